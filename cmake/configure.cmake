@@ -170,6 +170,14 @@ if (WITH_ARM_DOTPROD)
     add_definitions("-DWITH_ARM_DOTPROD")
 endif()
 
+if (WITH_ARM_I8MM)
+    add_definitions("-DWITH_ARM_I8MM")
+endif()
+
+if (WITH_ARM_BF16)
+    add_definitions("-DWITH_ARM_BF16")
+endif()
+
 if (LITE_WITH_NPU)
     add_definitions("-DLITE_WITH_NPU")
 endif()
@@ -245,6 +253,9 @@ if (LITE_WITH_NNADAPTER)
     if (NNADAPTER_WITH_KUNLUNXIN_XTCL)
       add_definitions("-DNNADAPTER_WITH_KUNLUNXIN_XTCL")
     endif()
+    if (NNADAPTER_WITH_FAKE_DEVICE)
+      add_definitions("-DNNADAPTER_WITH_FAKE_DEVICE")
+    endif()
   endif()
 endif()
 
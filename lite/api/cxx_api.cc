@@ -498,11 +498,36 @@ void Predictor::CheckPaddleOpVersions(
   }
 }
 
+std::vector<std::pair<std::string, float>> Predictor::Prepare(int threads) {
+  if (!program_generated_) {
+    GenRuntimeProgram();
+  }
+  return program_->Prepare(threads);
+}
+
+size_t Predictor::GetWorkspaceHighWaterMark() {
+  if (!program_generated_) {
+    return 0;
+  }
+  return program_->workspace()->high_water_mark();
+}
+
+void Predictor::SetRnnSessions(const std::vector<int64_t> &session_ids) {
+  if (!program_generated_) {
+    GenRuntimeProgram();
+  }
+  program_->SetRnnSessions(session_ids);
+}
+
+void Predictor::ReleaseRnnSession(int64_t session_id) {
+  if (program_generated_) {
+    program_->ReleaseRnnSession(session_id);
+  }
+}
+
 bool Predictor::TryShrinkMemory() {
-#ifdef LITE_WITH_ARM
-  // Clear ArmL3Cache
-  lite::DeviceInfo::Global().ClearArmL3Cache();
-#endif
+  // Free the workspace, its size is planned again by the next Run
+  program_->workspace()->Clear();
   const std::vector<std::string> &local_var_names =
       program_->exec_scope()->LocalVarNames();
   for (auto &var_name : local_var_names) {
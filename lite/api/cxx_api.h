@@ -199,6 +199,16 @@ class LITE_API Predictor {
   /// \return a boolean variable.
   bool TryShrinkMemory();
 
+  // Prepare the kernels ahead of the first Run.
+  std::vector<std::pair<std::string, float>> Prepare(int threads);
+
+  // The high-water mark of the workspace of the kernels.
+  size_t GetWorkspaceHighWaterMark();
+
+  // Run the lstm, gru and rnn ops as the streaming sessions.
+  void SetRnnSessions(const std::vector<int64_t>& session_ids);
+  void ReleaseRnnSession(int64_t session_id);
+
   // Get offset-th col of feed inputs.
   lite::Tensor* GetInput(size_t offset);
   // get input by name.
@@ -325,6 +335,13 @@ class CxxPaddleApiImpl : public lite_api::PaddlePredictor {
       lite_api::LiteModelType model_type = lite_api::LiteModelType::kProtobuf,
       bool record_info = false) override;
 
+  std::vector<std::pair<std::string, float>> Prepare() override;
+
+  size_t GetWorkspaceHighWaterMark() override;
+
+  void SetRnnSessions(const std::vector<int64_t>& session_ids) override;
+  void ReleaseRnnSession(int64_t session_id) override;
+
  private:
   std::shared_ptr<Predictor> raw_predictor_;
   lite_api::CxxConfig config_;
@@ -320,6 +320,26 @@ bool CxxPaddleApiImpl::TryShrinkMemory() {
   return raw_predictor_->TryShrinkMemory();
 }
 
+std::vector<std::pair<std::string, float>> CxxPaddleApiImpl::Prepare() {
+#ifdef LITE_WITH_ARM
+  lite::DeviceInfo::Global().SetRunMode(mode_, threads_);
+#endif
+  return raw_predictor_->Prepare(threads_);
+}
+
+size_t CxxPaddleApiImpl::GetWorkspaceHighWaterMark() {
+  return raw_predictor_->GetWorkspaceHighWaterMark();
+}
+
+void CxxPaddleApiImpl::SetRnnSessions(
+    const std::vector<int64_t> &session_ids) {
+  raw_predictor_->SetRnnSessions(session_ids);
+}
+
+void CxxPaddleApiImpl::ReleaseRnnSession(int64_t session_id) {
+  raw_predictor_->ReleaseRnnSession(session_id);
+}
+
 }  // namespace lite
 
 namespace lite_api {
@@ -15,6 +15,7 @@
 #include "lite/api/light_api.h"
 #include <algorithm>
 #include <map>
+#include "lite/utils/bfloat16.h"
 #ifdef ENABLE_ARM_FP16
 #include "lite/backends/arm/math/fp16/funcs_fp16.h"
 #endif
@@ -38,6 +39,8 @@ void LightPredictor::Build(const std::string& lite_model_file,
   // fp16 Weight convert
   WeightFP32ToFP16();
 #endif
+  // bf16 Weight convert
+  WeightFP32ToBF16();
   BuildRuntimeProgram(program_desc_);
   PrepareFeedFetch();
 }
@@ -72,6 +75,8 @@ void LightPredictor::Build(const std::string& model_dir,
   // fp16 Weight convert
   WeightFP32ToFP16();
 #endif
+  // bf16 Weight convert
+  WeightFP32ToBF16();
   BuildRuntimeProgram(program_desc_);
   PrepareFeedFetch();
 }
@@ -329,6 +334,7 @@ void LightPredictor::WeightFP32ToFP16() {
   std::vector<std::string> fp16_ops{"conv2d",
                                     "depthwise_conv2d",
                                     "conv2d_transpose",
+                                    "fusion_dw_pw_conv2d",
                                     "fc",
                                     "gru",
                                     "sequence_conv",
@@ -370,6 +376,35 @@ void LightPredictor::WeightFP32ToFP16() {
 }
 #endif
 
+// The weights marked by bf16_attribute_pass are stored in fp32 in the model,
+// they are rounded to bf16 here to halve their memory.
+void LightPredictor::WeightFP32ToBF16() {
+  std::shared_ptr<const cpp::ProgramDesc> program_desc = program_desc_;
+  for (size_t i = 0; i < program_desc->BlocksSize(); i++) {
+    auto* block = program_desc->GetBlock<cpp::BlockDesc>(i);
+    for (size_t k = 0; k < block->OpsSize(); ++k) {
+      auto* op_desc = block->GetOp<cpp::OpDesc>(k);
+      for (auto& input_name : op_desc->input_vars()) {
+        if (!op_desc->HasAttr(input_name + "_bf16")) continue;
+        auto input_tensor =
+            scope_->FindVar(input_name)->GetMutable<lite::Tensor>();
+        if (input_tensor->precision() != PRECISION(kFloat)) continue;
+
+        Tensor tmp_tensor;
+        tmp_tensor.CopyDataFrom(*input_tensor);
+        input_tensor->clear();
+        input_tensor->set_precision(PRECISION(kBF16));
+
+        auto* bf_data = input_tensor->mutable_data<bfloat16>();
+        const float* in_data = tmp_tensor.data<float>();
+        for (int64_t j = 0; j < input_tensor->numel(); ++j) {
+          bf_data[j].x = fp32_to_bf16_bits(in_data[j]);
+        }
+      }
+    }
+  }
+}
+
 void LightPredictor::CheckInputValid() {
   for (size_t idx = 0; idx < input_precisions_.size(); ++idx) {
     if (GetInput(idx)->precision() != input_precisions_[idx]) {
@@ -384,10 +419,8 @@ void LightPredictor::CheckInputValid() {
 }
 
 bool LightPredictor::TryShrinkMemory() {
-#ifdef LITE_WITH_ARM
-  // Clear ArmL3Cache
-  lite::DeviceInfo::Global().ClearArmL3Cache();
-#endif
+  // Free the workspace, its size is planned again by the next Run
+  program_->workspace()->Clear();
   const std::vector<std::string>& local_var_names =
       program_->exec_scope()->LocalVarNames();
   for (auto& var_name : local_var_names) {
@@ -75,6 +75,24 @@ class LITE_API LightPredictor {
   /// \return a boolean variable.
   bool TryShrinkMemory();
 
+  // Prepare the kernels ahead of the first Run.
+  std::vector<std::pair<std::string, float>> Prepare(int threads) {
+    return program_->Prepare(threads);
+  }
+
+  // The high-water mark of the workspace of the kernels.
+  size_t GetWorkspaceHighWaterMark() {
+    return program_->workspace()->high_water_mark();
+  }
+
+  // Run the lstm, gru and rnn ops as the streaming sessions.
+  void SetRnnSessions(const std::vector<int64_t>& session_ids) {
+    program_->SetRnnSessions(session_ids);
+  }
+  void ReleaseRnnSession(int64_t session_id) {
+    program_->ReleaseRnnSession(session_id);
+  }
+
   // Get offset-th col of feed inputs.
   Tensor* GetInput(size_t offset);
   // get input by name.
@@ -133,6 +151,8 @@ class LITE_API LightPredictor {
   void WeightFP32ToFP16();
 #endif
 
+  void WeightFP32ToBF16();
+
   void ClearTensorArray(
       const std::shared_ptr<const cpp::ProgramDesc>& program_desc);
 
@@ -175,6 +195,13 @@ class LightPredictorImpl : public lite_api::PaddlePredictor {
   /// \return a boolean variable.
   bool TryShrinkMemory() override;
 
+  std::vector<std::pair<std::string, float>> Prepare() override;
+
+  size_t GetWorkspaceHighWaterMark() override;
+
+  void SetRnnSessions(const std::vector<int64_t>& session_ids) override;
+  void ReleaseRnnSession(int64_t session_id) override;
+
  private:
   std::unique_ptr<lite::LightPredictor> raw_predictor_;
 };
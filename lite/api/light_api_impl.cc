@@ -169,6 +169,26 @@ bool LightPredictorImpl::TryShrinkMemory() {
   return raw_predictor_->TryShrinkMemory();
 }
 
+std::vector<std::pair<std::string, float>> LightPredictorImpl::Prepare() {
+#ifdef LITE_WITH_ARM
+  lite::DeviceInfo::Global().SetRunMode(mode_, threads_);
+#endif
+  return raw_predictor_->Prepare(threads_);
+}
+
+size_t LightPredictorImpl::GetWorkspaceHighWaterMark() {
+  return raw_predictor_->GetWorkspaceHighWaterMark();
+}
+
+void LightPredictorImpl::SetRnnSessions(
+    const std::vector<int64_t>& session_ids) {
+  raw_predictor_->SetRnnSessions(session_ids);
+}
+
+void LightPredictorImpl::ReleaseRnnSession(int64_t session_id) {
+  raw_predictor_->ReleaseRnnSession(session_id);
+}
+
 }  // namespace lite
 
 namespace lite_api {
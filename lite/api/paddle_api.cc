@@ -289,6 +289,28 @@ void PaddlePredictor::SaveOptimizedModel(const std::string &model_dir,
       << "The SaveOptimizedModel API is only supported by CxxConfig predictor.";
 }
 
+std::vector<std::pair<std::string, float>> PaddlePredictor::Prepare() {
+  LOG(FATAL) << "The Prepare API is only supported by CxxConfig and "
+                "MobileConfig predictors.";
+  return {};
+}
+
+size_t PaddlePredictor::GetWorkspaceHighWaterMark() {
+  LOG(FATAL) << "The GetWorkspaceHighWaterMark API is only supported by "
+                "CxxConfig and MobileConfig predictors.";
+  return 0;
+}
+
+void PaddlePredictor::SetRnnSessions(const std::vector<int64_t> &session_ids) {
+  LOG(FATAL) << "The SetRnnSessions API is only supported by CxxConfig and "
+                "MobileConfig predictors.";
+}
+
+void PaddlePredictor::ReleaseRnnSession(int64_t session_id) {
+  LOG(FATAL) << "The ReleaseRnnSession API is only supported by CxxConfig and "
+                "MobileConfig predictors.";
+}
+
 template <typename ConfigT>
 std::shared_ptr<PaddlePredictor> CreatePaddlePredictor(const ConfigT &) {
   return std::shared_ptr<PaddlePredictor>();
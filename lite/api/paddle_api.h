@@ -100,6 +100,18 @@ class LITE_API PaddlePredictor {
   virtual std::unique_ptr<const Tensor> GetOutput(int i) const = 0;
 
   virtual void Run() = 0;
+  /// Run the preparation of the kernels, e.g. the weight transforms, ahead of
+  /// the first Run, so that it doesn't slow down the first request. The
+  /// kernels are prepared by the threads of the predictor in parallel, and
+  /// the NNAdapter subgraphs are compiled in parallel with them. The inputs
+  /// should be resized and filled as for Run. The kernels whose input shapes
+  /// depend on the data computed by the others are still prepared at the
+  /// first Run.
+  /// \return the milliseconds spent by each prepared kernel.
+  virtual std::vector<std::pair<std::string, float>> Prepare();
+  /// The most bytes of the scratch memory used by the kernels at a time,
+  /// which is reserved by the predictor after its first Run.
+  virtual size_t GetWorkspaceHighWaterMark();
   virtual std::shared_ptr<PaddlePredictor> Clone() = 0;
   virtual std::shared_ptr<PaddlePredictor> Clone(
       const std::vector<std::string>& var_names) = 0;
@@ -133,6 +145,17 @@ class LITE_API PaddlePredictor {
       LiteModelType model_type = LiteModelType::kProtobuf,
       bool record_info = false);
 
+  /// Run the lstm, gru and rnn ops as the streaming sessions: the i-th input
+  /// sequence of the next runs(the i-th lod sequence, or the i-th batch of
+  /// the rnn op) continues from the final hidden and cell states of
+  /// `session_ids[i]`, the new sessions start from zeros. The sessions are run
+  /// in one batch, so the steps of them share the same GEMM calls. The empty
+  /// list turns off the streaming mode. Only the fp32 ARM and X86 kernels are
+  /// supported, and the reverse and bidirectional ops are not.
+  virtual void SetRnnSessions(const std::vector<int64_t>& session_ids);
+  /// Release the hidden and cell states of a finished session.
+  virtual void ReleaseRnnSession(int64_t session_id);
+
   virtual ~PaddlePredictor() = default;
 
  protected:
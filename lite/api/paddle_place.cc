@@ -103,7 +103,8 @@ const std::string& PrecisionToStr(PrecisionType precision) {
                                                  "int64_t",
                                                  "int16_t",
                                                  "uint8_t",
-                                                 "double"};
+                                                 "double",
+                                                 "bfloat16"};
   auto x = static_cast<int>(precision);
   CHECK_LT(x, static_cast<int>(PRECISION(NUM)));
   return precision2string[x];
@@ -158,7 +159,10 @@ const std::string& PrecisionRepr(PrecisionType precision) {
                                                  "kFP16",
                                                  "kBool",
                                                  "kInt64",
-                                                 "kInt16"};
+                                                 "kInt16",
+                                                 "kUInt8",
+                                                 "kFP64",
+                                                 "kBF16"};
   auto x = static_cast<int>(precision);
   CHECK_LT(x, static_cast<int>(PRECISION(NUM)));
   return precision2string[x];
@@ -218,8 +222,11 @@ std::set<TargetType> ExpandValidTargets(TargetType target) {
 }
 
 std::set<PrecisionType> ExpandValidPrecisions(PrecisionType precision) {
-  static const std::set<PrecisionType> valid_set(
-      {PRECISION(kFloat), PRECISION(kInt8), PRECISION(kFP16), PRECISION(kAny)});
+  static const std::set<PrecisionType> valid_set({PRECISION(kFloat),
+                                                  PRECISION(kInt8),
+                                                  PRECISION(kFP16),
+                                                  PRECISION(kBF16),
+                                                  PRECISION(kAny)});
   if (precision == PRECISION(kAny)) {
     return valid_set;
   }
@@ -76,7 +76,8 @@ enum class PrecisionType : int {
   kInt16 = 8,
   kUInt8 = 9,
   kFP64 = 10,
-  NUM = 11,  // number of fields.
+  kBF16 = 11,
+  NUM = 12,  // number of fields.
 };
 enum class DataLayoutType : int {
   kUnk = 0,
@@ -158,6 +159,8 @@ static size_t PrecisionTypeLength(PrecisionType type) {
       return 8;
     case PrecisionType::kFP16:
       return 2;
+    case PrecisionType::kBF16:
+      return 2;
     case PrecisionType::kInt16:
       return 2;
     default:
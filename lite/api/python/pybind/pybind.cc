@@ -67,6 +67,7 @@ void BindLiteOpt(py::module *m) {
       .def("set_param_file", &OptBase::SetParamFile)
       .def("set_valid_places", &OptBase::SetValidPlaces)
       .def("enable_fp16", &OptBase::EnableFloat16)
+      .def("enable_bf16", &OptBase::EnableBFloat16)
       .def("set_optimize_out", &OptBase::SetOptimizeOut)
       .def("set_model_type", &OptBase::SetModelType)
       .def("set_quant_model", &OptBase::SetQuantModel)
@@ -275,7 +276,8 @@ void BindLitePlace(py::module *m) {
       .value("INT64", PrecisionType::kInt64)
       .value("INT16", PrecisionType::kInt16)
       .value("UINT8", PrecisionType::kUInt8)
-      .value("FP64", PrecisionType::kFP64);
+      .value("FP64", PrecisionType::kFP64)
+      .value("BF16", PrecisionType::kBF16);
 
   // DataLayoutType
   py::enum_<DataLayoutType>(*m, "DataLayoutType")
@@ -371,6 +373,9 @@ void BindLiteCxxPredictor(py::module *m) {
       .def("get_input_by_name", &CxxPaddleApiImpl::GetInputByName)
       .def("get_output_by_name", &CxxPaddleApiImpl::GetOutputByName)
       .def("run", &CxxPaddleApiImpl::Run)
+      .def("prepare", &CxxPaddleApiImpl::Prepare)
+      .def("get_workspace_high_water_mark",
+           &CxxPaddleApiImpl::GetWorkspaceHighWaterMark)
       .def("get_version", &CxxPaddleApiImpl::GetVersion)
       .def("save_optimized_pb_model",
            [](CxxPaddleApiImpl &self, const std::string &output_dir) {
@@ -395,6 +400,9 @@ void BindLiteLightPredictor(py::module *m) {
       .def("get_input_by_name", &LightPredictorImpl::GetInputByName)
       .def("get_output_by_name", &LightPredictorImpl::GetOutputByName)
       .def("run", &LightPredictorImpl::Run)
+      .def("prepare", &LightPredictorImpl::Prepare)
+      .def("get_workspace_high_water_mark",
+           &LightPredictorImpl::GetWorkspaceHighWaterMark)
       .def("get_version", &LightPredictorImpl::GetVersion);
 }
 
@@ -31,11 +31,15 @@ DEFINE_int32(W, 224, "input_width");
 namespace paddle {
 namespace lite {
 
+// The kernels are prepared by `prepare_threads` threads ahead of the first run
+// if it's positive.
 void TestModel(const std::vector<Place>& valid_places,
                const std::string& model_dir = FLAGS_model_dir,
-               bool save_model = false) {
+               bool save_model = false,
+               int prepare_threads = 0,
+               lite_api::PowerMode power_mode = lite_api::LITE_POWER_NO_BIND) {
   DeviceInfo::Init();
-  DeviceInfo::Global().SetRunMode(lite_api::LITE_POWER_NO_BIND, FLAGS_threads);
+  DeviceInfo::Global().SetRunMode(power_mode, FLAGS_threads);
   lite::Predictor predictor;
 
   predictor.Build(model_dir, "", "", valid_places);
@@ -49,6 +53,11 @@ void TestModel(const std::vector<Place>& valid_places,
     data[i] = 1;
   }
 
+  if (prepare_threads > 0) {
+    auto prepare_times = predictor.Prepare(prepare_threads);
+    EXPECT_FALSE(prepare_times.empty());
+  }
+
   for (int i = 0; i < FLAGS_warmup; ++i) {
     predictor.Run();
   }
@@ -175,6 +184,18 @@ TEST(MobileNetV1, test_arm) {
   TestModel(valid_places);
 }
 
+// The conv kernels read the arch and the caches of the run mode when they are
+// prepared, which must be the same on the threads preparing them.
+TEST(MobileNetV1, test_arm_parallel_prepare) {
+  std::vector<Place> valid_places({
+      Place{TARGET(kARM), PRECISION(kFloat)},
+  });
+  for (auto power_mode :
+       {lite_api::LITE_POWER_NO_BIND, lite_api::LITE_POWER_HIGH}) {
+    TestModel(valid_places, FLAGS_model_dir, false, 4, power_mode);
+  }
+}
+
 #ifdef LITE_WITH_OPENCL
 TEST(MobileNetV1, test_opencl) {
   std::vector<Place> valid_places({
@@ -138,6 +138,14 @@ TEST(LightApi, run) {
     data[i] = i;
   }
 
+  // The kernels are prepared ahead of the first run.
+  auto prepare_times = predictor->Prepare();
+  EXPECT_FALSE(prepare_times.empty());
+  for (auto& kernel_time : prepare_times) {
+    LOG(INFO) << "prepare " << kernel_time.first << ": " << kernel_time.second
+              << " ms";
+  }
+
   predictor->Run();
 
   predictor->TryShrinkMemory();
@@ -48,6 +48,9 @@ DEFINE_string(quant_type,
               "Set the quant_type for post_quant_dynamic, "
               "and it should be QUANT_INT8 or QUANT_INT16 for now.");
 DEFINE_bool(enable_fp16, false, "Set kernel_type run in FP16.");
+DEFINE_bool(enable_bf16,
+            false,
+            "Store the fc weights in BF16 for the arm and x86 targets.");
 DEFINE_bool(record_tailoring_info,
             false,
             "Record kernels and operators information of the optimized model "
@@ -70,7 +73,8 @@ DEFINE_bool(print_all_ops_in_md_format,
 DEFINE_bool(print_model_ops, false, "Print operators in the input model");
 DEFINE_bool(sparse_model,
             false,
-            "Use sparse_conv_detect_pass to sparsify the 1x1conv weights.");
+            "Use sparse_conv_detect_pass to sparsify the 1x1conv and fc "
+            "weights.");
 DEFINE_double(sparse_threshold,
               0.6,
               "Set 0.6 as the lower bound for the sparse conv pass.");
@@ -112,6 +116,7 @@ int main(int argc, char** argv) {
   }
   if (FLAGS_valid_targets != "") {
     if (FLAGS_enable_fp16) opt.EnableFloat16();
+    if (FLAGS_enable_bf16) opt.EnableBFloat16();
     opt.SetValidPlaces(FLAGS_valid_targets);
   }
 
@@ -93,6 +93,10 @@ void OptBase::SetValidPlaces(const std::string& valid_places) {
   std::vector<std::string> nnadapter_device_names;
   for (auto& target_repr : target_reprs) {
     if (target_repr == "arm") {
+      if (enable_bf16_) {
+        valid_places_.emplace_back(
+            Place{TARGET(kARM), PRECISION(kBF16), DATALAYOUT(kNCHW)});
+      }
       if (enable_fp16_) {
         valid_places_.emplace_back(
             Place{TARGET(kARM), PRECISION(kFP16), DATALAYOUT(kNCHW)});
@@ -142,6 +146,9 @@ void OptBase::SetValidPlaces(const std::string& valid_places) {
       valid_places_.emplace_back(TARGET(kX86));
       valid_places_.emplace_back(TARGET(kHost));
     } else if (target_repr == "x86") {
+      if (enable_bf16_) {
+        valid_places_.emplace_back(Place{TARGET(kX86), PRECISION(kBF16)});
+      }
       valid_places_.emplace_back(Place{TARGET(kX86), PRECISION(kFloat)});
       valid_places_.emplace_back(Place{TARGET(kX86), PRECISION(kInt64)});
       valid_places_.emplace_back(Place{TARGET(kX86), PRECISION(kAny)});
@@ -405,6 +412,9 @@ void OptBase::PrintExecutableBinHelpInfo() {
       "        `--sparse_threshold=(float)`\n"
       "  Arguments of enable_fp16 in opt: \n"
       "        `--enable_fp16=(true|false)`\n"
+      "  Arguments of enable_bf16 in opt, the fc weights of arm and x86 are "
+      "stored and computed in bfloat16: \n"
+      "        `--enable_bf16=(true|false)`\n"
       "  Arguments of model checking and ops information:\n"
       "        `--print_all_ops=true`   Display all the valid operators of "
       "Paddle-Lite\n"
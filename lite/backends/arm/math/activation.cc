@@ -14,6 +14,7 @@
 
 #include "lite/backends/arm/math/activation.h"
 #include <algorithm>
+#include <cmath>
 #include <string>
 #include "lite/backends/arm/math/funcs.h"
 #include "lite/core/parallel_defines.h"
@@ -993,31 +994,105 @@ void act_elu<float>(
 
 // when using approximation
 // $out = \\frac{1}{2}x(1+tanh(\\sqrt{\\frac{2}{\\pi}}(x+0.044715x^{3}))$
+// which equals x * sigmoid(2 * \\sqrt{\\frac{2}{\\pi}}(x+0.044715x^{3})),
 // or else
 // $out = \\frac{1 + erf(\\frac{x}{\\sqrt{2}})}{2} x$
+// where erf is approximated by the polynomial of Abramowitz and Stegun 7.1.26,
+// whose max error is 1.5e-7.
+static const float kGeluTanhScale = -1.5957691216f;  // -2 * sqrt(2 / pi)
+static const float kErfP = 0.3275911f;
+static const float kErfA1 = 0.254829592f;
+static const float kErfA2 = -0.284496736f;
+static const float kErfA3 = 1.421413741f;
+static const float kErfA4 = -1.453152027f;
+static const float kErfA5 = 1.061405429f;
+
+inline float gelu_tanh(float x) {
+  return x / (1.f + expf(kGeluTanhScale * (x + 0.044715f * x * x * x)));
+}
+
+inline float gelu_erf(float x) {
+  float z = std::fabs(x) * static_cast<float>(M_SQRT1_2);
+  float t = 1.f / (1.f + kErfP * z);
+  float poly =
+      t * (kErfA1 + t * (kErfA2 + t * (kErfA3 + t * (kErfA4 + t * kErfA5))));
+  // 0.5 * (1 - erf(|x| / sqrt(2)))
+  float half_q = 0.5f * poly * expf(-z * z);
+  return x * (x >= 0.f ? 1.f - half_q : half_q);
+}
+
+// div_ps keeps only one Newton step, which isn't accurate enough here.
+inline float32x4_t gelu_div_ps(float32x4_t a, float32x4_t b) {
+#ifdef __aarch64__
+  return vdivq_f32(a, b);
+#else
+  float32x4_t reciprocal = vrecpeq_f32(b);
+  reciprocal = vmulq_f32(vrecpsq_f32(b, reciprocal), reciprocal);
+  reciprocal = vmulq_f32(vrecpsq_f32(b, reciprocal), reciprocal);
+  return vmulq_f32(a, reciprocal);
+#endif
+}
+
+inline float32x4_t gelu_tanh_ps(float32x4_t x) {
+  float32x4_t x3 = vmulq_f32(vmulq_f32(x, x), x);
+  float32x4_t u = vmlaq_n_f32(x, x3, 0.044715f);
+  float32x4_t e = exp_ps(vmulq_n_f32(u, kGeluTanhScale));
+  return gelu_div_ps(x, vaddq_f32(e, vdupq_n_f32(1.f)));
+}
+
+inline float32x4_t gelu_erf_ps(float32x4_t x) {
+  float32x4_t vone = vdupq_n_f32(1.f);
+  float32x4_t z = vmulq_n_f32(vabsq_f32(x), static_cast<float>(M_SQRT1_2));
+  float32x4_t t = gelu_div_ps(vone, vmlaq_n_f32(vone, z, kErfP));
+  float32x4_t poly = vmlaq_n_f32(vdupq_n_f32(kErfA4), t, kErfA5);
+  poly = vmlaq_f32(vdupq_n_f32(kErfA3), poly, t);
+  poly = vmlaq_f32(vdupq_n_f32(kErfA2), poly, t);
+  poly = vmlaq_f32(vdupq_n_f32(kErfA1), poly, t);
+  poly = vmulq_f32(poly, t);
+  float32x4_t e = exp_ps(vnegq_f32(vmulq_f32(z, z)));
+  float32x4_t half_q = vmulq_n_f32(vmulq_f32(poly, e), 0.5f);
+  uint32x4_t positive = vcgeq_f32(x, vdupq_n_f32(0.f));
+  return vmulq_f32(x, vbslq_f32(positive, vsubq_f32(vone, half_q), half_q));
+}
+
 template <>
 void act_gelu<float>(
     const float* din, float* dout, int size, bool approximate, int threads) {
-  if (approximate) {
-    const float pi = std::atan(1) * 4;
-    const float sqrt_2_div_pi = std::sqrt(2 / pi);
-    for (int i = 0; i < size; i++) {
-      float x = *din;
-      *dout = 0.5 * x *
-              (1 + std::tanh(sqrt_2_div_pi * (x + 0.044715 * std::pow(x, 3))));
-      ++din;
-      ++dout;
-    }
-  } else {
-    const float sqrt_2 = std::sqrt(2.0);
-    for (int i = 0; i < size; i++) {
-      float x = *din;
-      *dout = 0.5 * x * (1 + std::erf(x / sqrt_2));
-      ++din;
-      ++dout;
+  int nums_per_thread = size / threads;
+  int thread_remain = size % threads;
+  int cnt = nums_per_thread >> 2;
+  int remain = nums_per_thread & 3;
+  LITE_PARALLEL_BEGIN(i, tid, threads) {
+    const float* ptr_in_thread = din + i * nums_per_thread;
+    float* ptr_out_thread = dout + i * nums_per_thread;
+    if (approximate) {
+      for (int j = 0; j < cnt; j++) {
+        vst1q_f32(ptr_out_thread, gelu_tanh_ps(vld1q_f32(ptr_in_thread)));
+        ptr_in_thread += 4;
+        ptr_out_thread += 4;
+      }
+      for (int j = 0; j < remain; j++) {
+        ptr_out_thread[j] = gelu_tanh(ptr_in_thread[j]);
+      }
+    } else {
+      for (int j = 0; j < cnt; j++) {
+        vst1q_f32(ptr_out_thread, gelu_erf_ps(vld1q_f32(ptr_in_thread)));
+        ptr_in_thread += 4;
+        ptr_out_thread += 4;
+      }
+      for (int j = 0; j < remain; j++) {
+        ptr_out_thread[j] = gelu_erf(ptr_in_thread[j]);
+      }
     }
   }
+  LITE_PARALLEL_END();
+  float* ptr_out = dout + threads * nums_per_thread;
+  const float* ptr_in = din + threads * nums_per_thread;
+  for (int j = 0; j < thread_remain; j++) {
+    ptr_out[j] = approximate ? gelu_tanh(ptr_in[j]) : gelu_erf(ptr_in[j]);
+  }
 }
+
 template <>
 void mish(const float* din, float* dout, int size, float threshold) {
   int cnt = size >> 4;
@@ -0,0 +1,409 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/backends/arm/math/conv_depthwise_pointwise.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include <vector>
+#include "lite/backends/arm/math/conv_depthwise.h"
+#include "lite/backends/arm/math/saturate.h"
+#include "lite/core/parallel_defines.h"
+
+namespace paddle {
+namespace lite {
+namespace arm {
+namespace math {
+
+int conv_dw_pw_tile_rows(
+    int chin, int hout, int wout, int elem_size, ARMContext* ctx) {
+  // Use half of L2 for the depthwise tile, the rest is left for the packed
+  // pointwise weights and the output of the gemm.
+  int tile_size = ctx->l2_cache_size() / 2;
+  int row_size = chin * wout * elem_size;
+  int rows = row_size > 0 ? tile_size / row_size : hout;
+  return std::max(1, std::min(rows, hout));
+}
+
+template <typename Dtype>
+static void act_row(Dtype* dout,
+                    int size,
+                    const operators::ActivationParam& act_param) {
+  if (!act_param.has_active) return;
+  switch (act_param.active_type) {
+    case lite_api::ActivationType::kRelu:
+      for (int i = 0; i < size; i++) {
+        dout[i] = dout[i] > 0 ? dout[i] : static_cast<Dtype>(0);
+      }
+      break;
+    case lite_api::ActivationType::kRelu6: {
+      const Dtype six = static_cast<Dtype>(act_param.Relu_clipped_coef);
+      for (int i = 0; i < size; i++) {
+        Dtype x = dout[i] > 0 ? dout[i] : static_cast<Dtype>(0);
+        dout[i] = x < six ? x : six;
+      }
+      break;
+    }
+    case lite_api::ActivationType::kLeakyRelu: {
+      const Dtype alpha = static_cast<Dtype>(act_param.Leaky_relu_alpha);
+      for (int i = 0; i < size; i++) {
+        dout[i] = dout[i] > 0 ? dout[i] : dout[i] * alpha;
+      }
+      break;
+    }
+    case lite_api::ActivationType::kHardSwish: {
+      const float threshold = act_param.hard_swish_threshold;
+      const float scale = act_param.hard_swish_scale;
+      const float offset = act_param.hard_swish_offset;
+      for (int i = 0; i < size; i++) {
+        float x = static_cast<float>(dout[i]);
+        float y = std::min(std::max(x + offset, 0.f), threshold);
+        dout[i] = static_cast<Dtype>(x * y / scale);
+      }
+      break;
+    }
+    default:
+      LOG(FATAL) << "This act_type: "
+                 << static_cast<int>(act_param.active_type)
+                 << " doesn't support in fused depthwise conv";
+  }
+}
+
+template <typename Dtype>
+void conv_depthwise_rows(const Dtype* din,
+                         Dtype* dout,
+                         int chin,
+                         int hin,
+                         int win,
+                         int wout,
+                         int oh_begin,
+                         int oh_end,
+                         const Dtype* weights,
+                         const Dtype* bias,
+                         const operators::ConvParam& param,
+                         ARMContext* ctx) {
+  const int kh = param.filter->dims()[2];
+  const int kw = param.filter->dims()[3];
+  const int sh = param.strides[0];
+  const int sw = param.strides[1];
+  const int ph = (*param.paddings)[0];
+  const int pw = (*param.paddings)[2];
+  const int dh = (*param.dilations)[0];
+  const int dw = (*param.dilations)[1];
+  const int rows = oh_end - oh_begin;
+  const int in_size = hin * win;
+  const int tile_size = rows * wout;
+  const int kernel_size = kh * kw;
+
+  // The range of output columns [ow_begin, ow_end) of each kernel column which
+  // reads the input without padding.
+  std::vector<int> ow_begin(kw);
+  std::vector<int> ow_end(kw);
+  for (int kj = 0; kj < kw; kj++) {
+    int offset = kj * dw - pw;
+    int begin = offset < 0 ? (-offset + sw - 1) / sw : 0;
+    int end = (win - offset + sw - 1) / sw;
+    ow_begin[kj] = std::min(begin, wout);
+    ow_end[kj] = std::max(ow_begin[kj], std::min(end, wout));
+  }
+
+  LITE_PARALLEL_BEGIN(c, tid, chin) {
+    const Dtype* din_ch = din + c * in_size;
+    const Dtype* weights_ch = weights + c * kernel_size;
+    const Dtype bias_val = bias ? bias[c] : static_cast<Dtype>(0);
+    Dtype* dout_ch = dout + c * tile_size;
+    for (int oh = oh_begin; oh < oh_end; oh++) {
+      Dtype* dout_row = dout_ch + (oh - oh_begin) * wout;
+      for (int ow = 0; ow < wout; ow++) {
+        dout_row[ow] = bias_val;
+      }
+      for (int ki = 0; ki < kh; ki++) {
+        int ih = oh * sh - ph + ki * dh;
+        if (ih < 0 || ih >= hin) continue;
+        const Dtype* din_row = din_ch + ih * win;
+        for (int kj = 0; kj < kw; kj++) {
+          const Dtype w = weights_ch[ki * kw + kj];
+          const Dtype* din_ptr = din_row + kj * dw - pw;
+          if (sw == 1) {
+            for (int ow = ow_begin[kj]; ow < ow_end[kj]; ow++) {
+              dout_row[ow] += w * din_ptr[ow];
+            }
+          } else {
+            for (int ow = ow_begin[kj]; ow < ow_end[kj]; ow++) {
+              dout_row[ow] += w * din_ptr[ow * sw];
+            }
+          }
+        }
+      }
+    }
+    act_row(dout_ch, tile_size, param.activation_param);
+  }
+  LITE_PARALLEL_END();
+}
+
+template void conv_depthwise_rows<float>(const float* din,
+                                         float* dout,
+                                         int chin,
+                                         int hin,
+                                         int win,
+                                         int wout,
+                                         int oh_begin,
+                                         int oh_end,
+                                         const float* weights,
+                                         const float* bias,
+                                         const operators::ConvParam& param,
+                                         ARMContext* ctx);
+
+void conv_depthwise_rows_int8(const int8_t* din,
+                              int8_t* dout,
+                              int chin,
+                              int hin,
+                              int win,
+                              int wout,
+                              int oh_begin,
+                              int oh_end,
+                              const int8_t* weights,
+                              const float* bias,
+                              const float* scale,
+                              float out_scale,
+                              const operators::ConvParam& param,
+                              ARMContext* ctx) {
+  const int kh = param.filter->dims()[2];
+  const int kw = param.filter->dims()[3];
+  const int sh = param.strides[0];
+  const int sw = param.strides[1];
+  const int ph = (*param.paddings)[0];
+  const int pw = (*param.paddings)[2];
+  const int dh = (*param.dilations)[0];
+  const int dw = (*param.dilations)[1];
+  const int rows = oh_end - oh_begin;
+  const int in_size = hin * win;
+  const int tile_size = rows * wout;
+  const int kernel_size = kh * kw;
+  const float inv_out_scale = 1.f / out_scale;
+
+  std::vector<int> ow_begin(kw);
+  std::vector<int> ow_end(kw);
+  for (int kj = 0; kj < kw; kj++) {
+    int offset = kj * dw - pw;
+    int begin = offset < 0 ? (-offset + sw - 1) / sw : 0;
+    int end = (win - offset + sw - 1) / sw;
+    ow_begin[kj] = std::min(begin, wout);
+    ow_end[kj] = std::max(ow_begin[kj], std::min(end, wout));
+  }
+
+  LITE_PARALLEL_BEGIN(c, tid, chin) {
+    const int8_t* din_ch = din + c * in_size;
+    const int8_t* weights_ch = weights + c * kernel_size;
+    const float bias_val = bias ? bias[c] : 0.f;
+    int8_t* dout_ch = dout + c * tile_size;
+    std::vector<int32_t> sum(wout);
+    std::vector<float> dout_row(wout);
+    for (int oh = oh_begin; oh < oh_end; oh++) {
+      std::fill(sum.begin(), sum.end(), 0);
+      for (int ki = 0; ki < kh; ki++) {
+        int ih = oh * sh - ph + ki * dh;
+        if (ih < 0 || ih >= hin) continue;
+        const int8_t* din_row = din_ch + ih * win;
+        for (int kj = 0; kj < kw; kj++) {
+          const int32_t w = weights_ch[ki * kw + kj];
+          const int8_t* din_ptr = din_row + kj * dw - pw;
+          for (int ow = ow_begin[kj]; ow < ow_end[kj]; ow++) {
+            sum[ow] += w * din_ptr[ow * sw];
+          }
+        }
+      }
+      for (int ow = 0; ow < wout; ow++) {
+        dout_row[ow] = sum[ow] * scale[c] + bias_val;
+      }
+      act_row(dout_row.data(), wout, param.activation_param);
+      int8_t* dout_q = dout_ch + (oh - oh_begin) * wout;
+      for (int ow = 0; ow < wout; ow++) {
+        int8_t q = saturate_cast<int8_t>(roundf(dout_row[ow] * inv_out_scale));
+        dout_q[ow] = q < -127 ? -127 : q;
+      }
+    }
+  }
+  LITE_PARALLEL_END();
+}
+
+bool conv_depthwise_rows_neon_supported(const operators::ConvParam& param) {
+  const int kh = param.filter->dims()[2];
+  const int kw = param.filter->dims()[3];
+  const int sh = param.strides[0];
+  const int sw = param.strides[1];
+  for (auto dilation : *param.dilations) {
+    if (dilation != 1) return false;
+  }
+  return kh == kw && (kw == 3 || kw == 5) && sh == sw && (sw == 1 || sw == 2);
+}
+
+int conv_depthwise_rows_band_size(const operators::ConvParam& param,
+                                  int chin,
+                                  int win,
+                                  int tile_rows) {
+  const int kh = param.filter->dims()[2];
+  const int sh = param.strides[0];
+  return chin * ((tile_rows - 1) * sh + kh) * win;
+}
+
+void conv_depthwise_rows_neon(const float* din,
+                              float* dout,
+                              float* band,
+                              int chin,
+                              int hin,
+                              int win,
+                              int wout,
+                              int oh_begin,
+                              int oh_end,
+                              const float* weights,
+                              const float* bias,
+                              const operators::ConvParam& param,
+                              ARMContext* ctx) {
+  const int kh = param.filter->dims()[2];
+  const int kw = param.filter->dims()[3];
+  const int sh = param.strides[0];
+  const int ph = (*param.paddings)[0];
+  const int rows = oh_end - oh_begin;
+  // The input rows [ih_begin, ih_end) read by the tile, the ones out of the
+  // input are the paddings of the tile.
+  const int ih_begin = oh_begin * sh - ph;
+  const int ih_end = (oh_end - 1) * sh - ph + kh;
+  const int band_begin = std::max(ih_begin, 0);
+  const int band_end = std::min(ih_end, hin);
+  const int band_h = band_end - band_begin;
+  if (band_h <= 0) {
+    conv_depthwise_rows<float>(din,
+                               dout,
+                               chin,
+                               hin,
+                               win,
+                               wout,
+                               oh_begin,
+                               oh_end,
+                               param.filter->data<float>(),
+                               bias,
+                               param,
+                               ctx);
+    return;
+  }
+  LITE_PARALLEL_BEGIN(c, tid, chin) {
+    memcpy(band + c * band_h * win,
+           din + (c * hin + band_begin) * win,
+           sizeof(float) * band_h * win);
+  }
+  LITE_PARALLEL_END();
+
+  // The kernels apply the activation only partly, e.g. no hard_swish, so it's
+  // applied to the tile afterwards.
+  operators::ConvParam band_param = param;
+  std::vector<int> band_paddings{band_begin - ih_begin,
+                                 ih_end - band_end,
+                                 (*param.paddings)[2],
+                                 (*param.paddings)[3]};
+  band_param.paddings = std::make_shared<std::vector<int>>(band_paddings);
+  band_param.activation_param = operators::ActivationParam();
+  band_param.fuse_relu = false;
+  const auto& act_param = band_param.activation_param;
+  if (kw == 3 && sh == 1) {
+    conv_3x3s1_depthwise_fp32(band,
+                              dout,
+                              1,
+                              chin,
+                              rows,
+                              wout,
+                              chin,
+                              band_h,
+                              win,
+                              weights,
+                              bias,
+                              band_param,
+                              act_param,
+                              ctx);
+  } else if (kw == 3) {
+    conv_3x3s2_depthwise_fp32(band,
+                              dout,
+                              1,
+                              chin,
+                              rows,
+                              wout,
+                              chin,
+                              band_h,
+                              win,
+                              weights,
+                              bias,
+                              band_param,
+                              act_param,
+                              ctx);
+  } else if (sh == 1) {
+    ctx->ExtendWorkspace((win + wout + 16) * sizeof(float));
+    conv_depthwise_5x5s1_fp32(dout,
+                              band,
+                              weights,
+                              bias,
+                              bias != nullptr,
+                              false,
+                              1,
+                              chin,
+                              band_h,
+                              win,
+                              rows,
+                              wout,
+                              (*band_param.paddings)[2],
+                              (*band_param.paddings)[0],
+                              band_param,
+                              ctx);
+  } else {
+    conv_depthwise_5x5s2_fp32(band,
+                              dout,
+                              1,
+                              chin,
+                              rows,
+                              wout,
+                              chin,
+                              band_h,
+                              win,
+                              weights,
+                              bias,
+                              band_param,
+                              act_param,
+                              ctx);
+  }
+  const int tile_size = rows * wout;
+  LITE_PARALLEL_BEGIN(c, tid, chin) {
+    act_row(dout + c * tile_size, tile_size, param.activation_param);
+  }
+  LITE_PARALLEL_END();
+}
+
+#ifdef ENABLE_ARM_FP16
+template void conv_depthwise_rows<__fp16>(const __fp16* din,
+                                          __fp16* dout,
+                                          int chin,
+                                          int hin,
+                                          int win,
+                                          int wout,
+                                          int oh_begin,
+                                          int oh_end,
+                                          const __fp16* weights,
+                                          const __fp16* bias,
+                                          const operators::ConvParam& param,
+                                          ARMContext* ctx);
+#endif
+
+}  // namespace math
+}  // namespace arm
+}  // namespace lite
+}  // namespace paddle
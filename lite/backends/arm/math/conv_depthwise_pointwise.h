@@ -0,0 +1,99 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "lite/core/context.h"
+#include "lite/core/target_wrapper.h"
+#include "lite/operators/op_params.h"
+
+namespace paddle {
+namespace lite {
+namespace arm {
+namespace math {
+
+/// Get the number of the depthwise output rows computed in one tile of the
+/// fused depthwise-pointwise conv, the tile of all the channels is kept in L2.
+int conv_dw_pw_tile_rows(int chin, int hout, int wout, int elem_size,
+                         ARMContext* ctx);
+
+/// Compute the rows [oh_begin, oh_end) of a depthwise conv (channel multiplier
+/// is 1) with the bias and activation of `param`, the rows of channel c are
+/// stored contiguously at dout + c * (oh_end - oh_begin) * wout, so that the
+/// tile can be used as the B matrix of the pointwise gemm directly.
+template <typename Dtype>
+void conv_depthwise_rows(const Dtype* din,
+                         Dtype* dout,
+                         int chin,
+                         int hin,
+                         int win,
+                         int wout,
+                         int oh_begin,
+                         int oh_end,
+                         const Dtype* weights,
+                         const Dtype* bias,
+                         const operators::ConvParam& param,
+                         ARMContext* ctx);
+
+/// The int8 version of conv_depthwise_rows(): the int32 sums of channel c are
+/// dequantized by scale[c], added by the fp32 bias and activated, then
+/// quantized to int8 by `out_scale` to be the B matrix of the int8 gemm.
+void conv_depthwise_rows_int8(const int8_t* din,
+                              int8_t* dout,
+                              int chin,
+                              int hin,
+                              int win,
+                              int wout,
+                              int oh_begin,
+                              int oh_end,
+                              const int8_t* weights,
+                              const float* bias,
+                              const float* scale,
+                              float out_scale,
+                              const operators::ConvParam& param,
+                              ARMContext* ctx);
+
+/// Whether conv_depthwise_rows_neon() supports the depthwise conv: 3x3 or 5x5
+/// kernels with the same stride 1 or 2 on both axes and no dilation.
+bool conv_depthwise_rows_neon_supported(const operators::ConvParam& param);
+
+/// The floats of the input rows copied by conv_depthwise_rows_neon() for a tile
+/// of `tile_rows` output rows.
+int conv_depthwise_rows_band_size(const operators::ConvParam& param,
+                                  int chin,
+                                  int win,
+                                  int tile_rows);
+
+/// The same as conv_depthwise_rows(), but the rows are computed by the NEON
+/// depthwise conv kernels. The input rows read by the tile are copied to
+/// `band`, the paddings of the tile are passed to the kernels, and `weights`
+/// are transformed by conv_trans_weights_numc() in blocks of 4 channels.
+void conv_depthwise_rows_neon(const float* din,
+                              float* dout,
+                              float* band,
+                              int chin,
+                              int hin,
+                              int win,
+                              int wout,
+                              int oh_begin,
+                              int oh_end,
+                              const float* weights,
+                              const float* bias,
+                              const operators::ConvParam& param,
+                              ARMContext* ctx);
+
+}  // namespace math
+}  // namespace arm
+}  // namespace lite
+}  // namespace paddle
@@ -28,12 +28,14 @@
 #include "lite/backends/arm/math/col_im_transform.h"
 #include "lite/backends/arm/math/concat.h"
 #include "lite/backends/arm/math/conv_block_utils.h"
+#include "lite/backends/arm/math/conv_depthwise_pointwise.h"
 #include "lite/backends/arm/math/conv_impl.h"
 #include "lite/backends/arm/math/conv_transpose_depthwise.h"
 #include "lite/backends/arm/math/decode_bboxes.h"
 #include "lite/backends/arm/math/dropout.h"
 #include "lite/backends/arm/math/elementwise.h"
 #include "lite/backends/arm/math/fill_bias_relu.h"
+#include "lite/backends/arm/math/gemm_bf16.h"
 #include "lite/backends/arm/math/gemm_prepacked_int8.h"
 #include "lite/backends/arm/math/gemm_s8.h"
 #include "lite/backends/arm/math/gemv_arm_int8.h"
@@ -46,21 +48,18 @@
 #include "lite/backends/arm/math/packed_sgemm.h"
 #include "lite/backends/arm/math/packed_sgemm_c4.h"
 #include "lite/backends/arm/math/pad2d.h"
+#include "lite/backends/arm/math/pointwise_chain.h"
 #include "lite/backends/arm/math/pooling.h"
 #include "lite/backends/arm/math/power.h"
 #include "lite/backends/arm/math/quantize.h"
-#include "lite/backends/arm/math/reduce_max.h"
-#include "lite/backends/arm/math/reduce_max_min.h"
 #include "lite/backends/arm/math/reduce_mean.h"
-#include "lite/backends/arm/math/reduce_min.h"
-#include "lite/backends/arm/math/reduce_prod.h"
-#include "lite/backends/arm/math/reduce_sum.h"
 #include "lite/backends/arm/math/scale.h"
 #include "lite/backends/arm/math/scatter.h"
 #include "lite/backends/arm/math/sequence_expand.h"
 #include "lite/backends/arm/math/sequence_pool.h"
 #include "lite/backends/arm/math/sequence_pool_grad.h"
 #include "lite/backends/arm/math/sgemm.h"
+#include "lite/backends/arm/math/sgemm_batched.h"
 #include "lite/backends/arm/math/sgemv.h"
 #include "lite/backends/arm/math/slice.h"
 #include "lite/backends/arm/math/softmax.h"
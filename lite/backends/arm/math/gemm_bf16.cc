@@ -0,0 +1,266 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/backends/arm/math/gemm_bf16.h"
+#include <arm_neon.h>
+#include <algorithm>
+#include "lite/core/parallel_defines.h"
+
+namespace paddle {
+namespace lite {
+namespace arm {
+namespace math {
+
+namespace {
+
+// the columns of a packed panel
+const int kPanel = 16;
+// the rows of A computed together
+#ifdef __aarch64__
+const int kMr = 4;
+#else
+const int kMr = 2;
+#endif
+
+inline uint16_t to_bf16_bits(float val) { return fp32_to_bf16_bits(val); }
+inline uint16_t to_bf16_bits(bfloat16 val) { return val.x; }
+
+template <typename T>
+void gemm_bf16_packb_impl(
+    int K, int N, const T* B, int ldb, bfloat16* packed_B) {
+  const int kh = (K + 1) / 2;
+  const int panels = (N + kPanel - 1) / kPanel;
+  uint16_t* out = reinterpret_cast<uint16_t*>(packed_B);
+  for (int p = 0; p < panels; ++p) {
+    for (int q = 0; q < kh; ++q) {
+      for (int c = 0; c < kPanel; ++c) {
+        int n = p * kPanel + c;
+        for (int h = 0; h < 2; ++h) {
+          int k = 2 * q + h;
+          *out++ = (k < K && n < N) ? to_bf16_bits(B[k * ldb + n]) : 0;
+        }
+      }
+    }
+  }
+}
+
+inline float32x4_t bf16_fma(float32x4_t acc, float32x4_t b, float a) {
+#ifdef __aarch64__
+  return vfmaq_n_f32(acc, b, a);
+#else
+  return vmlaq_n_f32(acc, b, a);
+#endif
+}
+
+// C[MR, ncols] = A[MR, K] * b, b is one packed panel
+template <int MR>
+void gemm_bf16_kernel(int K,
+                      const float* A,
+                      int lda,
+                      const uint16_t* b,
+                      float* C,
+                      int ldc,
+                      int ncols,
+                      const float* bias,
+                      bool relu) {
+  float32x4_t acc[MR][4];
+  for (int r = 0; r < MR; ++r) {
+    for (int c = 0; c < 4; ++c) {
+      acc[r][c] = vdupq_n_f32(0.f);
+    }
+  }
+  const uint32x4_t vmask_hi = vdupq_n_u32(0xffff0000u);
+  // the even k is in the low half of the pair, the odd k in the high half
+  for (int k = 0; k < K - 1; k += 2) {
+    float32x4_t vb_e[4];
+    float32x4_t vb_o[4];
+    for (int c = 0; c < 4; ++c) {
+      uint32x4_t vb = vreinterpretq_u32_u16(vld1q_u16(b + c * 8));
+      vb_e[c] = vreinterpretq_f32_u32(vshlq_n_u32(vb, 16));
+      vb_o[c] = vreinterpretq_f32_u32(vandq_u32(vb, vmask_hi));
+    }
+    for (int r = 0; r < MR; ++r) {
+      float a_e = A[r * lda + k];
+      float a_o = A[r * lda + k + 1];
+      for (int c = 0; c < 4; ++c) {
+        acc[r][c] = bf16_fma(acc[r][c], vb_e[c], a_e);
+        acc[r][c] = bf16_fma(acc[r][c], vb_o[c], a_o);
+      }
+    }
+    b += 2 * kPanel;
+  }
+  if (K & 1) {
+    for (int c = 0; c < 4; ++c) {
+      uint32x4_t vb = vreinterpretq_u32_u16(vld1q_u16(b + c * 8));
+      float32x4_t vb_e = vreinterpretq_f32_u32(vshlq_n_u32(vb, 16));
+      for (int r = 0; r < MR; ++r) {
+        acc[r][c] = bf16_fma(acc[r][c], vb_e, A[r * lda + K - 1]);
+      }
+    }
+  }
+
+  const float32x4_t vzero = vdupq_n_f32(0.f);
+  if (ncols == kPanel) {
+    for (int c = 0; c < 4; ++c) {
+      float32x4_t vbias = bias ? vld1q_f32(bias + c * 4) : vzero;
+      for (int r = 0; r < MR; ++r) {
+        float32x4_t v = vaddq_f32(acc[r][c], vbias);
+        if (relu) {
+          v = vmaxq_f32(v, vzero);
+        }
+        vst1q_f32(C + r * ldc + c * 4, v);
+      }
+    }
+  } else {
+    float tile[kPanel];
+    for (int r = 0; r < MR; ++r) {
+      for (int c = 0; c < 4; ++c) {
+        vst1q_f32(tile + c * 4, acc[r][c]);
+      }
+      for (int c = 0; c < ncols; ++c) {
+        float v = tile[c] + (bias ? bias[c] : 0.f);
+        C[r * ldc + c] = relu ? std::max(v, 0.f) : v;
+      }
+    }
+  }
+}
+
+void gemm_bf16_panel(int mr,
+                     int K,
+                     const float* A,
+                     int lda,
+                     const uint16_t* b,
+                     float* C,
+                     int ldc,
+                     int ncols,
+                     const float* bias,
+                     bool relu) {
+  switch (mr) {
+#ifdef __aarch64__
+    case 4:
+      gemm_bf16_kernel<4>(K, A, lda, b, C, ldc, ncols, bias, relu);
+      break;
+    case 3:
+      gemm_bf16_kernel<3>(K, A, lda, b, C, ldc, ncols, bias, relu);
+      break;
+#endif
+    case 2:
+      gemm_bf16_kernel<2>(K, A, lda, b, C, ldc, ncols, bias, relu);
+      break;
+    default:
+      gemm_bf16_kernel<1>(K, A, lda, b, C, ldc, ncols, bias, relu);
+      break;
+  }
+}
+
+}  // namespace
+
+void fp32_to_bf16(const float* din, bfloat16* dout, int64_t size) {
+  uint16_t* out = reinterpret_cast<uint16_t*>(dout);
+  const uint32x4_t vone = vdupq_n_u32(1);
+  const uint32x4_t vround = vdupq_n_u32(0x7fff);
+  const uint32x4_t vquiet = vdupq_n_u32(0x400000);
+  int64_t i = 0;
+  for (; i + 4 <= size; i += 4) {
+    float32x4_t vf = vld1q_f32(din + i);
+    uint32x4_t v = vreinterpretq_u32_f32(vf);
+    uint32x4_t vlsb = vandq_u32(vshrq_n_u32(v, 16), vone);
+    uint32x4_t vrnd = vaddq_u32(v, vaddq_u32(vround, vlsb));
+    // NaN is the only value which is not equal to itself
+    uint32x4_t vnan = vmvnq_u32(vceqq_f32(vf, vf));
+    vrnd = vbslq_u32(vnan, vorrq_u32(v, vquiet), vrnd);
+    vst1_u16(out + i, vshrn_n_u32(vrnd, 16));
+  }
+  for (; i < size; ++i) {
+    out[i] = fp32_to_bf16_bits(din[i]);
+  }
+}
+
+void bf16_to_fp32(const bfloat16* din, float* dout, int64_t size) {
+  const uint16_t* in = reinterpret_cast<const uint16_t*>(din);
+  int64_t i = 0;
+  for (; i + 4 <= size; i += 4) {
+    uint32x4_t v = vshll_n_u16(vld1_u16(in + i), 16);
+    vst1q_f32(dout + i, vreinterpretq_f32_u32(v));
+  }
+  for (; i < size; ++i) {
+    dout[i] = bf16_bits_to_fp32(in[i]);
+  }
+}
+
+int64_t gemm_bf16_packb_size(int K, int N) {
+  return static_cast<int64_t>((N + kPanel - 1) / kPanel) * ((K + 1) / 2) * 2 *
+         kPanel;
+}
+
+void gemm_bf16_packb(
+    int K, int N, const float* B, int ldb, bfloat16* packed_B) {
+  gemm_bf16_packb_impl(K, N, B, ldb, packed_B);
+}
+
+void gemm_bf16_packb(
+    int K, int N, const bfloat16* B, int ldb, bfloat16* packed_B) {
+  gemm_bf16_packb_impl(K, N, B, ldb, packed_B);
+}
+
+void gemm_bf16(int M,
+               int N,
+               int K,
+               const float* A,
+               int lda,
+               const bfloat16* packed_B,
+               float* C,
+               int ldc,
+               const float* bias,
+               bool relu,
+               ARMContext* ctx) {
+  if (M <= 0 || N <= 0) {
+    return;
+  }
+#if defined(__aarch64__) && defined(WITH_ARM_BF16)
+  if (ctx->has_bf16()) {
+    gemm_bf16_bfdot(M, N, K, A, lda, packed_B, C, ldc, bias, relu, ctx);
+    return;
+  }
+#endif
+  const int panels = (N + kPanel - 1) / kPanel;
+  const int64_t panel_stride = static_cast<int64_t>((K + 1) / 2) * 2 * kPanel;
+  const uint16_t* b = reinterpret_cast<const uint16_t*>(packed_B);
+  // each panel of B stays in cache while all of the rows of A are computed
+  LITE_PARALLEL_BEGIN(p, tid, panels) {
+    int n0 = p * kPanel;
+    int ncols = std::min(N - n0, kPanel);
+    const uint16_t* bp = b + p * panel_stride;
+    const float* bias_p = bias ? bias + n0 : nullptr;
+    for (int i = 0; i < M; i += kMr) {
+      int mr = std::min(kMr, M - i);
+      gemm_bf16_panel(mr,
+                      K,
+                      A + static_cast<int64_t>(i) * lda,
+                      lda,
+                      bp,
+                      C + static_cast<int64_t>(i) * ldc + n0,
+                      ldc,
+                      ncols,
+                      bias_p,
+                      relu);
+    }
+  }
+  LITE_PARALLEL_END();
+}
+
+}  // namespace math
+}  // namespace arm
+}  // namespace lite
+}  // namespace paddle
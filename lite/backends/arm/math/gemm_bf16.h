@@ -0,0 +1,76 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <stdint.h>
+#include "lite/core/context.h"
+#include "lite/utils/bfloat16.h"
+
+namespace paddle {
+namespace lite {
+namespace arm {
+namespace math {
+
+void fp32_to_bf16(const float* din, bfloat16* dout, int64_t size);
+
+void bf16_to_fp32(const bfloat16* din, float* dout, int64_t size);
+
+// B[K, N] is packed into the panels of 16 columns whose rows are the pairs of
+// k, [ceil(N / 16)][ceil(K / 2)][16][2], padded with zeros. A q register of a
+// row holds the pairs of 4 columns, which is the operand of bfdot.
+int64_t gemm_bf16_packb_size(int K, int N);
+
+void gemm_bf16_packb(
+    int K, int N, const float* B, int ldb, bfloat16* packed_B);
+
+void gemm_bf16_packb(
+    int K, int N, const bfloat16* B, int ldb, bfloat16* packed_B);
+
+// C[M, N] = A[M, K] * B[K, N] + bias[N], followed by relu if `relu` is true.
+// A and C are float and B is packed by gemm_bf16_packb, the bias can be null.
+// B is widened to float in the registers, so only the loads of B are halved,
+// unless the bfdot kernel is built and the cpu supports it.
+void gemm_bf16(int M,
+               int N,
+               int K,
+               const float* A,
+               int lda,
+               const bfloat16* packed_B,
+               float* C,
+               int ldc,
+               const float* bias,
+               bool relu,
+               ARMContext* ctx);
+
+#if defined(__aarch64__) && defined(WITH_ARM_BF16)
+// The same as gemm_bf16, computed by the armv8.6 bfdot with A rounded to bf16.
+// It should be only called if ctx->has_bf16() is true.
+void gemm_bf16_bfdot(int M,
+                     int N,
+                     int K,
+                     const float* A,
+                     int lda,
+                     const bfloat16* packed_B,
+                     float* C,
+                     int ldc,
+                     const float* bias,
+                     bool relu,
+                     ARMContext* ctx);
+#endif
+
+}  // namespace math
+}  // namespace arm
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,154 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// The file is built with +bf16, see lite/backends/arm/math/CMakeLists.txt,
+// and only dispatched on the cpus which support it.
+#if defined(__aarch64__) && defined(WITH_ARM_BF16)
+
+#include <arm_neon.h>
+#include <algorithm>
+#include "lite/backends/arm/math/gemm_bf16.h"
+#include "lite/core/parallel_defines.h"
+
+namespace paddle {
+namespace lite {
+namespace arm {
+namespace math {
+
+namespace {
+
+const int kPanel = 16;
+const int kMr = 4;
+
+// C[MR, ncols] = A[MR, K] * b, A is in bf16 and read as the pairs of k, b is
+// one packed panel. A pair of A is duplicated to the 4 lanes, then bfdot
+// accumulates its products with the pairs of 4 columns.
+template <int MR>
+void gemm_bf16_kernel_bfdot(int kh,
+                            const uint32_t* a,
+                            const uint16_t* b,
+                            float* C,
+                            int ldc,
+                            int ncols,
+                            const float* bias,
+                            bool relu) {
+  float32x4_t acc[MR][4];
+  for (int r = 0; r < MR; ++r) {
+    for (int c = 0; c < 4; ++c) {
+      acc[r][c] = vdupq_n_f32(0.f);
+    }
+  }
+  for (int q = 0; q < kh; ++q) {
+    bfloat16x8_t vb[4];
+    for (int c = 0; c < 4; ++c) {
+      vb[c] = vreinterpretq_bf16_u16(vld1q_u16(b + c * 8));
+    }
+    for (int r = 0; r < MR; ++r) {
+      bfloat16x8_t va = vreinterpretq_bf16_u32(vdupq_n_u32(a[r * kh + q]));
+      for (int c = 0; c < 4; ++c) {
+        acc[r][c] = vbfdotq_f32(acc[r][c], vb[c], va);
+      }
+    }
+    b += 2 * kPanel;
+  }
+
+  const float32x4_t vzero = vdupq_n_f32(0.f);
+  if (ncols == kPanel) {
+    for (int c = 0; c < 4; ++c) {
+      float32x4_t vbias = bias ? vld1q_f32(bias + c * 4) : vzero;
+      for (int r = 0; r < MR; ++r) {
+        float32x4_t v = vaddq_f32(acc[r][c], vbias);
+        if (relu) {
+          v = vmaxq_f32(v, vzero);
+        }
+        vst1q_f32(C + r * ldc + c * 4, v);
+      }
+    }
+  } else {
+    float tile[kPanel];
+    for (int r = 0; r < MR; ++r) {
+      for (int c = 0; c < 4; ++c) {
+        vst1q_f32(tile + c * 4, acc[r][c]);
+      }
+      for (int c = 0; c < ncols; ++c) {
+        float v = tile[c] + (bias ? bias[c] : 0.f);
+        C[r * ldc + c] = relu ? std::max(v, 0.f) : v;
+      }
+    }
+  }
+}
+
+}  // namespace
+
+void gemm_bf16_bfdot(int M,
+                     int N,
+                     int K,
+                     const float* A,
+                     int lda,
+                     const bfloat16* packed_B,
+                     float* C,
+                     int ldc,
+                     const float* bias,
+                     bool relu,
+                     ARMContext* ctx) {
+  const int kh = (K + 1) / 2;
+  const int panels = (N + kPanel - 1) / kPanel;
+  const int64_t panel_stride = static_cast<int64_t>(kh) * 2 * kPanel;
+  const uint16_t* b = reinterpret_cast<const uint16_t*>(packed_B);
+
+  // the rows of A in bf16, each of them is padded to kh pairs
+  ctx->ExtendWorkspace(static_cast<size_t>(M) * kh * sizeof(uint32_t));
+  uint32_t* a_pairs = ctx->workspace_data<uint32_t>();
+  for (int i = 0; i < M; ++i) {
+    if (K & 1) {
+      a_pairs[(i + 1) * kh - 1] = 0;
+    }
+    fp32_to_bf16(A + static_cast<int64_t>(i) * lda,
+                 reinterpret_cast<bfloat16*>(a_pairs + i * kh),
+                 K);
+  }
+
+  LITE_PARALLEL_BEGIN(p, tid, panels) {
+    int n0 = p * kPanel;
+    int ncols = std::min(N - n0, kPanel);
+    const uint16_t* bp = b + p * panel_stride;
+    const float* bias_p = bias ? bias + n0 : nullptr;
+    for (int i = 0; i < M; i += kMr) {
+      const uint32_t* ap = a_pairs + i * kh;
+      float* cp = C + static_cast<int64_t>(i) * ldc + n0;
+      switch (std::min(kMr, M - i)) {
+        case 4:
+          gemm_bf16_kernel_bfdot<4>(kh, ap, bp, cp, ldc, ncols, bias_p, relu);
+          break;
+        case 3:
+          gemm_bf16_kernel_bfdot<3>(kh, ap, bp, cp, ldc, ncols, bias_p, relu);
+          break;
+        case 2:
+          gemm_bf16_kernel_bfdot<2>(kh, ap, bp, cp, ldc, ncols, bias_p, relu);
+          break;
+        default:
+          gemm_bf16_kernel_bfdot<1>(kh, ap, bp, cp, ldc, ncols, bias_p, relu);
+          break;
+      }
+    }
+  }
+  LITE_PARALLEL_END();
+}
+
+}  // namespace math
+}  // namespace arm
+}  // namespace lite
+}  // namespace paddle
+
+#endif  // __aarch64__ && WITH_ARM_BF16
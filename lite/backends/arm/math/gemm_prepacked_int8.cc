@@ -7467,6 +7467,13 @@ void gemm_prepack_int8(const int8_t* A_packed,
 #ifdef __aarch64__
   if (ctx->has_dot()) {
 #ifdef WITH_ARM_DOTPROD
+#ifdef WITH_ARM_I8MM
+    // smmla reads A in the sdot layout, see prepackA_int8
+    if (ctx->has_i8mm()) {
+      gemm_prepack_i8mm_int8<dtype>(IN_PARAMS);
+      return;
+    }
+#endif
     gemm_prepack_sdot_int8<dtype>(IN_PARAMS);
 #endif
   } else {
@@ -99,6 +99,25 @@ void gemm_prepack_int8(const int8_t* A_packed,
                        const operators::ActivationParam act_param,
                        ARMContext* ctx);
 
+#if defined(__aarch64__) && defined(WITH_ARM_I8MM)
+// The int8 gemm with the armv8.6 smmla, A is packed by prepackA_int8 in the
+// sdot layout. flag_act and alpha are the same as gemm_prepack_sdot_int8.
+template <typename dtype>
+void gemm_prepack_i8mm_int8(const int8_t* A_packed,
+                            const int8_t* B,
+                            const float* bias,
+                            dtype* C,
+                            int M,
+                            int N,
+                            int K,
+                            bool is_bias,
+                            int flag_act,
+                            bool is_transB,
+                            const float* scale,
+                            const float* alpha,
+                            ARMContext* ctx);
+#endif
+
 #define ROUNDUP(a, b) ((((a) + (b)-1) / (b)) * (b))
 }  // namespace math
 }  // namespace arm
@@ -0,0 +1,286 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// The file is built with +i8mm, see lite/backends/arm/math/CMakeLists.txt,
+// and only dispatched on the cpus which support it.
+#if defined(__aarch64__) && defined(WITH_ARM_I8MM)
+
+#include <arm_neon.h>
+#include <algorithm>
+#include "lite/backends/arm/math/gemm_prepacked_int8.h"
+#include "lite/core/parallel_defines.h"
+
+namespace paddle {
+namespace lite {
+namespace arm {
+namespace math {
+
+namespace {
+
+const int NBLOCK_INT8_I8MM = 8;
+const int KBLOCK_INT8_I8MM = 8;
+
+// Pack the columns [n0, nmax) of B to the panels of 8 columns. Every panel is
+// [kup / 8][8][8], the 8 consecutive k of the columns, so that a pair of the
+// columns is the right operand of smmla. The columns beyond nmax and the k
+// beyond K are zero.
+void packb_i8mm_int8(int8_t* out,
+                     const int8_t* B,
+                     int ldb,
+                     int K,
+                     int n0,
+                     int nmax,
+                     bool is_trans) {
+  int kup = ROUNDUP(K, KBLOCK_INT8_I8MM);
+  for (int n = n0; n < nmax; n += NBLOCK_INT8_I8MM) {
+    int cols = std::min(NBLOCK_INT8_I8MM, nmax - n);
+    for (int k0 = 0; k0 < kup; k0 += KBLOCK_INT8_I8MM) {
+      int8_t* dout = out + (n - n0) * kup + k0 * NBLOCK_INT8_I8MM;
+      for (int j = 0; j < NBLOCK_INT8_I8MM; ++j) {
+        for (int k = k0; k < k0 + KBLOCK_INT8_I8MM; ++k) {
+          int8_t v = 0;
+          if (j < cols && k < K) {
+            v = is_trans ? B[(n + j) * ldb + k] : B[k * ldb + n + j];
+          }
+          *dout++ = v;
+        }
+      }
+    }
+  }
+}
+
+// Compute the 8x8 int32 tile. The packed A is [kup / 4][8][4], two of the k4
+// groups are zipped to the 2x8 blocks of the row pairs, the odd last group is
+// zipped with zero.
+void gemm_i8mm_int8_kernel(const int8_t* a_ptr,
+                           const int8_t* b_ptr,
+                           int kup,
+                           int32_t* tile) {
+  int32x4_t c[4][4];
+  for (int i = 0; i < 4; ++i) {
+    for (int j = 0; j < 4; ++j) {
+      c[i][j] = vdupq_n_s32(0);
+    }
+  }
+  int groups = kup / KBLOCK_INT8;
+  int32x4_t vzero = vdupq_n_s32(0);
+  for (int g = 0; g < groups; g += 2) {
+    int32x4_t a0 = vreinterpretq_s32_s8(vld1q_s8(a_ptr));
+    int32x4_t a1 = vreinterpretq_s32_s8(vld1q_s8(a_ptr + 16));
+    int32x4_t a2 = vzero;
+    int32x4_t a3 = vzero;
+    if (g + 1 < groups) {
+      a2 = vreinterpretq_s32_s8(vld1q_s8(a_ptr + 32));
+      a3 = vreinterpretq_s32_s8(vld1q_s8(a_ptr + 48));
+    }
+    int8x16_t va[4];
+    va[0] = vreinterpretq_s8_s32(vzip1q_s32(a0, a2));
+    va[1] = vreinterpretq_s8_s32(vzip2q_s32(a0, a2));
+    va[2] = vreinterpretq_s8_s32(vzip1q_s32(a1, a3));
+    va[3] = vreinterpretq_s8_s32(vzip2q_s32(a1, a3));
+    int8x16_t vb[4];
+    vb[0] = vld1q_s8(b_ptr);
+    vb[1] = vld1q_s8(b_ptr + 16);
+    vb[2] = vld1q_s8(b_ptr + 32);
+    vb[3] = vld1q_s8(b_ptr + 48);
+    for (int i = 0; i < 4; ++i) {
+      for (int j = 0; j < 4; ++j) {
+        c[i][j] = vmmlaq_s32(c[i][j], va[i], vb[j]);
+      }
+    }
+    a_ptr += 64;
+    b_ptr += 64;
+  }
+  // c[i][j] is the 2x2 block of the rows 2i, 2i + 1 and the cols 2j, 2j + 1
+  for (int i = 0; i < 4; ++i) {
+    int64x2_t c0 = vreinterpretq_s64_s32(c[i][0]);
+    int64x2_t c1 = vreinterpretq_s64_s32(c[i][1]);
+    int64x2_t c2 = vreinterpretq_s64_s32(c[i][2]);
+    int64x2_t c3 = vreinterpretq_s64_s32(c[i][3]);
+    int32_t* row0 = tile + 2 * i * NBLOCK_INT8_I8MM;
+    int32_t* row1 = row0 + NBLOCK_INT8_I8MM;
+    vst1q_s32(row0, vreinterpretq_s32_s64(vzip1q_s64(c0, c1)));
+    vst1q_s32(row0 + 4, vreinterpretq_s32_s64(vzip1q_s64(c2, c3)));
+    vst1q_s32(row1, vreinterpretq_s32_s64(vzip2q_s64(c0, c1)));
+    vst1q_s32(row1 + 4, vreinterpretq_s32_s64(vzip2q_s64(c2, c3)));
+  }
+}
+
+inline float32x4_t i8mm_act(float32x4_t x,
+                            int flag_act,
+                            const float* alpha) {
+  float32x4_t vzero = vdupq_n_f32(0.f);
+  switch (flag_act) {
+    case 1:
+      return vmaxq_f32(x, vzero);
+    case 2:
+      return vminq_f32(vmaxq_f32(x, vzero), vdupq_n_f32(alpha[0]));
+    case 3:
+      return vbslq_f32(
+          vcgeq_f32(x, vzero), x, vmulq_f32(x, vdupq_n_f32(alpha[0])));
+    case 4: {
+      float32x4_t t = vaddq_f32(x, vdupq_n_f32(alpha[4]));
+      t = vminq_f32(vmaxq_f32(t, vzero), vdupq_n_f32(alpha[8]));
+      return vmulq_f32(vmulq_f32(x, vdupq_n_f32(alpha[0])), t);
+    }
+    default:
+      return x;
+  }
+}
+
+// Write the first n of the 8 results of a row, int32 is written without the
+// scale and the bias like the sdot kernels.
+void i8mm_store_row(const int32_t* in,
+                    int32_t* out,
+                    int n,
+                    float scale,
+                    float bias,
+                    int flag_act,
+                    const float* alpha) {
+  std::copy(in, in + n, out);
+}
+
+void i8mm_store_row(const int32_t* in,
+                    float* out,
+                    int n,
+                    float scale,
+                    float bias,
+                    int flag_act,
+                    const float* alpha) {
+  float tmp[NBLOCK_INT8_I8MM];
+  float* dout = n == NBLOCK_INT8_I8MM ? out : tmp;
+  for (int i = 0; i < NBLOCK_INT8_I8MM; i += 4) {
+    float32x4_t x = vcvtq_f32_s32(vld1q_s32(in + i));
+    x = vmlaq_n_f32(vdupq_n_f32(bias), x, scale);
+    vst1q_f32(dout + i, i8mm_act(x, flag_act, alpha));
+  }
+  if (dout == tmp) {
+    std::copy(tmp, tmp + n, out);
+  }
+}
+
+void i8mm_store_row(const int32_t* in,
+                    int8_t* out,
+                    int n,
+                    float scale,
+                    float bias,
+                    int flag_act,
+                    const float* alpha) {
+  float32x4_t vmin = vdupq_n_f32(-127.f);
+  int16x4_t v16[2];
+  for (int i = 0; i < 2; ++i) {
+    float32x4_t x = vcvtq_f32_s32(vld1q_s32(in + 4 * i));
+    x = vmlaq_n_f32(vdupq_n_f32(bias), x, scale);
+    x = vmaxq_f32(i8mm_act(x, flag_act, alpha), vmin);
+    v16[i] = vqmovn_s32(vcvtaq_s32_f32(x));
+  }
+  int8x8_t v8 = vqmovn_s16(vcombine_s16(v16[0], v16[1]));
+  if (n == NBLOCK_INT8_I8MM) {
+    vst1_s8(out, v8);
+  } else {
+    int8_t tmp[NBLOCK_INT8_I8MM];
+    vst1_s8(tmp, v8);
+    std::copy(tmp, tmp + n, out);
+  }
+}
+
+}  // namespace
+
+template <typename Dtype>
+void gemm_prepack_i8mm_int8(const int8_t* A_packed,
+                            const int8_t* B,
+                            const float* bias,
+                            Dtype* C,
+                            int M,
+                            int N,
+                            int K,
+                            bool is_bias,
+                            int flag_act,
+                            bool is_transB,
+                            const float* scale,
+                            const float* alpha,
+                            ARMContext* ctx) {
+  int kup = ROUNDUP(K, KBLOCK_INT8);
+  int kup_b = ROUNDUP(K, KBLOCK_INT8_I8MM);
+  //! MBLOCK_INT8_DOT * x (result) + MBLOCK_INT8_DOT * k (A) + x * k (B) = l2
+  int llc_size = ctx->llc_size() / 4;
+  int x_block =
+      (llc_size - MBLOCK_INT8_DOT * kup) / (kup_b + MBLOCK_INT8_DOT);
+  x_block = std::max(x_block / NBLOCK_INT8_I8MM * NBLOCK_INT8_I8MM,
+                     NBLOCK_INT8_I8MM);
+  int x_num = (N + x_block - 1) / x_block;
+  x_block = ROUNDUP((N + x_num - 1) / x_num, NBLOCK_INT8_I8MM);
+  // The packed B uses the head of the workspace like the sdot gemm, the
+  // callers keep their buffers after llc_size.
+  auto b_pannel = ctx->workspace_data<int8_t>();
+
+  for (int x0 = 0; x0 < N; x0 += x_block) {
+    int xmax = std::min(x0 + x_block, N);
+    packb_i8mm_int8(b_pannel, B, is_transB ? K : N, K, x0, xmax, is_transB);
+    LITE_PARALLEL_COMMON_BEGIN(y, tid, M, 0, MBLOCK_INT8_DOT) {
+      int rows = std::min(MBLOCK_INT8_DOT, M - y);
+      float bias_local[MBLOCK_INT8_DOT] = {0};
+      float scale_local[MBLOCK_INT8_DOT] = {0};
+      for (int i = 0; i < rows; ++i) {
+        bias_local[i] = is_bias ? bias[y + i] : 0.f;
+        scale_local[i] = scale ? scale[y + i] : 1.f;
+      }
+      const int8_t* a_ptr = A_packed + y * kup;
+      const int8_t* b_ptr = b_pannel;
+      int32_t tile[MBLOCK_INT8_DOT * NBLOCK_INT8_I8MM];
+      for (int x = x0; x < xmax; x += NBLOCK_INT8_I8MM) {
+        gemm_i8mm_int8_kernel(a_ptr, b_ptr, kup, tile);
+        b_ptr += NBLOCK_INT8_I8MM * kup_b;
+        int cols = std::min(NBLOCK_INT8_I8MM, xmax - x);
+        for (int i = 0; i < rows; ++i) {
+          i8mm_store_row(tile + i * NBLOCK_INT8_I8MM,
+                         C + (y + i) * N + x,
+                         cols,
+                         scale_local[i],
+                         bias_local[i],
+                         flag_act,
+                         alpha);
+        }
+      }
+    }
+    LITE_PARALLEL_COMMON_END();
+  }
+}
+
+#define GEMM_PREPACK_I8MM_INT8(dtype)          \
+  template void gemm_prepack_i8mm_int8<dtype>( \
+      const int8_t* A_packed,                  \
+      const int8_t* B,                         \
+      const float* bias,                       \
+      dtype* C,                                \
+      int M,                                   \
+      int N,                                   \
+      int K,                                   \
+      bool is_bias,                            \
+      int flag_act,                            \
+      bool is_transB,                          \
+      const float* scale,                      \
+      const float* alpha,                      \
+      ARMContext* ctx);
+GEMM_PREPACK_I8MM_INT8(int8_t);
+GEMM_PREPACK_I8MM_INT8(float);
+GEMM_PREPACK_I8MM_INT8(int32_t);
+#undef GEMM_PREPACK_I8MM_INT8
+
+}  // namespace math
+}  // namespace arm
+}  // namespace lite
+}  // namespace paddle
+
+#endif  // __aarch64__ && WITH_ARM_I8MM
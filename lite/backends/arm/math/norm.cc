@@ -25,6 +25,7 @@ namespace arm {
 namespace math {
 
 void matrix_norm_row(const float* x_data,
+                     const float* residual_data,
                      const float* scale_data,
                      const float* bias_data,
                      float* out_data,
@@ -38,7 +39,21 @@ void matrix_norm_row(const float* x_data,
 
   LITE_PARALLEL_BEGIN(bi, tid, batch_size) {
     int offset = bi * feature_size;
-    const float* x_ptr = x_data + offset;
+    const float* row_ptr = x_data + offset;
+    if (residual_data) {
+      const float* r_ptr = residual_data + offset;
+      float* sum_ptr = out_data + offset;
+      int i = 0;
+      for (; i + 3 < feature_size; i += 4) {
+        vst1q_f32(sum_ptr + i,
+                  vaddq_f32(vld1q_f32(row_ptr + i), vld1q_f32(r_ptr + i)));
+      }
+      for (; i < feature_size; ++i) {
+        sum_ptr[i] = row_ptr[i] + r_ptr[i];
+      }
+      row_ptr = sum_ptr;
+    }
+    const float* x_ptr = row_ptr;
     float mean = 0.f;
     float variance = 0.f;
 
@@ -81,7 +96,7 @@ void matrix_norm_row(const float* x_data,
     float rvar = 1 / variance;
     // compute norm_out
     float* out_ptr = out_data + offset;
-    x_ptr = x_data + offset;
+    x_ptr = row_ptr;
 
     auto* scale_ptr = scale_data;
     auto* bias_ptr = bias_data;
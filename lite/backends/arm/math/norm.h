@@ -22,7 +22,10 @@ namespace lite {
 namespace arm {
 namespace math {
 
+// Normalize each row of x_data, or of x_data + residual_data if the residual
+// isn't null, the sum is stored in out_data and normalized in place.
 void matrix_norm_row(const float* x_data,
+                     const float* residual_data,
                      const float* scale_data,
                      const float* bias_data,
                      float* out_data,
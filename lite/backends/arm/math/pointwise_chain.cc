@@ -0,0 +1,432 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/backends/arm/math/pointwise_chain.h"
+#include <arm_neon.h>
+#include <string.h>
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include "lite/backends/arm/math/funcs.h"
+#include "lite/core/parallel_defines.h"
+
+namespace paddle {
+namespace lite {
+namespace arm {
+namespace math {
+
+bool ParsePointwiseStepType(const std::string& name, PointwiseStepType* type) {
+  static const std::map<std::string, PointwiseStepType> kStepTypes{
+      {"add", PointwiseStepType::kAdd},
+      {"sub", PointwiseStepType::kSub},
+      {"mul", PointwiseStepType::kMul},
+      {"div", PointwiseStepType::kDiv},
+      {"max", PointwiseStepType::kMax},
+      {"min", PointwiseStepType::kMin},
+      {"scale", PointwiseStepType::kScale},
+      {"clip", PointwiseStepType::kClip},
+      {"relu", PointwiseStepType::kRelu},
+      {"relu6", PointwiseStepType::kRelu6},
+      {"leaky_relu", PointwiseStepType::kLeakyRelu},
+      {"hard_swish", PointwiseStepType::kHardSwish},
+      {"hard_sigmoid", PointwiseStepType::kHardSigmoid},
+      {"sigmoid", PointwiseStepType::kSigmoid},
+      {"tanh", PointwiseStepType::kTanh},
+      {"swish", PointwiseStepType::kSwish},
+      {"exp", PointwiseStepType::kExp},
+      {"abs", PointwiseStepType::kAbs},
+      {"square", PointwiseStepType::kSquare}};
+  auto it = kStepTypes.find(name);
+  if (it == kStepTypes.end()) return false;
+  *type = it->second;
+  return true;
+}
+
+namespace {
+
+// The tile of x and the tile of an operand take 8KB, which stay in L1 through
+// all of the steps.
+const int kTileSize = 1024;
+
+// The functors of the steps have the same operator() for the float32x4_t
+// lanes and the scalar tails, so that each step is compiled into one tight
+// loop over the tile.
+template <typename Op>
+inline void unary_loop(float* x, int len, const Op& op) {
+  int i = 0;
+  for (; i + 7 < len; i += 8) {
+    float32x4_t vx0 = vld1q_f32(x + i);
+    float32x4_t vx1 = vld1q_f32(x + i + 4);
+    vst1q_f32(x + i, op(vx0));
+    vst1q_f32(x + i + 4, op(vx1));
+  }
+  for (; i + 3 < len; i += 4) {
+    vst1q_f32(x + i, op(vld1q_f32(x + i)));
+  }
+  for (; i < len; i++) {
+    x[i] = op(x[i]);
+  }
+}
+
+// y is nullptr if the operand is the same value `ys` in the whole tile.
+template <typename Op>
+inline void binary_loop(
+    float* x, const float* y, float ys, int len, bool reversed, const Op& op) {
+  int i = 0;
+  if (y == nullptr) {
+    float32x4_t vy = vdupq_n_f32(ys);
+    if (reversed) {
+      for (; i + 3 < len; i += 4) {
+        vst1q_f32(x + i, op(vy, vld1q_f32(x + i)));
+      }
+      for (; i < len; i++) {
+        x[i] = op(ys, x[i]);
+      }
+    } else {
+      for (; i + 3 < len; i += 4) {
+        vst1q_f32(x + i, op(vld1q_f32(x + i), vy));
+      }
+      for (; i < len; i++) {
+        x[i] = op(x[i], ys);
+      }
+    }
+    return;
+  }
+  if (reversed) {
+    for (; i + 3 < len; i += 4) {
+      vst1q_f32(x + i, op(vld1q_f32(y + i), vld1q_f32(x + i)));
+    }
+    for (; i < len; i++) {
+      x[i] = op(y[i], x[i]);
+    }
+  } else {
+    for (; i + 3 < len; i += 4) {
+      vst1q_f32(x + i, op(vld1q_f32(x + i), vld1q_f32(y + i)));
+    }
+    for (; i < len; i++) {
+      x[i] = op(x[i], y[i]);
+    }
+  }
+}
+
+struct AddOp {
+  float32x4_t operator()(float32x4_t u, float32x4_t v) const {
+    return vaddq_f32(u, v);
+  }
+  float operator()(float u, float v) const { return u + v; }
+};
+
+struct SubOp {
+  float32x4_t operator()(float32x4_t u, float32x4_t v) const {
+    return vsubq_f32(u, v);
+  }
+  float operator()(float u, float v) const { return u - v; }
+};
+
+struct MulOp {
+  float32x4_t operator()(float32x4_t u, float32x4_t v) const {
+    return vmulq_f32(u, v);
+  }
+  float operator()(float u, float v) const { return u * v; }
+};
+
+struct DivOp {
+  float32x4_t operator()(float32x4_t u, float32x4_t v) const {
+#ifdef __aarch64__
+    return vdivq_f32(u, v);
+#else
+    return div_ps(u, v);
+#endif
+  }
+  float operator()(float u, float v) const { return u / v; }
+};
+
+struct MaxOp {
+  float32x4_t operator()(float32x4_t u, float32x4_t v) const {
+    return vmaxq_f32(u, v);
+  }
+  float operator()(float u, float v) const { return std::max(u, v); }
+};
+
+struct MinOp {
+  float32x4_t operator()(float32x4_t u, float32x4_t v) const {
+    return vminq_f32(u, v);
+  }
+  float operator()(float u, float v) const { return std::min(u, v); }
+};
+
+struct ScaleOp {
+  explicit ScaleOp(const PointwiseStep& step)
+      : a(step.a), b(step.b), va(vdupq_n_f32(a)), vb(vdupq_n_f32(b)) {}
+  float32x4_t operator()(float32x4_t u) const { return vmlaq_f32(vb, u, va); }
+  float operator()(float u) const { return u * a + b; }
+  float a, b;
+  float32x4_t va, vb;
+};
+
+struct ClipOp {
+  explicit ClipOp(const PointwiseStep& step)
+      : a(step.a), b(step.b), va(vdupq_n_f32(a)), vb(vdupq_n_f32(b)) {}
+  float32x4_t operator()(float32x4_t u) const {
+    return vminq_f32(vmaxq_f32(u, va), vb);
+  }
+  float operator()(float u) const { return std::min(std::max(u, a), b); }
+  float a, b;
+  float32x4_t va, vb;
+};
+
+struct ReluOp {
+  float32x4_t operator()(float32x4_t u) const {
+    return vmaxq_f32(u, vdupq_n_f32(0.f));
+  }
+  float operator()(float u) const { return std::max(u, 0.f); }
+};
+
+struct Relu6Op {
+  explicit Relu6Op(const PointwiseStep& step)
+      : a(step.a), va(vdupq_n_f32(a)) {}
+  float32x4_t operator()(float32x4_t u) const {
+    return vminq_f32(vmaxq_f32(u, vdupq_n_f32(0.f)), va);
+  }
+  float operator()(float u) const { return std::min(std::max(u, 0.f), a); }
+  float a;
+  float32x4_t va;
+};
+
+struct LeakyReluOp {
+  explicit LeakyReluOp(const PointwiseStep& step)
+      : a(step.a), va(vdupq_n_f32(a)) {}
+  float32x4_t operator()(float32x4_t u) const {
+    uint32x4_t positive = vcgtq_f32(u, vdupq_n_f32(0.f));
+    return vbslq_f32(positive, u, vmulq_f32(u, va));
+  }
+  float operator()(float u) const { return u > 0.f ? u : u * a; }
+  float a;
+  float32x4_t va;
+};
+
+struct HardSwishOp {
+  explicit HardSwishOp(const PointwiseStep& step)
+      : a(step.a),
+        b_inv(1.f / step.b),
+        c(step.c),
+        va(vdupq_n_f32(a)),
+        vb_inv(vdupq_n_f32(b_inv)),
+        vc(vdupq_n_f32(c)) {}
+  float32x4_t operator()(float32x4_t u) const {
+    float32x4_t t = vaddq_f32(u, vc);
+    t = vminq_f32(vmaxq_f32(t, vdupq_n_f32(0.f)), va);
+    return vmulq_f32(vmulq_f32(u, t), vb_inv);
+  }
+  float operator()(float u) const {
+    return u * std::min(std::max(u + c, 0.f), a) * b_inv;
+  }
+  float a, b_inv, c;
+  float32x4_t va, vb_inv, vc;
+};
+
+struct HardSigmoidOp {
+  explicit HardSigmoidOp(const PointwiseStep& step)
+      : a(step.a), b(step.b), va(vdupq_n_f32(a)), vb(vdupq_n_f32(b)) {}
+  float32x4_t operator()(float32x4_t u) const {
+    float32x4_t t = vminq_f32(vmlaq_f32(vb, u, va), vdupq_n_f32(1.f));
+    return vmaxq_f32(t, vdupq_n_f32(0.f));
+  }
+  float operator()(float u) const {
+    return std::max(std::min(u * a + b, 1.f), 0.f);
+  }
+  float a, b;
+  float32x4_t va, vb;
+};
+
+struct SigmoidOp {
+  float32x4_t operator()(float32x4_t u) const {
+    return vactive_f32<lite_api::ActivationType::kSigmoid>(u);
+  }
+  float operator()(float u) const { return 1.f / (1.f + std::exp(-u)); }
+};
+
+struct TanhOp {
+  float32x4_t operator()(float32x4_t u) const {
+    return vactive_f32<lite_api::ActivationType::kTanh>(u);
+  }
+  float operator()(float u) const { return std::tanh(u); }
+};
+
+struct SwishOp {
+  explicit SwishOp(const PointwiseStep& step)
+      : a(step.a), va(vdupq_n_f32(a)) {}
+  float32x4_t operator()(float32x4_t u) const {
+    return vmulq_f32(u, SigmoidOp()(vmulq_f32(u, va)));
+  }
+  float operator()(float u) const { return u * SigmoidOp()(u * a); }
+  float a;
+  float32x4_t va;
+};
+
+struct ExpOp {
+  float32x4_t operator()(float32x4_t u) const { return exp_ps(u); }
+  float operator()(float u) const { return std::exp(u); }
+};
+
+struct AbsOp {
+  float32x4_t operator()(float32x4_t u) const { return vabsq_f32(u); }
+  float operator()(float u) const { return std::fabs(u); }
+};
+
+struct SquareOp {
+  float32x4_t operator()(float32x4_t u) const { return vmulq_f32(u, u); }
+  float operator()(float u) const { return u * u; }
+};
+
+// Get the operand of the tile [begin, begin + len), it returns the pointer to
+// len values, or nullptr if the tile takes the same value `*ys`.
+const float* operand_tile(
+    const PointwiseStep& step, int64_t begin, int len, float* buf, float* ys) {
+  const int64_t n = step.n;
+  const int64_t post = step.post;
+  if (post == 1) {
+    int64_t offset = begin % n;
+    if (offset + len <= n) {
+      return step.y + offset;
+    }
+    // The tile wraps around the operand.
+    int copied = 0;
+    while (copied < len) {
+      int count =
+          static_cast<int>(std::min<int64_t>(n - offset, len - copied));
+      memcpy(buf + copied, step.y + offset, count * sizeof(float));
+      copied += count;
+      offset = 0;
+    }
+    return buf;
+  }
+  int64_t row = begin / post;
+  int64_t last_row = (begin + len - 1) / post;
+  if (row == last_row) {
+    *ys = step.y[row % n];
+    return nullptr;
+  }
+  int filled = 0;
+  while (filled < len) {
+    int count = static_cast<int>(
+        std::min<int64_t>((row + 1) * post - (begin + filled), len - filled));
+    std::fill_n(buf + filled, count, step.y[row % n]);
+    filled += count;
+    row++;
+  }
+  return buf;
+}
+
+void apply_step(
+    const PointwiseStep& step, float* x, int64_t begin, int len, float* buf) {
+  if (IsBinaryPointwiseStep(step.type)) {
+    float ys = 0.f;
+    const float* y = operand_tile(step, begin, len, buf, &ys);
+    bool reversed = step.reversed;
+    switch (step.type) {
+      case PointwiseStepType::kAdd:
+        binary_loop(x, y, ys, len, false, AddOp());
+        break;
+      case PointwiseStepType::kSub:
+        binary_loop(x, y, ys, len, reversed, SubOp());
+        break;
+      case PointwiseStepType::kMul:
+        binary_loop(x, y, ys, len, false, MulOp());
+        break;
+      case PointwiseStepType::kDiv:
+        binary_loop(x, y, ys, len, reversed, DivOp());
+        break;
+      case PointwiseStepType::kMax:
+        binary_loop(x, y, ys, len, false, MaxOp());
+        break;
+      case PointwiseStepType::kMin:
+        binary_loop(x, y, ys, len, false, MinOp());
+        break;
+      default:
+        break;
+    }
+    return;
+  }
+  switch (step.type) {
+    case PointwiseStepType::kScale:
+      unary_loop(x, len, ScaleOp(step));
+      break;
+    case PointwiseStepType::kClip:
+      unary_loop(x, len, ClipOp(step));
+      break;
+    case PointwiseStepType::kRelu:
+      unary_loop(x, len, ReluOp());
+      break;
+    case PointwiseStepType::kRelu6:
+      unary_loop(x, len, Relu6Op(step));
+      break;
+    case PointwiseStepType::kLeakyRelu:
+      unary_loop(x, len, LeakyReluOp(step));
+      break;
+    case PointwiseStepType::kHardSwish:
+      unary_loop(x, len, HardSwishOp(step));
+      break;
+    case PointwiseStepType::kHardSigmoid:
+      unary_loop(x, len, HardSigmoidOp(step));
+      break;
+    case PointwiseStepType::kSigmoid:
+      unary_loop(x, len, SigmoidOp());
+      break;
+    case PointwiseStepType::kTanh:
+      unary_loop(x, len, TanhOp());
+      break;
+    case PointwiseStepType::kSwish:
+      unary_loop(x, len, SwishOp(step));
+      break;
+    case PointwiseStepType::kExp:
+      unary_loop(x, len, ExpOp());
+      break;
+    case PointwiseStepType::kAbs:
+      unary_loop(x, len, AbsOp());
+      break;
+    case PointwiseStepType::kSquare:
+      unary_loop(x, len, SquareOp());
+      break;
+    default:
+      break;
+  }
+}
+
+}  // namespace
+
+void pointwise_chain(const float* x,
+                     float* out,
+                     int64_t size,
+                     const std::vector<PointwiseStep>& steps) {
+  int num_tiles = static_cast<int>((size + kTileSize - 1) / kTileSize);
+  LITE_PARALLEL_BEGIN(t, tid, num_tiles) {
+    float buf[kTileSize];
+    int64_t begin = static_cast<int64_t>(t) * kTileSize;
+    int len = static_cast<int>(std::min<int64_t>(kTileSize, size - begin));
+    float* tile = out + begin;
+    if (out != x) {
+      memcpy(tile, x + begin, len * sizeof(float));
+    }
+    for (auto& step : steps) {
+      apply_step(step, tile, begin, len, buf);
+    }
+  }
+  LITE_PARALLEL_END();
+}
+
+}  // namespace math
+}  // namespace arm
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,88 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace paddle {
+namespace lite {
+namespace arm {
+namespace math {
+
+enum class PointwiseStepType {
+  // The binary steps, x = x op y, or y op x if the step is reversed.
+  kAdd = 0,
+  kSub,
+  kMul,
+  kDiv,
+  kMax,
+  kMin,
+  // x = x * a + b
+  kScale,
+  // x = min(max(x, a), b)
+  kClip,
+  kRelu,
+  // x = min(max(x, 0), a)
+  kRelu6,
+  // x = x > 0 ? x : x * a
+  kLeakyRelu,
+  // x = x * min(max(x + c, 0), a) / b
+  kHardSwish,
+  // x = min(max(x * a + b, 0), 1)
+  kHardSigmoid,
+  kSigmoid,
+  kTanh,
+  // x = x * sigmoid(x * a)
+  kSwish,
+  kExp,
+  kAbs,
+  kSquare,
+};
+
+/// Get the step type by the name used in the fusion_pointwise_chain op,
+/// returns false if the name is unknown.
+bool ParsePointwiseStepType(const std::string& name, PointwiseStepType* type);
+
+inline bool IsBinaryPointwiseStep(PointwiseStepType type) {
+  return type <= PointwiseStepType::kMin;
+}
+
+struct PointwiseStep {
+  PointwiseStepType type{PointwiseStepType::kRelu};
+  // The second operand of the binary steps, the element i of x is combined
+  // with y[(i / post) % n].
+  const float* y{nullptr};
+  int64_t n{1};
+  int64_t post{1};
+  bool reversed{false};
+  float a{0.f};
+  float b{0.f};
+  float c{0.f};
+};
+
+/// Apply the steps to x in order and write the result to out in one pass over
+/// memory, the data is processed in tiles which stay in L1 through all of the
+/// steps. `out` can be the same as `x`.
+void pointwise_chain(const float* x,
+                     float* out,
+                     int64_t size,
+                     const std::vector<PointwiseStep>& steps);
+
+}  // namespace math
+}  // namespace arm
+}  // namespace lite
+}  // namespace paddle
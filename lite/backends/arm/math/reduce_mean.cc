@@ -15,190 +15,12 @@ limitations under the License. */
 #include "lite/backends/arm/math/reduce_mean.h"
 #include "lite/backends/arm/math/funcs.h"
 #include "lite/core/parallel_defines.h"
-#include "lite/core/tensor.h"
 
 namespace paddle {
 namespace lite {
 namespace arm {
 namespace math {
 
-template <>
-void reduce_mean_n<float>(const float* src,
-                          float* dst,
-                          int num_in,
-                          int channel_in,
-                          int height_in,
-                          int width_in) {
-  int hw_size = height_in * width_in;
-  int chw_size = channel_in * hw_size;
-  int data_index, src_index, src_index0;
-  for (int c = 0; c < channel_in; ++c) {
-    for (int h = 0; h < height_in; ++h) {
-      for (int w = 0; w < width_in; ++w) {
-        data_index = c * hw_size + h * width_in + w;
-        dst[data_index] = 0.0;
-        for (int n = 0; n < num_in; ++n) {
-          src_index = n * chw_size + data_index;
-          dst[data_index] += static_cast<float>(src[src_index]) / num_in;
-        }
-      }
-    }
-  }
-}
-
-template <>
-void reduce_mean_c<float>(const float* src,
-                          float* dst,
-                          int num_in,
-                          int channel_in,
-                          int height_in,
-                          int width_in) {
-  int hw_size = height_in * width_in;
-  int chw_size = hw_size * channel_in;
-  int data_index, src_index0, src_index;
-  for (int n = 0; n < num_in; ++n) {
-    for (int h = 0; h < height_in; ++h) {
-      for (int w = 0; w < width_in; ++w) {
-        data_index = n * hw_size + h * width_in + w;
-        src_index0 = n * chw_size + h * width_in + w;
-        dst[data_index] = 0.0;
-        for (int c = 0; c < channel_in; ++c) {
-          src_index = src_index0 + c * hw_size;
-          dst[data_index] += static_cast<float>(src[src_index]) / channel_in;
-        }
-      }
-    }
-  }
-}
-
-template <>
-void reduce_mean_h<float>(const float* src,
-                          float* dst,
-                          int num_in,
-                          int channel_in,
-                          int height_in,
-                          int width_in) {
-  int cw_size = channel_in * width_in;
-  int chw_size = cw_size * height_in;
-  int hw_size = height_in * width_in;
-  int data_index, src_index, src_index0;
-  for (int n = 0; n < num_in; ++n) {
-    for (int c = 0; c < channel_in; ++c) {
-      for (int w = 0; w < width_in; ++w) {
-        data_index = n * cw_size + c * width_in + w;
-        src_index0 = n * chw_size + c * hw_size + w;
-        dst[data_index] = 0.0;
-        for (int h = 0; h < height_in; ++h) {
-          src_index = src_index0 + h * width_in;
-          dst[data_index] += static_cast<float>(src[src_index]) / height_in;
-        }
-      }
-    }
-  }
-}
-
-template <>
-void reduce_mean_w<float>(const float* src,
-                          float* dst,
-                          int num_in,
-                          int channel_in,
-                          int height_in,
-                          int width_in) {
-  int ch_size = channel_in * height_in;
-  int hw_size = height_in * width_in;
-  int chw_size = ch_size * width_in;
-  int data_index = 0;
-  int src_index0 = 0;
-  int src_index = 0;
-  for (int n = 0; n < num_in; ++n) {
-    for (int c = 0; c < channel_in; ++c) {
-      for (int h = 0; h < height_in; ++h) {
-        data_index = n * ch_size + c * height_in + h;
-        src_index0 = n * chw_size + c * hw_size + h * width_in;
-        dst[data_index] = 0.0;
-        for (int w = 0; w < width_in; ++w) {
-          src_index = src_index0 + w;
-          dst[data_index] += static_cast<float>(src[src_index]) / width_in;
-        }
-      }
-    }
-  }
-}
-
-template <>
-void reduce_mean_all<float>(const float* src,
-                            float* dst,
-                            int num_in,
-                            int channel_in,
-                            int height_in,
-                            int width_in) {
-  float mean = 0.0;
-  int src_index;
-  int n_id, c_id;
-  int all = num_in * channel_in * height_in * width_in;
-  for (int n = 0; n < num_in; ++n) {
-    n_id = n * channel_in * height_in * width_in;
-    for (int c = 0; c < channel_in; ++c) {
-      c_id = c * height_in * width_in;
-      for (int h = 0; h < height_in; ++h) {
-        for (int w = 0; w < width_in; ++w) {
-          src_index = n_id + c_id + h * width_in + w;
-          mean = src[src_index] / all;
-        }
-      }
-    }
-  }
-  dst[0] = mean;
-}
-
-template <>
-void reduce_mean_nc<float>(const float* src,
-                           float* dst,
-                           int num_in,
-                           int channel_in,
-                           int height_in,
-                           int width_in) {
-  // reduce n first.
-  DDimLite ddimA({1, channel_in, height_in, width_in});
-  lite::Tensor tensor_tmp;
-  tensor_tmp.Resize(ddimA);
-  float* tmp_out = tensor_tmp.mutable_data<float>();
-  reduce_mean_n(src, tmp_out, num_in, channel_in, height_in, width_in);
-  reduce_mean_c(tmp_out, dst, 1, channel_in, height_in, width_in);
-}
-
-template <>
-void reduce_mean_ch<float>(const float* src,
-                           float* dst,
-                           int num_in,
-                           int channel_in,
-                           int height_in,
-                           int width_in) {
-  // reduce c first
-  DDimLite ddimA({num_in, 1, height_in, width_in});
-  lite::Tensor tensor_tmp;
-  tensor_tmp.Resize(ddimA);
-  float* tmp_out = tensor_tmp.mutable_data<float>();
-  reduce_mean_c(src, tmp_out, num_in, channel_in, height_in, width_in);
-  reduce_mean_h(tmp_out, dst, num_in, 1, height_in, width_in);
-}
-
-template <>
-void reduce_mean_hw<float>(const float* src,
-                           float* dst,
-                           int num_in,
-                           int channel_in,
-                           int height_in,
-                           int width_in) {
-  // reduce h first
-  DDimLite ddimA({num_in, channel_in, 1, width_in});
-  lite::Tensor tensor_tmp;
-  tensor_tmp.Resize(ddimA);
-  float* tmp_out = tensor_tmp.mutable_data<float>();
-  reduce_mean_h(src, tmp_out, num_in, channel_in, height_in, width_in);
-  reduce_mean_w(tmp_out, dst, num_in, channel_in, 1, width_in);
-}
-
 template <>
 void mean_grad<float>(const float* out_grad, float* in_grad, int size) {
   float grad = out_grad[0] / size;
@@ -0,0 +1,288 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/backends/arm/math/sgemm_batched.h"
+#include <arm_neon.h>
+#include <algorithm>
+#include "lite/backends/arm/math/sgemm.h"
+#include "lite/core/parallel_defines.h"
+
+namespace paddle {
+namespace lite {
+namespace arm {
+namespace math {
+
+namespace {
+
+#ifdef __aarch64__
+constexpr int kMr = 8;
+#else
+constexpr int kMr = 4;
+#endif
+constexpr int kNr = 8;
+// The GEMMs larger than this are parallelized well enough by sgemm alone.
+constexpr int64_t kLargeGemmWork = 1 << 23;
+
+// Pack the rows [m0, m0 + kMr) of alpha * op(A) to [K][kMr], the rows beyond
+// M are zero padded.
+void pack_a_tile(const float* A,
+                 int lda,
+                 bool is_trans,
+                 int M,
+                 int K,
+                 int m0,
+                 float alpha,
+                 float* dst) {
+  int rows = std::min(kMr, M - m0);
+  for (int i = 0; i < kMr; ++i) {
+    if (i >= rows) {
+      for (int k = 0; k < K; ++k) dst[k * kMr + i] = 0.f;
+    } else if (is_trans) {
+      const float* src = A + m0 + i;
+      for (int k = 0; k < K; ++k) dst[k * kMr + i] = alpha * src[k * lda];
+    } else {
+      const float* src = A + (m0 + i) * lda;
+      for (int k = 0; k < K; ++k) dst[k * kMr + i] = alpha * src[k];
+    }
+  }
+}
+
+// Pack the columns [n0, n0 + kNr) of op(B) to [K][kNr], the columns beyond N
+// are zero padded.
+void pack_b_panel(
+    const float* B, int ldb, bool is_trans, int N, int K, int n0, float* dst) {
+  int cols = std::min(kNr, N - n0);
+  for (int k = 0; k < K; ++k) {
+    float* out = dst + k * kNr;
+    for (int j = 0; j < kNr; ++j) {
+      if (j >= cols) {
+        out[j] = 0.f;
+      } else {
+        out[j] = is_trans ? B[(n0 + j) * ldb + k] : B[k * ldb + n0 + j];
+      }
+    }
+  }
+}
+
+template <int LANE>
+inline void mla_row(float32x4_t* acc,
+                    float32x4_t b0,
+                    float32x4_t b1,
+                    float32x4_t a) {
+#ifdef __aarch64__
+  acc[0] = vfmaq_laneq_f32(acc[0], b0, a, LANE);
+  acc[1] = vfmaq_laneq_f32(acc[1], b1, a, LANE);
+#else
+  float32x2_t a_half = LANE < 2 ? vget_low_f32(a) : vget_high_f32(a);
+  acc[0] = vmlaq_lane_f32(acc[0], b0, a_half, LANE & 1);
+  acc[1] = vmlaq_lane_f32(acc[1], b1, a_half, LANE & 1);
+#endif
+}
+
+// C[rows, cols] = packed_a * packed_b + beta * C, the tiles on the edges are
+// computed in full and only the valid part is written.
+void kernel_tile(const float* pa,
+                 const float* pb,
+                 int K,
+                 float beta,
+                 float* C,
+                 int ldc,
+                 int rows,
+                 int cols) {
+  float32x4_t acc[kMr][2];
+  for (int i = 0; i < kMr; ++i) {
+    acc[i][0] = vdupq_n_f32(0.f);
+    acc[i][1] = vdupq_n_f32(0.f);
+  }
+  for (int k = 0; k < K; ++k) {
+    float32x4_t b0 = vld1q_f32(pb);
+    float32x4_t b1 = vld1q_f32(pb + 4);
+    float32x4_t a0 = vld1q_f32(pa);
+    mla_row<0>(acc[0], b0, b1, a0);
+    mla_row<1>(acc[1], b0, b1, a0);
+    mla_row<2>(acc[2], b0, b1, a0);
+    mla_row<3>(acc[3], b0, b1, a0);
+#ifdef __aarch64__
+    float32x4_t a1 = vld1q_f32(pa + 4);
+    mla_row<0>(acc[4], b0, b1, a1);
+    mla_row<1>(acc[5], b0, b1, a1);
+    mla_row<2>(acc[6], b0, b1, a1);
+    mla_row<3>(acc[7], b0, b1, a1);
+#endif
+    pa += kMr;
+    pb += kNr;
+  }
+  bool has_beta = beta != 0.f;
+  if (rows == kMr && cols == kNr) {
+    for (int i = 0; i < kMr; ++i) {
+      float* c = C + i * ldc;
+      if (has_beta) {
+        acc[i][0] = vmlaq_n_f32(acc[i][0], vld1q_f32(c), beta);
+        acc[i][1] = vmlaq_n_f32(acc[i][1], vld1q_f32(c + 4), beta);
+      }
+      vst1q_f32(c, acc[i][0]);
+      vst1q_f32(c + 4, acc[i][1]);
+    }
+    return;
+  }
+  float tile[kMr * kNr];
+  for (int i = 0; i < kMr; ++i) {
+    vst1q_f32(tile + i * kNr, acc[i][0]);
+    vst1q_f32(tile + i * kNr + 4, acc[i][1]);
+  }
+  for (int i = 0; i < rows; ++i) {
+    float* c = C + i * ldc;
+    for (int j = 0; j < cols; ++j) {
+      c[j] = has_beta ? tile[i * kNr + j] + beta * c[j] : tile[i * kNr + j];
+    }
+  }
+}
+
+}  // namespace
+
+void sgemm_batched(bool is_transA,
+                   bool is_transB,
+                   int batch,
+                   int M,
+                   int N,
+                   int K,
+                   float alpha,
+                   const float* A,
+                   int lda,
+                   int64_t stride_a,
+                   const float* B,
+                   int ldb,
+                   int64_t stride_b,
+                   float beta,
+                   float* C,
+                   int ldc,
+                   int64_t stride_c,
+                   ARMContext* ctx) {
+  if (batch <= 0 || M <= 0 || N <= 0) return;
+  operators::ActivationParam act_param;
+  act_param.has_active = false;
+  // The broadcast B with the contiguous rows of A and C is one GEMM of
+  // batch * M rows.
+  if (batch == 1 || (stride_b == 0 && !is_transA &&
+                     stride_a == static_cast<int64_t>(M) * lda &&
+                     stride_c == static_cast<int64_t>(M) * ldc)) {
+    sgemm(is_transA,
+          is_transB,
+          batch * M,
+          N,
+          K,
+          alpha,
+          A,
+          lda,
+          B,
+          ldb,
+          beta,
+          C,
+          ldc,
+          nullptr,
+          false,
+          act_param,
+          ctx);
+    return;
+  }
+  int64_t work = static_cast<int64_t>(M) * N * K;
+  if (ctx->threads() == 1 || work >= kLargeGemmWork) {
+    for (int i = 0; i < batch; ++i) {
+      sgemm(is_transA,
+            is_transB,
+            M,
+            N,
+            K,
+            alpha,
+            A + i * stride_a,
+            lda,
+            B + i * stride_b,
+            ldb,
+            beta,
+            C + i * stride_c,
+            ldc,
+            nullptr,
+            false,
+            act_param,
+            ctx);
+    }
+    return;
+  }
+
+  // The small GEMMs: every distinct A and B is packed once, then the batches
+  // and the row tiles are computed in one parallel region.
+  int m_tiles = (M + kMr - 1) / kMr;
+  int n_panels = (N + kNr - 1) / kNr;
+  int count_a = stride_a == 0 ? 1 : batch;
+  int count_b = stride_b == 0 ? 1 : batch;
+  int64_t size_a = static_cast<int64_t>(m_tiles) * kMr * K;
+  int64_t size_b = static_cast<int64_t>(n_panels) * kNr * K;
+  ctx->ExtendWorkspace((count_a * size_a + count_b * size_b) * sizeof(float));
+  float* packed_a = ctx->workspace_data<float>();
+  float* packed_b = packed_a + count_a * size_a;
+
+  int a_jobs = count_a * m_tiles;
+  int b_jobs = count_b * n_panels;
+  LITE_PARALLEL_BEGIN(j, tid, a_jobs + b_jobs) {
+    if (j < a_jobs) {
+      int i = j / m_tiles;
+      int t = j % m_tiles;
+      pack_a_tile(A + i * stride_a,
+                  lda,
+                  is_transA,
+                  M,
+                  K,
+                  t * kMr,
+                  alpha,
+                  packed_a + i * size_a + t * kMr * K);
+    } else {
+      int i = (j - a_jobs) / n_panels;
+      int p = (j - a_jobs) % n_panels;
+      pack_b_panel(B + i * stride_b,
+                   ldb,
+                   is_transB,
+                   N,
+                   K,
+                   p * kNr,
+                   packed_b + i * size_b + p * kNr * K);
+    }
+  }
+  LITE_PARALLEL_END();
+
+  LITE_PARALLEL_BEGIN(j, tid, batch * m_tiles) {
+    int i = j / m_tiles;
+    int t = j % m_tiles;
+    const float* pa =
+        packed_a + (stride_a == 0 ? 0 : i) * size_a + t * kMr * K;
+    const float* pb = packed_b + (stride_b == 0 ? 0 : i) * size_b;
+    float* c = C + i * stride_c + t * kMr * ldc;
+    int rows = std::min(kMr, M - t * kMr);
+    for (int p = 0; p < n_panels; ++p) {
+      kernel_tile(pa,
+                  pb + p * kNr * K,
+                  K,
+                  beta,
+                  c + p * kNr,
+                  ldc,
+                  rows,
+                  std::min(kNr, N - p * kNr));
+    }
+  }
+  LITE_PARALLEL_END();
+}
+
+}  // namespace math
+}  // namespace arm
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,52 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <stdint.h>
+#include "lite/core/context.h"
+
+namespace paddle {
+namespace lite {
+namespace arm {
+namespace math {
+
+/// C[i] = alpha * op(A[i]) * op(B[i]) + beta * C[i] for i in [0, batch), the
+/// matrices of the batch i start at A + i * stride_a, B + i * stride_b and
+/// C + i * stride_c, and the zero stride broadcasts one matrix to all of the
+/// batches. The small GEMMs are run in one parallel region over the batches
+/// and the row blocks, and a broadcast matrix is packed only once.
+void sgemm_batched(bool is_transA,
+                   bool is_transB,
+                   int batch,
+                   int M,
+                   int N,
+                   int K,
+                   float alpha,
+                   const float* A,
+                   int lda,
+                   int64_t stride_a,
+                   const float* B,
+                   int ldb,
+                   int64_t stride_b,
+                   float beta,
+                   float* C,
+                   int ldc,
+                   int64_t stride_c,
+                   ARMContext* ctx);
+
+}  // namespace math
+}  // namespace arm
+}  // namespace lite
+}  // namespace paddle
@@ -14,6 +14,7 @@
 
 #include "lite/backends/arm/math/softmax.h"
 #include <algorithm>
+#include <limits>
 #include "lite/backends/arm/math/funcs.h"
 #include "lite/core/parallel_defines.h"
 
@@ -509,74 +510,94 @@ void softmax_inner4<float>(const float* din,
   }
 }
 
+namespace {
+
+inline float max_row(const float* din, int size) {
+  int cnt = size >> 2;
+  float max_data = din[0];
+  if (cnt > 0) {
+    float32x4_t vmax = vld1q_f32(din);
+    for (int j = 1; j < cnt; ++j) {
+      vmax = vmaxq_f32(vmax, vld1q_f32(din + j * 4));
+    }
+    float32x2_t vhmax = vmax_f32(vget_high_f32(vmax), vget_low_f32(vmax));
+    max_data = std::max(vget_lane_f32(vhmax, 0), vget_lane_f32(vhmax, 1));
+  }
+  for (int j = cnt * 4; j < size; ++j) {
+    max_data = std::max(max_data, din[j]);
+  }
+  return max_data;
+}
+
+// dout = exp(din - max_data), returns the sum of dout.
+inline float exp_row(const float* din, float* dout, int size, float max_data) {
+  int cnt = size >> 2;
+  float32x4_t vmax = vdupq_n_f32(max_data);
+  float32x4_t vsum = vdupq_n_f32(0.f);
+  for (int j = 0; j < cnt; ++j) {
+    float32x4_t vexp = exp_ps(vsubq_f32(vld1q_f32(din + j * 4), vmax));
+    vst1q_f32(dout + j * 4, vexp);
+    vsum = vaddq_f32(vsum, vexp);
+  }
+  float32x2_t vhsum = vadd_f32(vget_high_f32(vsum), vget_low_f32(vsum));
+  float sum_data = vget_lane_f32(vhsum, 0) + vget_lane_f32(vhsum, 1);
+  for (int j = cnt * 4; j < size; ++j) {
+    dout[j] = expf(din[j] - max_data);
+    sum_data += dout[j];
+  }
+  return sum_data;
+}
+
+inline void scale_row(float* dout, int size, float scale) {
+  int cnt = size >> 2;
+  float32x4_t vscale = vdupq_n_f32(scale);
+  for (int j = 0; j < cnt; ++j) {
+    vst1q_f32(dout + j * 4, vmulq_f32(vld1q_f32(dout + j * 4), vscale));
+  }
+  for (int j = cnt * 4; j < size; ++j) {
+    dout[j] *= scale;
+  }
+}
+
+}  // namespace
+
+// The online softmax, the row is processed in the blocks which stay in L1. The
+// exp of each block is taken with the running max and the sum is rescaled
+// when the max grows, so the input is read from memory only once. The blocks
+// taken with the smaller max are corrected while the row is normalized.
 template <>
 void softmax_inner1_large_axis<float>(const float* din,
                                       float* dout,
                                       const int outer_size,
                                       const int axis_size) {
+  const int kMaxBlocks = 64;
+  int block_size = (axis_size + kMaxBlocks - 1) / kMaxBlocks;
+  block_size = std::max(1024, (block_size + 3) / 4 * 4);
   LITE_PARALLEL_BEGIN(i, tid, outer_size) {
     const float* din_ptr = din + i * axis_size;
     float* dout_ptr = dout + i * axis_size;
-
-    const float* din_max_ptr = din_ptr;
-    int nn = axis_size >> 2;
-
-    // get max
-    float32x4_t vmax = vld1q_f32(din_max_ptr);
-    din_max_ptr += 4;
-    int j = 1;
-    for (; j < nn; ++j) {
-      vmax = vmaxq_f32(vmax, vld1q_f32(din_max_ptr));
-      din_max_ptr += 4;
-    }
-    float32x2_t vhmax = vmax_f32(vget_high_f32(vmax), vget_low_f32(vmax));
-    float max_data = std::max(vget_lane_f32(vhmax, 0), vget_lane_f32(vhmax, 1));
-    for (j = 4 * nn; j < axis_size; ++j) {
-      max_data = std::max(max_data, din_max_ptr[0]);
-      din_max_ptr++;
-    }
-
-    // sub, exp and sum
-    const float* din_sum_ptr = din_ptr;
-    float* dout_sum_ptr = dout_ptr;
-    vmax = vdupq_n_f32(max_data);
-    float32x4_t vsub_exp = exp_ps(vsubq_f32(vld1q_f32(din_sum_ptr), vmax));
-    float32x4_t vsum = vsub_exp;
-    vst1q_f32(dout_sum_ptr, vsub_exp);
-    din_sum_ptr += 4;
-    dout_sum_ptr += 4;
-
-    j = 1;
-    for (; j < nn; ++j) {
-      vsub_exp = exp_ps(vsubq_f32(vld1q_f32(din_sum_ptr), vmax));
-      vst1q_f32(dout_sum_ptr, vsub_exp);
-      vsum = vaddq_f32(vsum, vsub_exp);
-      din_sum_ptr += 4;
-      dout_sum_ptr += 4;
-    }
-    float32x2_t vhsum = vadd_f32(vget_high_f32(vsum), vget_low_f32(vsum));
-    float sum_data = vget_lane_f32(vhsum, 0) + vget_lane_f32(vhsum, 1);
-
-    for (j = 4 * nn; j < axis_size; ++j) {
-      dout_sum_ptr[0] = expf(din_sum_ptr[0] - max_data);
-      sum_data += dout_sum_ptr[0];
-      din_sum_ptr++;
-      dout_sum_ptr++;
+    float block_max[kMaxBlocks];
+    float max_data = std::numeric_limits<float>::lowest();
+    float sum_data = 0.f;
+    int num_blocks = 0;
+    for (int start = 0; start < axis_size; start += block_size) {
+      int size = std::min(block_size, axis_size - start);
+      float cur_max = max_row(din_ptr + start, size);
+      if (cur_max > max_data) {
+        sum_data *= expf(max_data - cur_max);
+        max_data = cur_max;
+      }
+      block_max[num_blocks++] = max_data;
+      sum_data += exp_row(din_ptr + start, dout_ptr + start, size, max_data);
     }
-
     float sum_inv = 1.f / sum_data;
-    float* dout_res_ptr = dout_ptr;
-    float32x4_t vinv = vdupq_n_f32(sum_inv);
-    // get softmax result
-    j = 0;
-    for (; j < nn; ++j) {
-      float32x4_t vout = vld1q_f32(dout_res_ptr);
-      float32x4_t vres = vmulq_f32(vout, vinv);
-      vst1q_f32(dout_res_ptr, vres);
-      dout_res_ptr += 4;
-    }
-    for (j = nn * 4; j < axis_size; ++j) {
-      dout_ptr[j] *= sum_inv;
+    for (int b = 0; b < num_blocks; ++b) {
+      int start = b * block_size;
+      int size = std::min(block_size, axis_size - start);
+      float scale = block_max[b] == max_data
+                        ? sum_inv
+                        : expf(block_max[b] - max_data) * sum_inv;
+      scale_row(dout_ptr + start, size, scale);
     }
   }
   LITE_PARALLEL_END();
@@ -13,6 +13,8 @@
 // limitations under the License.
 
 #pragma once
+#include <vector>
+#include "lite/backends/host/math/topk.h"
 #include "lite/core/context.h"
 
 namespace paddle {
@@ -20,6 +22,25 @@ namespace lite {
 namespace host {
 namespace math {
 
+// The buffers of the decode steps, which are kept by the kernel so that a
+// step allocates nothing once they are as large as the step needs.
+struct BeamSearchScratch {
+  // the best beam_size candidates of each prefix, the best one first
+  std::vector<float> row_scores;
+  std::vector<int64_t> row_ids;
+  std::vector<int> row_counts;
+  // the candidates of a source, gathered from its prefixes
+  std::vector<float> cand_scores;
+  std::vector<int> cand_pos;
+  std::vector<int> picked;
+  // the selected items of all of the sources, grouped by the prefix
+  std::vector<int> sel_rows;
+  std::vector<int64_t> sel_ids;
+  std::vector<float> sel_scores;
+  std::vector<uint64_t> low_level;
+  std::vector<TopkSelector<float>> selectors;
+};
+
 void beam_search(const Tensor* pre_ids,
                  const Tensor* pre_scores,
                  const Tensor* ids,
@@ -30,7 +51,8 @@ void beam_search(const Tensor* pre_ids,
                  int level,
                  int beam_size,
                  int end_id,
-                 bool is_accumulated);
+                 bool is_accumulated,
+                 BeamSearchScratch* scratch = nullptr);
 
 }  // namespace math
 }  // namespace host
@@ -15,6 +15,7 @@
 #pragma once
 
 #include <algorithm>
+#include <cstring>
 #include <string>
 #include <vector>
 #include "lite/operators/op_params.h"
@@ -59,6 +60,64 @@ void concat_func(const std::vector<lite::Tensor*>& input,
   }
 }
 
+// Concat the inputs when all of the dims before axis are 1, so that every
+// input is a contiguous piece of the output, returns false otherwise. The
+// inputs which are already the views of their pieces aren't copied. If
+// `make_views` is true, the inputs are made the views of their pieces
+// afterwards, so that their producers write into the output directly from
+// the next run and the copies are skipped.
+template <typename T>
+bool concat_views(const std::vector<lite::Tensor*>& input,
+                  const int axis,
+                  bool make_views,
+                  lite::Tensor* output) {
+  auto out_dims = output->dims();
+  if (out_dims.count(0, axis) != 1 || out_dims.production() == 0) {
+    return false;
+  }
+  size_t out_size = out_dims.production() * sizeof(T);
+  // The input views whose pieces move, as the sizes of the inputs before them
+  // change, may be overwritten by the copies of the other inputs.
+  bool moved = false;
+  size_t offset = 0;
+  if (output->IsInitialized()) {
+    auto* old_ptr = reinterpret_cast<const char*>(output->raw_data());
+    for (auto* in : input) {
+      moved = moved || (in->SharesBufferWith(*output) &&
+                        in->raw_data() != old_ptr + offset);
+      offset += in->numel() * sizeof(T);
+    }
+  }
+  // The pieces written by the producers stay in the old buffer, which is kept
+  // alive by the input views, until they are copied into the new one.
+  if (moved || out_size > output->capacity()) {
+    output->DetachBuffer();
+  }
+  auto* dst_ptr = reinterpret_cast<char*>(output->mutable_data<T>());
+  offset = 0;
+  for (auto* in : input) {
+    size_t in_size = in->numel() * sizeof(T);
+    if (in->raw_data() != dst_ptr + offset) {
+      std::memcpy(dst_ptr + offset, in->raw_data(), in_size);
+    }
+    offset += in_size;
+  }
+  CHECK_EQ(offset, out_size);
+  if (!make_views) return true;
+  offset = 0;
+  for (auto* in : input) {
+    size_t in_size = in->numel() * sizeof(T);
+    // An input concatenated twice can only be the view of one piece.
+    if (in_size > 0 && std::count(input.begin(), input.end(), in) == 1) {
+      auto lod = in->lod();
+      in->ShareDataWith(*output, offset, in->dims());
+      in->set_lod(lod);
+    }
+    offset += in_size;
+  }
+  return true;
+}
+
 }  // namespace math
 }  // namespace host
 }  // namespace lite
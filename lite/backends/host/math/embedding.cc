@@ -0,0 +1,391 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/backends/host/math/embedding.h"
+#include <string.h>
+#include <algorithm>
+#include <cmath>
+#include "lite/core/parallel_defines.h"
+#include "lite/utils/log/cp_logging.h"
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define EMBEDDING_WITH_NEON
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define EMBEDDING_WITH_SSE2
+#endif
+
+namespace paddle {
+namespace lite {
+namespace host {
+namespace math {
+
+namespace {
+
+// The head of a row which is prefetched, the rest of it is sequential to
+// the head, which is left to the hardware prefetcher.
+const int64_t kPrefetchBytes = 256;
+const int64_t kCacheLine = 64;
+
+inline void prefetch_row(const EmbeddingTable& table, int64_t id) {
+#if defined(__GNUC__) || defined(__clang__)
+  if (id < 0 || id >= table.rows) {
+    return;
+  }
+  const char* row =
+      reinterpret_cast<const char*>(table.data + id * table.stride());
+  int64_t bytes =
+      std::min(kPrefetchBytes,
+               static_cast<int64_t>(table.stride() * sizeof(float)));
+  for (int64_t b = 0; b < bytes; b += kCacheLine) {
+    __builtin_prefetch(row + b, 0, 1);
+  }
+#endif
+}
+
+inline void check_id(int64_t id, int64_t rows) {
+  CHECK_LT(id, rows) << "look uptable ids[i] < row_number check failed";
+  CHECK_GE(id, 0) << "lookuptable ids[i] >= 0 check failed";
+}
+
+// acc[0, width) += row[0, width)
+inline void add_row(const float* row, int64_t width, float* acc) {
+  int64_t i = 0;
+#ifdef EMBEDDING_WITH_NEON
+  for (; i + 8 <= width; i += 8) {
+    float32x4_t a0 = vld1q_f32(acc + i);
+    float32x4_t a1 = vld1q_f32(acc + i + 4);
+    vst1q_f32(acc + i, vaddq_f32(a0, vld1q_f32(row + i)));
+    vst1q_f32(acc + i + 4, vaddq_f32(a1, vld1q_f32(row + i + 4)));
+  }
+#elif defined(EMBEDDING_WITH_SSE2)
+  for (; i + 8 <= width; i += 8) {
+    __m128 a0 = _mm_loadu_ps(acc + i);
+    __m128 a1 = _mm_loadu_ps(acc + i + 4);
+    _mm_storeu_ps(acc + i, _mm_add_ps(a0, _mm_loadu_ps(row + i)));
+    _mm_storeu_ps(acc + i + 4, _mm_add_ps(a1, _mm_loadu_ps(row + i + 4)));
+  }
+#endif
+  for (; i < width; ++i) {
+    acc[i] += row[i];
+  }
+}
+
+// out[0, width) /= div, divided rather than multiplied by the reciprocal, so
+// the result is the same as the one of sequence_pool.
+inline void div_row(float div, int64_t width, float* out) {
+  int64_t i = 0;
+#if defined(EMBEDDING_WITH_NEON) && defined(__aarch64__)
+  float32x4_t vdiv = vdupq_n_f32(div);
+  for (; i + 4 <= width; i += 4) {
+    vst1q_f32(out + i, vdivq_f32(vld1q_f32(out + i), vdiv));
+  }
+#elif defined(EMBEDDING_WITH_SSE2)
+  __m128 vdiv = _mm_set1_ps(div);
+  for (; i + 4 <= width; i += 4) {
+    _mm_storeu_ps(out + i, _mm_div_ps(_mm_loadu_ps(out + i), vdiv));
+  }
+#endif
+  for (; i < width; ++i) {
+    out[i] /= div;
+  }
+}
+
+// Decodes a row of kUInt8MinMax to the width floats of out.
+void decode_uint8_row(const float* row, int64_t width, float* out) {
+  float min = row[0];
+  float max = row[1];
+  float scale = (max - min) / 256;
+  const uint8_t* codes = reinterpret_cast<const uint8_t*>(row + 2);
+  int64_t i = 0;
+#ifdef EMBEDDING_WITH_NEON
+  float32x4_t vscale = vdupq_n_f32(scale);
+  float32x4_t vmin = vdupq_n_f32(min);
+  for (; i + 8 <= width; i += 8) {
+    uint16x8_t c16 = vmovl_u8(vld1_u8(codes + i));
+    float32x4_t c0 = vcvtq_f32_u32(vmovl_u16(vget_low_u16(c16)));
+    float32x4_t c1 = vcvtq_f32_u32(vmovl_u16(vget_high_u16(c16)));
+    vst1q_f32(out + i, vaddq_f32(vmulq_f32(c0, vscale), vmin));
+    vst1q_f32(out + i + 4, vaddq_f32(vmulq_f32(c1, vscale), vmin));
+  }
+#elif defined(EMBEDDING_WITH_SSE2)
+  __m128 vscale = _mm_set1_ps(scale);
+  __m128 vmin = _mm_set1_ps(min);
+  __m128i vzero = _mm_setzero_si128();
+  for (; i + 8 <= width; i += 8) {
+    __m128i c8 =
+        _mm_loadl_epi64(reinterpret_cast<const __m128i*>(codes + i));
+    __m128i c16 = _mm_unpacklo_epi8(c8, vzero);
+    __m128 c0 = _mm_cvtepi32_ps(_mm_unpacklo_epi16(c16, vzero));
+    __m128 c1 = _mm_cvtepi32_ps(_mm_unpackhi_epi16(c16, vzero));
+    _mm_storeu_ps(out + i, _mm_add_ps(_mm_mul_ps(c0, vscale), vmin));
+    _mm_storeu_ps(out + i + 4, _mm_add_ps(_mm_mul_ps(c1, vscale), vmin));
+  }
+#endif
+  for (; i < width; ++i) {
+    out[i] = scale * static_cast<int>(codes[i]) + min;
+  }
+}
+
+// Assigns a slot to each of the distinct ids, scratch->slots[i] is the slot
+// of ids[i] and scratch->first[s] is the first index of the id of slot s.
+// The ids of padding_idx have no slot.
+void assign_slots(const int64_t* ids,
+                  int64_t num,
+                  int64_t rows,
+                  int64_t padding_idx,
+                  EmbeddingScratch* scratch) {
+  scratch->slot_of_id.clear();
+  scratch->first.clear();
+  scratch->slots.resize(num);
+  for (int64_t i = 0; i < num; ++i) {
+    int64_t id = ids[i];
+    if (padding_idx != -1 && id == padding_idx) {
+      scratch->slots[i] = -1;
+      continue;
+    }
+    check_id(id, rows);
+    auto res = scratch->slot_of_id.emplace(
+        id, static_cast<int64_t>(scratch->first.size()));
+    if (res.second) {
+      scratch->first.push_back(i);
+    }
+    scratch->slots[i] = res.first->second;
+  }
+}
+
+void lookup_float(const EmbeddingTable& table,
+                  const int64_t* ids,
+                  int64_t num,
+                  int64_t padding_idx,
+                  float* out) {
+  const int64_t width = table.width;
+  int tasks = (num + kEmbeddingIdsPerTask - 1) / kEmbeddingIdsPerTask;
+  LITE_PARALLEL_BEGIN(t, tid, tasks) {
+    int64_t begin = static_cast<int64_t>(t) * kEmbeddingIdsPerTask;
+    int64_t end = std::min(num, begin + kEmbeddingIdsPerTask);
+    for (int64_t i = begin; i < end; ++i) {
+      if (i + kEmbeddingPrefetchDistance < end) {
+        prefetch_row(table, ids[i + kEmbeddingPrefetchDistance]);
+      }
+      int64_t id = ids[i];
+      float* dout = out + i * width;
+      if (padding_idx != -1 && id == padding_idx) {
+        memset(dout, 0, width * sizeof(float));
+      } else {
+        check_id(id, table.rows);
+        memcpy(dout, table.data + id * width, width * sizeof(float));
+      }
+    }
+  }
+  LITE_PARALLEL_END();
+}
+
+// Each of the distinct rows is decoded at the first index of its id, then
+// copied to the other ones.
+void lookup_uint8(const EmbeddingTable& table,
+                  const int64_t* ids,
+                  int64_t num,
+                  int64_t padding_idx,
+                  float* out,
+                  EmbeddingScratch* scratch) {
+  const int64_t width = table.width;
+  const int64_t stride = table.stride();
+  assign_slots(ids, num, table.rows, padding_idx, scratch);
+  const int64_t* slots = scratch->slots.data();
+  const int64_t* first = scratch->first.data();
+  int tasks = (num + kEmbeddingIdsPerTask - 1) / kEmbeddingIdsPerTask;
+  LITE_PARALLEL_BEGIN(t, tid, tasks) {
+    int64_t begin = static_cast<int64_t>(t) * kEmbeddingIdsPerTask;
+    int64_t end = std::min(num, begin + kEmbeddingIdsPerTask);
+    for (int64_t i = begin; i < end; ++i) {
+      if (i + kEmbeddingPrefetchDistance < end) {
+        prefetch_row(table, ids[i + kEmbeddingPrefetchDistance]);
+      }
+      float* dout = out + i * width;
+      if (slots[i] < 0) {
+        memset(dout, 0, width * sizeof(float));
+      } else if (first[slots[i]] == i) {
+        decode_uint8_row(table.data + ids[i] * stride, width, dout);
+      }
+    }
+  }
+  LITE_PARALLEL_END();
+  LITE_PARALLEL_BEGIN(t, tid, tasks) {
+    int64_t begin = static_cast<int64_t>(t) * kEmbeddingIdsPerTask;
+    int64_t end = std::min(num, begin + kEmbeddingIdsPerTask);
+    for (int64_t i = begin; i < end; ++i) {
+      if (slots[i] >= 0 && first[slots[i]] != i) {
+        memcpy(out + i * width,
+               out + first[slots[i]] * width,
+               width * sizeof(float));
+      }
+    }
+  }
+  LITE_PARALLEL_END();
+}
+
+// Pools the float rows of table, the ids are the ones of embedding_seq_pool
+// or the slots of the decoded rows.
+void seq_pool_float(const EmbeddingTable& table,
+                    const int64_t* ids,
+                    const uint64_t* lod,
+                    int64_t batch,
+                    int64_t ids_per_row,
+                    int64_t padding_idx,
+                    EmbeddingPoolType pool_type,
+                    float pad_value,
+                    float* out) {
+  const int64_t width = table.width;
+  const int64_t out_width = ids_per_row * width;
+  int tasks = (batch + kEmbeddingSeqsPerTask - 1) / kEmbeddingSeqsPerTask;
+  LITE_PARALLEL_BEGIN(t, tid, tasks) {
+    int64_t seq_end = std::min(
+        batch, static_cast<int64_t>(t + 1) * kEmbeddingSeqsPerTask);
+    for (int64_t s = static_cast<int64_t>(t) * kEmbeddingSeqsPerTask;
+         s < seq_end;
+         ++s) {
+      int64_t height = static_cast<int64_t>(lod[s + 1] - lod[s]);
+      float* dout = out + s * out_width;
+      if (height <= 0) {
+        std::fill(dout, dout + out_width, pad_value);
+        continue;
+      }
+      for (int64_t j = 0; j < ids_per_row; ++j) {
+        const int64_t* col = ids + lod[s] * ids_per_row + j;
+        float* acc = dout + j * width;
+        for (int64_t h = 0; h < height; ++h) {
+          if (h + kEmbeddingPrefetchDistance < height) {
+            prefetch_row(table,
+                         col[(h + kEmbeddingPrefetchDistance) * ids_per_row]);
+          }
+          int64_t id = col[h * ids_per_row];
+          bool padding = padding_idx != -1 && id == padding_idx;
+          if (!padding) {
+            check_id(id, table.rows);
+          }
+          // the first row is copied and the others are added, as
+          // sequence_pool does, the rows of padding are zeros
+          if (h == 0) {
+            if (padding) {
+              memset(acc, 0, width * sizeof(float));
+            } else {
+              memcpy(acc, table.data + id * width, width * sizeof(float));
+            }
+          } else if (!padding) {
+            add_row(table.data + id * width, width, acc);
+          }
+        }
+      }
+      if (pool_type == EmbeddingPoolType::kAverage) {
+        div_row(static_cast<float>(height), out_width, dout);
+      } else if (pool_type == EmbeddingPoolType::kSqrt) {
+        div_row(sqrtf(height), out_width, dout);
+      }
+    }
+  }
+  LITE_PARALLEL_END();
+}
+
+}  // namespace
+
+void embedding_lookup(const EmbeddingTable& table,
+                      const int64_t* ids,
+                      int64_t num,
+                      int64_t padding_idx,
+                      float* out,
+                      EmbeddingScratch* scratch) {
+  if (num <= 0) {
+    return;
+  }
+  if (table.format == EmbeddingFormat::kFloat) {
+    lookup_float(table, ids, num, padding_idx, out);
+  } else {
+    lookup_uint8(table, ids, num, padding_idx, out, scratch);
+  }
+}
+
+void embedding_seq_pool(const EmbeddingTable& table,
+                        const int64_t* ids,
+                        const uint64_t* lod,
+                        int64_t batch,
+                        int64_t ids_per_row,
+                        int64_t padding_idx,
+                        EmbeddingPoolType pool_type,
+                        float pad_value,
+                        float* out,
+                        EmbeddingScratch* scratch) {
+  if (batch <= 0) {
+    return;
+  }
+  if (table.format == EmbeddingFormat::kFloat) {
+    seq_pool_float(table,
+                   ids,
+                   lod,
+                   batch,
+                   ids_per_row,
+                   padding_idx,
+                   pool_type,
+                   pad_value,
+                   out);
+    return;
+  }
+  // The distinct rows are decoded once, then pooled as a float table whose
+  // ids are their slots, the padding is the slot after them.
+  const int64_t num = static_cast<int64_t>(lod[batch]) * ids_per_row;
+  const int64_t width = table.width;
+  const int64_t stride = table.stride();
+  assign_slots(ids, num, table.rows, padding_idx, scratch);
+  const int64_t slot_num = static_cast<int64_t>(scratch->first.size());
+  for (auto& slot : scratch->slots) {
+    if (slot < 0) {
+      slot = slot_num;
+    }
+  }
+  scratch->rows.resize(slot_num * width);
+  const int64_t* first = scratch->first.data();
+  float* rows = scratch->rows.data();
+  int tasks = (slot_num + kEmbeddingIdsPerTask - 1) / kEmbeddingIdsPerTask;
+  LITE_PARALLEL_BEGIN(t, tid, tasks) {
+    int64_t begin = static_cast<int64_t>(t) * kEmbeddingIdsPerTask;
+    int64_t end = std::min(slot_num, begin + kEmbeddingIdsPerTask);
+    for (int64_t s = begin; s < end; ++s) {
+      if (s + kEmbeddingPrefetchDistance < end) {
+        prefetch_row(table, ids[first[s + kEmbeddingPrefetchDistance]]);
+      }
+      decode_uint8_row(
+          table.data + ids[first[s]] * stride, width, rows + s * width);
+    }
+  }
+  LITE_PARALLEL_END();
+
+  EmbeddingTable decoded;
+  decoded.data = rows;
+  decoded.rows = slot_num;
+  decoded.width = width;
+  seq_pool_float(decoded,
+                 scratch->slots.data(),
+                 lod,
+                 batch,
+                 ids_per_row,
+                 slot_num,
+                 pool_type,
+                 pad_value,
+                 out);
+}
+
+}  // namespace math
+}  // namespace host
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,100 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <stdint.h>
+#include <unordered_map>
+#include <vector>
+
+namespace paddle {
+namespace lite {
+namespace host {
+namespace math {
+
+// The ids gathered by a parallel task of the embedding lookup, and the
+// sequences pooled by one of embedding_seq_pool.
+const int kEmbeddingIdsPerTask = 64;
+const int kEmbeddingSeqsPerTask = 4;
+// The rows are prefetched this number of ids before they are read.
+const int kEmbeddingPrefetchDistance = 4;
+
+enum class EmbeddingFormat {
+  // float rows of width values
+  kFloat,
+  // The rows of lookup_table_dequant, each of them is the min and the max in
+  // float followed by the width uint8 codes, which are packed into the
+  // floats, the value is min + code * (max - min) / 256.
+  kUInt8MinMax,
+};
+
+enum class EmbeddingPoolType { kSum, kAverage, kSqrt };
+
+// The table W[rows, ...] whose rows are decoded to `width` floats.
+struct EmbeddingTable {
+  const float* data{nullptr};
+  int64_t rows{0};
+  int64_t width{0};
+  EmbeddingFormat format{EmbeddingFormat::kFloat};
+
+  // The floats of a row in data.
+  int64_t stride() const {
+    return format == EmbeddingFormat::kFloat ? width : width / 4 + 2;
+  }
+};
+
+// The buffers of the lookup of a compressed table, which are kept by the
+// kernel so that nothing is allocated after the first run. The repeated ids
+// of a batch share one slot, so each of the rows is decoded once.
+struct EmbeddingScratch {
+  std::unordered_map<int64_t, int64_t> slot_of_id;
+  // the first index of the id of each slot
+  std::vector<int64_t> first;
+  // the slot of each of the ids, -1 for padding_idx
+  std::vector<int64_t> slots;
+  // the decoded rows of the slots
+  std::vector<float> rows;
+};
+
+// Out[i, :] = W[ids[i], :] for the num ids, the rows of padding_idx are
+// zeros, padding_idx is -1 if there is none. The ids should be in
+// [0, table.rows).
+void embedding_lookup(const EmbeddingTable& table,
+                      const int64_t* ids,
+                      int64_t num,
+                      int64_t padding_idx,
+                      float* out,
+                      EmbeddingScratch* scratch);
+
+// The lookup followed by the sequence_pool of its output, without the rows
+// of the lookup in memory. The ids are [lod[batch], ids_per_row], the row r
+// of sequence_pool is the rows of ids[r, :], so Out is [batch, ids_per_row *
+// width]. The rows of a sequence are summed in order as sequence_pool does,
+// then divided by the length for kAverage and by its sqrt for kSqrt. The
+// rows of padding_idx are zeros which are counted in the length, the empty
+// sequences are pad_value.
+void embedding_seq_pool(const EmbeddingTable& table,
+                        const int64_t* ids,
+                        const uint64_t* lod,
+                        int64_t batch,
+                        int64_t ids_per_row,
+                        int64_t padding_idx,
+                        EmbeddingPoolType pool_type,
+                        float pad_value,
+                        float* out,
+                        EmbeddingScratch* scratch);
+
+}  // namespace math
+}  // namespace host
+}  // namespace lite
+}  // namespace paddle
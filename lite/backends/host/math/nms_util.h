@@ -17,6 +17,7 @@
 #include <utility>
 #include <vector>
 #include "lite/backends/host/math/poly_util.h"
+#include "lite/backends/host/math/topk.h"
 #include "lite/core/tensor.h"
 namespace paddle {
 namespace lite {
@@ -34,19 +35,13 @@ static void GetMaxScoreIndex(const std::vector<T>& scores,
                              const T threshold,
                              int top_k,
                              std::vector<std::pair<T, int>>* sorted_indices) {
-  for (size_t i = 0; i < scores.size(); ++i) {
-    if (scores[i] > threshold) {
-      sorted_indices->push_back(std::make_pair(scores[i], i));
-    }
-  }
-  // Sort the score pair according to the scores in descending order
-  std::stable_sort(sorted_indices->begin(),
-                   sorted_indices->end(),
-                   SortScorePairDescend<int>);
-  // Keep top_k scores if needed.
-  if (top_k > -1 && top_k < static_cast<int>(sorted_indices->size())) {
-    sorted_indices->resize(top_k);
-  }
+  // The scores above the threshold in descending order, the ties are in the
+  // order of the index as the stable sort does. Keep top_k scores if needed.
+  int num = static_cast<int>(scores.size());
+  TopkSelector<T> selector(top_k > -1 ? top_k : num, true);
+  selector.SetThreshold(threshold);
+  int count = selector.Select(scores.data(), num);
+  sorted_indices->assign(selector.data(), selector.data() + count);
 }
 
 template <typename T>
@@ -13,7 +13,20 @@ See the License for the specific language governing permissions and
 limitations under the License. */
 
 #include "lite/backends/host/math/reduce.h"
+#include <string.h>
+#include <algorithm>
+#include <limits>
+#include <utility>
+#include "lite/core/parallel_defines.h"
 #include "lite/core/tensor.h"
+#include "lite/core/workspace.h"
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define REDUCE_WITH_NEON
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define REDUCE_WITH_SSE2
+#endif
 
 namespace paddle {
 namespace lite {
@@ -234,6 +247,450 @@ ReduceFuncs(bool, LogicalAnd);
 ReduceFuncs(bool, LogicalOr);
 #undef ReduceFuncs
 
+namespace {
+
+// The type in which the values are accumulated.
+template <typename T>
+struct ReduceAcc {
+  typedef T type;
+};
+
+#ifdef ENABLE_ARM_FP16
+template <>
+struct ReduceAcc<float16_t> {
+  typedef float type;
+};
+#endif
+
+#ifdef REDUCE_WITH_NEON
+typedef float32x4_t VFloat;
+inline VFloat vload(const float* p) { return vld1q_f32(p); }
+inline void vstore(float* p, VFloat v) { vst1q_f32(p, v); }
+#elif defined(REDUCE_WITH_SSE2)
+typedef __m128 VFloat;
+inline VFloat vload(const float* p) { return _mm_loadu_ps(p); }
+inline void vstore(float* p, VFloat v) { _mm_storeu_ps(p, v); }
+#endif
+
+struct SumOp {
+  template <typename A>
+  static A Init() {
+    return A(0);
+  }
+  template <typename A>
+  static A Apply(A a, A b) {
+    return a + b;
+  }
+#ifdef REDUCE_WITH_NEON
+  static VFloat VApply(VFloat a, VFloat b) { return vaddq_f32(a, b); }
+#elif defined(REDUCE_WITH_SSE2)
+  static VFloat VApply(VFloat a, VFloat b) { return _mm_add_ps(a, b); }
+#endif
+};
+
+struct ProdOp {
+  template <typename A>
+  static A Init() {
+    return A(1);
+  }
+  template <typename A>
+  static A Apply(A a, A b) {
+    return a * b;
+  }
+#ifdef REDUCE_WITH_NEON
+  static VFloat VApply(VFloat a, VFloat b) { return vmulq_f32(a, b); }
+#elif defined(REDUCE_WITH_SSE2)
+  static VFloat VApply(VFloat a, VFloat b) { return _mm_mul_ps(a, b); }
+#endif
+};
+
+struct MaxOp {
+  template <typename A>
+  static A Init() {
+    return std::numeric_limits<A>::lowest();
+  }
+  template <typename A>
+  static A Apply(A a, A b) {
+    return a < b ? b : a;
+  }
+#ifdef REDUCE_WITH_NEON
+  static VFloat VApply(VFloat a, VFloat b) { return vmaxq_f32(a, b); }
+#elif defined(REDUCE_WITH_SSE2)
+  static VFloat VApply(VFloat a, VFloat b) { return _mm_max_ps(a, b); }
+#endif
+};
+
+struct MinOp {
+  template <typename A>
+  static A Init() {
+    return std::numeric_limits<A>::max();
+  }
+  template <typename A>
+  static A Apply(A a, A b) {
+    return b < a ? b : a;
+  }
+#ifdef REDUCE_WITH_NEON
+  static VFloat VApply(VFloat a, VFloat b) { return vminq_f32(a, b); }
+#elif defined(REDUCE_WITH_SSE2)
+  static VFloat VApply(VFloat a, VFloat b) { return _mm_min_ps(a, b); }
+#endif
+};
+
+// Reduces the values of In into the accumulators of A. Row() reduces n
+// contiguous values, Columns() folds the rows x[r * stride, +n) of `rows`
+// into acc[0, n).
+template <typename Op, typename In, typename A>
+struct Reducer {
+  static A Row(const In* x, int64_t n) {
+    A a0 = Op::template Init<A>();
+    A a1 = a0;
+    A a2 = a0;
+    A a3 = a0;
+    int64_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+      a0 = Op::Apply(a0, static_cast<A>(x[i]));
+      a1 = Op::Apply(a1, static_cast<A>(x[i + 1]));
+      a2 = Op::Apply(a2, static_cast<A>(x[i + 2]));
+      a3 = Op::Apply(a3, static_cast<A>(x[i + 3]));
+    }
+    for (; i < n; ++i) {
+      a0 = Op::Apply(a0, static_cast<A>(x[i]));
+    }
+    return Op::Apply(Op::Apply(a0, a1), Op::Apply(a2, a3));
+  }
+
+  static void Columns(
+      const In* x, int64_t rows, int64_t stride, int64_t n, A* acc) {
+    for (int64_t r = 0; r < rows; ++r) {
+      const In* row = x + r * stride;
+      for (int64_t j = 0; j < n; ++j) {
+        acc[j] = Op::Apply(acc[j], static_cast<A>(row[j]));
+      }
+    }
+  }
+};
+
+#if defined(REDUCE_WITH_NEON) || defined(REDUCE_WITH_SSE2)
+template <typename Op>
+struct Reducer<Op, float, float> {
+  static float Row(const float* x, int64_t n) {
+    float init = Op::template Init<float>();
+    float lanes[4] = {init, init, init, init};
+    VFloat v0 = vload(lanes);
+    VFloat v1 = v0;
+    VFloat v2 = v0;
+    VFloat v3 = v0;
+    int64_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+      v0 = Op::VApply(v0, vload(x + i));
+      v1 = Op::VApply(v1, vload(x + i + 4));
+      v2 = Op::VApply(v2, vload(x + i + 8));
+      v3 = Op::VApply(v3, vload(x + i + 12));
+    }
+    for (; i + 4 <= n; i += 4) {
+      v0 = Op::VApply(v0, vload(x + i));
+    }
+    vstore(lanes, Op::VApply(Op::VApply(v0, v1), Op::VApply(v2, v3)));
+    float a0 = Op::Apply(lanes[0], lanes[1]);
+    float a1 = Op::Apply(lanes[2], lanes[3]);
+    for (; i < n; ++i) {
+      a0 = Op::Apply(a0, x[i]);
+    }
+    return Op::Apply(a0, a1);
+  }
+
+  static void Columns(
+      const float* x, int64_t rows, int64_t stride, int64_t n, float* acc) {
+    int64_t j = 0;
+    for (; j + 16 <= n; j += 16) {
+      VFloat v0 = vload(acc + j);
+      VFloat v1 = vload(acc + j + 4);
+      VFloat v2 = vload(acc + j + 8);
+      VFloat v3 = vload(acc + j + 12);
+      for (int64_t r = 0; r < rows; ++r) {
+        const float* row = x + r * stride + j;
+        v0 = Op::VApply(v0, vload(row));
+        v1 = Op::VApply(v1, vload(row + 4));
+        v2 = Op::VApply(v2, vload(row + 8));
+        v3 = Op::VApply(v3, vload(row + 12));
+      }
+      vstore(acc + j, v0);
+      vstore(acc + j + 4, v1);
+      vstore(acc + j + 8, v2);
+      vstore(acc + j + 12, v3);
+    }
+    for (; j + 4 <= n; j += 4) {
+      VFloat v0 = vload(acc + j);
+      for (int64_t r = 0; r < rows; ++r) {
+        v0 = Op::VApply(v0, vload(x + r * stride + j));
+      }
+      vstore(acc + j, v0);
+    }
+    for (; j < n; ++j) {
+      float a = acc[j];
+      for (int64_t r = 0; r < rows; ++r) {
+        a = Op::Apply(a, x[r * stride + j]);
+      }
+      acc[j] = a;
+    }
+  }
+};
+#endif  // REDUCE_WITH_NEON || REDUCE_WITH_SSE2
+
+// The mean divides the result by `count`, the others have count 0.
+template <typename Out, typename A>
+inline Out reduce_finish(A acc, int64_t count) {
+  if (count > 0) {
+    acc = acc / static_cast<A>(count);
+  }
+  return static_cast<Out>(acc);
+}
+
+// The rows of the pass, i.e. inner is 1. The rows are reduced by the tasks
+// of about kReduceChunk values, a long row of the few ones is split into
+// chunks whose partial results are combined in order.
+template <typename Op, typename In, typename Out, typename A>
+void reduce_rows(const In* x, Out* out, const ReducePass& pass, int64_t count) {
+  const int64_t outer = pass.outer;
+  const int64_t n = pass.reduce;
+  if (outer < kReduceMinTasks && n >= 2 * kReduceChunk) {
+    const int64_t chunks = (n + kReduceChunk - 1) / kReduceChunk;
+    auto& workspace = WorkSpace::Current();
+    size_t mark = workspace.Mark();
+    A* partial = workspace.Alloc<A>(outer * chunks);
+    LITE_PARALLEL_BEGIN(t, tid, static_cast<int>(outer * chunks)) {
+      int64_t begin = (t % chunks) * kReduceChunk;
+      int64_t len = std::min(kReduceChunk, n - begin);
+      partial[t] = Reducer<Op, In, A>::Row(x + (t / chunks) * n + begin, len);
+    }
+    LITE_PARALLEL_END();
+    for (int64_t o = 0; o < outer; ++o) {
+      A acc = partial[o * chunks];
+      for (int64_t c = 1; c < chunks; ++c) {
+        acc = Op::Apply(acc, partial[o * chunks + c]);
+      }
+      out[o] = reduce_finish<Out>(acc, count);
+    }
+    workspace.Release(mark);
+    return;
+  }
+  const int64_t rows_per_task =
+      std::max<int64_t>(1, kReduceChunk / std::max<int64_t>(n, 1));
+  const int64_t tasks = (outer + rows_per_task - 1) / rows_per_task;
+  LITE_PARALLEL_BEGIN(t, tid, static_cast<int>(tasks)) {
+    int64_t end = std::min(outer, (t + 1) * rows_per_task);
+    for (int64_t o = t * rows_per_task; o < end; ++o) {
+      out[o] = reduce_finish<Out>(Reducer<Op, In, A>::Row(x + o * n, n), count);
+    }
+  }
+  LITE_PARALLEL_END();
+}
+
+// The columns of the pass, i.e. inner is more than 1. A task reduces
+// kReduceBlock columns of an outer index, which are read row by row. If
+// there are few of the tasks, the reduced axis is split into chunks as well,
+// and their partial results are combined in order.
+template <typename Op, typename In, typename Out, typename A>
+void reduce_columns(const In* x,
+                    Out* out,
+                    const ReducePass& pass,
+                    int64_t count) {
+  const int64_t outer = pass.outer;
+  const int64_t rows = pass.reduce;
+  const int64_t inner = pass.inner;
+  const int64_t blocks = (inner + kReduceBlock - 1) / kReduceBlock;
+  if (outer * blocks < kReduceMinTasks && rows * inner >= 2 * kReduceChunk) {
+    const int64_t rows_per_chunk = std::max<int64_t>(1, kReduceChunk / inner);
+    const int64_t chunks = (rows + rows_per_chunk - 1) / rows_per_chunk;
+    auto& workspace = WorkSpace::Current();
+    size_t mark = workspace.Mark();
+    A* partial = workspace.Alloc<A>(outer * chunks * inner);
+    LITE_PARALLEL_BEGIN(t, tid, static_cast<int>(outer * chunks * blocks)) {
+      int64_t b = t % blocks;
+      int64_t c = (t / blocks) % chunks;
+      int64_t o = t / blocks / chunks;
+      int64_t begin = c * rows_per_chunk;
+      int64_t col = b * kReduceBlock;
+      int64_t width = std::min<int64_t>(kReduceBlock, inner - col);
+      A* acc = partial + (o * chunks + c) * inner + col;
+      std::fill(acc, acc + width, Op::template Init<A>());
+      Reducer<Op, In, A>::Columns(x + (o * rows + begin) * inner + col,
+                                  std::min(rows_per_chunk, rows - begin),
+                                  inner,
+                                  width,
+                                  acc);
+    }
+    LITE_PARALLEL_END();
+    LITE_PARALLEL_BEGIN(t, tid, static_cast<int>(outer * blocks)) {
+      int64_t o = t / blocks;
+      int64_t col = (t % blocks) * kReduceBlock;
+      int64_t width = std::min<int64_t>(kReduceBlock, inner - col);
+      const A* src = partial + o * chunks * inner + col;
+      for (int64_t j = 0; j < width; ++j) {
+        A acc = src[j];
+        for (int64_t c = 1; c < chunks; ++c) {
+          acc = Op::Apply(acc, src[c * inner + j]);
+        }
+        out[o * inner + col + j] = reduce_finish<Out>(acc, count);
+      }
+    }
+    LITE_PARALLEL_END();
+    workspace.Release(mark);
+    return;
+  }
+  LITE_PARALLEL_BEGIN(t, tid, static_cast<int>(outer * blocks)) {
+    int64_t o = t / blocks;
+    int64_t col = (t % blocks) * kReduceBlock;
+    int64_t width = std::min<int64_t>(kReduceBlock, inner - col);
+    A acc[kReduceBlock];
+    std::fill(acc, acc + width, Op::template Init<A>());
+    Reducer<Op, In, A>::Columns(
+        x + o * rows * inner + col, rows, inner, width, acc);
+    for (int64_t j = 0; j < width; ++j) {
+      out[o * inner + col + j] = reduce_finish<Out>(acc[j], count);
+    }
+  }
+  LITE_PARALLEL_END();
+}
+
+template <typename Op, typename In, typename Out, typename A>
+void reduce_pass(const In* x, Out* out, const ReducePass& pass, int64_t count) {
+  if (pass.inner == 1) {
+    reduce_rows<Op, In, Out, A>(x, out, pass, count);
+  } else {
+    reduce_columns<Op, In, Out, A>(x, out, pass, count);
+  }
+}
+
+// Runs the passes, the intermediate results are of the accumulator type in
+// the workspace, and the mean is divided by the count of all of the passes
+// in the last one.
+template <typename Op, typename T>
+void reduce_impl(const T* x,
+                 T* out,
+                 const std::vector<ReducePass>& passes,
+                 bool mean) {
+  typedef typename ReduceAcc<T>::type A;
+  int64_t count = 0;
+  if (mean) {
+    count = 1;
+    for (auto& pass : passes) {
+      count *= pass.reduce;
+    }
+  }
+  if (passes.size() == 1) {
+    reduce_pass<Op, T, T, A>(x, out, passes[0], count);
+    return;
+  }
+  auto& workspace = WorkSpace::Current();
+  size_t mark = workspace.Mark();
+  A* src = workspace.Alloc<A>(passes[0].outer * passes[0].inner);
+  reduce_pass<Op, T, A, A>(x, src, passes[0], 0);
+  for (size_t i = 1; i + 1 < passes.size(); ++i) {
+    A* dst = workspace.Alloc<A>(passes[i].outer * passes[i].inner);
+    reduce_pass<Op, A, A, A>(src, dst, passes[i], 0);
+    src = dst;
+  }
+  reduce_pass<Op, A, T, A>(src, out, passes.back(), count);
+  workspace.Release(mark);
+}
+
+}  // namespace
+
+std::vector<ReducePass> reduce_plan(const std::vector<int64_t>& dims,
+                                    const std::vector<int>& axes,
+                                    bool reduce_all) {
+  const int rank = static_cast<int>(dims.size());
+  std::vector<bool> reduced(rank, reduce_all || axes.empty());
+  for (int axis : axes) {
+    if (axis < 0) {
+      axis += rank;
+    }
+    CHECK(axis >= 0 && axis < rank) << "The axis " << axis
+                                    << " is out of the rank " << rank;
+    reduced[axis] = true;
+  }
+  // The merged dims and whether they are reduced.
+  std::vector<std::pair<int64_t, bool>> groups;
+  for (int i = 0; i < rank; ++i) {
+    if (dims[i] == 1) {
+      continue;
+    }
+    if (!groups.empty() && groups.back().second == reduced[i]) {
+      groups.back().first *= dims[i];
+    } else {
+      groups.emplace_back(dims[i], reduced[i]);
+    }
+  }
+  std::vector<ReducePass> passes;
+  int64_t inner = 1;
+  for (int i = static_cast<int>(groups.size()) - 1; i >= 0; --i) {
+    if (!groups[i].second) {
+      inner *= groups[i].first;
+      continue;
+    }
+    int64_t outer = 1;
+    for (int j = 0; j < i; ++j) {
+      outer *= groups[j].first;
+    }
+    passes.push_back({outer, groups[i].first, inner});
+  }
+  return passes;
+}
+
+template <typename T>
+void reduce(const T* x,
+            T* out,
+            const std::vector<int64_t>& dims,
+            const std::vector<int>& axes,
+            bool reduce_all,
+            ReduceType type) {
+  auto passes = reduce_plan(dims, axes, reduce_all);
+  if (passes.empty()) {
+    int64_t size = 1;
+    for (auto dim : dims) {
+      size *= dim;
+    }
+    memcpy(out, x, size * sizeof(T));
+    return;
+  }
+  switch (type) {
+    case ReduceType::kSum:
+      reduce_impl<SumOp>(x, out, passes, false);
+      break;
+    case ReduceType::kMean:
+      reduce_impl<SumOp>(x, out, passes, true);
+      break;
+    case ReduceType::kMax:
+      reduce_impl<MaxOp>(x, out, passes, false);
+      break;
+    case ReduceType::kMin:
+      reduce_impl<MinOp>(x, out, passes, false);
+      break;
+    case ReduceType::kProd:
+      reduce_impl<ProdOp>(x, out, passes, false);
+      break;
+    default:
+      LOG(FATAL) << "Unsupported reduce type: " << static_cast<int>(type);
+  }
+}
+
+#define REDUCE_INSTANTIATE(DTYPE)                               \
+  template void reduce<DTYPE>(const DTYPE* x,                   \
+                              DTYPE* out,                       \
+                              const std::vector<int64_t>& dims, \
+                              const std::vector<int>& axes,     \
+                              bool reduce_all,                  \
+                              ReduceType type);
+
+REDUCE_INSTANTIATE(float);
+REDUCE_INSTANTIATE(int32_t);
+REDUCE_INSTANTIATE(int64_t);
+#ifdef ENABLE_ARM_FP16
+REDUCE_INSTANTIATE(float16_t);
+#endif
+#undef REDUCE_INSTANTIATE
+
 }  // namespace math
 }  // namespace host
 }  // namespace lite
@@ -13,12 +13,58 @@ See the License for the specific language governing permissions and
 limitations under the License. */
 
 #pragma once
+#include <stdint.h>
+#include <vector>
+
+#ifdef ENABLE_ARM_FP16
+typedef __fp16 float16_t;
+#endif
 
 namespace paddle {
 namespace lite {
 namespace host {
 namespace math {
 
+enum class ReduceType { kSum, kMean, kMax, kMin, kProd };
+
+// A reduction of the input [outer, reduce, inner] to [outer, inner].
+struct ReducePass {
+  int64_t outer;
+  int64_t reduce;
+  int64_t inner;
+};
+
+// The values reduced by a parallel task, the long rows are split into the
+// chunks of this size if there are too few rows to keep the threads busy.
+const int64_t kReduceChunk = 16384;
+// The tasks below which the reduced axis is split into chunks.
+const int kReduceMinTasks = 16;
+// The columns reduced together by a task, whose accumulators are on stack.
+const int kReduceBlock = 64;
+
+// Canonicalizes the reduction of `axes` over the input of `dims` into the
+// passes, the innermost reduced axes first. The dims of size 1 are dropped
+// and the adjacent reduced or kept dims are merged, so e.g. [N, C, H, W]
+// reduced over {2, 3} is one pass of [N * C, H * W, 1], and over {0, 2} is
+// [N * C, H, W] followed by [1, N, C * W]. The axes may be negative, all of
+// the axes are reduced if `reduce_all` is true or `axes` is empty.
+std::vector<ReducePass> reduce_plan(const std::vector<int64_t>& dims,
+                                    const std::vector<int>& axes,
+                                    bool reduce_all);
+
+// Out = reduce(x) over the axes as reduce_plan. The rows and the columns are
+// reduced by SIMD trees in parallel, the partial results of the split rows
+// are combined in order, so the result doesn't depend on the threads. The
+// fp16 values are accumulated in float, and the mean of the ints is rounded
+// toward zero.
+template <typename T>
+void reduce(const T* x,
+            T* out,
+            const std::vector<int64_t>& dims,
+            const std::vector<int>& axes,
+            bool reduce_all,
+            ReduceType type);
+
 struct LogicalAnd {
   inline bool operator()(const bool a, const bool b) { return a && b; }
 };
@@ -0,0 +1,252 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/backends/host/math/roi_align.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include "lite/core/parallel_defines.h"
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define ROI_ALIGN_WITH_NEON
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define ROI_ALIGN_WITH_SSE2
+#endif
+
+namespace paddle {
+namespace lite {
+namespace host {
+namespace math {
+
+namespace {
+
+static constexpr int kROISize = 4;
+// The ROIs computed by a parallel task, which share the buffers of the taps.
+const int kRoisPerTask = 4;
+
+void PreCalcForBilinearInterpolate(const int height,
+                                   const int width,
+                                   const int pooled_height,
+                                   const int pooled_width,
+                                   float roi_ymin,
+                                   float roi_xmin,
+                                   float bin_size_h,
+                                   float bin_size_w,
+                                   int roi_bin_grid_h,
+                                   int roi_bin_grid_w,
+                                   int* pre_pos_data,
+                                   float* pre_w_data) {
+  int pre_calc_index = 0;
+  for (int ph = 0; ph < pooled_height; ph++) {
+    for (int pw = 0; pw < pooled_width; pw++) {
+      for (int iy = 0; iy < roi_bin_grid_h; iy++) {
+        // calculate y of sample points
+        float y = roi_ymin + ph * bin_size_h +
+                  static_cast<float>(iy + .5f) * bin_size_h /
+                      static_cast<float>(roi_bin_grid_h);
+        // calculate x of samle points
+        for (int ix = 0; ix < roi_bin_grid_w; ix++) {
+          float x = roi_xmin + pw * bin_size_w +
+                    static_cast<float>(ix + .5f) * bin_size_w /
+                        static_cast<float>(roi_bin_grid_w);
+          // deal with elements out of map
+          if (y < -1.0 || y > height || x < -1.0 || x > width) {
+            for (int i = 0; i < kROISize; ++i) {
+              pre_pos_data[i + pre_calc_index * kROISize] = 0;
+              pre_w_data[i + pre_calc_index * kROISize] = 0;
+            }
+            pre_calc_index += 1;
+            continue;
+          }
+          y = y <= 0 ? 0 : y;
+          x = x <= 0 ? 0 : x;
+
+          int y_low = static_cast<int>(y);
+          int x_low = static_cast<int>(x);
+          int y_high;
+          int x_high;
+          if (y_low >= height - 1) {
+            y_high = y_low = height - 1;
+            y = static_cast<float>(y_low);
+          } else {
+            y_high = y_low + 1;
+          }
+          if (x_low >= width - 1) {
+            x_high = x_low = width - 1;
+            x = static_cast<float>(x_low);
+          } else {
+            x_high = x_low + 1;
+          }
+          float ly = y - y_low, lx = x - x_low;
+          float hy = 1. - ly, hx = 1. - lx;
+          pre_pos_data[pre_calc_index * kROISize] = y_low * width + x_low;
+          pre_pos_data[pre_calc_index * kROISize + 1] = y_low * width + x_high;
+          pre_pos_data[pre_calc_index * kROISize + 2] = y_high * width + x_low;
+          pre_pos_data[pre_calc_index * kROISize + 3] =
+              y_high * width + x_high;
+          pre_w_data[pre_calc_index * kROISize] = hy * hx;
+          pre_w_data[pre_calc_index * kROISize + 1] = hy * lx;
+          pre_w_data[pre_calc_index * kROISize + 2] = ly * hx;
+          pre_w_data[pre_calc_index * kROISize + 3] = ly * lx;
+          pre_calc_index += 1;
+        }
+      }
+    }
+  }
+}
+
+// Accumulates the taps of the bins of 4 channels, the lanes are the channels
+// whose planes are `plane` apart. The sums are added in the order of the
+// taps as the scalar loop does.
+void PooledBins4(const float* data,
+                 int plane,
+                 const int* pre_pos,
+                 const float* pre_w,
+                 int pooled_size,
+                 int taps,
+                 float count,
+                 float* out) {
+  for (int bin = 0; bin < pooled_size; ++bin) {
+    float sum[4];
+#ifdef ROI_ALIGN_WITH_NEON
+    float32x4_t vsum = vdupq_n_f32(0.f);
+    for (int t = 0; t < taps; ++t) {
+      const float* d = data + pre_pos[t];
+      float32x4_t v = vdupq_n_f32(0.f);
+      v = vld1q_lane_f32(d, v, 0);
+      v = vld1q_lane_f32(d + plane, v, 1);
+      v = vld1q_lane_f32(d + 2 * plane, v, 2);
+      v = vld1q_lane_f32(d + 3 * plane, v, 3);
+      vsum = vaddq_f32(vsum, vmulq_n_f32(v, pre_w[t]));
+    }
+    vst1q_f32(sum, vsum);
+#elif defined(ROI_ALIGN_WITH_SSE2)
+    __m128 vsum = _mm_setzero_ps();
+    for (int t = 0; t < taps; ++t) {
+      const float* d = data + pre_pos[t];
+      __m128 v = _mm_set_ps(d[3 * plane], d[2 * plane], d[plane], d[0]);
+      vsum = _mm_add_ps(vsum, _mm_mul_ps(v, _mm_set1_ps(pre_w[t])));
+    }
+    _mm_storeu_ps(sum, vsum);
+#else
+    sum[0] = sum[1] = sum[2] = sum[3] = 0.f;
+    for (int t = 0; t < taps; ++t) {
+      const float* d = data + pre_pos[t];
+      for (int k = 0; k < 4; ++k) {
+        sum[k] += pre_w[t] * d[k * plane];
+      }
+    }
+#endif
+    for (int k = 0; k < 4; ++k) {
+      out[k * pooled_size + bin] = sum[k] / count;
+    }
+    pre_pos += taps;
+    pre_w += taps;
+  }
+}
+
+}  // namespace
+
+void roi_align(const float* x,
+               int channels,
+               int height,
+               int width,
+               const float* rois,
+               const int* roi_batch_id,
+               int rois_num,
+               float spatial_scale,
+               int pooled_height,
+               int pooled_width,
+               int sampling_ratio,
+               float* out) {
+  const int plane = height * width;
+  const int pooled_size = pooled_height * pooled_width;
+  const int tasks = (rois_num + kRoisPerTask - 1) / kRoisPerTask;
+  LITE_PARALLEL_BEGIN(task, tid, tasks) {
+    std::vector<int> pre_pos;
+    std::vector<float> pre_w;
+    int end = std::min(rois_num, (task + 1) * kRoisPerTask);
+    for (int n = task * kRoisPerTask; n < end; ++n) {
+      const float* roi = rois + n * 4;
+      float roi_xmin = roi[0] * spatial_scale;
+      float roi_ymin = roi[1] * spatial_scale;
+      float roi_xmax = roi[2] * spatial_scale;
+      float roi_ymax = roi[3] * spatial_scale;
+
+      float roi_width = std::max(roi_xmax - roi_xmin, 1.0f);
+      float roi_height = std::max(roi_ymax - roi_ymin, 1.0f);
+      float bin_size_h = roi_height / pooled_height;
+      float bin_size_w = roi_width / pooled_width;
+      const float* batch_data =
+          x + static_cast<int64_t>(roi_batch_id[n]) * channels * plane;
+      float* out_data = out + static_cast<int64_t>(n) * channels * pooled_size;
+
+      int roi_bin_grid_h = (sampling_ratio > 0)
+                               ? sampling_ratio
+                               : ceil(roi_height / pooled_height);
+      int roi_bin_grid_w = (sampling_ratio > 0)
+                               ? sampling_ratio
+                               : ceil(roi_width / pooled_width);
+      const float count = roi_bin_grid_h * roi_bin_grid_w;
+      const int taps = roi_bin_grid_h * roi_bin_grid_w * kROISize;
+      pre_pos.resize(taps * pooled_size);
+      pre_w.resize(taps * pooled_size);
+      PreCalcForBilinearInterpolate(height,
+                                    width,
+                                    pooled_height,
+                                    pooled_width,
+                                    roi_ymin,
+                                    roi_xmin,
+                                    bin_size_h,
+                                    bin_size_w,
+                                    roi_bin_grid_h,
+                                    roi_bin_grid_w,
+                                    pre_pos.data(),
+                                    pre_w.data());
+
+      int c = 0;
+      for (; c + 4 <= channels; c += 4) {
+        PooledBins4(batch_data + c * plane,
+                    plane,
+                    pre_pos.data(),
+                    pre_w.data(),
+                    pooled_size,
+                    taps,
+                    count,
+                    out_data + c * pooled_size);
+      }
+      for (; c < channels; ++c) {
+        const float* data = batch_data + c * plane;
+        const int* pos = pre_pos.data();
+        const float* w = pre_w.data();
+        for (int bin = 0; bin < pooled_size; ++bin) {
+          float output_val = 0;
+          for (int t = 0; t < taps; ++t) {
+            output_val += w[t] * data[pos[t]];
+          }
+          out_data[c * pooled_size + bin] = output_val / count;
+          pos += taps;
+          w += taps;
+        }
+      }
+    }
+  }
+  LITE_PARALLEL_END();
+}
+
+}  // namespace math
+}  // namespace host
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,45 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+namespace paddle {
+namespace lite {
+namespace host {
+namespace math {
+
+// RoIAlign of the NCHW input x[batch, channels, height, width]. The ROIs are
+// [rois_num, 4] of (xmin, ymin, xmax, ymax), the i-th of which is in the
+// image roi_batch_id[i], the output is
+// [rois_num, channels, pooled_height, pooled_width].
+// The sample points of a ROI and their bilinear weights are computed once
+// and shared by all of the channels, which are accumulated 4 at a time. The
+// ROIs are computed in parallel.
+void roi_align(const float* x,
+               int channels,
+               int height,
+               int width,
+               const float* rois,
+               const int* roi_batch_id,
+               int rois_num,
+               float spatial_scale,
+               int pooled_height,
+               int pooled_width,
+               int sampling_ratio,
+               float* out);
+
+}  // namespace math
+}  // namespace host
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,474 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/backends/host/math/sparse_structured_gemm.h"
+#include <algorithm>
+#include "lite/core/parallel_defines.h"
+#include "lite/core/workspace.h"
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define SPARSE_WITH_NEON
+#elif defined(__AVX__)
+#include <immintrin.h>
+#define SPARSE_WITH_AVX
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define SPARSE_WITH_SSE2
+#endif
+
+namespace paddle {
+namespace lite {
+namespace host {
+namespace math {
+
+namespace {
+
+// F4 is a vector of 4 floats, FV is the widest vector of kLanes floats.
+// fma(acc, a, b) returns acc + a * b.
+#if defined(SPARSE_WITH_NEON)
+typedef float32x4_t F4;
+inline F4 f4_set1(float x) { return vdupq_n_f32(x); }
+inline F4 f4_load(const float* p) { return vld1q_f32(p); }
+inline void f4_store(float* p, F4 v) { vst1q_f32(p, v); }
+inline F4 f4_fma(F4 acc, F4 a, F4 b) { return vmlaq_f32(acc, a, b); }
+inline float f4_sum(F4 v) {
+  float32x2_t sum = vadd_f32(vget_low_f32(v), vget_high_f32(v));
+  return vget_lane_f32(vpadd_f32(sum, sum), 0);
+}
+#elif defined(SPARSE_WITH_AVX) || defined(SPARSE_WITH_SSE2)
+typedef __m128 F4;
+inline F4 f4_set1(float x) { return _mm_set1_ps(x); }
+inline F4 f4_load(const float* p) { return _mm_loadu_ps(p); }
+inline void f4_store(float* p, F4 v) { _mm_storeu_ps(p, v); }
+#ifdef __FMA__
+inline F4 f4_fma(F4 acc, F4 a, F4 b) { return _mm_fmadd_ps(a, b, acc); }
+#else
+inline F4 f4_fma(F4 acc, F4 a, F4 b) {
+  return _mm_add_ps(acc, _mm_mul_ps(a, b));
+}
+#endif
+inline float f4_sum(F4 v) {
+  float lanes[4];
+  _mm_storeu_ps(lanes, v);
+  return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+}
+#else
+struct F4 {
+  float v[4];
+};
+inline F4 f4_set1(float x) { return {{x, x, x, x}}; }
+inline F4 f4_load(const float* p) { return {{p[0], p[1], p[2], p[3]}}; }
+inline void f4_store(float* p, F4 v) { std::copy(v.v, v.v + 4, p); }
+inline F4 f4_fma(F4 acc, F4 a, F4 b) {
+  for (int i = 0; i < 4; i++) {
+    acc.v[i] += a.v[i] * b.v[i];
+  }
+  return acc;
+}
+inline float f4_sum(F4 v) { return (v.v[0] + v.v[1]) + (v.v[2] + v.v[3]); }
+#endif
+
+#ifdef SPARSE_WITH_AVX
+typedef __m256 FV;
+const int kLanes = 8;
+inline FV fv_set1(float x) { return _mm256_set1_ps(x); }
+inline FV fv_load(const float* p) { return _mm256_loadu_ps(p); }
+inline void fv_store(float* p, FV v) { _mm256_storeu_ps(p, v); }
+#ifdef __FMA__
+inline FV fv_fma(FV acc, FV a, FV b) { return _mm256_fmadd_ps(a, b, acc); }
+#else
+inline FV fv_fma(FV acc, FV a, FV b) {
+  return _mm256_add_ps(acc, _mm256_mul_ps(a, b));
+}
+#endif
+#else
+typedef F4 FV;
+const int kLanes = 4;
+inline FV fv_set1(float x) { return f4_set1(x); }
+inline FV fv_load(const float* p) { return f4_load(p); }
+inline void fv_store(float* p, FV v) { f4_store(p, v); }
+inline FV fv_fma(FV acc, FV a, FV b) { return f4_fma(acc, a, b); }
+#endif
+
+// The vectors of the columns of C computed together by the N:M gemm.
+const int kNMUnroll = 16 / kLanes;
+// The outputs of a row computed by a parallel task of the N:M fc.
+const int kNMFcBlock = 64;
+
+// x[idx[0]], ..., x[idx[3]]
+inline F4 f4_gather(const float* x, const int32_t* idx) {
+  float lanes[4] = {x[idx[0]], x[idx[1]], x[idx[2]], x[idx[3]]};
+  return f4_load(lanes);
+}
+
+inline void sparse_act(float* data,
+                       int size,
+                       const operators::ActivationParam& act_param) {
+  if (!act_param.has_active) {
+    return;
+  }
+  switch (act_param.active_type) {
+    case lite_api::ActivationType::kRelu:
+      for (int i = 0; i < size; i++) {
+        data[i] = std::max(data[i], 0.f);
+      }
+      break;
+    case lite_api::ActivationType::kRelu6: {
+      const float six = act_param.Relu_clipped_coef;
+      for (int i = 0; i < size; i++) {
+        data[i] = std::min(std::max(data[i], 0.f), six);
+      }
+    } break;
+    case lite_api::ActivationType::kLeakyRelu: {
+      const float alpha = act_param.Leaky_relu_alpha;
+      for (int i = 0; i < size; i++) {
+        data[i] = data[i] > 0.f ? data[i] : data[i] * alpha;
+      }
+    } break;
+    case lite_api::ActivationType::kHardSwish: {
+      const float threshold = act_param.hard_swish_threshold;
+      const float scale = act_param.hard_swish_scale;
+      const float offset = act_param.hard_swish_offset;
+      for (int i = 0; i < size; i++) {
+        data[i] = std::min(std::max(data[i] + offset, 0.f), threshold) *
+                  data[i] / scale;
+      }
+    } break;
+    default:
+      LOG(FATAL) << "The sparse gemm does not support the activation type "
+                 << static_cast<int>(act_param.active_type);
+  }
+}
+
+// Every block row computes BH rows of C, the columns of C are computed
+// 2 * kLanes at a time with BH x 2 accumulators.
+template <int BH, int BW>
+void block_gemm_impl(const float* values,
+                     const uint32_t* row_ptr,
+                     const int32_t* col_idx,
+                     const float* B,
+                     const float* bias,
+                     float* C,
+                     int M,
+                     int N,
+                     const operators::ActivationParam& act_param) {
+  const int block_rows = M / BH;
+  LITE_PARALLEL_BEGIN(br, tid, block_rows) {
+    const uint32_t begin = row_ptr[br];
+    const uint32_t end = row_ptr[br + 1];
+    float* c_ptr = C + br * BH * N;
+    float bias_row[BH];
+    for (int i = 0; i < BH; i++) {
+      bias_row[i] = bias ? bias[br * BH + i] : 0.f;
+    }
+    int n = 0;
+    for (; n + 2 * kLanes <= N; n += 2 * kLanes) {
+      FV acc0[BH];
+      FV acc1[BH];
+      for (int i = 0; i < BH; i++) {
+        acc0[i] = fv_set1(bias_row[i]);
+        acc1[i] = acc0[i];
+      }
+      for (uint32_t b = begin; b < end; b++) {
+        const float* v = values + b * BH * BW;
+        const float* b_ptr = B + col_idx[b] * N + n;
+        for (int j = 0; j < BW; j++) {
+          FV vb0 = fv_load(b_ptr + j * N);
+          FV vb1 = fv_load(b_ptr + j * N + kLanes);
+          for (int i = 0; i < BH; i++) {
+            FV w = fv_set1(v[j * BH + i]);
+            acc0[i] = fv_fma(acc0[i], vb0, w);
+            acc1[i] = fv_fma(acc1[i], vb1, w);
+          }
+        }
+      }
+      for (int i = 0; i < BH; i++) {
+        fv_store(c_ptr + i * N + n, acc0[i]);
+        fv_store(c_ptr + i * N + n + kLanes, acc1[i]);
+      }
+    }
+    for (; n < N; n++) {
+      float acc[BH];
+      for (int i = 0; i < BH; i++) {
+        acc[i] = bias_row[i];
+      }
+      for (uint32_t b = begin; b < end; b++) {
+        const float* v = values + b * BH * BW;
+        const float* b_ptr = B + col_idx[b] * N + n;
+        for (int j = 0; j < BW; j++) {
+          for (int i = 0; i < BH; i++) {
+            acc[i] += v[j * BH + i] * b_ptr[j * N];
+          }
+        }
+      }
+      for (int i = 0; i < BH; i++) {
+        c_ptr[i * N + n] = acc[i];
+      }
+    }
+    sparse_act(c_ptr, BH * N, act_param);
+  }
+  LITE_PARALLEL_END();
+}
+
+// Every block row computes BH outputs of a row of X. The 4 outputs of a
+// 4xBW block are a vector, and the 4 columns of a 1x4 block are reduced as a
+// dot product.
+template <int BH, int BW>
+void block_fc_impl(const float* values,
+                   const uint32_t* row_ptr,
+                   const int32_t* col_idx,
+                   const float* X,
+                   const float* bias,
+                   float* C,
+                   int M,
+                   int K,
+                   int N,
+                   const operators::ActivationParam& act_param) {
+  const int block_rows = M / BH;
+  LITE_PARALLEL_BEGIN(br, tid, block_rows) {
+    const uint32_t begin = row_ptr[br];
+    const uint32_t end = row_ptr[br + 1];
+    for (int r = 0; r < N; r++) {
+      const float* x_ptr = X + r * K;
+      float* c_ptr = C + r * M + br * BH;
+      if (BH == 4) {
+        F4 acc = bias ? f4_load(bias + br * BH) : f4_set1(0.f);
+        for (uint32_t b = begin; b < end; b++) {
+          const float* v = values + b * BH * BW;
+          const float* xk = x_ptr + col_idx[b];
+          for (int j = 0; j < BW; j++) {
+            acc = f4_fma(acc, f4_load(v + j * BH), f4_set1(xk[j]));
+          }
+        }
+        f4_store(c_ptr, acc);
+      } else if (BW == 4) {
+        F4 acc = f4_set1(0.f);
+        for (uint32_t b = begin; b < end; b++) {
+          acc = f4_fma(
+              acc, f4_load(values + b * BW), f4_load(x_ptr + col_idx[b]));
+        }
+        c_ptr[0] = f4_sum(acc) + (bias ? bias[br * BH] : 0.f);
+      } else {
+        for (int i = 0; i < BH; i++) {
+          float acc = bias ? bias[br * BH + i] : 0.f;
+          for (uint32_t b = begin; b < end; b++) {
+            const float* v = values + b * BH * BW;
+            for (int j = 0; j < BW; j++) {
+              acc += v[j * BH + i] * x_ptr[col_idx[b] + j];
+            }
+          }
+          c_ptr[i] = acc;
+        }
+      }
+      sparse_act(c_ptr, BH, act_param);
+    }
+  }
+  LITE_PARALLEL_END();
+}
+
+}  // namespace
+
+void sparse_block_gemm_fp32(const float* values,
+                            const uint32_t* row_ptr,
+                            const int32_t* col_idx,
+                            int block_h,
+                            int block_w,
+                            const float* B,
+                            const float* bias,
+                            float* C,
+                            int M,
+                            int K,
+                            int N,
+                            const operators::ActivationParam& act_param) {
+  if (block_h == 1 && block_w == 4) {
+    block_gemm_impl<1, 4>(
+        values, row_ptr, col_idx, B, bias, C, M, N, act_param);
+  } else if (block_h == 4 && block_w == 1) {
+    block_gemm_impl<4, 1>(
+        values, row_ptr, col_idx, B, bias, C, M, N, act_param);
+  } else if (block_h == 4 && block_w == 4) {
+    block_gemm_impl<4, 4>(
+        values, row_ptr, col_idx, B, bias, C, M, N, act_param);
+  } else {
+    LOG(FATAL) << "The sparse gemm does not support the block shape "
+               << block_h << "x" << block_w;
+  }
+}
+
+void sparse_block_fc_fp32(const float* values,
+                          const uint32_t* row_ptr,
+                          const int32_t* col_idx,
+                          int block_h,
+                          int block_w,
+                          const float* X,
+                          const float* bias,
+                          float* C,
+                          int M,
+                          int K,
+                          int N,
+                          const operators::ActivationParam& act_param) {
+  if (block_h == 1 && block_w == 4) {
+    block_fc_impl<1, 4>(
+        values, row_ptr, col_idx, X, bias, C, M, K, N, act_param);
+  } else if (block_h == 4 && block_w == 1) {
+    block_fc_impl<4, 1>(
+        values, row_ptr, col_idx, X, bias, C, M, K, N, act_param);
+  } else if (block_h == 4 && block_w == 4) {
+    block_fc_impl<4, 4>(
+        values, row_ptr, col_idx, X, bias, C, M, K, N, act_param);
+  } else {
+    LOG(FATAL) << "The sparse fc does not support the block shape " << block_h
+               << "x" << block_w;
+  }
+}
+
+void sparse_nm_gemm_fp32(const float* values,
+                         const int32_t* col_idx,
+                         int nm_n,
+                         int nm_m,
+                         const float* B,
+                         const float* bias,
+                         float* C,
+                         int M,
+                         int K,
+                         int N,
+                         const operators::ActivationParam& act_param) {
+  const int row_nonzeros = K / nm_m * nm_n;
+  LITE_PARALLEL_BEGIN(m, tid, M) {
+    const float* v = values + m * row_nonzeros;
+    const int32_t* idx = col_idx + m * row_nonzeros;
+    float* c_ptr = C + m * N;
+    const float bias_val = bias ? bias[m] : 0.f;
+    int n = 0;
+    for (; n + kNMUnroll * kLanes <= N; n += kNMUnroll * kLanes) {
+      FV acc[kNMUnroll];
+      for (int u = 0; u < kNMUnroll; u++) {
+        acc[u] = fv_set1(bias_val);
+      }
+      for (int t = 0; t < row_nonzeros; t++) {
+        const float* b_ptr = B + idx[t] * N + n;
+        FV w = fv_set1(v[t]);
+        for (int u = 0; u < kNMUnroll; u++) {
+          acc[u] = fv_fma(acc[u], fv_load(b_ptr + u * kLanes), w);
+        }
+      }
+      for (int u = 0; u < kNMUnroll; u++) {
+        fv_store(c_ptr + n + u * kLanes, acc[u]);
+      }
+    }
+    for (; n + kLanes <= N; n += kLanes) {
+      FV acc = fv_set1(bias_val);
+      for (int t = 0; t < row_nonzeros; t++) {
+        acc = fv_fma(acc, fv_load(B + idx[t] * N + n), fv_set1(v[t]));
+      }
+      fv_store(c_ptr + n, acc);
+    }
+    for (; n < N; n++) {
+      float acc = bias_val;
+      for (int t = 0; t < row_nonzeros; t++) {
+        acc += v[t] * B[idx[t] * N + n];
+      }
+      c_ptr[n] = acc;
+    }
+    sparse_act(c_ptr, N, act_param);
+  }
+  LITE_PARALLEL_END();
+}
+
+// The rows of X are computed kLanes at a time, whose tile is transposed to
+// [K, kLanes] in the workspace, so that a value of S is multiplied by a
+// vector of the rows as in the N:M gemm. The remaining rows gather 4 inputs
+// of the column indices at a time. The tasks are the tiles or the remaining
+// rows by the blocks of kNMFcBlock outputs.
+void sparse_nm_fc_fp32(const float* values,
+                       const int32_t* col_idx,
+                       int nm_n,
+                       int nm_m,
+                       const float* X,
+                       const float* bias,
+                       float* C,
+                       int M,
+                       int K,
+                       int N,
+                       const operators::ActivationParam& act_param) {
+  const int row_nonzeros = K / nm_m * nm_n;
+  const int tiles = N / kLanes;
+  const int rest_begin = tiles * kLanes;
+  const int row_groups = tiles + N - rest_begin;
+  const int m_blocks = (M + kNMFcBlock - 1) / kNMFcBlock;
+  auto& workspace = WorkSpace::Current();
+  size_t mark = workspace.Mark();
+  float* xt = workspace.Alloc<float>(static_cast<size_t>(tiles) * K * kLanes);
+  LITE_PARALLEL_BEGIN(tile, tid, tiles) {
+    const float* x_ptr = X + tile * kLanes * K;
+    float* xt_ptr = xt + tile * K * kLanes;
+    for (int k = 0; k < K; k++) {
+      for (int i = 0; i < kLanes; i++) {
+        xt_ptr[k * kLanes + i] = x_ptr[i * K + k];
+      }
+    }
+  }
+  LITE_PARALLEL_END();
+  LITE_PARALLEL_BEGIN(task, tid, row_groups * m_blocks) {
+    const int group = task / m_blocks;
+    const int m_begin = (task % m_blocks) * kNMFcBlock;
+    const int m_end = std::min(M, m_begin + kNMFcBlock);
+    if (group < tiles) {
+      const float* xt_ptr = xt + group * K * kLanes;
+      float* c_ptr = C + group * kLanes * M;
+      for (int m = m_begin; m < m_end; m++) {
+        const float* v = values + m * row_nonzeros;
+        const int32_t* idx = col_idx + m * row_nonzeros;
+        FV acc = fv_set1(bias ? bias[m] : 0.f);
+        for (int t = 0; t < row_nonzeros; t++) {
+          acc = fv_fma(acc, fv_load(xt_ptr + idx[t] * kLanes), fv_set1(v[t]));
+        }
+        float out[kLanes];
+        fv_store(out, acc);
+        for (int i = 0; i < kLanes; i++) {
+          c_ptr[i * M + m] = out[i];
+        }
+      }
+    } else {
+      const int r = rest_begin + group - tiles;
+      const float* x_ptr = X + r * K;
+      float* c_ptr = C + r * M;
+      for (int m = m_begin; m < m_end; m++) {
+        const float* v = values + m * row_nonzeros;
+        const int32_t* idx = col_idx + m * row_nonzeros;
+        F4 acc = f4_set1(0.f);
+        int t = 0;
+        for (; t + 4 <= row_nonzeros; t += 4) {
+          acc = f4_fma(acc, f4_load(v + t), f4_gather(x_ptr, idx + t));
+        }
+        float sum = f4_sum(acc) + (bias ? bias[m] : 0.f);
+        for (; t < row_nonzeros; t++) {
+          sum += v[t] * x_ptr[idx[t]];
+        }
+        c_ptr[m] = sum;
+      }
+    }
+  }
+  LITE_PARALLEL_END();
+  workspace.Release(mark);
+  if (act_param.has_active) {
+    LITE_PARALLEL_BEGIN(r, tid, N) { sparse_act(C + r * M, M, act_param); }
+    LITE_PARALLEL_END();
+  }
+}
+
+}  // namespace math
+}  // namespace host
+}  // namespace lite
+}  // namespace paddle
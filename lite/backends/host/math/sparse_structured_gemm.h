@@ -0,0 +1,84 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <stdint.h>
+#include "lite/operators/op_params.h"
+
+namespace paddle {
+namespace lite {
+namespace host {
+namespace math {
+
+// The sparse matrix S is [M, K] and stored in the block format or the N:M
+// format described by operators::SparseFormat. The supported block shapes
+// are 1x4, 4x1 and 4x4. The kernels use NEON on ARM and AVX or SSE2 on x86.
+
+/// C[M, N] = act(S[M, K] * B[K, N] + bias[M]), used by 1x1 conv.
+void sparse_block_gemm_fp32(const float* values,
+                            const uint32_t* row_ptr,
+                            const int32_t* col_idx,
+                            int block_h,
+                            int block_w,
+                            const float* B,
+                            const float* bias,
+                            float* C,
+                            int M,
+                            int K,
+                            int N,
+                            const operators::ActivationParam& act_param);
+
+void sparse_nm_gemm_fp32(const float* values,
+                         const int32_t* col_idx,
+                         int nm_n,
+                         int nm_m,
+                         const float* B,
+                         const float* bias,
+                         float* C,
+                         int M,
+                         int K,
+                         int N,
+                         const operators::ActivationParam& act_param);
+
+/// C[N, M] = act(X[N, K] * S[M, K]^T + bias[M]), used by fc, mul and matmul.
+void sparse_block_fc_fp32(const float* values,
+                          const uint32_t* row_ptr,
+                          const int32_t* col_idx,
+                          int block_h,
+                          int block_w,
+                          const float* X,
+                          const float* bias,
+                          float* C,
+                          int M,
+                          int K,
+                          int N,
+                          const operators::ActivationParam& act_param);
+
+void sparse_nm_fc_fp32(const float* values,
+                       const int32_t* col_idx,
+                       int nm_n,
+                       int nm_m,
+                       const float* X,
+                       const float* bias,
+                       float* C,
+                       int M,
+                       int K,
+                       int N,
+                       const operators::ActivationParam& act_param);
+
+}  // namespace math
+}  // namespace host
+}  // namespace lite
+}  // namespace paddle
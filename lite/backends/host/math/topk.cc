@@ -13,14 +13,121 @@
 // limitations under the License.
 
 #include "lite/backends/host/math/topk.h"
+#include <string.h>
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define TOPK_WITH_NEON
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define TOPK_WITH_SSE2
+#endif
 
 namespace paddle {
 namespace lite {
 namespace host {
 namespace math {
 
-bool comp_func(std::pair<float, int> a, std::pair<float, int> b) {
-  return (a.first > b.first);
+namespace {
+
+#ifdef TOPK_WITH_NEON
+inline bool any_lane(uint32x4_t mask) {
+#ifdef __aarch64__
+  return vmaxvq_u32(mask) != 0;
+#else
+  uint32x2_t m = vorr_u32(vget_low_u32(mask), vget_high_u32(mask));
+  return (vget_lane_u32(m, 0) | vget_lane_u32(m, 1)) != 0;
+#endif
+}
+#endif  // TOPK_WITH_NEON
+
+// The key is ordered as the float is, greater if `largest` is true, otherwise
+// less. Both of the zeros have the same key, as they are equal.
+inline uint32_t radix_key(float v, bool largest) {
+  uint32_t u = 0;
+  if (v != 0.f) {
+    memcpy(&u, &v, sizeof(u));
+  }
+  u = (u & 0x80000000u) ? ~u : (u | 0x80000000u);
+  return largest ? u : ~u;
+}
+
+}  // namespace
+
+int topk_skip(const float* x,
+              int begin,
+              int end,
+              int64_t stride,
+              float thr,
+              bool largest) {
+  int i = begin;
+  if (stride == 1) {
+#ifdef TOPK_WITH_NEON
+    float32x4_t vthr = vdupq_n_f32(thr);
+    for (; i + 8 <= end; i += 8) {
+      float32x4_t v0 = vld1q_f32(x + i);
+      float32x4_t v1 = vld1q_f32(x + i + 4);
+      uint32x4_t m0 = largest ? vcgtq_f32(v0, vthr) : vcltq_f32(v0, vthr);
+      uint32x4_t m1 = largest ? vcgtq_f32(v1, vthr) : vcltq_f32(v1, vthr);
+      if (any_lane(vorrq_u32(m0, m1))) {
+        break;
+      }
+    }
+#elif defined(TOPK_WITH_SSE2)
+    __m128 vthr = _mm_set1_ps(thr);
+    for (; i + 8 <= end; i += 8) {
+      __m128 v0 = _mm_loadu_ps(x + i);
+      __m128 v1 = _mm_loadu_ps(x + i + 4);
+      __m128 m0 = largest ? _mm_cmpgt_ps(v0, vthr) : _mm_cmplt_ps(v0, vthr);
+      __m128 m1 = largest ? _mm_cmpgt_ps(v1, vthr) : _mm_cmplt_ps(v1, vthr);
+      if (_mm_movemask_ps(_mm_or_ps(m0, m1)) != 0) {
+        break;
+      }
+    }
+#endif
+  }
+  for (; i < end; ++i) {
+    float v = x[i * stride];
+    if (largest ? v > thr : v < thr) {
+      return i;
+    }
+  }
+  return end;
+}
+
+void topk_radix_select(std::pair<float, int>* cand,
+                       int n,
+                       int k,
+                       bool largest) {
+  // Finds the key of the k-th best value 8 bits a pass, from the high bits,
+  // among the candidates whose high bits are the ones found so far.
+  uint32_t prefix = 0;
+  uint32_t mask = 0;
+  int rank = k;
+  for (int shift = 24; shift >= 0; shift -= 8) {
+    int hist[256] = {0};
+    for (int i = 0; i < n; ++i) {
+      uint32_t key = radix_key(cand[i].first, largest);
+      if ((key & mask) == prefix) {
+        ++hist[(key >> shift) & 0xff];
+      }
+    }
+    int digit = 255;
+    for (; digit > 0 && hist[digit] < rank; --digit) {
+      rank -= hist[digit];
+    }
+    prefix |= static_cast<uint32_t>(digit) << shift;
+    mask |= 0xffu << shift;
+  }
+  // The keys above the k-th one are all selected, then `rank` of the ones
+  // equal to it, which are the first ones as the candidates are in the order
+  // of the index.
+  int w = 0;
+  for (int i = 0; i < n && w < k; ++i) {
+    uint32_t key = radix_key(cand[i].first, largest);
+    if (key > prefix || (key == prefix && rank-- > 0)) {
+      cand[w++] = cand[i];
+    }
+  }
 }
 
 void topk(const float* in_data,
@@ -29,20 +136,7 @@ void topk(const float* in_data,
           int m,
           int n,
           int k) {
-  for (int i = 0; i < m; i++) {
-    const float* in_tmp = in_data + i * n;
-    float* out_val_tmp = out_val + i * k;
-    int64_t* out_ind_tmp = out_ind + i * k;
-    std::vector<std::pair<float, int>> vec;
-    for (int j = 0; j < n; j++) {
-      vec.push_back(std::make_pair(in_tmp[j], j));
-    }
-    std::partial_sort(vec.begin(), vec.begin() + k, vec.end(), comp_func);
-    for (int q = 0; q < k; q++) {
-      out_val_tmp[q] = vec[q].first;
-      out_ind_tmp[q] = vec[q].second;
-    }
-  }
+  topk<float>(in_data, out_val, out_ind, m, n, 1, k, true);
 }
 
 }  // namespace math
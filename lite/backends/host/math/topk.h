@@ -13,15 +13,232 @@
 // limitations under the License.
 
 #pragma once
+#include <stdint.h>
 #include <algorithm>
 #include <utility>
 #include <vector>
+#include "lite/core/parallel_defines.h"
 
 namespace paddle {
 namespace lite {
 namespace host {
 namespace math {
 
+// The k at most which is selected by a heap whatever the row size is, the
+// larger k uses the heap only if the row is kTopkHeapRatio times as long.
+const int kTopkHeapMaxK = 64;
+const int kTopkHeapRatio = 16;
+// The rows selected by a TopkSelector in a parallel task of topk.
+const int kTopkRowsPerTask = 16;
+
+// Returns the first index in [begin, end) whose value is strictly better than
+// `thr`, greater if `largest` is true, otherwise less, or `end` if none.
+template <typename T>
+inline int topk_skip(
+    const T* x, int begin, int end, int64_t stride, T thr, bool largest) {
+  for (int i = begin; i < end; ++i) {
+    T v = x[i * stride];
+    if (largest ? v > thr : v < thr) {
+      return i;
+    }
+  }
+  return end;
+}
+
+// The rows in float with stride 1 are compared by SSE or NEON.
+int topk_skip(const float* x,
+              int begin,
+              int end,
+              int64_t stride,
+              float thr,
+              bool largest);
+
+// Moves the k best of cand[0, n) to cand[0, k) in no order, `largest` and
+// the ties are as TopkSelector. It's a radix select by the bits of floats.
+void topk_radix_select(std::pair<float, int>* cand,
+                       int n,
+                       int k,
+                       bool largest);
+
+template <typename T>
+inline void topk_radix_select(std::pair<T, int>* cand,
+                              int n,
+                              int k,
+                              bool largest) {
+  auto better = [largest](const std::pair<T, int>& a,
+                          const std::pair<T, int>& b) {
+    if (a.first != b.first) {
+      return largest ? a.first > b.first : a.first < b.first;
+    }
+    return a.second < b.second;
+  };
+  std::nth_element(cand, cand + k - 1, cand + n, better);
+}
+
+// Selects the k best values of the rows, which are the largest ones if
+// `largest` is true, otherwise the smallest ones. The ties are ordered by the
+// lower index, so the result is the same as the one of a stable sort.
+// The selector keeps its buffers, a selector which is reused by the rows
+// allocates nothing after the first one. It's not thread-safe, each thread
+// should have its own one.
+template <typename T>
+class TopkSelector {
+ public:
+  TopkSelector(int k, bool largest) : k_(k), largest_(largest) {}
+
+  void SetK(int k) { k_ = k; }
+
+  // Only the values which are strictly better than `threshold` are selected,
+  // e.g. the scores above the score threshold of nms.
+  void SetThreshold(T threshold) {
+    has_threshold_ = true;
+    threshold_ = threshold;
+  }
+
+  // Selects from the row x[0], x[stride], ..., x[(n - 1) * stride], returns
+  // the number of the selected values, which is less than k if the row is
+  // shorter or there are not enough values above the threshold. The selected
+  // (value, index) pairs are in data(), the best one first.
+  int Select(const T* x, int n, int64_t stride = 1) {
+    int k = std::min(k_, n);
+    if (k <= 0) {
+      return 0;
+    }
+    if (k <= kTopkHeapMaxK || static_cast<int64_t>(k) * kTopkHeapRatio <= n) {
+      return SelectByHeap(x, n, stride, k);
+    }
+    return SelectByPartition(x, n, stride, k);
+  }
+
+  const std::pair<T, int>* data() const { return out_.data(); }
+
+ private:
+  bool Better(const std::pair<T, int>& a, const std::pair<T, int>& b) const {
+    if (a.first != b.first) {
+      return largest_ ? a.first > b.first : a.first < b.first;
+    }
+    return a.second < b.second;
+  }
+
+  // A heap of the k best values so far whose root is the worst one, only the
+  // values better than the root are visited after the heap is full.
+  int SelectByHeap(const T* x, int n, int64_t stride, int k) {
+    out_.resize(k);
+    auto better = [this](const std::pair<T, int>& a,
+                         const std::pair<T, int>& b) { return Better(a, b); };
+    std::pair<T, int>* heap = out_.data();
+    int size = 0;
+    int i = 0;
+    while (size < k) {
+      if (has_threshold_) {
+        i = topk_skip(x, i, n, stride, threshold_, largest_);
+      }
+      if (i >= n) {
+        break;
+      }
+      heap[size++] = std::make_pair(x[i * stride], i);
+      ++i;
+    }
+    if (size < k) {
+      std::sort(heap, heap + size, better);
+      return size;
+    }
+    std::make_heap(heap, heap + k, better);
+    // A later value replaces the root only if it's strictly better, because
+    // the root wins the tie by its lower index.
+    while ((i = topk_skip(x, i, n, stride, heap[0].first, largest_)) < n) {
+      ReplaceTop(heap, k, std::make_pair(x[i * stride], i));
+      ++i;
+    }
+    std::sort_heap(heap, heap + k, better);
+    return k;
+  }
+
+  // Gathers the candidates, partitions the k best of them to the front and
+  // sorts them, for k which is near to the row size.
+  int SelectByPartition(const T* x, int n, int64_t stride, int k) {
+    cand_.resize(n);
+    int count = 0;
+    for (int i = 0; i < n; ++i) {
+      T v = x[i * stride];
+      if (has_threshold_ &&
+          !(largest_ ? v > threshold_ : v < threshold_)) {
+        continue;
+      }
+      cand_[count++] = std::make_pair(v, i);
+    }
+    auto better = [this](const std::pair<T, int>& a,
+                         const std::pair<T, int>& b) { return Better(a, b); };
+    if (count > k) {
+      topk_radix_select(cand_.data(), count, k, largest_);
+      count = k;
+    }
+    std::sort(cand_.begin(), cand_.begin() + count, better);
+    out_.assign(cand_.begin(), cand_.begin() + count);
+    return count;
+  }
+
+  void ReplaceTop(std::pair<T, int>* heap, int k, std::pair<T, int> item) {
+    int i = 0;
+    while (true) {
+      int child = 2 * i + 1;
+      if (child >= k) {
+        break;
+      }
+      // the worse child moves up
+      if (child + 1 < k && Better(heap[child], heap[child + 1])) {
+        ++child;
+      }
+      if (!Better(item, heap[child])) {
+        break;
+      }
+      heap[i] = heap[child];
+      i = child;
+    }
+    heap[i] = item;
+  }
+
+  int k_;
+  bool largest_;
+  bool has_threshold_{false};
+  T threshold_{};
+  std::vector<std::pair<T, int>> out_;
+  std::vector<std::pair<T, int>> cand_;
+};
+
+// The top k along the axis of the input [outer, axis, inner], writes the
+// values and the indices of the output [outer, k, inner]. The rows are
+// selected in parallel, k should be no more than axis.
+template <typename T>
+void topk(const T* din,
+          T* out_val,
+          int64_t* out_ind,
+          int outer,
+          int axis,
+          int inner,
+          int k,
+          bool largest = true) {
+  int rows = outer * inner;
+  int tasks = (rows + kTopkRowsPerTask - 1) / kTopkRowsPerTask;
+  LITE_PARALLEL_BEGIN(t, tid, tasks) {
+    TopkSelector<T> selector(k, largest);
+    int end = std::min(rows, (t + 1) * kTopkRowsPerTask);
+    for (int r = t * kTopkRowsPerTask; r < end; ++r) {
+      int o = r / inner;
+      int i = r % inner;
+      int64_t in_off = static_cast<int64_t>(o) * axis * inner + i;
+      int64_t out_off = static_cast<int64_t>(o) * k * inner + i;
+      int count = selector.Select(din + in_off, axis, inner);
+      const std::pair<T, int>* res = selector.data();
+      for (int j = 0; j < count; ++j) {
+        out_val[out_off + j * inner] = res[j].first;
+        out_ind[out_off + j * inner] = res[j].second;
+      }
+    }
+  }
+  LITE_PARALLEL_END();
+}
+
 void topk(
     const float* din, float* out_val, int64_t* out_ind, int m, int n, int k);
 
@@ -0,0 +1,543 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/backends/host/math/transpose.h"
+#include <string.h>
+#include <algorithm>
+#include <utility>
+#include "lite/core/parallel_defines.h"
+#include "lite/utils/log/cp_logging.h"
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define PERMUTE_WITH_NEON
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define PERMUTE_WITH_SSE2
+#endif
+
+namespace paddle {
+namespace lite {
+namespace host {
+namespace math {
+
+namespace {
+
+// The tiles of the 2-D transpose are about 32x32 elements, so that the
+// source and the destination lines of a tile stay in L1.
+const int64_t kTile = 32;
+const int64_t kTileElems = kTile * kTile;
+// The number of the elements copied by a task of the row copies.
+const int64_t kCopyChunk = 16384;
+
+// Transpose a kSize x kSize block, dst[c * dst_ld + r] = src[r * src_ld + c].
+template <typename T>
+struct MicroTranspose {
+  static const int kSize = 4;
+  static void Run(const T* src, int64_t src_ld, T* dst, int64_t dst_ld) {
+    for (int r = 0; r < kSize; ++r) {
+      for (int c = 0; c < kSize; ++c) {
+        dst[c * dst_ld + r] = src[r * src_ld + c];
+      }
+    }
+  }
+};
+
+#ifdef PERMUTE_WITH_NEON
+template <>
+struct MicroTranspose<uint32_t> {
+  static const int kSize = 4;
+  static void Run(const uint32_t* src,
+                  int64_t src_ld,
+                  uint32_t* dst,
+                  int64_t dst_ld) {
+    uint32x4_t r0 = vld1q_u32(src);
+    uint32x4_t r1 = vld1q_u32(src + src_ld);
+    uint32x4_t r2 = vld1q_u32(src + 2 * src_ld);
+    uint32x4_t r3 = vld1q_u32(src + 3 * src_ld);
+    // a0b0a2b2 a1b1a3b3, c0d0c2d2 c1d1c3d3
+    uint32x4x2_t t01 = vtrnq_u32(r0, r1);
+    uint32x4x2_t t23 = vtrnq_u32(r2, r3);
+    vst1q_u32(dst,
+              vcombine_u32(vget_low_u32(t01.val[0]),
+                           vget_low_u32(t23.val[0])));
+    vst1q_u32(dst + dst_ld,
+              vcombine_u32(vget_low_u32(t01.val[1]),
+                           vget_low_u32(t23.val[1])));
+    vst1q_u32(dst + 2 * dst_ld,
+              vcombine_u32(vget_high_u32(t01.val[0]),
+                           vget_high_u32(t23.val[0])));
+    vst1q_u32(dst + 3 * dst_ld,
+              vcombine_u32(vget_high_u32(t01.val[1]),
+                           vget_high_u32(t23.val[1])));
+  }
+};
+
+template <>
+struct MicroTranspose<uint16_t> {
+  static const int kSize = 8;
+  static void Run(const uint16_t* src,
+                  int64_t src_ld,
+                  uint16_t* dst,
+                  int64_t dst_ld) {
+    uint16x8x2_t t01 = vtrnq_u16(vld1q_u16(src), vld1q_u16(src + src_ld));
+    uint16x8x2_t t23 =
+        vtrnq_u16(vld1q_u16(src + 2 * src_ld), vld1q_u16(src + 3 * src_ld));
+    uint16x8x2_t t45 =
+        vtrnq_u16(vld1q_u16(src + 4 * src_ld), vld1q_u16(src + 5 * src_ld));
+    uint16x8x2_t t67 =
+        vtrnq_u16(vld1q_u16(src + 6 * src_ld), vld1q_u16(src + 7 * src_ld));
+    // s0: the columns 0/4 and 2/6 of the rows a-d, s1: the columns 1/5 and
+    // 3/7, s2 and s3 are the same for the rows e-h.
+    uint32x4x2_t s0 = vtrnq_u32(vreinterpretq_u32_u16(t01.val[0]),
+                                vreinterpretq_u32_u16(t23.val[0]));
+    uint32x4x2_t s1 = vtrnq_u32(vreinterpretq_u32_u16(t01.val[1]),
+                                vreinterpretq_u32_u16(t23.val[1]));
+    uint32x4x2_t s2 = vtrnq_u32(vreinterpretq_u32_u16(t45.val[0]),
+                                vreinterpretq_u32_u16(t67.val[0]));
+    uint32x4x2_t s3 = vtrnq_u32(vreinterpretq_u32_u16(t45.val[1]),
+                                vreinterpretq_u32_u16(t67.val[1]));
+    const uint32x4x2_t* lo[4] = {&s0, &s1, &s0, &s1};
+    const uint32x4x2_t* hi[4] = {&s2, &s3, &s2, &s3};
+    for (int c = 0; c < 4; ++c) {
+      int v = c >> 1;
+      uint32x4_t col = vcombine_u32(vget_low_u32(lo[c]->val[v]),
+                                    vget_low_u32(hi[c]->val[v]));
+      uint32x4_t col4 = vcombine_u32(vget_high_u32(lo[c]->val[v]),
+                                     vget_high_u32(hi[c]->val[v]));
+      vst1q_u16(dst + c * dst_ld, vreinterpretq_u16_u32(col));
+      vst1q_u16(dst + (c + 4) * dst_ld, vreinterpretq_u16_u32(col4));
+    }
+  }
+};
+
+template <>
+struct MicroTranspose<uint8_t> {
+  static const int kSize = 8;
+  static void Run(const uint8_t* src,
+                  int64_t src_ld,
+                  uint8_t* dst,
+                  int64_t dst_ld) {
+    uint8x8x2_t t01 = vtrn_u8(vld1_u8(src), vld1_u8(src + src_ld));
+    uint8x8x2_t t23 =
+        vtrn_u8(vld1_u8(src + 2 * src_ld), vld1_u8(src + 3 * src_ld));
+    uint8x8x2_t t45 =
+        vtrn_u8(vld1_u8(src + 4 * src_ld), vld1_u8(src + 5 * src_ld));
+    uint8x8x2_t t67 =
+        vtrn_u8(vld1_u8(src + 6 * src_ld), vld1_u8(src + 7 * src_ld));
+    uint16x4x2_t s0 = vtrn_u16(vreinterpret_u16_u8(t01.val[0]),
+                               vreinterpret_u16_u8(t23.val[0]));
+    uint16x4x2_t s1 = vtrn_u16(vreinterpret_u16_u8(t01.val[1]),
+                               vreinterpret_u16_u8(t23.val[1]));
+    uint16x4x2_t s2 = vtrn_u16(vreinterpret_u16_u8(t45.val[0]),
+                               vreinterpret_u16_u8(t67.val[0]));
+    uint16x4x2_t s3 = vtrn_u16(vreinterpret_u16_u8(t45.val[1]),
+                               vreinterpret_u16_u8(t67.val[1]));
+    // c04: the columns 0 and 4, c15, c26 and c37 are the same.
+    uint32x2x2_t c04 = vtrn_u32(vreinterpret_u32_u16(s0.val[0]),
+                                vreinterpret_u32_u16(s2.val[0]));
+    uint32x2x2_t c15 = vtrn_u32(vreinterpret_u32_u16(s1.val[0]),
+                                vreinterpret_u32_u16(s3.val[0]));
+    uint32x2x2_t c26 = vtrn_u32(vreinterpret_u32_u16(s0.val[1]),
+                                vreinterpret_u32_u16(s2.val[1]));
+    uint32x2x2_t c37 = vtrn_u32(vreinterpret_u32_u16(s1.val[1]),
+                                vreinterpret_u32_u16(s3.val[1]));
+    vst1_u8(dst, vreinterpret_u8_u32(c04.val[0]));
+    vst1_u8(dst + dst_ld, vreinterpret_u8_u32(c15.val[0]));
+    vst1_u8(dst + 2 * dst_ld, vreinterpret_u8_u32(c26.val[0]));
+    vst1_u8(dst + 3 * dst_ld, vreinterpret_u8_u32(c37.val[0]));
+    vst1_u8(dst + 4 * dst_ld, vreinterpret_u8_u32(c04.val[1]));
+    vst1_u8(dst + 5 * dst_ld, vreinterpret_u8_u32(c15.val[1]));
+    vst1_u8(dst + 6 * dst_ld, vreinterpret_u8_u32(c26.val[1]));
+    vst1_u8(dst + 7 * dst_ld, vreinterpret_u8_u32(c37.val[1]));
+  }
+};
+#endif  // PERMUTE_WITH_NEON
+
+#ifdef PERMUTE_WITH_SSE2
+inline __m128i load_si128(const void* ptr) {
+  return _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr));
+}
+
+inline void store_si128(void* ptr, __m128i v) {
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(ptr), v);
+}
+
+template <>
+struct MicroTranspose<uint32_t> {
+  static const int kSize = 4;
+  static void Run(const uint32_t* src,
+                  int64_t src_ld,
+                  uint32_t* dst,
+                  int64_t dst_ld) {
+    __m128i r0 = load_si128(src);
+    __m128i r1 = load_si128(src + src_ld);
+    __m128i r2 = load_si128(src + 2 * src_ld);
+    __m128i r3 = load_si128(src + 3 * src_ld);
+    // a0b0a1b1 a2b2a3b3, c0d0c1d1 c2d2c3d3
+    __m128i t0 = _mm_unpacklo_epi32(r0, r1);
+    __m128i t1 = _mm_unpackhi_epi32(r0, r1);
+    __m128i t2 = _mm_unpacklo_epi32(r2, r3);
+    __m128i t3 = _mm_unpackhi_epi32(r2, r3);
+    store_si128(dst, _mm_unpacklo_epi64(t0, t2));
+    store_si128(dst + dst_ld, _mm_unpackhi_epi64(t0, t2));
+    store_si128(dst + 2 * dst_ld, _mm_unpacklo_epi64(t1, t3));
+    store_si128(dst + 3 * dst_ld, _mm_unpackhi_epi64(t1, t3));
+  }
+};
+
+template <>
+struct MicroTranspose<uint16_t> {
+  static const int kSize = 8;
+  static void Run(const uint16_t* src,
+                  int64_t src_ld,
+                  uint16_t* dst,
+                  int64_t dst_ld) {
+    __m128i r[8];
+    for (int i = 0; i < 8; ++i) {
+      r[i] = load_si128(src + i * src_ld);
+    }
+    // t[2i]: the columns 0-3 of the rows 2i and 2i+1, t[2i+1]: the columns 4-7
+    __m128i t[8];
+    for (int i = 0; i < 4; ++i) {
+      t[2 * i] = _mm_unpacklo_epi16(r[2 * i], r[2 * i + 1]);
+      t[2 * i + 1] = _mm_unpackhi_epi16(r[2 * i], r[2 * i + 1]);
+    }
+    // u[0..3]: the column pairs 0/1, 2/3, 4/5, 6/7 of the rows a-d,
+    // u[4..7]: the same of the rows e-h
+    __m128i u[8];
+    for (int i = 0; i < 2; ++i) {
+      u[4 * i] = _mm_unpacklo_epi32(t[4 * i], t[4 * i + 2]);
+      u[4 * i + 1] = _mm_unpackhi_epi32(t[4 * i], t[4 * i + 2]);
+      u[4 * i + 2] = _mm_unpacklo_epi32(t[4 * i + 1], t[4 * i + 3]);
+      u[4 * i + 3] = _mm_unpackhi_epi32(t[4 * i + 1], t[4 * i + 3]);
+    }
+    for (int i = 0; i < 4; ++i) {
+      store_si128(dst + 2 * i * dst_ld, _mm_unpacklo_epi64(u[i], u[i + 4]));
+      store_si128(dst + (2 * i + 1) * dst_ld,
+                  _mm_unpackhi_epi64(u[i], u[i + 4]));
+    }
+  }
+};
+
+template <>
+struct MicroTranspose<uint8_t> {
+  static const int kSize = 8;
+  static void Run(const uint8_t* src,
+                  int64_t src_ld,
+                  uint8_t* dst,
+                  int64_t dst_ld) {
+    __m128i t[4];
+    for (int i = 0; i < 4; ++i) {
+      __m128i r0 = _mm_loadl_epi64(
+          reinterpret_cast<const __m128i*>(src + 2 * i * src_ld));
+      __m128i r1 = _mm_loadl_epi64(
+          reinterpret_cast<const __m128i*>(src + (2 * i + 1) * src_ld));
+      t[i] = _mm_unpacklo_epi8(r0, r1);
+    }
+    // the columns 0-3 and 4-7 of the rows a-d and e-h
+    __m128i u0 = _mm_unpacklo_epi16(t[0], t[1]);
+    __m128i u1 = _mm_unpackhi_epi16(t[0], t[1]);
+    __m128i u2 = _mm_unpacklo_epi16(t[2], t[3]);
+    __m128i u3 = _mm_unpackhi_epi16(t[2], t[3]);
+    // the column pairs 0/1, 2/3, 4/5 and 6/7
+    __m128i v[4] = {_mm_unpacklo_epi32(u0, u2),
+                    _mm_unpackhi_epi32(u0, u2),
+                    _mm_unpacklo_epi32(u1, u3),
+                    _mm_unpackhi_epi32(u1, u3)};
+    for (int i = 0; i < 4; ++i) {
+      _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + 2 * i * dst_ld),
+                       v[i]);
+      _mm_storel_epi64(
+          reinterpret_cast<__m128i*>(dst + (2 * i + 1) * dst_ld),
+          _mm_unpackhi_epi64(v[i], v[i]));
+    }
+  }
+};
+#endif  // PERMUTE_WITH_SSE2
+
+// Transpose a rows x cols tile, dst[c * dst_ld + r] = src[r * src_ld + c].
+template <typename T>
+void transpose_tile(const T* src,
+                    int64_t src_ld,
+                    T* dst,
+                    int64_t dst_ld,
+                    int64_t rows,
+                    int64_t cols) {
+  const int64_t block = MicroTranspose<T>::kSize;
+  int64_t r = 0;
+  for (; r + block <= rows; r += block) {
+    int64_t c = 0;
+    for (; c + block <= cols; c += block) {
+      MicroTranspose<T>::Run(
+          src + r * src_ld + c, src_ld, dst + c * dst_ld + r, dst_ld);
+    }
+    for (; c < cols; ++c) {
+      for (int64_t k = 0; k < block; ++k) {
+        dst[c * dst_ld + r + k] = src[(r + k) * src_ld + c];
+      }
+    }
+  }
+  for (; r < rows; ++r) {
+    for (int64_t c = 0; c < cols; ++c) {
+      dst[c * dst_ld + r] = src[r * src_ld + c];
+    }
+  }
+}
+
+// The dims walked by the outer loops, in the order of the output.
+struct OuterDims {
+  std::vector<int64_t> dims;
+  std::vector<int64_t> in_strides;
+  std::vector<int64_t> out_strides;
+
+  void Add(int64_t dim, int64_t in_stride, int64_t out_stride) {
+    dims.push_back(dim);
+    in_strides.push_back(in_stride);
+    out_strides.push_back(out_stride);
+  }
+
+  int64_t count() const {
+    int64_t count = 1;
+    for (auto dim : dims) count *= dim;
+    return count;
+  }
+
+  void Offsets(int64_t index, int64_t* in_offset, int64_t* out_offset) const {
+    *in_offset = 0;
+    *out_offset = 0;
+    for (int k = static_cast<int>(dims.size()) - 1; k >= 0; --k) {
+      int64_t i = index % dims[k];
+      index /= dims[k];
+      *in_offset += i * in_strides[k];
+      *out_offset += i * out_strides[k];
+    }
+  }
+};
+
+// The output rows of `inner` elements are contiguous in the input.
+void permute_rows(const char* din,
+                  char* dout,
+                  const OuterDims& outer,
+                  int64_t inner,
+                  size_t elem_size) {
+  int64_t count = outer.count();
+  int64_t chunk = std::max<int64_t>(1, kCopyChunk / inner);
+  int num_tasks = static_cast<int>((count + chunk - 1) / chunk);
+  size_t row_bytes = inner * elem_size;
+  int rank = static_cast<int>(outer.dims.size());
+  LITE_PARALLEL_BEGIN(task, tid, num_tasks) {
+    int64_t begin = task * chunk;
+    int64_t end = std::min(count, begin + chunk);
+    int64_t in_offset = 0;
+    int64_t out_offset = 0;
+    outer.Offsets(begin, &in_offset, &out_offset);
+    // Walk the input offsets of the rows as an odometer.
+    std::vector<int64_t> index(rank, 0);
+    int64_t rest = begin;
+    for (int k = rank - 1; k >= 0; --k) {
+      index[k] = rest % outer.dims[k];
+      rest /= outer.dims[k];
+    }
+    for (int64_t i = begin; i < end; ++i) {
+      memcpy(dout + out_offset * elem_size,
+             din + in_offset * elem_size,
+             row_bytes);
+      out_offset += inner;
+      for (int k = rank - 1; k >= 0; --k) {
+        in_offset += outer.in_strides[k];
+        if (++index[k] < outer.dims[k]) break;
+        in_offset -= outer.dims[k] * outer.in_strides[k];
+        index[k] = 0;
+      }
+    }
+  }
+  LITE_PARALLEL_END();
+}
+
+// Transpose the input rows x cols matrices into the output, the cols are
+// contiguous in the input and the rows are contiguous in the output.
+template <typename T>
+void permute_2d(const T* din,
+                T* dout,
+                const OuterDims& outer,
+                int64_t rows,
+                int64_t cols,
+                int64_t src_ld,
+                int64_t dst_ld) {
+  // The narrow matrices use the longer tiles, so that a task still moves
+  // about kTileElems elements.
+  int64_t tile_r = std::max(kTile, kTileElems / std::min(cols, kTile));
+  int64_t tile_c = std::max(kTile, kTileElems / std::min(rows, kTile));
+  int64_t tiles_r = (rows + tile_r - 1) / tile_r;
+  int64_t tiles_c = (cols + tile_c - 1) / tile_c;
+  int64_t tiles = tiles_r * tiles_c;
+  int num_tasks = static_cast<int>(outer.count() * tiles);
+  LITE_PARALLEL_BEGIN(task, tid, num_tasks) {
+    int64_t in_offset = 0;
+    int64_t out_offset = 0;
+    outer.Offsets(task / tiles, &in_offset, &out_offset);
+    int64_t tile = task % tiles;
+    int64_t r = (tile / tiles_c) * tile_r;
+    int64_t c = (tile % tiles_c) * tile_c;
+    transpose_tile(din + in_offset + r * src_ld + c,
+                   src_ld,
+                   dout + out_offset + c * dst_ld + r,
+                   dst_ld,
+                   std::min(tile_r, rows - r),
+                   std::min(tile_c, cols - c));
+  }
+  LITE_PARALLEL_END();
+}
+
+}  // namespace
+
+void permute(const void* din,
+             void* dout,
+             const std::vector<int64_t>& in_dims,
+             const std::vector<int>& axis,
+             size_t elem_size) {
+  CHECK_EQ(in_dims.size(), axis.size());
+  int64_t count = 1;
+  for (auto dim : in_dims) count *= dim;
+  if (count == 0) return;
+
+  // Drop the size 1 dims.
+  std::vector<int> new_axis_id(in_dims.size(), -1);
+  std::vector<int64_t> dims;
+  for (size_t i = 0; i < in_dims.size(); ++i) {
+    if (in_dims[i] != 1) {
+      new_axis_id[i] = static_cast<int>(dims.size());
+      dims.push_back(in_dims[i]);
+    }
+  }
+  std::vector<int> perm;
+  for (auto a : axis) {
+    CHECK(a >= 0 && a < static_cast<int>(in_dims.size()));
+    if (new_axis_id[a] >= 0) perm.push_back(new_axis_id[a]);
+  }
+  // Merge the input dims which are still adjacent in the output, each group
+  // holds the first and the last input dim.
+  std::vector<std::pair<int, int>> groups;
+  for (auto a : perm) {
+    if (!groups.empty() && a == groups.back().second + 1) {
+      groups.back().second = a;
+    } else {
+      groups.emplace_back(a, a);
+    }
+  }
+  std::vector<int> firsts;
+  for (auto& group : groups) firsts.push_back(group.first);
+  std::sort(firsts.begin(), firsts.end());
+  int rank = static_cast<int>(groups.size());
+  std::vector<int64_t> merged_dims(rank, 1);
+  std::vector<int> merged_perm(rank);
+  for (int k = 0; k < rank; ++k) {
+    int id = static_cast<int>(
+        std::lower_bound(firsts.begin(), firsts.end(), groups[k].first) -
+        firsts.begin());
+    merged_perm[k] = id;
+    for (int a = groups[k].first; a <= groups[k].second; ++a) {
+      merged_dims[id] *= dims[a];
+    }
+  }
+
+  if (rank <= 1) {
+    memcpy(dout, din, count * elem_size);
+    return;
+  }
+  std::vector<int64_t> in_strides(rank, 1);
+  std::vector<int64_t> out_strides(rank, 1);
+  for (int k = rank - 2; k >= 0; --k) {
+    in_strides[k] = in_strides[k + 1] * merged_dims[k + 1];
+    out_strides[k] = out_strides[k + 1] * merged_dims[merged_perm[k + 1]];
+  }
+
+  // The output is made of the contiguous input rows if the last input dim
+  // stays the last one.
+  OuterDims outer;
+  if (merged_perm[rank - 1] == rank - 1) {
+    for (int k = 0; k < rank - 1; ++k) {
+      outer.Add(merged_dims[merged_perm[k]],
+                in_strides[merged_perm[k]],
+                out_strides[k]);
+    }
+    permute_rows(static_cast<const char*>(din),
+                 static_cast<char*>(dout),
+                 outer,
+                 merged_dims[rank - 1],
+                 elem_size);
+    return;
+  }
+  // The last output dim is the input dim `row_axis`, the last input dim goes
+  // to the output dim `col_pos`.
+  int row_axis = merged_perm[rank - 1];
+  int col_pos = static_cast<int>(
+      std::find(merged_perm.begin(), merged_perm.end(), rank - 1) -
+      merged_perm.begin());
+  for (int k = 0; k < rank - 1; ++k) {
+    if (k == col_pos) continue;
+    outer.Add(merged_dims[merged_perm[k]],
+              in_strides[merged_perm[k]],
+              out_strides[k]);
+  }
+  int64_t rows = merged_dims[row_axis];
+  int64_t cols = merged_dims[rank - 1];
+  int64_t src_ld = in_strides[row_axis];
+  int64_t dst_ld = out_strides[col_pos];
+  switch (elem_size) {
+    case 1:
+      permute_2d(static_cast<const uint8_t*>(din),
+                 static_cast<uint8_t*>(dout),
+                 outer,
+                 rows,
+                 cols,
+                 src_ld,
+                 dst_ld);
+      break;
+    case 2:
+      permute_2d(static_cast<const uint16_t*>(din),
+                 static_cast<uint16_t*>(dout),
+                 outer,
+                 rows,
+                 cols,
+                 src_ld,
+                 dst_ld);
+      break;
+    case 4:
+      permute_2d(static_cast<const uint32_t*>(din),
+                 static_cast<uint32_t*>(dout),
+                 outer,
+                 rows,
+                 cols,
+                 src_ld,
+                 dst_ld);
+      break;
+    case 8:
+      permute_2d(static_cast<const uint64_t*>(din),
+                 static_cast<uint64_t*>(dout),
+                 outer,
+                 rows,
+                 cols,
+                 src_ld,
+                 dst_ld);
+      break;
+    default:
+      LOG(FATAL) << "Unsupported element size of permute: " << elem_size;
+  }
+}
+
+}  // namespace math
+}  // namespace host
+}  // namespace lite
+}  // namespace paddle
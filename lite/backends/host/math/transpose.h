@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #pragma once
+#include <stdint.h>
 #include <vector>
 #include "lite/core/tensor.h"
 
@@ -21,38 +22,27 @@ namespace lite {
 namespace host {
 namespace math {
 
+/// Permute the dims of the data, the dim i of the output is the dim axis[i]
+/// of the input. The size 1 dims are dropped and the dims which stay adjacent
+/// are merged first, then the permutation is either a copy of contiguous rows
+/// or a tiled 2-D transpose of the two innermost dims, the tiles are
+/// transposed by the 4x4/8x8 SIMD blocks and run in parallel. The element size
+/// can be 1, 2, 4 or 8 bytes.
+void permute(const void* din,
+             void* dout,
+             const std::vector<int64_t>& in_dims,
+             const std::vector<int>& axis,
+             size_t elem_size);
+
 template <typename T>
 void Transpose(const Tensor &input,
                Tensor *output,
                const std::vector<int> &orders) {
-  auto in_dims = input.dims();
-  auto out_dims = output->dims();
-  int num_axes = in_dims.size();
-  int count = in_dims.production();
-
-  const T *din = input.data<T>();
-  T *dout = output->mutable_data<T>();
-  std::vector<int> old_steps(
-      {static_cast<int>(in_dims[1] * in_dims[2] * in_dims[3]),
-       static_cast<int>(in_dims[2] * in_dims[3]),
-       static_cast<int>(in_dims[3]),
-       1});
-  std::vector<int> new_steps(
-      {static_cast<int>(out_dims[1] * out_dims[2] * out_dims[3]),
-       static_cast<int>(out_dims[2] * out_dims[3]),
-       static_cast<int>(out_dims[3]),
-       1});
-
-  for (int i = 0; i < count; ++i) {
-    int old_idx = 0;
-    int idx = i;
-    for (int j = 0; j < num_axes; ++j) {
-      int order = orders[j];
-      old_idx += (idx / new_steps[j]) * old_steps[order];
-      idx %= new_steps[j];
-    }
-    dout[i] = din[old_idx];
-  }
+  permute(input.data<T>(),
+          output->mutable_data<T>(),
+          input.dims().Vectorize(),
+          orders,
+          sizeof(T));
 }
 
 }  // namespace math
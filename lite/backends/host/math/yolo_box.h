@@ -14,7 +14,9 @@
 
 #pragma once
 #include <cmath>
+#include <limits>
 #include <vector>
+#include "lite/backends/host/math/topk.h"
 #include "lite/core/tensor.h"
 
 namespace paddle {
@@ -32,6 +34,18 @@ inline float Sigmoid(float x) {
   return 1.f / (1.f + expf(-x));
 }
 
+// The confidence sigmoid(x) of a cell is less than conf_thresh if x is not
+// greater than the bound, so such cells are skipped by comparing the logits.
+// The bound is a bit lower than the logit of conf_thresh, the cells near the
+// threshold are still checked by the sigmoid.
+inline float YoloConfLogitBound(float conf_thresh) {
+  if (conf_thresh <= 0.f || conf_thresh >= 1.f) {
+    return -std::numeric_limits<float>::infinity();
+  }
+  double logit = std::log(conf_thresh / (1. - conf_thresh));
+  return static_cast<float>(logit - 1e-3 * (1. + std::fabs(logit)));
+}
+
 template <typename T>
 inline void GetYoloBox(T* box,
                        const T* x,
@@ -137,52 +151,54 @@ void YoloBox(lite::Tensor* X,
   T* Scores_data = Scores->mutable_data<T>();
   memset(Scores_data, 0, Scores->numel() * sizeof(T));
 
+  const T conf_bound = static_cast<T>(
+      YoloConfLogitBound(static_cast<float>(conf_thresh)));
   T box[4];
   for (int i = 0; i < n; i++) {
     int img_height = ImgSize_data[2 * i];
     int img_width = ImgSize_data[2 * i + 1];
 
     for (int j = 0; j < an_num; j++) {
-      for (int k = 0; k < h; k++) {
-        for (int l = 0; l < w; l++) {
-          int obj_idx =
-              GetEntryIndex(i, j, k * w + l, an_num, an_stride, stride, 4);
-          T conf = Sigmoid(X_data[obj_idx]);
-          if (conf < conf_thresh) {
-            continue;
-          }
-
-          int box_idx =
-              GetEntryIndex(i, j, k * w + l, an_num, an_stride, stride, 0);
-          GetYoloBox(box,
-                     X_data,
-                     anchors_data,
-                     l,
-                     k,
-                     j,
-                     h,
-                     X_size,
-                     box_idx,
-                     stride,
-                     img_height,
-                     img_width,
-                     scale,
-                     bias);
-          box_idx = (i * b_num + j * stride + k * w + l) * 4;
-          CalcDetectionBox(
-              Boxes_data, box, box_idx, img_height, img_width, clip_bbox);
-
-          int label_idx =
-              GetEntryIndex(i, j, k * w + l, an_num, an_stride, stride, 5);
-          int score_idx = (i * b_num + j * stride + k * w + l) * class_num;
-          CalcLabelScore(Scores_data,
-                         X_data,
-                         label_idx,
-                         score_idx,
-                         class_num,
-                         conf,
-                         stride);
+      const T* obj =
+          X_data + GetEntryIndex(i, j, 0, an_num, an_stride, stride, 4);
+      for (int hw = topk_skip(obj, 0, stride, 1, conf_bound, true);
+           hw < stride;
+           hw = topk_skip(obj, hw + 1, stride, 1, conf_bound, true)) {
+        int k = hw / w;
+        int l = hw % w;
+        T conf = Sigmoid(obj[hw]);
+        if (conf < conf_thresh) {
+          continue;
         }
+
+        int box_idx = GetEntryIndex(i, j, hw, an_num, an_stride, stride, 0);
+        GetYoloBox(box,
+                   X_data,
+                   anchors_data,
+                   l,
+                   k,
+                   j,
+                   h,
+                   X_size,
+                   box_idx,
+                   stride,
+                   img_height,
+                   img_width,
+                   scale,
+                   bias);
+        box_idx = (i * b_num + j * stride + hw) * 4;
+        CalcDetectionBox(
+            Boxes_data, box, box_idx, img_height, img_width, clip_bbox);
+
+        int label_idx = GetEntryIndex(i, j, hw, an_num, an_stride, stride, 5);
+        int score_idx = (i * b_num + j * stride + hw) * class_num;
+        CalcLabelScore(Scores_data,
+                       X_data,
+                       label_idx,
+                       score_idx,
+                       class_num,
+                       conf,
+                       stride);
       }
     }
   }
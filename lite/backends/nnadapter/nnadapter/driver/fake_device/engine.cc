@@ -0,0 +1,373 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "driver/fake_device/engine.h"
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include "utility/cache.h"
+#include "utility/debug.h"
+#include "utility/logging.h"
+#include "utility/modeling.h"
+#include "utility/string.h"
+#include "utility/utility.h"
+
+namespace nnadapter {
+namespace fake_device {
+
+static const char* FAKE_DEVICE_PROGRAM_STEPS_KEY = "steps";
+static const char* FAKE_DEVICE_PROGRAM_TYPES_KEY = "types";
+static const char* FAKE_DEVICE_PROGRAM_INPUT_INDEXES_KEY = "input_indexes";
+static const char* FAKE_DEVICE_PROGRAM_OUTPUT_INDEXES_KEY = "output_indexes";
+static const char* FAKE_DEVICE_PROGRAM_CONSTANT_KEY = "constant_%d";
+
+static float ApplyFuseCode(float value, int32_t fuse_code) {
+  switch (fuse_code) {
+    case NNADAPTER_FUSED_RELU:
+      return std::max(value, 0.f);
+    case NNADAPTER_FUSED_RELU1:
+      return std::min(std::max(value, -1.f), 1.f);
+    case NNADAPTER_FUSED_RELU6:
+      return std::min(std::max(value, 0.f), 6.f);
+    default:
+      return value;
+  }
+}
+
+static float ComputeUnary(NNAdapterOperationType type, float x) {
+  switch (type) {
+    case NNADAPTER_RELU:
+      return std::max(x, 0.f);
+    case NNADAPTER_RELU6:
+      return std::min(std::max(x, 0.f), 6.f);
+    case NNADAPTER_SIGMOID:
+      return 1.f / (1.f + std::exp(-x));
+    case NNADAPTER_TANH:
+      return std::tanh(x);
+    // Only the shape is changed, which is the one of the output
+    case NNADAPTER_FLATTEN:
+    case NNADAPTER_RESHAPE:
+    case NNADAPTER_SQUEEZE:
+    case NNADAPTER_UNSQUEEZE:
+      return x;
+    default:
+      NNADAPTER_LOG(FATAL) << "Unsupported operation("
+                           << OperationTypeToString(type) << ") is found.";
+      return x;
+  }
+}
+
+static float ComputeBinary(NNAdapterOperationType type, float x, float y) {
+  switch (type) {
+    case NNADAPTER_ADD:
+      return x + y;
+    case NNADAPTER_SUB:
+      return x - y;
+    case NNADAPTER_MUL:
+      return x * y;
+    case NNADAPTER_DIV:
+      return x / y;
+    default:
+      NNADAPTER_LOG(FATAL) << "Unsupported operation("
+                           << OperationTypeToString(type) << ") is found.";
+      return x;
+  }
+}
+
+// The strides of the input along the axes of the output, which are 0 on the
+// broadcasted axes, the dimensions are aligned to the right.
+static std::vector<int64_t> GetBroadcastStrides(
+    const NNAdapterOperandType& input_type,
+    const NNAdapterOperandType& output_type) {
+  int32_t input_rank = input_type.dimensions.count;
+  int32_t output_rank = output_type.dimensions.count;
+  std::vector<int64_t> strides(output_rank, 0);
+  int64_t stride = 1;
+  for (int32_t i = input_rank - 1; i >= 0; i--) {
+    int32_t axis = i + output_rank - input_rank;
+    int32_t dimension = input_type.dimensions.data[i];
+    if (dimension != 1) {
+      strides[axis] = stride;
+    }
+    stride *= dimension;
+  }
+  return strides;
+}
+
+void Program::Clear() {
+  steps_.clear();
+  types_.clear();
+  buffers_.clear();
+  input_indexes_.clear();
+  output_indexes_.clear();
+}
+
+int Program::Build(hal::Model* model, hal::Cache* cache) {
+  Clear();
+  if (!cache->buffer.empty()) {
+    // Build from cache
+    if (!Deserialize(cache->buffer)) {
+      NNADAPTER_LOG(FATAL) << "Failed to deserialize the program!";
+      return NNADAPTER_DEVICE_INTERNAL_ERROR;
+    }
+    NNADAPTER_CHECK_EQ(input_indexes_.size(), cache->input_types.size());
+    NNADAPTER_CHECK_EQ(output_indexes_.size(), cache->output_types.size());
+  } else {
+    // Build from model
+    NNADAPTER_VLOG(5) << "Origin model:" << std::endl << Visualize(model);
+    int result = BuildFromModel(model);
+    if (result != NNADAPTER_NO_ERROR) {
+      return result;
+    }
+    if (cache->token && cache->dir) {
+      NNADAPTER_CHECK(Serialize(&cache->buffer));
+    }
+  }
+  NNADAPTER_VLOG(3) << "Build the program with " << steps_.size()
+                    << " steps success.";
+  return NNADAPTER_NO_ERROR;
+}
+
+int Program::BuildFromModel(hal::Model* model) {
+  std::map<hal::Operand*, int32_t> indexes;
+  bool valid = true;
+  auto get_index = [&](hal::Operand* operand) -> int32_t {
+    auto it = indexes.find(operand);
+    if (it != indexes.end()) {
+      return it->second;
+    }
+    const auto& type = operand->type;
+    if (type.precision != NNADAPTER_FLOAT32) {
+      NNADAPTER_LOG(ERROR) << "Only float32 is supported, but recevied "
+                           << OperandPrecisionCodeToString(type.precision);
+      valid = false;
+    }
+    for (uint32_t i = 0; i < type.dimensions.count; i++) {
+      if (type.dimensions.data[i] <= 0) {
+        NNADAPTER_LOG(ERROR) << "Only the static shapes are supported.";
+        valid = false;
+        break;
+      }
+    }
+    auto index = static_cast<int32_t>(types_.size());
+    types_.push_back(type);
+    buffers_.emplace_back(valid ? ProductionOfDimensions(type.dimensions.data,
+                                                         type.dimensions.count)
+                                : 0);
+    if (valid && IsConstantOperand(operand)) {
+      NNADAPTER_CHECK_EQ(operand->length, buffers_.back().size() * 4);
+      memcpy(buffers_.back().data(), operand->buffer, operand->length);
+    }
+    indexes[operand] = index;
+    return index;
+  };
+  for (auto operand : model->input_operands) {
+    input_indexes_.push_back(get_index(operand));
+  }
+  for (auto operation : SortOperationsInTopologicalOrder(model)) {
+    Step step;
+    step.type = operation->type;
+    step.fuse_code = NNADAPTER_FUSED_NONE;
+    step.input_indexes[1] = -1;
+    switch (operation->type) {
+      case NNADAPTER_ADD:
+      case NNADAPTER_SUB:
+      case NNADAPTER_MUL:
+      case NNADAPTER_DIV:
+        NNADAPTER_CHECK_EQ(operation->input_operands.size(), 3);
+        step.input_indexes[1] = get_index(operation->input_operands[1]);
+        step.fuse_code =
+            *reinterpret_cast<int32_t*>(operation->input_operands[2]->buffer);
+        break;
+      case NNADAPTER_RELU:
+      case NNADAPTER_RELU6:
+      case NNADAPTER_SIGMOID:
+      case NNADAPTER_TANH:
+        NNADAPTER_CHECK_EQ(operation->input_operands.size(), 1);
+        break;
+      case NNADAPTER_FLATTEN:
+      case NNADAPTER_RESHAPE:
+      case NNADAPTER_SQUEEZE:
+      case NNADAPTER_UNSQUEEZE:
+        break;
+      default:
+        NNADAPTER_LOG(ERROR) << "Unsupported operation("
+                             << OperationTypeToString(operation->type)
+                             << ") is found.";
+        return NNADAPTER_INVALID_PARAMETER;
+    }
+    step.input_indexes[0] = get_index(operation->input_operands[0]);
+    NNADAPTER_CHECK_EQ(operation->output_operands.size(), 1);
+    step.output_index = get_index(operation->output_operands[0]);
+    steps_.push_back(step);
+  }
+  for (auto operand : model->output_operands) {
+    output_indexes_.push_back(get_index(operand));
+  }
+  return valid ? NNADAPTER_NO_ERROR : NNADAPTER_INVALID_PARAMETER;
+}
+
+bool Program::Serialize(std::vector<uint8_t>* buffer) {
+  Cache helper;
+  NNADAPTER_CHECK(helper.Set(FAKE_DEVICE_PROGRAM_STEPS_KEY,
+                             steps_.data(),
+                             steps_.size() * sizeof(Step)));
+  NNADAPTER_CHECK(helper.Set(FAKE_DEVICE_PROGRAM_TYPES_KEY,
+                             types_.data(),
+                             types_.size() * sizeof(NNAdapterOperandType)));
+  NNADAPTER_CHECK(helper.Set(FAKE_DEVICE_PROGRAM_INPUT_INDEXES_KEY,
+                             input_indexes_.data(),
+                             input_indexes_.size() * sizeof(int32_t)));
+  NNADAPTER_CHECK(helper.Set(FAKE_DEVICE_PROGRAM_OUTPUT_INDEXES_KEY,
+                             output_indexes_.data(),
+                             output_indexes_.size() * sizeof(int32_t)));
+  // Only the constant tensors have the data at the building time
+  for (int i = 0; i < static_cast<int>(types_.size()); i++) {
+    auto lifetime = types_[i].lifetime;
+    if (lifetime != NNADAPTER_CONSTANT_COPY &&
+        lifetime != NNADAPTER_CONSTANT_REFERENCE) {
+      continue;
+    }
+    auto key = string_format(FAKE_DEVICE_PROGRAM_CONSTANT_KEY, i);
+    NNADAPTER_CHECK(helper.Set(
+        key, buffers_[i].data(), buffers_[i].size() * sizeof(float)));
+  }
+  buffer->resize(helper.GetSerializedSize());
+  return helper.Serialize(buffer->data(), buffer->size());
+}
+
+bool Program::Deserialize(const std::vector<uint8_t>& buffer) {
+  Cache helper;
+  std::vector<uint8_t> data(buffer);
+  if (!helper.Deserialize(data.data(), data.size())) {
+    return false;
+  }
+  std::vector<uint8_t> value;
+  if (!helper.Get(FAKE_DEVICE_PROGRAM_STEPS_KEY, &value)) return false;
+  steps_.resize(value.size() / sizeof(Step));
+  memcpy(steps_.data(), value.data(), steps_.size() * sizeof(Step));
+  if (!helper.Get(FAKE_DEVICE_PROGRAM_TYPES_KEY, &value)) return false;
+  types_.resize(value.size() / sizeof(NNAdapterOperandType));
+  memcpy(types_.data(),
+         value.data(),
+         types_.size() * sizeof(NNAdapterOperandType));
+  if (!helper.Get(FAKE_DEVICE_PROGRAM_INPUT_INDEXES_KEY, &value)) return false;
+  input_indexes_.resize(value.size() / sizeof(int32_t));
+  memcpy(input_indexes_.data(),
+         value.data(),
+         input_indexes_.size() * sizeof(int32_t));
+  if (!helper.Get(FAKE_DEVICE_PROGRAM_OUTPUT_INDEXES_KEY, &value)) {
+    return false;
+  }
+  output_indexes_.resize(value.size() / sizeof(int32_t));
+  memcpy(output_indexes_.data(),
+         value.data(),
+         output_indexes_.size() * sizeof(int32_t));
+  buffers_.resize(types_.size());
+  for (int i = 0; i < static_cast<int>(types_.size()); i++) {
+    buffers_[i].resize(ProductionOfDimensions(types_[i].dimensions.data,
+                                              types_[i].dimensions.count));
+    auto key = string_format(FAKE_DEVICE_PROGRAM_CONSTANT_KEY, i);
+    if (helper.Get(key, &value)) {
+      if (value.size() != buffers_[i].size() * sizeof(float)) return false;
+      memcpy(buffers_[i].data(), value.data(), value.size());
+    }
+  }
+  return true;
+}
+
+void Program::RunStep(const Step& step) {
+  const auto& output_type = types_[step.output_index];
+  auto output = buffers_[step.output_index].data();
+  auto count = static_cast<int64_t>(buffers_[step.output_index].size());
+  auto input0 = buffers_[step.input_indexes[0]].data();
+  if (step.input_indexes[1] < 0) {
+    for (int64_t i = 0; i < count; i++) {
+      output[i] = ComputeUnary(step.type, input0[i]);
+    }
+    return;
+  }
+  auto input1 = buffers_[step.input_indexes[1]].data();
+  auto strides0 =
+      GetBroadcastStrides(types_[step.input_indexes[0]], output_type);
+  auto strides1 =
+      GetBroadcastStrides(types_[step.input_indexes[1]], output_type);
+  int32_t rank = output_type.dimensions.count;
+  const int32_t* dimensions = output_type.dimensions.data;
+  // Walk the output in order, and move the offsets of the inputs along with
+  // the coordinate of the output
+  std::vector<int32_t> coordinate(rank, 0);
+  int64_t offset0 = 0;
+  int64_t offset1 = 0;
+  for (int64_t i = 0; i < count; i++) {
+    output[i] = ApplyFuseCode(
+        ComputeBinary(step.type, input0[offset0], input1[offset1]),
+        step.fuse_code);
+    for (int32_t axis = rank - 1; axis >= 0; axis--) {
+      offset0 += strides0[axis];
+      offset1 += strides1[axis];
+      if (++coordinate[axis] < dimensions[axis]) break;
+      offset0 -= strides0[axis] * dimensions[axis];
+      offset1 -= strides1[axis] * dimensions[axis];
+      coordinate[axis] = 0;
+    }
+  }
+}
+
+int Program::Execute(uint32_t input_count,
+                     hal::Argument* input_arguments,
+                     uint32_t output_count,
+                     hal::Argument* output_arguments) {
+  NNADAPTER_CHECK_EQ(input_indexes_.size(), input_count);
+  NNADAPTER_CHECK_EQ(output_indexes_.size(), output_count);
+  for (uint32_t i = 0; i < input_count; i++) {
+    auto& arg = input_arguments[i];
+    NNADAPTER_CHECK_GE(arg.index, 0);
+    NNADAPTER_CHECK_LT(arg.index, input_count);
+    NNADAPTER_CHECK(arg.memory);
+    NNADAPTER_CHECK(arg.access);
+    auto index = input_indexes_[arg.index];
+    auto type = types_[index];
+    auto buffer = arg.access(arg.memory, &type);
+    NNADAPTER_CHECK(buffer);
+    auto& data = buffers_[index];
+    NNADAPTER_CHECK_EQ(
+        ProductionOfDimensions(type.dimensions.data, type.dimensions.count),
+        data.size())
+        << "The shape of the input " << arg.index << " is changed.";
+    memcpy(data.data(), buffer, data.size() * sizeof(float));
+  }
+  auto start_time = GetCurrentUS();
+  for (const auto& step : steps_) {
+    RunStep(step);
+  }
+  NNADAPTER_VLOG(3) << "Process cost " << GetCurrentUS() - start_time << " us";
+  for (uint32_t i = 0; i < output_count; i++) {
+    auto& arg = output_arguments[i];
+    NNADAPTER_CHECK_GE(arg.index, 0);
+    NNADAPTER_CHECK_LT(arg.index, output_count);
+    NNADAPTER_CHECK(arg.memory);
+    NNADAPTER_CHECK(arg.access);
+    auto index = output_indexes_[arg.index];
+    auto type = types_[index];
+    auto buffer = arg.access(arg.memory, &type);
+    NNADAPTER_CHECK(buffer);
+    const auto& data = buffers_[index];
+    memcpy(buffer, data.data(), data.size() * sizeof(float));
+  }
+  return NNADAPTER_NO_ERROR;
+}
+
+}  // namespace fake_device
+}  // namespace nnadapter
@@ -0,0 +1,79 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <vector>
+#include "core/hal/types.h"
+
+namespace nnadapter {
+namespace fake_device {
+
+// A device which runs the models on the host by the reference
+// implementations of a few float32 operations, it's for testing the runtime,
+// e.g. the compilation and the model cache, without the hardware.
+class Device {
+ public:
+  Device() {}
+  ~Device() {}
+};
+
+class Context {
+ public:
+  explicit Context(void* device, const char* properties) : device_(device) {}
+  ~Context() {}
+
+ private:
+  void* device_{nullptr};
+};
+
+// An operation of the program, its operands are the indexes of the tensors
+typedef struct {
+  NNAdapterOperationType type;
+  int32_t fuse_code;
+  int32_t input_indexes[2];
+  int32_t output_index;
+} Step;
+
+class Program {
+ public:
+  explicit Program(Context* context) : context_(context) {}
+  ~Program() { Clear(); }
+
+  int Build(hal::Model* model, hal::Cache* cache);
+  int Execute(uint32_t input_count,
+              hal::Argument* input_arguments,
+              uint32_t output_count,
+              hal::Argument* output_arguments);
+
+ private:
+  void Clear();
+  int BuildFromModel(hal::Model* model);
+  // The compiled program is the steps, the types of the tensors and the data
+  // of the constant ones
+  bool Serialize(std::vector<uint8_t>* buffer);
+  bool Deserialize(const std::vector<uint8_t>& buffer);
+  void RunStep(const Step& step);
+
+ private:
+  Context* context_{nullptr};
+  std::vector<Step> steps_;
+  std::vector<NNAdapterOperandType> types_;
+  std::vector<std::vector<float>> buffers_;
+  std::vector<int32_t> input_indexes_;
+  std::vector<int32_t> output_indexes_;
+};
+
+}  // namespace fake_device
+}  // namespace nnadapter
@@ -23,7 +23,6 @@
 namespace nnadapter {
 namespace runtime {
 
-static const char* NNADAPTER_RUNTIME_CACHE_FILE_EXTENSION = ".nnc";
 static const char* NNADAPTER_RUNTIME_CACHE_INPUT_TYPES_KEY = "input_types";
 static const char* NNADAPTER_RUNTIME_CACHE_OUTPUT_TYPES_KEY = "output_types";
 static const char* NNADAPTER_RUNTIME_CACHE_NUM_CACHES_KEY = "num_caches";
@@ -36,6 +35,27 @@ static const char* NNADAPTER_RUNTIME_CACHE_CACHE_OUTPUT_TYPES_KEY =
 static const char* NNADAPTER_RUNTIME_CACHE_CACHE_MODEL_BUFFER_KEY =
     "cache_%d_model_buffer";
 
+// The caches made by the other devices of the context, or by the other versions
+// of their drivers, can't be loaded even if they have the same token.
+static std::string GetCacheSignature(Context* context) {
+  std::string signature = string_format("nnadapter:%d", NNADAPTER_VERSION);
+  for (size_t i = 0; i < context->GetDeviceCount(); i++) {
+    auto device = context->GetDeviceContext(static_cast<int>(i))->device;
+    signature +=
+        string_format(";%s:%d", device->GetName(), device->GetVersion());
+  }
+  return signature;
+}
+
+static uint64_t GetCacheCapacity(Context* context) {
+  auto key_values = GetKeyValues(context->GetProperties());
+  if (key_values.count(NNADAPTER_MODEL_CACHE_CAPACITY)) {
+    return static_cast<uint64_t>(
+        atol(key_values[NNADAPTER_MODEL_CACHE_CAPACITY].c_str()));
+  }
+  return GetUInt64FromEnv(NNADAPTER_MODEL_CACHE_CAPACITY);
+}
+
 Compilation::Compilation(Model* model,
                          const char* cache_token,
                          void* cache_buffer,
@@ -52,10 +72,10 @@ Compilation::Compilation(Model* model,
     std::vector<uint8_t> buffer;
     if (!cache_token_.empty() && !cache_dir_.empty() &&
         (!cache_buffer || !cache_length)) {
-      std::string path = cache_dir_ + "/" + cache_token_ +
-                         std::string(NNADAPTER_RUNTIME_CACHE_FILE_EXTENSION);
-      if (ReadFile(path, &buffer)) {
-        NNADAPTER_LOG(INFO) << "Read the cache file " << path << " success.";
+      CacheIndex index(cache_dir_, GetCacheCapacity(context_));
+      if (index.Read(cache_token_, GetCacheSignature(context_), &buffer)) {
+        NNADAPTER_LOG(INFO) << "Read the cache file "
+                            << index.GetFilePath(cache_token_) << " success.";
         cache_buffer = buffer.data();
         cache_length = buffer.size();
       }
@@ -112,11 +132,11 @@ int Compilation::Execute(std::vector<hal::Argument>* input_arguments,
         if (Serialize(&buffer)) {
           NNADAPTER_LOG(INFO)
               << "Serialize the cache models into memory success.";
-          std::string path =
-              cache_dir_ + "/" + cache_token_ +
-              std::string(NNADAPTER_RUNTIME_CACHE_FILE_EXTENSION);
-          if (WriteFile(path, buffer)) {
-            NNADAPTER_LOG(INFO) << "Write the cache file " << path
+          CacheIndex index(cache_dir_, GetCacheCapacity(context_));
+          if (index.Write(
+                  cache_token_, GetCacheSignature(context_), buffer)) {
+            NNADAPTER_LOG(INFO) << "Write the cache file "
+                                << index.GetFilePath(cache_token_)
                                 << " success.";
           }
         }
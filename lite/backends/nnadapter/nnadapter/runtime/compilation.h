@@ -21,6 +21,13 @@
 #include "runtime/context.h"
 #include "runtime/model.h"
 
+// The following environment variables or context properties can be used at
+// runtime:
+// Specify the maximum total bytes of the cache files in the model cache dir,
+// the least recently used ones are removed once it's exceeded, 0(default) means
+// unlimited, such as NNADAPTER_MODEL_CACHE_CAPACITY=268435456
+#define NNADAPTER_MODEL_CACHE_CAPACITY "NNADAPTER_MODEL_CACHE_CAPACITY"
+
 namespace nnadapter {
 namespace runtime {
 
@@ -13,6 +13,10 @@
 // limitations under the License.
 
 #include "utility/cache.h"
+#include <fcntl.h>
+#include <stdio.h>
+#include <sys/file.h>
+#include <unistd.h>
 #include "utility/logging.h"
 #include "utility/string.h"
 #include "utility/utility.h"
@@ -22,6 +26,18 @@ namespace nnadapter {
 static const uint32_t NNADAPTER_CACHE_MAGIC_NUMBER =
     ('.' << 24) + ('n' << 16) + ('n' << 8) + 'c';
 static const uint32_t NNADAPTER_CACHE_VERSION_CODE = 1;
+static const char* NNADAPTER_CACHE_FILE_EXTENSION = ".nnc";
+static const char* NNADAPTER_CACHE_INDEX_FILE_NAME = "nnadapter_cache.idx";
+static const char* NNADAPTER_CACHE_LOCK_FILE_NAME = "nnadapter_cache.lock";
+static const char* NNADAPTER_CACHE_INDEX_TICK_KEY = "tick";
+static const char* NNADAPTER_CACHE_INDEX_NUM_ENTRIES_KEY = "num_entries";
+static const char* NNADAPTER_CACHE_INDEX_ENTRY_TOKEN_KEY = "entry_%d_token";
+static const char* NNADAPTER_CACHE_INDEX_ENTRY_SIGNATURE_KEY =
+    "entry_%d_signature";
+// The CRC32C, the size and the tick of an entry
+static const char* NNADAPTER_CACHE_INDEX_ENTRY_META_KEY = "entry_%d_meta";
+static const uint64_t NNADAPTER_CACHE_INDEX_ENTRY_META_SIZE =
+    sizeof(uint32_t) + sizeof(uint64_t) * 2;
 
 static inline uint64_t align4(uint64_t size) { return (size + 3) & ~3; }
 
@@ -166,4 +182,216 @@ bool Cache::Deserialize(void* buffer, uint64_t size) {
   return true;
 }
 
+CacheIndex::CacheIndex(const std::string& dir, uint64_t capacity)
+    : dir_(dir), capacity_(capacity) {}
+
+std::string CacheIndex::GetFilePath(const std::string& token) const {
+  return dir_ + "/" + token + std::string(NNADAPTER_CACHE_FILE_EXTENSION);
+}
+
+bool CacheIndex::Read(const std::string& token,
+                      const std::string& signature,
+                      std::vector<uint8_t>* buffer) {
+  buffer->clear();
+  if (!Lock()) return false;
+  Load();
+  bool found = false;
+  auto it = entries_.find(token);
+  if (it != entries_.end()) {
+    auto path = GetFilePath(token);
+    if (it->second.signature_ != signature) {
+      NNADAPTER_LOG(WARNING) << "The cache file " << path
+                             << " is made by other devices or drivers, "
+                                "remove it.";
+    } else if (!ReadFile(path, buffer) ||
+               buffer->size() != it->second.size_ ||
+               CRC32C(buffer->data(), buffer->size()) != it->second.crc32c_) {
+      NNADAPTER_LOG(WARNING) << "The cache file " << path
+                             << " is missing or damaged, remove it.";
+    } else {
+      found = true;
+      it->second.tick_ = ++tick_;
+    }
+    if (!found) {
+      Remove(token);
+    }
+    Store();
+  }
+  Unlock();
+  if (!found) {
+    buffer->clear();
+  }
+  return found;
+}
+
+bool CacheIndex::Write(const std::string& token,
+                       const std::string& signature,
+                       const std::vector<uint8_t>& buffer) {
+  if (buffer.empty()) return false;
+  if (!Lock()) return false;
+  Load();
+  auto path = GetFilePath(token);
+  auto temp_path = string_format("%s.%d.tmp", path.c_str(), getpid());
+  bool success = WriteFile(temp_path, buffer) &&
+                 rename(temp_path.c_str(), path.c_str()) == 0;
+  if (success) {
+    auto& entry = entries_[token];
+    entry.crc32c_ = CRC32C(buffer.data(), buffer.size());
+    entry.size_ = buffer.size();
+    entry.tick_ = ++tick_;
+    entry.signature_ = signature;
+    if (capacity_ > 0) {
+      uint64_t total_size = 0;
+      for (const auto& e : entries_) {
+        total_size += e.second.size_;
+      }
+      // Evict the least recently used files except the one just written
+      while (total_size > capacity_) {
+        auto lru = entries_.end();
+        for (auto it = entries_.begin(); it != entries_.end(); it++) {
+          if (it->first == token) continue;
+          if (lru == entries_.end() || it->second.tick_ < lru->second.tick_) {
+            lru = it;
+          }
+        }
+        if (lru == entries_.end()) break;
+        NNADAPTER_LOG(INFO) << "Evict the cache file "
+                            << GetFilePath(lru->first) << ".";
+        total_size -= lru->second.size_;
+        Remove(lru->first);
+      }
+    }
+    success = Store();
+  } else {
+    remove(temp_path.c_str());
+  }
+  Unlock();
+  return success;
+}
+
+bool CacheIndex::Lock() {
+  auto path = dir_ + "/" + std::string(NNADAPTER_CACHE_LOCK_FILE_NAME);
+  lock_fd_ = open(path.c_str(), O_RDWR | O_CREAT, 0644);
+  if (lock_fd_ < 0) {
+    NNADAPTER_LOG(WARNING) << "Failed to open the lock file " << path << ".";
+    return false;
+  }
+  if (flock(lock_fd_, LOCK_EX) != 0) {
+    NNADAPTER_LOG(WARNING) << "Failed to lock the file " << path << ".";
+    close(lock_fd_);
+    lock_fd_ = -1;
+    return false;
+  }
+  return true;
+}
+
+void CacheIndex::Unlock() {
+  if (lock_fd_ >= 0) {
+    flock(lock_fd_, LOCK_UN);
+    close(lock_fd_);
+    lock_fd_ = -1;
+  }
+}
+
+void CacheIndex::Load() {
+  tick_ = 0;
+  entries_.clear();
+  auto path = dir_ + "/" + std::string(NNADAPTER_CACHE_INDEX_FILE_NAME);
+  if (access(path.c_str(), F_OK) != 0) return;
+  std::vector<uint8_t> buffer;
+  Cache helper;
+  if (!ReadFile(path, &buffer) || buffer.empty() ||
+      !helper.Deserialize(buffer.data(), buffer.size())) {
+    NNADAPTER_LOG(WARNING) << "Failed to load the cache index " << path
+                           << ", rebuild it.";
+    return;
+  }
+  std::vector<uint8_t> value;
+  uint64_t num_entries = 0;
+  if (!helper.Get(NNADAPTER_CACHE_INDEX_TICK_KEY, &value) ||
+      value.size() != sizeof(tick_)) {
+    return;
+  }
+  memcpy(&tick_, value.data(), sizeof(tick_));
+  if (!helper.Get(NNADAPTER_CACHE_INDEX_NUM_ENTRIES_KEY, &value) ||
+      value.size() != sizeof(num_entries)) {
+    tick_ = 0;
+    return;
+  }
+  memcpy(&num_entries, value.data(), sizeof(num_entries));
+  for (uint64_t i = 0; i < num_entries; i++) {
+    int index = static_cast<int>(i);
+    std::string token;
+    Entry entry;
+    if (!helper.Get(string_format(NNADAPTER_CACHE_INDEX_ENTRY_TOKEN_KEY, index),
+                    &token) ||
+        !helper.Get(
+            string_format(NNADAPTER_CACHE_INDEX_ENTRY_SIGNATURE_KEY, index),
+            &entry.signature_) ||
+        !helper.Get(string_format(NNADAPTER_CACHE_INDEX_ENTRY_META_KEY, index),
+                    &value) ||
+        value.size() != NNADAPTER_CACHE_INDEX_ENTRY_META_SIZE) {
+      NNADAPTER_LOG(WARNING) << "Bad entry " << i << " in the cache index "
+                             << path << ", rebuild it.";
+      tick_ = 0;
+      entries_.clear();
+      return;
+    }
+    auto meta = value.data();
+    memcpy(&entry.crc32c_, meta, sizeof(uint32_t));
+    memcpy(&entry.size_, meta + sizeof(uint32_t), sizeof(uint64_t));
+    memcpy(&entry.tick_,
+           meta + sizeof(uint32_t) + sizeof(uint64_t),
+           sizeof(uint64_t));
+    entries_[token] = entry;
+  }
+}
+
+bool CacheIndex::Store() {
+  Cache helper;
+  NNADAPTER_CHECK(
+      helper.Set(NNADAPTER_CACHE_INDEX_TICK_KEY, &tick_, sizeof(tick_)));
+  uint64_t num_entries = entries_.size();
+  NNADAPTER_CHECK(helper.Set(NNADAPTER_CACHE_INDEX_NUM_ENTRIES_KEY,
+                             &num_entries,
+                             sizeof(num_entries)));
+  int index = 0;
+  std::vector<uint8_t> meta(NNADAPTER_CACHE_INDEX_ENTRY_META_SIZE);
+  for (const auto& e : entries_) {
+    const auto& entry = e.second;
+    memcpy(meta.data(), &entry.crc32c_, sizeof(uint32_t));
+    memcpy(meta.data() + sizeof(uint32_t), &entry.size_, sizeof(uint64_t));
+    memcpy(meta.data() + sizeof(uint32_t) + sizeof(uint64_t),
+           &entry.tick_,
+           sizeof(uint64_t));
+    NNADAPTER_CHECK(helper.Set(
+        string_format(NNADAPTER_CACHE_INDEX_ENTRY_TOKEN_KEY, index), e.first));
+    NNADAPTER_CHECK(helper.Set(
+        string_format(NNADAPTER_CACHE_INDEX_ENTRY_SIGNATURE_KEY, index),
+        entry.signature_));
+    NNADAPTER_CHECK(helper.Set(
+        string_format(NNADAPTER_CACHE_INDEX_ENTRY_META_KEY, index), meta));
+    index++;
+  }
+  std::vector<uint8_t> buffer(helper.GetSerializedSize());
+  if (!helper.Serialize(buffer.data(), buffer.size())) {
+    return false;
+  }
+  auto path = dir_ + "/" + std::string(NNADAPTER_CACHE_INDEX_FILE_NAME);
+  auto temp_path = string_format("%s.%d.tmp", path.c_str(), getpid());
+  if (!WriteFile(temp_path, buffer) ||
+      rename(temp_path.c_str(), path.c_str()) != 0) {
+    NNADAPTER_LOG(WARNING) << "Failed to write the cache index " << path
+                           << ".";
+    remove(temp_path.c_str());
+    return false;
+  }
+  return true;
+}
+
+void CacheIndex::Remove(const std::string& token) {
+  remove(GetFilePath(token).c_str());
+  entries_.erase(token);
+}
+
 }  // namespace nnadapter
@@ -52,4 +52,55 @@ class Cache {
   std::map<std::string, std::vector<uint8_t>> entries_;
 };
 
+// The index of the model cache files in a directory, which may be shared by
+// the models of a process and by the processes. Each entry records the
+// signature of the devices which made the file, and the size and the CRC32C of
+// its content, so a file made by other devices or drivers, or changed after it
+// was indexed, is removed instead of being loaded. The least recently used
+// files are removed once their total size exceeds the capacity. The index is
+// updated under an exclusive file lock, and the index and the cache files are
+// replaced by renaming the temporary files, so the readers never see the
+// partial ones.
+class CacheIndex {
+  struct Entry {
+    uint32_t crc32c_;
+    uint64_t size_;
+    // The larger one is the more recently used one
+    uint64_t tick_;
+    std::string signature_;
+  };
+
+ public:
+  // 'capacity' is the maximum total bytes of the cache files, 0 means
+  // unlimited.
+  explicit CacheIndex(const std::string& dir, uint64_t capacity = 0);
+  // Read the cache file of the token if it's indexed with the same signature
+  // and its content is intact, and mark it as the most recently used one.
+  bool Read(const std::string& token,
+            const std::string& signature,
+            std::vector<uint8_t>* buffer);
+  // Write the buffer into the cache file of the token and index it, the least
+  // recently used files are evicted if the capacity is exceeded.
+  bool Write(const std::string& token,
+             const std::string& signature,
+             const std::vector<uint8_t>& buffer);
+  std::string GetFilePath(const std::string& token) const;
+
+ private:
+  bool Lock();
+  void Unlock();
+  // Load the index from the file, an index which is missing, damaged or
+  // produced by another version is treated as an empty one.
+  void Load();
+  bool Store();
+  void Remove(const std::string& token);
+
+ private:
+  std::string dir_;
+  uint64_t capacity_{0};
+  uint64_t tick_{0};
+  std::map<std::string, Entry> entries_;
+  int lock_fd_{-1};
+};
+
 }  // namespace nnadapter
@@ -0,0 +1,167 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "utility/cache.h"
+#include <dirent.h>
+#include <gtest/gtest.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <string>
+#include <thread>  // NOLINT
+#include <vector>
+#include "utility/utility.h"
+
+namespace nnadapter {
+
+// A temporary cache dir which is removed with its files.
+class CacheDir {
+ public:
+  CacheDir() {
+    char path[] = "nnadapter_cache_test_XXXXXX";
+    path_ = mkdtemp(path);
+  }
+  ~CacheDir() {
+    auto dir = opendir(path_.c_str());
+    if (dir) {
+      while (auto entry = readdir(dir)) {
+        std::string name = entry->d_name;
+        if (name != "." && name != "..") {
+          remove((path_ + "/" + name).c_str());
+        }
+      }
+      closedir(dir);
+    }
+    rmdir(path_.c_str());
+  }
+  const std::string& path() const { return path_; }
+
+ private:
+  std::string path_;
+};
+
+std::vector<uint8_t> MakeBuffer(size_t size, uint8_t seed) {
+  std::vector<uint8_t> buffer(size);
+  for (size_t i = 0; i < size; i++) {
+    buffer[i] = static_cast<uint8_t>(seed + i * 7);
+  }
+  return buffer;
+}
+
+bool FileExists(const std::string& path) {
+  return access(path.c_str(), F_OK) == 0;
+}
+
+TEST(CacheIndex, read_write) {
+  CacheDir dir;
+  CacheIndex index(dir.path());
+  auto buffer = MakeBuffer(100, 1);
+  std::vector<uint8_t> result;
+  EXPECT_FALSE(index.Read("a", "device", &result));
+  ASSERT_TRUE(index.Write("a", "device", buffer));
+  EXPECT_TRUE(FileExists(index.GetFilePath("a")));
+  // The index is shared by the other instances, e.g. the other processes.
+  CacheIndex other(dir.path());
+  ASSERT_TRUE(other.Read("a", "device", &result));
+  EXPECT_EQ(result, buffer);
+}
+
+TEST(CacheIndex, crc_mismatch) {
+  CacheDir dir;
+  CacheIndex index(dir.path());
+  auto buffer = MakeBuffer(100, 1);
+  ASSERT_TRUE(index.Write("a", "device", buffer));
+  // Change the content of the file without changing its size.
+  auto damaged = buffer;
+  damaged[50] ^= 0xFF;
+  ASSERT_TRUE(WriteFile(index.GetFilePath("a"), damaged));
+  std::vector<uint8_t> result;
+  EXPECT_FALSE(index.Read("a", "device", &result));
+  EXPECT_TRUE(result.empty());
+  EXPECT_FALSE(FileExists(index.GetFilePath("a")));
+  // A truncated file is removed as well.
+  ASSERT_TRUE(index.Write("b", "device", buffer));
+  ASSERT_TRUE(WriteFile(index.GetFilePath("b"), MakeBuffer(10, 1)));
+  EXPECT_FALSE(index.Read("b", "device", &result));
+  EXPECT_FALSE(FileExists(index.GetFilePath("b")));
+}
+
+TEST(CacheIndex, signature_mismatch) {
+  CacheDir dir;
+  CacheIndex index(dir.path());
+  auto buffer = MakeBuffer(100, 1);
+  ASSERT_TRUE(index.Write("a", "device v1", buffer));
+  std::vector<uint8_t> result;
+  EXPECT_FALSE(index.Read("a", "device v2", &result));
+  EXPECT_FALSE(FileExists(index.GetFilePath("a")));
+  // The entry is removed, so it can't be read by the original devices either.
+  EXPECT_FALSE(index.Read("a", "device v1", &result));
+}
+
+TEST(CacheIndex, lru_eviction) {
+  CacheDir dir;
+  CacheIndex index(dir.path(), 300);
+  ASSERT_TRUE(index.Write("a", "device", MakeBuffer(100, 1)));
+  ASSERT_TRUE(index.Write("b", "device", MakeBuffer(100, 2)));
+  ASSERT_TRUE(index.Write("c", "device", MakeBuffer(100, 3)));
+  // 'a' becomes the most recently used one, so 'b' is evicted for 'd'.
+  std::vector<uint8_t> result;
+  ASSERT_TRUE(index.Read("a", "device", &result));
+  ASSERT_TRUE(index.Write("d", "device", MakeBuffer(100, 4)));
+  EXPECT_FALSE(FileExists(index.GetFilePath("b")));
+  EXPECT_FALSE(index.Read("b", "device", &result));
+  for (auto token : {"a", "c", "d"}) {
+    EXPECT_TRUE(index.Read(token, "device", &result)) << token;
+  }
+  // The file just written is kept even if it exceeds the capacity alone.
+  ASSERT_TRUE(index.Write("e", "device", MakeBuffer(400, 5)));
+  EXPECT_TRUE(index.Read("e", "device", &result));
+  for (auto token : {"a", "c", "d"}) {
+    EXPECT_FALSE(FileExists(index.GetFilePath(token))) << token;
+  }
+}
+
+// The writers update the index under the file lock, so none of the entries
+// is lost by the concurrent read-modify-write of the index.
+TEST(CacheIndex, locking) {
+  CacheDir dir;
+  const int num_threads = 4;
+  const int num_tokens = 16;
+  std::vector<std::thread> threads;
+  for (int i = 0; i < num_threads; i++) {
+    threads.emplace_back([&, i]() {
+      // An instance per thread opens the lock file on its own, as the ones of
+      // the different processes.
+      CacheIndex index(dir.path());
+      for (int j = 0; j < num_tokens; j++) {
+        auto token = std::to_string(i) + "_" + std::to_string(j);
+        EXPECT_TRUE(index.Write(token, "device", MakeBuffer(64, i + j)));
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  CacheIndex index(dir.path());
+  std::vector<uint8_t> result;
+  for (int i = 0; i < num_threads; i++) {
+    for (int j = 0; j < num_tokens; j++) {
+      auto token = std::to_string(i) + "_" + std::to_string(j);
+      ASSERT_TRUE(index.Read(token, "device", &result)) << token;
+      EXPECT_EQ(result, MakeBuffer(64, i + j));
+    }
+  }
+}
+
+}  // namespace nnadapter
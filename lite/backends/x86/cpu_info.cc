@@ -146,6 +146,10 @@ bool MayIUse(const cpu_isa_t cpu_isa) {
       return true && cpu.has(Cpu::tAVX512F) && cpu.has(Cpu::tAVX512BW) &&
              cpu.has(Cpu::tAVX512VL) && cpu.has(Cpu::tAVX512DQ) &&
              cpu.has(Cpu::tAVX512_VNNI);
+    case avx512_core_bf16:
+      return true && cpu.has(Cpu::tAVX512F) && cpu.has(Cpu::tAVX512BW) &&
+             cpu.has(Cpu::tAVX512VL) && cpu.has(Cpu::tAVX512DQ) &&
+             cpu.has(Cpu::tAVX512_BF16);
     case avx512_mic:
       return true && cpu.has(Cpu::tAVX512F) && cpu.has(Cpu::tAVX512CD) &&
              cpu.has(Cpu::tAVX512ER) && cpu.has(Cpu::tAVX512PF);
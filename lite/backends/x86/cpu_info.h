@@ -68,6 +68,7 @@ typedef enum {
   avx512f,
   avx512_core,
   avx512_core_vnni,
+  avx512_core_bf16,
   avx512_mic,
   avx512_mic_4ops,
 } cpu_isa_t;  // Instruction set architecture
@@ -229,6 +229,86 @@ void hard_swish(const float* din,
   }
 }
 
+// The tanh approximation equals x * sigmoid(2 * sqrt(2 / pi) * (x + 0.044715 *
+// x^3)), and erf is approximated by the polynomial of Abramowitz and Stegun
+// 7.1.26, whose max error is 1.5e-7.
+static const float kGeluTanhScale = -1.5957691216f;  // -2 * sqrt(2 / pi)
+static const float kErfP = 0.3275911f;
+static const float kErfA1 = 0.254829592f;
+static const float kErfA2 = -0.284496736f;
+static const float kErfA3 = 1.421413741f;
+static const float kErfA4 = -1.453152027f;
+static const float kErfA5 = 1.061405429f;
+
+static inline float gelu_tanh(float x) {
+  return x / (1.f + std::exp(kGeluTanhScale * (x + 0.044715f * x * x * x)));
+}
+
+static inline float gelu_erf(float x) {
+  float z = std::fabs(x) * static_cast<float>(M_SQRT1_2);
+  float t = 1.f / (1.f + kErfP * z);
+  float poly =
+      t * (kErfA1 + t * (kErfA2 + t * (kErfA3 + t * (kErfA4 + t * kErfA5))));
+  // 0.5 * (1 - erf(|x| / sqrt(2)))
+  float half_q = 0.5f * poly * std::exp(-z * z);
+  return x * (x >= 0.f ? 1.f - half_q : half_q);
+}
+
+#ifdef __AVX__
+static inline __m256 gelu_tanh_avx(__m256 x) {
+  __m256 x3 = _mm256_mul_ps(_mm256_mul_ps(x, x), x);
+  __m256 u = _mm256_fmadd_ps(x3, _mm256_set1_ps(0.044715f), x);
+  __m256 e = exp256_ps(_mm256_mul_ps(u, _mm256_set1_ps(kGeluTanhScale)));
+  return _mm256_div_ps(x, _mm256_add_ps(e, _mm256_set1_ps(1.f)));
+}
+
+static inline __m256 gelu_erf_avx(__m256 x) {
+  __m256 vone = _mm256_set1_ps(1.f);
+  __m256 vabs = _mm256_andnot_ps(_mm256_set1_ps(-0.f), x);
+  __m256 z = _mm256_mul_ps(vabs, _mm256_set1_ps(static_cast<float>(M_SQRT1_2)));
+  __m256 t = _mm256_div_ps(
+      vone, _mm256_fmadd_ps(z, _mm256_set1_ps(kErfP), vone));
+  __m256 poly = _mm256_fmadd_ps(
+      t, _mm256_set1_ps(kErfA5), _mm256_set1_ps(kErfA4));
+  poly = _mm256_fmadd_ps(poly, t, _mm256_set1_ps(kErfA3));
+  poly = _mm256_fmadd_ps(poly, t, _mm256_set1_ps(kErfA2));
+  poly = _mm256_fmadd_ps(poly, t, _mm256_set1_ps(kErfA1));
+  poly = _mm256_mul_ps(poly, t);
+  __m256 e = exp256_ps(_mm256_sub_ps(_mm256_setzero_ps(), _mm256_mul_ps(z, z)));
+  __m256 half_q = _mm256_mul_ps(_mm256_mul_ps(poly, e), _mm256_set1_ps(0.5f));
+  __m256 positive = _mm256_cmp_ps(x, _mm256_setzero_ps(), _CMP_GE_OQ);
+  return _mm256_mul_ps(
+      x, _mm256_blendv_ps(half_q, _mm256_sub_ps(vone, half_q), positive));
+}
+#endif
+
+template <>
+void gelu(const float* din, float* dout, int size, bool approximate) {
+  // Each thread takes the blocks of 4096 elements.
+  const int kBlockSize = 4096;
+  int num_blocks = (size + kBlockSize - 1) / kBlockSize;
+#pragma omp parallel for
+  for (int b = 0; b < num_blocks; ++b) {
+    int start = b * kBlockSize;
+    int end = std::min(size, start + kBlockSize);
+    int i = start;
+#ifdef __AVX__
+    if (approximate) {
+      for (; i + 7 < end; i += 8) {
+        _mm256_storeu_ps(dout + i, gelu_tanh_avx(_mm256_loadu_ps(din + i)));
+      }
+    } else {
+      for (; i + 7 < end; i += 8) {
+        _mm256_storeu_ps(dout + i, gelu_erf_avx(_mm256_loadu_ps(din + i)));
+      }
+    }
+#endif
+    for (; i < end; ++i) {
+      dout[i] = approximate ? gelu_tanh(din[i]) : gelu_erf(din[i]);
+    }
+  }
+}
+
 }  // namespace math
 }  // namespace x86
 }  // namespace lite
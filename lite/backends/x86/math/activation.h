@@ -30,6 +30,11 @@ void hard_swish(const T* din,
                 float offset,
                 float threshold);
 
+// gelu(x) = 0.5 * x * (1 + erf(x / sqrt(2))), or with the tanh approximation
+// 0.5 * x * (1 + tanh(sqrt(2 / pi) * (x + 0.044715 * x^3))) if approximate.
+template <typename T>
+void gelu(const T* din, T* dout, int size, bool approximate);
+
 }  // namespace math
 }  // namespace x86
 }  // namespace lite
@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 #pragma once
+#include <algorithm>
 #include <cmath>
 #include <limits>
 #include <vector>
@@ -645,6 +646,14 @@ void Blas<lite::TargetType::kX86>::BatchedGEMM(CBLAS_TRANSPOSE transA,
                                                int batchCount,
                                                int64_t strideA,
                                                int64_t strideB) const {
+  // The broadcast B with the contiguous A is one GEMM of batchCount * M rows,
+  // B is packed once instead of once per batch.
+  if (strideB == 0 && transA == CblasNoTrans &&
+      strideA == static_cast<int64_t>(M) * K) {
+    this->template GEMM<T>(
+        transA, transB, batchCount * M, N, K, alpha, A, B, beta, C);
+    return;
+  }
 #ifdef PADDLE_WITH_MKLML
   int lda = (transA == CblasNoTrans) ? K : M;
   int ldb = (transB == CblasNoTrans) ? N : K;
@@ -766,22 +775,24 @@ void Blas<Target>::MatMul(const lite::Tensor &mat_a,
                            beta,
                            mat_out->template mutable_data<T>());
   } else {
-    CHECK(dim_a.batch_size_ == dim_b.batch_size_ || dim_a.batch_size_ == 0 ||
-          dim_b.batch_size_ == 0);
-    this->template BatchedGEMM<T>(
-        transA,
-        transB,
-        dim_a.height_,
-        dim_b.width_,
-        dim_a.width_,
-        alpha,
-        mat_a.data<T>(),
-        mat_b.data<T>(),
-        beta,
-        mat_out->template mutable_data<T>(),
-        dim_a.batch_size_ == 0 ? dim_b.batch_size_ : dim_a.batch_size_,
-        dim_a.stride_,
-        dim_b.stride_);
+    // The batch of size 1 is broadcast like the 2-D matrix, by the zero
+    // stride.
+    int64_t batch_a = std::max<int64_t>(dim_a.batch_size_, 1);
+    int64_t batch_b = std::max<int64_t>(dim_b.batch_size_, 1);
+    CHECK(batch_a == batch_b || batch_a == 1 || batch_b == 1);
+    this->template BatchedGEMM<T>(transA,
+                                  transB,
+                                  dim_a.height_,
+                                  dim_b.width_,
+                                  dim_a.width_,
+                                  alpha,
+                                  mat_a.data<T>(),
+                                  mat_b.data<T>(),
+                                  beta,
+                                  mat_out->template mutable_data<T>(),
+                                  std::max(batch_a, batch_b),
+                                  batch_a == 1 ? 0 : dim_a.stride_,
+                                  batch_b == 1 ? 0 : dim_b.stride_);
   }
 }
 template <lite::TargetType Target>
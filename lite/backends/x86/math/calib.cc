@@ -238,6 +238,27 @@ void int8_to_fp32(const int8_t* in,
   }
 }
 
+void int8_to_int8(const int8_t* in,
+                  int8_t* out,
+                  float in_scale,
+                  float out_scale,
+                  int64_t size) {
+  if (in_scale == out_scale) {
+    if (in != out) memcpy(out, in, size);
+    return;
+  }
+  // There are only 256 input values, look them up instead of computing.
+  int8_t table[256];
+  for (int i = -128; i < 128; i++) {
+    table[static_cast<uint8_t>(i)] = quantize_int8(i * in_scale, out_scale);
+  }
+  const uint8_t* din = reinterpret_cast<const uint8_t*>(in);
+#pragma omp parallel for
+  for (int64_t i = 0; i < size; i++) {
+    out[i] = table[din[i]];
+  }
+}
+
 }  // namespace math
 }  // namespace x86
 }  // namespace lite
@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include <math.h>
 #include <stdint.h>
 #include <vector>
 #include "lite/core/target_wrapper.h"
@@ -37,6 +38,37 @@ void int8_to_fp32(const int8_t* in,
                   int64_t outer_size,
                   int64_t inner_size);
 
+// Quantize a real value with the scale(real = int8 * scale), the result is
+// clamped to [-127, 127].
+inline int8_t quantize_int8(float v, float scale) {
+  float q = roundf(v / scale);
+  q = q > 127.f ? 127.f : (q < -127.f ? -127.f : q);
+  return static_cast<int8_t>(q);
+}
+
+// Convert a real value to the output type of the int8 kernels, it's quantized
+// for the int8 output and kept for the float output.
+template <typename T>
+inline T quantize_to(float v, float scale);
+
+template <>
+inline int8_t quantize_to<int8_t>(float v, float scale) {
+  return quantize_int8(v, scale);
+}
+
+template <>
+inline float quantize_to<float>(float v, float scale) {
+  return v;
+}
+
+// Requantize the int8 data from in_scale to out_scale, `in` and `out` can be
+// the same buffer.
+void int8_to_int8(const int8_t* in,
+                  int8_t* out,
+                  float in_scale,
+                  float out_scale,
+                  int64_t size);
+
 }  // namespace math
 }  // namespace x86
 }  // namespace lite
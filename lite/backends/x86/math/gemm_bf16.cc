@@ -0,0 +1,433 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/backends/x86/math/gemm_bf16.h"
+#include <algorithm>
+#include "lite/backends/x86/cpu_info.h"
+#include "lite/backends/x86/parallel.h"
+#include "lite/core/workspace.h"
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+// The file is built with -mavx2, the AVX512-BF16 code is enabled per function
+// and only dispatched on the cpus which support it.
+#ifdef __AVX2__
+#if defined(__clang__)
+#if __clang_major__ >= 9
+#define LITE_X86_GEMM_AVX512BF16
+#endif
+#elif defined(__GNUC__) && __GNUC__ >= 10
+#define LITE_X86_GEMM_AVX512BF16
+#endif
+#endif  // __AVX2__
+
+#ifdef LITE_X86_GEMM_AVX512BF16
+#define GEMM_BF16_TARGET \
+  __attribute__((target("avx512f,avx512bw,avx512dq,avx512vl,avx512bf16")))
+#endif
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+
+namespace {
+
+// the columns of a packed panel
+const int kPanel = 16;
+// the rows of A computed together
+const int kMr = 4;
+
+inline uint16_t to_bf16_bits(float val) { return fp32_to_bf16_bits(val); }
+inline uint16_t to_bf16_bits(bfloat16 val) { return val.x; }
+
+template <typename T>
+void gemm_bf16_packb_impl(
+    int K, int N, const T* B, int ldb, bfloat16* packed_B) {
+  const int kh = (K + 1) / 2;
+  const int panels = (N + kPanel - 1) / kPanel;
+  uint16_t* out = reinterpret_cast<uint16_t*>(packed_B);
+  for (int p = 0; p < panels; ++p) {
+    for (int q = 0; q < kh; ++q) {
+      for (int c = 0; c < kPanel; ++c) {
+        int n = p * kPanel + c;
+        for (int h = 0; h < 2; ++h) {
+          int k = 2 * q + h;
+          *out++ = (k < K && n < N) ? to_bf16_bits(B[k * ldb + n]) : 0;
+        }
+      }
+    }
+  }
+}
+
+#ifndef __AVX2__
+// C[mr, ncols] = A[mr, K] * b, b is one packed panel
+void gemm_bf16_kernel_ref(int mr,
+                          int K,
+                          const float* A,
+                          int lda,
+                          const uint16_t* b,
+                          float* C,
+                          int ldc,
+                          int ncols,
+                          const float* bias,
+                          bool relu) {
+  for (int r = 0; r < mr; ++r) {
+    for (int c = 0; c < ncols; ++c) {
+      float sum = bias ? bias[c] : 0.f;
+      for (int k = 0; k < K; ++k) {
+        sum += A[r * lda + k] *
+               bf16_bits_to_fp32(b[(k >> 1) * 2 * kPanel + c * 2 + (k & 1)]);
+      }
+      C[r * ldc + c] = relu ? std::max(sum, 0.f) : sum;
+    }
+  }
+}
+#else
+template <int MR>
+void gemm_bf16_kernel_avx2(int K,
+                           const float* A,
+                           int lda,
+                           const uint16_t* b,
+                           float* C,
+                           int ldc,
+                           int ncols,
+                           const float* bias,
+                           bool relu) {
+  __m256 acc[MR][2];
+  for (int r = 0; r < MR; ++r) {
+    acc[r][0] = _mm256_setzero_ps();
+    acc[r][1] = _mm256_setzero_ps();
+  }
+  const __m256i vmask_hi = _mm256_set1_epi32(static_cast<int>(0xffff0000u));
+  // the even k is in the low half of the pair, the odd k in the high half
+  for (int k = 0; k < K - 1; k += 2) {
+    __m256i vb0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b));
+    __m256i vb1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + 16));
+    __m256 vb0_e = _mm256_castsi256_ps(_mm256_slli_epi32(vb0, 16));
+    __m256 vb0_o = _mm256_castsi256_ps(_mm256_and_si256(vb0, vmask_hi));
+    __m256 vb1_e = _mm256_castsi256_ps(_mm256_slli_epi32(vb1, 16));
+    __m256 vb1_o = _mm256_castsi256_ps(_mm256_and_si256(vb1, vmask_hi));
+    for (int r = 0; r < MR; ++r) {
+      __m256 va_e = _mm256_set1_ps(A[r * lda + k]);
+      __m256 va_o = _mm256_set1_ps(A[r * lda + k + 1]);
+      acc[r][0] = _mm256_fmadd_ps(va_e, vb0_e, acc[r][0]);
+      acc[r][1] = _mm256_fmadd_ps(va_e, vb1_e, acc[r][1]);
+      acc[r][0] = _mm256_fmadd_ps(va_o, vb0_o, acc[r][0]);
+      acc[r][1] = _mm256_fmadd_ps(va_o, vb1_o, acc[r][1]);
+    }
+    b += 2 * kPanel;
+  }
+  if (K & 1) {
+    __m256i vb0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b));
+    __m256i vb1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + 16));
+    __m256 vb0_e = _mm256_castsi256_ps(_mm256_slli_epi32(vb0, 16));
+    __m256 vb1_e = _mm256_castsi256_ps(_mm256_slli_epi32(vb1, 16));
+    for (int r = 0; r < MR; ++r) {
+      __m256 va_e = _mm256_set1_ps(A[r * lda + K - 1]);
+      acc[r][0] = _mm256_fmadd_ps(va_e, vb0_e, acc[r][0]);
+      acc[r][1] = _mm256_fmadd_ps(va_e, vb1_e, acc[r][1]);
+    }
+  }
+
+  const __m256 vzero = _mm256_setzero_ps();
+  if (ncols == kPanel) {
+    __m256 vbias0 = bias ? _mm256_loadu_ps(bias) : vzero;
+    __m256 vbias1 = bias ? _mm256_loadu_ps(bias + 8) : vzero;
+    for (int r = 0; r < MR; ++r) {
+      __m256 v0 = _mm256_add_ps(acc[r][0], vbias0);
+      __m256 v1 = _mm256_add_ps(acc[r][1], vbias1);
+      if (relu) {
+        v0 = _mm256_max_ps(v0, vzero);
+        v1 = _mm256_max_ps(v1, vzero);
+      }
+      _mm256_storeu_ps(C + r * ldc, v0);
+      _mm256_storeu_ps(C + r * ldc + 8, v1);
+    }
+  } else {
+    float tile[kPanel];
+    for (int r = 0; r < MR; ++r) {
+      _mm256_storeu_ps(tile, acc[r][0]);
+      _mm256_storeu_ps(tile + 8, acc[r][1]);
+      for (int c = 0; c < ncols; ++c) {
+        float v = tile[c] + (bias ? bias[c] : 0.f);
+        C[r * ldc + c] = relu ? std::max(v, 0.f) : v;
+      }
+    }
+  }
+}
+#endif  // __AVX2__
+
+void gemm_bf16_panel(int mr,
+                     int K,
+                     const float* A,
+                     int lda,
+                     const uint16_t* b,
+                     float* C,
+                     int ldc,
+                     int ncols,
+                     const float* bias,
+                     bool relu) {
+#ifdef __AVX2__
+  switch (mr) {
+    case 4:
+      gemm_bf16_kernel_avx2<4>(K, A, lda, b, C, ldc, ncols, bias, relu);
+      break;
+    case 3:
+      gemm_bf16_kernel_avx2<3>(K, A, lda, b, C, ldc, ncols, bias, relu);
+      break;
+    case 2:
+      gemm_bf16_kernel_avx2<2>(K, A, lda, b, C, ldc, ncols, bias, relu);
+      break;
+    default:
+      gemm_bf16_kernel_avx2<1>(K, A, lda, b, C, ldc, ncols, bias, relu);
+      break;
+  }
+#else
+  gemm_bf16_kernel_ref(mr, K, A, lda, b, C, ldc, ncols, bias, relu);
+#endif
+}
+
+#ifdef LITE_X86_GEMM_AVX512BF16
+// C[MR, ncols] = A[MR, K] * b, A is in bf16 and read as the pairs of k, b is
+// NP panels which are `panel_stride` apart.
+template <int MR, int NP>
+GEMM_BF16_TARGET void gemm_bf16_kernel_avx512(int kh,
+                                              const uint32_t* a,
+                                              const uint16_t* b,
+                                              int64_t panel_stride,
+                                              float* C,
+                                              int ldc,
+                                              int ncols,
+                                              const float* bias,
+                                              bool relu) {
+  __m512 acc[MR][NP];
+  for (int r = 0; r < MR; ++r) {
+    for (int p = 0; p < NP; ++p) {
+      acc[r][p] = _mm512_setzero_ps();
+    }
+  }
+  for (int q = 0; q < kh; ++q) {
+    __m512i vb[NP];
+    for (int p = 0; p < NP; ++p) {
+      vb[p] = _mm512_loadu_si512(b + p * panel_stride + q * 2 * kPanel);
+    }
+    for (int r = 0; r < MR; ++r) {
+      __m512i va = _mm512_set1_epi32(static_cast<int>(a[r * kh + q]));
+      for (int p = 0; p < NP; ++p) {
+        acc[r][p] = _mm512_dpbf16_ps(acc[r][p],
+                                     reinterpret_cast<__m512bh>(va),
+                                     reinterpret_cast<__m512bh>(vb[p]));
+      }
+    }
+  }
+  const __m512 vzero = _mm512_setzero_ps();
+  for (int p = 0; p < NP; ++p) {
+    int cols = std::min(kPanel, ncols - p * kPanel);
+    __mmask16 mask = cols >= kPanel ? static_cast<__mmask16>(0xffff)
+                                    : static_cast<__mmask16>((1u << cols) - 1);
+    __m512 vbias =
+        bias ? _mm512_maskz_loadu_ps(mask, bias + p * kPanel) : vzero;
+    for (int r = 0; r < MR; ++r) {
+      __m512 v = _mm512_add_ps(acc[r][p], vbias);
+      if (relu) {
+        v = _mm512_max_ps(v, vzero);
+      }
+      _mm512_mask_storeu_ps(C + r * ldc + p * kPanel, mask, v);
+    }
+  }
+}
+
+template <int NP>
+void gemm_bf16_panels_avx512(int mr,
+                             int kh,
+                             const uint32_t* a,
+                             const uint16_t* b,
+                             int64_t panel_stride,
+                             float* C,
+                             int ldc,
+                             int ncols,
+                             const float* bias,
+                             bool relu) {
+  switch (mr) {
+    case 4:
+      gemm_bf16_kernel_avx512<4, NP>(
+          kh, a, b, panel_stride, C, ldc, ncols, bias, relu);
+      break;
+    case 3:
+      gemm_bf16_kernel_avx512<3, NP>(
+          kh, a, b, panel_stride, C, ldc, ncols, bias, relu);
+      break;
+    case 2:
+      gemm_bf16_kernel_avx512<2, NP>(
+          kh, a, b, panel_stride, C, ldc, ncols, bias, relu);
+      break;
+    default:
+      gemm_bf16_kernel_avx512<1, NP>(
+          kh, a, b, panel_stride, C, ldc, ncols, bias, relu);
+      break;
+  }
+}
+#endif  // LITE_X86_GEMM_AVX512BF16
+
+}  // namespace
+
+void fp32_to_bf16(const float* din, bfloat16* dout, int64_t size) {
+  uint16_t* out = reinterpret_cast<uint16_t*>(dout);
+  int64_t i = 0;
+#ifdef __AVX2__
+  const __m256i vone = _mm256_set1_epi32(1);
+  const __m256i vround = _mm256_set1_epi32(0x7fff);
+  const __m256i vquiet = _mm256_set1_epi32(0x400000);
+  for (; i + 8 <= size; i += 8) {
+    __m256 vf = _mm256_loadu_ps(din + i);
+    __m256i v = _mm256_castps_si256(vf);
+    __m256i vlsb = _mm256_and_si256(_mm256_srli_epi32(v, 16), vone);
+    __m256i vrnd = _mm256_add_epi32(v, _mm256_add_epi32(vround, vlsb));
+    __m256 vnan = _mm256_cmp_ps(vf, vf, _CMP_UNORD_Q);
+    vrnd = _mm256_castps_si256(
+        _mm256_blendv_ps(_mm256_castsi256_ps(vrnd),
+                         _mm256_castsi256_ps(_mm256_or_si256(v, vquiet)),
+                         vnan));
+    vrnd = _mm256_srli_epi32(vrnd, 16);
+    // pack within the 128-bit lanes, then gather the two low halves
+    __m256i vpack = _mm256_permute4x64_epi64(_mm256_packus_epi32(vrnd, vrnd),
+                                             _MM_SHUFFLE(3, 1, 2, 0));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i),
+                     _mm256_castsi256_si128(vpack));
+  }
+#endif
+  for (; i < size; ++i) {
+    out[i] = fp32_to_bf16_bits(din[i]);
+  }
+}
+
+void bf16_to_fp32(const bfloat16* din, float* dout, int64_t size) {
+  const uint16_t* in = reinterpret_cast<const uint16_t*>(din);
+  int64_t i = 0;
+#ifdef __AVX2__
+  for (; i + 8 <= size; i += 8) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+    __m256i vf = _mm256_slli_epi32(_mm256_cvtepu16_epi32(v), 16);
+    _mm256_storeu_ps(dout + i, _mm256_castsi256_ps(vf));
+  }
+#endif
+  for (; i < size; ++i) {
+    dout[i] = bf16_bits_to_fp32(in[i]);
+  }
+}
+
+int64_t gemm_bf16_packb_size(int K, int N) {
+  return static_cast<int64_t>((N + kPanel - 1) / kPanel) * ((K + 1) / 2) * 2 *
+         kPanel;
+}
+
+void gemm_bf16_packb(
+    int K, int N, const float* B, int ldb, bfloat16* packed_B) {
+  gemm_bf16_packb_impl(K, N, B, ldb, packed_B);
+}
+
+void gemm_bf16_packb(
+    int K, int N, const bfloat16* B, int ldb, bfloat16* packed_B) {
+  gemm_bf16_packb_impl(K, N, B, ldb, packed_B);
+}
+
+void gemm_bf16(int M,
+               int N,
+               int K,
+               const float* A,
+               int lda,
+               const bfloat16* packed_B,
+               float* C,
+               int ldc,
+               const float* bias,
+               bool relu) {
+  if (M <= 0 || N <= 0) {
+    return;
+  }
+  const int kh = (K + 1) / 2;
+  const int panels = (N + kPanel - 1) / kPanel;
+  const int64_t panel_stride = static_cast<int64_t>(kh) * 2 * kPanel;
+  const uint16_t* b = reinterpret_cast<const uint16_t*>(packed_B);
+
+#ifdef LITE_X86_GEMM_AVX512BF16
+  if (MayIUse(avx512_core_bf16)) {
+    // the rows of A in bf16, each of them is padded to kh pairs
+    auto& workspace = WorkSpace::Current();
+    size_t mark = workspace.Mark();
+    uint32_t* a_pairs =
+        workspace.Alloc<uint32_t>(static_cast<size_t>(M) * kh);
+    for (int i = 0; i < M; ++i) {
+      uint32_t* a_row = a_pairs + static_cast<int64_t>(i) * kh;
+      // the odd K leaves the high half of the last pair
+      if (K % 2) a_row[kh - 1] = 0;
+      fp32_to_bf16(A + static_cast<int64_t>(i) * lda,
+                   reinterpret_cast<bfloat16*>(a_row),
+                   K);
+    }
+    // two panels are computed together to hide the latency of vdpbf16ps
+    RunParallelFor(0, (panels + 1) / 2, [&](int64_t begin, int64_t end) {
+      for (int64_t g = begin; g < end; ++g) {
+        int n0 = static_cast<int>(g) * 2 * kPanel;
+        int ncols = std::min(N - n0, 2 * kPanel);
+        const uint16_t* bp = b + 2 * g * panel_stride;
+        const float* bias_p = bias ? bias + n0 : nullptr;
+        for (int i = 0; i < M; i += kMr) {
+          int mr = std::min(kMr, M - i);
+          const uint32_t* ap = a_pairs + static_cast<int64_t>(i) * kh;
+          float* cp = C + static_cast<int64_t>(i) * ldc + n0;
+          if (ncols > kPanel) {
+            gemm_bf16_panels_avx512<2>(
+                mr, kh, ap, bp, panel_stride, cp, ldc, ncols, bias_p, relu);
+          } else {
+            gemm_bf16_panels_avx512<1>(
+                mr, kh, ap, bp, panel_stride, cp, ldc, ncols, bias_p, relu);
+          }
+        }
+      }
+    });
+    workspace.Release(mark);
+    return;
+  }
+#endif  // LITE_X86_GEMM_AVX512BF16
+
+  // each panel of B stays in cache while all of the rows of A are computed
+  RunParallelFor(0, panels, [&](int64_t begin, int64_t end) {
+    for (int64_t p = begin; p < end; ++p) {
+      int n0 = static_cast<int>(p) * kPanel;
+      int ncols = std::min(N - n0, kPanel);
+      const uint16_t* bp = b + p * panel_stride;
+      const float* bias_p = bias ? bias + n0 : nullptr;
+      for (int i = 0; i < M; i += kMr) {
+        int mr = std::min(kMr, M - i);
+        gemm_bf16_panel(mr,
+                        K,
+                        A + static_cast<int64_t>(i) * lda,
+                        lda,
+                        bp,
+                        C + static_cast<int64_t>(i) * ldc + n0,
+                        ldc,
+                        ncols,
+                        bias_p,
+                        relu);
+      }
+    }
+  });
+}
+
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
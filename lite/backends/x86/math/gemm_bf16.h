@@ -0,0 +1,59 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <stdint.h>
+#include "lite/utils/bfloat16.h"
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+
+void fp32_to_bf16(const float* din, bfloat16* dout, int64_t size);
+
+void bf16_to_fp32(const bfloat16* din, float* dout, int64_t size);
+
+// B[K, N] is packed into the panels of 16 columns whose rows are the pairs of
+// k, [ceil(N / 16)][ceil(K / 2)][16][2], padded with zeros. It's the operand
+// layout of the AVX512-BF16 vdpbf16ps.
+int64_t gemm_bf16_packb_size(int K, int N);
+
+void gemm_bf16_packb(
+    int K, int N, const float* B, int ldb, bfloat16* packed_B);
+
+void gemm_bf16_packb(
+    int K, int N, const bfloat16* B, int ldb, bfloat16* packed_B);
+
+// C[M, N] = A[M, K] * B[K, N] + bias[N], followed by relu if `relu` is true.
+// A and C are float and B is packed by gemm_bf16_packb, the bias can be null.
+// The products are computed by vdpbf16ps on the cpus which support
+// AVX512-BF16, A is rounded to bf16 then. Otherwise B is widened to float in
+// the registers, only the loads of B are halved.
+void gemm_bf16(int M,
+               int N,
+               int K,
+               const float* A,
+               int lda,
+               const bfloat16* packed_B,
+               float* C,
+               int ldc,
+               const float* bias,
+               bool relu);
+
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
@@ -17,6 +17,7 @@ limitations under the License. */
 #include <string.h>
 #include <algorithm>
 #include <cmath>
+#include "lite/backends/x86/cpu_info.h"
 #include "lite/backends/x86/math/gemm_s8u8_kernel.h"
 #include "lite/backends/x86/math/gemm_s8u8_pack.h"
 #include "lite/core/memory.h"
@@ -57,11 +58,20 @@ class generate_gemm_s8u8_x86_kern {
                                        int relu_type,
                                        float relu_alpha) {
     PARAM_INIT
+    _use_vnni = MayIUse(avx512_core_vnni);
     gemm_int8_init(M, N, K, bias);
   }
 
   ~generate_gemm_s8u8_x86_kern() { gemm_int8_deinit(); }
 
+  // Packs a new A of the same shape, e.g. the activations of the next run,
+  // so the kernel and its buffers are reused for the changing A.
+  void prepare_A(const int8_t *A) {
+    _A = A;
+    repack_bias(_is_trans_A, _M, _K, _bias, _re_bias, _Sa, _Sb, _Sc, _A);
+    prepackA_i8(_M, _K, _A, _pack_A, _is_trans_A);
+  }
+
   void compute(const int8_t *A, const int8_t *B, TYPE_C *C) {
     if (_relu_type < 0 || _relu_type > 3) {
       LOG(FATAL) << "relu_type: 1 for relu, 2 for relu6, 3 for leakyrelu, but "
@@ -90,17 +100,31 @@ class generate_gemm_s8u8_x86_kern {
         cur_c = _C + loop_m * _ldc + loop_n;
 
         // kernel
-        gemm_kernel_loop_int8(min_m,
-                              min_n,
-                              _K,
-                              cur_a,
-                              _pack_B,
-                              cur_c,
-                              _ldc,
-                              _scale + loop_m,
-                              _re_bias + loop_m,
-                              _relu_type,
-                              _relu_alpha);
+        if (_use_vnni) {
+          gemm_kernel_loop_int8_vnni(min_m,
+                                     min_n,
+                                     _K,
+                                     cur_a,
+                                     _pack_B,
+                                     cur_c,
+                                     _ldc,
+                                     _scale + loop_m,
+                                     _re_bias + loop_m,
+                                     _relu_type,
+                                     _relu_alpha);
+        } else {
+          gemm_kernel_loop_int8(min_m,
+                                min_n,
+                                _K,
+                                cur_a,
+                                _pack_B,
+                                cur_c,
+                                _ldc,
+                                _scale + loop_m,
+                                _re_bias + loop_m,
+                                _relu_type,
+                                _relu_alpha);
+        }
       }
     }
   }
@@ -115,6 +139,8 @@ class generate_gemm_s8u8_x86_kern {
   bool _C_is_int8;
   bool _is_trans_A;
   bool _is_trans_B;
+  // run the AVX512-VNNI kernel on the packed data
+  bool _use_vnni{false};
   // divide block param
   const int _unroll_n = 32;
   const int _unroll_m = 2;
@@ -125,6 +151,7 @@ class generate_gemm_s8u8_x86_kern {
   float *_scale{nullptr};
   float *_in_bias{nullptr};
   float *_re_bias{nullptr};
+  const float *_bias{nullptr};
   int8_t *_pack_A{nullptr};
   uint8_t *_pack_B{nullptr};
   const int8_t *_A{nullptr};
@@ -182,12 +209,12 @@ class generate_gemm_s8u8_x86_kern {
       _in_bias = reinterpret_cast<float *>(
           TargetMalloc(TARGET(kX86), M * sizeof(float)));
       memset(_in_bias, 0, M * sizeof(float));
-      repack_bias(_is_trans_A, M, K, _in_bias, _re_bias, _Sa, _Sb, _Sc, _A);
+      _bias = _in_bias;
     } else {
-      repack_bias(_is_trans_A, M, K, bias, _re_bias, _Sa, _Sb, _Sc, _A);
+      _bias = bias;
     }
     calc_scale(M, _Sa, _Sb, _Sc, _scale);
-    prepackA_i8(M, K, _A, _pack_A, _is_trans_A);
+    prepare_A(_A);
   }
 
   void gemm_int8_deinit() {
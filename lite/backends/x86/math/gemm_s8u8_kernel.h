@@ -45,6 +45,34 @@ void gemm_kernel_loop_int8(int M,
                            int relu_type,
                            float relu_alpha);
 
+// The same as gemm_kernel_loop_int8 on the packed A and B, but computed by
+// the AVX512-VNNI vpdpbusd, which accumulates the u8 x s8 products to int32
+// directly instead of saturating them to int16. It should be only called if
+// MayIUse(avx512_core_vnni) is true.
+void gemm_kernel_loop_int8_vnni(int M,
+                                int N,
+                                int K,
+                                int8_t* A,
+                                uint8_t* B,
+                                int8_t* C,
+                                int ldc,
+                                const float* scale,
+                                const float* bias,
+                                int relu_type,
+                                float relu_alpha);
+
+void gemm_kernel_loop_int8_vnni(int M,
+                                int N,
+                                int K,
+                                int8_t* A,
+                                uint8_t* B,
+                                float* C,
+                                int ldc,
+                                const float* scale,
+                                const float* bias,
+                                int relu_type,
+                                float relu_alpha);
+
 }  // namespace math
 }  // namespace x86
 }  // namespace lite
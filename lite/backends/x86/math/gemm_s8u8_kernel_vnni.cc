@@ -0,0 +1,258 @@
+/* Copyright (c) 2021 paddlepaddle Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License. */
+
+#ifdef __AVX2__
+
+#include <immintrin.h>
+#include <stdint.h>
+#include "lite/backends/x86/math/gemm_s8u8_kernel.h"
+
+// The file is built with -mavx2, the AVX512-VNNI code is enabled per
+// function and only dispatched on the cpus which support it.
+#if defined(__GNUC__) || defined(__clang__)
+#define GEMM_VNNI_TARGET \
+  __attribute__((target("avx512f,avx512bw,avx512dq,avx512vl,avx512vnni")))
+#else
+#define GEMM_VNNI_TARGET
+#endif
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+
+namespace {
+
+// The packed B is divided into the tiles of 32, 24, 16, 8, 4, 2 and 1 columns,
+// see gemm_s8u8s8_runpackB.
+inline int vnni_tile_n(int remain) {
+  if (remain >= 32) return 32;
+  if (remain >= 24) return 24;
+  if (remain >= 16) return 16;
+  if (remain >= 8) return 8;
+  if (remain >= 4) return 4;
+  if (remain >= 2) return 2;
+  return 1;
+}
+
+inline __mmask16 vnni_lane_mask(int n) {
+  return n >= 16 ? static_cast<__mmask16>(0xffff)
+                 : static_cast<__mmask16>((1u << n) - 1);
+}
+
+GEMM_VNNI_TARGET inline __m512 vnni_act(__m512 x,
+                                        __m512 vec_alpha,
+                                        int relu_type) {
+  __m512 vec_zero = _mm512_setzero_ps();
+  switch (relu_type) {
+    case 1:
+      return _mm512_max_ps(x, vec_zero);
+    case 2:
+      return _mm512_min_ps(_mm512_max_ps(x, vec_zero), vec_alpha);
+    case 3: {
+      __mmask16 neg = _mm512_cmp_ps_mask(x, vec_zero, _CMP_LE_OS);
+      return _mm512_mask_mul_ps(x, neg, x, vec_alpha);
+    }
+    default:
+      return x;
+  }
+}
+
+GEMM_VNNI_TARGET inline void vnni_store(
+    __m512 x, __mmask16 mask, int8_t* dst) {
+  __m512i vec_i32 = _mm512_cvtps_epi32(x);
+  vec_i32 = _mm512_max_epi32(vec_i32, _mm512_set1_epi32(-127));
+  vec_i32 = _mm512_min_epi32(vec_i32, _mm512_set1_epi32(127));
+  _mm_mask_storeu_epi8(dst, mask, _mm512_cvtepi32_epi8(vec_i32));
+}
+
+GEMM_VNNI_TARGET inline void vnni_store(__m512 x, __mmask16 mask, float* dst) {
+  _mm512_mask_storeu_ps(dst, mask, x);
+}
+
+// Compute MR rows x tile_n(<= 32) columns, every column of the packed B holds
+// 4 consecutive k, which is exactly what vpdpbusd consumes, and the two zmm
+// registers cover 16 columns each.
+template <int MR, typename TYPE_C>
+GEMM_VNNI_TARGET void vnni_kernel(const int8_t* const* a_rows,
+                                  int a_step,
+                                  const uint8_t* b_ptr,
+                                  int tile_n,
+                                  int k_loop,
+                                  TYPE_C* c_ptr,
+                                  int ldc,
+                                  const float* scale,
+                                  const float* bias,
+                                  int relu_type,
+                                  float relu_alpha) {
+  __mmask16 mask0 = vnni_lane_mask(tile_n);
+  __mmask16 mask1 = vnni_lane_mask(tile_n > 16 ? tile_n - 16 : 0);
+  __m512i vec_c[MR][2];
+  for (int i = 0; i < MR; i++) {
+    vec_c[i][0] = _mm512_setzero_si512();
+    vec_c[i][1] = _mm512_setzero_si512();
+  }
+  for (int k = 0; k < k_loop; k++) {
+    __m512i vec_b0 = _mm512_maskz_loadu_epi32(mask0, b_ptr);
+    __m512i vec_b1 = _mm512_maskz_loadu_epi32(mask1, b_ptr + 64);
+    for (int i = 0; i < MR; i++) {
+      __m512i vec_a = _mm512_set1_epi32(
+          *reinterpret_cast<const int32_t*>(a_rows[i] + k * a_step));
+      vec_c[i][0] = _mm512_dpbusd_epi32(vec_c[i][0], vec_b0, vec_a);
+      vec_c[i][1] = _mm512_dpbusd_epi32(vec_c[i][1], vec_b1, vec_a);
+    }
+    b_ptr += tile_n * 4;
+  }
+  __m512 vec_alpha = _mm512_set1_ps(relu_alpha);
+  for (int i = 0; i < MR; i++) {
+    __m512 vec_scale = _mm512_set1_ps(scale[i]);
+    __m512 vec_bias = _mm512_set1_ps(bias[i]);
+    __m512 out0 = _mm512_fmadd_ps(
+        _mm512_cvtepi32_ps(vec_c[i][0]), vec_scale, vec_bias);
+    vnni_store(vnni_act(out0, vec_alpha, relu_type), mask0, c_ptr + i * ldc);
+    if (tile_n > 16) {
+      __m512 out1 = _mm512_fmadd_ps(
+          _mm512_cvtepi32_ps(vec_c[i][1]), vec_scale, vec_bias);
+      vnni_store(
+          vnni_act(out1, vec_alpha, relu_type), mask1, c_ptr + i * ldc + 16);
+    }
+  }
+}
+
+// The packed A holds the rows in pairs, [M / 2][k_loop][2][4], and the last
+// odd row is [k_loop][4].
+template <typename TYPE_C>
+GEMM_VNNI_TARGET void vnni_kernel_loop(int M,
+                                       int N,
+                                       int K,
+                                       int8_t* A,
+                                       uint8_t* B,
+                                       TYPE_C* C,
+                                       int ldc,
+                                       const float* scale,
+                                       const float* bias,
+                                       int relu_type,
+                                       float relu_alpha) {
+  int k_loop = (K + 3) >> 2;
+  int pack_k = k_loop << 2;
+  int idx_m = 0;
+  const int8_t* a_rows[8];
+  // 8 rows, 16 accumulators
+  for (; idx_m + 7 < M; idx_m += 8) {
+    for (int i = 0; i < 8; i++) {
+      a_rows[i] = A + (i >> 1) * 2 * pack_k + (i & 1) * 4;
+    }
+    const uint8_t* b_ptr = B;
+    for (int idx_n = 0; idx_n < N;) {
+      int tile_n = vnni_tile_n(N - idx_n);
+      vnni_kernel<8>(a_rows,
+                     8,
+                     b_ptr,
+                     tile_n,
+                     k_loop,
+                     C + idx_m * ldc + idx_n,
+                     ldc,
+                     scale + idx_m,
+                     bias + idx_m,
+                     relu_type,
+                     relu_alpha);
+      b_ptr += tile_n * pack_k;
+      idx_n += tile_n;
+    }
+    A += 8 * pack_k;
+  }
+  for (; idx_m + 1 < M; idx_m += 2) {
+    a_rows[0] = A;
+    a_rows[1] = A + 4;
+    const uint8_t* b_ptr = B;
+    for (int idx_n = 0; idx_n < N;) {
+      int tile_n = vnni_tile_n(N - idx_n);
+      vnni_kernel<2>(a_rows,
+                     8,
+                     b_ptr,
+                     tile_n,
+                     k_loop,
+                     C + idx_m * ldc + idx_n,
+                     ldc,
+                     scale + idx_m,
+                     bias + idx_m,
+                     relu_type,
+                     relu_alpha);
+      b_ptr += tile_n * pack_k;
+      idx_n += tile_n;
+    }
+    A += 2 * pack_k;
+  }
+  if (idx_m < M) {
+    a_rows[0] = A;
+    const uint8_t* b_ptr = B;
+    for (int idx_n = 0; idx_n < N;) {
+      int tile_n = vnni_tile_n(N - idx_n);
+      vnni_kernel<1>(a_rows,
+                     4,
+                     b_ptr,
+                     tile_n,
+                     k_loop,
+                     C + idx_m * ldc + idx_n,
+                     ldc,
+                     scale + idx_m,
+                     bias + idx_m,
+                     relu_type,
+                     relu_alpha);
+      b_ptr += tile_n * pack_k;
+      idx_n += tile_n;
+    }
+  }
+}
+
+}  // namespace
+
+void gemm_kernel_loop_int8_vnni(int M,
+                                int N,
+                                int K,
+                                int8_t* A,
+                                uint8_t* B,
+                                int8_t* C,
+                                int ldc,
+                                const float* scale,
+                                const float* bias,
+                                int relu_type,
+                                float relu_alpha) {
+  vnni_kernel_loop<int8_t>(
+      M, N, K, A, B, C, ldc, scale, bias, relu_type, relu_alpha);
+}
+
+void gemm_kernel_loop_int8_vnni(int M,
+                                int N,
+                                int K,
+                                int8_t* A,
+                                uint8_t* B,
+                                float* C,
+                                int ldc,
+                                const float* scale,
+                                const float* bias,
+                                int relu_type,
+                                float relu_alpha) {
+  vnni_kernel_loop<float>(
+      M, N, K, A, B, C, ldc, scale, bias, relu_type, relu_alpha);
+}
+
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
+
+#undef GEMM_VNNI_TARGET
+
+#endif  // __AVX2__
@@ -0,0 +1,135 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/backends/x86/math/layer_norm.h"
+#ifdef __AVX__
+#include <immintrin.h>
+#endif
+#include <stdint.h>
+#include <cmath>
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+
+#ifdef __AVX__
+static inline float reduce_add(__m256 x) {
+  __m128 v =
+      _mm_add_ps(_mm256_castps256_ps128(x), _mm256_extractf128_ps(x, 1));
+  v = _mm_add_ps(v, _mm_movehl_ps(v, v));
+  v = _mm_add_ss(v, _mm_shuffle_ps(v, v, 1));
+  return _mm_cvtss_f32(v);
+}
+#endif
+
+// The row stays in L1 for the usual hidden sizes, so the variance is taken
+// around the mean in a second pass, which is more precise than E(x^2) - E(x)^2.
+void layer_norm(const float* in,
+                const float* residual,
+                const float* scale,
+                const float* bias,
+                float* out,
+                float* mean,
+                float* variance,
+                const float epsilon,
+                const int rows,
+                const int cols) {
+#pragma omp parallel for
+  for (int i = 0; i < rows; ++i) {
+    const float* in_p = in + static_cast<int64_t>(i) * cols;
+    float* out_p = out + static_cast<int64_t>(i) * cols;
+    int j = 0;
+    float sum = 0.f;
+    // x = in + residual
+    if (residual) {
+      const float* r_p = residual + static_cast<int64_t>(i) * cols;
+#ifdef __AVX__
+      __m256 vsum = _mm256_setzero_ps();
+      for (; j + 7 < cols; j += 8) {
+        __m256 x =
+            _mm256_add_ps(_mm256_loadu_ps(in_p + j), _mm256_loadu_ps(r_p + j));
+        _mm256_storeu_ps(out_p + j, x);
+        vsum = _mm256_add_ps(vsum, x);
+      }
+      sum = reduce_add(vsum);
+#endif
+      for (; j < cols; ++j) {
+        out_p[j] = in_p[j] + r_p[j];
+        sum += out_p[j];
+      }
+      in_p = out_p;
+    } else {
+#ifdef __AVX__
+      __m256 vsum = _mm256_setzero_ps();
+      for (; j + 7 < cols; j += 8) {
+        vsum = _mm256_add_ps(vsum, _mm256_loadu_ps(in_p + j));
+      }
+      sum = reduce_add(vsum);
+#endif
+      for (; j < cols; ++j) {
+        sum += in_p[j];
+      }
+    }
+    const float mean_val = sum / cols;
+
+    float square_sum = 0.f;
+    j = 0;
+#ifdef __AVX__
+    const __m256 vmean = _mm256_set1_ps(mean_val);
+    __m256 vsquare = _mm256_setzero_ps();
+    for (; j + 7 < cols; j += 8) {
+      __m256 x = _mm256_sub_ps(_mm256_loadu_ps(in_p + j), vmean);
+      vsquare = _mm256_fmadd_ps(x, x, vsquare);
+    }
+    square_sum = reduce_add(vsquare);
+#endif
+    for (; j < cols; ++j) {
+      float x = in_p[j] - mean_val;
+      square_sum += x * x;
+    }
+    const float var_val = square_sum / cols;
+    mean[i] = mean_val;
+    variance[i] = var_val;
+
+    // out = (x - mean) / sqrt(var + epsilon) * scale + bias
+    const float rstd = 1.f / std::sqrt(var_val + epsilon);
+    j = 0;
+#ifdef __AVX__
+    const __m256 vrstd = _mm256_set1_ps(rstd);
+    for (; j + 7 < cols; j += 8) {
+      __m256 x =
+          _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(in_p + j), vmean), vrstd);
+      if (scale) {
+        x = _mm256_mul_ps(x, _mm256_loadu_ps(scale + j));
+      }
+      if (bias) {
+        x = _mm256_add_ps(x, _mm256_loadu_ps(bias + j));
+      }
+      _mm256_storeu_ps(out_p + j, x);
+    }
+#endif
+    for (; j < cols; ++j) {
+      float x = (in_p[j] - mean_val) * rstd;
+      if (scale) x *= scale[j];
+      if (bias) x += bias[j];
+      out_p[j] = x;
+    }
+  }
+}
+
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,39 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+
+// Normalize each row of in[rows][cols], or of in + residual if the residual
+// isn't null, the sum is stored in out and normalized in place. The scale and
+// bias can be null.
+void layer_norm(const float* in,
+                const float* residual,
+                const float* scale,
+                const float* bias,
+                float* out,
+                float* mean,
+                float* variance,
+                const float epsilon,
+                const int rows,
+                const int cols);
+
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
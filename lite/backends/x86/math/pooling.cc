@@ -15,6 +15,7 @@ limitations under the License. */
 #include "lite/backends/x86/math/pooling.h"
 #include <algorithm>
 #include <vector>
+#include "lite/backends/x86/math/calib.h"
 
 namespace paddle {
 namespace lite {
@@ -285,6 +286,109 @@ template class Pool2dGradFunctor<lite::TargetType::kX86,
                                  lite::x86::math::AvgPoolGrad<double>,
                                  double>;
 
+template <typename OutT>
+void Pool2dInt8(const lite::Tensor* input,
+                const std::vector<int>& ksize,
+                const std::vector<int>& strides,
+                const std::vector<int>& paddings,
+                bool is_max,
+                bool exclusive,
+                bool adaptive,
+                float in_scale,
+                float out_scale,
+                lite::Tensor* output) {
+  const int batch_size = input->dims()[0];
+  const int input_height = input->dims()[2];
+  const int input_width = input->dims()[3];
+  const int output_channels = output->dims()[1];
+  const int output_height = output->dims()[2];
+  const int output_width = output->dims()[3];
+  const int ksize_height = ksize[0];
+  const int ksize_width = ksize[1];
+  const int stride_height = strides[0];
+  const int stride_width = strides[1];
+  const int padding_height = paddings[0];
+  const int padding_width = paddings[2];
+
+  const int input_stride = input_height * input_width;
+  const int output_stride = output_height * output_width;
+
+  const int8_t* input_data = input->template data<int8_t>();
+  OutT* output_data =
+      output->template mutable_data<OutT>(lite::TargetType::kX86);
+
+#pragma omp parallel for
+  for (int nc = 0; nc < batch_size * output_channels; nc++) {
+    const int8_t* in_c = input_data + nc * input_stride;
+    OutT* out_c = output_data + nc * output_stride;
+    for (int ph = 0; ph < output_height; ++ph) {
+      int hstart, hend;
+      if (adaptive) {
+        hstart = AdaptStartIndex(ph, input_height, output_height);
+        hend = AdaptEndIndex(ph, input_height, output_height);
+      } else {
+        hstart = ph * stride_height - padding_height;
+        hend = (std::min)(hstart + ksize_height, input_height);
+        hstart = (std::max)(hstart, 0);
+      }
+      for (int pw = 0; pw < output_width; ++pw) {
+        int wstart, wend;
+        if (adaptive) {
+          wstart = AdaptStartIndex(pw, input_width, output_width);
+          wend = AdaptEndIndex(pw, input_width, output_width);
+        } else {
+          wstart = pw * stride_width - padding_width;
+          wend = (std::min)(wstart + ksize_width, input_width);
+          wstart = (std::max)(wstart, 0);
+        }
+        float value;
+        if (is_max) {
+          int8_t ele = -128;
+          for (int h = hstart; h < hend; ++h) {
+            for (int w = wstart; w < wend; ++w) {
+              ele = (std::max)(ele, in_c[h * input_width + w]);
+            }
+          }
+          value = ele * in_scale;
+        } else {
+          int32_t sum = 0;
+          for (int h = hstart; h < hend; ++h) {
+            for (int w = wstart; w < wend; ++w) {
+              sum += in_c[h * input_width + w];
+            }
+          }
+          int pool_size = (exclusive || adaptive)
+                              ? (hend - hstart) * (wend - wstart)
+                              : ksize_height * ksize_width;
+          value = sum * in_scale / pool_size;
+        }
+        out_c[ph * output_width + pw] = quantize_to<OutT>(value, out_scale);
+      }
+    }
+  }
+}
+
+template void Pool2dInt8<int8_t>(const lite::Tensor* input,
+                                 const std::vector<int>& ksize,
+                                 const std::vector<int>& strides,
+                                 const std::vector<int>& paddings,
+                                 bool is_max,
+                                 bool exclusive,
+                                 bool adaptive,
+                                 float in_scale,
+                                 float out_scale,
+                                 lite::Tensor* output);
+template void Pool2dInt8<float>(const lite::Tensor* input,
+                                const std::vector<int>& ksize,
+                                const std::vector<int>& strides,
+                                const std::vector<int>& paddings,
+                                bool is_max,
+                                bool exclusive,
+                                bool adaptive,
+                                float in_scale,
+                                float out_scale,
+                                lite::Tensor* output);
+
 /*
  * All tensors are in NCDHW format.
  * Ksize, strides, paddings are three elements. These three elements represent
@@ -109,6 +109,23 @@ class Pool2dFunctor {
                   lite::Tensor* output);
 };
 
+/*
+ * Pool2dInt8 pools the int8 input in NCHW format, the max pooling is done on
+ * the int8 values and the average pooling accumulates in int32. The results
+ * are dequantized by in_scale, and quantized by out_scale if OutT is int8_t.
+ */
+template <typename OutT>
+void Pool2dInt8(const lite::Tensor* input,
+                const std::vector<int>& ksize,
+                const std::vector<int>& strides,
+                const std::vector<int>& paddings,
+                bool is_max,
+                bool exclusive,
+                bool adaptive,
+                float in_scale,
+                float out_scale,
+                lite::Tensor* output);
+
 template <lite::TargetType Target, typename PoolProcess, typename T>
 class Pool2dGradFunctor {
  public:
@@ -13,6 +13,13 @@ See the License for the specific language governing permissions and
 limitations under the License. */
 
 #include "lite/backends/x86/math/softmax.h"
+#ifdef __AVX__
+#include <immintrin.h>
+#include "lite/backends/x86/math/avx/avx_mathfuns.h"
+#endif
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include "lite/backends/x86/math/softmax_impl.h"
 
 namespace paddle {
@@ -20,6 +27,113 @@ namespace lite {
 namespace x86 {
 namespace math {
 
+namespace {
+
+#ifdef __AVX__
+inline float reduce_avx(__m256 x, bool is_max) {
+  __m128 v = is_max ? _mm_max_ps(_mm256_castps256_ps128(x),
+                                 _mm256_extractf128_ps(x, 1))
+                    : _mm_add_ps(_mm256_castps256_ps128(x),
+                                 _mm256_extractf128_ps(x, 1));
+  __m128 h = _mm_movehl_ps(v, v);
+  v = is_max ? _mm_max_ps(v, h) : _mm_add_ps(v, h);
+  h = _mm_shuffle_ps(v, v, 1);
+  v = is_max ? _mm_max_ss(v, h) : _mm_add_ss(v, h);
+  return _mm_cvtss_f32(v);
+}
+#endif
+
+inline float max_row(const float* in, int size) {
+  float max_data = in[0];
+  int j = 0;
+#ifdef __AVX__
+  if (size >= 8) {
+    __m256 vmax = _mm256_loadu_ps(in);
+    for (j = 8; j + 7 < size; j += 8) {
+      vmax = _mm256_max_ps(vmax, _mm256_loadu_ps(in + j));
+    }
+    max_data = reduce_avx(vmax, true);
+  }
+#endif
+  for (; j < size; ++j) {
+    max_data = std::max(max_data, in[j]);
+  }
+  return max_data;
+}
+
+// out = exp(in - max_data), returns the sum of out.
+inline float exp_row(const float* in, float* out, int size, float max_data) {
+  float sum_data = 0.f;
+  int j = 0;
+#ifdef __AVX__
+  __m256 vmax = _mm256_set1_ps(max_data);
+  __m256 vsum = _mm256_setzero_ps();
+  for (; j + 7 < size; j += 8) {
+    __m256 vexp = exp256_ps(_mm256_sub_ps(_mm256_loadu_ps(in + j), vmax));
+    _mm256_storeu_ps(out + j, vexp);
+    vsum = _mm256_add_ps(vsum, vexp);
+  }
+  sum_data = reduce_avx(vsum, false);
+#endif
+  for (; j < size; ++j) {
+    out[j] = std::exp(in[j] - max_data);
+    sum_data += out[j];
+  }
+  return sum_data;
+}
+
+inline void scale_row(float* out, int size, float scale) {
+  int j = 0;
+#ifdef __AVX__
+  __m256 vscale = _mm256_set1_ps(scale);
+  for (; j + 7 < size; j += 8) {
+    _mm256_storeu_ps(out + j, _mm256_mul_ps(_mm256_loadu_ps(out + j), vscale));
+  }
+#endif
+  for (; j < size; ++j) {
+    out[j] *= scale;
+  }
+}
+
+}  // namespace
+
+// The exp of each block is taken with the running max and the sum is rescaled
+// when the max grows, the blocks taken with the smaller max are corrected
+// while the row is normalized.
+void softmax_inner1(const float* in, float* out, int outer, int axis) {
+  const int kMaxBlocks = 64;
+  int block_size = (axis + kMaxBlocks - 1) / kMaxBlocks;
+  block_size = std::max(1024, (block_size + 7) / 8 * 8);
+#pragma omp parallel for
+  for (int i = 0; i < outer; ++i) {
+    const float* in_ptr = in + static_cast<int64_t>(i) * axis;
+    float* out_ptr = out + static_cast<int64_t>(i) * axis;
+    float block_max[kMaxBlocks];
+    float max_data = std::numeric_limits<float>::lowest();
+    float sum_data = 0.f;
+    int num_blocks = 0;
+    for (int start = 0; start < axis; start += block_size) {
+      int size = std::min(block_size, axis - start);
+      float cur_max = max_row(in_ptr + start, size);
+      if (cur_max > max_data) {
+        sum_data *= std::exp(max_data - cur_max);
+        max_data = cur_max;
+      }
+      block_max[num_blocks++] = max_data;
+      sum_data += exp_row(in_ptr + start, out_ptr + start, size, max_data);
+    }
+    float sum_inv = 1.f / sum_data;
+    for (int b = 0; b < num_blocks; ++b) {
+      int start = b * block_size;
+      int size = std::min(block_size, axis - start);
+      float scale = block_max[b] == max_data
+                        ? sum_inv
+                        : std::exp(block_max[b] - max_data) * sum_inv;
+      scale_row(out_ptr + start, size, scale);
+    }
+  }
+}
+
 template class SoftmaxFunctor<lite::TargetType::kX86, float, true>;
 // note: these implemetaions have not been called yet
 // template class SoftmaxFunctor<lite::TargetType::kX86, float, false>;
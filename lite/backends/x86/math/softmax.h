@@ -33,6 +33,10 @@ class SoftmaxFunctor {
                   lite::Tensor* Y);
 };
 
+// The softmax of the rows of in[outer][axis], each row is processed in blocks
+// which stay in L1 with the running max, so the input is read only once.
+void softmax_inner1(const float* in, float* out, int outer, int axis);
+
 template <lite::TargetType Target, typename T, typename Enable = void>
 class SoftmaxGradFunctor {
  public:
@@ -145,6 +145,10 @@ class SoftmaxFunctor<Target, float, true, enable_if_CPU<Target>> {
     float* out_data = Y->mutable_data<float>();
     const int kBatchDim = 0;
     const int kClassDim = 1;
+    if (in_dims[kClassDim] == axis_dim) {
+      softmax_inner1(in_data, out_data, in_dims[kBatchDim], axis_dim);
+      return;
+    }
 #ifdef PADDLE_WITH_MKLML
     // 2D data. Batch x C
     auto compute_softmax =
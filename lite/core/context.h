@@ -49,6 +49,7 @@
 #include "lite/core/scope.h"
 #include "lite/core/target_wrapper.h"
 #include "lite/core/tensor.h"
+#include "lite/core/workspace.h"
 #include "lite/utils/all.h"
 #include "lite/utils/env.h"
 #include "lite/utils/macros.h"
@@ -398,15 +399,20 @@ class Context<TargetType::kARM> {
   int llc_size() const { return DeviceInfo::Global().llc_size(); }
   bool has_dot() const { return DeviceInfo::Global().has_dot(); }
   bool has_fp16() const { return DeviceInfo::Global().has_fp16(); }
+  bool has_i8mm() const { return DeviceInfo::Global().has_i8mm(); }
+  bool has_bf16() const { return DeviceInfo::Global().has_bf16(); }
+  bool has_sve() const { return DeviceInfo::Global().has_sve(); }
   bool has_a53_valid() const { return DeviceInfo::Global().set_a53_valid(); }
 
+  // The bottom of the workspace of the predictor, whose size is at least
+  // llc_size() plus the size it's extended by, see WorkSpace::Extend().
   template <typename T>
   T* workspace_data() {
-    return DeviceInfo::Global().workspace_data<T>();
+    return reinterpret_cast<T*>(WorkSpace::Current().Extend(llc_size()));
   }
 
   bool ExtendWorkspace(size_t size) {
-    return DeviceInfo::Global().ExtendWorkspace(size);
+    return WorkSpace::Current().Extend(size + llc_size()) != nullptr;
   }
 
   std::string name() const { return "ARMContext"; }
@@ -48,6 +48,9 @@
 #ifdef LITE_WITH_LINUX
 #include <sys/syscall.h>
 #include <unistd.h>
+#ifdef __aarch64__
+#include <sys/auxv.h>
+#endif
 #endif
 #ifdef LITE_WITH_ANDROID
 #include <sys/system_properties.h>
@@ -85,7 +88,6 @@ LITE_THREAD_LOCAL lite_api::PowerMode DeviceInfo::mode_;
 LITE_THREAD_LOCAL ARMArch DeviceInfo::arch_;
 LITE_THREAD_LOCAL int DeviceInfo::mem_size_;
 LITE_THREAD_LOCAL std::vector<int> DeviceInfo::active_ids_;
-LITE_THREAD_LOCAL TensorLite DeviceInfo::workspace_;
 LITE_THREAD_LOCAL int64_t DeviceInfo::count_ = 0;
 
 #ifdef TARGET_IOS
@@ -203,9 +205,20 @@ void get_cpu_arch(std::vector<ARMArch>* archs, const int cpu_num) {
         case 0xd0d:
           arch_type = kA77;
           break;
+        case 0xd0c:
+          // Neoverse N1
+          arch_type = kA76;
+          break;
         case 0xd40:
           arch_type = kA76;
           break;
+        case 0xd41:
+          arch_type = kA78;
+          break;
+        case 0xd49:
+          // Neoverse N2
+          arch_type = kA78;
+          break;
         case 0x804:
           // 855
           arch_type = kA76;
@@ -914,6 +927,36 @@ void DeviceInfo::SetCPUInfoByProb() {
 #endif  // LITE_WITH_LINUX
 }
 
+void DeviceInfo::SetFeatureInfoByHwcap() {
+#if defined(LITE_WITH_LINUX) && defined(__aarch64__)
+// The aarch64 hwcaps of the linux kernel, see
+// arch/arm64/include/uapi/asm/hwcap.h
+#ifndef AT_HWCAP2
+#define AT_HWCAP2 26
+#endif
+  const uint64_t kHwcapAsimdHp = 1ULL << 10;
+  const uint64_t kHwcapAsimdDp = 1ULL << 20;
+  const uint64_t kHwcapSve = 1ULL << 22;
+  const uint64_t kHwcap2Sve2 = 1ULL << 1;
+  const uint64_t kHwcap2I8mm = 1ULL << 13;
+  const uint64_t kHwcap2Bf16 = 1ULL << 14;
+  uint64_t hwcap = getauxval(AT_HWCAP);
+  uint64_t hwcap2 = getauxval(AT_HWCAP2);
+  // The server cpus, such as Neoverse and Ampere, are not in the cpu name
+  // list, the dot and fp16 features are only enabled here.
+  if (hwcap & kHwcapAsimdDp) {
+    SetDotInfo(1, 1);
+  }
+  if (hwcap & kHwcapAsimdHp) {
+    SetFP16Info(1, 1);
+  }
+  sve_ = (hwcap & kHwcapSve) != 0;
+  sve2_ = (hwcap2 & kHwcap2Sve2) != 0;
+  i8mm_ = (hwcap2 & kHwcap2I8mm) != 0;
+  bf16_ = (hwcap2 & kHwcap2Bf16) != 0;
+#endif
+}
+
 void DeviceInfo::RequestPowerFullMode(int thread_num) {
   int big_core_size = big_core_ids_.size();
   int little_core_size = little_core_ids_.size();
@@ -1090,6 +1133,7 @@ int DeviceInfo::Setup() {
   if (!SetCPUInfoByName()) {
     SetCPUInfoByProb();
   }
+  SetFeatureInfoByHwcap();
 #else
 #ifdef TARGET_IOS
   dev_name_ = "Apple";
@@ -1137,6 +1181,8 @@ int DeviceInfo::Setup() {
     LOG(INFO) << L3_cache_[i] / 1024 << " KB";
   }
   LOG(INFO) << "Total memory: " << mem_size_ << "KB";
+  LOG(INFO) << "ARM features, sve: " << sve_ << ", sve2: " << sve2_
+            << ", i8mm: " << i8mm_ << ", bf16: " << bf16_;
   // set default run mode
   SetRunMode(lite_api::PowerMode::LITE_POWER_NO_BIND,
              1);  // use single thread by default
@@ -1200,9 +1246,6 @@ void DeviceInfo::SetRunMode(lite_api::PowerMode mode, int thread_num) {
   omp_set_num_threads(active_ids_.size());
 #endif
 #endif  // LITE_WITH_LINUX
-  //! alloc memory for sgemm in this context
-  workspace_.Resize({llc_size()});
-  workspace_.mutable_data<int8_t>();
   arch_ = archs_[active_ids_[0]];
 }
 
@@ -1210,14 +1253,6 @@ void DeviceInfo::SetCache(int l1size, int l2size, int l3size) {
   SetCacheInfo(0, 1, l1size);
   SetCacheInfo(1, 1, l2size);
   SetCacheInfo(2, 1, l3size);
-  workspace_.Resize({llc_size()});
-  workspace_.mutable_data<int8_t>();
-}
-
-bool DeviceInfo::ExtendWorkspace(size_t size) {
-  workspace_.Resize(
-      {static_cast<int64_t>(size + static_cast<size_t>(llc_size()))});
-  return workspace_.mutable_data<int8_t>() != nullptr;
 }
 
 #endif  // LITE_WITH_ARM
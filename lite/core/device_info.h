@@ -77,21 +77,16 @@ class DeviceInfo {
   int l2_cache_size() const { return L2_cache_[active_ids_[0]]; }
   int l3_cache_size() const { return L3_cache_[active_ids_[0]]; }
 
-  // Methods for allocating L3Cache on Arm platform
+  // The size of the L3Cache used by the arm kernels, which is reserved by the
+  // workspace of the predictor, see ARMContext::workspace_data().
   // Enum class L3CacheSetMethod is declared in `lite/api/paddle_api.h`
   void SetArmL3CacheSize(
       L3CacheSetMethod method = L3CacheSetMethod::kDeviceL3Cache,
       int absolute_val = -1) {
     l3_cache_method_ = method;
     absolute_l3cache_size_ = absolute_val;
-    // Realloc memory for sgemm in this context.
-    workspace_.clear();
-    workspace_.Resize({llc_size()});
-    workspace_.mutable_data<int8_t>();
   }
 
-  void ClearArmL3Cache() { workspace_.clear(); }
-
   int llc_size() const {
     auto size = absolute_l3cache_size_;
     switch (l3_cache_method_) {
@@ -122,12 +117,18 @@ class DeviceInfo {
 #endif
   }
   bool has_fp16() const { return fp16_[active_ids_[0]]; }
-
-  template <typename T>
-  T* workspace_data() {
-    return reinterpret_cast<T*>(workspace_.mutable_data<int8_t>());
+  // The armv8.6 int8 matrix multiplication(smmla), which is used by the int8
+  // gemm only if the sdot kernels are enabled too.
+  inline bool has_i8mm() const {
+#ifdef WITH_ARM_I8MM
+    return i8mm_;
+#else
+    return false;
+#endif
   }
-  bool ExtendWorkspace(size_t size);
+  bool has_bf16() const { return bf16_; }
+  bool has_sve() const { return sve_; }
+  bool has_sve2() const { return sve2_; }
 
  private:
   int core_num_;
@@ -146,6 +147,11 @@ class DeviceInfo {
   std::vector<bool> fp32_;
   std::vector<bool> fp16_;
   std::vector<bool> dot_;
+  // The features reported by the kernel hwcaps are common to all of the cores.
+  bool i8mm_{false};
+  bool bf16_{false};
+  bool sve_{false};
+  bool sve2_{false};
   bool has_a53_valid_;
 
   // LITE_POWER_HIGH stands for using big cores,
@@ -155,7 +161,6 @@ class DeviceInfo {
   static LITE_THREAD_LOCAL ARMArch arch_;
   static LITE_THREAD_LOCAL int mem_size_;
   static LITE_THREAD_LOCAL std::vector<int> active_ids_;
-  static LITE_THREAD_LOCAL TensorLite workspace_;
   static LITE_THREAD_LOCAL int64_t count_;
 
   void SetDotInfo(int argc, ...);
@@ -165,6 +170,7 @@ class DeviceInfo {
   void SetArchInfo(int argc, ...);
   bool SetCPUInfoByName();
   void SetCPUInfoByProb();
+  void SetFeatureInfoByHwcap();
   void RequestPowerFullMode(int thread_num);
   void RequestPowerHighMode(int thread_num);
   void RequestPowerLowMode(int thread_num);
@@ -172,7 +178,8 @@ class DeviceInfo {
   void RequestPowerRandHighMode(int shift_num, int thread_num);
   void RequestPowerRandLowMode(int shift_num, int thread_num);
 
-  // Methods for allocating L3Cache on Arm platform
+  // The size of the L3Cache used by the arm kernels, which is reserved by the
+  // workspace of the predictor, see ARMContext::workspace_data().
   // Enum class L3CacheSetMethod is declared in `lite/api/paddle_api.h`
   L3CacheSetMethod l3_cache_method_{L3CacheSetMethod::kDeviceL3Cache};
   int absolute_l3cache_size_{-1};
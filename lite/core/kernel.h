@@ -81,31 +81,25 @@ class KernelBase {
   }
 #endif
 
-  void Launch() {
-    /// First run, init kernel, do weights transform once
+  /// Init kernel, do weights transform once. It's called at the first run,
+  /// or ahead of it by RuntimeProgram::Prepare.
+  void PrepareOnce() {
     if (is_first_epoch_) {
       PrepareForRun();
       is_first_epoch_ = false;
     }
+  }
+
+  void Launch() {
+    /// First run, init kernel, do weights transform once
+    PrepareOnce();
     /// re-init the kernel if needed (input shape should be checked in conv
     /// kernel)
     ReInitWhenNeeded();
 
-    // Reset the workspace to make every kernel in the same thread to share the
-    // temporary memory.
-    WorkSpace::Global_Host().AllocReset();
-#if defined(LITE_WITH_X86)
-    WorkSpace::Global_X86().AllocReset();
-#endif
-#if defined(LITE_WITH_CUDA)
-    WorkSpace::Global_CUDA().AllocReset();
-#endif
-#if defined(LITE_WITH_METAL)
-    WorkSpace::Global_METAL().AllocReset();
-#endif
-#if defined(LITE_WITH_MLU)
-    WorkSpace::Global_MLU().AllocReset();
-#endif
+    // Reset the workspace to make every kernel in the same predictor to share
+    // the temporary memory.
+    WorkSpace::Current().AllocReset();
 
 #ifdef LITE_WITH_PROFILE
     if (!is_kernel_test_) {
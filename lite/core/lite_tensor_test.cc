@@ -14,6 +14,8 @@
 
 #include <gtest/gtest.h>
 #include <cstring>
+#include <vector>
+#include "lite/backends/host/math/concat.h"
 #include "lite/core/tensor.h"
 
 namespace paddle {
@@ -58,5 +60,125 @@ TEST(tensor, shared_memory) {
 #endif
 }
 
+TEST(tensor, view) {
+  TensorLite tensor;
+  tensor.Resize({4, 3});
+  float* data = tensor.mutable_data<float>();
+  for (int i = 0; i < 12; i++) {
+    data[i] = static_cast<float>(i);
+  }
+
+  // rows 1-2
+  TensorLite view;
+  view.ShareDataWith(tensor, 3 * sizeof(float), DDim({2, 3}));
+  EXPECT_TRUE(view.SharesBufferWith(tensor));
+  EXPECT_EQ(view.memory_size(), 6 * sizeof(float));
+  EXPECT_EQ(view.data<float>(), data + 3);
+  // row 2 of the view of rows 1-2
+  TensorLite sub_view;
+  sub_view.ShareDataWith(view, 3 * sizeof(float), DDim({3}));
+  EXPECT_EQ(sub_view.data<float>()[0], 6.f);
+
+  TensorLite copy;
+  copy.CopyDataFrom(view);
+  EXPECT_FALSE(copy.SharesBufferWith(tensor));
+  EXPECT_EQ(std::memcmp(copy.data<float>(), data + 3, 6 * sizeof(float)), 0);
+
+  // The view can be moved with its own dims.
+  view.ShareDataWith(tensor, 6 * sizeof(float), view.dims());
+  EXPECT_EQ(view.dims(), DDim({2, 3}));
+  EXPECT_EQ(view.data<float>(), data + 6);
+
+  view.DetachBuffer();
+  EXPECT_FALSE(view.SharesBufferWith(tensor));
+  view.mutable_data<float>()[0] = -1.f;
+  EXPECT_EQ(data[3], 3.f);
+
+  // A view is written in place, but gets its own buffer when it grows.
+  TensorLite row;
+  row.ShareDataWith(tensor, 6 * sizeof(float), DDim({3}));
+  EXPECT_TRUE(row.is_view());
+  EXPECT_EQ(row.mutable_data<float>(), data + 6);
+  row.Resize({4});
+  row.mutable_data<float>()[0] = -1.f;
+  EXPECT_FALSE(row.SharesBufferWith(tensor));
+  EXPECT_EQ(data[6], 6.f);
+}
+
+TEST(tensor, copy_into_shared_buffer) {
+  TensorLite x;
+  x.Resize({2, 3});
+  auto* x_data = x.mutable_data<float>();
+  for (int i = 0; i < 6; i++) {
+    x_data[i] = static_cast<float>(i);
+  }
+  // The alias of a reshape shares the whole buffer at offset 0.
+  TensorLite alias;
+  alias.ShareDataWith(x);
+  alias.Resize({6});
+  EXPECT_TRUE(alias.is_shared());
+  TensorLite y;
+  y.Resize({6});
+  auto* y_data = y.mutable_data<float>();
+  for (int i = 0; i < 6; i++) {
+    y_data[i] = -1.f;
+  }
+  alias.CopyDataFrom(y);
+  EXPECT_FALSE(alias.SharesBufferWith(x));
+  EXPECT_EQ(alias.data<float>()[0], -1.f);
+  for (int i = 0; i < 6; i++) {
+    EXPECT_EQ(x.data<float>()[i], static_cast<float>(i));
+  }
+}
+
+void FillRows(TensorLite* tensor, int64_t rows, float first) {
+  tensor->Resize({rows, 2});
+  auto* data = tensor->mutable_data<float>();
+  for (int64_t i = 0; i < tensor->numel(); i++) {
+    data[i] = first + i;
+  }
+}
+
+// The inputs of the concat are the views of their pieces of the output, which
+// move when the sizes of the inputs before them change.
+TEST(tensor, concat_views) {
+  TensorLite a, b, out;
+  std::vector<TensorLite*> inputs{&a, &b};
+  auto check = [&](int64_t a_rows, int64_t b_rows) {
+    out.Resize({a_rows + b_rows, 2});
+    ASSERT_TRUE(host::math::concat_views<float>(inputs, 0, true, &out));
+    auto* data = out.data<float>();
+    for (int64_t i = 0; i < a_rows * 2; i++) {
+      EXPECT_EQ(data[i], i);
+    }
+    for (int64_t i = 0; i < b_rows * 2; i++) {
+      EXPECT_EQ(data[a_rows * 2 + i], 100 + i);
+    }
+    EXPECT_TRUE(a.is_view());
+    EXPECT_EQ(a.data<float>(), data);
+    EXPECT_TRUE(b.is_view());
+    EXPECT_EQ(b.data<float>(), data + a_rows * 2);
+  };
+  FillRows(&a, 2, 0);
+  FillRows(&b, 2, 100);
+  check(2, 2);
+  // The producers write into the views, which aren't copied.
+  auto* data = out.data<float>();
+  FillRows(&a, 2, 0);
+  FillRows(&b, 2, 100);
+  check(2, 2);
+  EXPECT_EQ(out.data<float>(), data);
+  // The grown a gets its own buffer, its piece covers the old piece of b.
+  FillRows(&a, 3, 0);
+  FillRows(&b, 1, 100);
+  check(3, 1);
+  // The piece of b moves before the old piece of it.
+  FillRows(&a, 1, 0);
+  FillRows(&b, 3, 100);
+  check(1, 3);
+  // The output isn't a view of the inputs if the dims before axis aren't 1.
+  EXPECT_FALSE(host::math::concat_views<float>(inputs, 1, true, &out));
+}
+
 }  // namespace lite
 }  // namespace paddle
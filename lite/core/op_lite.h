@@ -75,6 +75,9 @@ class OpLite : public Registry {
                << op_type_;
     return false;
   }
+  // Whether the output shapes only depend on the shapes and lods of the
+  // inputs, it's used to skip InferShape while the input shapes are unchanged.
+  bool IsShapeStatic() const { return InferShapeWithCache(); }
   // Run this operator.
   virtual bool Run();
   // Indicate whether the Op runs only once or not
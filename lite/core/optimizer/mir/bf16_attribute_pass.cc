@@ -0,0 +1,57 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/optimizer/mir/bf16_attribute_pass.h"
+#include <memory>
+#include <string>
+#include "lite/api/paddle_place.h"
+#include "lite/core/optimizer/mir/pass_registry.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+void BF16AttributePass::Apply(const std::unique_ptr<SSAGraph>& graph) {
+  for (auto* node : graph->StmtTopologicalOrder()) {
+    if (!node->IsStmt()) continue;
+    auto& inst = node->AsStmt();
+    if (inst.picked_kernel().precision() != PRECISION(kBF16)) continue;
+    OpInfo* op_info = inst.mutable_op_info();
+    auto* scope = inst.op()->scope();
+    for (auto* in_node : node->inlinks) {
+      CHECK(in_node->IsArg()) << "The input node should be variable.";
+      if (!in_node->arg()->is_weight) continue;
+      const std::string& weight_name = in_node->arg()->name;
+      std::string arg_name;
+      CHECK(op_info->GetInputArgname(weight_name, &arg_name));
+      const Type* decl_type = inst.picked_kernel().GetInputDeclType(arg_name);
+      if (decl_type->precision() != PRECISION(kBF16)) continue;
+      Tensor* weight = scope->FindVar(weight_name)->GetMutable<Tensor>();
+      CHECK(weight) << "Can not find the weight in scope.";
+      if (weight->precision() != PrecisionType::kFloat) {
+        LOG(INFO) << "The dtype of weight is not fp32, "
+                  << "so skip converting the weight of " << weight_name;
+        continue;
+      }
+      op_info->SetAttr<std::string>(weight_name + "_bf16", "bf16");
+    }
+  }
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_MIR_PASS(bf16_attribute_pass, paddle::lite::mir::BF16AttributePass)
+    .BindTargets({TARGET(kARM), TARGET(kX86)});
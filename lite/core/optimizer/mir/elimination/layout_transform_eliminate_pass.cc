@@ -0,0 +1,163 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/optimizer/mir/elimination/layout_transform_eliminate_pass.h"
+
+#include <map>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "lite/core/optimizer/mir/pass_registry.h"
+#include "lite/core/optimizer/mir/pattern_matcher.h"
+#include "lite/core/optimizer/mir/type_precision_cast_pass.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+namespace {
+
+bool IsLayoutTransform(const Node* node) {
+  if (!node->IsStmt()) return false;
+  auto op_type = node->stmt()->op_type();
+  return op_type == "layout" || op_type == "layout_once";
+}
+
+bool IsSameType(const Type* a, const Type* b) {
+  return a && b && a->target() == b->target() &&
+         a->precision() == b->precision() && a->layout() == b->layout();
+}
+
+// The var names used in the sub-blocks can't be renamed, and the var which
+// has no consumer may be an output of the block.
+bool IsRenamable(const Node* var_node) {
+  if (var_node->outlinks.empty()) return false;
+  for (auto* consumer : var_node->outlinks) {
+    auto op_type = consumer->stmt()->op_type();
+    if (op_type == "while" || op_type == "conditional_block" ||
+        op_type == "subgraph") {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+void LayoutTransformEliminatePass::Apply(
+    const std::unique_ptr<SSAGraph>& graph) {
+  int num_transforms = 0;
+  for (auto* node : graph->StmtTopologicalOrder()) {
+    if (IsLayoutTransform(node)) num_transforms++;
+  }
+  if (num_transforms == 0) return;
+  int num_removed = EliminateRoundTrips(graph.get());
+  num_removed += MergeDuplicates(graph.get());
+  VLOG(3) << "layout transforms: " << num_transforms << ", removed "
+          << num_removed << ", remaining " << num_transforms - num_removed;
+}
+
+int LayoutTransformEliminatePass::EliminateRoundTrips(SSAGraph* graph) {
+  int num_removed = 0;
+  std::set<const Node*> nodes_to_remove;
+  for (auto* first : graph->StmtTopologicalOrder()) {
+    if (!IsLayoutTransform(first) || nodes_to_remove.count(first)) continue;
+    if (first->inlinks.size() != 1 || first->outlinks.size() != 1) continue;
+    auto* src = first->inlinks.front();
+    auto* mid = first->outlinks.front();
+    // Only the round trip transforms are removable, the intermediate tensor
+    // must not be used by any other ops.
+    if (mid->outlinks.size() != 1) continue;
+    auto* second = mid->outlinks.front();
+    if (!IsLayoutTransform(second) || second->outlinks.size() != 1) continue;
+    auto* dst = second->outlinks.front();
+    if (!IsSameType(src->AsArg().type, dst->AsArg().type) ||
+        !IsRenamable(dst)) {
+      continue;
+    }
+    VLOG(3) << "remove round trip layout transforms " << src->AsArg().name
+            << " -> " << mid->AsArg().name << " -> " << dst->AsArg().name;
+    RedirectConsumers(graph, dst, src);
+    nodes_to_remove.insert(first);
+    nodes_to_remove.insert(mid);
+    nodes_to_remove.insert(second);
+    nodes_to_remove.insert(dst);
+    num_removed += 2;
+  }
+  GraphSafeRemoveNodes(graph, nodes_to_remove);
+  return num_removed;
+}
+
+int LayoutTransformEliminatePass::MergeDuplicates(SSAGraph* graph) {
+  int num_removed = 0;
+  std::set<const Node*> nodes_to_remove;
+  // The first transform of each input tensor and output type.
+  std::map<std::pair<const Node*, const Type*>, Node*> kept_outputs;
+  for (auto* node : graph->StmtTopologicalOrder()) {
+    if (!IsLayoutTransform(node)) continue;
+    if (node->inlinks.size() != 1 || node->outlinks.size() != 1) continue;
+    auto* src = node->inlinks.front();
+    auto* dst = node->outlinks.front();
+    auto key = std::make_pair(static_cast<const Node*>(src), dst->AsArg().type);
+    auto it = kept_outputs.find(key);
+    if (it == kept_outputs.end()) {
+      kept_outputs.emplace(key, dst);
+      continue;
+    }
+    if (!IsRenamable(dst)) continue;
+    VLOG(3) << "merge layout transform " << src->AsArg().name << " -> "
+            << dst->AsArg().name << " into " << it->second->AsArg().name;
+    RedirectConsumers(graph, dst, it->second);
+    nodes_to_remove.insert(node);
+    nodes_to_remove.insert(dst);
+    num_removed++;
+  }
+  GraphSafeRemoveNodes(graph, nodes_to_remove);
+  return num_removed;
+}
+
+void LayoutTransformEliminatePass::RedirectConsumers(SSAGraph* graph,
+                                                     Node* from,
+                                                     Node* to) {
+  auto consumers = from->outlinks;
+  for (auto* consumer : consumers) {
+    auto& stmt = consumer->AsStmt();
+    UpdateInputs(stmt.op().get(), from->AsArg().name, to->AsArg().name);
+    // ResetOp() will nullify the old op_info, so pass a copy of it, and keep
+    // the picked kernel.
+    auto original_selected_kernel = std::move(stmt.kernels().front());
+    auto update_op_info = *stmt.op_info();
+    stmt.ResetOp(update_op_info, graph->valid_places());
+    stmt.kernels().clear();
+    stmt.kernels().emplace_back(std::move(original_selected_kernel));
+    for (auto& kernel : stmt.kernels()) {
+      stmt.op()->AttachKernel(kernel.get());
+    }
+    RemoveDirectedLink(from, consumer);
+    DirectedLink(to, consumer);
+  }
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_MIR_PASS(layout_transform_eliminate_pass,
+                  paddle::lite::mir::LayoutTransformEliminatePass)
+    .BindTargets({TARGET(kAny)})
+    .ExcludeTargets({TARGET(kMLU)})
+    .ExcludeTargets({TARGET(kMetal)})
+    .BindKernel("layout_once")
+    .BindKernel("layout");
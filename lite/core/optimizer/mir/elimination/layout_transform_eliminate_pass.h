@@ -0,0 +1,48 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include "lite/core/optimizer/mir/pass.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+/*
+ * mir::LayoutTransformEliminatePass plans the layout transforms of the whole
+ * graph after type_layout_cast_pass, it
+ * - removes the round-trip transforms such as layout(NCHW->NHWC) followed by
+ *   layout(NHWC->NCHW), the consumers read the original tensor directly;
+ * - merges the transforms which convert the same tensor to the same type, so
+ *   that each tensor is converted at most once for each layout.
+ * The number of the removed layout transforms is reported for each graph.
+ */
+class LayoutTransformEliminatePass : public mir::StmtPass {
+ public:
+  void Apply(const std::unique_ptr<SSAGraph>& graph) override;
+
+ private:
+  // Return the number of the removed transforms.
+  int EliminateRoundTrips(SSAGraph* graph);
+  int MergeDuplicates(SSAGraph* graph);
+  // Let all the consumers of `from` read `to` instead.
+  void RedirectConsumers(SSAGraph* graph, Node* from, Node* to);
+};
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
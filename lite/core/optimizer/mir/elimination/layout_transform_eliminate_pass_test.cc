@@ -0,0 +1,113 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/optimizer/mir/elimination/layout_transform_eliminate_pass.h"
+#include <gtest/gtest.h>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include "lite/api/paddle_use_kernels.h"
+#include "lite/api/paddle_use_ops.h"
+#include "lite/api/paddle_use_passes.h"
+#include "lite/core/optimizer/mir/pass_manager.h"
+#include "lite/core/optimizer/mir/pass_test_helper.h"
+#include "lite/core/optimizer/mir/ssa_graph.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+void AddLayout(TestProgramBuilder* builder,
+               const std::string& x,
+               const std::string& out) {
+  builder->AddOp("layout", {{"Input", {x}}}, {{"Out", {out}}});
+}
+
+// The input names of the ops, by the names of their outputs.
+std::map<std::string, std::string> GetOpInputs(SSAGraph* graph) {
+  std::map<std::string, std::string> inputs;
+  for (auto* node : graph->StmtTopologicalOrder()) {
+    if (node->inlinks.empty() || node->outlinks.empty()) continue;
+    inputs[node->outlinks.front()->AsArg().name] =
+        node->inlinks.front()->AsArg().name;
+  }
+  return inputs;
+}
+
+// The NCHW tensor x is transformed to NHWC and back twice, the first round
+// trip is removed, and the second one is kept as its NHWC tensor is read by
+// another op too.
+TEST(layout_transform_eliminate_pass, round_trips) {
+  TestProgramBuilder builder;
+  builder.AddInput("x");
+  AddLayout(&builder, "x", "nhwc_a");
+  AddLayout(&builder, "nhwc_a", "nchw_a");
+  builder.AddOp("relu", {{"X", {"nchw_a"}}}, {{"Out", {"out_a"}}});
+  AddLayout(&builder, "x", "nhwc_b");
+  AddLayout(&builder, "nhwc_b", "nchw_b");
+  builder.AddOp("relu", {{"X", {"nchw_b"}}}, {{"Out", {"out_b"}}});
+  builder.AddOp("sigmoid", {{"X", {"nhwc_b"}}}, {{"Out", {"out_c"}}});
+  builder.AddOutput("out_a");
+  builder.AddOutput("out_b");
+  builder.AddOutput("out_c");
+
+  auto places = GetTestPlaces();
+  auto program_desc =
+      std::make_shared<cpp::ProgramDesc>(builder.program_desc());
+  auto scope = std::make_shared<Scope>();
+  Program program(program_desc, scope, places);
+  std::unique_ptr<SSAGraph> graph(new SSAGraph);
+  graph->Build(program, places);
+  auto* nchw = LiteType::GetTensorTy(
+      TARGET(kARM), PRECISION(kFloat), DATALAYOUT(kNCHW));
+  auto* nhwc = LiteType::GetTensorTy(
+      TARGET(kARM), PRECISION(kFloat), DATALAYOUT(kNHWC));
+  for (auto& node : graph->mutable_nodes()) {
+    if (!node.IsArg()) continue;
+    auto& name = node.AsArg().name;
+    node.AsArg().type = name.find("nhwc") == 0 ? nhwc : nchw;
+  }
+
+  auto* pass = PassManager::Global().LookUp<LayoutTransformEliminatePass>(
+      "layout_transform_eliminate_pass");
+  ASSERT_TRUE(pass != nullptr);
+  pass->Apply(graph);
+
+  int num_layouts = 0;
+  for (auto* node : graph->StmtTopologicalOrder()) {
+    if (node->AsStmt().op_type() == "layout") num_layouts++;
+  }
+  EXPECT_EQ(num_layouts, 2);
+  auto inputs = GetOpInputs(graph.get());
+  EXPECT_EQ(inputs.count("nhwc_a"), 0u);
+  EXPECT_EQ(inputs.count("nchw_a"), 0u);
+  EXPECT_EQ(inputs["out_a"], "x");
+  EXPECT_EQ(inputs["nhwc_b"], "x");
+  EXPECT_EQ(inputs["nchw_b"], "nhwc_b");
+  EXPECT_EQ(inputs["out_b"], "nchw_b");
+  EXPECT_EQ(inputs["out_c"], "nhwc_b");
+  // The consumer of the removed round trip reads x in its op desc too.
+  for (auto* node : graph->StmtTopologicalOrder()) {
+    auto* op_info = node->AsStmt().op_info();
+    if (op_info->Type() == "relu" &&
+        op_info->Output("Out").front() == "out_a") {
+      EXPECT_EQ(op_info->Input("X").front(), "x");
+    }
+  }
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
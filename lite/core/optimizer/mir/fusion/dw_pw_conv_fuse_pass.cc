@@ -0,0 +1,48 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/optimizer/mir/fusion/dw_pw_conv_fuse_pass.h"
+#include <memory>
+#include <vector>
+#include "lite/core/optimizer/mir/fusion/dw_pw_conv_fuser.h"
+#include "lite/core/optimizer/mir/pass_registry.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+void DwPwConvFusePass::Apply(const std::unique_ptr<SSAGraph>& graph) {
+  // fusion_dw_pw_conv2d is only implemented on arm fp32/fp16/int8.
+  for (auto& place : graph->valid_places()) {
+    if (place.target != TARGET(kARM) && place.target != TARGET(kHost)) {
+      VLOG(5) << "place.target: " << static_cast<int>(place.target);
+      return;
+    }
+  }
+  for (auto dw_has_bias : {true, false}) {
+    for (auto pw_has_bias : {true, false}) {
+      fusion::DwPwConvFuser fuser(dw_has_bias, pw_has_bias);
+      fuser(graph.get());
+    }
+  }
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_MIR_PASS(lite_dw_pw_conv_fuse_pass,
+                  paddle::lite::mir::DwPwConvFusePass)
+    .BindTargets({TARGET(kARM)})
+    .BindKernel("fusion_dw_pw_conv2d");
@@ -0,0 +1,249 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/optimizer/mir/fusion/dw_pw_conv_fuse_pass.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+#include "lite/api/paddle_use_kernels.h"
+#include "lite/api/paddle_use_ops.h"
+#include "lite/api/paddle_use_passes.h"
+#include "lite/core/device_info.h"
+#include "lite/core/optimizer/mir/pass_test_helper.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+struct DwPwConvCase {
+  int ksize;
+  int stride;
+  std::vector<int> paddings;
+  bool dw_bias;
+  bool pw_bias;
+  std::string dw_act;
+  std::string pw_act;
+};
+
+void SetConvAct(cpp::OpDesc* conv, const std::string& act_type) {
+  conv->SetAttr<bool>("with_act", !act_type.empty());
+  if (act_type.empty()) return;
+  conv->SetAttr<std::string>("act_type", act_type);
+  if (act_type == "relu6") {
+    conv->SetAttr<float>("fuse_brelu_threshold", 6.f);
+  } else if (act_type == "leaky_relu") {
+    conv->SetAttr<float>("leaky_relu_alpha", 0.1f);
+  } else if (act_type == "hard_swish") {
+    conv->SetAttr<float>("hard_swish_threshold", 6.f);
+    conv->SetAttr<float>("hard_swish_scale", 6.f);
+    conv->SetAttr<float>("hard_swish_offset", 3.f);
+  }
+}
+
+cpp::OpDesc* AddConv(TestProgramBuilder* builder,
+                     const std::string& type,
+                     const std::string& input,
+                     const std::string& prefix,
+                     const std::vector<int64_t>& filter_shape,
+                     bool with_bias,
+                     int groups) {
+  builder->AddWeight(prefix + "_w", filter_shape);
+  std::map<std::string, std::vector<std::string>> inputs{
+      {"Input", {input}}, {"Filter", {prefix + "_w"}}};
+  if (with_bias) {
+    builder->AddWeight(prefix + "_b", {filter_shape[0]});
+    inputs["Bias"] = {prefix + "_b"};
+  }
+  auto* conv = builder->AddOp(type, inputs, {{"Output", {prefix + "_out"}}});
+  conv->SetAttr<std::vector<int>>("strides", {1, 1});
+  conv->SetAttr<std::vector<int>>("paddings", {0, 0});
+  conv->SetAttr<std::vector<int>>("dilations", {1, 1});
+  conv->SetAttr<int>("groups", groups);
+  return conv;
+}
+
+// The scales of the int8 input and depthwise output, the int8 weights are
+// quantized from [-1, 1].
+const float kInputScale = 2.f / 127;
+const float kDwOutScale = 6.f / 127;
+
+void QuantizeConv(TestProgramBuilder* builder,
+                  cpp::OpDesc* conv,
+                  const std::string& prefix,
+                  float input_scale) {
+  auto* weight = builder->scope()->FindMutableTensor(prefix + "_w");
+  std::vector<float> values(weight->data<float>(),
+                            weight->data<float>() + weight->numel());
+  auto* data = weight->mutable_data<int8_t>();
+  for (size_t i = 0; i < values.size(); i++) {
+    data[i] = static_cast<int8_t>(std::round(values[i] * 127));
+  }
+  conv->SetAttr<bool>("enable_int8", true);
+  conv->SetAttr<int>("bit_length", 8);
+  conv->SetAttr<std::vector<float>>("Input0_scale", {input_scale});
+  conv->SetAttr<std::vector<float>>(
+      "Filter0_scale", std::vector<float>(weight->dims()[0], 1.f / 127));
+}
+
+// The output may be fp16 as the fetch op takes any precision.
+float OutputValue(const Tensor* out, int64_t i) {
+#ifdef ENABLE_ARM_FP16
+  if (out->precision() == PRECISION(kFP16)) {
+    return static_cast<float>(out->data<__fp16>()[i]);
+  }
+#endif
+  return out->data<float>()[i];
+}
+
+// The op types without the calib ops casting the input and output.
+std::vector<std::string> GetConvTypes(const Predictor& predictor) {
+  auto types = GetOpTypes(predictor);
+  types.erase(std::remove(types.begin(), types.end(), "calib"), types.end());
+  return types;
+}
+
+// Runs the fused convs on the places and the unfused depthwise and pointwise
+// convs on the reference places with the same input, whose output rows are
+// split into several tiles by the small L2. The convs are quantized to int8
+// if int8 is set.
+void CheckDwPwConv(const DwPwConvCase& c,
+                   const std::vector<int64_t>& input_shape,
+                   int out_channels,
+                   const std::vector<Place>& places = GetTestPlaces(),
+                   const std::vector<Place>& ref_places = GetTestPlaces(),
+                   float abs_error = 1e-3f,
+                   bool int8 = false) {
+  const int64_t chin = input_shape[1];
+  TestProgramBuilder builder;
+  builder.AddInput("x");
+  auto* dw = AddConv(&builder,
+                     "depthwise_conv2d",
+                     "x",
+                     "dw",
+                     {chin, 1, c.ksize, c.ksize},
+                     c.dw_bias,
+                     chin);
+  dw->SetAttr<std::vector<int>>("strides", {c.stride, c.stride});
+  dw->SetAttr<std::vector<int>>("paddings", c.paddings);
+  SetConvAct(dw, c.dw_act);
+  auto* pw = AddConv(&builder,
+                     "conv2d",
+                     "dw_out",
+                     "pw",
+                     {out_channels, chin, 1, 1},
+                     c.pw_bias,
+                     1);
+  SetConvAct(pw, c.pw_act);
+  builder.AddOutput("pw_out");
+  if (int8) {
+    QuantizeConv(&builder, dw, "dw", kInputScale);
+    QuantizeConv(&builder, pw, "pw", kDwOutScale);
+  }
+
+  auto predictor = builder.Build(places);
+  auto reference =
+      builder.BuildWithout(ref_places, {"lite_dw_pw_conv_fuse_pass"});
+  ASSERT_EQ(GetConvTypes(*predictor),
+            std::vector<std::string>{"fusion_dw_pw_conv2d"});
+  ASSERT_EQ(GetConvTypes(*reference),
+            (std::vector<std::string>{"depthwise_conv2d", "conv2d"}));
+  std::mt19937 gen(0);
+  std::uniform_real_distribution<float> dis(-2.f, 2.f);
+  auto* input = predictor->GetInput(0);
+  auto* ref_input = reference->GetInput(0);
+  input->Resize(input_shape);
+  ref_input->Resize(input_shape);
+  auto* data = input->mutable_data<float>();
+  auto* ref_data = ref_input->mutable_data<float>();
+  for (int64_t i = 0; i < input->numel(); i++) {
+    data[i] = ref_data[i] = dis(gen);
+  }
+  predictor->Run();
+  reference->Run();
+  auto* out = predictor->GetOutput(0);
+  auto* ref_out = reference->GetOutput(0);
+  ASSERT_EQ(out->dims(), ref_out->dims());
+  for (int64_t i = 0; i < ref_out->numel(); i++) {
+    float ref = ref_out->data<float>()[i];
+    ASSERT_NEAR(
+        OutputValue(out, i), ref, abs_error * std::max(1.f, std::abs(ref)))
+        << "k" << c.ksize << "s" << c.stride << ", index " << i;
+  }
+}
+
+TEST(dw_pw_conv_fuse_pass, compare_with_unfused) {
+  // 128K of L2 gives the tiles of 8 rows of the 32 channels x 64 columns.
+  DeviceInfo::Init();
+  DeviceInfo::Global().SetCache(32 * 1024, 128 * 1024, 0);
+  const std::vector<DwPwConvCase> cases{
+      {3, 1, {1, 1}, true, true, "relu", ""},
+      {3, 1, {2, 2}, false, true, "", "relu6"},
+      {3, 2, {0, 1, 0, 1}, true, false, "hard_swish", "leaky_relu"},
+      {3, 2, {1, 1}, false, false, "relu6", "hard_swish"},
+      {5, 1, {2, 2}, true, true, "leaky_relu", "relu"},
+      {5, 1, {1, 3, 2, 2}, false, true, "", ""},
+      {5, 2, {2, 2}, true, true, "relu", "relu6"},
+      {5, 2, {0, 0}, true, false, "hard_swish", ""},
+  };
+  for (auto& c : cases) {
+    CheckDwPwConv(c, {2, 32, 37, 64}, 24);
+  }
+}
+
+#ifdef ENABLE_ARM_FP16
+// The fp32 weights are converted to fp16 by the fused kernel, the outputs are
+// compared with the fp32 convs.
+TEST(dw_pw_conv_fuse_pass, fp16_compare_with_fp32) {
+  DeviceInfo::Init();
+  DeviceInfo::Global().SetCache(32 * 1024, 128 * 1024, 0);
+  const std::vector<Place> places{Place{TARGET(kARM), PRECISION(kFP16)},
+                                  Place{TARGET(kARM), PRECISION(kFloat)},
+                                  Place{TARGET(kHost), PRECISION(kFloat)}};
+  const std::vector<DwPwConvCase> cases{
+      {3, 1, {1, 1}, true, true, "relu", ""},
+      {3, 2, {0, 1, 0, 1}, true, false, "hard_swish", "leaky_relu"},
+      {5, 1, {1, 3, 2, 2}, false, true, "", "relu6"},
+  };
+  for (auto& c : cases) {
+    CheckDwPwConv(c, {1, 32, 37, 64}, 24, places, GetTestPlaces(), 5e-2f);
+  }
+}
+#endif
+
+// The int8 fused conv quantizes the depthwise tile as the int8 depthwise conv
+// does, a tie rounded differently changes the output by a step of it at most.
+TEST(dw_pw_conv_fuse_pass, int8_compare_with_unfused) {
+  DeviceInfo::Init();
+  DeviceInfo::Global().SetCache(32 * 1024, 128 * 1024, 0);
+  const std::vector<Place> places{Place{TARGET(kARM), PRECISION(kInt8)},
+                                  Place{TARGET(kARM), PRECISION(kFloat)},
+                                  Place{TARGET(kHost), PRECISION(kFloat)}};
+  const std::vector<DwPwConvCase> cases{
+      {3, 1, {1, 1}, true, true, "relu", ""},
+      {3, 2, {1, 1}, false, true, "relu6", "relu"},
+      {5, 1, {2, 2}, true, false, "", "relu6"},
+      {5, 2, {2, 2}, true, true, "relu", ""},
+  };
+  for (auto& c : cases) {
+    CheckDwPwConv(c, {2, 32, 37, 64}, 24, places, places, kDwOutScale, true);
+  }
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,250 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/optimizer/mir/fusion/dw_pw_conv_fuser.h"
+#include <memory>
+#include <set>
+#include <vector>
+
+namespace paddle {
+namespace lite {
+namespace mir {
+namespace fusion {
+
+namespace {
+
+bool IsInt8Conv(const OpInfo& op_info) {
+  return op_info.HasAttr("enable_int8") && op_info.GetAttr<bool>("enable_int8");
+}
+
+// The conv must be a plain float conv, or an int8 conv with the scales of its
+// input and filter, with at most a simple activation fused by
+// lite_conv_activation_fuse_pass.
+bool IsPlainConv(const OpInfo& op_desc) {
+  static const std::set<std::string> supported_acts{
+      "relu", "relu6", "leaky_relu", "hard_swish"};
+  if (IsInt8Conv(op_desc) &&
+      (!op_desc.HasInputScale("Input0_scale", true) ||
+       !op_desc.HasInputScale("Filter0_scale", true))) {
+    return false;
+  }
+  if (op_desc.HasAttr("quantization_type") ||
+      op_desc.HasAttr("fuse_elementwise_op_type") ||
+      op_desc.HasAttr("scale_activation_type")) {
+    return false;
+  }
+  if (op_desc.HasInput("ResidualData") &&
+      !op_desc.Input("ResidualData").empty()) {
+    return false;
+  }
+  if (op_desc.HasAttr("padding_algorithm")) {
+    auto padding_algorithm = op_desc.GetAttr<std::string>("padding_algorithm");
+    if (padding_algorithm == "SAME" || padding_algorithm == "VALID") {
+      return false;
+    }
+  }
+  if (op_desc.HasAttr("with_act") && op_desc.GetAttr<bool>("with_act")) {
+    return supported_acts.count(op_desc.GetAttr<std::string>("act_type")) > 0;
+  }
+  return true;
+}
+
+DDim FilterDims(const Node* node, const std::string& arg) {
+  auto op_desc = const_cast<Node*>(node)->stmt()->op_info();
+  auto* scope = const_cast<Node*>(node)->AsStmt().op()->scope();
+  auto* var = scope->FindVar(op_desc->Input(arg).front());
+  return var ? var->Get<lite::Tensor>().dims() : DDim();
+}
+
+void CopyConvAttrs(const cpp::OpDesc& from,
+                   const std::string& prefix,
+                   cpp::OpDesc* to) {
+  bool with_act = from.HasAttr("with_act") && from.GetAttr<bool>("with_act");
+  to->SetAttr(prefix + "with_act", with_act);
+  if (!with_act) {
+    return;
+  }
+  auto act_type = from.GetAttr<std::string>("act_type");
+  to->SetAttr(prefix + "act_type", act_type);
+  if (act_type == "relu6") {
+    to->SetAttr(prefix + "fuse_brelu_threshold",
+                from.GetAttr<float>("fuse_brelu_threshold"));
+  } else if (act_type == "leaky_relu") {
+    to->SetAttr(prefix + "leaky_relu_alpha",
+                from.GetAttr<float>("leaky_relu_alpha"));
+  } else if (act_type == "hard_swish") {
+    for (auto name :
+         {"hard_swish_threshold", "hard_swish_scale", "hard_swish_offset"}) {
+      to->SetAttr(prefix + name, from.GetAttr<float>(name));
+    }
+  }
+}
+
+}  // namespace
+
+void DwPwConvFuser::BuildPattern() {
+  auto dw_teller = [](const Node* node) -> bool {
+    auto op_desc = *const_cast<Node*>(node)->stmt()->op_info();
+    auto w_dims = FilterDims(node, "Filter");
+    if (w_dims.size() != 4 || w_dims[1] != 1) {
+      return false;
+    }
+    auto dilations = op_desc.GetAttr<std::vector<int>>("dilations");
+    return IsPlainConv(op_desc) && dilations.size() == 2 &&
+           op_desc.GetAttr<int>("groups") == w_dims[0];
+  };
+  auto pw_teller = [](const Node* node) -> bool {
+    auto op_desc = *const_cast<Node*>(node)->stmt()->op_info();
+    auto w_dims = FilterDims(node, "Filter");
+    if (w_dims.size() != 4 || w_dims[2] != 1 || w_dims[3] != 1) {
+      return false;
+    }
+    for (auto stride : op_desc.GetAttr<std::vector<int>>("strides")) {
+      if (stride != 1) return false;
+    }
+    for (auto padding : op_desc.GetAttr<std::vector<int>>("paddings")) {
+      if (padding != 0) return false;
+    }
+    for (auto dilation : op_desc.GetAttr<std::vector<int>>("dilations")) {
+      if (dilation != 1) return false;
+    }
+    return IsPlainConv(op_desc) && op_desc.GetAttr<int>("groups") == 1;
+  };
+
+  auto* input = VarNode("input")
+                    ->assert_is_op_input("depthwise_conv2d", "Input")
+                    ->AsInput();
+  auto* dw_filter = VarNode("dw_filter")
+                        ->assert_is_op_input("depthwise_conv2d", "Filter")
+                        ->AsInput();
+  auto* dw = OpNode("dw", "depthwise_conv2d")
+                 ->assert_node_satisfied(dw_teller)
+                 ->AsIntermediate();
+  // The convs are both float, or both int8 with the scale of the depthwise
+  // output, which the depthwise tile is quantized by.
+  auto dw_out_teller = [](const Node* node) -> bool {
+    if (node->inlinks.size() != 1 || node->outlinks.size() != 1) {
+      return false;
+    }
+    auto* dw_info = node->inlinks.front()->stmt()->op_info();
+    auto* pw_info = node->outlinks.front()->stmt()->op_info();
+    if (IsInt8Conv(*dw_info) != IsInt8Conv(*pw_info)) {
+      return false;
+    }
+    return !IsInt8Conv(*pw_info) ||
+           pw_info->HasInputScale(const_cast<Node*>(node)->arg()->name);
+  };
+  auto* dw_out = VarNode("dw_out")
+                     ->assert_is_op_output("depthwise_conv2d", "Output")
+                     ->assert_is_op_input("conv2d", "Input")
+                     ->assert_node_satisfied(dw_out_teller)
+                     ->AsIntermediate();
+  auto* pw_filter = VarNode("pw_filter")
+                        ->assert_is_op_input("conv2d", "Filter")
+                        ->AsInput();
+  auto* pw = OpNode("pw", "conv2d")
+                 ->assert_node_satisfied(pw_teller)
+                 ->AsIntermediate();
+  auto* output =
+      VarNode("output")->assert_is_op_output("conv2d", "Output")->AsOutput();
+
+  std::vector<PMNode*> dw_inputs{input, dw_filter};
+  std::vector<PMNode*> pw_inputs{dw_out, pw_filter};
+  if (dw_has_bias_) {
+    dw_inputs.push_back(VarNode("dw_bias")
+                            ->assert_is_op_input("depthwise_conv2d", "Bias")
+                            ->AsInput());
+  }
+  if (pw_has_bias_) {
+    pw_inputs.push_back(
+        VarNode("pw_bias")->assert_is_op_input("conv2d", "Bias")->AsInput());
+  }
+  dw_inputs >> *dw >> *dw_out;
+  pw_inputs >> *pw >> *output;
+}
+
+void DwPwConvFuser::InsertNewNode(SSAGraph* graph,
+                                  const key2nodes_t& matched) {
+  auto op_desc = GenOpDesc(matched);
+  auto fused_op = LiteOpRegistry::Global().Create("fusion_dw_pw_conv2d");
+  auto dw = matched.at("dw")->stmt()->op();
+  auto* scope = dw->scope();
+  auto& valid_places = dw->valid_places();
+  fused_op->Attach(op_desc, scope);
+
+  auto* new_op_node = graph->GraphCreateInstructNode(fused_op, valid_places);
+
+  IR_NODE_LINK_TO(matched.at("input"), new_op_node);
+  IR_NODE_LINK_TO(matched.at("dw_filter"), new_op_node);
+  IR_NODE_LINK_TO(matched.at("pw_filter"), new_op_node);
+  if (dw_has_bias_) {
+    IR_NODE_LINK_TO(matched.at("dw_bias"), new_op_node);
+  }
+  if (pw_has_bias_) {
+    IR_NODE_LINK_TO(matched.at("pw_bias"), new_op_node);
+  }
+  IR_NODE_LINK_TO(new_op_node, matched.at("output"));
+}
+
+cpp::OpDesc DwPwConvFuser::GenOpDesc(const key2nodes_t& matched) {
+  auto dw_desc = *matched.at("dw")->stmt()->op_info();
+  auto pw_desc = *matched.at("pw")->stmt()->op_info();
+
+  cpp::OpDesc op_desc;
+  op_desc.SetType("fusion_dw_pw_conv2d");
+  op_desc.SetInput("Input", {matched.at("input")->arg()->name});
+  op_desc.SetInput("DwFilter", {matched.at("dw_filter")->arg()->name});
+  op_desc.SetInput("PwFilter", {matched.at("pw_filter")->arg()->name});
+  if (dw_has_bias_) {
+    op_desc.SetInput("DwBias", {matched.at("dw_bias")->arg()->name});
+  }
+  if (pw_has_bias_) {
+    op_desc.SetInput("PwBias", {matched.at("pw_bias")->arg()->name});
+  }
+  op_desc.SetOutput("Output", {matched.at("output")->arg()->name});
+  op_desc.SetAttr("dw_strides", dw_desc.GetAttr<std::vector<int>>("strides"));
+  op_desc.SetAttr("dw_paddings",
+                  dw_desc.GetAttr<std::vector<int>>("paddings"));
+  op_desc.SetAttr("dw_dilations",
+                  dw_desc.GetAttr<std::vector<int>>("dilations"));
+  CopyConvAttrs(dw_desc, "dw_", &op_desc);
+  CopyConvAttrs(pw_desc, "pw_", &op_desc);
+  if (!IsInt8Conv(dw_desc)) {
+    return op_desc;
+  }
+  // The output scale is set by the kernel pick pass if the output is int8.
+  OpInfo op_info(op_desc);
+  op_info.SetAttr("enable_int8", true);
+  if (dw_desc.HasAttr("bit_length")) {
+    op_info.SetAttr("bit_length", dw_desc.GetAttr<int>("bit_length"));
+  }
+  op_info.SetInputScale("Input0_scale",
+                        dw_desc.GetInputScale("Input0_scale", true),
+                        true);
+  op_info.SetInputScale("DwFilter0_scale",
+                        dw_desc.GetInputScale("Filter0_scale", true),
+                        true);
+  op_info.SetInputScale("PwFilter0_scale",
+                        pw_desc.GetInputScale("Filter0_scale", true),
+                        true);
+  op_info.SetAttr(
+      "dw_output_scale",
+      pw_desc.GetInputScale(matched.at("dw_out")->arg()->name).front());
+  return op_info;
+}
+
+}  // namespace fusion
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,86 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/optimizer/mir/fusion/elementwise_add_layer_norm_fuser.h"
+#include <memory>
+#include <vector>
+
+namespace paddle {
+namespace lite {
+namespace mir {
+namespace fusion {
+
+void ElementwiseAddLayerNormFuser::BuildPattern() {
+  // The add with axis -1 broadcasts along the leading dims only, which is
+  // what the layer_norm kernels support for the residual.
+  auto add_teller = [](const Node* node) -> bool {
+    auto* op_desc = const_cast<Node*>(node)->AsStmt().op_info();
+    if (op_desc->HasAttr("axis") && op_desc->GetAttr<int>("axis") != -1) {
+      return false;
+    }
+    return !op_desc->HasAttr("enable_int8") ||
+           !op_desc->GetAttr<bool>("enable_int8");
+  };
+  auto layer_norm_teller = [](const Node* node) -> bool {
+    auto* op_desc = const_cast<Node*>(node)->AsStmt().op_info();
+    return !op_desc->HasInput("Residual") ||
+           op_desc->Input("Residual").empty();
+  };
+
+  // create input nodes.
+  auto* x = VarNode("x")
+                ->assert_is_op_input("elementwise_add", "X")
+                ->assert_var_not_persistable()
+                ->AsInput();
+  auto* y = VarNode("y")
+                ->assert_is_op_input("elementwise_add", "Y")
+                ->assert_var_not_persistable()
+                ->AsInput();
+
+  // create op nodes
+  auto* add = OpNode("add", "elementwise_add")
+                  ->assert_is_op("elementwise_add")
+                  ->assert_node_satisfied(add_teller)
+                  ->AsIntermediate();
+  auto* layer_norm = OpNode("layer_norm", "layer_norm")
+                         ->assert_is_op("layer_norm")
+                         ->assert_node_satisfied(layer_norm_teller);
+
+  // create intermediate nodes
+  auto* add_out = VarNode("add_out")
+                      ->assert_is_op_output("elementwise_add", "Out")
+                      ->assert_is_op_input("layer_norm", "X")
+                      ->AsIntermediate();
+
+  // create topology.
+  std::vector<PMNode*> add_inputs{x, y};
+  add_inputs >> *add >> *add_out >> *layer_norm;
+}
+
+void ElementwiseAddLayerNormFuser::InsertNewNode(SSAGraph* graph,
+                                                 const key2nodes_t& matched) {
+  auto layer_norm_instruct = matched.at("layer_norm")->stmt();
+  auto op_desc = *layer_norm_instruct->op_info();
+  op_desc.SetInput("X", {matched.at("x")->arg()->name});
+  op_desc.SetInput("Residual", {matched.at("y")->arg()->name});
+  layer_norm_instruct->ResetOp(op_desc, graph->valid_places());
+
+  IR_NODE_LINK_TO(matched.at("x"), matched.at("layer_norm"));
+  IR_NODE_LINK_TO(matched.at("y"), matched.at("layer_norm"));
+}
+
+}  // namespace fusion
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,99 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "lite/core/optimizer/mir/fusion/embedding_seq_pool_fuser.h"
+#include <memory>
+#include <vector>
+
+namespace paddle {
+namespace lite {
+namespace mir {
+namespace fusion {
+
+void EmbeddingSeqPoolFuser::BuildPattern() {
+  auto pool_teller = [](const Node* node) -> bool {
+    auto pool_type =
+        const_cast<Node*>(node)->AsStmt().op_info()->GetAttr<std::string>(
+            "pooltype");
+    return pool_type == "SUM" || pool_type == "AVERAGE" ||
+           pool_type == "SQRT";
+  };
+
+  // create nodes
+  // lookup
+  PMNode* w = VarNode("w")->assert_is_op_input(lookup_type_, "W")->AsInput();
+  PMNode* ids =
+      VarNode("ids")->assert_is_op_input(lookup_type_, "Ids")->AsInput();
+  PMNode* lookup = OpNode("lookup", lookup_type_)->AsIntermediate();
+  PMNode* lookup_out = VarNode("lookup_out")
+                           ->assert_is_op_output(lookup_type_, "Out")
+                           ->assert_is_op_input("sequence_pool", "X")
+                           ->AsIntermediate();
+
+  // sequence_pool
+  PMNode* pool = OpNode("sequence_pool", "sequence_pool")
+                     ->assert_node_satisfied(pool_teller)
+                     ->AsIntermediate();
+  PMNode* max_index = VarNode("max_index")
+                          ->assert_is_op_output("sequence_pool", "MaxIndex")
+                          ->AsIntermediate();
+  PMNode* out = VarNode("out")
+                    ->assert_is_op_output("sequence_pool", "Out")
+                    ->AsOutput();
+
+  // create topology.
+  std::vector<PMNode*> lookup_inputs{w, ids};
+  lookup_inputs >> *lookup >> *lookup_out >> *pool >> *out;
+  *pool >> *max_index;
+}
+
+void EmbeddingSeqPoolFuser::InsertNewNode(SSAGraph* graph,
+                                          const key2nodes_t& matched) {
+  auto op_desc = GenOpDesc(matched);
+  auto fused_op = LiteOpRegistry::Global().Create(op_desc.Type());
+  auto lookup = matched.at("lookup")->stmt()->op();
+  auto* scope = lookup->scope();
+  auto& valid_places = lookup->valid_places();
+  fused_op->Attach(op_desc, scope);
+
+  auto* new_op_node = graph->GraphCreateInstructNode(fused_op, valid_places);
+
+  IR_NODE_LINK_TO(matched.at("w"), new_op_node);
+  IR_NODE_LINK_TO(matched.at("ids"), new_op_node);
+  IR_NODE_LINK_TO(new_op_node, matched.at("out"));
+}
+
+cpp::OpDesc EmbeddingSeqPoolFuser::GenOpDesc(const key2nodes_t& matched) {
+  auto* lookup_info = matched.at("lookup")->stmt()->op_info();
+  auto* pool_info = matched.at("sequence_pool")->stmt()->op_info();
+
+  cpp::OpDesc op_desc;
+  op_desc.SetType("fusion_embedding_seq_pool");
+  op_desc.SetInput("W", {matched.at("w")->arg()->name});
+  op_desc.SetInput("Ids", {matched.at("ids")->arg()->name});
+  op_desc.SetOutput("Out", {matched.at("out")->arg()->name});
+  op_desc.SetAttr<int64_t>("padding_idx",
+                           lookup_info->GetAttr<int64_t>("padding_idx"));
+  op_desc.SetAttr<std::string>("lookup_type", lookup_type_);
+  op_desc.SetAttr<std::string>("pooltype",
+                               pool_info->GetAttr<std::string>("pooltype"));
+  if (pool_info->HasAttr("pad_value")) {
+    op_desc.SetAttr<float>("pad_value", pool_info->GetAttr<float>("pad_value"));
+  }
+  return op_desc;
+}
+
+}  // namespace fusion
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
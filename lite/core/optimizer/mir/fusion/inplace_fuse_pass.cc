@@ -30,7 +30,10 @@ void InplaceFusePass::Apply(const std::unique_ptr<SSAGraph>& graph) {
                                               "squeeze",
                                               "squeeze2",
                                               "unsqueeze",
-                                              "unsqueeze2"};
+                                              "unsqueeze2",
+                                              "slice",
+                                              "split",
+                                              "concat"};
   for (auto type : inplace_type_cases) {
     fusion::InplaceFuser inplace_fuser(type);
     inplace_fuser(graph.get());
@@ -0,0 +1,278 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/optimizer/mir/fusion/inplace_fuse_pass.h"
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+#include <vector>
+#include "lite/api/paddle_use_kernels.h"
+#include "lite/api/paddle_use_ops.h"
+#include "lite/api/paddle_use_passes.h"
+#include "lite/core/optimizer/mir/pass_test_helper.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+// The inplace attr of the first op of the type in the runtime program.
+bool IsInplace(const Predictor& predictor, const std::string& type) {
+  for (auto& inst : predictor.runtime_program().instructions()) {
+    auto op_info = inst.op()->op_info();
+    if (op_info->Type() == type) {
+      return op_info->HasAttr("inplace") && op_info->GetAttr<bool>("inplace");
+    }
+  }
+  LOG(FATAL) << "No op " << type;
+  return false;
+}
+
+// Runs the program with and without the pass twice, as the views are made in
+// the first run and written in the following ones, and compares the outputs.
+void CheckInplace(const std::unique_ptr<Predictor>& predictor,
+                  const std::unique_ptr<Predictor>& reference,
+                  const std::vector<int64_t>& input_shape,
+                  int num_outputs) {
+  std::mt19937 gen(0);
+  std::uniform_real_distribution<float> dis(-2.f, 2.f);
+  for (int run = 0; run < 2; run++) {
+    auto* input = predictor->GetInput(0);
+    auto* ref_input = reference->GetInput(0);
+    input->Resize(input_shape);
+    ref_input->Resize(input_shape);
+    auto* data = input->mutable_data<float>();
+    auto* ref_data = ref_input->mutable_data<float>();
+    for (int64_t i = 0; i < input->numel(); i++) {
+      data[i] = ref_data[i] = dis(gen);
+    }
+    predictor->Run();
+    reference->Run();
+    for (int i = 0; i < num_outputs; i++) {
+      auto* out = predictor->GetOutput(i);
+      auto* ref_out = reference->GetOutput(i);
+      ASSERT_EQ(out->dims(), ref_out->dims());
+      for (int64_t j = 0; j < ref_out->numel(); j++) {
+        EXPECT_NEAR(out->data<float>()[j], ref_out->data<float>()[j], 1e-5)
+            << "run " << run << ", output " << i << ", index " << j;
+      }
+    }
+  }
+}
+
+cpp::OpDesc* AddReshape(TestProgramBuilder* builder,
+                        const std::string& x,
+                        const std::string& out,
+                        const std::vector<int>& shape) {
+  auto* reshape =
+      builder->AddOp("reshape2",
+                     {{"X", {x}}},
+                     {{"Out", {out}}, {"XShape", {out + "_xshape"}}});
+  reshape->SetAttr<std::vector<int>>("shape", shape);
+  return reshape;
+}
+
+cpp::OpDesc* AddScale(TestProgramBuilder* builder,
+                      const std::string& x,
+                      const std::string& out,
+                      float scale) {
+  auto* op = builder->AddOp("scale", {{"X", {x}}}, {{"Out", {out}}});
+  op->SetAttr<float>("scale", scale);
+  op->SetAttr<float>("bias", 1.f);
+  op->SetAttr<bool>("bias_after_scale", true);
+  return op;
+}
+
+// The output of the reshape is read by two ops, so it isn't a view of the
+// input, as any of them may write into it.
+TEST(inplace_fuse_pass, multi_consumer_output) {
+  TestProgramBuilder builder;
+  builder.AddInput("x");
+  builder.AddOp("relu", {{"X", {"x"}}}, {{"Out", {"relu_out"}}});
+  AddReshape(&builder, "relu_out", "reshape_out", {0, -1});
+  AddScale(&builder, "reshape_out", "scale_out", 2.f);
+  builder.AddOp("sigmoid", {{"X", {"reshape_out"}}}, {{"Out", {"out"}}});
+  builder.AddOutput("scale_out");
+  builder.AddOutput("out");
+  auto places = GetTestPlaces();
+  auto predictor = builder.Build(places);
+  auto reference = builder.BuildWithout(places, {"lite_inplace_fuse_pass"});
+  EXPECT_FALSE(IsInplace(*predictor, "reshape2"));
+  CheckInplace(predictor, reference, {2, 3, 4, 5}, 2);
+}
+
+// The input of the reshape is read by another op too, the output which is
+// read only by one op is a view of it, and the input stays intact for the
+// other consumer.
+TEST(inplace_fuse_pass, multi_consumer_input) {
+  TestProgramBuilder builder;
+  builder.AddInput("x");
+  builder.AddOp("relu", {{"X", {"x"}}}, {{"Out", {"relu_out"}}});
+  AddReshape(&builder, "relu_out", "reshape_out", {0, -1});
+  AddScale(&builder, "reshape_out", "scale_out", 2.f);
+  builder.AddOp("sigmoid", {{"X", {"relu_out"}}}, {{"Out", {"out"}}});
+  builder.AddOutput("scale_out");
+  builder.AddOutput("out");
+  auto places = GetTestPlaces();
+  auto predictor = builder.Build(places);
+  auto reference = builder.BuildWithout(places, {"lite_inplace_fuse_pass"});
+  EXPECT_TRUE(IsInplace(*predictor, "reshape2"));
+  EXPECT_FALSE(IsInplace(*reference, "reshape2"));
+  CheckInplace(predictor, reference, {2, 3, 4, 5}, 2);
+}
+
+void AddConcat(TestProgramBuilder* builder,
+               const std::vector<std::string>& x,
+               const std::string& out,
+               int axis) {
+  builder->AddOp("concat", {{"X", x}}, {{"Out", {out}}})
+      ->SetAttr<int>("axis", axis);
+}
+
+// Whether the inputs of the first concat op are the views of their pieces of
+// the output, by the names of the vars after the memory optimize pass.
+bool IsConcatViews(const Predictor& predictor) {
+  for (auto& inst : predictor.runtime_program().instructions()) {
+    auto op_info = inst.op()->op_info();
+    if (op_info->Type() != "concat") continue;
+    auto* out = predictor.GetTensor(op_info->Output("Out").front());
+    int64_t offset = 0;
+    for (auto& name : op_info->Input("X")) {
+      auto* x = predictor.GetTensor(name);
+      if (!x->is_view() || x->data<float>() != out->data<float>() + offset) {
+        return false;
+      }
+      offset += x->numel();
+    }
+    return true;
+  }
+  LOG(FATAL) << "No op concat";
+  return false;
+}
+
+// The producers of the concat inputs write into the pieces of the output from
+// the second run on, and the growing inputs get the new pieces.
+TEST(inplace_fuse_pass, concat_in_place) {
+  TestProgramBuilder builder;
+  builder.AddInput("x");
+  builder.AddOp("relu", {{"X", {"x"}}}, {{"Out", {"relu_out"}}});
+  builder.AddOp("sigmoid", {{"X", {"x"}}}, {{"Out", {"sigmoid_out"}}});
+  AddScale(&builder, "x", "scale_out", 3.f);
+  AddConcat(&builder, {"relu_out", "sigmoid_out", "scale_out"}, "concat", 0);
+  AddScale(&builder, "concat", "out", 2.f);
+  builder.AddOutput("out");
+  auto places = GetTestPlaces();
+  auto predictor = builder.Build(places);
+  auto reference = builder.BuildWithout(places, {"lite_inplace_fuse_pass"});
+  EXPECT_TRUE(IsInplace(*predictor, "concat"));
+  EXPECT_FALSE(IsInplace(*reference, "concat"));
+  CheckInplace(predictor, reference, {2, 3, 4}, 1);
+  EXPECT_TRUE(IsConcatViews(*predictor));
+  EXPECT_FALSE(IsConcatViews(*reference));
+  CheckInplace(predictor, reference, {3, 3, 4}, 1);
+  EXPECT_TRUE(IsConcatViews(*predictor));
+  CheckInplace(predictor, reference, {1, 3, 4}, 1);
+  EXPECT_TRUE(IsConcatViews(*predictor));
+}
+
+// The inputs aren't contiguous pieces of the output if the dims before the
+// axis aren't 1, so the kernel copies them as the one without the pass.
+TEST(inplace_fuse_pass, concat_strided_pieces) {
+  TestProgramBuilder builder;
+  builder.AddInput("x");
+  builder.AddOp("relu", {{"X", {"x"}}}, {{"Out", {"relu_out"}}});
+  builder.AddOp("sigmoid", {{"X", {"x"}}}, {{"Out", {"sigmoid_out"}}});
+  AddConcat(&builder, {"relu_out", "sigmoid_out"}, "concat", 1);
+  AddScale(&builder, "concat", "out", 2.f);
+  builder.AddOutput("out");
+  auto places = GetTestPlaces();
+  auto predictor = builder.Build(places);
+  auto reference = builder.BuildWithout(places, {"lite_inplace_fuse_pass"});
+  EXPECT_TRUE(IsInplace(*predictor, "concat"));
+  CheckInplace(predictor, reference, {2, 3, 4}, 1);
+  EXPECT_FALSE(IsConcatViews(*predictor));
+  // The dims before the axis are 1 now.
+  CheckInplace(predictor, reference, {1, 3, 4}, 1);
+  EXPECT_TRUE(IsConcatViews(*predictor));
+}
+
+// The concat ops whose inputs can't be the views of the output are left as
+// they are.
+TEST(inplace_fuse_pass, concat_not_in_place) {
+  auto places = GetTestPlaces();
+  // The input fed by the feed op, which makes it a view of the feed tensor.
+  {
+    TestProgramBuilder builder;
+    builder.AddInput("x");
+    builder.AddOp("relu", {{"X", {"x"}}}, {{"Out", {"relu_out"}}});
+    AddConcat(&builder, {"x", "relu_out"}, "out", 0);
+    builder.AddOutput("out");
+    auto predictor = builder.Build(places);
+    auto reference = builder.BuildWithout(places, {"lite_inplace_fuse_pass"});
+    EXPECT_FALSE(IsInplace(*predictor, "concat"));
+    CheckInplace(predictor, reference, {2, 3, 4}, 1);
+  }
+  // The input which is a view of the output of the relu.
+  {
+    TestProgramBuilder builder;
+    builder.AddInput("x");
+    builder.AddOp("relu", {{"X", {"x"}}}, {{"Out", {"relu_out"}}});
+    builder.AddOp("sigmoid", {{"X", {"x"}}}, {{"Out", {"sigmoid_out"}}});
+    AddReshape(&builder, "relu_out", "reshape_out", {0, 3, 4});
+    AddConcat(&builder, {"reshape_out", "sigmoid_out"}, "out", 0);
+    builder.AddOutput("out");
+    auto predictor = builder.Build(places);
+    auto reference = builder.BuildWithout(places, {"lite_inplace_fuse_pass"});
+    EXPECT_FALSE(IsInplace(*predictor, "concat"));
+    CheckInplace(predictor, reference, {2, 3, 4}, 1);
+  }
+  // The input concatenated twice.
+  {
+    TestProgramBuilder builder;
+    builder.AddInput("x");
+    builder.AddOp("relu", {{"X", {"x"}}}, {{"Out", {"relu_out"}}});
+    AddConcat(&builder, {"relu_out", "relu_out"}, "out", 0);
+    builder.AddOutput("out");
+    auto predictor = builder.Build(places);
+    auto reference = builder.BuildWithout(places, {"lite_inplace_fuse_pass"});
+    EXPECT_FALSE(IsInplace(*predictor, "concat"));
+    CheckInplace(predictor, reference, {2, 3, 4}, 1);
+  }
+  // The input read by another concat op, which can only be the view of one
+  // of the outputs.
+  {
+    TestProgramBuilder builder;
+    builder.AddInput("x");
+    builder.AddOp("relu", {{"X", {"x"}}}, {{"Out", {"relu_out"}}});
+    builder.AddOp("sigmoid", {{"X", {"x"}}}, {{"Out", {"sigmoid_out"}}});
+    AddScale(&builder, "x", "scale_out", 3.f);
+    AddConcat(&builder, {"relu_out", "sigmoid_out"}, "out_a", 0);
+    AddConcat(&builder, {"relu_out", "scale_out"}, "out_b", 0);
+    builder.AddOutput("out_a");
+    builder.AddOutput("out_b");
+    auto predictor = builder.Build(places);
+    auto reference = builder.BuildWithout(places, {"lite_inplace_fuse_pass"});
+    for (auto& inst : predictor->runtime_program().instructions()) {
+      auto op_info = inst.op()->op_info();
+      if (op_info->Type() == "concat") {
+        EXPECT_FALSE(op_info->HasAttr("inplace") &&
+                     op_info->GetAttr<bool>("inplace"));
+      }
+    }
+    CheckInplace(predictor, reference, {2, 3, 4}, 2);
+  }
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
@@ -13,7 +13,10 @@
 // limitations under the License.
 
 #include "lite/core/optimizer/mir/fusion/inplace_fuser.h"
+#include <map>
 #include <memory>
+#include <set>
+#include <string>
 #include <vector>
 
 namespace paddle {
@@ -23,15 +26,122 @@ namespace fusion {
 
 void InplaceFuser::BuildPattern() { OpNode("inplace", type_); }
 
+namespace {
+
+bool IsHostTarget(TargetType target) {
+  return target == TARGET(kHost) || target == TARGET(kARM) ||
+         target == TARGET(kX86);
+}
+
+// The outputs of the op can be the views of its inputs only if none of them
+// is written by the other ops, such as the in-place ops whose input and output
+// share the same name.
+bool CanBeView(SSAGraph* graph, Node* op_node) {
+  std::set<std::string> names;
+  for (auto* var_node : op_node->inlinks) {
+    names.insert(var_node->arg()->name);
+  }
+  for (auto* var_node : op_node->outlinks) {
+    if (var_node->arg()->is_weight || var_node->arg()->is_persist) {
+      return false;
+    }
+    names.insert(var_node->arg()->name);
+  }
+  for (auto& node : graph->nodes()) {
+    if (!node.IsStmt() || &node == op_node) continue;
+    for (auto* var_node : node.outlinks) {
+      if (names.count(var_node->arg()->name)) return false;
+    }
+  }
+  return true;
+}
+
+// The inputs of the concat op can be the views of its output if each of them
+// is written only by its producer on the host, and none of them is the view of
+// another var or the input of another concat op.
+bool CanConcatInPlace(SSAGraph* graph, Node* op_node) {
+  const std::set<std::string> view_ops{"feed",
+                                       "reshape",
+                                       "reshape2",
+                                       "flatten",
+                                       "flatten2",
+                                       "squeeze",
+                                       "squeeze2",
+                                       "unsqueeze",
+                                       "unsqueeze2",
+                                       "slice",
+                                       "split"};
+  auto* stmt = op_node->stmt();
+  if (stmt->picked_kernel().precision() == PRECISION(kInt8)) return false;
+  auto x_names = stmt->op_info()->Input("X");
+  std::set<std::string> names(x_names.begin(), x_names.end());
+  if (x_names.size() < 2 || names.size() != x_names.size()) return false;
+  for (auto* var_node : op_node->inlinks) {
+    if (!names.count(var_node->arg()->name)) continue;
+    if (var_node->arg()->is_weight || var_node->arg()->is_persist ||
+        var_node->inlinks.size() != 1) {
+      return false;
+    }
+    auto* producer = var_node->inlinks.front()->stmt();
+    if (!IsHostTarget(producer->place().target) ||
+        view_ops.count(producer->op_type())) {
+      return false;
+    }
+    for (auto* consumer : var_node->outlinks) {
+      if (consumer != op_node && consumer->stmt()->op_type() == "concat") {
+        return false;
+      }
+    }
+  }
+  std::set<std::string> out_names;
+  for (auto* var_node : op_node->outlinks) {
+    if (var_node->arg()->is_weight || var_node->arg()->is_persist) {
+      return false;
+    }
+    out_names.insert(var_node->arg()->name);
+  }
+  // Each input is written only once and the output only by the concat op.
+  std::map<std::string, int> num_writes;
+  for (auto& node : graph->nodes()) {
+    if (!node.IsStmt() || &node == op_node) continue;
+    for (auto* var_node : node.outlinks) {
+      auto& name = var_node->arg()->name;
+      if (out_names.count(name) ||
+          (names.count(name) && ++num_writes[name] > 1)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
 void InplaceFuser::InsertNewNode(SSAGraph* graph, const key2nodes_t& matched) {
-  auto out_var_nodes = matched.at("inplace")->outlinks;
+  auto* op_node = matched.at("inplace");
+  auto* stmt = op_node->stmt();
+  bool is_host = IsHostTarget(stmt->place().target);
   bool inplace = true;
-  for (auto& out_var_node : out_var_nodes) {
-    if (out_var_node->outlinks.size() > 1) {
-      inplace = false;
+  if (type_ == "concat") {
+    // The concat kernels on the host make the inputs the views of the output.
+    if (!is_host || !CanConcatInPlace(graph, op_node)) return;
+  } else if (!is_host && (type_ == "slice" || type_ == "split")) {
+    // The slice and split kernels on the host make the views themselves.
+    return;
+  } else {
+    // A view is shared by all of its consumers, so any of them which writes
+    // into it would change the data read by the others.
+    for (auto& out_var_node : op_node->outlinks) {
+      if (out_var_node->outlinks.size() > 1) {
+        inplace = false;
+      }
+    }
+    // MemoryOptimizePass keeps the viewed inputs alive for the consumers of
+    // the views.
+    if (is_host && inplace) {
+      inplace = CanBeView(graph, op_node);
     }
   }
-  auto* stmt = matched.at("inplace")->stmt();
   auto op = stmt->op();
   cpp::OpDesc* op_desc = op->mutable_op_info();
   op_desc->SetAttr<bool>("inplace", inplace);
@@ -0,0 +1,402 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/optimizer/mir/fusion/pointwise_chain_fuse_pass.h"
+#include <algorithm>
+#include <list>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+#include "lite/core/optimizer/mir/pass_registry.h"
+#include "lite/core/optimizer/mir/pattern_matcher.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+namespace {
+
+struct PointwiseStepDesc {
+  std::string type;
+  // The second operand of the binary steps.
+  std::string operand;
+  int axis{-1};
+  bool reversed{false};
+  float attrs[3]{0.f, 0.f, 0.f};
+};
+
+template <typename T>
+T GetAttrOr(const OpInfo& op_info, const std::string& name, T value) {
+  return op_info.HasAttr(name) ? op_info.GetAttr<T>(name) : value;
+}
+
+bool HasTensorInput(const OpInfo& op_info, const std::string& name) {
+  return op_info.HasInput(name) && !op_info.Input(name).empty();
+}
+
+// Get the step of an activation, the `fused` activations of the scale op only
+// take the alpha attribute.
+bool GetActivationStep(const OpInfo& op_info,
+                       const std::string& act_type,
+                       bool fused,
+                       PointwiseStepDesc* step) {
+  static const std::set<std::string> plain_acts{
+      "relu", "sigmoid", "tanh", "exp", "abs", "square"};
+  step->type = act_type;
+  if (plain_acts.count(act_type)) {
+    return true;
+  }
+  if (act_type == "relu6") {
+    step->attrs[0] = fused ? GetAttrOr<float>(op_info, "alpha", 6.f)
+                           : GetAttrOr<float>(op_info, "threshold", 6.f);
+  } else if (act_type == "leaky_relu") {
+    step->attrs[0] = GetAttrOr<float>(op_info, "alpha", 0.02f);
+  } else if (fused) {
+    return false;
+  } else if (act_type == "hard_swish") {
+    step->attrs[0] = GetAttrOr<float>(op_info, "threshold", 6.f);
+    step->attrs[1] = GetAttrOr<float>(op_info, "scale", 6.f);
+    step->attrs[2] = GetAttrOr<float>(op_info, "offset", 3.f);
+  } else if (act_type == "hard_sigmoid") {
+    step->attrs[0] = GetAttrOr<float>(op_info, "slope", 0.2f);
+    step->attrs[1] = GetAttrOr<float>(op_info, "offset", 0.5f);
+  } else if (act_type == "swish") {
+    step->attrs[0] = GetAttrOr<float>(op_info, "beta", 1.f);
+  } else {
+    return false;
+  }
+  return true;
+}
+
+// The dims of a var are the shape of its var desc if it isn't a weight, so
+// they're empty if the shape isn't declared, and the unknown dims are -1.
+DDim GetVarDims(Scope* scope, const std::string& name) {
+  auto* var = scope->FindVar(name);
+  if (!var || !var->IsType<Tensor>()) {
+    return DDim();
+  }
+  return var->Get<Tensor>().dims();
+}
+
+// Whether the operand `y` broadcasts into the chained var `x` as the kernel
+// does, so the chain keeps the dims of its input. The -1 dims only match the
+// -1 dims, which are taken as the same batch size.
+bool IsBroadcastInto(const DDim& y_dims, const DDim& x_dims, int axis) {
+  const int x_rank = static_cast<int>(x_dims.size());
+  const int y_rank = static_cast<int>(y_dims.size());
+  if (x_rank == 0 || y_rank == 0 || y_rank > x_rank) {
+    return false;
+  }
+  if (axis == -1) {
+    axis = x_rank - y_rank;
+  }
+  int begin = 0;
+  int end = y_rank;
+  while (begin < end && y_dims[begin] == 1) begin++;
+  while (end > begin && y_dims[end - 1] == 1) end--;
+  axis += begin;
+  if (axis < 0 || axis + end - begin > x_rank) {
+    return false;
+  }
+  for (int i = begin; i < end; i++) {
+    if (x_dims[axis + i - begin] != y_dims[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Translate the op into the steps applied on its input `x_name`, returns false
+// if the op can't be a part of a chain. The fused op takes the dims of the
+// chain input, so the operand of a binary op must broadcast into `x_name`,
+// e.g. the elementwise_mul of squeeze-and-excitation isn't fused to the chain
+// of its scales [N, C, 1, 1], whose operand is the feature map.
+bool GetPointwiseSteps(const OpInfo& op_info,
+                       const std::string& x_name,
+                       Scope* scope,
+                       std::vector<PointwiseStepDesc>* steps) {
+  static const std::map<std::string, std::string> binary_ops{
+      {"elementwise_add", "add"},
+      {"elementwise_sub", "sub"},
+      {"elementwise_mul", "mul"},
+      {"elementwise_div", "div"},
+      {"elementwise_max", "max"},
+      {"elementwise_min", "min"},
+      {"fusion_elementwise_add_activation", "add"},
+      {"fusion_elementwise_sub_activation", "sub"},
+      {"fusion_elementwise_mul_activation", "mul"},
+      {"fusion_elementwise_div_activation", "div"},
+      {"fusion_elementwise_max_activation", "max"},
+      {"fusion_elementwise_min_activation", "min"}};
+  if (GetAttrOr<bool>(op_info, "enable_int8", false) ||
+      !op_info.HasOutput("Out") || op_info.Output("Out").size() != 1) {
+    return false;
+  }
+  const auto& op_type = op_info.Type();
+  auto binary_op = binary_ops.find(op_type);
+  if (binary_op != binary_ops.end()) {
+    if (GetAttrOr<bool>(op_info, "fuse_scale", false) ||
+        !GetAttrOr<std::string>(op_info, "activation_type", "").empty()) {
+      return false;
+    }
+    auto x = op_info.Input("X").front();
+    auto y = op_info.Input("Y").front();
+    if (x == y || (x != x_name && y != x_name)) {
+      return false;
+    }
+    PointwiseStepDesc step;
+    step.type = binary_op->second;
+    step.operand = x == x_name ? y : x;
+    step.reversed = x != x_name;
+    step.axis = GetAttrOr<int>(op_info, "axis", -1);
+    if (!IsBroadcastInto(GetVarDims(scope, step.operand),
+                         GetVarDims(scope, x_name),
+                         step.axis)) {
+      return false;
+    }
+    steps->push_back(step);
+    if (op_info.HasAttr("act_type")) {
+      PointwiseStepDesc act_step;
+      if (!GetActivationStep(op_info,
+                             op_info.GetAttr<std::string>("act_type"),
+                             false,
+                             &act_step)) {
+        return false;
+      }
+      steps->push_back(act_step);
+    }
+    return true;
+  }
+  if (op_info.Input("X").size() != 1 || op_info.Input("X").front() != x_name) {
+    return false;
+  }
+  PointwiseStepDesc step;
+  if (op_type == "scale") {
+    if (HasTensorInput(op_info, "ScaleTensor") ||
+        GetAttrOr<bool>(op_info, "fuse_scaleact", false)) {
+      return false;
+    }
+    float scale = op_info.GetAttr<float>("scale");
+    float bias = op_info.GetAttr<float>("bias");
+    bool bias_after_scale =
+        GetAttrOr<bool>(op_info, "bias_after_scale", true);
+    step.type = "scale";
+    step.attrs[0] = scale;
+    step.attrs[1] = bias_after_scale ? bias : bias * scale;
+    steps->push_back(step);
+    auto act_type = GetAttrOr<std::string>(op_info, "activation_type", "");
+    if (!act_type.empty()) {
+      PointwiseStepDesc act_step;
+      if (!GetActivationStep(op_info, act_type, true, &act_step)) {
+        return false;
+      }
+      steps->push_back(act_step);
+    }
+    return true;
+  }
+  if (op_type == "clip") {
+    if (HasTensorInput(op_info, "Min") || HasTensorInput(op_info, "Max")) {
+      return false;
+    }
+    step.type = "clip";
+    step.attrs[0] = op_info.GetAttr<float>("min");
+    step.attrs[1] = op_info.GetAttr<float>("max");
+    steps->push_back(step);
+    return true;
+  }
+  if (!GetActivationStep(op_info, op_type, false, &step)) {
+    return false;
+  }
+  steps->push_back(step);
+  return true;
+}
+
+Node* FindArg(const std::list<Node*>& links, const std::string& name) {
+  for (auto* link : links) {
+    if (link->IsArg() && link->arg()->name == name) {
+      return link;
+    }
+  }
+  return nullptr;
+}
+
+// The var types are known if they are declared in the model, the chain only
+// takes the float tensors.
+bool IsFloatArg(Node* arg) {
+  return arg && (!arg->arg()->type ||
+                 arg->arg()->type->precision() == PRECISION(kFloat));
+}
+
+bool HasFloatOperands(Node* stmt,
+                      const std::vector<PointwiseStepDesc>& steps) {
+  for (auto& step : steps) {
+    if (!step.operand.empty() &&
+        !IsFloatArg(FindArg(stmt->inlinks, step.operand))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+struct PointwiseChain {
+  std::vector<Node*> stmts;
+  std::vector<Node*> intermediates;
+  Node* x{nullptr};
+  Node* out{nullptr};
+  std::vector<PointwiseStepDesc> steps;
+};
+
+void FuseChain(SSAGraph* graph, const PointwiseChain& chain) {
+  std::vector<std::string> operands;
+  std::vector<Node*> operand_nodes;
+  std::vector<std::string> step_types;
+  std::vector<int> step_operands;
+  std::vector<int> step_axes;
+  std::vector<int> step_reversed;
+  std::vector<float> step_attrs;
+  for (auto& step : chain.steps) {
+    int operand = -1;
+    if (!step.operand.empty()) {
+      auto it = std::find(operands.begin(), operands.end(), step.operand);
+      operand = static_cast<int>(it - operands.begin());
+      if (it == operands.end()) {
+        operands.push_back(step.operand);
+      }
+    }
+    step_types.push_back(step.type);
+    step_operands.push_back(operand);
+    step_axes.push_back(step.axis);
+    step_reversed.push_back(step.reversed ? 1 : 0);
+    step_attrs.insert(step_attrs.end(), step.attrs, step.attrs + 3);
+  }
+  for (auto& name : operands) {
+    for (auto* stmt : chain.stmts) {
+      auto* node = FindArg(stmt->inlinks, name);
+      if (node) {
+        operand_nodes.push_back(node);
+        break;
+      }
+    }
+  }
+  CHECK_EQ(operand_nodes.size(), operands.size());
+
+  cpp::OpDesc op_desc;
+  op_desc.SetType("fusion_pointwise_chain");
+  op_desc.SetInput("X", {chain.x->arg()->name});
+  op_desc.SetInput("Operands", operands);
+  op_desc.SetOutput("Out", {chain.out->arg()->name});
+  op_desc.SetAttr("step_types", step_types);
+  op_desc.SetAttr("step_operands", step_operands);
+  op_desc.SetAttr("step_axes", step_axes);
+  op_desc.SetAttr("step_reversed", step_reversed);
+  op_desc.SetAttr("step_attrs", step_attrs);
+
+  auto head_op = chain.stmts.front()->stmt()->op();
+  auto chain_op = LiteOpRegistry::Global().Create("fusion_pointwise_chain");
+  chain_op->Attach(op_desc, head_op->scope());
+  auto* chain_node =
+      graph->GraphCreateInstructNode(chain_op, head_op->valid_places());
+
+  std::set<const Node*> nodes_to_remove(chain.stmts.begin(),
+                                        chain.stmts.end());
+  nodes_to_remove.insert(chain.intermediates.begin(),
+                         chain.intermediates.end());
+  GraphSafeRemoveNodes(graph, nodes_to_remove);
+
+  IR_NODE_LINK_TO(chain.x, chain_node);
+  for (auto* node : operand_nodes) {
+    if (node != chain.x) {
+      IR_NODE_LINK_TO(node, chain_node);
+    }
+  }
+  IR_NODE_LINK_TO(chain_node, chain.out);
+}
+
+}  // namespace
+
+void PointwiseChainFusePass::Apply(const std::unique_ptr<SSAGraph>& graph) {
+  // fusion_pointwise_chain is only implemented on arm fp32
+  for (auto& place : graph->valid_places()) {
+    if (place.target != TARGET(kARM) && place.target != TARGET(kHost)) {
+      return;
+    }
+    if (place.precision == PRECISION(kInt8) ||
+        place.precision == PRECISION(kFP16)) {
+      return;
+    }
+  }
+
+  std::set<Node*> visited;
+  std::vector<PointwiseChain> chains;
+  for (auto* node : graph->StmtTopologicalOrder()) {
+    if (visited.count(node)) continue;
+    auto* op_info = node->stmt()->op_info();
+    if (!op_info->HasInput("X") || op_info->Input("X").empty()) continue;
+    PointwiseChain chain;
+    chain.x = FindArg(node->inlinks, op_info->Input("X").front());
+    auto* scope = node->stmt()->op()->scope();
+    if (!IsFloatArg(chain.x) ||
+        !GetPointwiseSteps(
+            *op_info, chain.x->arg()->name, scope, &chain.steps) ||
+        !HasFloatOperands(node, chain.steps)) {
+      continue;
+    }
+    chain.stmts.push_back(node);
+    Node* cur = node;
+    while (true) {
+      auto* out =
+          FindArg(cur->outlinks, cur->stmt()->op_info()->Output("Out").front());
+      chain.out = out;
+      if (!IsFloatArg(out) || out->arg()->is_weight ||
+          out->outlinks.size() != 1) {
+        break;
+      }
+      auto* next = out->outlinks.front();
+      if (!next->IsStmt() || visited.count(next)) break;
+      std::vector<PointwiseStepDesc> next_steps;
+      if (!GetPointwiseSteps(*next->stmt()->op_info(),
+                             out->arg()->name,
+                             next->stmt()->op()->scope(),
+                             &next_steps)) {
+        break;
+      }
+      if (!HasFloatOperands(next, next_steps)) break;
+      chain.steps.insert(
+          chain.steps.end(), next_steps.begin(), next_steps.end());
+      chain.stmts.push_back(next);
+      chain.intermediates.push_back(out);
+      cur = next;
+    }
+    if (chain.stmts.size() < 2 || !chain.out) continue;
+    visited.insert(chain.stmts.begin(), chain.stmts.end());
+    chains.push_back(chain);
+  }
+
+  for (auto& chain : chains) {
+    VLOG(4) << "fuse a chain of " << chain.stmts.size()
+            << " pointwise ops into fusion_pointwise_chain";
+    FuseChain(graph.get(), chain);
+  }
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_MIR_PASS(lite_pointwise_chain_fuse_pass,
+                  paddle::lite::mir::PointwiseChainFusePass)
+    .BindTargets({TARGET(kARM)})
+    .BindKernel("fusion_pointwise_chain");
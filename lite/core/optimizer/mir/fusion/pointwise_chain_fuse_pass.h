@@ -0,0 +1,43 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include "lite/core/optimizer/mir/pass.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+/*
+ * PointwiseChainFusePass collapses a chain of the pointwise ops, such as
+ * scale->elementwise_add->hard_swish->elementwise_mul, into one
+ * fusion_pointwise_chain op which runs all of the steps in one pass over
+ * memory.
+ *
+ * The chain follows the output of each op into the only consumer of it, the
+ * elementwise ops take the other input as a broadcast operand. The clip ops
+ * with the Min/Max tensors, the scale ops with the ScaleTensor and the int8
+ * ops end a chain.
+ */
+class PointwiseChainFusePass : public ProgramPass {
+ public:
+  void Apply(const std::unique_ptr<SSAGraph>& graph) override;
+};
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
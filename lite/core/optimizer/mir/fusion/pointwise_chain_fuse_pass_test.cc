@@ -0,0 +1,144 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/optimizer/mir/fusion/pointwise_chain_fuse_pass.h"
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+#include <vector>
+#include "lite/api/paddle_use_kernels.h"
+#include "lite/api/paddle_use_ops.h"
+#include "lite/api/paddle_use_passes.h"
+#include "lite/core/optimizer/mir/pass_test_helper.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+// Runs the fused and the unfused programs with the same random inputs, and
+// returns the op types of the fused one.
+std::vector<std::string> CheckPointwiseChain(
+    TestProgramBuilder* builder,
+    const std::vector<std::vector<int64_t>>& input_shapes) {
+  auto places = GetTestPlaces();
+  auto predictor = builder->Build(places);
+  auto reference =
+      builder->BuildWithout(places, {"lite_pointwise_chain_fuse_pass"});
+  std::mt19937 gen(0);
+  std::uniform_real_distribution<float> dis(-2.f, 2.f);
+  for (size_t i = 0; i < input_shapes.size(); i++) {
+    auto* input = predictor->GetInput(i);
+    auto* ref_input = reference->GetInput(i);
+    input->Resize(input_shapes[i]);
+    ref_input->Resize(input_shapes[i]);
+    auto* data = input->mutable_data<float>();
+    auto* ref_data = ref_input->mutable_data<float>();
+    for (int64_t j = 0; j < input->numel(); j++) {
+      data[j] = ref_data[j] = dis(gen);
+    }
+  }
+  predictor->Run();
+  reference->Run();
+  auto* out = predictor->GetOutput(0);
+  auto* ref_out = reference->GetOutput(0);
+  EXPECT_EQ(out->dims(), ref_out->dims());
+  for (int64_t i = 0; i < ref_out->numel(); i++) {
+    EXPECT_NEAR(out->data<float>()[i], ref_out->data<float>()[i], 1e-5);
+  }
+  return GetOpTypes(*predictor);
+}
+
+TEST(pointwise_chain_fuse_pass, fuse_chain) {
+  TestProgramBuilder builder;
+  builder.AddInput("x", {-1, 8, 4, 4});
+  builder.AddInput("y", {-1, 8, 4, 4});
+  builder.AddWeight("bias", {8});
+  builder.AddOp("relu", {{"X", {"x"}}}, {{"Out", {"relu_out"}}});
+  auto* scale = builder.AddOp(
+      "scale", {{"X", {"relu_out"}}}, {{"Out", {"scale_out"}}});
+  scale->SetAttr<float>("scale", 2.f);
+  scale->SetAttr<float>("bias", 0.5f);
+  scale->SetAttr<bool>("bias_after_scale", true);
+  auto* add = builder.AddOp("elementwise_add",
+                            {{"X", {"scale_out"}}, {"Y", {"bias"}}},
+                            {{"Out", {"add_out"}}});
+  add->SetAttr<int>("axis", 1);
+  auto* mul = builder.AddOp("elementwise_mul",
+                            {{"X", {"add_out"}}, {"Y", {"y"}}},
+                            {{"Out", {"mul_out"}}});
+  mul->SetAttr<int>("axis", -1);
+  builder.AddOp("sigmoid", {{"X", {"mul_out"}}}, {{"Out", {"out"}}});
+  for (auto& name : {"relu_out", "scale_out", "add_out", "mul_out", "out"}) {
+    builder.SetShape(name, {-1, 8, 4, 4});
+  }
+  builder.AddOutput("out");
+  auto types = CheckPointwiseChain(&builder, {{2, 8, 4, 4}, {2, 8, 4, 4}});
+  EXPECT_EQ(types, std::vector<std::string>{"fusion_pointwise_chain"});
+}
+
+// The scales of squeeze-and-excitation [N, C, 1, 1] multiply the feature map,
+// the chain of the scales must stop before the elementwise_mul, while the
+// chain of the feature map takes the scales as its operand.
+TEST(pointwise_chain_fuse_pass, squeeze_excitation) {
+  TestProgramBuilder builder;
+  builder.AddInput("feature", {-1, 8, 4, 4});
+  builder.AddInput("se", {-1, 8, 1, 1});
+  auto* hard_sigmoid = builder.AddOp(
+      "hard_sigmoid", {{"X", {"se"}}}, {{"Out", {"se_scale"}}});
+  hard_sigmoid->SetAttr<float>("slope", 0.2f);
+  hard_sigmoid->SetAttr<float>("offset", 0.5f);
+  auto* mul = builder.AddOp("elementwise_mul",
+                            {{"X", {"feature"}}, {"Y", {"se_scale"}}},
+                            {{"Out", {"mul_out"}}});
+  mul->SetAttr<int>("axis", -1);
+  builder.AddOp("relu", {{"X", {"mul_out"}}}, {{"Out", {"relu_out"}}});
+  auto* scale =
+      builder.AddOp("scale", {{"X", {"relu_out"}}}, {{"Out", {"out"}}});
+  scale->SetAttr<float>("scale", 0.5f);
+  scale->SetAttr<float>("bias", 0.f);
+  scale->SetAttr<bool>("bias_after_scale", true);
+  builder.SetShape("se_scale", {-1, 8, 1, 1});
+  for (auto& name : {"mul_out", "relu_out", "out"}) {
+    builder.SetShape(name, {-1, 8, 4, 4});
+  }
+  builder.AddOutput("out");
+  auto types = CheckPointwiseChain(&builder, {{2, 8, 4, 4}, {2, 8, 1, 1}});
+  EXPECT_EQ(types,
+            (std::vector<std::string>{"hard_sigmoid",
+                                      "fusion_pointwise_chain"}));
+}
+
+// The binary ops aren't fused if the shapes of the vars aren't declared, as
+// the broadcast is unknown.
+TEST(pointwise_chain_fuse_pass, unknown_shapes) {
+  TestProgramBuilder builder;
+  builder.AddInput("x");
+  builder.AddInput("y");
+  builder.AddOp("relu", {{"X", {"x"}}}, {{"Out", {"relu_out"}}});
+  auto* add = builder.AddOp("elementwise_add",
+                            {{"X", {"relu_out"}}, {"Y", {"y"}}},
+                            {{"Out", {"add_out"}}});
+  add->SetAttr<int>("axis", -1);
+  builder.AddOp("tanh", {{"X", {"add_out"}}}, {{"Out", {"tanh_out"}}});
+  builder.AddOp("sigmoid", {{"X", {"tanh_out"}}}, {{"Out", {"out"}}});
+  builder.AddOutput("out");
+  auto types = CheckPointwiseChain(&builder, {{2, 8, 4, 4}, {2, 8, 1, 1}});
+  EXPECT_EQ(types,
+            (std::vector<std::string>{
+                "relu", "elementwise_add", "fusion_pointwise_chain"}));
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,344 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/optimizer/mir/fusion/yolo_box_nms_fuse_pass.h"
+#include <list>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+#include "lite/core/optimizer/mir/pass_registry.h"
+#include "lite/core/optimizer/mir/pattern_matcher.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+namespace {
+
+template <typename T>
+T GetAttrOr(const OpInfo& op_info, const std::string& name, T value) {
+  return op_info.HasAttr(name) ? op_info.GetAttr<T>(name) : value;
+}
+
+bool HasTensorArg(const std::vector<std::string>& args) {
+  return !args.empty() && !args.front().empty();
+}
+
+Node* FindArg(const std::list<Node*>& links, const std::string& name) {
+  for (auto* link : links) {
+    if (link->IsArg() && link->arg()->name == name) {
+      return link;
+    }
+  }
+  return nullptr;
+}
+
+// The op which produces the var, if the var is only consumed by `consumer`.
+Node* GetSingleUseProducer(Node* arg, Node* consumer) {
+  if (!arg || arg->arg()->is_weight || arg->inlinks.size() != 1 ||
+      arg->outlinks.size() != 1 || arg->outlinks.front() != consumer) {
+    return nullptr;
+  }
+  auto* producer = arg->inlinks.front();
+  return producer->IsStmt() ? producer : nullptr;
+}
+
+struct YoloBoxNmsPattern {
+  Node* nms{nullptr};
+  std::vector<Node*> yolo_boxes;
+  // the ops and the vars between the yolo_box ops and the nms op
+  std::set<const Node*> intermediates;
+};
+
+// Gets the inputs of a concat op along `axis` of the 3-D tensors.
+bool GetConcatInputs(Node* concat,
+                     int axis,
+                     std::vector<Node*>* inputs,
+                     YoloBoxNmsPattern* pattern) {
+  if (!concat || concat->stmt()->op_type() != "concat") {
+    return false;
+  }
+  auto* op_info = concat->stmt()->op_info();
+  int concat_axis = GetAttrOr<int>(*op_info, "axis", 0);
+  if ((concat_axis != axis && concat_axis != axis - 3) ||
+      (op_info->HasInput("AxisTensor") &&
+       HasTensorArg(op_info->Input("AxisTensor"))) ||
+      GetAttrOr<bool>(*op_info, "enable_int8", false)) {
+    return false;
+  }
+  for (auto& name : op_info->Input("X")) {
+    auto* arg = FindArg(concat->inlinks, name);
+    if (!arg) return false;
+    inputs->push_back(arg);
+  }
+  pattern->intermediates.insert(concat);
+  return true;
+}
+
+// Matches transpose(axis=[0, 2, 1]) and returns its input, the unused XShape
+// of transpose2 is removed with the op.
+Node* GetTransposeInput(Node* transpose, YoloBoxNmsPattern* pattern) {
+  if (!transpose) return nullptr;
+  auto op_type = transpose->stmt()->op_type();
+  if (op_type != "transpose" && op_type != "transpose2") {
+    return nullptr;
+  }
+  auto* op_info = transpose->stmt()->op_info();
+  if (op_info->GetAttr<std::vector<int>>("axis") != std::vector<int>{0, 2, 1} ||
+      GetAttrOr<bool>(*op_info, "enable_int8", false)) {
+    return nullptr;
+  }
+  if (op_info->HasOutput("XShape") && HasTensorArg(op_info->Output("XShape"))) {
+    auto* xshape = FindArg(transpose->outlinks, op_info->Output("XShape")[0]);
+    if (!xshape || !xshape->outlinks.empty()) return nullptr;
+    pattern->intermediates.insert(xshape);
+  }
+  pattern->intermediates.insert(transpose);
+  return FindArg(transpose->inlinks, op_info->Input("X").front());
+}
+
+// Gets the yolo_box op which produces the output `output` of it.
+Node* GetYoloBox(Node* arg,
+                 Node* consumer,
+                 const std::string& output,
+                 YoloBoxNmsPattern* pattern) {
+  auto* yolo_box = GetSingleUseProducer(arg, consumer);
+  if (!yolo_box || yolo_box->stmt()->op_type() != "yolo_box" ||
+      yolo_box->stmt()->op_info()->Output(output).front() !=
+          arg->arg()->name) {
+    return nullptr;
+  }
+  pattern->intermediates.insert(arg);
+  return yolo_box;
+}
+
+bool GetYoloBoxesOfBoxes(Node* bboxes, YoloBoxNmsPattern* pattern) {
+  auto* concat = GetSingleUseProducer(bboxes, pattern->nms);
+  std::vector<Node*> inputs;
+  if (!GetConcatInputs(concat, 1, &inputs, pattern)) {
+    return false;
+  }
+  pattern->intermediates.insert(bboxes);
+  for (auto* input : inputs) {
+    auto* yolo_box = GetYoloBox(input, concat, "Boxes", pattern);
+    if (!yolo_box) return false;
+    pattern->yolo_boxes.push_back(yolo_box);
+  }
+  return true;
+}
+
+// The scores are [N, M, C] concatenated then transposed to [N, C, M], or
+// transposed then concatenated along the last axis.
+bool GetYoloBoxesOfScores(Node* scores,
+                          YoloBoxNmsPattern* pattern,
+                          std::vector<Node*>* yolo_boxes) {
+  auto* producer = GetSingleUseProducer(scores, pattern->nms);
+  if (!producer) return false;
+  pattern->intermediates.insert(scores);
+  std::vector<Node*> inputs;
+  std::vector<Node*> consumers;
+  if (producer->stmt()->op_type() == "concat") {
+    if (!GetConcatInputs(producer, 2, &inputs, pattern)) {
+      return false;
+    }
+    for (auto& input : inputs) {
+      auto* transpose = GetSingleUseProducer(input, producer);
+      auto* transpose_x = GetTransposeInput(transpose, pattern);
+      if (!transpose_x) return false;
+      pattern->intermediates.insert(input);
+      input = transpose_x;
+      consumers.push_back(transpose);
+    }
+  } else {
+    auto* transpose_x = GetTransposeInput(producer, pattern);
+    auto* concat = GetSingleUseProducer(transpose_x, producer);
+    if (!GetConcatInputs(concat, 1, &inputs, pattern)) {
+      return false;
+    }
+    pattern->intermediates.insert(transpose_x);
+    consumers.assign(inputs.size(), concat);
+  }
+  for (size_t i = 0; i < inputs.size(); i++) {
+    auto* yolo_box = GetYoloBox(inputs[i], consumers[i], "Scores", pattern);
+    if (!yolo_box) return false;
+    yolo_boxes->push_back(yolo_box);
+  }
+  return true;
+}
+
+bool MatchYoloBoxNms(Node* nms, YoloBoxNmsPattern* pattern) {
+  auto* op_info = nms->stmt()->op_info();
+  // The boxes of the cells below conf_thresh are zeros in yolo_box, they are
+  // never selected only if score_threshold is not negative.
+  if ((op_info->HasInput("RoisNum") &&
+       HasTensorArg(op_info->Input("RoisNum"))) ||
+      op_info->GetAttr<float>("score_threshold") < 0.f) {
+    return false;
+  }
+  pattern->nms = nms;
+  auto* bboxes = FindArg(nms->inlinks, op_info->Input("BBoxes").front());
+  auto* scores = FindArg(nms->inlinks, op_info->Input("Scores").front());
+  std::vector<Node*> score_yolo_boxes;
+  if (!GetYoloBoxesOfBoxes(bboxes, pattern) ||
+      !GetYoloBoxesOfScores(scores, pattern, &score_yolo_boxes) ||
+      score_yolo_boxes != pattern->yolo_boxes) {
+    return false;
+  }
+  // The heads share the image sizes and the attributes except the anchors
+  // and the downsample ratios.
+  auto* first = pattern->yolo_boxes.front()->stmt()->op_info();
+  for (auto* yolo_box : pattern->yolo_boxes) {
+    auto* yolo_info = yolo_box->stmt()->op_info();
+    if (yolo_info->Input("ImgSize") != first->Input("ImgSize") ||
+        yolo_info->GetAttr<int>("class_num") !=
+            first->GetAttr<int>("class_num") ||
+        yolo_info->GetAttr<float>("conf_thresh") !=
+            first->GetAttr<float>("conf_thresh") ||
+        GetAttrOr<bool>(*yolo_info, "clip_bbox", true) !=
+            GetAttrOr<bool>(*first, "clip_bbox", true) ||
+        GetAttrOr<float>(*yolo_info, "scale_x_y", 1.f) !=
+            GetAttrOr<float>(*first, "scale_x_y", 1.f)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void FuseYoloBoxNms(SSAGraph* graph, const YoloBoxNmsPattern& pattern) {
+  auto* nms_info = pattern.nms->stmt()->op_info();
+  auto* first = pattern.yolo_boxes.front()->stmt()->op_info();
+  std::vector<std::string> x_names;
+  std::vector<Node*> x_nodes;
+  std::vector<int> anchors;
+  std::vector<int> anchor_nums;
+  std::vector<int> downsample_ratios;
+  for (auto* yolo_box : pattern.yolo_boxes) {
+    auto* yolo_info = yolo_box->stmt()->op_info();
+    auto x_name = yolo_info->Input("X").front();
+    x_names.push_back(x_name);
+    x_nodes.push_back(FindArg(yolo_box->inlinks, x_name));
+    auto head_anchors = yolo_info->GetAttr<std::vector<int>>("anchors");
+    anchors.insert(anchors.end(), head_anchors.begin(), head_anchors.end());
+    anchor_nums.push_back(static_cast<int>(head_anchors.size() / 2));
+    downsample_ratios.push_back(yolo_info->GetAttr<int>("downsample_ratio"));
+  }
+  auto img_size_name = first->Input("ImgSize").front();
+  auto* img_size =
+      FindArg(pattern.yolo_boxes.front()->inlinks, img_size_name);
+
+  cpp::OpDesc op_desc;
+  op_desc.SetType("fusion_yolo_box_nms");
+  op_desc.SetInput("X", x_names);
+  op_desc.SetInput("ImgSize", {img_size_name});
+  std::vector<Node*> out_nodes;
+  for (const std::string output : {"Out", "Index", "NmsRoisNum"}) {
+    if (nms_info->HasOutput(output) &&
+        HasTensorArg(nms_info->Output(output))) {
+      auto name = nms_info->Output(output).front();
+      op_desc.SetOutput(output, {name});
+      out_nodes.push_back(FindArg(pattern.nms->outlinks, name));
+    }
+  }
+  op_desc.SetAttr("anchors", anchors);
+  op_desc.SetAttr("anchor_nums", anchor_nums);
+  op_desc.SetAttr("downsample_ratios", downsample_ratios);
+  op_desc.SetAttr("class_num", first->GetAttr<int>("class_num"));
+  op_desc.SetAttr("conf_thresh", first->GetAttr<float>("conf_thresh"));
+  op_desc.SetAttr("clip_bbox", GetAttrOr<bool>(*first, "clip_bbox", true));
+  op_desc.SetAttr("scale_x_y", GetAttrOr<float>(*first, "scale_x_y", 1.f));
+  op_desc.SetAttr("background_label",
+                  nms_info->GetAttr<int>("background_label"));
+  op_desc.SetAttr("score_threshold",
+                  nms_info->GetAttr<float>("score_threshold"));
+  op_desc.SetAttr("nms_top_k", nms_info->GetAttr<int>("nms_top_k"));
+  op_desc.SetAttr("nms_threshold", nms_info->GetAttr<float>("nms_threshold"));
+  op_desc.SetAttr("nms_eta", nms_info->GetAttr<float>("nms_eta"));
+  op_desc.SetAttr("keep_top_k", nms_info->GetAttr<int>("keep_top_k"));
+  op_desc.SetAttr("normalized",
+                  GetAttrOr<bool>(*nms_info, "normalized", true));
+
+  auto nms_op = pattern.nms->stmt()->op();
+  auto fused_op = LiteOpRegistry::Global().Create("fusion_yolo_box_nms");
+  fused_op->Attach(op_desc, nms_op->scope());
+  auto* fused_node =
+      graph->GraphCreateInstructNode(fused_op, nms_op->valid_places());
+
+  std::set<const Node*> nodes_to_remove(pattern.intermediates);
+  nodes_to_remove.insert(pattern.nms);
+  nodes_to_remove.insert(pattern.yolo_boxes.begin(),
+                         pattern.yolo_boxes.end());
+  GraphSafeRemoveNodes(graph, nodes_to_remove);
+
+  std::set<Node*> linked;
+  for (auto* x : x_nodes) {
+    if (linked.insert(x).second) {
+      IR_NODE_LINK_TO(x, fused_node);
+    }
+  }
+  IR_NODE_LINK_TO(img_size, fused_node);
+  for (auto* out : out_nodes) {
+    IR_NODE_LINK_TO(fused_node, out);
+  }
+}
+
+}  // namespace
+
+void YoloBoxNmsFusePass::Apply(const std::unique_ptr<SSAGraph>& graph) {
+  // fusion_yolo_box_nms is only implemented on host fp32, yolo_box has the
+  // fp16 kernels on arm.
+  for (auto& place : graph->valid_places()) {
+    if (place.target != TARGET(kARM) && place.target != TARGET(kX86) &&
+        place.target != TARGET(kHost)) {
+      return;
+    }
+    if (place.precision == PRECISION(kInt8) ||
+        place.precision == PRECISION(kFP16)) {
+      return;
+    }
+  }
+
+  std::vector<YoloBoxNmsPattern> patterns;
+  std::set<const Node*> matched;
+  for (auto* node : graph->StmtTopologicalOrder()) {
+    auto op_type = node->stmt()->op_type();
+    if (op_type != "multiclass_nms" && op_type != "multiclass_nms2" &&
+        op_type != "multiclass_nms3") {
+      continue;
+    }
+    YoloBoxNmsPattern pattern;
+    if (!MatchYoloBoxNms(node, &pattern)) continue;
+    bool overlapped = false;
+    for (auto* yolo_box : pattern.yolo_boxes) {
+      overlapped = overlapped || !matched.insert(yolo_box).second;
+    }
+    if (overlapped) continue;
+    patterns.push_back(pattern);
+  }
+
+  for (auto& pattern : patterns) {
+    VLOG(4) << "fuse " << pattern.yolo_boxes.size()
+            << " yolo_box ops and multiclass_nms into fusion_yolo_box_nms";
+    FuseYoloBoxNms(graph.get(), pattern);
+  }
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_MIR_PASS(lite_yolo_box_nms_fuse_pass,
+                  paddle::lite::mir::YoloBoxNmsFusePass)
+    .BindTargets({TARGET(kARM), TARGET(kX86)})
+    .BindKernel("fusion_yolo_box_nms");
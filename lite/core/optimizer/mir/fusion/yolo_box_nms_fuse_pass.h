@@ -0,0 +1,48 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include "lite/core/optimizer/mir/pass.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+/*
+ * YoloBoxNmsFusePass fuses the post-processing of the YOLO detectors, such
+ * as YOLOv3 and PP-YOLO, into one fusion_yolo_box_nms op:
+ *
+ *   yolo_box(head 0) ... yolo_box(head n-1)
+ *       |Boxes                 |Scores
+ *   concat(axis=1)         concat(axis=1)
+ *       |                      |
+ *       |                  transpose2([0, 2, 1])
+ *       |BBoxes                |Scores
+ *            multiclass_nms/2/3
+ *
+ * The scores may also be transposed before they are concatenated along the
+ * last axis. The intermediate boxes and scores are never materialized, only
+ * the cells above conf_thresh are decoded.
+ */
+class YoloBoxNmsFusePass : public ProgramPass {
+ public:
+  void Apply(const std::unique_ptr<SSAGraph>& graph) override;
+};
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
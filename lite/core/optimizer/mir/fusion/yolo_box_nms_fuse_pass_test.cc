@@ -0,0 +1,238 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/optimizer/mir/fusion/yolo_box_nms_fuse_pass.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+#include "lite/api/paddle_use_kernels.h"
+#include "lite/api/paddle_use_ops.h"
+#include "lite/api/paddle_use_passes.h"
+#include "lite/backends/host/math/yolo_box.h"
+#include "lite/core/optimizer/mir/pass_test_helper.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+struct YoloHead {
+  int64_t height;
+  int64_t width;
+  std::vector<int> anchors;
+  int downsample_ratio;
+};
+
+struct YoloBoxNmsCase {
+  std::string nms_type;
+  // The scores are transposed before the concat, or after it.
+  bool transpose_first;
+  float conf_thresh;
+  float score_threshold;
+};
+
+const int kBatch = 2;
+const int kClassNum = 3;
+const std::vector<YoloHead> kHeads{{8, 8, {10, 13, 16, 30, 33, 23}, 8},
+                                   {4, 4, {30, 61, 62, 45, 59, 119}, 16}};
+
+void BuildYoloBoxNms(TestProgramBuilder* builder, const YoloBoxNmsCase& c) {
+  for (size_t i = 0; i < kHeads.size(); i++) {
+    builder->AddInput("x" + std::to_string(i));
+  }
+  builder->AddInput("img_size");
+  std::vector<std::string> boxes;
+  std::vector<std::string> scores;
+  for (size_t i = 0; i < kHeads.size(); i++) {
+    auto id = std::to_string(i);
+    auto* yolo_box = builder->AddOp(
+        "yolo_box",
+        {{"X", {"x" + id}}, {"ImgSize", {"img_size"}}},
+        {{"Boxes", {"boxes" + id}}, {"Scores", {"scores" + id}}});
+    yolo_box->SetAttr<std::vector<int>>("anchors", kHeads[i].anchors);
+    yolo_box->SetAttr<int>("class_num", kClassNum);
+    yolo_box->SetAttr<float>("conf_thresh", c.conf_thresh);
+    yolo_box->SetAttr<int>("downsample_ratio", kHeads[i].downsample_ratio);
+    yolo_box->SetAttr<bool>("clip_bbox", true);
+    yolo_box->SetAttr<float>("scale_x_y", 1.05f);
+    boxes.push_back("boxes" + id);
+    scores.push_back("scores" + id);
+  }
+  auto add_transpose = [&](const std::string& x, const std::string& out) {
+    auto* transpose = builder->AddOp(
+        "transpose2",
+        {{"X", {x}}},
+        {{"Out", {out}}, {"XShape", {out + "_xshape"}}});
+    transpose->SetAttr<std::vector<int>>("axis", {0, 2, 1});
+  };
+  auto add_concat = [&](const std::vector<std::string>& x,
+                        const std::string& out,
+                        int axis) {
+    builder->AddOp("concat", {{"X", x}}, {{"Out", {out}}})
+        ->SetAttr<int>("axis", axis);
+  };
+  add_concat(boxes, "boxes", 1);
+  if (c.transpose_first) {
+    std::vector<std::string> transposed;
+    for (auto& name : scores) {
+      add_transpose(name, name + "_t");
+      transposed.push_back(name + "_t");
+    }
+    add_concat(transposed, "scores", 2);
+  } else {
+    add_concat(scores, "scores_concat", 1);
+    add_transpose("scores_concat", "scores");
+  }
+  std::map<std::string, std::vector<std::string>> outputs{
+      {"Out", {"out"}}, {"Index", {"index"}}};
+  if (c.nms_type == "multiclass_nms3") {
+    outputs["NmsRoisNum"] = {"nms_rois_num"};
+  }
+  auto* nms = builder->AddOp(
+      c.nms_type, {{"BBoxes", {"boxes"}}, {"Scores", {"scores"}}}, outputs);
+  nms->SetAttr<int>("background_label", -1);
+  nms->SetAttr<float>("score_threshold", c.score_threshold);
+  nms->SetAttr<int>("nms_top_k", 40);
+  nms->SetAttr<float>("nms_threshold", 0.45f);
+  nms->SetAttr<float>("nms_eta", 1.f);
+  nms->SetAttr<int>("keep_top_k", 30);
+  nms->SetAttr<bool>("normalized", false);
+  builder->AddOutput("out");
+  builder->AddOutput("index");
+  if (c.nms_type == "multiclass_nms3") {
+    builder->AddOutput("nms_rois_num");
+  }
+}
+
+// Fills the heads with the random logits, and puts the objectness logits at
+// and around the logit of conf_thresh and the bound of the prefilter of the
+// logits into every third cell.
+void FeedYoloBoxNms(const std::vector<Predictor*>& predictors,
+                    float conf_thresh) {
+  std::mt19937 gen(0);
+  std::uniform_real_distribution<float> dis(-3.f, 3.f);
+  const float inf = std::numeric_limits<float>::infinity();
+  std::vector<float> boundaries;
+  if (conf_thresh > 0.f) {
+    float logit = std::log(conf_thresh / (1.f - conf_thresh));
+    float bound = lite::host::math::YoloConfLogitBound(conf_thresh);
+    for (float v : {logit, bound}) {
+      boundaries.push_back(v);
+      boundaries.push_back(std::nextafter(v, -inf));
+      boundaries.push_back(std::nextafter(v, inf));
+    }
+  }
+  for (size_t i = 0; i < kHeads.size(); i++) {
+    auto& head = kHeads[i];
+    const int64_t an_num = head.anchors.size() / 2;
+    const int64_t stride = head.height * head.width;
+    std::vector<float> x(kBatch * an_num * (5 + kClassNum) * stride);
+    for (auto& v : x) v = dis(gen);
+    if (!boundaries.empty()) {
+      for (int64_t a = 0; a < kBatch * an_num; a++) {
+        float* obj = x.data() + (a * (5 + kClassNum) + 4) * stride;
+        for (int64_t hw = 0; hw < stride; hw += 3) {
+          obj[hw] = boundaries[(a + hw) % boundaries.size()];
+        }
+      }
+    }
+    for (auto* predictor : predictors) {
+      auto* input = predictor->GetInput(i);
+      input->Resize({kBatch, an_num * (5 + kClassNum), head.height,
+                     head.width});
+      std::copy(x.begin(), x.end(), input->mutable_data<float>());
+    }
+  }
+  for (auto* predictor : predictors) {
+    auto* img_size = predictor->GetInput(kHeads.size());
+    img_size->Resize({kBatch, 2});
+    auto* data = img_size->mutable_data<int>();
+    data[0] = 416;
+    data[1] = 416;
+    data[2] = 320;
+    data[3] = 480;
+  }
+}
+
+void CheckYoloBoxNms(const YoloBoxNmsCase& c) {
+  TestProgramBuilder builder;
+  BuildYoloBoxNms(&builder, c);
+  auto places = GetTestPlaces();
+  auto predictor = builder.Build(places);
+  auto reference =
+      builder.BuildWithout(places, {"lite_yolo_box_nms_fuse_pass"});
+  ASSERT_EQ(GetOpTypes(*predictor),
+            std::vector<std::string>{"fusion_yolo_box_nms"});
+  FeedYoloBoxNms({predictor.get(), reference.get()}, c.conf_thresh);
+  predictor->Run();
+  reference->Run();
+
+  auto* out = predictor->GetOutput(0);
+  auto* ref_out = reference->GetOutput(0);
+  ASSERT_EQ(out->dims(), ref_out->dims());
+  ASSERT_EQ(out->lod(), ref_out->lod());
+  EXPECT_GT(ref_out->dims()[0], 1);
+  for (int64_t i = 0; i < ref_out->numel(); i++) {
+    EXPECT_NEAR(out->data<float>()[i], ref_out->data<float>()[i], 1e-4)
+        << c.nms_type << ", index " << i;
+  }
+  auto* index = predictor->GetOutput(1);
+  auto* ref_index = reference->GetOutput(1);
+  ASSERT_EQ(index->dims(), ref_index->dims());
+  for (int64_t i = 0; i < ref_index->numel(); i++) {
+    EXPECT_EQ(index->data<int>()[i], ref_index->data<int>()[i]);
+  }
+  if (c.nms_type == "multiclass_nms3") {
+    auto* rois_num = predictor->GetOutput(2);
+    auto* ref_rois_num = reference->GetOutput(2);
+    ASSERT_EQ(rois_num->numel(), ref_rois_num->numel());
+    for (int64_t i = 0; i < ref_rois_num->numel(); i++) {
+      EXPECT_EQ(rois_num->data<int>()[i], ref_rois_num->data<int>()[i]);
+    }
+  }
+}
+
+TEST(yolo_box_nms_fuse_pass, compare_with_unfused) {
+  const std::vector<YoloBoxNmsCase> cases{
+      {"multiclass_nms2", false, 0.3f, 0.05f},
+      {"multiclass_nms3", true, 0.3f, 0.05f},
+      // The cells below conf_thresh are zero scores, which aren't selected
+      // by the score threshold 0 either.
+      {"multiclass_nms2", true, 0.3f, 0.f},
+      {"multiclass_nms3", false, 0.01f, 0.f},
+      // No prefilter of the logits.
+      {"multiclass_nms3", true, 0.f, 0.f},
+  };
+  for (auto& c : cases) {
+    CheckYoloBoxNms(c);
+  }
+}
+
+// The negative score threshold selects the zero boxes of the cells below
+// conf_thresh, so the ops are left unfused.
+TEST(yolo_box_nms_fuse_pass, negative_score_threshold) {
+  TestProgramBuilder builder;
+  BuildYoloBoxNms(&builder, {"multiclass_nms3", false, 0.3f, -1.f});
+  auto predictor = builder.Build(GetTestPlaces());
+  auto types = GetOpTypes(*predictor);
+  EXPECT_EQ(std::count(types.begin(), types.end(), "fusion_yolo_box_nms"), 0);
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
@@ -105,6 +105,8 @@ void MemoryOptimizePass::CollectLifeCycleByDevice(
 
   // Collect the invalid input and output variables that will not be reused.
   std::set<std::string> invalid_var_names;
+  // The views and the variables viewed by them.
+  std::map<std::string, std::string> view_sources;
   for (auto& op_node : graph->StmtTopologicalOrder()) {
     // variables of invalid_op_nodes wil not be reused
     if (!op_node->IsStmt()) continue;
@@ -122,36 +124,50 @@ void MemoryOptimizePass::CollectLifeCycleByDevice(
       }
       continue;
     }
-    // The specified input and output variables of the Ops whose 'inplace' attr
-    // is true will not be reused, such as reshape/reshape2's X and Out
-    // variables
-    std::map<std::string,
-             std::pair<std::set<std::string>, std::set<std::string>>>
-        inplace_op_nodes = {{"reshape", {{"X"}, {"Out"}}},
-                            {"reshape2", {{"X"}, {"Out"}}},
-                            {"flatten", {{"X"}, {"Out"}}},
-                            {"flatten2", {{"X"}, {"Out"}}},
-                            {"squeeze", {{"X"}, {"Out"}}},
-                            {"squeeze2", {{"X"}, {{"Out"}, {"XShape"}}}},
-                            {"unsqueeze", {{"X"}, {"Out"}}},
-                            {"unsqueeze2", {{"X"}, {{"Out"}, {"XShape"}}}}};
+    // The outputs of the Ops whose 'inplace' attr is true are the views of
+    // their inputs, such as reshape/reshape2's Out of X, the views are not
+    // reused and their lifetimes are added to the viewed variables below.
+    // squeeze2/unsqueeze2's XShape is not reused either.
+    std::map<std::string, std::string> inplace_op_nodes = {
+        {"reshape", "X"},
+        {"reshape2", "X"},
+        {"flatten", "X"},
+        {"flatten2", "X"},
+        {"squeeze", "X"},
+        {"squeeze2", "X"},
+        {"unsqueeze", "X"},
+        {"unsqueeze2", "X"},
+        {"slice", "Input"},
+        {"split", "X"}};
     auto inplace_op_node = inplace_op_nodes.find(op_type);
     if (inplace_op_node != inplace_op_nodes.end()) {
       bool inplace = false;
       if (op_info->HasAttr("inplace")) {
         inplace = op_info->GetAttr<bool>("inplace");
       }
-      if (inplace) {
-        for (auto& in_param_name : inplace_op_node->second.first) {
-          const auto& in_arg_names = op_info->Input(in_param_name);
-          invalid_var_names.insert(in_arg_names.begin(), in_arg_names.end());
+      const auto& in_arg_names = op_info->Input(inplace_op_node->second);
+      if (inplace && !in_arg_names.empty()) {
+        for (auto& out_arg_name : op_info->Output("Out")) {
+          invalid_var_names.insert(out_arg_name);
+          view_sources[out_arg_name] = in_arg_names.front();
         }
-        for (auto& out_param_name : inplace_op_node->second.second) {
-          const auto& out_arg_names = op_info->Output(out_param_name);
-          invalid_var_names.insert(out_arg_names.begin(), out_arg_names.end());
+        if ((op_type == "squeeze2" || op_type == "unsqueeze2") &&
+            op_info->HasOutput("XShape")) {
+          const auto& xshape_names = op_info->Output("XShape");
+          invalid_var_names.insert(xshape_names.begin(), xshape_names.end());
         }
       }
     }
+    // The inputs of the in-place concat are the views of its output, which
+    // are written by their producers directly.
+    if (op_type == "concat" && op_info->HasAttr("inplace") &&
+        op_info->GetAttr<bool>("inplace")) {
+      const auto& out_arg_names = op_info->Output("Out");
+      for (auto& in_arg_name : op_info->Input("X")) {
+        invalid_var_names.insert(in_arg_name);
+        view_sources[in_arg_name] = out_arg_names.front();
+      }
+    }
   }
 
   // non-tensor(like tensor_array) variables will not be reused
@@ -162,6 +178,8 @@ void MemoryOptimizePass::CollectLifeCycleByDevice(
     }
   }
 
+  // The first and the last uses of the views.
+  std::map<std::string, std::pair<int, int>> view_uses;
   for (auto& op_node : graph->StmtTopologicalOrder()) {
     if (op_node->IsStmt()) {
       std::vector<Node*> var_nodes(op_node->inlinks.begin(),
@@ -173,6 +191,12 @@ void MemoryOptimizePass::CollectLifeCycleByDevice(
         auto& arg = var_node->AsArg();
         if (arg.is_weight || arg.is_persist) continue;
         std::string var_name = arg.name;
+        if (view_sources.count(var_name)) {
+          if (!view_uses.count(var_name)) {
+            view_uses[var_name].first = max_lifecycle_;
+          }
+          view_uses[var_name].second = max_lifecycle_;
+        }
         if (invalid_var_names.count(var_name)) continue;
         TargetType target_type = arg.type->target();
         if (is_host(target_type)) target_type = TARGET(kHost);
@@ -190,6 +214,22 @@ void MemoryOptimizePass::CollectLifeCycleByDevice(
       ++max_lifecycle_;
     }
   }
+
+  // The viewed variables live from the first use of their views until the
+  // last one, the views of the concat output are written before it.
+  for (auto& view : view_uses) {
+    std::string source = view.first;
+    while (view_sources.count(source)) {
+      source = view_sources.at(source);
+    }
+    for (auto& lifecycle : *lifecycles) {
+      auto it = lifecycle.second.find(source);
+      if (it != lifecycle.second.end()) {
+        it->second.first = (std::min)(it->second.first, view.second.first);
+        it->second.second = (std::max)(it->second.second, view.second.second);
+      }
+    }
+  }
   LOG(INFO) << "There are " << (*lifecycles).size() << " types device var.";
 }
 
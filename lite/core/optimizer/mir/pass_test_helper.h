@@ -0,0 +1,199 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include "lite/api/cxx_api.h"
+#include "lite/core/program.h"
+#include "lite/core/scope.h"
+#include "lite/model_parser/cpp_desc.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+// Builds a program manually for the pass tests. The inputs are fed and the
+// outputs are fetched by the orders they are added, so the inputs must be
+// added before the ops, and the outputs after them. Every predictor is built
+// from the copies of the program and the weights, as the passes modify them.
+class TestProgramBuilder {
+ public:
+  TestProgramBuilder()
+      : program_desc_(std::make_shared<cpp::ProgramDesc>()),
+        scope_(std::make_shared<Scope>()) {
+    block_desc_ = program_desc_->AddBlock<cpp::BlockDesc>();
+    block_desc_->ClearOps();
+    block_desc_->ClearVars();
+  }
+
+  // Adds a float var, which isn't persistable.
+  void AddVar(const std::string& name) {
+    auto* var_desc = block_desc_->AddVar<cpp::VarDesc>();
+    var_desc->SetName(name);
+    var_desc->SetType(VarDescAPI::Type::LOD_TENSOR);
+    var_desc->SetPersistable(false);
+    var_descs_[name] = var_desc;
+  }
+
+  // Sets the shape of the var desc, which the passes take as the dims of the
+  // var as the ones of a real model.
+  void SetShape(const std::string& name, const std::vector<int64_t>& shape) {
+    CHECK(var_descs_.count(name)) << "No var " << name;
+    var_descs_[name]->SetShape(shape);
+  }
+
+  // Adds a var fed by the col-th feed op.
+  void AddInput(const std::string& name,
+                const std::vector<int64_t>& shape = {}) {
+    AddVar(name);
+    SetShape(name, shape);
+    auto* op_desc = block_desc_->AddOp<cpp::OpDesc>();
+    op_desc->SetType("feed");
+    op_desc->SetInput("X", {"feed"});
+    op_desc->SetOutput("Out", {name});
+    op_desc->SetAttr<int>("col", num_inputs_++);
+  }
+
+  // Adds the persistable float weights filled with the values, or with the
+  // random values in [-1, 1] if the values are empty.
+  Tensor* AddWeight(const std::string& name,
+                    const std::vector<int64_t>& shape,
+                    const std::vector<float>& values = {}) {
+    auto* var_desc = block_desc_->AddVar<cpp::VarDesc>();
+    var_desc->SetName(name);
+    var_desc->SetType(VarDescAPI::Type::LOD_TENSOR);
+    var_desc->SetPersistable(true);
+    weight_names_.push_back(name);
+    auto* tensor = scope_->Var(name)->GetMutable<Tensor>();
+    tensor->Resize(shape);
+    tensor->set_persistable(true);
+    auto* data = tensor->mutable_data<float>();
+    std::uniform_real_distribution<float> dis(-1.f, 1.f);
+    for (int64_t i = 0; i < tensor->numel(); i++) {
+      data[i] = values.empty() ? dis(gen_) : values[i];
+    }
+    return tensor;
+  }
+
+  // Adds an op whose outputs are added as the vars.
+  cpp::OpDesc* AddOp(
+      const std::string& type,
+      const std::map<std::string, std::vector<std::string>>& inputs,
+      const std::map<std::string, std::vector<std::string>>& outputs) {
+    for (auto& output : outputs) {
+      for (auto& name : output.second) {
+        AddVar(name);
+      }
+    }
+    auto* op_desc = block_desc_->AddOp<cpp::OpDesc>();
+    op_desc->SetType(type);
+    for (auto& input : inputs) {
+      op_desc->SetInput(input.first, input.second);
+    }
+    for (auto& output : outputs) {
+      op_desc->SetOutput(output.first, output.second);
+    }
+    return op_desc;
+  }
+
+  // Adds the col-th fetch op of the var.
+  void AddOutput(const std::string& name) {
+    auto* op_desc = block_desc_->AddOp<cpp::OpDesc>();
+    op_desc->SetType("fetch");
+    op_desc->SetInput("X", {name});
+    op_desc->SetOutput("Out", {"fetch"});
+    op_desc->SetAttr<int>("col", num_outputs_++);
+  }
+
+  // Builds a predictor of the program, which runs the default passes.
+  std::unique_ptr<Predictor> Build(const std::vector<Place>& valid_places) {
+    std::unique_ptr<Predictor> predictor(new Predictor(CloneScope()));
+    predictor->Build(std::make_shared<cpp::ProgramDesc>(*program_desc_),
+                     valid_places);
+    return predictor;
+  }
+
+  // Builds a predictor without the passes under test, to compute the
+  // references of the outputs.
+  std::unique_ptr<Predictor> BuildWithout(
+      const std::vector<Place>& valid_places,
+      const std::vector<std::string>& discarded_passes) {
+    lite_api::CxxConfig config;
+    for (auto& pass : discarded_passes) {
+      config.add_discarded_pass(pass);
+    }
+    std::unique_ptr<Predictor> predictor(new Predictor(CloneScope()));
+    predictor->Build(std::make_shared<cpp::ProgramDesc>(*program_desc_),
+                     valid_places,
+                     {},
+                     config);
+    return predictor;
+  }
+
+  Scope* scope() { return scope_.get(); }
+  // The program desc, e.g. to build the graphs for the passes directly.
+  const cpp::ProgramDesc& program_desc() const { return *program_desc_; }
+
+ private:
+  std::shared_ptr<Scope> CloneScope() {
+    auto scope = std::make_shared<Scope>();
+    for (auto& name : weight_names_) {
+      auto* tensor = scope->Var(name)->GetMutable<Tensor>();
+      tensor->CopyDataFrom(scope_->FindVar(name)->Get<Tensor>());
+      tensor->set_persistable(true);
+    }
+    return scope;
+  }
+
+  std::shared_ptr<cpp::ProgramDesc> program_desc_;
+  std::shared_ptr<Scope> scope_;
+  cpp::BlockDesc* block_desc_{nullptr};
+  std::vector<std::string> weight_names_;
+  std::map<std::string, cpp::VarDesc*> var_descs_;
+  int num_inputs_{0};
+  int num_outputs_{0};
+  std::mt19937 gen_{2021};
+};
+
+// The op types of the runtime program in order, without the feed and fetch.
+inline std::vector<std::string> GetOpTypes(const Predictor& predictor) {
+  std::vector<std::string> types;
+  for (auto& inst : predictor.runtime_program().instructions()) {
+    auto type = inst.op()->op_info()->Type();
+    if (type != "feed" && type != "fetch") {
+      types.push_back(type);
+    }
+  }
+  return types;
+}
+
+// The default places of the tests on the targets.
+inline std::vector<Place> GetTestPlaces() {
+#ifdef LITE_WITH_ARM
+  return {Place{TARGET(kARM), PRECISION(kFloat)},
+          Place{TARGET(kHost), PRECISION(kFloat)}};
+#else
+  return {Place{TARGET(kX86), PRECISION(kFloat)},
+          Place{TARGET(kHost), PRECISION(kFloat)}};
+#endif
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
@@ -13,12 +13,16 @@
 // limitations under the License.
 //
 // This pass intends to improve the latency performance of the convolutional
-// operations with the kernel size of 1x1. In practice, the pass requires the
-// convolutional weights to be sparse. And, the sparser the weights
-// are, the more latency improvement we would potentially obtain.
+// operations with the kernel size of 1x1, and the fc, mul and matmul with
+// constant weights. In practice, the pass requires the weights to be sparse.
+// And, the sparser the weights are, the more latency improvement we would
+// potentially obtain. The unstructured, block and N:M formats are chosen by
+// the estimated speedup.
 
 #include "lite/core/optimizer/mir/sparse_conv_detect_pass.h"
 #include <math.h>
+#include <string.h>
+#include <algorithm>
 #include <list>
 #include <memory>
 #include <string>
@@ -370,192 +374,606 @@ void SparseConvDetectPass::CopyOutputScaleFromOpInfo(cpp::OpDesc* op_desc,
   }
 }
 
-void SparseConvDetectPass::Apply(const std::unique_ptr<SSAGraph>& graph) {
-  for (auto& node : graph->StmtTopologicalOrder()) {
-    if (node->IsStmt() && node->AsStmt().op_type() == "conv2d") {
-      auto* scope = node->stmt()->op()->scope();
-      auto conv_op_desc = node->stmt()->mutable_op_info();
-      auto x = conv_op_desc->Input("Input").front();
-      auto w = conv_op_desc->Input("Filter").front();
-      auto y = conv_op_desc->Output("Output").front();
-      auto x_tensor = scope->FindVar(x)->Get<lite::Tensor>();
-      auto w_tensor = scope->FindVar(w)->Get<lite::Tensor>();
-      auto x_dims = x_tensor.dims();
-      auto weight_dims = w_tensor.dims();
-      auto groups = conv_op_desc->GetAttr<int>("groups");
-      auto strides = conv_op_desc->GetAttr<std::vector<int>>("strides");
-      auto paddings = conv_op_desc->GetAttr<std::vector<int>>("paddings");
-      auto ch_out = weight_dims[0];
-      auto ch_in = weight_dims[1] * groups;
-      auto kh = weight_dims[2];
-      auto kw = weight_dims[3];
-      auto im_size = x_dims[2] * x_dims[3];
-      int weight_num = ch_out * ch_in * kh * kw;
-      bool use_int8 = (w_tensor.precision() == PrecisionType::kInt8);
-      bool use_fp32 = (w_tensor.precision() == PrecisionType::kFloat);
-      if (!(use_int8 || use_fp32)) {
-        VLOG(4) << "The sparse conv detect pass now only support fp32 and int8";
-        continue;
-      }
-      if (!(kw == 1 && kh == 1)) {
-        VLOG(4) << "The kernel size of the supported sparse conv must be 1x1";
-        continue;
-      }
-      if (groups != 1) {
-        VLOG(4) << "The groups of the supported sparse conv must be 1";
-        continue;
-      }
-      if (!(strides[0] == 1 && strides[1] == 1)) {
-        VLOG(4) << "The strides of the supported sparse conv must be 1";
-        continue;
-      }
-      if (!(paddings[0] == 0 && paddings[1] == 0)) {
-        VLOG(4) << "The paddings of the supported sparse conv must be 0";
-        continue;
-      }
-      int zero_num;
-      int num_build_nonzeroes = 0;
-      if (use_fp32) {
-        zero_num = ComputeSparseZeros<float>(
-            &w_tensor, &num_build_nonzeroes, ch_out, ch_in);
-      } else if (use_int8) {
-        zero_num = ComputeSparseZeros<int8_t>(&w_tensor, weight_num);
-      }
-      int nonzero_num = weight_num - zero_num;
-      VLOG(4) << "zero_num: " << zero_num << "weight_num: " << weight_num;
-      float sparse_zero_percent =
-          static_cast<float>(zero_num) / static_cast<float>(weight_num);
-      VLOG(4) << "sparse zero num percent: " << sparse_zero_percent;
-      if (sparse_zero_percent < sparse_threshold_) {
-        VLOG(4) << "The sparse degree of the sparse conv must be greater than "
-                   "sparse_threshold: "
-                << sparse_threshold_;
-        continue;
-      }
-      auto nonzeros_output_name =
-          string_format("%s_nonzeros_output", w.c_str());
-      auto oc_nonzeros_name = string_format("%s_oc_nonzeros", w.c_str());
-      auto ic_diffs_name = string_format("%s_ic_diffs", w.c_str());
-      auto* nonzeros_output_arg = graph->NewArgumentNode(nonzeros_output_name);
-      auto* oc_nonzeros_arg = graph->NewArgumentNode(oc_nonzeros_name);
-      auto* ic_diffs_arg = graph->NewArgumentNode(ic_diffs_name);
-      nonzeros_output_arg->AsArg().is_persist = true;
-      nonzeros_output_arg->AsArg().is_weight = true;
-      oc_nonzeros_arg->AsArg().is_persist = true;
-      oc_nonzeros_arg->AsArg().is_weight = true;
-      ic_diffs_arg->AsArg().is_persist = true;
-      ic_diffs_arg->AsArg().is_weight = true;
-
-      auto* nonzeros_output_t =
-          scope->Var(nonzeros_output_name)->GetMutable<Tensor>();
-      auto* oc_nonzeros_t = scope->Var(oc_nonzeros_name)->GetMutable<Tensor>();
-      auto* ic_diffs_t = scope->Var(ic_diffs_name)->GetMutable<Tensor>();
-      if (use_fp32) {
-        nonzeros_output_t->Resize({num_build_nonzeroes});
-        oc_nonzeros_t->Resize({ch_out});
-        ic_diffs_t->Resize({num_build_nonzeroes});
-      } else if (use_int8) {
-        nonzeros_output_t->Resize({nonzero_num});
-        oc_nonzeros_t->Resize({ch_out});
-        ic_diffs_t->Resize({nonzero_num});
-      }
-      int first_ic;
-      if (use_fp32) {
-        first_ic = ComputeSparseWeight<float>(&w_tensor,
-                                              ch_out,
-                                              ch_in,
-                                              im_size,
-                                              nonzero_num,
-                                              num_build_nonzeroes,
-                                              nonzeros_output_t,
-                                              oc_nonzeros_t,
-                                              ic_diffs_t);
-      } else if (use_int8) {
-        first_ic = ComputeSparseWeight<int8_t>(&w_tensor,
-                                               ch_out,
-                                               ch_in,
-                                               im_size,
-                                               nonzero_num,
-                                               nonzeros_output_t,
-                                               oc_nonzeros_t,
-                                               ic_diffs_t);
+namespace {
+
+// The efficiency of the sparse kernels relative to the dense gemm per useful
+// MAC. The conv kernels are vectorized along the spatial size while the fc
+// kernels are vectorized along the rows of the blocks, so the block shape
+// matters more for fc. For the N:M format, block_h and block_w are N and M.
+struct SparseKernelEfficiency {
+  operators::SparseFormat format;
+  int block_h;
+  int block_w;
+  float conv;
+  float fc;
+};
+
+const SparseKernelEfficiency kSparseKernels[] = {
+    {operators::SparseFormat::kUnstructured, 1, 1, 0.45f, 0.f},
+    {operators::SparseFormat::kBlock, 1, 4, 0.55f, 0.45f},
+    {operators::SparseFormat::kBlock, 4, 1, 0.7f, 0.55f},
+    {operators::SparseFormat::kBlock, 4, 4, 0.85f, 0.7f},
+    {operators::SparseFormat::kNM, 2, 4, 0.5f, 0.25f},
+};
+
+// The dense gemm with AVX2 and FMA is relatively faster than the sparse
+// kernels on x86.
+const float kX86EfficiencyScale = 0.8f;
+
+// The sparse op is only used when it's estimated faster enough than the dense.
+const float kMinSparseSpeedup = 1.1f;
+
+int64_t CountNonzeroBlocks(
+    const float* weights, int M, int K, int block_h, int block_w) {
+  int64_t num_blocks = 0;
+  for (int br = 0; br < M / block_h; br++) {
+    for (int bc = 0; bc < K / block_w; bc++) {
+      bool nonzero = false;
+      for (int i = 0; i < block_h && !nonzero; i++) {
+        const float* row = weights + (br * block_h + i) * K + bc * block_w;
+        for (int j = 0; j < block_w; j++) {
+          if (row[j] != 0.f) {
+            nonzero = true;
+            break;
+          }
+        }
       }
-      VLOG(4) << "zero_num: " << zero_num << " weight_num: " << weight_num
-              << " first_ic: " << first_ic;
-      nonzeros_output_t->set_persistable(true);
-      oc_nonzeros_t->set_persistable(true);
-      ic_diffs_t->set_persistable(true);
-      if (use_fp32)
-        nonzeros_output_t->set_precision(PRECISION(kFloat));
-      else if (use_int8)
-        nonzeros_output_t->set_precision(PRECISION(kInt8));
-      oc_nonzeros_t->set_precision(PRECISION(kInt32));
-      ic_diffs_t->set_precision(PRECISION(kInt32));
-      auto sparse_conv2d_op = LiteOpRegistry::Global().Create("sparse_conv2d");
-      cpp::OpDesc op_desc;
-      op_desc.SetType("sparse_conv2d");
-      op_desc.SetInput("Input", {x});
-      op_desc.SetInput("NonZeroWeights", {nonzeros_output_name});
-      op_desc.SetInput("OcNonZeros", {oc_nonzeros_name});
-      op_desc.SetInput("Diffs", {ic_diffs_name});
-      bool has_bias = conv_op_desc->HasInput("Bias") &&
-                      conv_op_desc->Input("Bias").size() > 0;
-      if (has_bias) {
-        auto b = conv_op_desc->Input("Bias").front();
-        op_desc.SetInput("Bias", {b});
+      num_blocks += nonzero ? 1 : 0;
+    }
+  }
+  return num_blocks;
+}
+
+bool IsNMSparse(const float* weights, int M, int K, int nm_n, int nm_m) {
+  for (int i = 0; i < M; i++) {
+    for (int g = 0; g < K / nm_m; g++) {
+      const float* group = weights + i * K + g * nm_m;
+      int nonzeros = 0;
+      for (int j = 0; j < nm_m; j++) {
+        nonzeros += group[j] != 0.f ? 1 : 0;
       }
-      op_desc.SetOutput("Output", {y});
-      if (use_int8) {
-        if (!(conv_op_desc->HasAttr("enable_int8")))
-          conv_op_desc->SetAttr<bool>("enable_int8", true);
-        else if (conv_op_desc->GetAttr<bool>("enable_int8") == false)
-          conv_op_desc->SetAttr<bool>("enable_int8", true);
+      if (nonzeros > nm_n) {
+        return false;
       }
-      // copy attributes
-      std::vector<std::string> attr_names = conv_op_desc->AttrNames();
-      for (size_t i = 0; i < attr_names.size(); i++) {
-        if (conv_op_desc->HasAttr(attr_names[i])) {
-          CopyAttrFromOpInfo(&op_desc, conv_op_desc, attr_names[i]);
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+SparseConvDetectPass::SparseCandidate SparseConvDetectPass::SelectSparseFormat(
+    const float* weights,
+    const int M,
+    const int K,
+    const bool is_fc,
+    const bool on_x86,
+    const int num_build_nonzeroes) {
+  SparseCandidate best;
+  const float dense_macs = static_cast<float>(M) * K;
+  for (auto& kernel : kSparseKernels) {
+    float efficiency = is_fc ? kernel.fc : kernel.conv;
+    int64_t stored = 0;
+    switch (kernel.format) {
+      case operators::SparseFormat::kUnstructured:
+        // Only the 1x1 conv kernel on arm supports the unstructured format
+        if (is_fc || on_x86) continue;
+        stored = num_build_nonzeroes;
+        break;
+      case operators::SparseFormat::kBlock:
+        if (M % kernel.block_h != 0 || K % kernel.block_w != 0) continue;
+        stored =
+            CountNonzeroBlocks(weights, M, K, kernel.block_h, kernel.block_w) *
+            kernel.block_h * kernel.block_w;
+        break;
+      case operators::SparseFormat::kNM:
+        if (K % kernel.block_w != 0 ||
+            !IsNMSparse(weights, M, K, kernel.block_h, kernel.block_w)) {
+          continue;
         }
-      }
-      // Copy inputs/outputs scales
-      if (conv_op_desc->HasAttr("enable_int8")) {
-        CopyInputScaleFromOpInfo(&op_desc, conv_op_desc, "Input0_scale");
-        CopyInputScaleFromOpInfo(&op_desc, conv_op_desc, "Filter0_scale");
-        CopyOutputScaleFromOpInfo(&op_desc, conv_op_desc, "Output0_scale");
-      }
+        stored = static_cast<int64_t>(M) * K / kernel.block_w * kernel.block_h;
+        break;
+    }
+    if (on_x86) {
+      efficiency *= kX86EfficiencyScale;
+    }
+    float speedup = efficiency * dense_macs /
+                    static_cast<float>(std::max<int64_t>(stored, 1));
+    VLOG(4) << "sparse format " << static_cast<int>(kernel.format) << " "
+            << kernel.block_h << "x" << kernel.block_w
+            << " estimated speedup: " << speedup;
+    if (speedup > best.speedup) {
+      best.format = kernel.format;
+      best.block_h = kernel.block_h;
+      best.block_w = kernel.block_w;
+      best.speedup = speedup;
+    }
+  }
+  return best;
+}
 
-      op_desc.SetAttr<int>("first_ic", first_ic);
-      sparse_conv2d_op->Attach(op_desc, node->stmt()->op()->scope());
-      auto* sparse_op_node = graph->GraphCreateInstructNode(
-          sparse_conv2d_op, graph->valid_places());
-      for (auto iter = node->inlinks.begin(); iter != node->inlinks.end();) {
-        auto it =
-            std::find((*iter)->outlinks.begin(), (*iter)->outlinks.end(), node);
-        if (it != (*iter)->outlinks.end()) {
-          (*iter)->outlinks.erase(it);
+void SparseConvDetectPass::ComputeBlockSparseWeight(
+    const float* weights,
+    const int M,
+    const int K,
+    const int block_h,
+    const int block_w,
+    lite::Tensor* nonzero_output_tensor,
+    lite::Tensor* row_ptr_tensor,
+    lite::Tensor* col_idx_tensor) {
+  const int block_rows = M / block_h;
+  const int block_cols = K / block_w;
+  std::vector<float> values;
+  std::vector<int32_t> col_idx;
+  row_ptr_tensor->Resize({block_rows + 1});
+  auto* row_ptr = row_ptr_tensor->mutable_data<uint32_t>();
+  row_ptr[0] = 0;
+  for (int br = 0; br < block_rows; br++) {
+    for (int bc = 0; bc < block_cols; bc++) {
+      const float* block = weights + br * block_h * K + bc * block_w;
+      bool nonzero = false;
+      for (int i = 0; i < block_h && !nonzero; i++) {
+        for (int j = 0; j < block_w; j++) {
+          if (block[i * K + j] != 0.f) {
+            nonzero = true;
+            break;
+          }
         }
-        bool is_weight = (*iter)->IsArg() && (*iter)->AsArg().is_weight;
-        if (!is_weight) {
-          DirectedLink(*iter, sparse_op_node);
-        } else {
-          graph->RemoveNode((*iter));
+      }
+      if (!nonzero) continue;
+      col_idx.push_back(bc * block_w);
+      for (int j = 0; j < block_w; j++) {
+        for (int i = 0; i < block_h; i++) {
+          values.push_back(block[i * K + j]);
         }
-        iter = node->inlinks.erase(iter);
       }
-      DirectedLink(nonzeros_output_arg, sparse_op_node);
-      DirectedLink(oc_nonzeros_arg, sparse_op_node);
-      DirectedLink(ic_diffs_arg, sparse_op_node);
-      for (auto iter = node->outlinks.begin(); iter != node->outlinks.end();) {
-        DirectedLink(sparse_op_node, *iter);
-        auto it =
-            std::find((*iter)->inlinks.begin(), (*iter)->inlinks.end(), node);
-        if (it != (*iter)->inlinks.end()) {
-          (*iter)->inlinks.erase(it);
+    }
+    row_ptr[br + 1] = col_idx.size();
+  }
+  // Keep the tensors non-empty even if all the weights are zero
+  values.resize(std::max<size_t>(values.size(), block_h * block_w), 0.f);
+  col_idx.resize(std::max<size_t>(col_idx.size(), 1), 0);
+  nonzero_output_tensor->Resize({static_cast<int64_t>(values.size())});
+  col_idx_tensor->Resize({static_cast<int64_t>(col_idx.size())});
+  memcpy(nonzero_output_tensor->mutable_data<float>(),
+         values.data(),
+         values.size() * sizeof(float));
+  memcpy(col_idx_tensor->mutable_data<int32_t>(),
+         col_idx.data(),
+         col_idx.size() * sizeof(int32_t));
+}
+
+void SparseConvDetectPass::ComputeNMSparseWeight(
+    const float* weights,
+    const int M,
+    const int K,
+    const int nm_n,
+    const int nm_m,
+    lite::Tensor* nonzero_output_tensor,
+    lite::Tensor* row_ptr_tensor,
+    lite::Tensor* col_idx_tensor) {
+  const int groups = K / nm_m;
+  const int row_nonzeros = groups * nm_n;
+  nonzero_output_tensor->Resize({M * row_nonzeros});
+  col_idx_tensor->Resize({M * row_nonzeros});
+  row_ptr_tensor->Resize({M + 1});
+  auto* values = nonzero_output_tensor->mutable_data<float>();
+  auto* col_idx = col_idx_tensor->mutable_data<int32_t>();
+  auto* row_ptr = row_ptr_tensor->mutable_data<uint32_t>();
+  for (int i = 0; i <= M; i++) {
+    row_ptr[i] = i * row_nonzeros;
+  }
+  for (int i = 0; i < M; i++) {
+    for (int g = 0; g < groups; g++) {
+      const int k0 = g * nm_m;
+      int t = 0;
+      for (int j = 0; j < nm_m; j++) {
+        if (weights[i * K + k0 + j] != 0.f) {
+          *values++ = weights[i * K + k0 + j];
+          *col_idx++ = k0 + j;
+          t++;
         }
-        iter = node->outlinks.erase(iter);
       }
-      graph->RemoveNode(node);
+      // The zero-padded values read the first input channel of the group
+      for (; t < nm_n; t++) {
+        *values++ = 0.f;
+        *col_idx++ = k0;
+      }
+    }
+  }
+}
+
+std::vector<Node*> SparseConvDetectPass::CreateSparseWeightNodes(
+    const std::unique_ptr<SSAGraph>& graph,
+    Scope* scope,
+    const std::string& weight_name,
+    std::vector<lite::Tensor*>* tensors) {
+  std::vector<std::string> names{
+      string_format("%s_nonzeros_output", weight_name.c_str()),
+      string_format("%s_oc_nonzeros", weight_name.c_str()),
+      string_format("%s_ic_diffs", weight_name.c_str())};
+  std::vector<Node*> nodes;
+  tensors->clear();
+  for (auto& name : names) {
+    auto* arg = graph->NewArgumentNode(name);
+    arg->AsArg().is_persist = true;
+    arg->AsArg().is_weight = true;
+    nodes.push_back(arg);
+    auto* tensor = scope->Var(name)->GetMutable<Tensor>();
+    tensor->set_persistable(true);
+    tensors->push_back(tensor);
+  }
+  return nodes;
+}
+
+void SparseConvDetectPass::ReplaceWithSparseOp(
+    const std::unique_ptr<SSAGraph>& graph,
+    Node* node,
+    Node* sparse_op_node,
+    const std::string& weight_name,
+    const std::vector<Node*>& sparse_weight_nodes) {
+  auto inlinks = node->inlinks;
+  for (auto* in : inlinks) {
+    RemoveDirectedLink(in, node);
+    if (in->IsArg() && in->AsArg().name == weight_name) {
+      if (in->outlinks.empty()) {
+        graph->RemoveNode(in);
+      }
+      continue;
+    }
+    DirectedLink(in, sparse_op_node);
+  }
+  for (auto* weight_node : sparse_weight_nodes) {
+    DirectedLink(weight_node, sparse_op_node);
+  }
+  auto outlinks = node->outlinks;
+  for (auto* out : outlinks) {
+    RemoveDirectedLink(node, out);
+    DirectedLink(sparse_op_node, out);
+  }
+  graph->RemoveNode(node);
+}
+
+void SparseConvDetectPass::DetectSparseConv(
+    const std::unique_ptr<SSAGraph>& graph, Node* node, const bool on_x86) {
+  auto* scope = node->stmt()->op()->scope();
+  auto conv_op_desc = node->stmt()->mutable_op_info();
+  auto x = conv_op_desc->Input("Input").front();
+  auto w = conv_op_desc->Input("Filter").front();
+  auto y = conv_op_desc->Output("Output").front();
+  auto x_tensor = scope->FindVar(x)->Get<lite::Tensor>();
+  auto w_tensor = scope->FindVar(w)->Get<lite::Tensor>();
+  auto x_dims = x_tensor.dims();
+  auto weight_dims = w_tensor.dims();
+  auto groups = conv_op_desc->GetAttr<int>("groups");
+  auto strides = conv_op_desc->GetAttr<std::vector<int>>("strides");
+  auto paddings = conv_op_desc->GetAttr<std::vector<int>>("paddings");
+  auto ch_out = weight_dims[0];
+  auto ch_in = weight_dims[1] * groups;
+  auto kh = weight_dims[2];
+  auto kw = weight_dims[3];
+  auto im_size = x_dims[2] * x_dims[3];
+  int weight_num = ch_out * ch_in * kh * kw;
+  bool use_int8 = (w_tensor.precision() == PrecisionType::kInt8);
+  bool use_fp32 = (w_tensor.precision() == PrecisionType::kFloat);
+  if (!(use_int8 || use_fp32)) {
+    VLOG(4) << "The sparse conv detect pass now only support fp32 and int8";
+    return;
+  }
+  if (use_int8 && on_x86) {
+    VLOG(4) << "The int8 sparse conv is not supported on x86";
+    return;
+  }
+  if (!(kw == 1 && kh == 1)) {
+    VLOG(4) << "The kernel size of the supported sparse conv must be 1x1";
+    return;
+  }
+  if (groups != 1) {
+    VLOG(4) << "The groups of the supported sparse conv must be 1";
+    return;
+  }
+  if (!(strides[0] == 1 && strides[1] == 1)) {
+    VLOG(4) << "The strides of the supported sparse conv must be 1";
+    return;
+  }
+  if (!(paddings[0] == 0 && paddings[1] == 0)) {
+    VLOG(4) << "The paddings of the supported sparse conv must be 0";
+    return;
+  }
+  int zero_num;
+  int num_build_nonzeroes = 0;
+  if (use_fp32) {
+    zero_num = ComputeSparseZeros<float>(
+        &w_tensor, &num_build_nonzeroes, ch_out, ch_in);
+  } else if (use_int8) {
+    zero_num = ComputeSparseZeros<int8_t>(&w_tensor, weight_num);
+  }
+  int nonzero_num = weight_num - zero_num;
+  VLOG(4) << "zero_num: " << zero_num << "weight_num: " << weight_num;
+  float sparse_zero_percent =
+      static_cast<float>(zero_num) / static_cast<float>(weight_num);
+  VLOG(4) << "sparse zero num percent: " << sparse_zero_percent;
+  if (sparse_zero_percent < sparse_threshold_) {
+    VLOG(4) << "The sparse degree of the sparse conv must be greater than "
+               "sparse_threshold: "
+            << sparse_threshold_;
+    return;
+  }
+  SparseCandidate candidate;
+  if (use_fp32) {
+    candidate = SelectSparseFormat(w_tensor.data<float>(),
+                                   ch_out,
+                                   ch_in,
+                                   false,
+                                   on_x86,
+                                   num_build_nonzeroes);
+    if (candidate.speedup < kMinSparseSpeedup) {
+      VLOG(4) << "The estimated speedup of the sparse conv "
+              << candidate.speedup << " is less than " << kMinSparseSpeedup;
+      return;
+    }
+  }
+
+  std::vector<lite::Tensor*> sparse_tensors;
+  auto sparse_weight_nodes =
+      CreateSparseWeightNodes(graph, scope, w, &sparse_tensors);
+  auto* nonzeros_output_t = sparse_tensors[0];
+  auto* oc_nonzeros_t = sparse_tensors[1];
+  auto* ic_diffs_t = sparse_tensors[2];
+  int first_ic = 0;
+  if (candidate.format == operators::SparseFormat::kBlock) {
+    ComputeBlockSparseWeight(w_tensor.data<float>(),
+                             ch_out,
+                             ch_in,
+                             candidate.block_h,
+                             candidate.block_w,
+                             nonzeros_output_t,
+                             oc_nonzeros_t,
+                             ic_diffs_t);
+  } else if (candidate.format == operators::SparseFormat::kNM) {
+    ComputeNMSparseWeight(w_tensor.data<float>(),
+                          ch_out,
+                          ch_in,
+                          candidate.block_h,
+                          candidate.block_w,
+                          nonzeros_output_t,
+                          oc_nonzeros_t,
+                          ic_diffs_t);
+  } else if (use_fp32) {
+    nonzeros_output_t->Resize({num_build_nonzeroes});
+    oc_nonzeros_t->Resize({ch_out});
+    ic_diffs_t->Resize({num_build_nonzeroes});
+    first_ic = ComputeSparseWeight<float>(&w_tensor,
+                                          ch_out,
+                                          ch_in,
+                                          im_size,
+                                          nonzero_num,
+                                          num_build_nonzeroes,
+                                          nonzeros_output_t,
+                                          oc_nonzeros_t,
+                                          ic_diffs_t);
+  } else if (use_int8) {
+    nonzeros_output_t->Resize({nonzero_num});
+    oc_nonzeros_t->Resize({ch_out});
+    ic_diffs_t->Resize({nonzero_num});
+    first_ic = ComputeSparseWeight<int8_t>(&w_tensor,
+                                           ch_out,
+                                           ch_in,
+                                           im_size,
+                                           nonzero_num,
+                                           nonzeros_output_t,
+                                           oc_nonzeros_t,
+                                           ic_diffs_t);
+  }
+  // The precisions are set after the packing, as mutable_data<uint32_t>()
+  // resets them to kUnk, which can't be saved.
+  nonzeros_output_t->set_precision(use_int8 ? PRECISION(kInt8)
+                                            : PRECISION(kFloat));
+  oc_nonzeros_t->set_precision(PRECISION(kInt32));
+  ic_diffs_t->set_precision(PRECISION(kInt32));
+  VLOG(4) << "zero_num: " << zero_num << " weight_num: " << weight_num
+          << " first_ic: " << first_ic;
+  auto sparse_conv2d_op = LiteOpRegistry::Global().Create("sparse_conv2d");
+  cpp::OpDesc op_desc;
+  op_desc.SetType("sparse_conv2d");
+  op_desc.SetInput("Input", {x});
+  op_desc.SetInput("NonZeroWeights",
+                   {sparse_weight_nodes[0]->AsArg().name});
+  op_desc.SetInput("OcNonZeros", {sparse_weight_nodes[1]->AsArg().name});
+  op_desc.SetInput("Diffs", {sparse_weight_nodes[2]->AsArg().name});
+  bool has_bias =
+      conv_op_desc->HasInput("Bias") && conv_op_desc->Input("Bias").size() > 0;
+  if (has_bias) {
+    auto b = conv_op_desc->Input("Bias").front();
+    op_desc.SetInput("Bias", {b});
+  }
+  op_desc.SetOutput("Output", {y});
+  if (use_int8) {
+    if (!(conv_op_desc->HasAttr("enable_int8")))
+      conv_op_desc->SetAttr<bool>("enable_int8", true);
+    else if (conv_op_desc->GetAttr<bool>("enable_int8") == false)
+      conv_op_desc->SetAttr<bool>("enable_int8", true);
+  }
+  // copy attributes
+  std::vector<std::string> attr_names = conv_op_desc->AttrNames();
+  for (size_t i = 0; i < attr_names.size(); i++) {
+    if (conv_op_desc->HasAttr(attr_names[i])) {
+      CopyAttrFromOpInfo(&op_desc, conv_op_desc, attr_names[i]);
+    }
+  }
+  // Copy inputs/outputs scales
+  if (conv_op_desc->HasAttr("enable_int8")) {
+    CopyInputScaleFromOpInfo(&op_desc, conv_op_desc, "Input0_scale");
+    CopyInputScaleFromOpInfo(&op_desc, conv_op_desc, "Filter0_scale");
+    CopyOutputScaleFromOpInfo(&op_desc, conv_op_desc, "Output0_scale");
+  }
+
+  op_desc.SetAttr<int>("first_ic", first_ic);
+  op_desc.SetAttr<int>("sparse_format", static_cast<int>(candidate.format));
+  if (candidate.format == operators::SparseFormat::kBlock) {
+    op_desc.SetAttr<int>("block_h", candidate.block_h);
+    op_desc.SetAttr<int>("block_w", candidate.block_w);
+  } else if (candidate.format == operators::SparseFormat::kNM) {
+    op_desc.SetAttr<int>("nm_n", candidate.block_h);
+    op_desc.SetAttr<int>("nm_m", candidate.block_w);
+  }
+  sparse_conv2d_op->Attach(op_desc, scope);
+  auto* sparse_op_node =
+      graph->GraphCreateInstructNode(sparse_conv2d_op, graph->valid_places());
+  ReplaceWithSparseOp(graph, node, sparse_op_node, w, sparse_weight_nodes);
+}
+
+void SparseConvDetectPass::DetectSparseFc(
+    const std::unique_ptr<SSAGraph>& graph, Node* node, const bool on_x86) {
+  auto* scope = node->stmt()->op()->scope();
+  auto op_info = node->stmt()->mutable_op_info();
+  auto op_type = op_info->Type();
+  std::string x, w, y, act_type;
+  int in_num_col_dims = 1;
+  bool trans_w = false;
+  if (op_info->HasAttr("enable_int8") &&
+      op_info->GetAttr<bool>("enable_int8")) {
+    return;
+  }
+  if (op_type == "fc") {
+    x = op_info->Input("Input").front();
+    w = op_info->Input("W").front();
+    y = op_info->Output("Out").front();
+    in_num_col_dims = op_info->GetAttr<int>("in_num_col_dims");
+    if (op_info->HasAttr("activation_type")) {
+      act_type = op_info->GetAttr<std::string>("activation_type");
+    }
+    if (op_info->HasAttr("padding_weights") &&
+        op_info->GetAttr<bool>("padding_weights")) {
+      return;
+    }
+    if (!act_type.empty() && act_type != "relu") {
+      VLOG(4) << "The sparse fc only supports fuse with relu";
+      return;
+    }
+  } else if (op_type == "mul") {
+    x = op_info->Input("X").front();
+    w = op_info->Input("Y").front();
+    y = op_info->Output("Out").front();
+    in_num_col_dims = op_info->GetAttr<int>("x_num_col_dims");
+    if (op_info->GetAttr<int>("y_num_col_dims") != 1) return;
+  } else {
+    x = op_info->Input("X").front();
+    w = op_info->Input("Y").front();
+    y = op_info->Output("Out").front();
+    bool is_v2 = op_type == "matmul_v2";
+    bool trans_x = op_info->GetAttr<bool>(is_v2 ? "trans_x" : "transpose_X");
+    trans_w = op_info->GetAttr<bool>(is_v2 ? "trans_y" : "transpose_Y");
+    float alpha =
+        op_info->HasAttr("alpha") ? op_info->GetAttr<float>("alpha") : 1.f;
+    if (trans_x || fabs(alpha - 1.f) > 1e-6f) return;
+    in_num_col_dims = -1;
+  }
+  auto* w_var = scope->FindVar(w);
+  if (w_var == nullptr) return;
+  const auto& w_tensor = w_var->Get<lite::Tensor>();
+  if (!w_tensor.persistable() || w_tensor.dims().size() != 2 ||
+      w_tensor.precision() != PrecisionType::kFloat) {
+    return;
+  }
+  const int K = trans_w ? w_tensor.dims()[1] : w_tensor.dims()[0];
+  const int M = trans_w ? w_tensor.dims()[0] : w_tensor.dims()[1];
+  // The sparse weights are [out_features, in_features]
+  std::vector<float> weights(M * K);
+  const float* w_data = w_tensor.data<float>();
+  int zero_num = 0;
+  for (int i = 0; i < M; i++) {
+    for (int j = 0; j < K; j++) {
+      float value = trans_w ? w_data[i * K + j] : w_data[j * M + i];
+      weights[i * K + j] = value;
+      zero_num += value == 0.f ? 1 : 0;
+    }
+  }
+  float sparse_zero_percent =
+      static_cast<float>(zero_num) / static_cast<float>(M * K);
+  VLOG(4) << op_type << " sparse zero num percent: " << sparse_zero_percent;
+  if (sparse_zero_percent < sparse_threshold_) {
+    return;
+  }
+  auto candidate =
+      SelectSparseFormat(weights.data(), M, K, true, on_x86, M * K - zero_num);
+  if (candidate.speedup < kMinSparseSpeedup) {
+    VLOG(4) << "The estimated speedup of the sparse " << op_type << " "
+            << candidate.speedup << " is less than " << kMinSparseSpeedup;
+    return;
+  }
+
+  std::vector<lite::Tensor*> sparse_tensors;
+  auto sparse_weight_nodes =
+      CreateSparseWeightNodes(graph, scope, w, &sparse_tensors);
+  if (candidate.format == operators::SparseFormat::kBlock) {
+    ComputeBlockSparseWeight(weights.data(),
+                             M,
+                             K,
+                             candidate.block_h,
+                             candidate.block_w,
+                             sparse_tensors[0],
+                             sparse_tensors[1],
+                             sparse_tensors[2]);
+  } else {
+    ComputeNMSparseWeight(weights.data(),
+                          M,
+                          K,
+                          candidate.block_h,
+                          candidate.block_w,
+                          sparse_tensors[0],
+                          sparse_tensors[1],
+                          sparse_tensors[2]);
+  }
+  sparse_tensors[0]->set_precision(PRECISION(kFloat));
+  sparse_tensors[1]->set_precision(PRECISION(kInt32));
+  sparse_tensors[2]->set_precision(PRECISION(kInt32));
+
+  auto sparse_fc_op = LiteOpRegistry::Global().Create("sparse_fc");
+  cpp::OpDesc op_desc;
+  op_desc.SetType("sparse_fc");
+  op_desc.SetInput("Input", {x});
+  op_desc.SetInput("NonZeroWeights", {sparse_weight_nodes[0]->AsArg().name});
+  op_desc.SetInput("OcNonZeros", {sparse_weight_nodes[1]->AsArg().name});
+  op_desc.SetInput("Diffs", {sparse_weight_nodes[2]->AsArg().name});
+  if (op_type == "fc" && op_info->HasInput("Bias") &&
+      !op_info->Input("Bias").empty()) {
+    op_desc.SetInput("Bias", {op_info->Input("Bias").front()});
+  }
+  op_desc.SetOutput("Out", {y});
+  op_desc.SetAttr<int>("in_num_col_dims", in_num_col_dims);
+  op_desc.SetAttr<int>("in_features", K);
+  op_desc.SetAttr<int>("out_features", M);
+  op_desc.SetAttr<std::string>("activation_type", act_type);
+  op_desc.SetAttr<int>("sparse_format", static_cast<int>(candidate.format));
+  if (candidate.format == operators::SparseFormat::kBlock) {
+    op_desc.SetAttr<int>("block_h", candidate.block_h);
+    op_desc.SetAttr<int>("block_w", candidate.block_w);
+  } else {
+    op_desc.SetAttr<int>("nm_n", candidate.block_h);
+    op_desc.SetAttr<int>("nm_m", candidate.block_w);
+  }
+  sparse_fc_op->Attach(op_desc, scope);
+  auto* sparse_op_node =
+      graph->GraphCreateInstructNode(sparse_fc_op, graph->valid_places());
+  ReplaceWithSparseOp(graph, node, sparse_op_node, w, sparse_weight_nodes);
+}
+
+void SparseConvDetectPass::Apply(const std::unique_ptr<SSAGraph>& graph) {
+  bool on_x86 = false;
+  for (auto& place : graph->valid_places()) {
+    if (place.target == TARGET(kX86)) {
+      on_x86 = true;
+    }
+  }
+  for (auto& node : graph->StmtTopologicalOrder()) {
+    if (!node->IsStmt()) continue;
+    auto op_type = node->AsStmt().op_type();
+    if (op_type == "conv2d") {
+      DetectSparseConv(graph, node, on_x86);
+    } else if (op_type == "fc" || op_type == "mul" || op_type == "matmul" ||
+               op_type == "matmul_v2") {
+      DetectSparseFc(graph, node, on_x86);
     }
   }
 }
@@ -566,10 +984,9 @@ void SparseConvDetectPass::Apply(const std::unique_ptr<SSAGraph>& graph) {
 
 REGISTER_MIR_PASS(sparse_conv_detect_pass,
                   paddle::lite::mir::SparseConvDetectPass)
-    .BindTargets({TARGET(kARM)})
+    .BindTargets({TARGET(kARM), TARGET(kX86)})
     .ExcludeTargets({TARGET(kXPU)})
     .ExcludeTargets({TARGET(kBM)})
     .ExcludeTargets({TARGET(kRKNPU)})
     .ExcludeTargets({TARGET(kOpenCL)})
-    .ExcludeTargets({TARGET(kNPU)})
-    .ExcludeTargets({TARGET(kX86)});
+    .ExcludeTargets({TARGET(kNPU)});
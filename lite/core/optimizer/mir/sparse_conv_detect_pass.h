@@ -16,8 +16,10 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 #include "lite/core/op_registry.h"
 #include "lite/core/optimizer/mir/pass.h"
+#include "lite/operators/op_params.h"
 
 namespace paddle {
 namespace lite {
@@ -25,8 +27,50 @@ namespace mir {
 
 class SparseConvDetectPass : public ProgramPass {
  public:
+  // The sparse format selected for a weight, with its estimated speedup over
+  // the dense gemm.
+  struct SparseCandidate {
+    operators::SparseFormat format{operators::SparseFormat::kUnstructured};
+    int block_h{1};
+    int block_w{1};
+    float speedup{0.f};
+  };
+
   void Apply(const std::unique_ptr<SSAGraph>& graph) override;
 
+  // Estimate the speedup of every supported format for the sparse weights
+  // [M, K], and return the best one. The estimation is based on the stored
+  // non-zeros (with the zero-padding of blocks) and the efficiency of each
+  // kernel relative to the dense gemm, because the pass may run on the host
+  // by the opt tool rather than on the target.
+  SparseCandidate SelectSparseFormat(const float* weights,
+                                     const int M,
+                                     const int K,
+                                     const bool is_fc,
+                                     const bool on_x86,
+                                     const int num_build_nonzeroes);
+
+  // Pack the weights [M, K] into the block format, the blocks are stored
+  // column major.
+  void ComputeBlockSparseWeight(const float* weights,
+                                const int M,
+                                const int K,
+                                const int block_h,
+                                const int block_w,
+                                lite::Tensor* nonzero_output_tensor,
+                                lite::Tensor* row_ptr_tensor,
+                                lite::Tensor* col_idx_tensor);
+
+  // Pack the weights [M, K] into the N:M format.
+  void ComputeNMSparseWeight(const float* weights,
+                             const int M,
+                             const int K,
+                             const int nm_n,
+                             const int nm_m,
+                             lite::Tensor* nonzero_output_tensor,
+                             lite::Tensor* row_ptr_tensor,
+                             lite::Tensor* col_idx_tensor);
+
   template <typename T>
   int ComputeSparseZeros(const lite::Tensor* weights, const int num);
 
@@ -73,6 +117,27 @@ class SparseConvDetectPass : public ProgramPass {
   }
 
  private:
+  void DetectSparseConv(const std::unique_ptr<SSAGraph>& graph,
+                        Node* node,
+                        const bool on_x86);
+  void DetectSparseFc(const std::unique_ptr<SSAGraph>& graph,
+                      Node* node,
+                      const bool on_x86);
+  // Create the persistable tensors of the sparse weights named after the
+  // dense weights.
+  std::vector<Node*> CreateSparseWeightNodes(
+      const std::unique_ptr<SSAGraph>& graph,
+      Scope* scope,
+      const std::string& weight_name,
+      std::vector<lite::Tensor*>* tensors);
+  // Replace the dense op node with the sparse op node, the dense weights are
+  // removed from the graph if not used by other ops.
+  void ReplaceWithSparseOp(const std::unique_ptr<SSAGraph>& graph,
+                           Node* node,
+                           Node* sparse_op_node,
+                           const std::string& weight_name,
+                           const std::vector<Node*>& sparse_weight_nodes);
+
   float sparse_threshold_{0.5f};
 };
 
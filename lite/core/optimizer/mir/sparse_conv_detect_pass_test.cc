@@ -0,0 +1,111 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/optimizer/mir/sparse_conv_detect_pass.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+#include "lite/api/light_api.h"
+#include "lite/api/paddle_use_kernels.h"
+#include "lite/api/paddle_use_ops.h"
+#include "lite/api/paddle_use_passes.h"
+#include "lite/core/optimizer/mir/pass_test_helper.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+// The fc whose weights [K, M] are sparse in 4x4 blocks is replaced by the
+// sparse fc, and the packed weights are saved and loaded by the opt tool.
+TEST(sparse_conv_detect_pass, save_and_load_sparse_fc) {
+  const int N = 8;
+  const int K = 64;
+  const int M = 32;
+  std::mt19937 gen(0);
+  std::uniform_real_distribution<float> dis(-1.f, 1.f);
+  std::vector<float> w(K * M, 0.f);
+  for (int bm = 0; bm < M / 4; bm++) {
+    for (int bk = 0; bk < K / 4; bk++) {
+      if (gen() % 8 != 0) continue;
+      for (int i = 0; i < 4; i++) {
+        for (int j = 0; j < 4; j++) {
+          w[(bk * 4 + j) * M + bm * 4 + i] = dis(gen);
+        }
+      }
+    }
+  }
+  TestProgramBuilder builder;
+  builder.AddInput("x");
+  builder.AddWeight("fc_w", {K, M}, w);
+  builder.AddWeight("fc_bias", {M});
+  auto* fc = builder.AddOp(
+      "fc",
+      {{"Input", {"x"}}, {"W", {"fc_w"}}, {"Bias", {"fc_bias"}}},
+      {{"Out", {"fc_out"}}});
+  fc->SetAttr<int>("in_num_col_dims", 1);
+  builder.AddOutput("fc_out");
+
+  auto* pass = PassManager::Global().LookUp<SparseConvDetectPass>(
+      "sparse_conv_detect_pass");
+  ASSERT_TRUE(pass != nullptr);
+  pass->SetSparseThreshold(0.5f);
+  auto places = GetTestPlaces();
+  auto predictor = builder.Build(places);
+  ASSERT_EQ(GetOpTypes(*predictor), std::vector<std::string>{"sparse_fc"});
+  // The precisions must survive the packing, or the weights can't be saved.
+  EXPECT_EQ(predictor->GetTensor("fc_w_nonzeros_output")->precision(),
+            PRECISION(kFloat));
+  EXPECT_EQ(predictor->GetTensor("fc_w_oc_nonzeros")->precision(),
+            PRECISION(kInt32));
+  EXPECT_EQ(predictor->GetTensor("fc_w_ic_diffs")->precision(),
+            PRECISION(kInt32));
+  auto reference = builder.BuildWithout(places, {"sparse_conv_detect_pass"});
+  ASSERT_EQ(GetOpTypes(*reference), std::vector<std::string>{"fc"});
+
+  std::vector<float> x(N * K);
+  for (auto& v : x) v = dis(gen);
+  auto feed = [&](lite::Tensor* input) {
+    input->Resize({N, K});
+    std::copy(x.begin(), x.end(), input->mutable_data<float>());
+  };
+  feed(reference->GetInput(0));
+  reference->Run();
+  feed(predictor->GetInput(0));
+  predictor->Run();
+  auto* ref_out = reference->GetOutput(0);
+  auto* out = predictor->GetOutput(0);
+  ASSERT_EQ(out->numel(), N * M);
+  for (int i = 0; i < N * M; i++) {
+    EXPECT_NEAR(out->data<float>()[i], ref_out->data<float>()[i], 1e-4);
+  }
+
+  const std::string model_file = "sparse_conv_detect_pass_test_opt";
+  predictor->SaveModel(model_file, lite_api::LiteModelType::kNaiveBuffer);
+  LightPredictor loaded(model_file + ".nb", false);
+  feed(loaded.GetInput(0));
+  loaded.Run();
+  auto* loaded_out = loaded.GetOutput(0);
+  ASSERT_EQ(loaded_out->numel(), N * M);
+  for (int i = 0; i < N * M; i++) {
+    EXPECT_EQ(loaded_out->data<float>()[i], out->data<float>()[i]);
+  }
+  std::remove((model_file + ".nb").c_str());
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
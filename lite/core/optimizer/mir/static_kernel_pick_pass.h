@@ -223,6 +223,9 @@ class StaticKernelPickPass : public mir::StmtPass {
     } else if ((p1 == PRECISION(kFP16) || p1 == PRECISION(kFloat)) &&
                (p2 == PRECISION(kFP16) || p2 == PRECISION(kFloat))) {
       return true;
+    } else if ((p1 == PRECISION(kBF16) || p1 == PRECISION(kFloat)) &&
+               (p2 == PRECISION(kBF16) || p2 == PRECISION(kFloat))) {
+      return true;
     } else {
       return false;
     }
@@ -13,8 +13,12 @@
 // limitations under the License.
 
 #include "lite/core/optimizer/mir/subgraph/subgraph_detector.h"
+#include <algorithm>
+#include <cstdlib>
+#include <map>
 #include <memory>
 #include <set>
+#include <string>
 #include <utility>
 #include <vector>
 #include "lite/core/optimizer/mir/dot.h"
@@ -22,6 +26,7 @@
 #include "lite/core/optimizer/mir/pattern_matcher.h"
 #include "lite/operators/subgraph_op.h"
 #include "lite/utils/env.h"
+#include "lite/utils/hash.h"
 #include "lite/utils/io.h"
 #include "lite/utils/string.h"
 
@@ -505,6 +510,185 @@ std::vector<std::vector<Node *>> SubgraphDetector::operator()() {
   return subgraphs;
 }
 
+SubgraphCostModel::SubgraphCostModel(const std::string &cost_table) {
+  std::vector<std::string> lines = Split(cost_table, "\n");
+  for (const auto &line : lines) {
+    if (line.empty() || line[0] == '#') continue;
+    std::vector<std::string> item = Split(line, ":");
+    CHECK_EQ(item.size(), 2u) << "Invalid subgraph cost table line: " << line;
+    std::vector<std::string> costs = Split(item[1], ",");
+    CHECK_EQ(costs.size(), 2u) << "Invalid subgraph cost table line: " << line;
+    auto cost = std::make_pair(std::atof(costs[0].c_str()),
+                               std::atof(costs[1].c_str()));
+    if (item[0] == "transfer") {
+      transfer_fixed_cost_ = cost.first;
+      transfer_cost_per_byte_ = cost.second;
+    } else if (item[0] == "default") {
+      default_cost_ = cost;
+    } else {
+      op_costs_[item[0]] = cost;
+    }
+    empty_ = false;
+  }
+}
+
+double SubgraphCostModel::HostCost(Node *op_node) const {
+  auto it = op_costs_.find(op_node->AsStmt().op_type());
+  return it != op_costs_.end() ? it->second.first : default_cost_.first;
+}
+
+double SubgraphCostModel::DeviceCost(Node *op_node) const {
+  auto it = op_costs_.find(op_node->AsStmt().op_type());
+  return it != op_costs_.end() ? it->second.second : default_cost_.second;
+}
+
+double SubgraphCostModel::TransferCost(Node *var_node) const {
+  double cost = transfer_fixed_cost_;
+  if (transfer_cost_per_byte_ == 0.0) return cost;
+  // Find the tensor in the scope of any op which links to the var
+  Scope *scope = nullptr;
+  for (auto *op_node : var_node->inlinks) {
+    scope = op_node->AsStmt().op()->scope();
+  }
+  for (auto *op_node : var_node->outlinks) {
+    if (scope) break;
+    scope = op_node->AsStmt().op()->scope();
+  }
+  if (!scope) return cost;
+  auto *var = scope->FindVar(var_node->AsArg().name);
+  if (!var || !var->IsType<Tensor>()) return cost;
+  // The dims from the var desc may be unknown, e.g. [-1, 3, 224, 224]
+  auto dims = var->Get<Tensor>().dims();
+  if (dims.empty()) return cost;
+  for (size_t i = 0; i < dims.size(); i++) {
+    if (dims[i] <= 0) return cost;
+  }
+  // The precision of the tensor is set by the data type of the var desc or by
+  // its data, otherwise the one of the arg type is taken if it's known, or
+  // float by default.
+  size_t type_length = PrecisionTypeLength(var->Get<Tensor>().precision());
+  auto *type = var_node->AsArg().type;
+  if (type_length == 0 && type) {
+    type_length = PrecisionTypeLength(type->precision());
+  }
+  if (type_length == 0) type_length = sizeof(float);
+  return cost + transfer_cost_per_byte_ * dims.production() * type_length;
+}
+
+bool SubgraphPartitioner::IsTransferred(Node *var_node,
+                                        const std::set<Node *> &op_nodes) {
+  if (!var_node->IsArg() || var_node->AsArg().is_weight) return false;
+  bool produced_inside = !var_node->inlinks.empty() &&
+                         op_nodes.count(var_node->inlinks.front()) != 0;
+  for (auto *op_node : var_node->outlinks) {
+    // An output is copied to the host if it's used by any op outside, an
+    // input is copied to the device once for all of the ops inside.
+    if (produced_inside != (op_nodes.count(op_node) != 0)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+double SubgraphPartitioner::OffloadGain(const std::set<Node *> &op_nodes) {
+  double gain = 0.0;
+  std::set<Node *> var_nodes;
+  for (auto *op_node : op_nodes) {
+    gain += cost_model_.HostCost(op_node) - cost_model_.DeviceCost(op_node);
+    var_nodes.insert(op_node->inlinks.begin(), op_node->inlinks.end());
+    var_nodes.insert(op_node->outlinks.begin(), op_node->outlinks.end());
+  }
+  for (auto *var_node : var_nodes) {
+    if (IsTransferred(var_node, op_nodes)) {
+      gain -= cost_model_.TransferCost(var_node);
+    }
+  }
+  return gain;
+}
+
+double SubgraphPartitioner::RemovalDelta(Node *op_node,
+                                         std::set<Node *> *op_nodes) {
+  // Only the transfers of the vars of the op are changed
+  std::set<Node *> var_nodes(op_node->inlinks.begin(), op_node->inlinks.end());
+  var_nodes.insert(op_node->outlinks.begin(), op_node->outlinks.end());
+  double delta =
+      cost_model_.DeviceCost(op_node) - cost_model_.HostCost(op_node);
+  for (auto *var_node : var_nodes) {
+    if (IsTransferred(var_node, *op_nodes)) {
+      delta += cost_model_.TransferCost(var_node);
+    }
+  }
+  op_nodes->erase(op_node);
+  for (auto *var_node : var_nodes) {
+    if (IsTransferred(var_node, *op_nodes)) {
+      delta -= cost_model_.TransferCost(var_node);
+    }
+  }
+  op_nodes->insert(op_node);
+  return delta;
+}
+
+bool SubgraphPartitioner::IsBoundary(Node *op_node,
+                                     const std::set<Node *> &op_nodes) {
+  bool has_producer = false;
+  for (auto *var_node : op_node->inlinks) {
+    if (!var_node->inlinks.empty() &&
+        op_nodes.count(var_node->inlinks.front())) {
+      has_producer = true;
+      break;
+    }
+  }
+  if (!has_producer) return true;
+  for (auto *var_node : op_node->outlinks) {
+    for (auto *next_op_node : var_node->outlinks) {
+      if (op_nodes.count(next_op_node)) return false;
+    }
+  }
+  return true;
+}
+
+std::vector<std::vector<Node *>> SubgraphPartitioner::operator()(
+    const std::vector<std::vector<Node *>> &subgraphs) {
+  std::vector<std::vector<Node *>> partitioned_subgraphs;
+  for (auto &subgraph : subgraphs) {
+    std::set<Node *> op_nodes(subgraph.begin(), subgraph.end());
+    // Move the boundary op which saves the most back to the host, one at a
+    // time, as the gains of the others are changed by it.
+    while (!op_nodes.empty()) {
+      Node *best_op_node = nullptr;
+      double best_delta = 0.0;
+      for (auto *op_node : op_nodes) {
+        if (!IsBoundary(op_node, op_nodes)) continue;
+        double delta = RemovalDelta(op_node, &op_nodes);
+        if (delta > best_delta) {
+          best_delta = delta;
+          best_op_node = op_node;
+        }
+      }
+      if (!best_op_node) break;
+      VLOG(3) << "move " << best_op_node->AsStmt().op_type()
+              << " back to the host, saves " << best_delta;
+      op_nodes.erase(best_op_node);
+    }
+    if (op_nodes.empty()) continue;
+    double gain = OffloadGain(op_nodes);
+    if (gain < 0.0) {
+      VLOG(3) << "drop the subgraph of " << op_nodes.size()
+              << " ops, which is slower than the host by " << -gain;
+      continue;
+    }
+    // Keep the topological order of the detected subgraph
+    std::vector<Node *> partitioned_subgraph;
+    for (auto *op_node : subgraph) {
+      if (op_nodes.count(op_node)) {
+        partitioned_subgraph.push_back(op_node);
+      }
+    }
+    partitioned_subgraphs.push_back(partitioned_subgraph);
+  }
+  return partitioned_subgraphs;
+}
+
 void SubgraphFuser::InsertNewNode(SSAGraph *graph,
                                   int subgraph_idx,
                                   const std::vector<Node *> &subgraph_nodes) {
@@ -562,6 +746,38 @@ void SubgraphFuser::InsertNewNode(SSAGraph *graph,
                                                      idata_var_names);
   subgraph_op_desc.SetAttr<std::vector<std::string>>("output_data_names",
                                                      odata_var_names);
+  // Record the shapes of the weights as 'name:d0,d1,...', and the hash of
+  // their data in the order of the shapes, they are kept in the model even if
+  // the weights aren't saved in the offline mode
+  auto scope = (*subgraph_nodes.begin())->AsStmt().op()->scope();
+  std::map<std::string, const Tensor *> weight_tensors;
+  for (auto &var_node : weight_var_nodes) {
+    auto &var_name = var_node->AsArg().name;
+    auto tensor = scope->FindTensor(var_name);
+    if (!tensor) continue;
+    std::string shape = var_name + ":";
+    for (auto dim : tensor->dims().Vectorize()) {
+      shape += std::to_string(dim) + ",";
+    }
+    weight_tensors[shape] = tensor;
+  }
+  std::vector<std::string> weight_data_shapes;
+  uint64_t weight_data_hash = HashBytes(nullptr, 0);
+  bool has_weight_data = true;
+  for (auto &weight_tensor : weight_tensors) {
+    weight_data_shapes.push_back(weight_tensor.first);
+    auto tensor = weight_tensor.second;
+    has_weight_data = has_weight_data && tensor->IsInitialized();
+    if (!has_weight_data) continue;
+    weight_data_hash =
+        HashBytes(tensor->raw_data(), tensor->memory_size(), weight_data_hash);
+  }
+  subgraph_op_desc.SetAttr<std::vector<std::string>>("weight_data_shapes",
+                                                     weight_data_shapes);
+  if (has_weight_data) {
+    subgraph_op_desc.SetAttr<std::string>("weight_data_digest",
+                                          std::to_string(weight_data_hash));
+  }
   // Set all of the inputs and outputs to the target subgraph op
   // To prevent vars are removed in RuntimeProgram::UpdateVarsOfProgram()
   std::vector<std::string> input_var_names;
@@ -644,6 +860,9 @@ void SubgraphFuser::ReplaceNodesWithSubgraphs(
 void SubgraphFuser::operator()() {
   std::vector<std::vector<Node *>> subgraphs =
       SubgraphDetector(graph_, teller_, subgraph_partition_configs_)();
+  if (!cost_model_.empty()) {
+    subgraphs = SubgraphPartitioner(graph_, cost_model_)(subgraphs);
+  }
   if (support_mixed_precision_) {
     MixedPrecisionAutoInsertCalibFuser mixed_precision_auto_insert_calib_fuser(
         graph_, &subgraphs);
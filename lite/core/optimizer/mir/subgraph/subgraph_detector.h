@@ -18,6 +18,7 @@
 #include <memory>
 #include <set>
 #include <string>
+#include <utility>
 #include <vector>
 #include "lite/core/optimizer/mir/pass.h"
 
@@ -89,6 +90,74 @@ class SubgraphDetector {
   const std::string& subgraph_partition_configs_;
 };
 
+/*
+ * The estimated latency of the op nodes on the host and on the device, and of
+ * the transfers of the variables between them, which are the io_copy, layout
+ * and precision casts inserted at the boundary of a subgraph by
+ * type_target_cast_pass and its siblings. The costs are loaded from a cost
+ * table, an example is shown as below, all of the costs are in the same unit:
+ * op_type:host_cost,device_cost
+ * default:host_cost,device_cost
+ * transfer:fixed_cost,cost_per_byte
+ * The ops which are not in the table take the default costs, which are the
+ * same on the host and on the device unless 'default' is given. The size of
+ * a variable is its dims in its precision, or in float if the precision is
+ * unknown, if the dims are known in the scope, otherwise only the fixed cost
+ * of the transfer is counted.
+ */
+class SubgraphCostModel {
+ public:
+  explicit SubgraphCostModel(const std::string& cost_table = "");
+
+  // No cost table is given, the subgraphs are kept as they are detected.
+  bool empty() const { return empty_; }
+
+  double HostCost(Node* op_node) const;
+  double DeviceCost(Node* op_node) const;
+  double TransferCost(Node* var_node) const;
+
+ protected:
+  bool empty_{true};
+  std::map<std::string, std::pair<double, double>> op_costs_;
+  std::pair<double, double> default_cost_{1.0, 1.0};
+  double transfer_fixed_cost_{0.0};
+  double transfer_cost_per_byte_{0.0};
+};
+
+/*
+ * Refine the detected subgraphs by the cost model. An op on the boundary of a
+ * subgraph, whose inputs or outputs are all outside of the subgraph, is moved
+ * back to the host if it reduces the estimated latency, which is the costs of
+ * the ops plus the costs of the transfers at the cuts, until no one does.
+ * Then the subgraph is dropped if it's still slower than running all of its
+ * ops on the host. Only the boundary ops are removed, so the subgraphs are
+ * still convex.
+ */
+class SubgraphPartitioner {
+ public:
+  SubgraphPartitioner(SSAGraph* graph, const SubgraphCostModel& cost_model)
+      : graph_(graph), cost_model_(cost_model) {}
+
+  std::vector<std::vector<Node*>> operator()(
+      const std::vector<std::vector<Node*>>& subgraphs);
+
+  // The latency saved by running the ops on the device, which is negative if
+  // they are slower on the device with the transfers.
+  double OffloadGain(const std::set<Node*>& op_nodes);
+
+ protected:
+  // Whether the var is transferred between the host and the device if the
+  // op_nodes run on the device.
+  bool IsTransferred(Node* var_node, const std::set<Node*>& op_nodes);
+  // The gain is changed by this if the op node is moved back to the host.
+  double RemovalDelta(Node* op_node, std::set<Node*>* op_nodes);
+  // Whether the op node has no producer or no consumer in the op_nodes.
+  bool IsBoundary(Node* op_node, const std::set<Node*>& op_nodes);
+
+  SSAGraph* graph_{nullptr};
+  const SubgraphCostModel& cost_model_;
+};
+
 /*
  * Replace all of subgraphs with the subgraph ops, a block desc is added into
  * the subgraph op to wrap the original op nodes, keep all of var nodes of the
@@ -100,12 +169,14 @@ class SubgraphFuser {
                 const SubgraphTeller& teller,
                 int min_subgraph_size,
                 const std::string& subgraph_partition_configs = "",
-                bool support_mixed_precision = false)
+                bool support_mixed_precision = false,
+                const std::string& subgraph_cost_table = "")
       : graph_(graph),
         teller_(teller),
         min_subgraph_size_{min_subgraph_size},
         subgraph_partition_configs_(subgraph_partition_configs),
-        support_mixed_precision_(support_mixed_precision) {}
+        support_mixed_precision_(support_mixed_precision),
+        cost_model_(subgraph_cost_table) {}
   void operator()();
 
   // Remove the op nodes of the subgraphs and replace with the subgraph ops.
@@ -125,6 +196,7 @@ class SubgraphFuser {
   int min_subgraph_size_;
   const std::string& subgraph_partition_configs_;
   bool support_mixed_precision_{false};
+  SubgraphCostModel cost_model_;
 };
 
 class MixedPrecisionAutoInsertCalibFuser {
@@ -44,12 +44,14 @@ std::vector<std::string> AddFCDesc(
 
   auto* wgt = block_desc->AddVar<cpp::VarDesc>();
   wgt->SetName(prefix + "_W");
+  wgt->SetPersistable(true);
   auto* wtensor = scope->Var(prefix + "_W")->GetMutable<Tensor>();
   wtensor->Resize(wshape);
   wtensor->mutable_data<float>();
 
   auto* bias = block_desc->AddVar<cpp::VarDesc>();
   bias->SetName(prefix + "_Bias");
+  bias->SetPersistable(true);
   auto* btensor = scope->Var(prefix + "_Bias")->GetMutable<Tensor>();
   btensor->Resize({wshape[1]});
   btensor->mutable_data<float>();
@@ -173,6 +175,138 @@ TEST(Subgraph, detect_simple_model) {
   mir::SubgraphVisualizer(graph.get(), subgraphs)();
 }
 
+TEST(Subgraph, partition_by_cost) {
+  auto program_desc = std::make_shared<cpp::ProgramDesc>();
+  std::vector<Place> valid_places{{TARGET(kHost), PRECISION(kFloat)}};
+  auto scope = std::make_shared<Scope>();
+  // Build a network of fc->fc->elementwise_add whose output is fetched
+  auto* block_desc = program_desc->AddBlock<cpp::BlockDesc>();
+  block_desc->ClearOps();
+  block_desc->ClearVars();
+  for (auto& name : {"feed_var", "feed_var2"}) {
+    auto* var_desc = block_desc->AddVar<cpp::VarDesc>();
+    var_desc->SetName(name);
+    scope->Var(name)->GetMutable<Tensor>()->Resize({1, 2});
+  }
+  auto fc1_out = AddFCDesc(block_desc, scope, {"feed_var"}, {2, 5});
+  auto fc2_out = AddFCDesc(block_desc, scope, fc1_out, {5, 2});
+  auto add_out =
+      AddElementwiseAddDesc(block_desc, scope, fc2_out, {"feed_var2"});
+  AddFetchDesc(block_desc, scope, add_out);
+  Program program(program_desc, scope, valid_places);
+  auto graph = std::unique_ptr<mir::SSAGraph>(new mir::SSAGraph());
+  graph->Build(program, valid_places);
+  auto teller = [](mir::Node* node) {
+    if (!node->IsStmt()) return false;
+    auto& stmt = node->AsStmt();
+    auto op_type = stmt.op_type();
+    return op_type == "fc" || op_type == "elementwise_add";
+  };
+  auto subgraphs = mir::SubgraphDetector(graph.get(), teller)();
+  ASSERT_EQ(subgraphs.size(), 1u);
+  ASSERT_EQ(subgraphs[0].size(), 3u);
+  // The fc ops are faster on the fake device, the elementwise_add is not, so
+  // it's moved back to the host to save the transfers of its input and
+  // output.
+  mir::SubgraphCostModel fast_fc(
+      "fc:10,1\nelementwise_add:1,1\ntransfer:5,0\n");
+  auto partitioned = mir::SubgraphPartitioner(graph.get(), fast_fc)(subgraphs);
+  ASSERT_EQ(partitioned.size(), 1u);
+  ASSERT_EQ(partitioned[0].size(), 2u);
+  for (auto* node : partitioned[0]) {
+    ASSERT_EQ(node->AsStmt().op_type(), "fc");
+  }
+  // The fc ops are a little faster on the fake device, which can't pay for
+  // the transfers, so the subgraph is dropped.
+  mir::SubgraphCostModel slow_fc("fc:10,9\ntransfer:5,0\n");
+  partitioned = mir::SubgraphPartitioner(graph.get(), slow_fc)(subgraphs);
+  ASSERT_EQ(partitioned.size(), 0u);
+  // The transfers are free, all of the ops are kept.
+  mir::SubgraphCostModel free_transfer("fc:10,9\n");
+  partitioned =
+      mir::SubgraphPartitioner(graph.get(), free_transfer)(subgraphs);
+  ASSERT_EQ(partitioned.size(), 1u);
+  ASSERT_EQ(partitioned[0].size(), 3u);
+}
+
+// The bytes of a transferred var are counted in the precision of its tensor.
+TEST(Subgraph, transfer_cost_by_precision) {
+  auto program_desc = std::make_shared<cpp::ProgramDesc>();
+  std::vector<Place> valid_places{{TARGET(kHost), PRECISION(kFloat)}};
+  auto scope = std::make_shared<Scope>();
+  auto* block_desc = program_desc->AddBlock<cpp::BlockDesc>();
+  block_desc->ClearOps();
+  block_desc->ClearVars();
+  auto* var_desc = block_desc->AddVar<cpp::VarDesc>();
+  var_desc->SetName("feed_var");
+  auto* feed_var = scope->Var("feed_var")->GetMutable<Tensor>();
+  feed_var->Resize({2, 8});
+  AddFCDesc(block_desc, scope, {"feed_var"}, {8, 4});
+  Program program(program_desc, scope, valid_places);
+  auto graph = std::unique_ptr<mir::SSAGraph>(new mir::SSAGraph());
+  graph->Build(program, valid_places);
+  mir::Node* var_node = nullptr;
+  for (auto& node : graph->mutable_nodes()) {
+    if (node.IsArg() && node.AsArg().name == "feed_var") var_node = &node;
+  }
+  ASSERT_TRUE(var_node != nullptr);
+  mir::SubgraphCostModel cost_model("transfer:5,0.5\n");
+  // The precision is unknown before the data is allocated, float is taken.
+  EXPECT_DOUBLE_EQ(cost_model.TransferCost(var_node), 5 + 0.5 * 16 * 4);
+  auto* exec_feed_var = program.exec_scope()->FindMutableTensor("feed_var");
+  ASSERT_TRUE(exec_feed_var != nullptr);
+  exec_feed_var->mutable_data<int8_t>();
+  EXPECT_DOUBLE_EQ(cost_model.TransferCost(var_node), 5 + 0.5 * 16);
+  exec_feed_var->mutable_data<int64_t>();
+  EXPECT_DOUBLE_EQ(cost_model.TransferCost(var_node), 5 + 0.5 * 16 * 8);
+}
+
+// The digest of the weight data is recorded on the subgraph op, it's stable
+// for the same weights and changed with any byte of them.
+TEST(Subgraph, weight_data_digest) {
+  auto fuse = [](float bias) {
+    auto program_desc = std::make_shared<cpp::ProgramDesc>();
+    std::vector<Place> valid_places{{TARGET(kHost), PRECISION(kFloat)}};
+    auto scope = std::make_shared<Scope>();
+    auto* block_desc = program_desc->AddBlock<cpp::BlockDesc>();
+    block_desc->ClearOps();
+    block_desc->ClearVars();
+    auto* var_desc = block_desc->AddVar<cpp::VarDesc>();
+    var_desc->SetName("feed_var");
+    scope->Var("feed_var")->GetMutable<Tensor>()->Resize({1, 4});
+    AddFCDesc(block_desc, scope, {"feed_var"}, {4, 2});
+    for (auto& name : scope->LocalVarNames()) {
+      auto* tensor = scope->FindMutableTensor(name);
+      if (!tensor->IsInitialized()) continue;
+      auto* data = tensor->mutable_data<float>();
+      for (int64_t i = 0; i < tensor->numel(); i++) {
+        data[i] = name.find("_Bias") != std::string::npos ? bias : i;
+      }
+    }
+    Program program(program_desc, scope, valid_places);
+    auto graph = std::unique_ptr<mir::SSAGraph>(new mir::SSAGraph());
+    graph->Build(program, valid_places);
+    auto teller = [](mir::Node* node) {
+      return node->IsStmt() && node->AsStmt().op_type() == "fc";
+    };
+    mir::SubgraphFuser(graph.get(), teller, 1)();
+    for (auto* node : graph->StmtTopologicalOrder()) {
+      auto* op_info = node->AsStmt().op_info();
+      if (op_info->Type() != "subgraph") continue;
+      EXPECT_EQ(op_info->GetAttr<std::vector<std::string>>(
+                    "weight_data_shapes")
+                    .size(),
+                2u);
+      return op_info->GetAttr<std::string>("weight_data_digest");
+    }
+    return std::string();
+  };
+  auto digest = fuse(0.5f);
+  ASSERT_FALSE(digest.empty());
+  EXPECT_EQ(fuse(0.5f), digest);
+  EXPECT_NE(fuse(0.25f), digest);
+}
+
 TEST(Subgraph, detect_custom_model) {
   if (FLAGS_model_dir.empty() && FLAGS_model_file.empty() &&
       FLAGS_params_file.empty()) {
@@ -26,9 +26,9 @@ namespace paddle {
 namespace lite {
 namespace mir {
 
-static std::string ReadSubgraphPartitionConfigsFromEnv() {
+static std::string ReadSubgraphConfigFileFromEnv(const std::string& env) {
   std::string configs;
-  auto path = GetStringFromEnv(SUBGRAPH_CUSTOM_PARTITION_CONFIG_FILE);
+  auto path = GetStringFromEnv(env);
   if (!path.empty()) {
     std::vector<char> buffer;
     if (ReadFile(path, &buffer, false)) {
@@ -36,14 +36,21 @@ static std::string ReadSubgraphPartitionConfigsFromEnv() {
         configs.insert(configs.begin(), buffer.begin(), buffer.end());
       }
     } else {
-      LOG(WARNING)
-          << "Missing the subgraph custom partition configuration file "
-          << path;
+      LOG(WARNING) << "Missing the subgraph configuration file " << path
+                   << " of " << env;
     }
   }
   return configs;
 }
 
+static std::string ReadSubgraphPartitionConfigsFromEnv() {
+  return ReadSubgraphConfigFileFromEnv(SUBGRAPH_CUSTOM_PARTITION_CONFIG_FILE);
+}
+
+static std::string ReadSubgraphCostTableFromEnv() {
+  return ReadSubgraphConfigFileFromEnv(SUBGRAPH_COST_TABLE_FILE);
+}
+
 void NPUSubgraphPass::Apply(const std::unique_ptr<SSAGraph>& graph) {
   std::set<std::string> supported_lists;
 #define USE_SUBGRAPH_BRIDGE(op_type, target) supported_lists.insert(#op_type);
@@ -55,10 +62,13 @@ void NPUSubgraphPass::Apply(const std::unique_ptr<SSAGraph>& graph) {
     return supported_lists.count(stmt.op_type()) != 0;
   };
   auto subgraph_partition_configs = ReadSubgraphPartitionConfigsFromEnv();
+  auto subgraph_cost_table = ReadSubgraphCostTableFromEnv();
   SubgraphFuser fuser(graph.get(),
                       teller,
                       1 /* min_subgraph_size */,
-                      subgraph_partition_configs);
+                      subgraph_partition_configs,
+                      false,
+                      subgraph_cost_table);
   fuser();
 }
 
@@ -74,10 +84,13 @@ void XPUSubgraphPass::Apply(const std::unique_ptr<SSAGraph>& graph) {
     return supported_lists.count(stmt.op_type()) != 0;
   };
   auto subgraph_partition_configs = ReadSubgraphPartitionConfigsFromEnv();
+  auto subgraph_cost_table = ReadSubgraphCostTableFromEnv();
   SubgraphFuser fuser(graph.get(),
                       teller,
                       1 /* min_subgraph_size */,
-                      subgraph_partition_configs);
+                      subgraph_partition_configs,
+                      false,
+                      subgraph_cost_table);
   fuser();
 }
 
@@ -92,10 +105,13 @@ void BMSubgraphPass::Apply(const std::unique_ptr<SSAGraph>& graph) {
     return supported_lists.count(stmt.op_type()) != 0;
   };
   auto subgraph_partition_configs = ReadSubgraphPartitionConfigsFromEnv();
+  auto subgraph_cost_table = ReadSubgraphCostTableFromEnv();
   SubgraphFuser fuser(graph.get(),
                       teller,
                       1 /* min_subgraph_size */,
-                      subgraph_partition_configs);
+                      subgraph_partition_configs,
+                      false,
+                      subgraph_cost_table);
   fuser();
 }
 
@@ -110,10 +126,13 @@ void RKNPUSubgraphPass::Apply(const std::unique_ptr<SSAGraph>& graph) {
     return supported_lists.count(stmt.op_type()) != 0;
   };
   auto subgraph_partition_configs = ReadSubgraphPartitionConfigsFromEnv();
+  auto subgraph_cost_table = ReadSubgraphCostTableFromEnv();
   SubgraphFuser fuser(graph.get(),
                       teller,
                       1 /* min_subgraph_size */,
-                      subgraph_partition_configs);
+                      subgraph_partition_configs,
+                      false,
+                      subgraph_cost_table);
   fuser();
 }
 
@@ -128,10 +147,13 @@ void MLUSubgraphPass::Apply(const std::unique_ptr<SSAGraph>& graph) {
     return supported_lists.count(stmt.op_type()) != 0;
   };
   auto subgraph_partition_configs = ReadSubgraphPartitionConfigsFromEnv();
+  auto subgraph_cost_table = ReadSubgraphCostTableFromEnv();
   SubgraphFuser fuser(graph.get(),
                       teller,
                       1 /* min_subgraph_size */,
-                      subgraph_partition_configs);
+                      subgraph_partition_configs,
+                      false,
+                      subgraph_cost_table);
   fuser();
 }
 
@@ -211,11 +233,13 @@ void NNAdapterSubgraphPass::Apply(const std::unique_ptr<SSAGraph>& graph) {
     auto& stmt = node->AsStmt();
     return supported_ops.count(stmt.op_type()) != 0;
   };
+  auto subgraph_cost_table = ReadSubgraphCostTableFromEnv();
   SubgraphFuser fuser(graph.get(),
                       teller,
                       1 /* min_subgraph_size */,
                       subgraph_partition_configs,
-                      true);
+                      true,
+                      subgraph_cost_table);
   fuser();
 }
 
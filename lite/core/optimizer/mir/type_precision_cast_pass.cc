@@ -230,7 +230,12 @@ void PrecisionCastPass::ComplementInputs(
   }
   has_fp16 = has_fp16 && (in->AsArg().is_weight);
   VLOG(4) << "has_fp16: " << has_fp16 << ", arg_name: " << in->AsArg().name;
-  if ((!has_fp16) &&
+  // The float weights of the bf16 kernels are converted when the model is
+  // loaded, see bf16_attribute_pass, or packed by the kernels.
+  bool bf16_weight = in->AsArg().is_weight &&
+                     input_decl_type->precision() == PRECISION(kBF16) &&
+                     in->AsArg().type->precision() == PRECISION(kFloat);
+  if ((!has_fp16) && (!bf16_weight) &&
       !PrecisionCompatibleTo(*in->AsArg().type, *input_decl_type)) {
     VLOG(4) << "found Target unmatched tensor: " << in->AsArg().name
             << " for kernel " << inst.op()->DebugString() << " "
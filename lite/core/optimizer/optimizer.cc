@@ -148,6 +148,7 @@ std::unique_ptr<RuntimeProgram> RunDefaultOptimizer(
        // TODO(Superjomn) Refine the fusion related design to select fusion
        // kernels for devices automatically.
        "lite_conv_activation_fuse_pass",              //
+       "lite_dw_pw_conv_fuse_pass",                   //
        "lite_var_conv_2d_activation_fuse_pass",       //
        "lite_match_matrix_activation_fuse_pass",      //
        "lite_squeeze2_matmul_fuse_pass",              //
@@ -166,12 +167,16 @@ std::unique_ptr<RuntimeProgram> RunDefaultOptimizer(
        "lite_scale_activation_fuse_pass",             //
        "lite_scaleacts_fuse_pass",                    //
        "lite_elementwise_scale_fuse_pass",            //
+       "lite_elementwise_add_layer_norm_fuse_pass",   //
        "lite_instance_norm_activation_fuse_pass",     //
        "lite_flatten_fc_fuse_pass",                   //
        "lite_fc_prelu_fuse_pass",                     //
        "lite_elementwise_activation_fuse_pass",
        "lite_conv_scale_fuse_pass",
        "lite_conv_elementwise_tree_fuse_pass",
+       "lite_pointwise_chain_fuse_pass",
+       "lite_yolo_box_nms_fuse_pass",
+       "lite_embedding_seq_pool_fuse_pass",
        "lite_greater_than_cast_fuse_pass",
        "fill_range_fuse_pass",
        "range_calc_offline_pass",
@@ -257,6 +262,9 @@ std::unique_ptr<RuntimeProgram> RunDefaultOptimizer(
                                  // different layout when last and next node
        "argument_type_display_pass",  //
 
+       "layout_transform_eliminate_pass",  // remove the redundant layout ops
+       "argument_type_display_pass",       //
+
        "variable_place_inference_pass",  //
        "control_flow_op_shared_inputs_and_outputs_place_sync_pass",
        "argument_type_display_pass",
@@ -309,6 +317,7 @@ std::unique_ptr<RuntimeProgram> RunDefaultOptimizer(
   const std::string pqd_pass{"post_quant_dynamic_pass"};
   const std::string pqd_depend_pass{"lite_quant_dequant_fuse_pass"};
   const std::string fp16_pass{"fp16_attribute_pass"};
+  const std::string bf16_pass{"bf16_attribute_pass"};
 
   for (const std::string& pass : passes) {
     if (pass == msa_pass) {
@@ -335,6 +344,14 @@ std::unique_ptr<RuntimeProgram> RunDefaultOptimizer(
     }
   }
 
+  for (auto place : valid_places) {
+    if ((place.target == TARGET(kARM) || place.target == TARGET(kX86)) &&
+        place.precision == PRECISION(kBF16)) {
+      passes_local.push_back(bf16_pass);
+      break;
+    }
+  }
+
   for (auto& pass_name : passes_local) {
     optim.AddPass(pass_name);
   }
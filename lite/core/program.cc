@@ -15,9 +15,12 @@
 #include "lite/core/program.h"
 
 #include <algorithm>
+#include <atomic>
 #include <map>
 #include <set>
+#include <thread>  // NOLINT
 
+#include "lite/core/profile/timer.h"
 #include "lite/model_parser/cpp_desc.h"
 #include "lite/operators/conditional_block_op.h"
 #include "lite/operators/subgraph_op.h"
@@ -28,6 +31,9 @@
 #ifdef LITE_WITH_FPGA
 #include "lite/backends/fpga/monitor.hpp"
 #endif
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 namespace paddle {
 namespace lite {
@@ -395,6 +401,210 @@ void RuntimeProgram::SaveOutput() {
 }
 #endif
 
+void RuntimeProgram::PlanStaticShapes() {
+  input_tensors_.clear();
+  last_input_dims_.clear();
+  last_input_lods_.clear();
+  // The inputs such as 'ShapeTensor' and 'StartsTensorList' carry the shape
+  // values, the output shapes depend on their data rather than their shapes.
+  auto IsShapeValueArg = [](const std::string& argname) {
+    auto EndsWith = [&](const std::string& suffix) {
+      return argname.size() >= suffix.size() &&
+             argname.compare(argname.size() - suffix.size(),
+                             suffix.size(),
+                             suffix) == 0;
+    };
+    return argname == "Shape" || EndsWith("Tensor") || EndsWith("TensorList");
+  };
+  // Whether the shape of a variable is decided by the program input shapes,
+  // only the latest writer of a variable is taken into account.
+  std::map<std::string, bool> is_var_shape_static;
+  std::set<const Tensor*> visited_inputs;
+  for (auto& inst : instructions_[kRootBlockIdx]) {
+#if !defined(LITE_WITH_FPGA) && !defined(LITE_WITH_METAL)
+    // The feed and fetch ops are skipped in Run(), so the feed targets are
+    // taken as the program inputs.
+    if (inst.is_feed_fetch_op()) continue;
+#endif
+    auto* op = const_cast<OpLite*>(inst.op());
+    const auto* op_info = op->op_info();
+    auto* scope = op->scope();
+    if (op_info == nullptr || scope == nullptr) continue;
+    bool is_shape_static = op->IsShapeStatic();
+    for (auto& argname : op_info->input_argnames()) {
+      for (auto& var_name : op_info->Input(argname)) {
+        auto* var = scope->FindVar(var_name);
+        if (var == nullptr || !var->IsType<Tensor>() ||
+            IsShapeValueArg(argname)) {
+          is_shape_static = false;
+          continue;
+        }
+        auto it = is_var_shape_static.find(var_name);
+        if (it == is_var_shape_static.end()) {
+          auto* tensor = &var->Get<Tensor>();
+          if (!visited_inputs.count(tensor)) {
+            visited_inputs.insert(tensor);
+            input_tensors_.push_back(tensor);
+          }
+        } else if (!it->second) {
+          is_shape_static = false;
+        }
+      }
+    }
+    std::vector<Tensor*> outputs;
+    for (auto& var_name : op_info->output_names()) {
+      auto* var = scope->FindVar(var_name);
+      if (var == nullptr || !var->IsType<Tensor>()) {
+        is_shape_static = false;
+        continue;
+      }
+      outputs.push_back(var->GetMutable<Tensor>());
+    }
+    // The outputs of the ops which run only once are never resized again.
+    for (auto& var_name : op_info->output_names()) {
+      is_var_shape_static[var_name] = is_shape_static || op->run_once();
+    }
+    if (is_shape_static) {
+      inst.set_static_shape_outputs(outputs);
+    }
+  }
+}
+
+bool RuntimeProgram::InputShapesChanged() {
+  bool changed = last_input_dims_.size() != input_tensors_.size();
+  if (changed) {
+    last_input_dims_.resize(input_tensors_.size());
+    last_input_lods_.resize(input_tensors_.size());
+  }
+  for (size_t i = 0; i < input_tensors_.size(); i++) {
+    const auto& dims = input_tensors_[i]->dims();
+    const auto& lod = input_tensors_[i]->lod();
+    if (changed || last_input_dims_[i] != dims || last_input_lods_[i] != lod) {
+      changed = true;
+      last_input_dims_[i] = dims;
+      last_input_lods_[i] = lod;
+    }
+  }
+  return changed;
+}
+
+void RuntimeProgram::SetRnnSessions(const std::vector<int64_t>& session_ids) {
+  bool was_enabled = rnn_stream_state_.enabled();
+  rnn_stream_state_.set_sessions(session_ids);
+  if (was_enabled == rnn_stream_state_.enabled()) return;
+  if (rnn_stream_state_.enabled()) {
+    for (auto& inst : instructions_[kRootBlockIdx]) {
+      auto* op = const_cast<OpLite*>(inst.op());
+      if (RnnStreamState::IsStreamOp(op->Type())) {
+        rnn_stream_state_.Prepare(op, inst.mutable_kernel());
+      }
+    }
+  }
+  // The initial state inputs are added or removed.
+  PlanStaticShapes();
+}
+
+std::vector<std::pair<std::string, float>> RuntimeProgram::Prepare(
+    int threads) {
+  WorkSpace::Binding workspace_binding(&workspace_);
+  // The output shapes of the shape-static and the run-once instructions only
+  // depend on the shapes of the program inputs, see PlanStaticShapes(), so
+  // they are inferred in order without running the kernels.
+  std::vector<Instruction*> insts;
+  for (auto& inst : instructions_[kRootBlockIdx]) {
+#if !defined(LITE_WITH_FPGA) && !defined(LITE_WITH_METAL)
+    if (inst.is_feed_fetch_op()) continue;
+#endif
+    if (!inst.is_shape_static() && !inst.op()->run_once()) continue;
+    inst.InferShapeBeforeRun();
+    insts.push_back(&inst);
+  }
+
+  std::vector<float> times(insts.size(), 0.f);
+  auto PrepareKernel = [&](size_t i) {
+    profile::Timer timer;
+    timer.Start();
+    insts[i]->mutable_kernel()->PrepareOnce();
+    times[i] = timer.Stop();
+  };
+#ifdef LITE_WITH_ARM
+  // The run mode of DeviceInfo is thread local, and the arm kernels read the
+  // arch and the caches of the active cores when they are prepared, so the
+  // workers take the run mode of the caller.
+  auto mode = DeviceInfo::Global().mode();
+  int mode_threads = DeviceInfo::Global().threads();
+#endif
+  auto SetWorkerRunMode = [&]() {
+#ifdef LITE_WITH_ARM
+    DeviceInfo::Global().SetRunMode(mode, mode_threads);
+#endif
+#ifdef _OPENMP
+    // The kernels are prepared in parallel rather than their loops.
+    omp_set_num_threads(1);
+#endif
+  };
+  // The host kernels only touch their own states. The NNAdapter subgraph
+  // kernels own their device contexts and compile their device programs when
+  // they are prepared, so each of them is compiled by a thread of its own
+  // while the host kernels are prepared. The others, e.g. the gpu kernels,
+  // share the device states, so they are prepared in order by the caller.
+  std::vector<size_t> host_insts;
+  std::vector<std::thread> compilers;
+  for (size_t i = 0; i < insts.size(); i++) {
+    auto target = insts[i]->kernel()->target();
+    if (target == TARGET(kARM) || target == TARGET(kX86) ||
+        target == TARGET(kHost)) {
+      host_insts.push_back(i);
+    } else if (target == TARGET(kNNAdapter)) {
+      compilers.emplace_back([&, i]() {
+        SetWorkerRunMode();
+        PrepareKernel(i);
+      });
+    } else {
+      PrepareKernel(i);
+    }
+  }
+#ifdef LITE_USE_THREAD_POOL
+  // The thread pool can't be entered by several threads at the same time.
+  threads = 1;
+#endif
+  int workers_num = std::min(threads, static_cast<int>(host_insts.size()));
+  if (workers_num <= 1) {
+    for (auto i : host_insts) {
+      PrepareKernel(i);
+    }
+  } else {
+    std::atomic<size_t> next{0};
+    std::vector<std::thread> workers;
+    for (int t = 0; t < workers_num; t++) {
+      workers.emplace_back([&]() {
+        SetWorkerRunMode();
+        for (size_t k = next++; k < host_insts.size(); k = next++) {
+          PrepareKernel(host_insts[k]);
+        }
+      });
+    }
+    for (auto& worker : workers) {
+      worker.join();
+    }
+  }
+  for (auto& compiler : compilers) {
+    compiler.join();
+  }
+
+  std::vector<std::pair<std::string, float>> summary;
+  float total = 0.f;
+  for (size_t i = 0; i < insts.size(); i++) {
+    auto name = insts[i]->kernel()->SerializedKernelType();
+    VLOG(3) << "prepare " << name << ": " << times[i] << " ms";
+    summary.emplace_back(name, times[i]);
+    total += times[i];
+  }
+  LOG(INFO) << "prepared " << insts.size() << " kernels with " << workers_num
+            << " threads, " << total << " ms in total";
+  return summary;
+}
+
 void RuntimeProgram::Run() {
 #ifdef LITE_WITH_PRECISION_PROFILE
   auto inst_precision_profiler = paddle::lite::profile::PrecisionProfiler();
@@ -416,6 +626,14 @@ void RuntimeProgram::Run() {
   monitor.inferStart();
 #endif
 
+  // The kernels share the workspace of the program, and the ones of the
+  // sub-blocks share the one of the main program.
+  WorkSpace::Binding workspace_binding(&workspace_);
+
+  // The output shapes of the shape-static instructions are reused while the
+  // shapes of the program inputs are the same as the last run.
+  bool reuse_shapes = !InputShapesChanged();
+
   int idx = -1;
 
   auto& insts = instructions_[kRootBlockIdx];
@@ -424,6 +642,7 @@ void RuntimeProgram::Run() {
 #if !defined(LITE_WITH_FPGA) && !defined(LITE_WITH_METAL)
     if (inst.is_feed_fetch_op()) continue;
 #endif
+    inst.set_reuse_shapes(reuse_shapes);
 #ifdef LITE_WITH_NVTX
     NVTXRangeAnnotation annotation = annotator.AnnotateBlock();
     nvtxStringHandle_t registered_name = register_layer_names_[idx];
@@ -446,8 +665,18 @@ void RuntimeProgram::Run() {
     inst.Flush(idx);
 #endif
 
+    bool is_rnn_stream = rnn_stream_state_.enabled() &&
+                         RnnStreamState::IsStreamOp(inst.op()->Type());
+    if (is_rnn_stream) {
+      rnn_stream_state_.Load(const_cast<OpLite*>(inst.op()));
+    }
+
     inst.Run();
 
+    if (is_rnn_stream) {
+      rnn_stream_state_.Save(const_cast<OpLite*>(inst.op()));
+    }
+
 #ifdef LITE_WITH_FPGA
     monitor.postRun(inst);
 #endif
@@ -471,6 +700,8 @@ void RuntimeProgram::Run() {
 
 #ifdef LITE_WITH_PROFILE
   LOG(INFO) << "\n" << profiler_.Summary(profile::Type::kDispatch, false, 1);
+  LOG(INFO) << "workspace high-water mark: " << workspace_.high_water_mark()
+            << " bytes";
 #endif
 #ifdef LITE_WITH_PRECISION_PROFILE
   LOG(INFO) << "\n"
@@ -631,6 +862,15 @@ void Instruction::SaveOutput() {
 }
 #endif
 
+void Instruction::InferShapeBeforeRun() {
+  CHECK(op_) << "op null";
+  if (first_epoch_) {
+    first_epoch_ = false;
+    CHECK(op_->CheckShape());
+  }
+  op_->InferShape();
+}
+
 void Instruction::Run() {
 #ifdef LITE_WITH_PROFILE
   CHECK(profiler_) << "Profiler pointer of kernel can not be nullptr. "
@@ -651,7 +891,22 @@ void Instruction::Run() {
     return;
   }
 
-  op_->InferShape();
+  if (reuse_shapes_ && !last_output_dims_.empty()) {
+    for (size_t i = 0; i < static_shape_outputs_.size(); i++) {
+      static_shape_outputs_[i]->Resize(last_output_dims_[i]);
+      static_shape_outputs_[i]->set_lod(last_output_lods_[i]);
+    }
+  } else {
+    op_->InferShape();
+    if (is_shape_static_) {
+      last_output_dims_.clear();
+      last_output_lods_.clear();
+      for (auto* output : static_shape_outputs_) {
+        last_output_dims_.push_back(output->dims());
+        last_output_lods_.push_back(output->lod());
+      }
+    }
+  }
   kernel_->Launch();
   has_run_ = true;
 
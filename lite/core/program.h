@@ -22,6 +22,8 @@
 #include "lite/core/kernel.h"
 #include "lite/core/op_lite.h"
 #include "lite/core/op_registry.h"
+#include "lite/core/rnn_stream_state.h"
+#include "lite/core/workspace.h"
 #include "lite/model_parser/cpp_desc.h"
 #ifdef LITE_WITH_PROFILE
 #include "lite/core/profile/profiler.h"
@@ -118,6 +120,9 @@ struct Instruction {
 
   // Run the instruction.
   void Run();
+  // Check and infer the output shapes ahead of the first run, so that the
+  // kernel can be prepared, see RuntimeProgram::Prepare.
+  void InferShapeBeforeRun();
 #ifdef LITE_WITH_METAL
   void SaveOutput();
 #endif
@@ -130,6 +135,21 @@ struct Instruction {
 
   bool is_feed_fetch_op() const { return is_feed_fetch_op_; }
 
+  // Mark the instruction as shape-static, the shapes of its outputs only
+  // depend on the shapes of the program inputs, and they are recorded after
+  // InferShape and reused while the program input shapes are unchanged.
+  void set_static_shape_outputs(const std::vector<Tensor*>& outputs) {
+    is_shape_static_ = true;
+    static_shape_outputs_ = outputs;
+    last_output_dims_.clear();
+    last_output_lods_.clear();
+  }
+  bool is_shape_static() const { return is_shape_static_; }
+  // Skip InferShape in the next Run if the output shapes have been recorded.
+  void set_reuse_shapes(bool reuse_shapes) {
+    reuse_shapes_ = reuse_shapes && is_shape_static_;
+  }
+
 #ifdef LITE_WITH_CUDA
   bool need_sync() const {
     if (kernel_->target() == TargetType::kCUDA) {
@@ -185,6 +205,12 @@ struct Instruction {
   bool is_feed_fetch_op_{false};
   bool first_epoch_{true};
   bool has_run_{false};
+  // For the whole-program shape propagation, see RuntimeProgram::Run().
+  bool is_shape_static_{false};
+  bool reuse_shapes_{false};
+  std::vector<Tensor*> static_shape_outputs_;
+  std::vector<DDim> last_output_dims_;
+  std::vector<LoD> last_output_lods_;
 
 #ifdef LITE_WITH_PROFILE
   profile::Profiler* profiler_;
@@ -222,6 +248,7 @@ class LITE_API RuntimeProgram {
     if (instructions_.empty()) {
       LOG(FATAL) << "no instructions";
     }
+    PlanStaticShapes();
 #ifdef LITE_WITH_PROFILE
     set_profiler();
 #endif
@@ -304,6 +331,29 @@ class LITE_API RuntimeProgram {
 
   const int64_t get_version() const { return version_; }
 
+  // Run the preparation of the kernels of the main block, e.g. the weight
+  // transforms, ahead of the first Run, the host kernels are prepared by
+  // `threads` workers in parallel, and the NNAdapter subgraphs are compiled
+  // in parallel with them. The program inputs should be resized as for Run,
+  // and be filled so that their precisions are known. Only the kernels whose
+  // input shapes don't depend on the data computed by the other kernels are
+  // prepared, the rest are still prepared at the first Run. Returns the
+  // milliseconds spent by each kernel.
+  std::vector<std::pair<std::string, float>> Prepare(int threads);
+
+  // Run the lstm, gru and rnn ops of the main block as the streaming sessions,
+  // the i-th sequence of the next runs belongs to session_ids[i]. The empty
+  // list turns off the streaming mode. See RnnStreamState for the details.
+  void SetRnnSessions(const std::vector<int64_t>& session_ids);
+  // Drop the hidden and cell states of a finished session.
+  void ReleaseRnnSession(int64_t session_id) {
+    rnn_stream_state_.Release(session_id);
+  }
+
+  // The scratch memory shared by the kernels, whose high-water mark is the
+  // size planned by the first Run.
+  WorkSpace* workspace() { return &workspace_; }
+
 #ifndef LITE_ON_TINY_PUBLISH
   // Update the ops and vars of all of blocks to the given program_desc
   // according to the instructions
@@ -321,9 +371,24 @@ class LITE_API RuntimeProgram {
 
  private:
   RuntimeProgram(const RuntimeProgram&) = delete;
+  // Infer which instructions of the main block are shape-static and collect
+  // the program inputs their shapes are determined by.
+  void PlanStaticShapes();
+  // Return true if the shapes or lods of the program inputs are different from
+  // the last run, and record the current ones.
+  bool InputShapesChanged();
+
   std::vector<std::vector<Instruction>> instructions_;
   Scope* exec_scope_{};
   int64_t version_{0};
+  // The tensors read by the main block before being written by it, such as
+  // the feed targets and the weights.
+  std::vector<const Tensor*> input_tensors_;
+  std::vector<DDim> last_input_dims_;
+  std::vector<LoD> last_input_lods_;
+  RnnStreamState rnn_stream_state_;
+  // The scratch memory of the kernels, which is bound to the thread of Run.
+  WorkSpace workspace_;
 
 #ifdef LITE_WITH_METAL
   std::unique_ptr<KernelContext> metal_ctx_{nullptr};
@@ -0,0 +1,152 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/program.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+#include "lite/api/paddle_use_kernels.h"
+#include "lite/api/paddle_use_ops.h"
+#include "lite/api/paddle_use_passes.h"
+#include "lite/core/optimizer/mir/pass_test_helper.h"
+
+namespace paddle {
+namespace lite {
+
+// Whether the instructions of the ops are shape-static, by the op types.
+std::map<std::string, bool> GetShapeStatic(const Predictor& predictor) {
+  std::map<std::string, bool> is_shape_static;
+  for (auto& inst : predictor.runtime_program().instructions()) {
+    auto type = inst.op()->op_info()->Type();
+    if (type != "feed" && type != "fetch") {
+      is_shape_static[type] = inst.is_shape_static();
+    }
+  }
+  return is_shape_static;
+}
+
+std::vector<float> FeedRandom(Predictor* predictor,
+                              const std::vector<int64_t>& shape,
+                              const LoD& lod = {}) {
+  std::mt19937 gen(shape.size());
+  std::uniform_real_distribution<float> dis(-2.f, 2.f);
+  auto* input = predictor->GetInput(0);
+  input->Resize(shape);
+  input->set_lod(lod);
+  auto* data = input->mutable_data<float>();
+  for (int64_t i = 0; i < input->numel(); i++) {
+    data[i] = dis(gen);
+  }
+  return std::vector<float>(data, data + input->numel());
+}
+
+void AddScale(mir::TestProgramBuilder* builder,
+              const std::string& x,
+              const std::string& out) {
+  auto* scale = builder->AddOp("scale", {{"X", {x}}}, {{"Out", {out}}});
+  scale->SetAttr<float>("scale", 2.f);
+  scale->SetAttr<float>("bias", 1.f);
+  scale->SetAttr<bool>("bias_after_scale", true);
+}
+
+// The shapes of all of the ops only depend on the shape of the input, they
+// are inferred again only when the input shape or lod changes.
+TEST(RuntimeProgram, static_shapes) {
+  mir::TestProgramBuilder builder;
+  builder.AddInput("x");
+  builder.AddOp("relu", {{"X", {"x"}}}, {{"Out", {"relu_out"}}});
+  builder.AddOp("softmax", {{"X", {"relu_out"}}}, {{"Out", {"softmax_out"}}})
+      ->SetAttr<int>("axis", -1);
+  AddScale(&builder, "softmax_out", "out");
+  builder.AddOutput("out");
+  builder.AddOutput("softmax_out");
+  auto predictor = builder.Build(mir::GetTestPlaces());
+  auto is_shape_static = GetShapeStatic(*predictor);
+  EXPECT_EQ(is_shape_static.size(), 3u);
+  for (auto& op : is_shape_static) {
+    EXPECT_TRUE(op.second) << op.first;
+  }
+
+  // The same shape twice, then the other shapes and lods.
+  const std::vector<std::vector<int64_t>> shapes{
+      {2, 3, 4}, {2, 3, 4}, {3, 5}, {3, 5}, {6, 5}, {6, 5}};
+  const std::vector<LoD> lods{{}, {}, {}, {{0, 1, 3}}, {{0, 2, 6}}, {{0, 6}}};
+  for (size_t i = 0; i < shapes.size(); i++) {
+    auto x = FeedRandom(predictor.get(), shapes[i], lods[i]);
+    predictor->Run();
+    auto* out = predictor->GetOutput(0);
+    ASSERT_EQ(out->dims(), DDim(shapes[i])) << "run " << i;
+    // The lod is kept by the softmax, but not by the scale.
+    EXPECT_EQ(predictor->GetOutput(1)->lod(), lods[i]) << "run " << i;
+    int64_t width = shapes[i].back();
+    for (int64_t row = 0; row < out->numel() / width; row++) {
+      std::vector<float> exp(width);
+      float sum = 0.f;
+      for (int64_t j = 0; j < width; j++) {
+        exp[j] = std::exp(std::max(x[row * width + j], 0.f));
+        sum += exp[j];
+      }
+      for (int64_t j = 0; j < width; j++) {
+        EXPECT_NEAR(out->data<float>()[row * width + j],
+                    exp[j] / sum * 2.f + 1.f,
+                    1e-5)
+            << "run " << i << ", index " << row * width + j;
+      }
+    }
+  }
+}
+
+// The output shape of the reshape depends on the data of its Shape input, so
+// it and the following ops are inferred in every run, even if the shapes of
+// the inputs are unchanged.
+TEST(RuntimeProgram, dynamic_shapes) {
+  mir::TestProgramBuilder builder;
+  builder.AddInput("x");
+  builder.AddInput("shape");
+  builder.AddOp("relu", {{"X", {"x"}}}, {{"Out", {"relu_out"}}});
+  builder
+      .AddOp("reshape2",
+             {{"X", {"relu_out"}}, {"Shape", {"shape"}}},
+             {{"Out", {"reshape_out"}}, {"XShape", {"reshape_xshape"}}})
+      ->SetAttr<std::vector<int>>("shape", {});
+  AddScale(&builder, "reshape_out", "out");
+  builder.AddOutput("out");
+  auto predictor = builder.Build(mir::GetTestPlaces());
+  auto is_shape_static = GetShapeStatic(*predictor);
+  EXPECT_TRUE(is_shape_static["relu"]);
+  EXPECT_FALSE(is_shape_static["reshape2"]);
+  EXPECT_FALSE(is_shape_static["scale"]);
+
+  const std::vector<std::vector<int>> shapes{{6, 4}, {6, 4}, {4, 6}, {24, 1}};
+  for (size_t i = 0; i < shapes.size(); i++) {
+    auto x = FeedRandom(predictor.get(), {2, 3, 4});
+    auto* shape = predictor->GetInput(1);
+    shape->Resize({2});
+    std::copy(shapes[i].begin(), shapes[i].end(), shape->mutable_data<int>());
+    predictor->Run();
+    auto* out = predictor->GetOutput(0);
+    ASSERT_EQ(out->dims(), DDim({shapes[i][0], shapes[i][1]})) << "run " << i;
+    for (int64_t j = 0; j < out->numel(); j++) {
+      EXPECT_NEAR(out->data<float>()[j], std::max(x[j], 0.f) * 2.f + 1.f, 1e-5)
+          << "run " << i << ", index " << j;
+    }
+  }
+}
+
+}  // namespace lite
+}  // namespace paddle
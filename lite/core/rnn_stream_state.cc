@@ -0,0 +1,221 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/rnn_stream_state.h"
+#include <algorithm>
+#include <set>
+
+namespace paddle {
+namespace lite {
+
+void RnnStreamState::set_sessions(const std::vector<int64_t>& session_ids) {
+  std::set<int64_t> unique_ids(session_ids.begin(), session_ids.end());
+  CHECK_EQ(unique_ids.size(), session_ids.size())
+      << "The rnn session ids should be unique.";
+  sessions_ = session_ids;
+  if (sessions_.empty()) {
+    for (auto& prepared_op : prepared_ops_) {
+      prepared_op.op->Attach(prepared_op.origin_desc,
+                             prepared_op.op->scope());
+      prepared_op.op->AttachKernel(prepared_op.kernel);
+    }
+    prepared_ops_.clear();
+  }
+}
+
+void RnnStreamState::Release(int64_t session_id) {
+  for (auto& key_states : states_) {
+    key_states.second.erase(session_id);
+  }
+}
+
+void RnnStreamState::Prepare(OpLite* op, KernelBase* kernel) {
+  CHECK(IsStreamOp(op->Type()));
+  CHECK(kernel->target() == TARGET(kARM) ||
+        kernel->target() == TARGET(kX86) || kernel->target() == TARGET(kHost))
+      << "The streaming " << op->Type() << " is only supported on the host, "
+      << "but got the kernel " << kernel->name();
+  // The int8 lstm and gru kernels only quantize the weights, their H0, C0,
+  // Hidden and Cell are float as the ones of the float kernels.
+  CHECK(kernel->precision() == PRECISION(kFloat) ||
+        (kernel->precision() == PRECISION(kInt8) && op->Type() != "rnn"))
+      << "The streaming " << op->Type()
+      << " only supports the float states, but got the kernel "
+      << kernel->name();
+  auto* op_info = op->op_info();
+  if (op->Type() == "rnn") {
+    CHECK(!op_info->GetAttr<bool>("is_bidirec"))
+        << "The bidirectional rnn can't be run as the streaming sessions.";
+    // The PreState of the rnn op is always given.
+    return;
+  }
+  // The reverse recurrence starts from the last step of the whole sequence,
+  // which isn't known until the last chunk.
+  CHECK(!op_info->GetAttr<bool>("is_reverse"))
+      << "The reverse " << op->Type()
+      << " can't be run as the streaming sessions.";
+  cpp::OpDesc desc = *op_info;
+  bool changed = false;
+  auto AddInitState = [&](const std::string& input_arg,
+                          const std::string& output_arg) {
+    if (desc.HasInput(input_arg) && !desc.Input(input_arg).empty()) return;
+    auto name = desc.Output(output_arg).front() + "@stream_init";
+    op->scope()->Var(name)->GetMutable<Tensor>();
+    desc.SetInput(input_arg, {name});
+    changed = true;
+  };
+  AddInitState("H0", "Hidden");
+  if (op->Type() == "lstm") {
+    AddInitState("C0", "Cell");
+  }
+  if (!changed) return;
+  prepared_ops_.push_back({op, kernel, *op_info});
+  op->Attach(desc, op->scope());
+  op->AttachKernel(kernel);
+}
+
+void RnnStreamState::Load(OpLite* op) {
+  auto* op_info = op->op_info();
+  auto* scope = op->scope();
+  int64_t num_sessions = static_cast<int64_t>(sessions_.size());
+  if (op->Type() == "rnn") {
+    auto* input = scope->FindTensor(op_info->Input("Input").front());
+    CHECK_EQ(input->dims()[1], num_sessions)
+        << "The batch size of the rnn should be equal to the number of the "
+           "sessions.";
+    auto pre_states = op_info->Input("PreState");
+    auto states = op_info->Output("State");
+    CHECK_EQ(pre_states.size(), states.size());
+    int64_t num_layers = op_info->GetAttr<int>("num_layers");
+    int64_t hidden_size = op_info->GetAttr<int>("hidden_size");
+    for (size_t i = 0; i < states.size(); i++) {
+      Gather(states[i],
+             DDim({num_layers, num_sessions, hidden_size}),
+             scope->FindMutableTensor(pre_states[i]));
+    }
+    return;
+  }
+  auto* input = scope->FindTensor(op_info->Input("Input").front());
+  CHECK(!input->lod().empty());
+  CHECK_EQ(static_cast<int64_t>(input->lod().back().size()) - 1,
+           num_sessions)
+      << "The number of the sequences of the " << op->Type()
+      << " should be equal to the number of the sessions.";
+  auto* weight = scope->FindTensor(op_info->Input("Weight").front());
+  int64_t frame_size = weight->dims()[0];
+  DDim state_dims({num_sessions, frame_size});
+  Gather(op_info->Output("Hidden").front(),
+         state_dims,
+         scope->FindMutableTensor(op_info->Input("H0").front()));
+  if (op->Type() == "lstm") {
+    Gather(op_info->Output("Cell").front(),
+           state_dims,
+           scope->FindMutableTensor(op_info->Input("C0").front()));
+  }
+}
+
+void RnnStreamState::Save(OpLite* op) {
+  auto* op_info = op->op_info();
+  auto* scope = op->scope();
+  if (op->Type() == "rnn") {
+    for (auto& name : op_info->Output("State")) {
+      Scatter(name, *scope->FindTensor(name));
+    }
+    return;
+  }
+  auto lod = scope->FindTensor(op_info->Input("Input").front())->lod();
+  auto hidden = op_info->Output("Hidden").front();
+  ScatterLastSteps(hidden, *scope->FindTensor(hidden), lod);
+  if (op->Type() == "lstm") {
+    auto cell = op_info->Output("Cell").front();
+    ScatterLastSteps(cell, *scope->FindTensor(cell), lod);
+  }
+}
+
+void RnnStreamState::Gather(const std::string& key,
+                            const DDim& dims,
+                            Tensor* state) {
+  CHECK(state);
+  CHECK_GE(dims.size(), 2u);
+  int64_t num_sessions = dims[dims.size() - 2];
+  int64_t width = dims[dims.size() - 1];
+  int64_t slices = dims.count(0, dims.size() - 2);
+  state->Resize(dims);
+  state->set_lod({});
+  auto* state_data = state->mutable_data<float>();
+  auto& key_states = states_[key];
+  for (int64_t i = 0; i < num_sessions; i++) {
+    auto it = key_states.find(sessions_[i]);
+    bool found = it != key_states.end();
+    if (found) {
+      CHECK_EQ(static_cast<int64_t>(it->second.size()), slices * width)
+          << "The state size of " << key << " is changed.";
+    }
+    for (int64_t s = 0; s < slices; s++) {
+      float* dst = state_data + (s * num_sessions + i) * width;
+      if (found) {
+        std::copy_n(it->second.data() + s * width, width, dst);
+      } else {
+        std::fill_n(dst, width, 0.f);
+      }
+    }
+  }
+}
+
+void RnnStreamState::Scatter(const std::string& key, const Tensor& state) {
+  auto dims = state.dims();
+  CHECK_GE(dims.size(), 2u);
+  int64_t num_sessions = dims[dims.size() - 2];
+  int64_t width = dims[dims.size() - 1];
+  int64_t slices = dims.count(0, dims.size() - 2);
+  CHECK_EQ(num_sessions, static_cast<int64_t>(sessions_.size()));
+  CHECK(state.precision() == PRECISION(kFloat))
+      << "The state " << key << " should be float, but got "
+      << lite_api::PrecisionToStr(state.precision());
+  auto* state_data = state.data<float>();
+  auto& key_states = states_[key];
+  for (int64_t i = 0; i < num_sessions; i++) {
+    auto& session_state = key_states[sessions_[i]];
+    session_state.resize(slices * width);
+    for (int64_t s = 0; s < slices; s++) {
+      std::copy_n(state_data + (s * num_sessions + i) * width,
+                  width,
+                  session_state.data() + s * width);
+    }
+  }
+}
+
+void RnnStreamState::ScatterLastSteps(const std::string& key,
+                                      const Tensor& hidden,
+                                      const LoD& lod) {
+  CHECK(!lod.empty());
+  auto& offsets = lod.back();
+  int64_t width = hidden.dims()[1];
+  CHECK(hidden.precision() == PRECISION(kFloat))
+      << "The state " << key << " should be float, but got "
+      << lite_api::PrecisionToStr(hidden.precision());
+  auto* hidden_data = hidden.data<float>();
+  auto& key_states = states_[key];
+  for (size_t i = 0; i + 1 < offsets.size(); i++) {
+    // The session without the new steps keeps its states.
+    if (offsets[i] == offsets[i + 1]) continue;
+    size_t step = offsets[i + 1] - 1;
+    auto& session_state = key_states[sessions_[i]];
+    session_state.assign(hidden_data + step * width,
+                         hidden_data + (step + 1) * width);
+  }
+}
+
+}  // namespace lite
+}  // namespace paddle
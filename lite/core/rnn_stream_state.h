@@ -0,0 +1,88 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <map>
+#include <string>
+#include <vector>
+#include "lite/core/kernel.h"
+#include "lite/core/op_lite.h"
+#include "lite/core/tensor.h"
+
+namespace paddle {
+namespace lite {
+
+/*
+ * RnnStreamState keeps the final hidden and cell states of the lstm, gru and
+ * rnn ops between the runs, so that the long sequences of many concurrent
+ * sessions can be fed step by step or chunk by chunk.
+ *
+ * The i-th sequence of a run belongs to the i-th session set by
+ * `set_sessions()`, it's the i-th lod sequence of the lstm and gru ops and the
+ * i-th batch of the rnn op. Since all of the sessions are run in one batch,
+ * their steps share the same GEMM calls of the kernels.
+ *
+ * Before an op runs, the states of its sessions are gathered into the initial
+ * state inputs(H0, C0 or PreState), the sessions never seen before start from
+ * zeros. After the op runs, the states of the last steps are scattered back.
+ */
+class RnnStreamState {
+ public:
+  // Whether the op keeps its states in the streaming mode.
+  static bool IsStreamOp(const std::string& op_type) {
+    return op_type == "lstm" || op_type == "gru" || op_type == "rnn";
+  }
+
+  // Set the sessions of the next runs, the empty list turns off the streaming
+  // mode and restores the ops.
+  void set_sessions(const std::vector<int64_t>& session_ids);
+  const std::vector<int64_t>& sessions() const { return sessions_; }
+  bool enabled() const { return !sessions_.empty(); }
+
+  // Drop the states of a finished session.
+  void Release(int64_t session_id);
+
+  // Add the missing initial state inputs to the op and re-attach its kernel,
+  // it should be called once for each stream op before it runs.
+  void Prepare(OpLite* op, KernelBase* kernel);
+
+  // Gather the states of the sessions into the initial state inputs.
+  void Load(OpLite* op);
+  // Scatter the final states of the sessions from the outputs.
+  void Save(OpLite* op);
+
+ private:
+  // The state tensor is viewed as [slices, sessions, width].
+  void Gather(const std::string& key, const DDim& dims, Tensor* state);
+  void Scatter(const std::string& key, const Tensor& state);
+  // The lstm and gru ops output the states of all of the steps, only the
+  // last step of each lod sequence is saved.
+  void ScatterLastSteps(const std::string& key,
+                        const Tensor& hidden,
+                        const LoD& lod);
+
+  std::vector<int64_t> sessions_;
+  // The states of the sessions, indexed by the output name of the states.
+  std::map<std::string, std::map<int64_t, std::vector<float>>> states_;
+  // The ops whose initial state inputs are added by `Prepare()`.
+  struct PreparedOp {
+    OpLite* op;
+    KernelBase* kernel;
+    cpp::OpDesc origin_desc;
+  };
+  std::vector<PreparedOp> prepared_ops_;
+};
+
+}  // namespace lite
+}  // namespace paddle
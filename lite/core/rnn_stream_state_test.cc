@@ -0,0 +1,218 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/rnn_stream_state.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+#include "lite/api/paddle_use_kernels.h"
+#include "lite/api/paddle_use_ops.h"
+#include "lite/api/paddle_use_passes.h"
+#include "lite/core/optimizer/mir/pass_test_helper.h"
+
+namespace paddle {
+namespace lite {
+
+using Sequence = std::vector<std::vector<float>>;
+// The steps [begin, end) of a sequence.
+struct Chunk {
+  const Sequence* sequence;
+  size_t begin;
+  size_t end;
+};
+
+const int64_t kFrameSize = 8;
+
+// Builds a gru or lstm op whose hidden (and cell) states are fetched.
+void BuildRnn(mir::TestProgramBuilder* builder,
+              const std::string& type,
+              bool is_reverse = false) {
+  int64_t gates = type == "gru" ? 3 : 4;
+  builder->AddInput("x");
+  builder->AddWeight("w", {kFrameSize, gates * kFrameSize});
+  builder->AddWeight("b", {1, gates * kFrameSize});
+  if (type == "gru") {
+    auto* gru =
+        builder->AddOp("gru",
+                       {{"Input", {"x"}}, {"Weight", {"w"}}, {"Bias", {"b"}}},
+                       {{"BatchGate", {"batch_gate"}},
+                        {"BatchResetHiddenPrev", {"batch_reset"}},
+                        {"BatchHidden", {"batch_hidden"}},
+                        {"Hidden", {"hidden"}}});
+    gru->SetAttr<std::string>("activation", "tanh");
+    gru->SetAttr<std::string>("gate_activation", "sigmoid");
+    gru->SetAttr<bool>("is_reverse", is_reverse);
+    gru->SetAttr<bool>("origin_mode", false);
+    builder->AddOutput("hidden");
+  } else {
+    auto* lstm =
+        builder->AddOp("lstm",
+                       {{"Input", {"x"}}, {"Weight", {"w"}}, {"Bias", {"b"}}},
+                       {{"Hidden", {"hidden"}},
+                        {"Cell", {"cell"}},
+                        {"BatchGate", {"batch_gate"}},
+                        {"BatchCellPreAct", {"batch_cell_pre_act"}}});
+    lstm->SetAttr<bool>("use_peepholes", false);
+    lstm->SetAttr<bool>("is_reverse", is_reverse);
+    lstm->SetAttr<std::string>("gate_activation", "sigmoid");
+    lstm->SetAttr<std::string>("cell_activation", "tanh");
+    lstm->SetAttr<std::string>("candidate_activation", "tanh");
+    builder->AddOutput("hidden");
+    builder->AddOutput("cell");
+  }
+}
+
+Sequence RandomSequence(size_t steps, int64_t width, std::mt19937* gen) {
+  std::uniform_real_distribution<float> dis(-1.f, 1.f);
+  Sequence sequence(steps, std::vector<float>(width));
+  for (auto& step : sequence) {
+    for (auto& v : step) v = dis(*gen);
+  }
+  return sequence;
+}
+
+// Feeds the chunks as the lod sequences of one run, and returns the steps of
+// the chunks in the outputs.
+std::vector<std::vector<Sequence>> RunChunks(Predictor* predictor,
+                                             const std::vector<Chunk>& chunks,
+                                             int num_outputs) {
+  std::vector<uint64_t> offsets{0};
+  for (auto& chunk : chunks) {
+    offsets.push_back(offsets.back() + chunk.end - chunk.begin);
+  }
+  int64_t width = chunks.front().sequence->front().size();
+  auto* input = predictor->GetInput(0);
+  input->Resize({static_cast<int64_t>(offsets.back()), width});
+  input->set_lod({offsets});
+  auto* data = input->mutable_data<float>();
+  for (auto& chunk : chunks) {
+    for (size_t i = chunk.begin; i < chunk.end; i++) {
+      data = std::copy(
+          (*chunk.sequence)[i].begin(), (*chunk.sequence)[i].end(), data);
+    }
+  }
+  predictor->Run();
+  std::vector<std::vector<Sequence>> results(num_outputs);
+  for (int i = 0; i < num_outputs; i++) {
+    auto* output = predictor->GetOutput(i);
+    EXPECT_EQ(output->dims()[0], static_cast<int64_t>(offsets.back()));
+    const float* out_data = output->data<float>();
+    for (size_t j = 0; j + 1 < offsets.size(); j++) {
+      Sequence steps;
+      for (uint64_t k = offsets[j]; k < offsets[j + 1]; k++) {
+        steps.emplace_back(out_data + k * kFrameSize,
+                           out_data + (k + 1) * kFrameSize);
+      }
+      results[i].push_back(steps);
+    }
+  }
+  return results;
+}
+
+// The outputs of the chunks are the steps [begin, end) of the reference.
+void CheckChunks(const std::vector<std::vector<Sequence>>& results,
+                 const std::vector<Chunk>& chunks,
+                 const std::vector<std::vector<Sequence>>& reference,
+                 const std::vector<int>& reference_ids) {
+  for (size_t i = 0; i < results.size(); i++) {
+    for (size_t j = 0; j < chunks.size(); j++) {
+      auto& expected = reference[i][reference_ids[j]];
+      for (size_t k = chunks[j].begin; k < chunks[j].end; k++) {
+        auto& step = results[i][j][k - chunks[j].begin];
+        for (int64_t l = 0; l < kFrameSize; l++) {
+          EXPECT_NEAR(step[l], expected[k][l], 1e-5)
+              << "output " << i << ", chunk " << j << ", step " << k;
+        }
+      }
+    }
+  }
+}
+
+// Feeds the sequences chunk by chunk over several runs, which get the same
+// outputs as the run of the whole sequences.
+void CheckRnnStream(const std::string& type) {
+  mir::TestProgramBuilder builder;
+  BuildRnn(&builder, type);
+  int num_outputs = type == "gru" ? 1 : 2;
+  int64_t gates = type == "gru" ? 3 : 4;
+  auto places = mir::GetTestPlaces();
+  auto predictor = builder.Build(places);
+  auto reference = builder.Build(places);
+
+  std::mt19937 gen(0);
+  auto a = RandomSequence(5, gates * kFrameSize, &gen);
+  auto b = RandomSequence(10, gates * kFrameSize, &gen);
+  auto c = RandomSequence(6, gates * kFrameSize, &gen);
+  auto expected =
+      RunChunks(reference.get(),
+                {{&a, 0, a.size()}, {&b, 0, b.size()}, {&c, 0, c.size()}},
+                num_outputs);
+
+  // The sessions 1 and 2 run a and b in two chunks.
+  predictor->SetRnnSessions({1, 2});
+  std::vector<Chunk> chunks{{&a, 0, 4}, {&b, 0, 2}};
+  CheckChunks(RunChunks(predictor.get(), chunks, num_outputs),
+              chunks,
+              expected,
+              {0, 1});
+  chunks = {{&a, 4, 5}, {&b, 2, 7}};
+  CheckChunks(RunChunks(predictor.get(), chunks, num_outputs),
+              chunks,
+              expected,
+              {0, 1});
+
+  // The released session 1 and the new session 4 start from zeros, with the
+  // session 2 continued in the other order of the sessions.
+  predictor->ReleaseRnnSession(1);
+  predictor->SetRnnSessions({4, 2, 1});
+  chunks = {{&c, 0, 2}, {&b, 7, 10}, {&c, 0, 3}};
+  CheckChunks(RunChunks(predictor.get(), chunks, num_outputs),
+              chunks,
+              expected,
+              {2, 1, 2});
+  predictor->SetRnnSessions({1});
+  chunks = {{&c, 3, 6}};
+  CheckChunks(RunChunks(predictor.get(), chunks, num_outputs),
+              chunks,
+              expected,
+              {2});
+
+  // The empty sessions restore the ops, whose states start from zeros.
+  predictor->SetRnnSessions({});
+  chunks = {{&c, 0, 6}, {&a, 0, 5}};
+  CheckChunks(RunChunks(predictor.get(), chunks, num_outputs),
+              chunks,
+              expected,
+              {2, 0});
+}
+
+TEST(RnnStreamState, gru) { CheckRnnStream("gru"); }
+
+// The reverse op needs the steps of the following chunks, so it's refused.
+TEST(RnnStreamState, reverse_gru) {
+  mir::TestProgramBuilder builder;
+  BuildRnn(&builder, "gru", true);
+  auto predictor = builder.Build(mir::GetTestPlaces());
+  ASSERT_DEATH(predictor->SetRnnSessions({1}), "");
+}
+
+#ifdef LITE_WITH_ARM
+// The lstm is only implemented on arm.
+TEST(RnnStreamState, lstm) { CheckRnnStream("lstm"); }
+#endif
+
+}  // namespace lite
+}  // namespace paddle
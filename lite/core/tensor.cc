@@ -29,6 +29,26 @@ void TensorLite::ShareDataWith(const TensorLite &other) {
   memory_size_ = other.memory_size_;
   precision_ = other.precision_;
   offset_ = other.offset_;
+  view_ = other.view_;
+  shared_ = true;
+}
+
+void TensorLite::ShareDataWith(const TensorLite &other,
+                               size_t offset,
+                               const DDimLite &dims) {
+  int64_t numel = other.numel();
+  CHECK_GT(numel, 0) << "Can't make a view of an empty tensor.";
+  size_t memory_size = dims.production() * (other.memory_size_ / numel);
+  CHECK_LE(offset + memory_size, other.memory_size_)
+      << "The view is out of the range of the shared tensor.";
+  // dims may be the dims of this tensor.
+  DDimLite view_dims = dims;
+  ShareDataWith(other);
+  dims_ = view_dims;
+  lod_.clear();
+  memory_size_ = memory_size;
+  offset_ = other.offset_ + offset;
+  view_ = true;
 }
 
 void TensorLite::CopyDataFrom(const TensorLite &other) {
@@ -38,13 +58,24 @@ void TensorLite::CopyDataFrom(const TensorLite &other) {
   memory_size_ = other.memory_size_;
   precision_ = other.precision_;
   persistable_ = other.persistable_;
-  buffer_->CopyDataFrom(*other.buffer_, memory_size_);
+  // Don't write into the data of the tensor shared by this one, e.g. the
+  // alias of a reshape or the first output of a split, even at offset 0.
+  if (shared_ || offset_ != 0) {
+    DetachBuffer();
+  }
+  if (other.offset_ == 0) {
+    buffer_->CopyDataFrom(*other.buffer_, memory_size_);
+  } else {
+    buffer_->ResetLazy(target_, memory_size_);
+    TargetCopy(target_, buffer_->data(), other.raw_data(), memory_size_);
+  }
 }
 
 void *TensorLite::mutable_data(size_t memory_size) {
+  DetachGrowingView(memory_size);
   memory_size_ = memory_size;
   buffer_->ResetLazy(target_, memory_size_);
-  return buffer_->data();
+  return raw_data();
 }
 
 void *TensorLite::mutable_data(TargetType target, size_t memory_size) {
@@ -68,6 +99,8 @@ void TensorLite::ResetBuffer(std::shared_ptr<Buffer> buffer,
         << "The buffer is smaller than the specified minimum size.";
   }
   buffer_ = buffer;
+  view_ = false;
+  shared_ = false;
   memory_size_ = memory_size;
   target_ = buffer->target();
 }
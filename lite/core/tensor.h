@@ -95,6 +95,7 @@ class TensorLite {
   template <typename T, typename R = T>
   R *mutable_data() {
     precision_ = lite_api::PrecisionTypeTrait<T>::Type();
+    DetachGrowingView(dims_.production() * sizeof(T));
     memory_size_ = dims_.production() * sizeof(T);
     buffer_->ResetLazy(target_, memory_size_);
     return reinterpret_cast<R *>(static_cast<char *>(buffer_->data()) +
@@ -189,6 +190,7 @@ class TensorLite {
     }
 #endif
     precision_ = lite_api::PrecisionTypeTrait<T>::Type();
+    DetachGrowingView(memory_size);
     memory_size_ = memory_size;
     buffer_->ResetLazy(target, memory_size_);
     target_ = target;
@@ -223,6 +225,30 @@ class TensorLite {
 
   // Other share data to this.
   void ShareDataWith(const TensorLite &other);
+  // Make this a view of the `dims` elements of other which start at the byte
+  // `offset` of other's data, nothing is copied.
+  void ShareDataWith(const TensorLite &other,
+                     size_t offset,
+                     const DDimLite &dims);
+  bool SharesBufferWith(const TensorLite &other) const {
+    return buffer_ == other.buffer_;
+  }
+  // Whether this is a view made by ShareDataWith(other, offset, dims).
+  bool is_view() const { return view_; }
+  // The bytes which can be written from the data without reallocation.
+  size_t capacity() const {
+    return buffer_->space() > offset_ ? buffer_->space() - offset_ : 0;
+  }
+  // Whether the buffer is shared from another tensor by ShareDataWith().
+  bool is_shared() const { return shared_; }
+  // Stop sharing the data with the other tensors, the next mutable_data()
+  // allocates the own memory.
+  void DetachBuffer() {
+    buffer_ = std::make_shared<Buffer>();
+    offset_ = 0;
+    view_ = false;
+    shared_ = false;
+  }
 
   void CopyDataFrom(const TensorLite &other);
 
@@ -261,6 +287,18 @@ class TensorLite {
 
   /// @brief Buffer may be shared with other tensors
   size_t offset_{0};
+  // A view never writes out of the viewed data, it gets its own buffer when
+  // it grows.
+  bool view_{false};
+  // The buffer is shared from another tensor, CopyDataFrom() never writes
+  // into it.
+  bool shared_{false};
+
+  void DetachGrowingView(size_t memory_size) {
+    if (view_ && memory_size > memory_size_) {
+      DetachBuffer();
+    }
+  }
 };
 
 template <typename T>
@@ -269,7 +307,9 @@ TensorLite TensorLite::Slice(int64_t begin, int64_t end) const {
   CHECK_LE(end, dims_[0]);
   CHECK_LT(begin, end);
   if (dims_[0] == 1) {
-    return *this;
+    TensorLite dst = *this;
+    dst.shared_ = true;
+    return dst;
   } else {
     int64_t base = numel() / dims_[0];
     TensorLite dst;
@@ -279,6 +319,7 @@ TensorLite TensorLite::Slice(int64_t begin, int64_t end) const {
     dst_dims[0] = end - begin;
     dst.Resize(dst_dims);
     dst.offset_ = offset_ + static_cast<size_t>(begin * base) * sizeof(T);
+    dst.shared_ = true;
     return dst;
   }
 }
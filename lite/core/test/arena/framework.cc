@@ -55,6 +55,8 @@ std::shared_ptr<lite::OpLite> TestCase::CreateSubgraphOp() {
 #elif defined(NNADAPTER_WITH_KUNLUNXIN_XTCL)
   ctx_->As<NNAdapterContext>().SetNNAdapterDeviceNames(scope,
                                                        {"kunlunxin_xtcl"});
+#elif defined(NNADAPTER_WITH_FAKE_DEVICE)
+  ctx_->As<NNAdapterContext>().SetNNAdapterDeviceNames(scope, {"fake_device"});
 #endif
   // Create a new block desc to wrap the original op desc
   auto sub_program_desc = std::make_shared<cpp::ProgramDesc>();
@@ -0,0 +1,116 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/workspace.h"
+#include <algorithm>
+#include <memory>
+
+namespace paddle {
+namespace lite {
+
+LITE_THREAD_LOCAL WorkSpace* WorkSpace::bound_ = nullptr;
+
+namespace {
+
+size_t AlignSize(size_t size) {
+  return (size + WorkSpace::kAlignment - 1) / WorkSpace::kAlignment *
+         WorkSpace::kAlignment;
+}
+
+}  // namespace
+
+void WorkSpace::AllocReset() {
+  Release(0);
+  if (high_water_mark_ > capacity_) {
+    Reserve(high_water_mark_);
+  }
+}
+
+core::byte_t* WorkSpace::Alloc(size_t size) {
+  size = AlignSize(size);
+  core::byte_t* data = nullptr;
+  if (cursor_ + size <= capacity_) {
+    data = data_ + cursor_;
+  } else {
+    data = static_cast<core::byte_t*>(TargetMalloc(TARGET(kHost), size));
+    blocks_.emplace_back(cursor_, data);
+  }
+  cursor_ += size;
+  high_water_mark_ = std::max(high_water_mark_, cursor_);
+  return data;
+}
+
+void WorkSpace::Release(size_t mark) {
+  while (!blocks_.empty() && blocks_.back().first >= mark) {
+    TargetFree(TARGET(kHost), blocks_.back().second);
+    blocks_.pop_back();
+  }
+  cursor_ = std::min(cursor_, mark);
+  extended_ = std::min(extended_, mark);
+}
+
+core::byte_t* WorkSpace::Extend(size_t size) {
+  size = AlignSize(size);
+  if (size > extended_) {
+    CHECK_EQ(cursor_, extended_)
+        << "The workspace should be extended before it's allocated.";
+    if (size > capacity_) {
+      Reserve(size);
+    }
+    extended_ = cursor_ = size;
+    high_water_mark_ = std::max(high_water_mark_, cursor_);
+  }
+  return data_;
+}
+
+void WorkSpace::Clear() {
+  Release(0);
+  high_water_mark_ = 0;
+  Reserve(0);
+}
+
+void WorkSpace::Reserve(size_t size) {
+  if (data_) {
+    TargetFree(TARGET(kHost), data_);
+    data_ = nullptr;
+  }
+  if (size > 0) {
+    data_ = static_cast<core::byte_t*>(TargetMalloc(TARGET(kHost), size));
+  }
+  capacity_ = size;
+}
+
+WorkSpace& WorkSpace::Current() {
+  if (bound_) {
+    return *bound_;
+  }
+  static LITE_THREAD_LOCAL std::unique_ptr<WorkSpace> x(new WorkSpace());
+  return *x;
+}
+
+WorkSpace::Binding::Binding(WorkSpace* workspace) {
+  if (!WorkSpace::bound_) {
+    WorkSpace::bound_ = workspace;
+    owner_ = true;
+  }
+}
+
+WorkSpace::Binding::~Binding() {
+  if (owner_) {
+    WorkSpace::bound_ = nullptr;
+  }
+}
+
+}  // namespace lite
+}  // namespace paddle
@@ -13,7 +13,8 @@
 // limitations under the License.
 
 #pragma once
-#include <memory>
+#include <utility>
+#include <vector>
 #include "lite/core/memory.h"
 #include "lite/core/types.h"
 #include "lite/utils/macros.h"
@@ -22,76 +23,95 @@ namespace paddle {
 namespace lite {
 
 /*
- * WorkSpace is a container that help to manage the temporary memory that are
- * shared across kernels during the serial execution.
+ * WorkSpace is the host scratch memory of a predictor, which is shared by its
+ * kernels as they run in order. The workspace of a program is bound to the
+ * thread of its Run, so the scratch memory scales with the predictors rather
+ * than with the threads which ever ran one. The kernels which run on a thread
+ * without a bound workspace, e.g. in the unit tests, use the one of the
+ * thread.
  *
- * Due to the mobile library size limit, a complex allocator or GC algorithm is
- * not suitable here, one need to carefully manage the workspace inside a single
- * kernel.
+ * The allocations are stack-style, Alloc() moves a cursor up and Release()
+ * moves it back to a Mark(), and the workspace is reset before each kernel.
+ * An allocation never moves the ones before it, the one which doesn't fit
+ * takes a block of its own, then the next reset replaces the blocks by one
+ * of the high-water mark. So the first Run plans the size, and the later ones
+ * allocate nothing.
  *
  * NOTE
  *
  * For kernel developers, one need to call the workspace as follows:
  *
- * - call `WorkSpace::Global().Alloc()` if needed to allocate some temporary
- * buffer.
+ * - call `WorkSpace::Current().Alloc()` to allocate some temporary buffer,
+ * which is valid until the kernel returns.
+ * - call `WorkSpace::Current().Extend()` to use the bottom of the workspace
+ * as one contiguous buffer, e.g. ARMContext::workspace_data(), before
+ * anything is allocated.
  */
 class WorkSpace {
  public:
+  WorkSpace() = default;
+  ~WorkSpace() { Clear(); }
+
   // Reset the workspace, and treat the workspace as empty.
-  void AllocReset() { cursor_ = 0; }
-
-  // Allocate a memory buffer.
-  core::byte_t* Alloc(size_t size) {
-    buffer_.ResetLazy(target_, cursor_ + size);
-    auto* data = static_cast<core::byte_t*>(buffer_.data()) + cursor_;
-    cursor_ += size;
-    return data;
-  }
+  void AllocReset();
+
+  // Allocate a memory buffer, which is aligned to kAlignment.
+  core::byte_t* Alloc(size_t size);
 
-  static WorkSpace& Global_Host() {
-    static LITE_THREAD_LOCAL std::unique_ptr<WorkSpace> x(
-        new WorkSpace(TARGET(kHost)));
-    return *x;
+  template <typename T>
+  T* Alloc(size_t count) {
+    return reinterpret_cast<T*>(Alloc(count * sizeof(T)));
   }
 
-#if defined(LITE_WITH_X86)
-  static WorkSpace& Global_X86() { return Global_Host(); }
-#endif
+  size_t Mark() const { return cursor_; }
+  // Free the buffers allocated after the mark.
+  void Release(size_t mark);
 
-#if defined(LITE_WITH_ARM)
-  static WorkSpace& Global_ARM() { return Global_Host(); }
-#endif
+  // Returns the bottom of the workspace as a contiguous buffer of at least
+  // `size` bytes. Its content is kept as long as the buffer doesn't grow.
+  core::byte_t* Extend(size_t size);
 
-#if defined(LITE_WITH_CUDA)
-  static WorkSpace& Global_CUDA() {
-    static LITE_THREAD_LOCAL std::unique_ptr<WorkSpace> x(
-        new WorkSpace(TARGET(kCUDA)));
-    return *x;
-  }
-#endif
-#if defined(LITE_WITH_METAL)
-  static WorkSpace& Global_METAL() {
-    static LITE_THREAD_LOCAL std::unique_ptr<WorkSpace> x(
-        new WorkSpace(TARGET(kMetal)));
-    return *x;
-  }
-#endif
+  // Free all of the memory, the size is planned again by the next Run.
+  void Clear();
 
-#if defined(LITE_WITH_MLU)
-  static WorkSpace& Global_MLU() {
-    static LITE_THREAD_LOCAL std::unique_ptr<WorkSpace> x(
-        new WorkSpace(TARGET(kMLU)));
-    return *x;
-  }
-#endif
+  // The bytes reserved by the workspace.
+  size_t capacity() const { return capacity_; }
+  // The most bytes in use at a time since the workspace is created or
+  // cleared.
+  size_t high_water_mark() const { return high_water_mark_; }
+
+  // The workspace of the kernels running on this thread.
+  static WorkSpace& Current();
+
+  // Binds a workspace to this thread in its scope, unless one is bound
+  // already, e.g. the sub-blocks share the one of the main program.
+  class Binding {
+   public:
+    explicit Binding(WorkSpace* workspace);
+    ~Binding();
+
+   private:
+    bool owner_{false};
+
+    DISALLOW_COPY_AND_ASSIGN(Binding);
+  };
+
+  static const size_t kAlignment = 64;
 
  private:
-  explicit WorkSpace(TargetType x) : target_(x) {}
+  // Replace the blocks by one of `size` bytes.
+  void Reserve(size_t size);
+
+  core::byte_t* data_{nullptr};
+  size_t capacity_{0};
+  size_t cursor_{0};
+  // The bytes at the bottom used as a contiguous buffer.
+  size_t extended_{0};
+  size_t high_water_mark_{0};
+  // The blocks which are allocated beyond the capacity and their offsets.
+  std::vector<std::pair<size_t, core::byte_t*>> blocks_;
 
-  TargetType target_;
-  Buffer buffer_;
-  size_t cursor_;
+  static LITE_THREAD_LOCAL WorkSpace* bound_;
 
   DISALLOW_COPY_AND_ASSIGN(WorkSpace);
 };
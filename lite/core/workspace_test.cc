@@ -0,0 +1,91 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "lite/core/workspace.h"
+#include <gtest/gtest.h>
+#include <string.h>
+
+namespace paddle {
+namespace lite {
+
+TEST(workspace, alloc) {
+  WorkSpace workspace;
+  // The first pass takes the blocks beyond the capacity, which keep the
+  // allocations before them.
+  auto* a = workspace.Alloc<float>(100);
+  memset(a, 1, 100 * sizeof(float));
+  size_t mark = workspace.Mark();
+  auto* b = workspace.Alloc<float>(1000);
+  auto* c = workspace.Alloc(10);
+  memset(b, 2, 1000 * sizeof(float));
+  memset(c, 3, 10);
+  EXPECT_EQ(reinterpret_cast<uint8_t*>(a)[399], 1);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(c) % WorkSpace::kAlignment, 0);
+  size_t peak = workspace.high_water_mark();
+  EXPECT_GE(peak, 4410u);
+  workspace.Release(mark);
+  workspace.Alloc(100);
+  EXPECT_EQ(workspace.high_water_mark(), peak);
+
+  // The reset plans one block of the high-water mark.
+  workspace.AllocReset();
+  EXPECT_EQ(workspace.capacity(), peak);
+  auto* d = workspace.Alloc<float>(100);
+  auto* e = workspace.Alloc<float>(1000);
+  EXPECT_EQ(reinterpret_cast<uint8_t*>(e) - reinterpret_cast<uint8_t*>(d),
+            static_cast<ptrdiff_t>(mark));
+  workspace.AllocReset();
+  EXPECT_EQ(workspace.capacity(), peak);
+
+  workspace.Clear();
+  EXPECT_EQ(workspace.capacity(), 0u);
+  EXPECT_EQ(workspace.high_water_mark(), 0u);
+}
+
+TEST(workspace, extend) {
+  WorkSpace workspace;
+  auto* a = workspace.Extend(1000);
+  memset(a, 1, 1000);
+  // The bottom is kept while it doesn't grow.
+  EXPECT_EQ(workspace.Extend(500), a);
+  EXPECT_EQ(a[999], 1);
+  workspace.Extend(5000);
+  workspace.Alloc(100);
+  workspace.AllocReset();
+  EXPECT_GE(workspace.capacity(), 5100u);
+  // The allocations are above the bottom.
+  auto* b = workspace.Extend(5000);
+  auto* c = workspace.Alloc(100);
+  EXPECT_GE(c - b, 5000);
+}
+
+TEST(workspace, binding) {
+  WorkSpace workspace;
+  auto* local = &WorkSpace::Current();
+  EXPECT_NE(local, &workspace);
+  {
+    WorkSpace::Binding binding(&workspace);
+    EXPECT_EQ(&WorkSpace::Current(), &workspace);
+    WorkSpace nested;
+    {
+      // A sub-block shares the workspace of the main program.
+      WorkSpace::Binding nested_binding(&nested);
+      EXPECT_EQ(&WorkSpace::Current(), &workspace);
+    }
+    EXPECT_EQ(&WorkSpace::Current(), &workspace);
+  }
+  EXPECT_EQ(&WorkSpace::Current(), local);
+}
+
+}  // namespace lite
+}  // namespace paddle
@@ -16,6 +16,7 @@
 
 #include <vector>
 
+#include "lite/backends/arm/math/gemm_bf16.h"
 #include "lite/backends/arm/math/type_trans.h"
 #include "lite/core/op_registry.h"
 #include "lite/core/type_system.h"
@@ -107,6 +108,21 @@ void CalibComputeInt64ToFp32<DLType>::Run() {
   }
 }
 
+template <DataLayoutType DLType>
+void CalibComputeBf16ToFp32<DLType>::Run() {
+  auto& param = this->template Param<operators::CalibParam>();
+  const auto* din = param.input->template data<bfloat16>();
+  auto* dout = param.output->template mutable_data<float>();
+  lite::arm::math::bf16_to_fp32(din, dout, param.input->numel());
+}
+template <DataLayoutType DLType>
+void CalibComputeFp32ToBf16<DLType>::Run() {
+  auto& param = this->template Param<operators::CalibParam>();
+  const auto* din = param.input->template data<float>();
+  auto* dout = param.output->template mutable_data<bfloat16>();
+  lite::arm::math::fp32_to_bf16(din, dout, param.input->numel());
+}
+
 #ifdef ENABLE_ARM_FP16
 template <DataLayoutType DLType>
 void CalibComputeFp16ToFp32<DLType>::Run() {
@@ -317,3 +333,49 @@ REGISTER_LITE_KERNEL(
                                        PRECISION(kInt32),
                                        DATALAYOUT(kNCHW))})
     .Finalize();
+
+REGISTER_LITE_KERNEL(
+    calib,
+    kARM,
+    kBF16,
+    kNCHW,
+    paddle::lite::kernels::arm::CalibComputeBf16ToFp32<DATALAYOUT(kNCHW)>,
+    bf16_to_fp32)
+    .BindInput("Input", {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kBF16))})
+    .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kFloat))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(
+    calib,
+    kARM,
+    kBF16,
+    kNCHW,
+    paddle::lite::kernels::arm::CalibComputeFp32ToBf16<DATALAYOUT(kNCHW)>,
+    fp32_to_bf16)
+    .BindInput("Input",
+               {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kFloat))})
+    .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kBF16))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(
+    calib_once,
+    kARM,
+    kBF16,
+    kNCHW,
+    paddle::lite::kernels::arm::CalibComputeBf16ToFp32<DATALAYOUT(kNCHW)>,
+    bf16_to_fp32)
+    .BindInput("Input", {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kBF16))})
+    .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kFloat))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(
+    calib_once,
+    kARM,
+    kBF16,
+    kNCHW,
+    paddle::lite::kernels::arm::CalibComputeFp32ToBf16<DATALAYOUT(kNCHW)>,
+    fp32_to_bf16)
+    .BindInput("Input",
+               {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kFloat))})
+    .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kBF16))})
+    .Finalize();
@@ -33,6 +33,32 @@ class CalibComputeFp32ToInt8
 
  private:
 };
+template <DataLayoutType DLType>
+class CalibComputeFp32ToBf16
+    : public KernelLite<TARGET(kARM), PRECISION(kBF16), DLType> {
+ public:
+  using param_t = operators::CalibParam;
+
+  void Run() override;
+
+  ~CalibComputeFp32ToBf16() override{};
+
+ private:
+};
+
+template <DataLayoutType DLType>
+class CalibComputeBf16ToFp32
+    : public KernelLite<TARGET(kARM), PRECISION(kBF16), DLType> {
+ public:
+  using param_t = operators::CalibParam;
+
+  void Run() override;
+
+  ~CalibComputeBf16ToFp32() override{};
+
+ private:
+};
+
 #ifdef ENABLE_ARM_FP16
 typedef __fp16 float16_t;
 template <DataLayoutType DLType>
@@ -16,6 +16,7 @@
 #include <string>
 #include <vector>
 #include "lite/backends/arm/math/funcs.h"
+#include "lite/backends/host/math/concat.h"
 #include "lite/core/op_registry.h"
 #include "lite/core/tensor.h"
 #include "lite/core/type_system.h"
@@ -40,7 +41,12 @@ std::vector<size_t> stride_numel(const DDim& ddim) {
 template <typename T>
 void ConcatFunc(const std::vector<lite::Tensor*> inputs,
                 int axis,
+                bool inplace,
                 lite::Tensor* out) {
+  if (inplace &&
+      lite::host::math::concat_views<T>(inputs, axis, true, out)) {
+    return;
+  }
   // Sometimes direct copies will be faster, this maybe need deeply analysis.
   if (axis == 0 && inputs.size() < 10) {
     size_t output_offset = 0;
@@ -123,21 +129,21 @@ void ConcatCompute::Run() {
 
   switch (type) {
     case PRECISION(kFloat):
-      ConcatFunc<float>(inputs, axis, out);
+      ConcatFunc<float>(inputs, axis, param.inplace, out);
       break;
 #ifdef ENABLE_ARM_FP16
     case PRECISION(kFP16):
-      ConcatFunc<__fp16>(inputs, axis, out);
+      ConcatFunc<__fp16>(inputs, axis, param.inplace, out);
       break;
 #endif
     case PRECISION(kInt32):
-      ConcatFunc<int32_t>(inputs, axis, out);
+      ConcatFunc<int32_t>(inputs, axis, param.inplace, out);
       break;
     case PRECISION(kInt64):
-      ConcatFunc<int64_t>(inputs, axis, out);
+      ConcatFunc<int64_t>(inputs, axis, param.inplace, out);
       break;
     case PRECISION(kBool):
-      ConcatFunc<bool>(inputs, axis, out);
+      ConcatFunc<bool>(inputs, axis, param.inplace, out);
       break;
     default:
       LOG(FATAL) << "Concat does not implement for the "
@@ -346,6 +346,61 @@ void FcCompute<PRECISION(kInt8), PRECISION(kInt8)>::Run() {
   }
 }
 
+/// for bf16 kernel, only the weights are in bf16
+template <>
+void FcCompute<PRECISION(kBF16), PRECISION(kFloat)>::ReInitWhenNeeded() {
+  auto& param = this->template Param<operators::FcParam>();
+  auto x_dims = param.input->dims();
+  if (last_shape_ == x_dims) {
+    return;
+  }
+  last_shape_ = x_dims;
+  auto w_dims = param.w->dims();
+  CHECK_GE(x_dims.size(), 2UL);
+  CHECK_EQ(w_dims.size(), 2UL);
+  m_ = x_dims.Slice(0, param.in_num_col_dims).production();
+  k_ = x_dims.Slice(param.in_num_col_dims, x_dims.size()).production();
+  n_ = w_dims[1];
+  CHECK_EQ(k_, static_cast<int>(w_dims[0]));
+}
+
+// The weights are packed once, they are float if they are not converted to
+// bf16 when the model is loaded, see LightPredictor::WeightFP32ToBF16.
+template <>
+void FcCompute<PRECISION(kBF16), PRECISION(kFloat)>::PrepareForRun() {
+  ReInitWhenNeeded();
+  auto& param = this->template Param<operators::FcParam>();
+  weights_.Resize({lite::arm::math::gemm_bf16_packb_size(k_, n_)});
+  auto* packed = weights_.mutable_data<bfloat16>();
+  if (param.w->precision() == PRECISION(kBF16)) {
+    lite::arm::math::gemm_bf16_packb(
+        k_, n_, param.w->data<bfloat16>(), n_, packed);
+  } else {
+    lite::arm::math::gemm_bf16_packb(
+        k_, n_, param.w->data<float>(), n_, packed);
+  }
+}
+
+template <>
+void FcCompute<PRECISION(kBF16), PRECISION(kFloat)>::Run() {
+  auto& param = this->Param<operators::FcParam>();
+  auto& ctx = this->ctx_->template As<ARMContext>();
+  if (param.bias) {
+    CHECK_EQ(param.bias->numel(), n_);
+  }
+  lite::arm::math::gemm_bf16(m_,
+                             n_,
+                             k_,
+                             param.input->data<float>(),
+                             k_,
+                             weights_.data<bfloat16>(),
+                             param.output->mutable_data<float>(),
+                             n_,
+                             param.bias ? param.bias->data<float>() : nullptr,
+                             param.activation_type == "relu",
+                             &ctx);
+}
+
 #ifdef ENABLE_ARM_FP16
 template <>
 void fc_trans_weights<PRECISION(kFP16)>(const Tensor& tin, Tensor* tout) {
@@ -442,6 +497,9 @@ typedef paddle::lite::kernels::arm::FcCompute<PRECISION(kInt8),
 typedef paddle::lite::kernels::arm::FcCompute<PRECISION(kInt8),
                                               PRECISION(kInt8)>
     FcCompute_int8_int8;
+typedef paddle::lite::kernels::arm::FcCompute<PRECISION(kBF16),
+                                              PRECISION(kFloat)>
+    FcCompute_BF16;
 
 #ifdef ENABLE_ARM_FP16
 typedef paddle::lite::kernels::arm::FcCompute<PRECISION(kFP16),
@@ -477,3 +535,10 @@ REGISTER_LITE_KERNEL(fc, kARM, kInt8, kNCHW, FcCompute_int8_fp32, fp32out)
     .BindInput("W", {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kInt8))})
     .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kFloat))})
     .Finalize();
+
+REGISTER_LITE_KERNEL(fc, kARM, kBF16, kNCHW, FcCompute_BF16, def)
+    .BindInput("Input", {LiteType::GetTensorTy(TARGET(kARM))})
+    .BindInput("Bias", {LiteType::GetTensorTy(TARGET(kARM))})
+    .BindInput("W", {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kBF16))})
+    .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kARM))})
+    .Finalize();
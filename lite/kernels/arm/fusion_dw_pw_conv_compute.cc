@@ -0,0 +1,474 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/kernels/arm/fusion_dw_pw_conv_compute.h"
+#include <algorithm>
+#include <cstring>
+#include <vector>
+#include "lite/core/op_registry.h"
+
+namespace paddle {
+namespace lite {
+namespace kernels {
+namespace arm {
+
+template <>
+void DwPwConvCompute<float, PRECISION(kFloat)>::PrepareForRun() {
+  auto& param = this->Param<param_t>();
+  auto& ctx = this->ctx_->template As<ARMContext>();
+  auto pw_dims = param.pw_param.filter->dims();
+  cout_ = pw_dims[0];
+  cin_ = pw_dims[1];
+  lite::arm::math::prepackA(&pw_weights_packed_,
+                            *param.pw_param.filter,
+                            1.f,
+                            cout_,
+                            cin_,
+                            1,
+                            false,
+                            &ctx);
+  neon_dw_ =
+      lite::arm::math::conv_depthwise_rows_neon_supported(param.dw_param);
+  if (neon_dw_) {
+    constexpr int cblock = 4;
+    auto dw_dims = param.dw_param.filter->dims();
+    int kernel_size = dw_dims[2] * dw_dims[3];
+    int cround = (cin_ + cblock - 1) / cblock * cblock;
+    dw_weights_c4_.Resize({cround, 1, dw_dims[2], dw_dims[3]});
+    lite::arm::math::conv_trans_weights_numc(
+        param.dw_param.filter->data<float>(),
+        dw_weights_c4_.mutable_data<float>(),
+        cin_,
+        1,
+        cblock,
+        kernel_size);
+  }
+}
+
+template <>
+void DwPwConvCompute<float, PRECISION(kFloat)>::DepthwiseRows(
+    const float* din,
+    float* tile,
+    int ih,
+    int iw,
+    int ow,
+    int oh_begin,
+    int oh_end,
+    ARMContext* ctx) {
+  auto& param = this->Param<param_t>();
+  const float* dw_bias =
+      param.dw_param.bias ? param.dw_param.bias->data<float>() : nullptr;
+  if (!neon_dw_) {
+    lite::arm::math::conv_depthwise_rows<float>(
+        din,
+        tile,
+        cin_,
+        ih,
+        iw,
+        ow,
+        oh_begin,
+        oh_end,
+        param.dw_param.filter->data<float>(),
+        dw_bias,
+        param.dw_param,
+        ctx);
+    return;
+  }
+  int band_size = lite::arm::math::conv_depthwise_rows_band_size(
+      param.dw_param, cin_, iw, oh_end - oh_begin);
+  dw_band_.Resize({band_size});
+  lite::arm::math::conv_depthwise_rows_neon(din,
+                                            tile,
+                                            dw_band_.mutable_data<float>(),
+                                            cin_,
+                                            ih,
+                                            iw,
+                                            ow,
+                                            oh_begin,
+                                            oh_end,
+                                            dw_weights_c4_.data<float>(),
+                                            dw_bias,
+                                            param.dw_param,
+                                            ctx);
+}
+
+template <>
+void DwPwConvCompute<float, PRECISION(kFloat)>::PointwiseGemm(
+    const float* din,
+    float* dout,
+    int n,
+    int ldc,
+    const float* bias,
+    ARMContext* ctx) {
+  auto& param = this->Param<param_t>();
+  lite::arm::math::sgemm_prepack(false,
+                                 cout_,
+                                 n,
+                                 cin_,
+                                 pw_weights_packed_.data<float>(),
+                                 din,
+                                 n,
+                                 0.f,
+                                 dout,
+                                 ldc,
+                                 bias,
+                                 bias != nullptr,
+                                 param.pw_param.activation_param,
+                                 ctx);
+}
+
+#ifdef ENABLE_ARM_FP16
+// The weights are converted by the light predictor if the model is optimized
+// by opt, but they are still fp32 in the full api, e.g. in the unit tests.
+static void WeightToFP16(Tensor* weight) {
+  if (!weight || weight->precision() == PRECISION(kFP16)) return;
+  Tensor tmp_tensor;
+  tmp_tensor.CopyDataFrom(*weight);
+  weight->clear();
+  weight->set_precision(PRECISION(kFP16));
+  float16_t* fp_data = weight->mutable_data<float16_t>();
+  const float* in_data = tmp_tensor.data<float>();
+  lite::arm::math::fp16::fp32_to_fp16(in_data, fp_data, weight->numel());
+}
+
+template <>
+void DwPwConvCompute<float16_t, PRECISION(kFP16)>::PrepareForRun() {
+  auto& param = this->Param<param_t>();
+  auto& ctx = this->ctx_->template As<ARMContext>();
+  WeightToFP16(param.dw_param.filter);
+  WeightToFP16(param.dw_param.bias);
+  WeightToFP16(param.pw_param.filter);
+  WeightToFP16(param.pw_param.bias);
+  auto pw_dims = param.pw_param.filter->dims();
+  cout_ = pw_dims[0];
+  cin_ = pw_dims[1];
+  lite::arm::math::fp16::prepackA_fp16(&pw_weights_packed_,
+                                       *param.pw_param.filter,
+                                       1.f,
+                                       cout_,
+                                       cin_,
+                                       1,
+                                       false,
+                                       &ctx);
+}
+
+template <>
+void DwPwConvCompute<float16_t, PRECISION(kFP16)>::DepthwiseRows(
+    const float16_t* din,
+    float16_t* tile,
+    int ih,
+    int iw,
+    int ow,
+    int oh_begin,
+    int oh_end,
+    ARMContext* ctx) {
+  auto& param = this->Param<param_t>();
+  const float16_t* dw_bias =
+      param.dw_param.bias ? param.dw_param.bias->data<float16_t>() : nullptr;
+  lite::arm::math::conv_depthwise_rows<float16_t>(
+      din,
+      tile,
+      cin_,
+      ih,
+      iw,
+      ow,
+      oh_begin,
+      oh_end,
+      param.dw_param.filter->data<float16_t>(),
+      dw_bias,
+      param.dw_param,
+      ctx);
+}
+
+template <>
+void DwPwConvCompute<float16_t, PRECISION(kFP16)>::PointwiseGemm(
+    const float16_t* din,
+    float16_t* dout,
+    int n,
+    int ldc,
+    const float16_t* bias,
+    ARMContext* ctx) {
+  auto& param = this->Param<param_t>();
+  lite::arm::math::fp16::gemm_prepack_fp16(false,
+                                           cout_,
+                                           n,
+                                           cin_,
+                                           pw_weights_packed_.data<float16_t>(),
+                                           din,
+                                           n,
+                                           0.f,
+                                           dout,
+                                           ldc,
+                                           bias,
+                                           bias != nullptr,
+                                           param.pw_param.activation_param,
+                                           ctx);
+}
+#endif
+
+template <typename T, PrecisionType PType>
+void DwPwConvCompute<T, PType>::Run() {
+  auto& param = this->template Param<param_t>();
+  auto& ctx = this->ctx_->template As<ARMContext>();
+  auto x_dims = param.x->dims();
+  auto o_dims = param.output->dims();
+  int bs = x_dims[0];
+  int ih = x_dims[2];
+  int iw = x_dims[3];
+  int oh = o_dims[2];
+  int ow = o_dims[3];
+
+  const T* din = param.x->template data<T>();
+  T* dout = param.output->template mutable_data<T>();
+  const T* pw_bias =
+      param.pw_param.bias ? param.pw_param.bias->template data<T>() : nullptr;
+
+  int tile_rows = lite::arm::math::conv_dw_pw_tile_rows(
+      cin_, oh, ow, static_cast<int>(sizeof(T)), &ctx);
+  dw_tile_.Resize({cin_, tile_rows * ow});
+  T* tile = dw_tile_.template mutable_data<T>();
+
+  for (int b = 0; b < bs; ++b) {
+    const T* din_batch = din + b * cin_ * ih * iw;
+    T* dout_batch = dout + b * cout_ * oh * ow;
+    for (int oh_begin = 0; oh_begin < oh; oh_begin += tile_rows) {
+      int oh_end = std::min(oh_begin + tile_rows, oh);
+      DepthwiseRows(din_batch, tile, ih, iw, ow, oh_begin, oh_end, &ctx);
+      PointwiseGemm(tile,
+                    dout_batch + oh_begin * ow,
+                    (oh_end - oh_begin) * ow,
+                    oh * ow,
+                    pw_bias,
+                    &ctx);
+    }
+  }
+}
+
+template class DwPwConvCompute<float, PRECISION(kFloat)>;
+#ifdef ENABLE_ARM_FP16
+template class DwPwConvCompute<float16_t, PRECISION(kFP16)>;
+#endif
+
+// The weights of all the channels share the scale if there is only one.
+static std::vector<float> ChannelScales(const std::vector<float>& weight_scale,
+                                        int channels) {
+  CHECK(weight_scale.size() == 1 ||
+        static_cast<int>(weight_scale.size()) == channels)
+      << "weights scale size must equal to filter size";
+  if (weight_scale.size() == 1) {
+    return std::vector<float>(channels, weight_scale[0]);
+  }
+  return weight_scale;
+}
+
+template <PrecisionType OutType>
+void DwPwConvInt8Compute<OutType>::PrepareForRun() {
+  auto& param = this->template Param<param_t>();
+  auto& ctx = this->ctx_->template As<ARMContext>();
+  const auto& dw_param = param.dw_param;
+  const auto& pw_param = param.pw_param;
+  auto pw_dims = pw_param.filter->dims();
+  cout_ = pw_dims[0];
+  cin_ = pw_dims[1];
+  lite::arm::math::prepackA_int8(
+      &pw_weights_packed_, *pw_param.filter, cout_, cin_, 1, false, &ctx);
+  dw_scale_ = ChannelScales(dw_param.weight_scale, cin_);
+  for (auto& scale : dw_scale_) {
+    scale *= dw_param.input_scale;
+  }
+  // The depthwise tile is quantized by the input scale of the pointwise conv,
+  // and the int8 output by the output scale, which the bias and the
+  // thresholds of the activation are scaled by as the int8 conv does.
+  float output_scale =
+      OutType == PRECISION(kInt8) ? pw_param.output_scale : 1.f;
+  pw_scale_ = ChannelScales(pw_param.weight_scale, cout_);
+  for (auto& scale : pw_scale_) {
+    scale = scale * pw_param.input_scale / output_scale;
+  }
+  pw_bias_.clear();
+  if (pw_param.bias) {
+    const float* bias = pw_param.bias->data<float>();
+    for (int i = 0; i < cout_; i++) {
+      pw_bias_.push_back(bias[i] / output_scale);
+    }
+  }
+  pw_act_param_ = pw_param.activation_param;
+  if (pw_act_param_.active_type == lite_api::ActivationType::kRelu6) {
+    pw_act_param_.Relu_clipped_coef /= output_scale;
+  } else if (pw_act_param_.active_type ==
+             lite_api::ActivationType::kHardSwish) {
+    pw_act_param_.hard_swish_offset /= output_scale;
+    pw_act_param_.hard_swish_threshold /= output_scale;
+  }
+}
+
+template <PrecisionType OutType>
+template <typename Dtype>
+void DwPwConvInt8Compute<OutType>::RunTiles(Dtype* dout) {
+  auto& param = this->template Param<param_t>();
+  auto& ctx = this->ctx_->template As<ARMContext>();
+  auto x_dims = param.x->dims();
+  auto o_dims = param.output->dims();
+  int bs = x_dims[0];
+  int ih = x_dims[2];
+  int iw = x_dims[3];
+  int oh = o_dims[2];
+  int ow = o_dims[3];
+
+  const int8_t* din = param.x->template data<int8_t>();
+  const int8_t* dw_weights = param.dw_param.filter->template data<int8_t>();
+  const float* dw_bias = param.dw_param.bias
+                             ? param.dw_param.bias->template data<float>()
+                             : nullptr;
+  const float* pw_bias = pw_bias_.empty() ? nullptr : pw_bias_.data();
+
+  int tile_rows = lite::arm::math::conv_dw_pw_tile_rows(
+      cin_, oh, ow, static_cast<int>(sizeof(int8_t)), &ctx);
+  dw_tile_.Resize({cin_, tile_rows * ow});
+  int8_t* tile = dw_tile_.mutable_data<int8_t>();
+  pw_tile_.Resize({cout_, tile_rows * ow});
+  Dtype* pw_tile = pw_tile_.template mutable_data<Dtype>();
+
+  for (int b = 0; b < bs; ++b) {
+    const int8_t* din_batch = din + b * cin_ * ih * iw;
+    Dtype* dout_batch = dout + b * cout_ * oh * ow;
+    for (int oh_begin = 0; oh_begin < oh; oh_begin += tile_rows) {
+      int oh_end = std::min(oh_begin + tile_rows, oh);
+      int n = (oh_end - oh_begin) * ow;
+      lite::arm::math::conv_depthwise_rows_int8(din_batch,
+                                                tile,
+                                                cin_,
+                                                ih,
+                                                iw,
+                                                ow,
+                                                oh_begin,
+                                                oh_end,
+                                                dw_weights,
+                                                dw_bias,
+                                                dw_scale_.data(),
+                                                param.dw_param.output_scale,
+                                                param.dw_param,
+                                                &ctx);
+      // The int8 gemm has no ldc, the output rows of a tile are copied to the
+      // channels unless the tile is the whole output.
+      Dtype* gemm_out = n == oh * ow ? dout_batch : pw_tile;
+      lite::arm::math::gemm_prepack_int8(pw_weights_packed_.data<int8_t>(),
+                                         tile,
+                                         pw_bias,
+                                         gemm_out,
+                                         cout_,
+                                         n,
+                                         cin_,
+                                         pw_bias != nullptr,
+                                         false,
+                                         pw_scale_.data(),
+                                         pw_act_param_,
+                                         &ctx);
+      if (gemm_out == dout_batch) continue;
+      for (int c = 0; c < cout_; ++c) {
+        memcpy(dout_batch + c * oh * ow + oh_begin * ow,
+               pw_tile + c * n,
+               sizeof(Dtype) * n);
+      }
+    }
+  }
+}
+
+template <PrecisionType OutType>
+void DwPwConvInt8Compute<OutType>::Run() {
+  auto& param = this->template Param<param_t>();
+  if (OutType == PRECISION(kInt8)) {
+    RunTiles(param.output->template mutable_data<int8_t>());
+  } else {
+    RunTiles(param.output->template mutable_data<float>());
+  }
+}
+
+template class DwPwConvInt8Compute<PRECISION(kInt8)>;
+template class DwPwConvInt8Compute<PRECISION(kFloat)>;
+
+}  // namespace arm
+}  // namespace kernels
+}  // namespace lite
+}  // namespace paddle
+
+typedef paddle::lite::kernels::arm::DwPwConvCompute<float, PRECISION(kFloat)>
+    DwPwConvFp32;
+
+REGISTER_LITE_KERNEL(
+    fusion_dw_pw_conv2d, kARM, kFloat, kNCHW, DwPwConvFp32, def)
+    .BindInput("Input", {LiteType::GetTensorTy(TARGET(kARM))})
+    .BindInput("DwFilter", {LiteType::GetTensorTy(TARGET(kARM))})
+    .BindInput("DwBias", {LiteType::GetTensorTy(TARGET(kARM))})
+    .BindInput("PwFilter", {LiteType::GetTensorTy(TARGET(kARM))})
+    .BindInput("PwBias", {LiteType::GetTensorTy(TARGET(kARM))})
+    .BindOutput("Output", {LiteType::GetTensorTy(TARGET(kARM))})
+    .Finalize();
+
+typedef paddle::lite::kernels::arm::DwPwConvInt8Compute<PRECISION(kInt8)>
+    DwPwConvInt8_Int8;
+typedef paddle::lite::kernels::arm::DwPwConvInt8Compute<PRECISION(kFloat)>
+    DwPwConvInt8_Fp32;
+
+REGISTER_LITE_KERNEL(
+    fusion_dw_pw_conv2d, kARM, kInt8, kNCHW, DwPwConvInt8_Int8, int8_out)
+    .BindInput("Input", {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kInt8))})
+    .BindInput("DwFilter",
+               {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kInt8))})
+    .BindInput("DwBias",
+               {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kFloat))})
+    .BindInput("PwFilter",
+               {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kInt8))})
+    .BindInput("PwBias",
+               {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kFloat))})
+    .BindOutput("Output",
+                {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kInt8))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(
+    fusion_dw_pw_conv2d, kARM, kInt8, kNCHW, DwPwConvInt8_Fp32, fp32_out)
+    .BindInput("Input", {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kInt8))})
+    .BindInput("DwFilter",
+               {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kInt8))})
+    .BindInput("DwBias",
+               {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kFloat))})
+    .BindInput("PwFilter",
+               {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kInt8))})
+    .BindInput("PwBias",
+               {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kFloat))})
+    .BindOutput("Output",
+                {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kFloat))})
+    .Finalize();
+
+#ifdef ENABLE_ARM_FP16
+typedef paddle::lite::kernels::arm::DwPwConvCompute<float16_t,
+                                                    PRECISION(kFP16)>
+    DwPwConvFp16;
+
+REGISTER_LITE_KERNEL(
+    fusion_dw_pw_conv2d, kARM, kFP16, kNCHW, DwPwConvFp16, def)
+    .BindInput("Input",
+               {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kFP16))})
+    .BindInput("DwFilter",
+               {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kFP16))})
+    .BindInput("DwBias",
+               {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kFP16))})
+    .BindInput("PwFilter",
+               {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kFP16))})
+    .BindInput("PwBias",
+               {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kFP16))})
+    .BindOutput("Output",
+                {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kFP16))})
+    .Finalize();
+#endif  // ENABLE_ARM_FP16
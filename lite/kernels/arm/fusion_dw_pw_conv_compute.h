@@ -0,0 +1,107 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <vector>
+#include "lite/backends/arm/math/funcs.h"
+#include "lite/core/kernel.h"
+#include "lite/operators/op_params.h"
+#ifdef ENABLE_ARM_FP16
+#include "lite/backends/arm/math/fp16/funcs_fp16.h"
+#endif
+
+namespace paddle {
+namespace lite {
+namespace kernels {
+namespace arm {
+
+// The depthwise output is computed tile by tile of rows, each tile of all the
+// channels stays in L2 and is consumed by the pointwise gemm at once, instead
+// of writing the whole depthwise output back to memory.
+template <typename T, PrecisionType PType>
+class DwPwConvCompute : public KernelLite<TARGET(kARM), PType> {
+ public:
+  using param_t = operators::DwPwConvParam;
+
+  void PrepareForRun() override;
+
+  void Run() override;
+
+  virtual ~DwPwConvCompute() = default;
+
+ private:
+  void PointwiseGemm(const T* din,
+                     T* dout,
+                     int n,
+                     int ldc,
+                     const T* bias,
+                     ARMContext* ctx);
+
+  // Computes the depthwise rows [oh_begin, oh_end) of a batch into the tile.
+  void DepthwiseRows(const T* din,
+                     T* tile,
+                     int ih,
+                     int iw,
+                     int ow,
+                     int oh_begin,
+                     int oh_end,
+                     ARMContext* ctx);
+
+  Tensor pw_weights_packed_;
+  Tensor dw_tile_;
+  // The depthwise weights transformed for the NEON depthwise kernels, and the
+  // input rows copied for them, only used by fp32.
+  Tensor dw_weights_c4_;
+  Tensor dw_band_;
+  bool neon_dw_{false};
+  int cout_{0};
+  int cin_{0};
+};
+
+// The int8 fused conv, the depthwise tile is quantized by the input scale of
+// the pointwise conv, and the output is int8 or fp32 as OutType.
+template <PrecisionType OutType>
+class DwPwConvInt8Compute
+    : public KernelLite<TARGET(kARM), PRECISION(kInt8)> {
+ public:
+  using param_t = operators::DwPwConvParam;
+
+  void PrepareForRun() override;
+
+  void Run() override;
+
+  virtual ~DwPwConvInt8Compute() = default;
+
+ private:
+  template <typename Dtype>
+  void RunTiles(Dtype* dout);
+
+  Tensor pw_weights_packed_;
+  Tensor dw_tile_;
+  // The gemm output of a tile, copied to the output rows of the channels.
+  Tensor pw_tile_;
+  // The scales dequantizing the depthwise sums, and the scales and bias of
+  // the pointwise gemm for the output type.
+  std::vector<float> dw_scale_;
+  std::vector<float> pw_scale_;
+  std::vector<float> pw_bias_;
+  operators::ActivationParam pw_act_param_;
+  int cout_{0};
+  int cin_{0};
+};
+
+}  // namespace arm
+}  // namespace kernels
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,113 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/kernels/arm/fusion_pointwise_chain_compute.h"
+#include "lite/core/op_registry.h"
+
+namespace paddle {
+namespace lite {
+namespace kernels {
+namespace arm {
+
+namespace {
+
+// Get the broadcast of y to x, the element i of x takes y[(i / post) % n].
+// Y is matched with the dims of X from `axis`, its leading and trailing dims
+// of 1 are ignored.
+void GetOperandBroadcast(const DDim& x_dims,
+                         const DDim& y_dims,
+                         int axis,
+                         int64_t* n,
+                         int64_t* post) {
+  const int x_rank = static_cast<int>(x_dims.size());
+  const int y_rank = static_cast<int>(y_dims.size());
+  if (axis == -1) {
+    axis = x_rank - y_rank;
+  }
+  int begin = 0;
+  int end = y_rank;
+  while (begin < end && y_dims[begin] == 1) begin++;
+  while (end > begin && y_dims[end - 1] == 1) end--;
+  *n = 1;
+  *post = x_dims.production();
+  if (begin == end) {
+    return;
+  }
+  axis += begin;
+  CHECK(axis >= 0 && axis + end - begin <= x_rank)
+      << "The operand " << y_dims << " can't be broadcast to " << x_dims
+      << " with axis " << axis;
+  for (int i = begin; i < end; i++) {
+    CHECK_EQ(x_dims[axis + i - begin], y_dims[i])
+        << "The operand " << y_dims << " can't be broadcast to " << x_dims;
+    *n *= y_dims[i];
+  }
+  *post = x_dims.count(axis + end - begin, x_rank);
+}
+
+}  // namespace
+
+void PointwiseChainCompute::PrepareForRun() {
+  auto& param = this->Param<param_t>();
+  const size_t num_steps = param.step_types.size();
+  steps_.resize(num_steps);
+  for (size_t i = 0; i < num_steps; i++) {
+    auto& step = steps_[i];
+    CHECK(lite::arm::math::ParsePointwiseStepType(param.step_types[i],
+                                                  &step.type))
+        << "Unsupported pointwise step: " << param.step_types[i];
+    CHECK_EQ(lite::arm::math::IsBinaryPointwiseStep(step.type),
+             param.step_operands[i] >= 0)
+        << "The binary step " << param.step_types[i]
+        << " should take exactly one operand.";
+    step.reversed = param.step_reversed[i] != 0;
+    step.a = param.step_attrs[3 * i];
+    step.b = param.step_attrs[3 * i + 1];
+    step.c = param.step_attrs[3 * i + 2];
+  }
+}
+
+void PointwiseChainCompute::Run() {
+  auto& param = this->Param<param_t>();
+  auto x_dims = param.X->dims();
+  for (size_t i = 0; i < steps_.size(); i++) {
+    int operand = param.step_operands[i];
+    if (operand < 0) continue;
+    auto* y = param.operands[operand];
+    auto& step = steps_[i];
+    step.y = y->data<float>();
+    GetOperandBroadcast(
+        x_dims, y->dims(), param.step_axes[i], &step.n, &step.post);
+  }
+  lite::arm::math::pointwise_chain(param.X->data<float>(),
+                                   param.Out->mutable_data<float>(),
+                                   x_dims.production(),
+                                   steps_);
+}
+
+}  // namespace arm
+}  // namespace kernels
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_LITE_KERNEL(fusion_pointwise_chain,
+                     kARM,
+                     kFloat,
+                     kNCHW,
+                     paddle::lite::kernels::arm::PointwiseChainCompute,
+                     def)
+    .BindInput("X", {LiteType::GetTensorTy(TARGET(kARM))})
+    .BindInput("Operands", {LiteType::GetTensorTy(TARGET(kARM))})
+    .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kARM))})
+    .Finalize();
@@ -25,9 +25,9 @@ void LayerNormCompute::PrepareForRun() {}
 void LayerNormCompute::Run() {
   auto& param = this->Param<operators::LayerNormParam>();
 
-  auto input_dims = param.X->dims();
-
   const auto* x_data = param.X->data<float>();
+  const auto* residual =
+      param.Residual ? param.Residual->data<float>() : nullptr;
   const auto* scale = param.Scale ? param.Scale->data<float>() : nullptr;
   const auto* bias = param.Bias ? param.Bias->data<float>() : nullptr;
   auto* o_data = param.Y->mutable_data<float>();
@@ -35,12 +35,30 @@ void LayerNormCompute::Run() {
   auto* var = param.Variance->mutable_data<float>();
 
   int axis = param.begin_norm_axis;
-  auto matrix_dim = param.X->dims().Flatten2D(axis);
+  auto matrix_dim = param.Y->dims().Flatten2D(axis);
   int left = matrix_dim[0];
   int right = matrix_dim[1];
 
-  lite::arm::math::matrix_norm_row(
-      x_data, scale, bias, o_data, mean, var, param.epsilon, left, right);
+  if (residual && param.Residual->numel() != param.X->numel()) {
+    // Add the broadcast input into Y first, which is normalized in place.
+    int64_t x_size = param.X->numel();
+    int64_t r_size = param.Residual->numel();
+    for (int64_t i = 0; i < param.Y->numel(); i++) {
+      o_data[i] = x_data[i % x_size] + residual[i % r_size];
+    }
+    x_data = o_data;
+    residual = nullptr;
+  }
+  lite::arm::math::matrix_norm_row(x_data,
+                                   residual,
+                                   scale,
+                                   bias,
+                                   o_data,
+                                   mean,
+                                   var,
+                                   param.epsilon,
+                                   left,
+                                   right);
 }
 
 }  // namespace arm
@@ -55,6 +73,7 @@ REGISTER_LITE_KERNEL(layer_norm,
                      paddle::lite::kernels::arm::LayerNormCompute,
                      def)
     .BindInput("X", {LiteType::GetTensorTy(TARGET(kARM))})
+    .BindInput("Residual", {LiteType::GetTensorTy(TARGET(kARM))})
     .BindInput("Scale", {LiteType::GetTensorTy(TARGET(kARM))})
     .BindInput("Bias", {LiteType::GetTensorTy(TARGET(kARM))})
     .BindOutput("Y", {LiteType::GetTensorTy(TARGET(kARM))})
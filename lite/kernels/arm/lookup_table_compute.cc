@@ -17,6 +17,7 @@
 #include <vector>
 #include "lite/api/paddle_place.h"
 #include "lite/backends/arm/math/funcs.h"
+#include "lite/backends/host/math/embedding.h"
 #include "lite/core/op_registry.h"
 #include "lite/core/tensor.h"
 #include "lite/core/type_system.h"
@@ -33,28 +34,16 @@ void LookupTableCompute::Run() {
   auto out = param.Out;
 
   auto table_dim = w->dims();
-  int64_t ids_numel = ids->numel();
-  auto ids_data = ids->data<int64_t>();
-
-  int64_t row_number = table_dim[0];
-  int64_t row_width = table_dim[1];
-  auto table_data = w->data<float>();
-  auto dout = out->mutable_data<float>();
-
-  for (int64_t i = 0; i < ids_numel; ++i) {
-    int ids_int = ids_data[i];
-    if (param.padding_idx != -1 && ids_data[i] == param.padding_idx) {
-      memset(dout + i * row_width, 0, row_width * sizeof(float));
-    } else {
-      CHECK_LT(ids_data[i], row_number)
-          << "look uptable ids[i] < row_number check failed";
-      CHECK_GE(ids_data[i], 0) << "lookuptable ids[i] >= 0 check failed";
-
-      memcpy(dout + i * row_width,
-             table_data + ids_int * row_width,
-             row_width * sizeof(float));
-    }
-  }
+  lite::host::math::EmbeddingTable table;
+  table.data = w->data<float>();
+  table.rows = table_dim[0];
+  table.width = table_dim[1];
+  lite::host::math::embedding_lookup(table,
+                                     ids->data<int64_t>(),
+                                     ids->numel(),
+                                     param.padding_idx,
+                                     out->mutable_data<float>(),
+                                     nullptr);
   *(out->mutable_lod()) = ids->lod();
 }
 
@@ -17,6 +17,7 @@
 #include <vector>
 #include "lite/api/paddle_place.h"
 #include "lite/backends/arm/math/funcs.h"
+#include "lite/backends/host/math/embedding.h"
 #include "lite/core/op_registry.h"
 #include "lite/core/tensor.h"
 #include "lite/core/type_system.h"
@@ -26,19 +27,6 @@ namespace lite {
 namespace kernels {
 namespace arm {
 
-void dequant(const unsigned char *in,
-             float *out,
-             float min,
-             float max,
-             int emb_size,
-             int pow_2_bits) {
-  float scale = (max - min) / pow_2_bits;
-  for (int i = 0; i < emb_size; ++i) {
-    float x = scale * static_cast<int>(in[i]) + min;
-    out[i] = x;
-  }
-}
-
 void LookupTableDequantCompute::Run() {
   auto &param = this->Param<param_t>();
   // inputs
@@ -48,38 +36,17 @@ void LookupTableDequantCompute::Run() {
   auto out = param.Out;
 
   auto table_dim = w->dims();
-  int64_t ids_numel = ids->numel();
-  auto ids_data = ids->data<int64_t>();
-
-  int64_t row_number = table_dim[0];
-  int64_t quant_number = table_dim[1];
-  int64_t row_width = (quant_number - 2) * 4;
-
-  auto table_data = w->data<float>();
-  auto dout = out->mutable_data<float>();
-  int pow_2_bits = static_cast<int>(pow(2, 8));
-
-  for (int64_t i = 0; i < ids_numel; ++i) {
-    int ids_int = ids_data[i];
-    if (param.padding_idx != -1 && ids_data[i] == param.padding_idx) {
-      memset(dout + i * row_width, 0, row_width * sizeof(float));
-    } else {
-      CHECK_LT(ids_data[i], row_number)
-          << "look uptable ids[i] < row_number check failed";
-      CHECK_GE(ids_data[i], 0) << "lookuptable ids[i] >= 0 check failed";
-      float min = *(table_data + ids_data[i] * quant_number);
-      float max = *(table_data + ids_data[i] * quant_number + 1);
-      int offset = ids_data[i] * quant_number + 2;
-      const unsigned char *tensor_buf =
-          reinterpret_cast<const unsigned char *>(table_data + offset);
-      dequant(
-          tensor_buf, dout + i * row_width, min, max, row_width, pow_2_bits);
-
-      // memcpy(dout + i * row_width,
-      //       table_data + ids_int * row_width,
-      //       row_width * sizeof(float));
-    }
-  }
+  lite::host::math::EmbeddingTable table;
+  table.data = w->data<float>();
+  table.rows = table_dim[0];
+  table.width = (table_dim[1] - 2) * 4;
+  table.format = lite::host::math::EmbeddingFormat::kUInt8MinMax;
+  lite::host::math::embedding_lookup(table,
+                                     ids->data<int64_t>(),
+                                     ids->numel(),
+                                     param.padding_idx,
+                                     out->mutable_data<float>(),
+                                     &scratch_);
   *(out->mutable_lod()) = ids->lod();
 }
 
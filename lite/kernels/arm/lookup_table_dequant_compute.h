@@ -14,6 +14,7 @@
 
 #pragma once
 #include <algorithm>
+#include "lite/backends/host/math/embedding.h"
 #include "lite/core/kernel.h"
 
 namespace paddle {
@@ -31,6 +32,9 @@ class LookupTableDequantCompute
   void Run() override;
 
   virtual ~LookupTableDequantCompute() = default;
+
+ private:
+  lite::host::math::EmbeddingScratch scratch_;
 };
 
 }  // namespace arm
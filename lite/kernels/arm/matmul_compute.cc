@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "lite/kernels/arm/matmul_compute.h"
+#include <algorithm>
 #include <vector>
 #include "lite/backends/arm/math/funcs.h"
 #include "lite/core/op_registry.h"
@@ -166,67 +167,31 @@ void MatMulCompute<PRECISION(kFloat), PRECISION(kFloat)>::Run() {
     int y_inner = y_dims[y_dims.size() - 2] * y_dims[y_dims.size() - 1];
     int out_inner = o_dims[o_dims.size() - 2] * o_dims[o_dims.size() - 1];
 
-    if (x_dims.size() > 2 && y_dims.size() > 2) {
-      for (size_t i = 0; i < x_dims.count(0, x_dims.size() - 2); ++i) {
-        lite::arm::math::sgemm(x_transpose,
-                               y_transpose,
-                               m_,
-                               n_,
-                               k_,
-                               alpha,
-                               x_data + i * x_inner,
-                               lda,
-                               y_data + i * y_inner,
-                               ldb,
-                               0.f,
-                               o_data + i * out_inner,
-                               ldc,
-                               nullptr,
-                               false,
-                               act_param,
-                               &ctx);
-      }
-    } else if (x_dims.size() > 2 && y_dims.size() == 2) {
-      for (size_t i = 0; i < x_dims.count(0, x_dims.size() - 2); ++i) {
-        lite::arm::math::sgemm(x_transpose,
-                               y_transpose,
-                               m_,
-                               n_,
-                               k_,
-                               alpha,
-                               x_data + i * x_inner,
-                               lda,
-                               y_data,
-                               ldb,
-                               0.f,
-                               o_data + i * out_inner,
-                               ldc,
-                               nullptr,
-                               false,
-                               act_param,
-                               &ctx);
-      }
-    } else if (x_dims.size() == 2 && y_dims.size() > 2) {
-      for (size_t i = 0; i < y_dims.count(0, y_dims.size() - 2); ++i) {
-        lite::arm::math::sgemm(x_transpose,
-                               y_transpose,
-                               m_,
-                               n_,
-                               k_,
-                               alpha,
-                               x_data,
-                               lda,
-                               y_data + i * y_inner,
-                               ldb,
-                               0.f,
-                               o_data + i * out_inner,
-                               ldc,
-                               nullptr,
-                               false,
-                               act_param,
-                               &ctx);
-      }
-    }
+    // The broadcast batch has the zero stride, all of the batches are run as
+    // one batched GEMM.
+    int64_t x_batch = x_dims.count(0, x_dims.size() - 2);
+    int64_t y_batch = y_dims.count(0, y_dims.size() - 2);
+    CHECK(x_batch == y_batch || x_batch == 1 || y_batch == 1)
+        << "not supported x_dims(" << x_dims << ") and y_dims(" << y_dims
+        << ")";
+    lite::arm::math::sgemm_batched(x_transpose,
+                                   y_transpose,
+                                   std::max(x_batch, y_batch),
+                                   m_,
+                                   n_,
+                                   k_,
+                                   alpha,
+                                   x_data,
+                                   lda,
+                                   x_batch == 1 ? 0 : x_inner,
+                                   y_data,
+                                   ldb,
+                                   y_batch == 1 ? 0 : y_inner,
+                                   0.f,
+                                   o_data,
+                                   ldc,
+                                   out_inner,
+                                   &ctx);
   } else if ((x_dims.size() == 2 && y_dims.size() == 2) ||
              (x_dims.size() == 2 && y_dims.size() == 1)) {
     // x: [M, K], y: [K, N], out: [M, N]
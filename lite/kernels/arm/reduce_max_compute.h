@@ -14,7 +14,7 @@
 
 #pragma once
 #include <stdint.h>
-#include "lite/backends/arm/math/type_trans.h"
+#include "lite/backends/host/math/reduce.h"
 #include "lite/core/kernel.h"
 #include "lite/core/op_registry.h"
 
@@ -23,14 +23,12 @@ namespace lite {
 namespace kernels {
 namespace arm {
 
-template <typename T>
-class ReduceMaxCompute : public KernelLite<TARGET(kARM), PRECISION(kFloat)> {
+template <typename T, PrecisionType Ptype = PRECISION(kFloat)>
+class ReduceMaxCompute : public KernelLite<TARGET(kARM), Ptype> {
  public:
   void Run() override;
 
   virtual ~ReduceMaxCompute() = default;
-
- private:
 };
 
 }  // namespace arm
@@ -13,71 +13,21 @@
 // limitations under the License.
 
 #include "lite/kernels/arm/reduce_mean_compute.h"
-#include <string>
-#include "lite/backends/arm/math/funcs.h"
 
 namespace paddle {
 namespace lite {
 namespace kernels {
 namespace arm {
 
-void ReduceMeanCompute::Run() {
-  auto& param = Param<operators::ReduceParam>();
-  const float* input = param.X->data<float>();
-  auto x_dims = param.X->dims();
-  int x_rank = x_dims.size();
-  float* output = param.Out->mutable_data<float>();
-  bool keep_dim = param.keep_dim;
-  auto dim = param.dim;
-
-  if (!dim.empty()) {
-    for (int i = 0; i < dim.size(); i++) {
-      if (dim[i] < 0) {
-        dim[i] += x_rank;
-      }
-    }
-  }
-
-  size_t new_dims[] = {1, 1, 1, 1};
-  for (size_t j = 0; j < x_dims.size(); ++j) {
-    new_dims[j] = x_dims[j];
-  }
-  int n_in = new_dims[0];
-  int c_in = new_dims[1];
-  int h_in = new_dims[2];
-  int w_in = new_dims[3];
-  if (dim.size() == 0) {
-    lite::arm::math::reduce_mean_all(input, output, n_in, c_in, h_in, w_in);
-  } else if (dim.size() == 1) {
-    switch (dim[0]) {
-      case 0:
-        lite::arm::math::reduce_mean_n(input, output, n_in, c_in, h_in, w_in);
-        break;
-      case 1:
-        lite::arm::math::reduce_mean_c(input, output, n_in, c_in, h_in, w_in);
-        break;
-      case 2:
-        lite::arm::math::reduce_mean_h(input, output, n_in, c_in, h_in, w_in);
-        break;
-      case 3:
-        lite::arm::math::reduce_mean_w(input, output, n_in, c_in, h_in, w_in);
-        break;
-      default:
-        LOG(FATAL) << "error!!!";
-    }
-  } else if (dim.size() == 2) {
-    if (dim[0] == 0 && dim[1] == 1) {
-      lite::arm::math::reduce_mean_nc(input, output, n_in, c_in, h_in, w_in);
-    } else if (dim[0] == 1 && dim[1] == 2) {
-      lite::arm::math::reduce_mean_ch(input, output, n_in, c_in, h_in, w_in);
-    } else if (dim[0] == 2 && dim[1] == 3) {
-      lite::arm::math::reduce_mean_hw(input, output, n_in, c_in, h_in, w_in);
-    } else {
-      LOG(FATAL) << "invalid dim!!";
-    }
-  } else {
-    LOG(FATAL) << "dim's size over than 2, which is not supported now!!";
-  }
+template <typename T, PrecisionType Ptype>
+void ReduceMeanCompute<T, Ptype>::Run() {
+  auto& param = this->template Param<operators::ReduceParam>();
+  lite::host::math::reduce(param.X->template data<T>(),
+                           param.Out->template mutable_data<T>(),
+                           param.X->dims().Vectorize(),
+                           param.dim,
+                           param.reduce_all,
+                           lite::host::math::ReduceType::kMean);
 }
 
 }  // namespace arm
@@ -85,12 +35,19 @@ void ReduceMeanCompute::Run() {
 }  // namespace lite
 }  // namespace paddle
 
-REGISTER_LITE_KERNEL(reduce_mean,
-                     kARM,
-                     kFloat,
-                     kNCHW,
-                     paddle::lite::kernels::arm::ReduceMeanCompute,
-                     def)
+using reduce_mean_arm_float =
+    paddle::lite::kernels::arm::ReduceMeanCompute<float, PRECISION(kFloat)>;
+REGISTER_LITE_KERNEL(
+    reduce_mean, kARM, kFloat, kNCHW, reduce_mean_arm_float, def)
     .BindInput("X", {LiteType::GetTensorTy(TARGET(kARM))})
     .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kARM))})
     .Finalize();
+
+#ifdef ENABLE_ARM_FP16
+using reduce_mean_arm_fp16 =
+    paddle::lite::kernels::arm::ReduceMeanCompute<float16_t, PRECISION(kFP16)>;
+REGISTER_LITE_KERNEL(reduce_mean, kARM, kFP16, kNCHW, reduce_mean_arm_fp16, def)
+    .BindInput("X", {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kFP16))})
+    .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kFP16))})
+    .Finalize();
+#endif  // ENABLE_ARM_FP16
@@ -14,7 +14,7 @@
 
 #pragma once
 #include <stdint.h>
-#include "lite/backends/arm/math/type_trans.h"
+#include "lite/backends/host/math/reduce.h"
 #include "lite/core/kernel.h"
 #include "lite/core/op_registry.h"
 
@@ -23,13 +23,12 @@ namespace lite {
 namespace kernels {
 namespace arm {
 
-class ReduceMeanCompute : public KernelLite<TARGET(kARM), PRECISION(kFloat)> {
+template <typename T, PrecisionType Ptype>
+class ReduceMeanCompute : public KernelLite<TARGET(kARM), Ptype> {
  public:
   void Run() override;
 
   virtual ~ReduceMeanCompute() = default;
-
- private:
 };
 
 }  // namespace arm
@@ -108,6 +108,46 @@ inline std::vector<int64_t> get_new_data_from_tensor(
   return vec_new_data;
 }
 
+// Get the element offset of the slice if its `numel` elements are contiguous
+// in the input, i.e. all of the dims after the last sliced one are full and
+// all of the dims before it are 1.
+inline bool GetContiguousSliceOffset(const DDim& in_dims,
+                                     const std::vector<int>& axes,
+                                     const std::vector<int64_t>& starts,
+                                     const std::vector<int64_t>& ends,
+                                     int64_t numel,
+                                     int64_t* offset) {
+  int rank = static_cast<int>(in_dims.size());
+  std::vector<int64_t> begin(rank, 0);
+  std::vector<int64_t> extent = in_dims.Vectorize();
+  for (size_t i = 0; i < axes.size(); ++i) {
+    int64_t dim = in_dims[axes[i]];
+    int64_t start = starts[i] < 0 ? starts[i] + dim : starts[i];
+    int64_t end = ends[i] < 0 ? ends[i] + dim : ends[i];
+    start = std::min(std::max(start, static_cast<int64_t>(0)), dim);
+    end = std::min(std::max(end, static_cast<int64_t>(0)), dim);
+    begin[axes[i]] = start;
+    extent[axes[i]] = end - start;
+  }
+  int last_sliced = -1;
+  int64_t count = 1;
+  for (int i = 0; i < rank; ++i) {
+    if (extent[i] != in_dims[i]) last_sliced = i;
+    count *= extent[i];
+  }
+  if (count <= 0 || count != numel) return false;
+  for (int i = 0; i < last_sliced; ++i) {
+    if (extent[i] != 1) return false;
+  }
+  *offset = 0;
+  int64_t stride = 1;
+  for (int i = rank - 1; i >= 0; --i) {
+    *offset += begin[i] * stride;
+    stride *= in_dims[i];
+  }
+  return true;
+}
+
 template <typename T, PrecisionType PType>
 void SliceCompute<T, PType>::Run() {
   auto& ctx = this->ctx_->template As<ARMContext>();
@@ -231,6 +271,17 @@ void SliceCompute<T, PType>::Run() {
       out->Resize(DDim(vec_origin_out_shape));
     }
   }
+  int64_t offset = 0;
+  if (param.inplace &&
+      GetContiguousSliceOffset(
+          in_dims, axes, starts, ends, out->numel(), &offset)) {
+    out->ShareDataWith(*in, offset * sizeof(T), out_dims);
+    return;
+  }
+  // Out was a view of X in the previous run
+  if (out->SharesBufferWith(*in)) {
+    out->DetachBuffer();
+  }
   auto new_out_dims = out->dims();
   const auto* x_data = in->template data<T>();
   auto* o_data = out->template mutable_data<T>();
@@ -15,6 +15,7 @@
 #include "lite/kernels/arm/sparse_conv_compute.h"
 #include <utility>
 #include "lite/backends/arm/math/sparse_conv_impl.h"
+#include "lite/backends/host/math/sparse_structured_gemm.h"
 #include "lite/core/op_registry.h"
 #include "lite/core/type_system.h"
 
@@ -107,6 +108,41 @@ void SparseConvCompute<PRECISION(kFloat), PRECISION(kFloat)>::Run() {
   int ow = o_dims[3];
   int oc = o_dims[1];
   int im_size = oh * ow;
+  if (param.sparse_format == operators::SparseFormat::kBlock) {
+    for (int b = 0; b < bs; b++) {
+      lite::host::math::sparse_block_gemm_fp32(nonzero_weights,
+                                               oc_nonzeros,
+                                               diffs,
+                                               param.block_h,
+                                               param.block_w,
+                                               input + b * ic * im_size,
+                                               bias,
+                                               dout + b * oc * im_size,
+                                               oc,
+                                               ic,
+                                               im_size,
+                                               param.activation_param);
+    }
+    KERNEL_FUNC_NAME("sparse_block_gemm_fp32")
+    return;
+  }
+  if (param.sparse_format == operators::SparseFormat::kNM) {
+    for (int b = 0; b < bs; b++) {
+      lite::host::math::sparse_nm_gemm_fp32(nonzero_weights,
+                                            diffs,
+                                            param.nm_n,
+                                            param.nm_m,
+                                            input + b * ic * im_size,
+                                            bias,
+                                            dout + b * oc * im_size,
+                                            oc,
+                                            ic,
+                                            im_size,
+                                            param.activation_param);
+    }
+    KERNEL_FUNC_NAME("sparse_nm_gemm_fp32")
+    return;
+  }
   int first_ic = param.first_ic;
   const float* din = input + first_ic * im_size;
   lite::arm::math::sparse_conv_fp32_pipelined(nonzero_weights,
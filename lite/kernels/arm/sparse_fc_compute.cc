@@ -0,0 +1,83 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/kernels/arm/sparse_fc_compute.h"
+#include "lite/backends/host/math/sparse_structured_gemm.h"
+#include "lite/core/op_registry.h"
+
+namespace paddle {
+namespace lite {
+namespace kernels {
+namespace arm {
+
+void SparseFcCompute::Run() {
+  auto& param = this->Param<param_t>();
+  const float* input = param.input->data<float>();
+  const float* nonzero_weights = param.nonzero_weights->data<float>();
+  const int32_t* diffs = param.diffs->data<int32_t>();
+  const uint32_t* oc_nonzeros = param.oc_nonzeros->data<uint32_t>();
+  const float* bias = param.bias ? param.bias->data<float>() : nullptr;
+  float* output = param.output->mutable_data<float>();
+
+  int k = param.in_features;
+  int m = param.out_features;
+  int n = param.input->numel() / k;
+  if (param.sparse_format == operators::SparseFormat::kBlock) {
+    lite::host::math::sparse_block_fc_fp32(nonzero_weights,
+                                           oc_nonzeros,
+                                           diffs,
+                                           param.block_h,
+                                           param.block_w,
+                                           input,
+                                           bias,
+                                           output,
+                                           m,
+                                           k,
+                                           n,
+                                           param.activation_param);
+  } else {
+    lite::host::math::sparse_nm_fc_fp32(nonzero_weights,
+                                        diffs,
+                                        param.nm_n,
+                                        param.nm_m,
+                                        input,
+                                        bias,
+                                        output,
+                                        m,
+                                        k,
+                                        n,
+                                        param.activation_param);
+  }
+}
+
+}  // namespace arm
+}  // namespace kernels
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_LITE_KERNEL(sparse_fc,
+                     kARM,
+                     kFloat,
+                     kNCHW,
+                     paddle::lite::kernels::arm::SparseFcCompute,
+                     def)
+    .BindInput("Input", {LiteType::GetTensorTy(TARGET(kARM))})
+    .BindInput("NonZeroWeights", {LiteType::GetTensorTy(TARGET(kARM))})
+    .BindInput("OcNonZeros",
+               {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kInt32))})
+    .BindInput("Diffs",
+               {LiteType::GetTensorTy(TARGET(kARM), PRECISION(kInt32))})
+    .BindInput("Bias", {LiteType::GetTensorTy(TARGET(kARM))})
+    .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kARM))})
+    .Finalize();
@@ -16,6 +16,7 @@
 #include <string>
 #include <vector>
 #include "lite/backends/arm/math/funcs.h"
+#include "lite/backends/host/math/transpose.h"
 #include "lite/core/op_registry.h"
 #include "lite/core/parallel_defines.h"
 #include "lite/core/tensor.h"
@@ -55,92 +56,6 @@ void transpose_mat(const Dtype* din,
   dtype* dout6 = dout5 + height; \
   dtype* dout7 = dout6 + height;
 
-void transpose_mat(const float* din,
-                   float* dout,
-                   const int num,
-                   const int width,
-                   const int height) {
-  int nw = width >> 2;
-  int nh = height >> 2;
-  int size_in = width * height;
-  int size_w = width << 2;
-  int size_h = height << 2;
-
-  for (int i = 0; i < num; ++i) {
-    float* ptr_out = dout + i * size_in;
-    const float* ptr_in = din + i * size_in;
-    LITE_PARALLEL_BEGIN(h, tid, nh) {
-      const float* ptr_din_row = ptr_in + h * size_w;
-      int tmp_h = h * 4;
-      for (int w = 0; w < nw; w++) {
-        INIT_PTR_4(float, ptr_out, size_h)
-#ifdef __aarch64__
-        float32x4_t vr0 = vld1q_f32(din0);
-        float32x4_t vr1 = vld1q_f32(din1);
-        float32x4_t vr2 = vld1q_f32(din2);
-        float32x4_t vr3 = vld1q_f32(din3);
-        float32x4_t re0 = vtrn1q_f32(vr0, vr1);
-        float32x4_t re1 = vtrn2q_f32(vr0, vr1);
-        float32x4_t re2 = vtrn1q_f32(vr2, vr3);
-        float32x4_t re3 = vtrn2q_f32(vr2, vr3);
-        vst1_f32(dout0, vget_low_f32(re0));
-        dout0 += 2;
-        vst1_f32(dout0, vget_low_f32(re2));
-        vst1_f32(dout1, vget_low_f32(re1));
-        dout1 += 2;
-        vst1_f32(dout1, vget_low_f32(re3));
-        vst1_f32(dout2, vget_high_f32(re0));
-        dout2 += 2;
-        vst1_f32(dout2, vget_high_f32(re2));
-        vst1_f32(dout3, vget_high_f32(re1));
-        dout3 += 2;
-        vst1_f32(dout3, vget_high_f32(re3));
-#else
-        asm("vld1.32 {d0, d1}, [%[in0]]    \n"
-            "vld1.32 {d2, d3}, [%[in1]]    \n"
-            "vld1.32 {d4, d5}, [%[in2]]    \n"
-            "vld1.32 {d6, d7}, [%[in3]]    \n"
-            "vtrn.32 q0, q1                \n"
-            "vtrn.32 q2, q3                \n"
-            "vswp d1, d4                   \n"
-            "vswp d3, d6                   \n"
-            "vst1.32 {d0, d1}, [%[out0]]   \n"
-            "vst1.32 {d2, d3}, [%[out1]]   \n"
-            "vst1.32 {d4, d5}, [%[out2]]   \n"
-            "vst1.32 {d6, d7}, [%[out3]]   \n"
-            :
-            : [out0] "r"(dout0),
-              [out1] "r"(dout1),
-              [out2] "r"(dout2),
-              [out3] "r"(dout3),
-              [in0] "r"(din0),
-              [in1] "r"(din1),
-              [in2] "r"(din2),
-              [in3] "r"(din3)
-            : "q0", "q1", "q2", "q3");
-#endif
-        ptr_din_row += 4;
-      }
-    }
-    LITE_PARALLEL_END();
-    // remain
-    for (int h = 0; h < height; h++) {
-      for (int w = nw * 4; w < width; w++) {
-        const float* data_in_ptr = ptr_in + h * width + w;
-        float* data_out_ptr = ptr_out + w * height + h;
-        *data_out_ptr = *data_in_ptr;
-      }
-    }
-    for (int w = 0; w < width; w++) {
-      for (int h = nh * 4; h < height; h++) {
-        const float* data_in_ptr = ptr_in + h * width + w;
-        float* data_out_ptr = ptr_out + w * height + h;
-        *data_out_ptr = *data_in_ptr;
-      }
-    }
-  }
-}
-
 #ifdef ENABLE_ARM_FP16
 void transpose_mat(const lite_api::float16_t* din,
                    lite_api::float16_t* dout,
@@ -445,15 +360,6 @@ void transpose_mat(const lite_api::float16_t* din,
 }
 #endif
 
-std::vector<int> get_stride(const paddle::lite::DDimLite& dims) {
-  std::vector<int> data_stride{0};
-
-  for (int i = 0; i < dims.size(); ++i) {
-    data_stride.push_back(dims.count(i, dims.size()));
-  }
-  return data_stride;
-}
-
 void TransposeCompute::ReInitWhenNeeded() {
   auto& param = Param<operators::TransposeParam>();
   auto* input = param.x;
@@ -496,15 +402,11 @@ void TransposeCompute::ReInitWhenNeeded() {
     return;
   }
 
-  if (axis_diff.size() == 1) {
-    trans_mat = true;
+  trans_mat = axis_diff.size() == 1;
+  if (trans_mat) {
     _trans_num = input->dims().count(0, std::max(axis_diff[0], 0));
     _trans_w = input->dims().count(axis_diff[0] + 1, _num_axes);
     _trans_h = input->dims()[axis_diff[0]];
-  } else {
-    trans_mat = false;
-    _new_steps = get_stride(output->dims());
-    _old_steps = get_stride(input->dims());
   }
 }
 void TransposeCompute::PrepareForRun() { ReInitWhenNeeded(); }
@@ -513,54 +415,11 @@ template <typename Dtype>
 void TransposeCompute_(const std::vector<int>& axis,
                        const lite::Tensor* input,
                        lite::Tensor* output) {
-  const Dtype* input_ptr = input->data<Dtype>();
-  Dtype* output_ptr = output->mutable_data<Dtype>();
-
-  // input and output's shape dimension must >= 2 && <= 6.
-  const DDim& in_dim = input->dims();
-  const DDim& out_dim = output->dims();
-
-  // precompute inverted output dim and strides
-  size_t rout_dim[6], strides[6];
-  int permute = axis.size();  // permute must >=2 && <= 6.
-  for (int i = 0; i < permute; ++i) {
-    int k = permute - 1 - i;
-    strides[k] = 1;
-    for (int j = axis[i] + 1; j < permute; ++j) {
-      strides[k] *= in_dim[j];
-    }
-    rout_dim[k] = out_dim[i];
-  }
-
-  // unroll the first 2 dimensions
-  int reamin_dim = 1;
-  for (int i = 2; i < out_dim.size(); ++i) {
-    reamin_dim *= out_dim[i];
-  }
-
-  for (int batch = 0; batch < out_dim[0]; ++batch) {
-    LITE_PARALLEL_BEGIN(j, tid, out_dim[1]) {
-      size_t offset = batch * strides[permute - 1] + j * strides[permute - 2];
-      Dtype* out_ptr = output_ptr + (batch * out_dim[1] + j) * reamin_dim;
-      int indics[4] = {0, 0, 0, 0};
-      for (int k = 0; k < reamin_dim; ++k) {
-        out_ptr[k] = input_ptr[offset];
-        indics[0] += 1;
-        offset += strides[0];
-        for (int p = 0; p < permute - 3; ++p) {
-          if (indics[p] == rout_dim[p]) {
-            indics[p + 1] += 1;
-            indics[p] = 0;
-            offset += strides[p + 1];
-            offset -= rout_dim[p] * strides[p];
-          } else {
-            break;
-          }
-        }
-      }
-    }
-    LITE_PARALLEL_END();
-  }
+  lite::host::math::permute(input->data<Dtype>(),
+                            output->mutable_data<Dtype>(),
+                            input->dims().Vectorize(),
+                            axis,
+                            sizeof(Dtype));
 }
 // Transpose
 void TransposeCompute::Run() {
@@ -574,12 +433,6 @@ void TransposeCompute::Run() {
     return;
   }
 
-  if (input->precision() == PRECISION(kFloat) && trans_mat) {
-    const float* din = input->data<float>();
-    float* dout = output->mutable_data<float>();
-    transpose_mat(din, dout, _trans_num, _trans_w, _trans_h);
-    return;
-  }
 #ifdef ENABLE_ARM_FP16
   if (input->precision() == PRECISION(kFP16) && trans_mat) {
     const lite_api::float16_t* din = input->data<lite_api::float16_t>();
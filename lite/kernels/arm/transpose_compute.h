@@ -40,8 +40,6 @@ class TransposeCompute : public KernelLite<TARGET(kARM), PRECISION(kAny)> {
   int _trans_w;
   int _trans_h;
   DDim last_shape_;
-  std::vector<int> _new_steps;
-  std::vector<int> _old_steps;
 };
 
 // Transpose2
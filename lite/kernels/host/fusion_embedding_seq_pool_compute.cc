@@ -0,0 +1,79 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "lite/kernels/host/fusion_embedding_seq_pool_compute.h"
+#include <vector>
+
+namespace paddle {
+namespace lite {
+namespace kernels {
+namespace host {
+
+void FusionEmbeddingSeqPoolCompute::Run() {
+  auto& param = this->Param<param_t>();
+  const auto& table_dims = param.W->dims();
+  const auto& ids_dims = param.Ids->dims();
+  const auto& lod = param.Ids->lod()[0];
+  const int64_t batch = static_cast<int64_t>(lod.size()) - 1;
+
+  lite::host::math::EmbeddingTable table;
+  table.data = param.W->data<float>();
+  table.rows = table_dims[0];
+  if (param.lookup_type == "lookup_table_dequant") {
+    table.format = lite::host::math::EmbeddingFormat::kUInt8MinMax;
+    table.width = (table_dims[1] - 2) * 4;
+  } else {
+    table.width = table_dims[1];
+  }
+  auto pool_type = lite::host::math::EmbeddingPoolType::kSum;
+  if (param.pool_type == "AVERAGE") {
+    pool_type = lite::host::math::EmbeddingPoolType::kAverage;
+  } else if (param.pool_type == "SQRT") {
+    pool_type = lite::host::math::EmbeddingPoolType::kSqrt;
+  }
+
+  lite::host::math::embedding_seq_pool(table,
+                                       param.Ids->data<int64_t>(),
+                                       lod.data(),
+                                       batch,
+                                       param.Ids->numel() / ids_dims[0],
+                                       param.padding_idx,
+                                       pool_type,
+                                       param.pad_value,
+                                       param.Out->mutable_data<float>(),
+                                       &scratch_);
+
+  std::vector<uint64_t> out_lod(batch + 1);
+  for (int64_t i = 0; i <= batch; i++) {
+    out_lod[i] = i;
+  }
+  param.Out->mutable_lod()->clear();
+  param.Out->mutable_lod()->push_back(out_lod);
+}
+
+}  // namespace host
+}  // namespace kernels
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_LITE_KERNEL(fusion_embedding_seq_pool,
+                     kHost,
+                     kFloat,
+                     kNCHW,
+                     paddle::lite::kernels::host::FusionEmbeddingSeqPoolCompute,
+                     def)
+    .BindInput("W", {LiteType::GetTensorTy(TARGET(kHost), PRECISION(kFloat))})
+    .BindInput("Ids", {LiteType::GetTensorTy(TARGET(kHost), PRECISION(kInt64))})
+    .BindOutput("Out",
+                {LiteType::GetTensorTy(TARGET(kHost), PRECISION(kFloat))})
+    .Finalize();
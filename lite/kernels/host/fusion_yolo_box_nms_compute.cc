@@ -0,0 +1,292 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/kernels/host/fusion_yolo_box_nms_compute.h"
+#include <algorithm>
+#include <utility>
+#include "lite/backends/host/math/nms_util.h"
+#include "lite/backends/host/math/yolo_box.h"
+#include "lite/core/parallel_defines.h"
+
+namespace paddle {
+namespace lite {
+namespace kernels {
+namespace host {
+
+void FusionYoloBoxNmsCompute::Run() {
+  auto& param = this->Param<param_t>();
+  const int n = param.ImgSize->dims()[0];
+  const int num_heads = static_cast<int>(param.X.size());
+  const int class_num = param.class_num;
+  const int* img_size = param.ImgSize->data<int>();
+  const float conf_thresh = param.conf_thresh;
+  const float conf_bound =
+      lite::host::math::YoloConfLogitBound(param.conf_thresh);
+  const float scale = param.scale_x_y;
+  const float bias = -0.5f * (scale - 1.f);
+
+  // the heads of the anchors, and the offsets of the heads in the boxes
+  std::vector<int> anchor_heads;
+  std::vector<int> head_offsets(num_heads + 1, 0);
+  for (int h = 0; h < num_heads; h++) {
+    auto x_dims = param.X[h]->dims();
+    anchor_heads.insert(anchor_heads.end(), param.anchor_nums[h], h);
+    head_offsets[h + 1] =
+        head_offsets[h] + param.anchor_nums[h] * x_dims[2] * x_dims[3];
+  }
+  const int anchor_num = static_cast<int>(anchor_heads.size());
+  const int box_num = head_offsets[num_heads];
+
+  const int tasks = n * anchor_num;
+  decoded_.resize(tasks);
+  LITE_PARALLEL_BEGIN(t, tid, tasks) {
+    const int i = t / anchor_num;
+    const int a = t % anchor_num;
+    const int h = anchor_heads[a];
+    int head_anchor = 0;
+    for (int k = 0; k < h; k++) {
+      head_anchor += param.anchor_nums[k];
+    }
+    const int j = a - head_anchor;
+    auto x_dims = param.X[h]->dims();
+    const int an_num = param.anchor_nums[h];
+    const int height = x_dims[2];
+    const int width = x_dims[3];
+    const int stride = height * width;
+    const int an_stride = (class_num + 5) * stride;
+    const int input_size = param.downsample_ratios[h] * height;
+    const float* x = param.X[h]->data<float>();
+    const int* anchors = param.anchors.data() + 2 * head_anchor;
+    const int img_height = img_size[2 * i];
+    const int img_width = img_size[2 * i + 1];
+
+    Candidates& cand = decoded_[t];
+    cand.index.clear();
+    cand.boxes.clear();
+    cand.scores.clear();
+    const float* obj = x + lite::host::math::GetEntryIndex(
+                               i, j, 0, an_num, an_stride, stride, 4);
+    for (int hw = lite::host::math::topk_skip(
+             obj, 0, stride, 1, conf_bound, true);
+         hw < stride;
+         hw = lite::host::math::topk_skip(
+             obj, hw + 1, stride, 1, conf_bound, true)) {
+      float conf = lite::host::math::Sigmoid(obj[hw]);
+      if (conf < conf_thresh) {
+        continue;
+      }
+      float box[4];
+      float det[4];
+      int box_idx = lite::host::math::GetEntryIndex(
+          i, j, hw, an_num, an_stride, stride, 0);
+      lite::host::math::GetYoloBox(box,
+                                   x,
+                                   anchors,
+                                   hw % width,
+                                   hw / width,
+                                   j,
+                                   height,
+                                   input_size,
+                                   box_idx,
+                                   stride,
+                                   img_height,
+                                   img_width,
+                                   scale,
+                                   bias);
+      lite::host::math::CalcDetectionBox(
+          det, box, 0, img_height, img_width, param.clip_bbox);
+      cand.index.push_back(head_offsets[h] + j * stride + hw);
+      cand.boxes.insert(cand.boxes.end(), det, det + 4);
+      int label_idx = lite::host::math::GetEntryIndex(
+          i, j, hw, an_num, an_stride, stride, 5);
+      for (int c = 0; c < class_num; c++) {
+        cand.scores.push_back(
+            conf * lite::host::math::Sigmoid(x[label_idx + c * stride]));
+      }
+    }
+  }
+  LITE_PARALLEL_END();
+
+  class_scores_.resize(class_num);
+  class_cands_.resize(class_num);
+  kept_.resize(class_num);
+  selectors_.resize(class_num,
+                    lite::host::math::TopkSelector<float>(0, true));
+  out_rows_.clear();
+  out_index_.clear();
+  std::vector<uint64_t> batch_starts = {0};
+  for (int i = 0; i < n; i++) {
+    // The candidates of the image, in the order of their indices as the
+    // anchors are, so the ties of the scores are broken as multiclass_nms.
+    image_.index.clear();
+    image_.boxes.clear();
+    image_.scores.clear();
+    for (int a = 0; a < anchor_num; a++) {
+      const Candidates& cand = decoded_[i * anchor_num + a];
+      image_.index.insert(
+          image_.index.end(), cand.index.begin(), cand.index.end());
+      image_.boxes.insert(
+          image_.boxes.end(), cand.boxes.begin(), cand.boxes.end());
+      image_.scores.insert(
+          image_.scores.end(), cand.scores.begin(), cand.scores.end());
+    }
+    const int num_cands = static_cast<int>(image_.index.size());
+    for (int c = 0; c < class_num; c++) {
+      class_scores_[c].clear();
+      class_cands_[c].clear();
+      if (c == param.background_label) continue;
+      for (int m = 0; m < num_cands; m++) {
+        float score = image_.scores[m * class_num + c];
+        if (score > param.score_threshold) {
+          class_scores_[c].push_back(score);
+          class_cands_[c].push_back(m);
+        }
+      }
+    }
+
+    LITE_PARALLEL_BEGIN(c, tid, class_num) {
+      std::vector<int>& kept = kept_[c];
+      kept.clear();
+      int num = static_cast<int>(class_scores_[c].size());
+      auto& selector = selectors_[c];
+      selector.SetK(param.nms_top_k > -1 ? param.nms_top_k : num);
+      int num_sorted = selector.Select(class_scores_[c].data(), num);
+      float adaptive_threshold = param.nms_threshold;
+      for (int s = 0; s < num_sorted; s++) {
+        int m = class_cands_[c][selector.data()[s].second];
+        bool keep = true;
+        for (int kept_m : kept) {
+          float overlap =
+              lite::host::math::JaccardOverlap<float>(&image_.boxes[m * 4],
+                                                      &image_.boxes[kept_m * 4],
+                                                      param.normalized);
+          if (overlap > adaptive_threshold) {
+            keep = false;
+            break;
+          }
+        }
+        if (keep) {
+          kept.push_back(m);
+          if (param.nms_eta < 1 && adaptive_threshold > 0.5) {
+            adaptive_threshold *= param.nms_eta;
+          }
+        }
+      }
+    }
+    LITE_PARALLEL_END();
+
+    int num_det = 0;
+    for (int c = 0; c < class_num; c++) {
+      num_det += static_cast<int>(kept_[c].size());
+    }
+    if (param.keep_top_k > -1 && num_det > param.keep_top_k) {
+      // Keep top k results per image.
+      std::vector<std::pair<float, std::pair<int, int>>> score_index_pairs;
+      for (int c = 0; c < class_num; c++) {
+        for (int m : kept_[c]) {
+          score_index_pairs.push_back(std::make_pair(
+              image_.scores[m * class_num + c], std::make_pair(c, m)));
+        }
+      }
+      std::stable_sort(
+          score_index_pairs.begin(),
+          score_index_pairs.end(),
+          lite::host::math::SortScorePairDescend<std::pair<int, int>>);
+      score_index_pairs.resize(param.keep_top_k);
+      for (int c = 0; c < class_num; c++) {
+        kept_[c].clear();
+      }
+      for (auto& pair : score_index_pairs) {
+        kept_[pair.second.first].push_back(pair.second.second);
+      }
+      num_det = param.keep_top_k;
+    }
+
+    for (int c = 0; c < class_num; c++) {
+      for (int m : kept_[c]) {
+        out_rows_.push_back(static_cast<float>(c));
+        out_rows_.push_back(image_.scores[m * class_num + c]);
+        out_rows_.insert(out_rows_.end(),
+                         image_.boxes.begin() + m * 4,
+                         image_.boxes.begin() + m * 4 + 4);
+        out_index_.push_back(i * box_num + image_.index[m]);
+      }
+    }
+    batch_starts.push_back(batch_starts.back() + num_det);
+  }
+
+  // The outputs are the same as the ones of multiclass_nms.
+  auto* outs = param.Out;
+  auto* index = param.Index;
+  const int64_t out_dim = 6;
+  uint64_t num_kept = batch_starts.back();
+  if (num_kept == 0) {
+    if (index) {
+      outs->Resize({0, out_dim});
+      index->Resize({0, 1});
+    } else {
+      outs->Resize({1, 1});
+      outs->mutable_data<float>()[0] = -1;
+      batch_starts = {0, 1};
+    }
+  } else {
+    outs->Resize({static_cast<int64_t>(num_kept), out_dim});
+    std::copy(
+        out_rows_.begin(), out_rows_.end(), outs->mutable_data<float>());
+    if (index) {
+      index->Resize({static_cast<int64_t>(num_kept), 1});
+      std::copy(
+          out_index_.begin(), out_index_.end(), index->mutable_data<int>());
+    }
+  }
+
+  if (param.NmsRoisNum) {
+    param.NmsRoisNum->Resize({n});
+    int* num_data = param.NmsRoisNum->mutable_data<int>();
+    for (int i = 1; i <= n; i++) {
+      num_data[i - 1] =
+          i < static_cast<int>(batch_starts.size())
+              ? static_cast<int>(batch_starts[i] - batch_starts[i - 1])
+              : 0;
+    }
+  }
+
+  LoD lod;
+  lod.emplace_back(batch_starts);
+  if (index) {
+    index->set_lod(lod);
+  }
+  outs->set_lod(lod);
+}
+
+}  // namespace host
+}  // namespace kernels
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_LITE_KERNEL(fusion_yolo_box_nms,
+                     kHost,
+                     kFloat,
+                     kNCHW,
+                     paddle::lite::kernels::host::FusionYoloBoxNmsCompute,
+                     def)
+    .BindInput("X", {LiteType::GetTensorTy(TARGET(kHost), PRECISION(kFloat))})
+    .BindInput("ImgSize",
+               {LiteType::GetTensorTy(TARGET(kHost), PRECISION(kInt32))})
+    .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kHost))})
+    .BindOutput("Index",
+                {LiteType::GetTensorTy(TARGET(kHost), PRECISION(kInt32))})
+    .BindOutput("NmsRoisNum",
+                {LiteType::GetTensorTy(TARGET(kHost), PRECISION(kInt32))})
+    .Finalize();
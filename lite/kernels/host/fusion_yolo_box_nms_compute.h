@@ -0,0 +1,63 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <vector>
+#include "lite/backends/host/math/topk.h"
+#include "lite/core/kernel.h"
+#include "lite/core/op_registry.h"
+
+namespace paddle {
+namespace lite {
+namespace kernels {
+namespace host {
+
+// Only the cells whose confidences reach conf_thresh are decoded, the boxes
+// of the other cells are zeros whose scores can't pass the nms. The cells of
+// the anchors of the heads are decoded in parallel, then the nms of the
+// classes of an image run in parallel on the decoded boxes.
+class FusionYoloBoxNmsCompute
+    : public KernelLite<TARGET(kHost), PRECISION(kFloat)> {
+ public:
+  using param_t = operators::YoloBoxNmsParam;
+
+  void Run() override;
+
+  virtual ~FusionYoloBoxNmsCompute() = default;
+
+ private:
+  // The decoded boxes of an anchor of a head in an image, in the order of
+  // their indices in the concatenated boxes of the heads.
+  struct Candidates {
+    std::vector<int> index;
+    std::vector<float> boxes;
+    std::vector<float> scores;
+  };
+
+  // The buffers are kept across the runs, so a run allocates nothing once
+  // they are as large as the run needs.
+  std::vector<Candidates> decoded_;
+  Candidates image_;
+  std::vector<std::vector<float>> class_scores_;
+  std::vector<std::vector<int>> class_cands_;
+  std::vector<std::vector<int>> kept_;
+  std::vector<lite::host::math::TopkSelector<float>> selectors_;
+  std::vector<float> out_rows_;
+  std::vector<int> out_index_;
+};
+
+}  // namespace host
+}  // namespace kernels
+}  // namespace lite
+}  // namespace paddle
@@ -17,6 +17,7 @@
 #include <map>
 #include <utility>
 #include <vector>
+#include "lite/backends/host/math/topk.h"
 
 namespace paddle {
 namespace lite {
@@ -103,24 +104,18 @@ void NMSMatrix(const Tensor& bbox,
   auto score_ptr = scores.data<T>();
   auto bbox_ptr = bbox.data<T>();
 
-  std::vector<int32_t> perm(num_boxes);
-  std::iota(perm.begin(), perm.end(), 0);
-  auto end = std::remove_if(
-      perm.begin(), perm.end(), [&score_ptr, score_threshold](int32_t idx) {
-        return score_ptr[idx] <= score_threshold;
-      });
-  auto sort_fn = [&score_ptr](int32_t lhs, int32_t rhs) {
-    return score_ptr[lhs] > score_ptr[rhs];
-  };
-
-  int64_t num_pre = std::distance(perm.begin(), end);
+  // the boxes above the score threshold, in descending order of the score
+  int64_t num_keep = top_k > -1 ? top_k : num_boxes;
+  lite::host::math::TopkSelector<T> selector(static_cast<int>(num_keep), true);
+  selector.SetThreshold(score_threshold);
+  int64_t num_pre = selector.Select(score_ptr, static_cast<int>(num_boxes));
   if (num_pre <= 0) {
     return;
   }
-  if (top_k > -1 && num_pre > top_k) {
-    num_pre = top_k;
+  std::vector<int32_t> perm(num_pre);
+  for (int64_t i = 0; i < num_pre; i++) {
+    perm[i] = selector.data()[i].second;
   }
-  std::partial_sort(perm.begin(), perm.begin() + num_pre, end, sort_fn);
 
   std::vector<T> iou_matrix((num_pre * (num_pre - 1)) >> 1);
   std::vector<T> iou_max(num_pre);
@@ -223,15 +218,13 @@ size_t MultiClassMatrixNMS(const Tensor& scores,
     if (num_det > k) num_det = k;
   }
 
-  std::vector<int32_t> perm(all_indices.size());
-  std::iota(perm.begin(), perm.end(), 0);
-
-  std::partial_sort(perm.begin(),
-                    perm.begin() + num_det,
-                    perm.end(),
-                    [&all_scores](int lhs, int rhs) {
-                      return all_scores[lhs] > all_scores[rhs];
-                    });
+  lite::host::math::TopkSelector<T> selector(static_cast<int>(num_det), true);
+  num_det = selector.Select(all_scores.data(),
+                            static_cast<int>(all_scores.size()));
+  std::vector<int32_t> perm(num_det);
+  for (size_t i = 0; i < num_det; i++) {
+    perm[i] = selector.data()[i].second;
+  }
 
   for (size_t i = 0; i < num_det; i++) {
     auto p = perm[i];
@@ -17,6 +17,7 @@
 #include <map>
 #include <utility>
 #include <vector>
+#include "lite/backends/host/math/nms_util.h"
 #include "lite/operators/retinanet_detection_output_op.h"
 
 namespace paddle {
@@ -36,27 +37,6 @@ bool SortScoreTwoPairDescend(const std::pair<float, std::pair<T, T>>& pair1,
   return pair1.first > pair2.first;
 }
 
-template <class T>
-static inline void GetMaxScoreIndex(
-    const std::vector<T>& scores,
-    const T threshold,
-    int top_k,
-    std::vector<std::pair<T, int>>* sorted_indices) {
-  for (size_t i = 0; i < scores.size(); ++i) {
-    if (scores[i] > threshold) {
-      sorted_indices->push_back(std::make_pair(scores[i], i));
-    }
-  }
-  // Sort the score pair according to the scores in descending order
-  std::stable_sort(sorted_indices->begin(),
-                   sorted_indices->end(),
-                   SortScorePairDescend<int>);
-  // Keep top_k scores if needed.
-  if (top_k > -1 && top_k < static_cast<int>(sorted_indices->size())) {
-    sorted_indices->resize(top_k);
-  }
-}
-
 template <class T>
 static inline T BBoxArea(const std::vector<T>& box, const bool normalized) {
   if (box[2] < box[0] || box[3] < box[1]) {
@@ -290,7 +270,8 @@ void RetinanetDetectionOutput(
 
     // For the highest level, we take the threshold 0.0
     T threshold = (l < (scores.size() - 1) ? score_threshold : 0.0);
-    GetMaxScoreIndex(scores_data, threshold, nms_top_k, &sorted_indices);
+    lite::host::math::GetMaxScoreIndex(
+        scores_data, threshold, nms_top_k, &sorted_indices);
     auto* im_info_data = im_info.data<T>();
     auto im_height = im_info_data[0];
     auto im_width = im_info_data[1];
@@ -15,12 +15,17 @@
 #include "lite/kernels/host/roi_perspective_transform_compute.h"
 #include <algorithm>
 #include <cmath>
+#include <vector>
+#include "lite/core/parallel_defines.h"
 
 namespace paddle {
 namespace lite {
 namespace kernels {
 namespace host {
 
+// The ROIs computed by a parallel task, which share the buffers of the taps.
+const int kRoisPerTask = 4;
+
 template <typename T>
 bool GT_E(T a, T b) {
   return (a > b) || fabs(a - b) < 1e-4;
@@ -179,26 +184,12 @@ bool in_quad(T x, T y, T roi_x[], T roi_y[]) {
 }
 
 /**
- * Perform bilinear interpolation in the input feature map.
+ * Get the positions and the weights of the bilinear interpolation in a
+ * channel of the input feature map, the source coords are in the map.
  */
 template <typename T>
-void bilinear_interpolate(const T* in_data,
-                          const int channels,
-                          const int width,
-                          const int height,
-                          int in_n,
-                          int in_c,
-                          T in_w,
-                          T in_h,
-                          T* val) {
-  // Deal with cases that source coords are out of feature map boundary
-  if (GT_E<T>(-0.5, in_w) || GT_E<T>(in_w, width - 0.5) ||
-      GT_E<T>(-0.5, in_h) || GT_E<T>(in_h, height - 0.5)) {
-    // empty
-    val[0] = 0.0;
-    return;
-  }
-
+void bilinear_taps(
+    const int width, const int height, T in_w, T in_h, int pos[], T w[]) {
   if (GT_E<T>(0, in_w)) {
     in_w = 0;
   }
@@ -228,17 +219,14 @@ void bilinear_interpolate(const T* in_data,
   T h_floor = in_h - in_h_floor;
   T w_ceil = 1 - w_floor;
   T h_ceil = 1 - h_floor;
-  const T* data = in_data + (in_n * channels + in_c) * height * width;
-  // Do bilinear interpolation
-  T v1 = data[in_h_floor * width + in_w_floor];
-  T v2 = data[in_h_ceil * width + in_w_floor];
-  T v3 = data[in_h_ceil * width + in_w_ceil];
-  T v4 = data[in_h_floor * width + in_w_ceil];
-  T w1 = w_ceil * h_ceil;
-  T w2 = w_ceil * h_floor;
-  T w3 = w_floor * h_floor;
-  T w4 = w_floor * h_ceil;
-  val[0] = w1 * v1 + w2 * v2 + w3 * v3 + w4 * v4;
+  pos[0] = in_h_floor * width + in_w_floor;
+  pos[1] = in_h_ceil * width + in_w_floor;
+  pos[2] = in_h_ceil * width + in_w_ceil;
+  pos[3] = in_h_floor * width + in_w_ceil;
+  w[0] = w_ceil * h_ceil;
+  w[1] = w_ceil * h_floor;
+  w[2] = w_floor * h_floor;
+  w[3] = w_floor * h_ceil;
 }
 
 template <class T>
@@ -276,61 +264,73 @@ void RoiPerspectiveTransformCompute<T>::Run() {
   const T* rois_data = rois->template data<T>();
   T* transform_matrix = out_transform_matrix->template mutable_data<T>();
 
-  for (int n = 0; n < rois_num; ++n) {
-    const T* n_rois = rois_data + n * 8;
-    T roi_x[4];
-    T roi_y[4];
-    for (int k = 0; k < 4; ++k) {
-      roi_x[k] = n_rois[2 * k] * spatial_scale;
-      roi_y[k] = n_rois[2 * k + 1] * spatial_scale;
-    }
-    int image_id = roi2image_data[n];
-    // Get transform matrix
-    T matrix[9];
-    get_transform_matrix<T>(
-        transformed_width, transformed_height, roi_x, roi_y, matrix);
-    for (int i = 0; i < 9; i++) {
-      transform_matrix[n * 9 + i] = matrix[i];
-    }
-    for (int c = 0; c < channels; ++c) {
+  // The source coords of an output pixel and its mask are computed once and
+  // shared by all of the channels, the ROIs are computed in parallel.
+  const int out_size = transformed_height * transformed_width;
+  const int in_size = in_height * in_width;
+  const int tasks = (rois_num + kRoisPerTask - 1) / kRoisPerTask;
+  LITE_PARALLEL_BEGIN(task, tid, tasks) {
+    std::vector<int> taps_pos(out_size * 4);
+    std::vector<T> taps_w(out_size * 4);
+    int end = std::min(rois_num, (task + 1) * kRoisPerTask);
+    for (int n = task * kRoisPerTask; n < end; ++n) {
+      const T* n_rois = rois_data + n * 8;
+      T roi_x[4];
+      T roi_y[4];
+      for (int k = 0; k < 4; ++k) {
+        roi_x[k] = n_rois[2 * k] * spatial_scale;
+        roi_y[k] = n_rois[2 * k + 1] * spatial_scale;
+      }
+      int image_id = roi2image_data[n];
+      // Get transform matrix
+      T matrix[9];
+      get_transform_matrix<T>(
+          transformed_width, transformed_height, roi_x, roi_y, matrix);
+      for (int i = 0; i < 9; i++) {
+        transform_matrix[n * 9 + i] = matrix[i];
+      }
+      int* n_mask = mask_data + n * out_size;
       for (int out_h = 0; out_h < transformed_height; ++out_h) {
         for (int out_w = 0; out_w < transformed_width; ++out_w) {
-          int out_index =
-              n * channels * transformed_height * transformed_width +
-              c * transformed_height * transformed_width +
-              out_h * transformed_width + out_w;
+          int index = out_h * transformed_width + out_w;
           T in_w, in_h;
           get_source_coords<T>(matrix, out_w, out_h, &in_w, &in_h);
-          if (in_quad<T>(in_w, in_h, roi_x, roi_y)) {
-            if (GT_E<T>(-0.5, in_w) ||
+          n_mask[index] =
+              in_quad<T>(in_w, in_h, roi_x, roi_y) &&
+              !(GT_E<T>(-0.5, in_w) ||
                 GT_E<T>(in_w, static_cast<T>(in_width - 0.5)) ||
                 GT_E<T>(-0.5, in_h) ||
-                GT_E<T>(in_h, static_cast<T>(in_height - 0.5))) {
-              output_data[out_index] = 0.0;
-              mask_data[(n * transformed_height + out_h) * transformed_width +
-                        out_w] = 0;
-            } else {
-              bilinear_interpolate(input_data,
-                                   channels,
-                                   in_width,
-                                   in_height,
-                                   image_id,
-                                   c,
-                                   in_w,
-                                   in_h,
-                                   output_data + out_index);
-              mask_data[(n * transformed_height + out_h) * transformed_width +
-                        out_w] = 1;
-            }
-          } else {
-            output_data[out_index] = 0.0;
-            mask_data[(n * transformed_height + out_h) * transformed_width +
-                      out_w] = 0;
+                GT_E<T>(in_h, static_cast<T>(in_height - 0.5)));
+          if (n_mask[index]) {
+            bilinear_taps<T>(in_width,
+                             in_height,
+                             in_w,
+                             in_h,
+                             &taps_pos[index * 4],
+                             &taps_w[index * 4]);
+          }
+        }
+      }
+      for (int c = 0; c < channels; ++c) {
+        const T* data =
+            input_data + static_cast<int64_t>(image_id * channels + c) *
+                             in_size;
+        T* out_data =
+            output_data + static_cast<int64_t>(n * channels + c) * out_size;
+        for (int index = 0; index < out_size; ++index) {
+          if (!n_mask[index]) {
+            out_data[index] = 0.0;
+            continue;
           }
+          const int* pos = &taps_pos[index * 4];
+          const T* w = &taps_w[index * 4];
+          out_data[index] = w[0] * data[pos[0]] + w[1] * data[pos[1]] +
+                            w[2] * data[pos[2]] + w[3] * data[pos[3]];
         }
       }
     }
   }
+  LITE_PARALLEL_END();
 }
 
 }  // namespace host
@@ -38,6 +38,21 @@ void SplitCompute<T, PType>::Run() {
     axis += static_cast<int>(param.x->dims().size());
   }
 
+  // The outputs are contiguous in x if all of the dims before axis are 1.
+  if (param.inplace && in_dim.count(0, axis) == 1) {
+    size_t offset = 0;
+    for (auto* out : dout) {
+      out->ShareDataWith(*param.x, offset, out->dims());
+      offset += out->numel() * sizeof(T);
+    }
+    return;
+  }
+  for (auto* out : dout) {
+    // out was a view of x in the previous run
+    if (out->SharesBufferWith(*param.x)) {
+      out->DetachBuffer();
+    }
+  }
   lite::host::math::split(din, dout, axis, in_strides);
 }
 
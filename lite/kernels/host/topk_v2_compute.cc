@@ -13,16 +13,12 @@
 // limitations under the License.
 
 #include "lite/kernels/host/topk_v2_compute.h"
-#include <utility>
-#include <vector>
+#include "lite/backends/host/math/topk.h"
 
 namespace paddle {
 namespace lite {
 namespace kernels {
 namespace host {
-bool comp_func(std::pair<float, int> a, std::pair<float, int> b) {
-  return (a.first > b.first);
-}
 
 void TopkV2Compute::Run() {
   auto& param = Param<operators::TopkParam>();
@@ -42,25 +38,9 @@ void TopkV2Compute::Run() {
   int outer_size = x_dims.count(0, axis);
   int axis_size = x_dims[axis];
   int inner_size = x_dims.count(axis + 1, dim_size);
-  int sum_size = axis_size * inner_size;
-  int out_sum_size = k * inner_size;
-
-  for (int i = 0; i < outer_size; i++) {
-    int glb_in_off = i * sum_size;
-    int glb_out_off = i * out_sum_size;
-    std::vector<std::pair<float, int>> vec;
-    for (int j = 0; j < axis_size; j++) {
-      vec.push_back(std::make_pair(x_data[glb_in_off + j * inner_size], j));
-    }
-    std::partial_sort(vec.begin(), vec.begin() + k, vec.end(), comp_func);
-    for (int j = 0; j < k; j++) {
-      for (int k = 0; k < inner_size; k++) {
-        int cur_off = glb_in_off + vec[j].second * inner_size + k;
-        out_val[glb_out_off + j * inner_size + k] = x_data[cur_off];
-        out_ind[glb_out_off + j * inner_size + k] = vec[j].second;
-      }
-    }
-  }
+  // each column of the inner dims is selected as a strided row
+  lite::host::math::topk<float>(
+      x_data, out_val, out_ind, outer_size, axis_size, inner_size, k);
 }
 
 }  // namespace host
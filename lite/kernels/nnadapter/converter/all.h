@@ -63,12 +63,12 @@ REGISTER_CONVERTER(reshape,
                    ConvertReshape,
                    "rockchip_npu,mediatek_apu,huawei_kirin_npu,huawei_ascend_"
                    "npu,amlogic_npu,imagination_nna,verisilicon_timvx,"
-                   "kunlunxin_xtcl,cambricon_mlu");
+                   "kunlunxin_xtcl,cambricon_mlu,fake_device");
 REGISTER_CONVERTER(reshape2,
                    ConvertReshape,
                    "rockchip_npu,mediatek_apu,huawei_kirin_npu,huawei_ascend_"
                    "npu,amlogic_npu,imagination_nna,verisilicon_timvx,"
-                   "kunlunxin_xtcl,cambricon_mlu");
+                   "kunlunxin_xtcl,cambricon_mlu,fake_device");
 REGISTER_CONVERTER(unsqueeze,
                    ConvertUnsqueeze,
                    "huawei_ascend_npu,cambricon_mlu");
@@ -80,22 +80,23 @@ REGISTER_CONVERTER(elementwise_add,
                    ConvertElementwise,
                    "rockchip_npu,mediatek_apu,huawei_kirin_npu,huawei_ascend_"
                    "npu,amlogic_npu,imagination_nna,cambricon_mlu,verisilicon_"
-                   "timvx,kunlunxin_xtcl");
+                   "timvx,kunlunxin_xtcl,fake_device");
 REGISTER_CONVERTER(elementwise_sub,
                    ConvertElementwise,
                    "rockchip_npu,mediatek_apu,huawei_kirin_npu,huawei_ascend_"
                    "npu,amlogic_npu,imagination_nna,cambricon_mlu,verisilicon_"
-                   "timvx,kunlunxin_xtcl");
+                   "timvx,kunlunxin_xtcl,fake_device");
 REGISTER_CONVERTER(elementwise_mul,
                    ConvertElementwise,
                    "rockchip_npu,mediatek_apu,huawei_kirin_npu,huawei_ascend_"
                    "npu,amlogic_npu,imagination_nna,cambricon_mlu,verisilicon_"
-                   "timvx,kunlunxin_xtcl");
+                   "timvx,kunlunxin_xtcl,fake_device");
 REGISTER_CONVERTER(
     elementwise_div,
     ConvertElementwise,
     "rockchip_npu,mediatek_apu,huawei_kirin_npu,huawei_ascend_"
-    "npu,amlogic_npu,imagination_nna,verisilicon_timvx,kunlunxin_xtcl");
+    "npu,amlogic_npu,imagination_nna,verisilicon_timvx,kunlunxin_xtcl,"
+    "fake_device");
 REGISTER_CONVERTER(elementwise_max,
                    ConvertElementwise,
                    "huawei_ascend_npu,imagination_nna,kunlunxin_xtcl");
@@ -107,27 +108,31 @@ REGISTER_CONVERTER(elementwise_pow,
                    "huawei_ascend_npu,cambricon_mlu");
 REGISTER_CONVERTER(fusion_elementwise_add_activation,
                    ConvertElementwise,
-                   "huawei_ascend_npu,kunlunxin_xtcl");
+                   "huawei_ascend_npu,kunlunxin_xtcl,fake_device");
 REGISTER_CONVERTER(
     fusion_elementwise_add_activation,
     ConvertElementwise,
     "rockchip_npu,mediatek_apu,huawei_kirin_npu,huawei_ascend_"
-    "npu,amlogic_npu,imagination_nna,verisilicon_timvx,kunlunxin_xtcl");
+    "npu,amlogic_npu,imagination_nna,verisilicon_timvx,kunlunxin_xtcl,"
+    "fake_device");
 REGISTER_CONVERTER(
     fusion_elementwise_sub_activation,
     ConvertElementwise,
     "rockchip_npu,mediatek_apu,huawei_kirin_npu,huawei_ascend_"
-    "npu,amlogic_npu,imagination_nna,verisilicon_timvx,kunlunxin_xtcl");
+    "npu,amlogic_npu,imagination_nna,verisilicon_timvx,kunlunxin_xtcl,"
+    "fake_device");
 REGISTER_CONVERTER(
     fusion_elementwise_mul_activation,
     ConvertElementwise,
     "rockchip_npu,mediatek_apu,huawei_kirin_npu,huawei_ascend_"
-    "npu,amlogic_npu,imagination_nna,verisilicon_timvx,kunlunxin_xtcl");
+    "npu,amlogic_npu,imagination_nna,verisilicon_timvx,kunlunxin_xtcl,"
+    "fake_device");
 REGISTER_CONVERTER(
     fusion_elementwise_div_activation,
     ConvertElementwise,
     "rockchip_npu,mediatek_apu,huawei_kirin_npu,huawei_ascend_"
-    "npu,amlogic_npu,imagination_nna,verisilicon_timvx,kunlunxin_xtcl");
+    "npu,amlogic_npu,imagination_nna,verisilicon_timvx,kunlunxin_xtcl,"
+    "fake_device");
 REGISTER_CONVERTER(fusion_elementwise_min_activation,
                    ConvertElementwise,
                    "huawei_ascend_npu,imagination_nna,kunlunxin_xtcl");
@@ -144,17 +149,18 @@ REGISTER_CONVERTER(
     sigmoid,
     ConvertUnaryActivations,
     "rockchip_npu,mediatek_apu,huawei_kirin_npu,huawei_ascend_"
-    "npu,amlogic_npu,cambricon_mlu,verisilicon_timvx,kunlunxin_xtcl");
+    "npu,amlogic_npu,cambricon_mlu,verisilicon_timvx,kunlunxin_xtcl,"
+    "fake_device");
 REGISTER_CONVERTER(relu,
                    ConvertUnaryActivations,
                    "rockchip_npu,mediatek_apu,huawei_kirin_npu,huawei_ascend_"
                    "npu,amlogic_npu,imagination_nna,cambricon_mlu,verisilicon_"
-                   "timvx,kunlunxin_xtcl");
+                   "timvx,kunlunxin_xtcl,fake_device");
 REGISTER_CONVERTER(relu6,
                    ConvertUnaryActivations,
                    "rockchip_npu,mediatek_apu,huawei_kirin_npu,huawei_ascend_"
                    "npu,amlogic_npu,imagination_nna,cambricon_mlu,verisilicon_"
-                   "timvx,kunlunxin_xtcl");
+                   "timvx,kunlunxin_xtcl,fake_device");
 REGISTER_CONVERTER(
     leaky_relu,
     ConvertLeakyRelu,
@@ -163,7 +169,8 @@ REGISTER_CONVERTER(
     tanh,
     ConvertUnaryActivations,
     "rockchip_npu,mediatek_apu,huawei_kirin_npu,huawei_ascend_"
-    "npu,amlogic_npu,cambricon_mlu,verisilicon_timvx,kunlunxin_xtcl");
+    "npu,amlogic_npu,cambricon_mlu,verisilicon_timvx,kunlunxin_xtcl,"
+    "fake_device");
 REGISTER_CONVERTER(abs, ConvertUnaryActivations, "huawei_ascend_npu");
 REGISTER_CONVERTER(exp, ConvertUnaryActivations, "huawei_ascend_npu");
 REGISTER_CONVERTER(instance_norm, ConvertInstanceNorm, "huawei_ascend_npu");
@@ -257,12 +264,14 @@ REGISTER_CONVERTER(
     flatten,
     ConvertFlatten,
     "rockchip_npu,mediatek_apu,huawei_kirin_npu,huawei_ascend_"
-    "npu,amlogic_npu,verisilicon_timvx,kunlunxin_xtcl,cambricon_mlu");
+    "npu,amlogic_npu,verisilicon_timvx,kunlunxin_xtcl,cambricon_mlu,"
+    "fake_device");
 REGISTER_CONVERTER(
     flatten2,
     ConvertFlatten,
     "rockchip_npu,mediatek_apu,huawei_kirin_npu,huawei_ascend_"
-    "npu,amlogic_npu,verisilicon_timvx,kunlunxin_xtcl,cambricon_mlu");
+    "npu,amlogic_npu,verisilicon_timvx,kunlunxin_xtcl,cambricon_mlu,"
+    "fake_device");
 REGISTER_CONVERTER(
     flatten_contiguous_range,
     ConvertFlattenContiguousRange,
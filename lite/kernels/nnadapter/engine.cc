@@ -15,11 +15,13 @@
 #include "lite/kernels/nnadapter/engine.h"
 #include <sys/time.h>
 #include <time.h>
+#include <limits>
 #include <utility>
 #include "lite/core/op_registry.h"
 #include "lite/core/subgraph/subgraph_bridge_registry.h"
 #include "lite/kernels/nnadapter/converter/converter.h"
 #include "lite/utils/env.h"
+#include "lite/utils/hash.h"
 #include "lite/utils/md5.h"
 
 namespace paddle {
@@ -27,12 +29,112 @@ namespace lite {
 namespace kernels {
 namespace nnadapter {
 
+// The hash of the data of the weights in the order of their shapes, as the
+// one recorded by the subgraph pass, or the empty string if any of them isn't
+// in the scope.
+std::string HashWeightData(Scope* exec_scope,
+                           const std::vector<std::string>& weight_shapes) {
+  uint64_t hash = HashBytes(nullptr, 0);
+  for (auto& weight_shape : weight_shapes) {
+    auto tensor =
+        exec_scope->FindTensor(weight_shape.substr(0, weight_shape.rfind(':')));
+    if (!tensor || !tensor->IsInitialized()) return "";
+    hash = HashBytes(tensor->raw_data(), tensor->memory_size(), hash);
+  }
+  return std::to_string(hash);
+}
+
+// The digest of the types, the variables and the attributes of the ops of the
+// subgraph, and the shapes and the data of the weights they read. The
+// subgraphs of the different models which have the same input names and
+// shapes are told apart by it, so they may share a model cache dir. The
+// weights aren't saved in the offline mode, see SUBGRAPH_ONLINE_MODE, so the
+// hash of their data recorded by the subgraph pass is taken instead, and only
+// their shapes are hashed for the models optimized by the older versions.
+std::string GenerateModelDigest(
+    int block_idx,
+    const std::shared_ptr<const cpp::ProgramDesc>& program_desc,
+    Scope* exec_scope,
+    const std::vector<std::string>& weight_shapes,
+    const std::string& weight_digest) {
+  std::ostringstream os;
+  // The float attributes, e.g. the quantization scales, are told apart by all
+  // of their digits.
+  os.precision(std::numeric_limits<float>::max_digits10);
+  for (auto& weight_shape : weight_shapes) {
+    os << weight_shape << ";";
+  }
+  auto weight_data_digest = HashWeightData(exec_scope, weight_shapes);
+  os << (weight_data_digest.empty() ? weight_digest : weight_data_digest)
+     << ";";
+  auto block_desc = program_desc->GetBlock<cpp::BlockDesc>(block_idx);
+  for (size_t op_idx = 0; op_idx < block_desc->OpsSize(); op_idx++) {
+    auto op_desc = block_desc->GetOp<cpp::OpDesc>(op_idx);
+    OpInfo op_info(*op_desc);
+    os << op_info.Type() << "(";
+    for (auto& var_name : op_info.input_vars()) {
+      os << var_name << ",";
+    }
+    os << ")(";
+    for (auto& var_name : op_info.output_vars()) {
+      os << var_name << ",";
+    }
+    os << ")";
+    for (auto& attr_name : op_info.AttrNames()) {
+      os << attr_name << ":";
+      switch (op_info.GetAttrType(attr_name)) {
+        case OpAttrType::INT:
+          os << op_info.GetAttr<int>(attr_name);
+          break;
+        case OpAttrType::LONG:
+          os << op_info.GetAttr<int64_t>(attr_name);
+          break;
+        case OpAttrType::FLOAT:
+          os << op_info.GetAttr<float>(attr_name);
+          break;
+        case OpAttrType::BOOLEAN:
+          os << op_info.GetAttr<bool>(attr_name);
+          break;
+        case OpAttrType::STRING:
+          os << op_info.GetAttr<std::string>(attr_name);
+          break;
+        case OpAttrType::INTS:
+          for (auto v : op_info.GetAttr<std::vector<int>>(attr_name)) {
+            os << v << ",";
+          }
+          break;
+        case OpAttrType::LONGS:
+          for (auto v : op_info.GetAttr<std::vector<int64_t>>(attr_name)) {
+            os << v << ",";
+          }
+          break;
+        case OpAttrType::FLOATS:
+          for (auto v : op_info.GetAttr<std::vector<float>>(attr_name)) {
+            os << v << ",";
+          }
+          break;
+        case OpAttrType::STRINGS:
+          for (auto& v : op_info.GetAttr<std::vector<std::string>>(attr_name)) {
+            os << v << ",";
+          }
+          break;
+        default:
+          break;
+      }
+      os << ";";
+    }
+  }
+  return MD5(os.str());
+}
+
 // A simple token for identifying the model cache is generated based on the MD5
 // algorithm and the following information: 1) The valid device names 2) The
-// input variable names 3) The input variable shapes
+// input variable names 3) The input variable shapes 4) The digest of the ops
+// and the weights of the subgraph
 std::string GenerateModelCacheToken(
     const std::vector<std::string>& device_names,
-    const std::vector<Variable>& input_vars) {
+    const std::vector<Variable>& input_vars,
+    const std::string& model_digest) {
   std::ostringstream os;
   for (auto device_name : device_names) {
     os << device_name;
@@ -43,6 +145,7 @@ std::string GenerateModelCacheToken(
       os << input_shape;
     }
   }
+  os << model_digest;
   return MD5(os.str());
 }
 
@@ -240,11 +343,15 @@ Engine::Engine(KernelContext* ctx,
                const std::vector<std::string>& input_names,
                const std::vector<std::string>& output_names,
                const std::vector<float>& input_scales,
-               const std::vector<float>& output_scales)
+               const std::vector<float>& output_scales,
+               const std::vector<std::string>& weight_shapes,
+               const std::string& weight_digest)
     : ctx_(ctx),
       block_idx_(block_idx),
       program_desc_(program_desc),
       exec_scope_(exec_scope) {
+  model_digest_ = GenerateModelDigest(
+      block_idx, program_desc, exec_scope, weight_shapes, weight_digest);
   int result;
   // Obtain the same order every time by sorting the input and output names,
   // because the topological order may be different each time of the partition
@@ -321,50 +428,79 @@ Engine::~Engine() {
   }
 }
 
-bool Engine::Run() {
-  // Update the input dimensions to generate a key to find a compiled device
-  // program
+std::vector<std::vector<int64_t>> Engine::GetInputDimensions() {
   auto input_count = input_vars_.size();
   std::vector<std::vector<int64_t>> input_dims(input_count);
   for (size_t i = 0; i < input_count; i++) {
     input_dims[i] = input_vars_[i].value->dims().Vectorize();
   }
+  return input_dims;
+}
+
+std::shared_ptr<Program> Engine::Compile() {
+  std::vector<std::string> device_names;
+  for (auto* device : devices_) {
+    const char* name = nullptr;
+    NNAdapterDevice_getName_invoke(device, &name);
+    device_names.push_back(name);
+  }
+  auto program = std::make_shared<Program>(context_);
+  // Take the model cache buffer from the scope
+  std::vector<char> model_cache_buffer;
+  // Generate a cache token based on the input names and shapes and the model
+  auto model_cache_token =
+      GenerateModelCacheToken(device_names, input_vars_, model_digest_);
+  VLOG(3) << "NNAdapter model_cache_token: " << model_cache_token;
+  ctx_->As<NNAdapterContext>().NNAdapterModelCacheBuffers(
+      exec_scope_, model_cache_token, &model_cache_buffer);
+  VLOG(3) << "NNAdapter model_cache_buffer size: " << model_cache_buffer.size();
+  // Load the compiled device program from the model cache buffer or file
+  if (!program->LoadFromCache(
+          model_cache_token, &model_cache_buffer, model_cache_dir_)) {
+    // Compile the model online to generate the device program and cache it to
+    // the file
+    CHECK(program->BuildAndCacheToFile(block_idx_,
+                                       program_desc_,
+                                       exec_scope_,
+                                       input_vars_,
+                                       &output_vars_,
+                                       model_cache_token,
+                                       model_cache_dir_));
+  }
+  CHECK(program->IsValid());
+  CHECK(program->SetInputsAndOutputs(&input_vars_, &output_vars_));
+  return program;
+}
+
+void Engine::Prepare() {
+  for (auto& input_var : input_vars_) {
+    auto value = input_var.value;
+    if (!value || value->precision() == PRECISION(kUnk) ||
+        value->dims().size() == 0) {
+      return;
+    }
+    for (auto dim : value->dims().Vectorize()) {
+      if (dim <= 0) {
+        return;
+      }
+    }
+  }
+  auto input_dims = GetInputDimensions();
+  if (!programs_.count(input_dims)) {
+    programs_[input_dims] = Compile();
+  }
+}
+
+bool Engine::Run() {
+  // Update the input dimensions to generate a key to find a compiled device
+  // program
+  auto input_dims = GetInputDimensions();
   // Find the compiled device program according to the input dimensions
   std::shared_ptr<Program> program = nullptr;
   if (!programs_.count(input_dims)) {
     // Rebuild the device program corresponding to the input dimensions if not
     // found
-    std::vector<std::string> device_names;
-    for (auto* device : devices_) {
-      const char* name = nullptr;
-      NNAdapterDevice_getName_invoke(device, &name);
-      device_names.push_back(name);
-    }
-    program = std::make_shared<Program>(context_);
-    // Take the model cache buffer from the scope
-    std::vector<char> model_cache_buffer;
-    // Generate a cache token based on the input names and shapes
-    auto model_cache_token = GenerateModelCacheToken(device_names, input_vars_);
-    VLOG(3) << "NNAdapter model_cache_token: " << model_cache_token;
-    ctx_->As<NNAdapterContext>().NNAdapterModelCacheBuffers(
-        exec_scope_, model_cache_token, &model_cache_buffer);
-    VLOG(3) << "NNAdapter model_cache_buffer size: "
-            << model_cache_buffer.size();
-    // Load the compiled device program from the model cache buffer or file
-    if (!program->LoadFromCache(
-            model_cache_token, &model_cache_buffer, model_cache_dir_)) {
-      // Compile the model online to generate the device program and cache it to
-      // the file
-      CHECK(program->BuildAndCacheToFile(block_idx_,
-                                         program_desc_,
-                                         exec_scope_,
-                                         input_vars_,
-                                         &output_vars_,
-                                         model_cache_token,
-                                         model_cache_dir_));
-    }
-    CHECK(program->IsValid());
-    CHECK(program->SetInputsAndOutputs(&input_vars_, &output_vars_));
+    program = Compile();
     programs_[input_dims] = program;
   } else {
     program = programs_[input_dims];
@@ -76,11 +76,21 @@ class Engine {
          const std::vector<std::string>& input_names,
          const std::vector<std::string>& output_names,
          const std::vector<float>& input_scales,
-         const std::vector<float>& output_scales);
+         const std::vector<float>& output_scales,
+         const std::vector<std::string>& weight_shapes,
+         const std::string& weight_digest);
   ~Engine();
+  // Compile the device program for the current input dimensions ahead of the
+  // first Run, it's skipped if the dimensions or the precisions of the inputs
+  // are not known yet, e.g. they are computed by the other kernels.
+  void Prepare();
   bool Run();
 
  private:
+  std::vector<std::vector<int64_t>> GetInputDimensions();
+  // Load or build the device program for the current input dimensions
+  std::shared_ptr<Program> Compile();
+
   KernelContext* ctx_{nullptr};
   int block_idx_{-1};
   const std::shared_ptr<const cpp::ProgramDesc> program_desc_{nullptr};
@@ -92,6 +102,9 @@ class Engine {
   std::map<std::vector<std::vector<int64_t>>, std::shared_ptr<Program>>
       programs_;
   std::string model_cache_dir_{""};
+  // The digest of the ops and the weights of the subgraph, see
+  // GenerateModelDigest()
+  std::string model_digest_{""};
 };
 
 }  // namespace nnadapter
@@ -28,8 +28,11 @@ void SubgraphCompute::PrepareForRun() {
                            param.input_data_names,
                            param.output_data_names,
                            param.input_data_scales,
-                           param.output_data_scales));
+                           param.output_data_scales,
+                           param.weight_data_shapes,
+                           param.weight_data_digest));
   CHECK(engine_);
+  engine_->Prepare();
 }
 
 void SubgraphCompute::Run() {
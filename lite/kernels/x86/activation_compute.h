@@ -25,6 +25,7 @@
 #include "lite/backends/x86/fluid/eigen.h"
 #include "lite/backends/x86/math/activation.h"
 #include "lite/backends/x86/math/blas.h"
+#include "lite/backends/x86/math/calib.h"
 #include "lite/core/kernel.h"
 #include "lite/core/op_lite.h"
 #include "lite/core/op_registry.h"
@@ -182,36 +183,7 @@ class TanhCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
   virtual ~TanhCompute() = default;
 };
 
-// gelu(x) = 0.5 * x *  (1 + erf(x / sqrt(2)))
-template <typename T>
-struct GeluFunctor : public BaseActivationFunctor<T> {
-  template <typename Device, typename X, typename Out>
-  void operator()(Device d, X x, Out out) const {
-// Because the execute or device context can not be deliver here, it keep the
-// marco for NVCC.
-#if defined(PADDLE_WITH_MKLML) && !defined(_WIN32) && !defined(__APPLE__) && \
-    !defined(__OSX__) && !defined(PADDLE_WITH_CUDA)
-    auto x_data = x.data();
-    auto out_data = out.data();
-    int n = std::min(x.size(), out.size());
-    std::memset(out_data, 0, n * sizeof(T));
-    paddle::lite::x86::math::CBlas<T>::AXPY(
-        n, static_cast<T>(M_SQRT1_2), x_data, 1, out_data, 1);
-    paddle::lite::x86::math::CBlas<T>::VMERF(n, out_data, out_data, VML_LA);
-    for (int i = 0; i < n; i++) {
-      out_data[i] += static_cast<T>(1);
-    }
-    paddle::lite::x86::math::CBlas<T>::VMUL(n, x_data, out_data, out_data);
-    for (int i = 0; i < n; i++) {
-      out_data[i] *= static_cast<T>(0.5);
-    }
-#else
-    auto temp = (x * static_cast<T>(M_SQRT1_2)).erf();
-    out.device(d) = x * static_cast<T>(0.5) * (static_cast<T>(1) + temp);
-#endif
-  }
-};
-
+// gelu(x) = 0.5 * x *  (1 + erf(x / sqrt(2))), or its tanh approximation
 template <typename T>
 class GeluCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
  public:
@@ -220,8 +192,12 @@ class GeluCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
   void Run() override {
     auto& param = *param_.get_mutable<operators::ActivationParam>();
 
-    param.Out->template mutable_data<T>();
-    Activate<GeluFunctor<T>>(param.X, param.Out);
+    auto x_data = param.X->template data<T>();
+    auto output_data = param.Out->template mutable_data<T>();
+    lite::x86::math::gelu<T>(x_data,
+                             output_data,
+                             param.X->numel(),
+                             param.gelu_approximate);
   }
 
   virtual ~GeluCompute() = default;
@@ -393,6 +369,68 @@ class HardSwishComputeCompute
   virtual ~HardSwishComputeCompute() = default;
 };
 
+// The int8 input has only 256 values, so the activation is computed once for
+// each of them in PrepareForRun and the Run is a table lookup.
+template <typename OutT>
+class ActivationInt8Compute
+    : public KernelLite<TARGET(kX86), PRECISION(kInt8)> {
+ public:
+  using param_t = operators::ActivationParam;
+
+  void PrepareForRun() override {
+    auto& param = *param_.get_mutable<operators::ActivationParam>();
+    for (int i = -128; i < 128; i++) {
+      float x = i * param.input_scale;
+      float y = x;
+      switch (param.active_type) {
+        case lite_api::ActivationType::kRelu:
+          y = (std::max)(x, 0.f);
+          break;
+        case lite_api::ActivationType::kRelu6:
+          y = (std::min)((std::max)(x, 0.f), param.threshold);
+          break;
+        case lite_api::ActivationType::kLeakyRelu:
+          y = x > 0.f ? x : x * param.Leaky_relu_alpha;
+          break;
+        case lite_api::ActivationType::kHardSwish:
+          y = x *
+              (std::min)((std::max)(x + param.hard_swish_offset, 0.f),
+                         param.hard_swish_threshold) /
+              param.hard_swish_scale;
+          break;
+        case lite_api::ActivationType::kSigmoid:
+          y = 1.f / (1.f + std::exp(-x));
+          break;
+        case lite_api::ActivationType::kTanh:
+          y = std::tanh(x);
+          break;
+        default:
+          LOG(FATAL) << "Unsupported int8 activation type: "
+                     << static_cast<int>(param.active_type);
+      }
+      table_[static_cast<uint8_t>(i)] =
+          lite::x86::math::quantize_to<OutT>(y, param.output_scale);
+    }
+  }
+
+  void Run() override {
+    auto& param = *param_.get_mutable<operators::ActivationParam>();
+    auto x_data = reinterpret_cast<const uint8_t*>(
+        param.X->template data<int8_t>());
+    auto out_data = param.Out->template mutable_data<OutT>();
+    int64_t size = param.X->numel();
+#pragma omp parallel for
+    for (int64_t i = 0; i < size; i++) {
+      out_data[i] = table_[x_data[i]];
+    }
+  }
+
+  virtual ~ActivationInt8Compute() = default;
+
+ private:
+  OutT table_[256];
+};
+
 }  // namespace x86
 }  // namespace kernels
 }  // namespace lite
@@ -107,6 +107,30 @@ class CalibComputeInt64ToFp32 : public KernelLite<TARGET(kX86), Ptype, DLType> {
  private:
 };
 
+template <PrecisionType Ptype, DataLayoutType DLType>
+class CalibComputeFp32ToBf16 : public KernelLite<TARGET(kX86), Ptype, DLType> {
+ public:
+  using param_t = operators::CalibParam;
+
+  void Run() override;
+
+  ~CalibComputeFp32ToBf16() override{};
+
+ private:
+};
+
+template <PrecisionType Ptype, DataLayoutType DLType>
+class CalibComputeBf16ToFp32 : public KernelLite<TARGET(kX86), Ptype, DLType> {
+ public:
+  using param_t = operators::CalibParam;
+
+  void Run() override;
+
+  ~CalibComputeBf16ToFp32() override{};
+
+ private:
+};
+
 }  // namespace x86
 }  // namespace kernels
 }  // namespace lite
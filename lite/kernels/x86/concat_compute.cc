@@ -14,6 +14,9 @@
 
 #include "lite/kernels/x86/concat_compute.h"
 
+typedef paddle::lite::kernels::x86::ConcatInt8Compute<int8_t> ConcatInt8Out;
+typedef paddle::lite::kernels::x86::ConcatInt8Compute<float> ConcatFp32Out;
+
 REGISTER_LITE_KERNEL(concat,
                      kX86,
                      kFloat,
@@ -49,3 +52,19 @@ REGISTER_LITE_KERNEL(concat,
                {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kInt64))})
     .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kInt64))})
     .Finalize();
+
+REGISTER_LITE_KERNEL(concat, kX86, kInt8, kNCHW, ConcatInt8Out, int8_out)
+    .BindInput("X", {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kInt8))})
+    .BindInput("AxisTensor",
+               {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kInt32))})
+    .BindOutput("Out",
+                {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kInt8))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(concat, kX86, kInt8, kNCHW, ConcatFp32Out, fp32_out)
+    .BindInput("X", {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kInt8))})
+    .BindInput("AxisTensor",
+               {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kInt32))})
+    .BindOutput("Out",
+                {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kFloat))})
+    .Finalize();
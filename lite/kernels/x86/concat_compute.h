@@ -15,6 +15,8 @@
 
 #include <Eigen/Core>
 #include <vector>
+#include "lite/backends/host/math/concat.h"
+#include "lite/backends/x86/math/calib.h"
 #include "lite/core/kernel.h"
 #include "lite/core/op_registry.h"
 #include "lite/core/types.h"
@@ -56,6 +58,10 @@ class ConcatCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
     }
 
     auto* out = param.output;
+    if (param.inplace &&
+        lite::host::math::concat_views<T>(param.x, axis, true, out)) {
+      return;
+    }
     T* output_data = param.output->template mutable_data<T>();
 
     int offset_concat_axis = 0;
@@ -78,6 +84,62 @@ class ConcatCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
   virtual ~ConcatCompute() = default;
 };
 
+// Concat the int8 inputs with the different scales, each input is
+// requantized to the output scale or dequantized to float by a lookup table
+// while it's copied.
+template <typename OutT>
+class ConcatInt8Compute : public KernelLite<TARGET(kX86), PRECISION(kInt8)> {
+ public:
+  using param_t = operators::ConcatParam;
+
+  void Run() override {
+    auto& param = *param_.get_mutable<param_t>();
+    int axis = param.axis;
+    auto* axis_tensor = param.axis_tensor;
+    if (axis_tensor != nullptr) {
+      auto* axis_tensor_data = axis_tensor->template data<int>();
+      axis = axis_tensor_data[0];
+    }
+    const auto& x_dims = param.x[0]->dims();
+    if (axis < 0) {
+      axis += static_cast<int>(x_dims.size());
+    }
+    CHECK_EQ(param.input_scales.size(), param.x.size());
+
+    auto* out = param.output;
+    OutT* output_data = param.output->template mutable_data<OutT>();
+
+    int offset_concat_axis = 0;
+    int num_concat = count(0, axis, x_dims);
+    int concat_input_size = count(axis + 1, x_dims.size(), x_dims);
+    const int top_concat_axis = out->dims()[axis];
+    OutT table[256];
+    for (size_t i = 0; i < param.x.size(); ++i) {
+      const uint8_t* bottom_data = reinterpret_cast<const uint8_t*>(
+          param.x[i]->template data<int8_t>());
+      const int64_t bottom_concat_axis = param.x[i]->dims()[axis];
+      for (int v = -128; v < 128; v++) {
+        table[static_cast<uint8_t>(v)] =
+            lite::x86::math::quantize_to<OutT>(v * param.input_scales[i],
+                                               param.output_scale);
+      }
+      const int64_t size = bottom_concat_axis * concat_input_size;
+#pragma omp parallel for
+      for (int n = 0; n < num_concat; ++n) {
+        OutT* dst =
+            output_data +
+            (n * top_concat_axis + offset_concat_axis) * concat_input_size;
+        const uint8_t* src = bottom_data + n * size;
+        for (int64_t k = 0; k < size; k++) {
+          dst[k] = table[src[k]];
+        }
+      }
+      offset_concat_axis += bottom_concat_axis;
+    }
+  }
+  virtual ~ConcatInt8Compute() = default;
+};
+
 }  // namespace x86
 }  // namespace kernels
 }  // namespace lite
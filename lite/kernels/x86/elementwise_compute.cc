@@ -16,8 +16,10 @@
 // by 0 will get the correct result in ElementWise OP.
 
 #include "lite/kernels/x86/elementwise_compute.h"
+#include <algorithm>
 #include <string>
 #include <vector>
+#include "lite/backends/x86/math/calib.h"
 #include "lite/backends/x86/math/elementwise.h"
 #include "lite/backends/x86/math/elementwise_common_broadcast_config.h"
 #include "lite/kernels/host/elementwise_op_func.h"
@@ -350,6 +352,62 @@ void elementwise_compute_template(paddle::lite::KernelBase* kernel,
     }                                                                         \
   }
 
+// The int8 inputs are dequantized by their own scales, combined in float and
+// then quantized by the output scale or written as float. Only the same
+// shapes and the fast broadcast of Y are supported.
+template <typename OutT, typename OpFn>
+void elementwise_int8_compute(const operators::ElementwiseParam& param,
+                              OpFn op) {
+  auto x_dims = param.X->dims();
+  auto y_dims = param.Y->dims();
+  const int8_t* x_data = param.X->data<int8_t>();
+  const int8_t* y_data = param.Y->data<int8_t>();
+  OutT* out_data = param.Out->mutable_data<OutT>();
+  const float x_scale = param.x_input_scale;
+  const float y_scale = param.y_input_scale;
+  const float out_scale = param.output_scale;
+  const bool has_relu = param.activation_type == "relu";
+  CHECK(param.activation_type.empty() || has_relu)
+      << "Unsupported int8 elementwise activation: " << param.activation_type;
+  int pre = 1;
+  int n = 1;
+  int post = 1;
+  if (x_dims == y_dims) {
+    n = x_dims.production();
+  } else if (!is_fast_broadcast(x_dims, y_dims, param.axis, &pre, &n, &post)) {
+    LOG(FATAL) << "Unsupported int8 elementwise broadcast, x_dims: " << x_dims
+               << ", y_dims: " << y_dims << ", axis: " << param.axis;
+  }
+  const bool broadcast_y = x_dims != y_dims;
+#pragma omp parallel for
+  for (int i = 0; i < pre * n; i++) {
+    const int8_t* x_ptr = x_data + static_cast<int64_t>(i) * post;
+    const int8_t* y_ptr =
+        broadcast_y ? y_data + i % n : y_data + static_cast<int64_t>(i) * post;
+    OutT* out_ptr = out_data + static_cast<int64_t>(i) * post;
+    for (int k = 0; k < post; k++) {
+      float y = (broadcast_y ? y_ptr[0] : y_ptr[k]) * y_scale;
+      float v = op(x_ptr[k] * x_scale, y);
+      if (has_relu) v = (std::max)(v, 0.f);
+      out_ptr[k] = x86_math::quantize_to<OutT>(v, out_scale);
+    }
+  }
+}
+
+template <typename OutT>
+void ElementwiseAddInt8Compute<OutT>::Run() {
+  auto& param = this->template Param<operators::ElementwiseParam>();
+  elementwise_int8_compute<OutT>(param,
+                                 [](float x, float y) { return x + y; });
+}
+
+template <typename OutT>
+void ElementwiseMulInt8Compute<OutT>::Run() {
+  auto& param = this->template Param<operators::ElementwiseParam>();
+  elementwise_int8_compute<OutT>(param,
+                                 [](float x, float y) { return x * y; });
+}
+
 // clang-format off
 ElementwiseOpCompute(Add)
 ElementwiseOpActivationCompute(Add)
@@ -736,3 +794,40 @@ REGISTER_LITE_KERNEL(elementwise_min,
     .BindInput("Y", {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kInt64))})
     .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kInt64))})
     .Finalize();
+
+typedef paddle::lite::kernels::x86::ElementwiseAddInt8Compute<int8_t>
+    AddInt8Out;
+typedef paddle::lite::kernels::x86::ElementwiseAddInt8Compute<float>
+    AddFp32Out;
+typedef paddle::lite::kernels::x86::ElementwiseMulInt8Compute<int8_t>
+    MulInt8Out;
+typedef paddle::lite::kernels::x86::ElementwiseMulInt8Compute<float>
+    MulFp32Out;
+
+REGISTER_LITE_KERNEL(elementwise_add, kX86, kInt8, kNCHW, AddInt8Out, int8_out)
+    .BindInput("X", {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kInt8))})
+    .BindInput("Y", {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kInt8))})
+    .BindOutput("Out",
+                {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kInt8))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(elementwise_add, kX86, kInt8, kNCHW, AddFp32Out, fp32_out)
+    .BindInput("X", {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kInt8))})
+    .BindInput("Y", {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kInt8))})
+    .BindOutput("Out",
+                {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kFloat))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(elementwise_mul, kX86, kInt8, kNCHW, MulInt8Out, int8_out)
+    .BindInput("X", {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kInt8))})
+    .BindInput("Y", {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kInt8))})
+    .BindOutput("Out",
+                {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kInt8))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(elementwise_mul, kX86, kInt8, kNCHW, MulFp32Out, fp32_out)
+    .BindInput("X", {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kInt8))})
+    .BindInput("Y", {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kInt8))})
+    .BindOutput("Out",
+                {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kFloat))})
+    .Finalize();
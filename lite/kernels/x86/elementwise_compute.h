@@ -184,6 +184,24 @@ class ElementwisePowActivationCompute
   virtual ~ElementwisePowActivationCompute() = default;
 };
 
+template <typename OutT>
+class ElementwiseAddInt8Compute
+    : public KernelLite<TARGET(kX86), PRECISION(kInt8)> {
+ public:
+  void Run() override;
+
+  virtual ~ElementwiseAddInt8Compute() = default;
+};
+
+template <typename OutT>
+class ElementwiseMulInt8Compute
+    : public KernelLite<TARGET(kX86), PRECISION(kInt8)> {
+ public:
+  void Run() override;
+
+  virtual ~ElementwiseMulInt8Compute() = default;
+};
+
 }  // namespace x86
 }  // namespace kernels
 }  // namespace lite
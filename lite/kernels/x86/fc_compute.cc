@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "lite/kernels/x86/fc_compute.h"
+#include "lite/backends/x86/math/gemm_bf16.h"
 #include "lite/backends/x86/math/gemm_s8u8_compute.h"
 #include "lite/backends/x86/math/saturate.h"
 
@@ -269,6 +270,45 @@ void FcCompute<PRECISION(kInt8), PRECISION(kFloat)>::Run() {
   TargetFree(TARGET(kX86), w_scale);
 }
 
+// The weights are packed once, they are float if they are not converted to
+// bf16 when the model is loaded, see LightPredictor::WeightFP32ToBF16.
+template <>
+void FcCompute<PRECISION(kBF16), PRECISION(kFloat)>::PrepareForRun() {
+  auto& param = this->Param<operators::FcParam>();
+  const auto& w_dims = param.w->dims();
+  int k = param.padding_weights ? w_dims[0] - 4 : w_dims[0];
+  int n = param.padding_weights ? w_dims[1] - 4 : w_dims[1];
+  packed_weights_.Resize({lite::x86::math::gemm_bf16_packb_size(k, n)});
+  auto* packed = packed_weights_.mutable_data<bfloat16>();
+  if (param.w->precision() == PRECISION(kBF16)) {
+    lite::x86::math::gemm_bf16_packb(
+        k, n, param.w->data<bfloat16>(), w_dims[1], packed);
+  } else {
+    lite::x86::math::gemm_bf16_packb(
+        k, n, param.w->data<float>(), w_dims[1], packed);
+  }
+}
+
+template <>
+void FcCompute<PRECISION(kBF16), PRECISION(kFloat)>::Run() {
+  auto& param = this->Param<operators::FcParam>();
+  const auto& w_dims = param.w->dims();
+  int k = param.padding_weights ? w_dims[0] - 4 : w_dims[0];
+  int n = param.padding_weights ? w_dims[1] - 4 : w_dims[1];
+  int m = param.output->dims().production() / n;
+  bool with_relu = param.activation_type == "relu";
+  lite::x86::math::gemm_bf16(m,
+                             n,
+                             k,
+                             param.input->data<float>(),
+                             k,
+                             packed_weights_.data<bfloat16>(),
+                             param.output->mutable_data<float>(),
+                             n,
+                             param.bias ? param.bias->data<float>() : nullptr,
+                             with_relu);
+}
+
 #undef GEMM_OUT_INT8
 #undef GEMM_OUT_FLOAT
 
@@ -286,6 +326,9 @@ typedef paddle::lite::kernels::x86::FcCompute<PRECISION(kInt8),
 typedef paddle::lite::kernels::x86::FcCompute<PRECISION(kInt8),
                                               PRECISION(kInt8)>
     FcCompute_int8_int8;
+typedef paddle::lite::kernels::x86::FcCompute<PRECISION(kBF16),
+                                              PRECISION(kFloat)>
+    FcCompute_BF16;
 
 REGISTER_LITE_KERNEL(fc, kX86, kFloat, kNCHW, FcCompute_FP32, def)
     .BindInput("Input", {LiteType::GetTensorTy(TARGET(kX86))})
@@ -307,3 +350,10 @@ REGISTER_LITE_KERNEL(fc, kX86, kInt8, kNCHW, FcCompute_int8_fp32, fp32_out)
     .BindInput("W", {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kInt8))})
     .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kX86))})
     .Finalize();
+
+REGISTER_LITE_KERNEL(fc, kX86, kBF16, kNCHW, FcCompute_BF16, def)
+    .BindInput("Input", {LiteType::GetTensorTy(TARGET(kX86))})
+    .BindInput("Bias", {LiteType::GetTensorTy(TARGET(kX86))})
+    .BindInput("W", {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kBF16))})
+    .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kX86))})
+    .Finalize();
@@ -36,9 +36,15 @@ class FcCompute : public KernelLite<TARGET(kX86), PType> {
  public:
   using param_t = operators::FcParam;
 
+  virtual void PrepareForRun() {}
+
   virtual void Run();
 
   virtual ~FcCompute() = default;
+
+ private:
+  // the weights packed by gemm_bf16_packb for the bf16 kernel
+  Tensor packed_weights_;
 };
 
 }  // namespace x86
@@ -14,9 +14,7 @@
 
 #pragma once
 
-#include "lite/backends/x86/jit/helper.h"
-#include "lite/backends/x86/jit/kernel_base.h"
-#include "lite/backends/x86/jit/kernels.h"
+#include "lite/backends/x86/math/layer_norm.h"
 #include "lite/core/kernel.h"
 #include "lite/core/op_lite.h"
 #include "lite/core/op_registry.h"
@@ -35,50 +33,46 @@ class LayerNormCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
 
   void Run() override {
     auto &param = *param_.get_mutable<param_t>();
-    float epsilon = param.epsilon;
-    auto Scale = param.Scale;
-    auto Bias = param.Bias;
-    auto x = param.X;
-
-    auto y = param.Y;
-    auto Mean = param.Mean;
-    auto Var = param.Variance;
-    auto begin_norm_axis = param.begin_norm_axis;
-
-    auto x_dims = x->dims();
-
-    y->template mutable_data<T>();
-    Mean->template mutable_data<T>();
-    Var->template mutable_data<T>();
-
-    auto matrix_dim = x_dims.Flatten2D(begin_norm_axis);
+    auto y_dims = param.Y->dims();
+    auto matrix_dim = y_dims.Flatten2D(param.begin_norm_axis);
     int left = static_cast<int>(matrix_dim[0]);
     int right = static_cast<int>(matrix_dim[1]);
-    lite::DDim matrix_shape({left, right});
-
-    lite::Tensor in;
-    in.ShareDataWith(*x);
-    in.Resize(matrix_shape);
-    lite::Tensor out;
-    out.ShareDataWith(*y);
-    out.Resize(matrix_shape);
 
+    auto Mean = param.Mean;
+    auto Var = param.Variance;
     CHECK_EQ(Mean->numel(), left);
     CHECK_EQ(Var->numel(), left);
-    CHECK_EQ(Scale->numel(), right);
-    CHECK_EQ(Bias->numel(), right);
+    if (param.Scale) {
+      CHECK_EQ(param.Scale->numel(), right);
+    }
+    if (param.Bias) {
+      CHECK_EQ(param.Bias->numel(), right);
+    }
 
-    auto ker = paddle::lite::jit::KernelFuncs<jit::LayerNormTuple<T>,
-                                              lite::fluid::CPUPlace>::Cache()
-                   .At(right);
-    ker(in.mutable_data<T>(),
-        out.mutable_data<T>(),
+    const T *x_data = param.X->template data<T>();
+    const T *residual =
+        param.Residual ? param.Residual->template data<T>() : nullptr;
+    T *y_data = param.Y->template mutable_data<T>();
+    if (residual && param.Residual->numel() != param.X->numel()) {
+      // Add the broadcast input into Y first, which is normalized in place.
+      int64_t x_size = param.X->numel();
+      int64_t r_size = param.Residual->numel();
+      for (int64_t i = 0; i < param.Y->numel(); i++) {
+        y_data[i] = x_data[i % x_size] + residual[i % r_size];
+      }
+      x_data = y_data;
+      residual = nullptr;
+    }
+    lite::x86::math::layer_norm(
+        x_data,
+        residual,
+        param.Scale ? param.Scale->template data<T>() : nullptr,
+        param.Bias ? param.Bias->template data<T>() : nullptr,
+        y_data,
         Mean->template mutable_data<T>(),
         Var->template mutable_data<T>(),
-        Scale->template data<T>(),
-        Bias->template data<T>(),
-        static_cast<int>(left),
-        epsilon,
+        param.epsilon,
+        left,
         right);
   }
 
@@ -13,7 +13,9 @@
 // limitations under the License.
 #pragma once
 
+#include <type_traits>
 #include <vector>
+#include "lite/backends/host/math/embedding.h"
 #include "lite/backends/x86/fluid/eigen.h"
 #include "lite/core/kernel.h"
 #include "lite/core/op_registry.h"
@@ -40,9 +42,18 @@ class LookupTableCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
     int64_t row_number = table_t->dims()[0];
     int64_t row_width = table_t->dims()[1];
 
+    if (std::is_same<T, float>::value) {
+      lite::host::math::EmbeddingTable table;
+      table.data = table_t->template data<float>();
+      table.rows = row_number;
+      table.width = row_width;
+      float *output = output_t->template mutable_data<float>();
+      lite::host::math::embedding_lookup(
+          table, ids, ids_numel, padding_idx, output, nullptr);
+      return;
+    }
     const T *table = table_t->template data<T>();
     T *output = output_t->template mutable_data<T>();
-    memset(output, 0, output_t->dims().production() * sizeof(T));
     for (int64_t i = 0; i < ids_numel; ++i) {
       if (padding_idx != -1 && ids[i] == padding_idx) {
         memset(output + i * row_width, 0, row_width * sizeof(T));
@@ -14,6 +14,9 @@
 
 #include "lite/kernels/x86/matmul_compute.h"
 
+typedef paddle::lite::kernels::x86::MatMulInt8Compute<int8_t> MatMulInt8Out;
+typedef paddle::lite::kernels::x86::MatMulInt8Compute<float> MatMulFp32Out;
+
 REGISTER_LITE_KERNEL(matmul,
                      kX86,
                      kFloat,
@@ -24,3 +27,17 @@ REGISTER_LITE_KERNEL(matmul,
     .BindInput("Y", {LiteType::GetTensorTy(TARGET(kX86))})
     .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kX86))})
     .Finalize();
+
+REGISTER_LITE_KERNEL(matmul, kX86, kInt8, kNCHW, MatMulInt8Out, int8_out)
+    .BindInput("X", {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kInt8))})
+    .BindInput("Y", {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kInt8))})
+    .BindOutput("Out",
+                {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kInt8))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(matmul, kX86, kInt8, kNCHW, MatMulFp32Out, fp32_out)
+    .BindInput("X", {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kInt8))})
+    .BindInput("Y", {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kInt8))})
+    .BindOutput("Out",
+                {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kFloat))})
+    .Finalize();
@@ -13,7 +13,12 @@
 // limitations under the License.
 #pragma once
 
+#include <algorithm>
+#include <memory>
+#include <vector>
 #include "lite/backends/x86/math/blas.h"
+#include "lite/backends/x86/math/calib.h"
+#include "lite/backends/x86/math/gemm_s8u8_compute.h"
 #include "lite/core/kernel.h"
 #include "lite/core/op_registry.h"
 #include "lite/core/types.h"
@@ -70,6 +75,140 @@ class MatMulCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
   virtual ~MatMulCompute() = default;
 };
 
+/**
+ * The int8 matmul runs the s8u8 gemm for each batch, the alpha is folded into
+ * the scale of X. The per-tensor scale of Y is applied by the gemm, while the
+ * per-column scales of Y are applied on the float results of the gemm. The
+ * gemm is built once for the shapes and only packs X of each batch.
+ */
+template <typename OutT>
+class MatMulInt8Compute : public KernelLite<TARGET(kX86), PRECISION(kInt8)> {
+ public:
+  using param_t = operators::MatMulParam;
+
+  void PrepareForRun() override { ReInitWhenNeeded(); }
+
+  void ReInitWhenNeeded() override {
+    auto &param = *param_.get_mutable<operators::MatMulParam>();
+    auto x_dims = param.X->dims();
+    auto y_dims = param.Y->dims();
+    if (last_x_dims_ == x_dims && last_y_dims_ == y_dims) {
+      return;
+    }
+    CHECK_GE(x_dims.size(), 2u) << "The int8 matmul needs the matrix X.";
+    CHECK_GE(y_dims.size(), 2u) << "The int8 matmul needs the matrix Y.";
+    const int x_rank = x_dims.size();
+    const int y_rank = y_dims.size();
+    M_ = param.transpose_X ? x_dims[x_rank - 1] : x_dims[x_rank - 2];
+    K_ = param.transpose_X ? x_dims[x_rank - 2] : x_dims[x_rank - 1];
+    N_ = param.transpose_Y ? y_dims[y_rank - 2] : y_dims[y_rank - 1];
+    x_batch_ = x_dims.count(0, x_rank - 2);
+    y_batch_ = y_dims.count(0, y_rank - 2);
+    CHECK(x_batch_ == y_batch_ || x_batch_ == 1 || y_batch_ == 1)
+        << "The batches of X and Y can't be broadcast, x_dims: " << x_dims
+        << ", y_dims: " << y_dims;
+
+    const auto &weight_scale = param.weight_scale;
+    per_column_ = weight_scale.size() > 1;
+    if (per_column_) {
+      CHECK_EQ(static_cast<int>(weight_scale.size()), N_)
+          << "The scales of Y should be per-tensor or per-column.";
+    }
+    const float y_scale = weight_scale.empty() ? 1.f : weight_scale[0];
+    x_scale_.assign(M_, param.input_scale * param.alpha);
+    // The gemm packs X on its construction, and every batch packs its own X
+    // again in Run.
+    const int8_t *x_data = param.X->template data<int8_t>();
+    gemm_.reset();
+    gemm_float_.reset();
+    if (per_column_) {
+      tmp_out_.Resize({static_cast<int64_t>(M_) * N_});
+      gemm_float_.reset(
+          new lite::x86::math::generate_gemm_s8u8_x86_kern<float>(
+              param.transpose_X,
+              param.transpose_Y,
+              M_,
+              N_,
+              K_,
+              x_data,
+              N_,
+              x_scale_.data(),
+              1.f,
+              1.f,
+              nullptr,
+              0,
+              0.f));
+    } else {
+      gemm_.reset(new lite::x86::math::generate_gemm_s8u8_x86_kern<OutT>(
+          param.transpose_X,
+          param.transpose_Y,
+          M_,
+          N_,
+          K_,
+          x_data,
+          N_,
+          x_scale_.data(),
+          y_scale,
+          param.output_scale,
+          nullptr,
+          0,
+          0.f));
+    }
+    last_x_dims_ = x_dims;
+    last_y_dims_ = y_dims;
+  }
+
+  void Run() override {
+    auto &param = *param_.get_mutable<operators::MatMulParam>();
+    const int M = M_;
+    const int N = N_;
+    const int K = K_;
+    const int64_t batch = (std::max)(x_batch_, y_batch_);
+    const auto &weight_scale = param.weight_scale;
+    const int8_t *x_data = param.X->template data<int8_t>();
+    const int8_t *y_data = param.Y->template data<int8_t>();
+    OutT *out_data = param.Out->template mutable_data<OutT>();
+    for (int64_t b = 0; b < batch; b++) {
+      const int8_t *x_ptr =
+          x_data + (x_batch_ == 1 ? 0 : b * static_cast<int64_t>(M) * K);
+      const int8_t *y_ptr =
+          y_data + (y_batch_ == 1 ? 0 : b * static_cast<int64_t>(K) * N);
+      OutT *out_ptr = out_data + b * static_cast<int64_t>(M) * N;
+      if (!per_column_) {
+        gemm_->prepare_A(x_ptr);
+        gemm_->compute(x_ptr, y_ptr, out_ptr);
+        continue;
+      }
+      float *tmp_data = tmp_out_.template mutable_data<float>();
+      gemm_float_->prepare_A(x_ptr);
+      gemm_float_->compute(x_ptr, y_ptr, tmp_data);
+      for (int m = 0; m < M; m++) {
+        for (int n = 0; n < N; n++) {
+          out_ptr[m * N + n] = lite::x86::math::quantize_to<OutT>(
+              tmp_data[m * N + n] * weight_scale[n], param.output_scale);
+        }
+      }
+    }
+  }
+
+  virtual ~MatMulInt8Compute() = default;
+
+ private:
+  int M_{0};
+  int N_{0};
+  int K_{0};
+  int64_t x_batch_{1};
+  int64_t y_batch_{1};
+  bool per_column_{false};
+  DDim last_x_dims_;
+  DDim last_y_dims_;
+  std::vector<float> x_scale_;
+  std::unique_ptr<lite::x86::math::generate_gemm_s8u8_x86_kern<OutT>> gemm_;
+  std::unique_ptr<lite::x86::math::generate_gemm_s8u8_x86_kern<float>>
+      gemm_float_;
+  lite::Tensor tmp_out_;
+};
+
 }  // namespace x86
 }  // namespace kernels
 }  // namespace lite
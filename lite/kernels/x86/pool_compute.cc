@@ -14,6 +14,9 @@
 
 #include "lite/kernels/x86/pool_compute.h"
 
+typedef paddle::lite::kernels::x86::PoolInt8Compute<int8_t> PoolInt8Out;
+typedef paddle::lite::kernels::x86::PoolInt8Compute<float> PoolFp32Out;
+
 REGISTER_LITE_KERNEL(pool2d,
                      kX86,
                      kFloat,
@@ -23,3 +26,15 @@ REGISTER_LITE_KERNEL(pool2d,
     .BindInput("X", {LiteType::GetTensorTy(TARGET(kX86))})
     .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kX86))})
     .Finalize();
+
+REGISTER_LITE_KERNEL(pool2d, kX86, kInt8, kNCHW, PoolInt8Out, int8_out)
+    .BindInput("X", {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kInt8))})
+    .BindOutput("Out",
+                {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kInt8))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(pool2d, kX86, kInt8, kNCHW, PoolFp32Out, fp32_out)
+    .BindInput("X", {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kInt8))})
+    .BindOutput("Out",
+                {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kFloat))})
+    .Finalize();
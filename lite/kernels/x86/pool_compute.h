@@ -81,6 +81,35 @@ class PoolCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
   virtual ~PoolCompute() = default;
 };
 
+template <typename OutT>
+class PoolInt8Compute : public KernelLite<TARGET(kX86), PRECISION(kInt8)> {
+ public:
+  using param_t = operators::PoolParam;
+  void Run() override {
+    auto& param = *param_.get_mutable<param_t>();
+    if (param.global_pooling) {
+      for (size_t i = 0; i < param.ksize.size(); ++i) {
+        param.ksize[i] = static_cast<int>(param.x->dims()[i + 2]);
+      }
+    }
+    CHECK_EQ(param.ksize.size(), 2u)
+        << "Only the int8 pool2d is supported on x86.";
+    CHECK(param.pooling_type == "max" || param.pooling_type == "avg")
+        << "Unsupported pooling type: " << param.pooling_type;
+    paddle::lite::x86::math::Pool2dInt8<OutT>(param.x,
+                                              param.ksize,
+                                              param.strides,
+                                              *param.paddings,
+                                              param.pooling_type == "max",
+                                              param.exclusive,
+                                              param.adaptive,
+                                              param.input_scale,
+                                              param.output_scale,
+                                              param.output);
+  }
+  virtual ~PoolInt8Compute() = default;
+};
+
 }  // namespace x86
 }  // namespace kernels
 }  // namespace lite
@@ -0,0 +1,92 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/kernels/x86/sparse_conv_compute.h"
+#include "lite/backends/host/math/sparse_structured_gemm.h"
+#include "lite/core/op_registry.h"
+
+namespace paddle {
+namespace lite {
+namespace kernels {
+namespace x86 {
+
+void SparseConvCompute::Run() {
+  auto& param = this->Param<param_t>();
+  const float* input = param.x->data<float>();
+  const float* nonzero_weights = param.nonzero_weights->data<float>();
+  const int32_t* diffs = param.diffs->data<int32_t>();
+  const uint32_t* oc_nonzeros = param.oc_nonzeros->data<uint32_t>();
+  const float* bias = param.bias ? param.bias->data<float>() : nullptr;
+  float* dout = param.output->mutable_data<float>();
+
+  auto x_dims = param.x->dims();
+  auto o_dims = param.output->dims();
+  int ic = x_dims[1];
+  int bs = x_dims[0];
+  int oc = o_dims[1];
+  int im_size = o_dims[2] * o_dims[3];
+  for (int b = 0; b < bs; b++) {
+    const float* din = input + b * ic * im_size;
+    float* out = dout + b * oc * im_size;
+    if (param.sparse_format == operators::SparseFormat::kBlock) {
+      lite::host::math::sparse_block_gemm_fp32(nonzero_weights,
+                                               oc_nonzeros,
+                                               diffs,
+                                               param.block_h,
+                                               param.block_w,
+                                               din,
+                                               bias,
+                                               out,
+                                               oc,
+                                               ic,
+                                               im_size,
+                                               param.activation_param);
+    } else if (param.sparse_format == operators::SparseFormat::kNM) {
+      lite::host::math::sparse_nm_gemm_fp32(nonzero_weights,
+                                            diffs,
+                                            param.nm_n,
+                                            param.nm_m,
+                                            din,
+                                            bias,
+                                            out,
+                                            oc,
+                                            ic,
+                                            im_size,
+                                            param.activation_param);
+    } else {
+      LOG(FATAL) << "The unstructured sparse conv is not supported on x86.";
+    }
+  }
+}
+
+}  // namespace x86
+}  // namespace kernels
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_LITE_KERNEL(sparse_conv2d,
+                     kX86,
+                     kFloat,
+                     kNCHW,
+                     paddle::lite::kernels::x86::SparseConvCompute,
+                     def)
+    .BindInput("Input", {LiteType::GetTensorTy(TARGET(kX86))})
+    .BindInput("NonZeroWeights", {LiteType::GetTensorTy(TARGET(kX86))})
+    .BindInput("OcNonZeros",
+               {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kInt32))})
+    .BindInput("Diffs",
+               {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kInt32))})
+    .BindInput("Bias", {LiteType::GetTensorTy(TARGET(kX86))})
+    .BindOutput("Output", {LiteType::GetTensorTy(TARGET(kX86))})
+    .Finalize();
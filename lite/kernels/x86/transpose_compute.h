@@ -14,9 +14,10 @@
 
 #pragma once
 
-#include <Eigen/Core>
+#include <type_traits>
 #include <vector>
-#include "lite/backends/x86/math/math_function.h"
+#include "lite/backends/host/math/transpose.h"
+#include "lite/backends/x86/math/calib.h"
 #include "lite/core/kernel.h"
 #include "lite/core/op_lite.h"
 #include "lite/core/op_registry.h"
@@ -34,34 +35,12 @@ inline void TransCompute(const int dim,
                          const lite::Tensor& in,
                          lite::Tensor* out,
                          const std::vector<int>& axis) {
-  switch (dim) {
-    case 1:
-      paddle::lite::x86::math::Transpose<lite::TargetType::kX86, T, 1> trans1;
-      trans1(context, in, out, axis);
-      break;
-    case 2:
-      paddle::lite::x86::math::Transpose<lite::TargetType::kX86, T, 2> trans2;
-      trans2(context, in, out, axis);
-      break;
-    case 3:
-      paddle::lite::x86::math::Transpose<lite::TargetType::kX86, T, 3> trans3;
-      trans3(context, in, out, axis);
-      break;
-    case 4:
-      paddle::lite::x86::math::Transpose<lite::TargetType::kX86, T, 4> trans4;
-      trans4(context, in, out, axis);
-      break;
-    case 5:
-      paddle::lite::x86::math::Transpose<lite::TargetType::kX86, T, 5> trans5;
-      trans5(context, in, out, axis);
-      break;
-    case 6:
-      paddle::lite::x86::math::Transpose<lite::TargetType::kX86, T, 6> trans6;
-      trans6(context, in, out, axis);
-      break;
-    default:
-      LOG(FATAL) << "Tensors with rank at most 6 are supported";
-  }
+  CHECK_LE(dim, 6) << "Tensors with rank at most 6 are supported";
+  lite::host::math::permute(in.data<T>(),
+                            out->template mutable_data<T>(),
+                            in.dims().Vectorize(),
+                            axis,
+                            sizeof(T));
 }
 
 template <typename T>
@@ -102,6 +81,50 @@ class Transpose2Compute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
   virtual ~Transpose2Compute() = default;
 };
 
+// Transpose the int8 data, then requantize it to the output scale or
+// dequantize it to float.
+template <typename OutT>
+class TransposeInt8Compute
+    : public KernelLite<TARGET(kX86), PRECISION(kInt8)> {
+ public:
+  using param_t = operators::TransposeParam;
+
+  void Run() override {
+    auto& param = *param_.get_mutable<param_t>();
+    auto* x = param.x;
+    auto* out = param.output;
+    int ndims = param.axis.size();
+    auto& context = ctx_->As<X86Context>();
+    if (std::is_same<OutT, int8_t>::value) {
+      auto* out_data = out->template mutable_data<int8_t>();
+      TransCompute<lite::TargetType::kX86, int8_t>(
+          ndims, context, *x, out, param.axis);
+      lite::x86::math::int8_to_int8(out_data,
+                                    out_data,
+                                    param.input_scale,
+                                    param.output_scale,
+                                    out->numel());
+    } else {
+      trans_out_.Resize(out->dims());
+      trans_out_.template mutable_data<int8_t>();
+      TransCompute<lite::TargetType::kX86, int8_t>(
+          ndims, context, *x, &trans_out_, param.axis);
+      float scale = param.input_scale;
+      lite::x86::math::int8_to_fp32(trans_out_.template data<int8_t>(),
+                                    out->template mutable_data<float>(),
+                                    &scale,
+                                    1,
+                                    1,
+                                    out->numel());
+    }
+  }
+
+  virtual ~TransposeInt8Compute() = default;
+
+ private:
+  lite::Tensor trans_out_;
+};
+
 }  // namespace x86
 }  // namespace kernels
 }  // namespace lite
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "lite/operators/concat_op.h"
+#include <string>
 #include "lite/core/op_lite.h"
 #include "lite/core/op_registry.h"
 
@@ -76,6 +77,9 @@ bool ConcatOpLite::AttachImpl(const cpp::OpDesc &op_desc, lite::Scope *scope) {
   CHECK(scope->FindVar(out));
   param_.output = scope->FindVar(out)->GetMutable<lite::Tensor>();
   param_.axis = op_desc.GetAttr<int>("axis");
+  if (op_desc.HasAttr("inplace")) {
+    param_.inplace = op_desc.GetAttr<bool>("inplace");
+  }
 
   std::vector<std::string> input_arg_names = op_desc.InputArgumentNames();
   if (std::find(input_arg_names.begin(), input_arg_names.end(), "AxisTensor") !=
@@ -88,6 +92,20 @@ bool ConcatOpLite::AttachImpl(const cpp::OpDesc &op_desc, lite::Scope *scope) {
       }
     }
   }
+  // For Int8
+  const OpInfo *op_info = static_cast<const OpInfo *>(&op_desc);
+  if (op_info != nullptr && op_info->HasAttr("enable_int8")) {
+    param_.enable_int8 = op_info->GetAttr<bool>("enable_int8");
+    param_.input_scales.assign(inputs.size(), 1.f);
+    for (size_t i = 0; i < inputs.size(); i++) {
+      auto input_scale_name = "X" + std::to_string(i) + "_scale";
+      if (op_info->HasInputScale(input_scale_name, true))
+        param_.input_scales[i] =
+            op_info->GetInputScale(input_scale_name, true)[0];
+    }
+    if (op_info->HasOutputScale("Out0_scale", true))
+      param_.output_scale = op_info->GetOutputScale("Out0_scale", true)[0];
+  }
   return true;
 }
 
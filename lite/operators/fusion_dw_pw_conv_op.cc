@@ -0,0 +1,182 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/operators/fusion_dw_pw_conv_op.h"
+#include <algorithm>
+#include <memory>
+#include <vector>
+#include "lite/core/op_registry.h"
+
+namespace paddle {
+namespace lite {
+namespace operators {
+
+namespace {
+
+lite::Tensor* FindOptionalInput(const cpp::OpDesc& op_desc,
+                                lite::Scope* scope,
+                                const std::string& name) {
+  if (!op_desc.HasInput(name) || op_desc.Input(name).empty()) {
+    return nullptr;
+  }
+  auto* var = scope->FindVar(op_desc.Input(name).front());
+  return var ? var->GetMutable<lite::Tensor>() : nullptr;
+}
+
+// Parse the activation fused by conv_activation_fuse_pass, the attribute names
+// are prefixed with "dw_" or "pw_".
+void ParseActivation(const cpp::OpDesc& op_desc,
+                     const std::string& prefix,
+                     ActivationParam* act_param) {
+  if (!op_desc.HasAttr(prefix + "with_act") ||
+      !op_desc.GetAttr<bool>(prefix + "with_act")) {
+    return;
+  }
+  act_param->has_active = true;
+  auto act_type = op_desc.GetAttr<std::string>(prefix + "act_type");
+  if (act_type == "relu") {
+    act_param->active_type = lite_api::ActivationType::kRelu;
+  } else if (act_type == "relu6") {
+    act_param->active_type = lite_api::ActivationType::kRelu6;
+    act_param->Relu_clipped_coef =
+        op_desc.GetAttr<float>(prefix + "fuse_brelu_threshold");
+  } else if (act_type == "leaky_relu") {
+    act_param->active_type = lite_api::ActivationType::kLeakyRelu;
+    act_param->Leaky_relu_alpha =
+        op_desc.GetAttr<float>(prefix + "leaky_relu_alpha");
+  } else if (act_type == "hard_swish") {
+    act_param->active_type = lite_api::ActivationType::kHardSwish;
+    act_param->hard_swish_threshold =
+        op_desc.GetAttr<float>(prefix + "hard_swish_threshold");
+    act_param->hard_swish_scale =
+        op_desc.GetAttr<float>(prefix + "hard_swish_scale");
+    act_param->hard_swish_offset =
+        op_desc.GetAttr<float>(prefix + "hard_swish_offset");
+  } else {
+    LOG(FATAL) << "The fused depthwise-pointwise conv only supports fuse with "
+                  "relu, relu6, leaky relu and hard_swish, while the given "
+                  "activation type is "
+               << act_type;
+  }
+}
+
+}  // namespace
+
+bool FusionDwPwConvOpLite::CheckShape() const {
+  CHECK_OR_FALSE(param_.x);
+  CHECK_OR_FALSE(param_.output);
+  CHECK_OR_FALSE(param_.dw_param.filter);
+  CHECK_OR_FALSE(param_.pw_param.filter);
+
+  const auto in_dims = param_.x->dims();
+  const auto dw_filter_dims = param_.dw_param.filter->dims();
+  const auto pw_filter_dims = param_.pw_param.filter->dims();
+  CHECK_EQ_OR_FALSE(in_dims.size(), 4UL);
+  CHECK_EQ_OR_FALSE(dw_filter_dims.size(), 4UL);
+  CHECK_EQ_OR_FALSE(pw_filter_dims.size(), 4UL);
+  CHECK_EQ_OR_FALSE(dw_filter_dims[0], in_dims[1]);
+  CHECK_EQ_OR_FALSE(dw_filter_dims[1], 1);
+  CHECK_EQ_OR_FALSE(pw_filter_dims[1], in_dims[1]);
+  CHECK_EQ_OR_FALSE(pw_filter_dims[2], 1);
+  CHECK_EQ_OR_FALSE(pw_filter_dims[3], 1);
+  return true;
+}
+
+bool FusionDwPwConvOpLite::InferShapeImpl() const {
+  const auto in_dims = param_.x->dims();
+  const auto dw_filter_dims = param_.dw_param.filter->dims();
+  const auto& strides = param_.dw_param.strides;
+  const auto& paddings = *param_.dw_param.paddings;
+  const auto& dilations = *param_.dw_param.dilations;
+  std::vector<int64_t> output_shape(
+      {in_dims[0], param_.pw_param.filter->dims()[0]});
+  for (size_t i = 0; i < strides.size(); ++i) {
+    const int dkernel = dilations[i] * (dw_filter_dims[i + 2] - 1) + 1;
+    output_shape.push_back(
+        (in_dims[i + 2] + paddings[i * 2] + paddings[i * 2 + 1] - dkernel) /
+            strides[i] +
+        1);
+  }
+  param_.output->Resize(lite::DDim(output_shape));
+  param_.output->set_lod(param_.x->lod());
+  return true;
+}
+
+bool FusionDwPwConvOpLite::AttachImpl(const cpp::OpDesc& op_desc,
+                                      lite::Scope* scope) {
+  auto X = op_desc.Input("Input").front();
+  auto DwFilter = op_desc.Input("DwFilter").front();
+  auto PwFilter = op_desc.Input("PwFilter").front();
+  auto Out = op_desc.Output("Output").front();
+  param_.x = scope->FindVar(X)->GetMutable<lite::Tensor>();
+  param_.output = scope->FindVar(Out)->GetMutable<lite::Tensor>();
+
+  auto& dw_param = param_.dw_param;
+  dw_param.x = param_.x;
+  dw_param.filter = scope->FindVar(DwFilter)->GetMutable<lite::Tensor>();
+  dw_param.bias = FindOptionalInput(op_desc, scope, "DwBias");
+  dw_param.strides = op_desc.GetAttr<std::vector<int>>("dw_strides");
+  std::vector<int> paddings = op_desc.GetAttr<std::vector<int>>("dw_paddings");
+  // 2-pad to 4-pad
+  if (paddings.size() == 2L) {
+    for (size_t i = 0; i < dw_param.strides.size(); ++i) {
+      int copy_pad = *(paddings.begin() + 2 * i);
+      paddings.insert(paddings.begin() + 2 * i + 1, copy_pad);
+    }
+  } else {
+    if (paddings.size() != 4L) {
+      LOG(FATAL)
+          << "Paddings size should be the same or twice as the input size.";
+    }
+  }
+  dw_param.paddings = std::make_shared<std::vector<int>>(paddings);
+  dw_param.dilations = std::make_shared<std::vector<int>>(
+      op_desc.GetAttr<std::vector<int>>("dw_dilations"));
+  dw_param.groups = dw_param.filter->dims()[0];
+  ParseActivation(op_desc, "dw_", &dw_param.activation_param);
+
+  auto& pw_param = param_.pw_param;
+  pw_param.filter = scope->FindVar(PwFilter)->GetMutable<lite::Tensor>();
+  pw_param.bias = FindOptionalInput(op_desc, scope, "PwBias");
+  pw_param.output = param_.output;
+  pw_param.paddings = std::make_shared<std::vector<int>>(4, 0);
+  pw_param.dilations = std::make_shared<std::vector<int>>(2, 1);
+  ParseActivation(op_desc, "pw_", &pw_param.activation_param);
+
+  // For Int8, the depthwise output is quantized by the input scale of the
+  // pointwise conv, which is kept as dw_output_scale.
+  const OpInfo* op_info = static_cast<const OpInfo*>(&op_desc);
+  if (op_info->HasAttr("enable_int8") &&
+      op_info->GetAttr<bool>("enable_int8")) {
+    dw_param.enable_int8 = true;
+    pw_param.enable_int8 = true;
+    dw_param.input_scale = op_info->GetInputScale("Input0_scale", true)[0];
+    dw_param.weight_scale = op_info->GetInputScale("DwFilter0_scale", true);
+    dw_param.output_scale = op_info->GetAttr<float>("dw_output_scale");
+    pw_param.input_scale = dw_param.output_scale;
+    pw_param.weight_scale = op_info->GetInputScale("PwFilter0_scale", true);
+    if (op_info->HasOutputScale("Output0_scale", true)) {
+      pw_param.output_scale =
+          op_info->GetOutputScale("Output0_scale", true)[0];
+    }
+  }
+  return true;
+}
+
+}  // namespace operators
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_LITE_OP(fusion_dw_pw_conv2d,
+                 paddle::lite::operators::FusionDwPwConvOpLite);
@@ -0,0 +1,72 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <string>
+#include "lite/core/kernel.h"
+#include "lite/core/op_lite.h"
+#include "lite/core/scope.h"
+#include "lite/core/tensor.h"
+#include "lite/operators/op_params.h"
+#include "lite/utils/all.h"
+
+namespace paddle {
+namespace lite {
+namespace operators {
+
+// The depthwise conv followed by a 1x1s1p0 conv, which is generated by
+// lite_dw_pw_conv_fuse_pass.
+class FusionDwPwConvOpLite : public OpLite {
+ public:
+  FusionDwPwConvOpLite() {}
+
+  explicit FusionDwPwConvOpLite(const std::string& type) : OpLite(type) {}
+
+  bool CheckShape() const override;
+
+  bool InferShapeImpl() const override;
+
+  bool InferShapeWithCache() const override { return true; }
+
+  bool AttachImpl(const cpp::OpDesc& op_desc, lite::Scope* scope) override;
+
+  void AttachKernel(KernelBase* kernel) override { kernel->SetParam(param_); }
+
+  std::string DebugString() const override { return "fusion_dw_pw_conv2d"; }
+
+#ifdef LITE_WITH_PROFILE
+  void GetOpRuntimeInfo(paddle::lite::profile::OpCharacter* ch) {
+    auto dw_filter_dims = param_.dw_param.filter->dims();
+    auto input_dims = param_.x->dims();
+    auto output_dims = param_.output->dims();
+    ch->input_shape = ch->DimToStr(input_dims);
+    ch->output_shape = ch->DimToStr(output_dims);
+    ch->filter_shape = ch->DimToStr(dw_filter_dims);
+    ch->remark = std::to_string(dw_filter_dims[2]) + "x" +
+                 std::to_string(dw_filter_dims[3]) + "s" +
+                 std::to_string(param_.dw_param.strides[0]) + "+1x1";
+    auto dw_output_size = output_dims.production() / output_dims[1];
+    ch->macs = 2.f * dw_filter_dims[2] * dw_filter_dims[3] * dw_output_size *
+                   input_dims[1] +
+               2.f * output_dims.production() * input_dims[1];
+  }
+#endif
+
+ private:
+  mutable DwPwConvParam param_;
+};
+
+}  // namespace operators
+}  // namespace lite
+}  // namespace paddle
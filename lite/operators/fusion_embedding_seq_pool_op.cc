@@ -0,0 +1,83 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/operators/fusion_embedding_seq_pool_op.h"
+#include <vector>
+#include "lite/core/op_registry.h"
+
+namespace paddle {
+namespace lite {
+namespace operators {
+
+bool FusionEmbeddingSeqPoolOpLite::CheckShape() const {
+  CHECK_OR_FALSE(param_.W);
+  CHECK_OR_FALSE(param_.Ids);
+  CHECK_OR_FALSE(param_.Out);
+  CHECK_OR_FALSE(param_.pool_type == "SUM" ||
+                 param_.pool_type == "AVERAGE" ||
+                 param_.pool_type == "SQRT");
+
+  const auto& table_dims = param_.W->dims();
+  const auto& ids_dims = param_.Ids->dims();
+  CHECK_EQ_OR_FALSE(table_dims.size(), 2UL);
+  if (param_.lookup_type == "lookup_table_dequant") {
+    CHECK_GT_OR_FALSE(table_dims[1], 2);
+  }
+  if (param_.lookup_type != "lookup_table_v2") {
+    CHECK_EQ_OR_FALSE(ids_dims[ids_dims.size() - 1], 1);
+  }
+  const auto& lod = param_.Ids->lod();
+  CHECK_EQ_OR_FALSE(lod.size(), 1UL);
+  CHECK_GE_OR_FALSE(ids_dims[0], static_cast<int64_t>(lod[0].size()) - 1);
+  return true;
+}
+
+bool FusionEmbeddingSeqPoolOpLite::InferShapeImpl() const {
+  // The shape of the output of the lookup, whose first dim is the sequences.
+  const auto& table_dims = param_.W->dims();
+  const auto& ids_dims = param_.Ids->dims();
+  std::vector<int64_t> out_dims = ids_dims.Vectorize();
+  if (param_.lookup_type == "lookup_table_v2") {
+    out_dims.push_back(table_dims[1]);
+  } else if (param_.lookup_type == "lookup_table_dequant") {
+    out_dims.back() = (table_dims[1] - 2) * 4;
+  } else {
+    out_dims.back() = table_dims[1];
+  }
+  out_dims[0] = static_cast<int64_t>(param_.Ids->lod()[0].size()) - 1;
+  param_.Out->Resize(lite::DDim(out_dims));
+  return true;
+}
+
+bool FusionEmbeddingSeqPoolOpLite::AttachImpl(const cpp::OpDesc& op_desc,
+                                              lite::Scope* scope) {
+  param_.W = scope->FindTensor(op_desc.Input("W").front());
+  param_.Ids = scope->FindTensor(op_desc.Input("Ids").front());
+  param_.Out = scope->FindMutableTensor(op_desc.Output("Out").front());
+
+  param_.padding_idx = op_desc.GetAttr<int64_t>("padding_idx");
+  param_.lookup_type = op_desc.GetAttr<std::string>("lookup_type");
+  param_.pool_type = op_desc.GetAttr<std::string>("pooltype");
+  if (op_desc.HasAttr("pad_value")) {
+    param_.pad_value = op_desc.GetAttr<float>("pad_value");
+  }
+  return true;
+}
+
+}  // namespace operators
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_LITE_OP(fusion_embedding_seq_pool,
+                 paddle::lite::operators::FusionEmbeddingSeqPoolOpLite);
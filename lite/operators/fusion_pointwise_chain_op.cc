@@ -0,0 +1,68 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/operators/fusion_pointwise_chain_op.h"
+#include "lite/core/op_registry.h"
+
+namespace paddle {
+namespace lite {
+namespace operators {
+
+bool FusionPointwiseChainOpLite::CheckShape() const {
+  CHECK_OR_FALSE(param_.X);
+  CHECK_OR_FALSE(param_.Out);
+  const size_t num_steps = param_.step_types.size();
+  CHECK_GT_OR_FALSE(num_steps, 0UL);
+  CHECK_EQ_OR_FALSE(param_.step_operands.size(), num_steps);
+  CHECK_EQ_OR_FALSE(param_.step_axes.size(), num_steps);
+  CHECK_EQ_OR_FALSE(param_.step_reversed.size(), num_steps);
+  CHECK_EQ_OR_FALSE(param_.step_attrs.size(), 3 * num_steps);
+  for (auto operand : param_.step_operands) {
+    CHECK_GT_OR_FALSE(static_cast<int>(param_.operands.size()), operand);
+  }
+  return true;
+}
+
+bool FusionPointwiseChainOpLite::InferShapeImpl() const {
+  param_.Out->Resize(param_.X->dims());
+  param_.Out->set_lod(param_.X->lod());
+  return true;
+}
+
+bool FusionPointwiseChainOpLite::AttachImpl(const cpp::OpDesc& op_desc,
+                                            lite::Scope* scope) {
+  param_.X = scope->FindVar(op_desc.Input("X").front())->GetMutable<Tensor>();
+  param_.operands.clear();
+  if (op_desc.HasInput("Operands")) {
+    for (auto& name : op_desc.Input("Operands")) {
+      param_.operands.push_back(scope->FindVar(name)->GetMutable<Tensor>());
+    }
+  }
+  param_.Out =
+      scope->FindVar(op_desc.Output("Out").front())->GetMutable<Tensor>();
+  param_.step_types =
+      op_desc.GetAttr<std::vector<std::string>>("step_types");
+  param_.step_operands = op_desc.GetAttr<std::vector<int>>("step_operands");
+  param_.step_axes = op_desc.GetAttr<std::vector<int>>("step_axes");
+  param_.step_reversed = op_desc.GetAttr<std::vector<int>>("step_reversed");
+  param_.step_attrs = op_desc.GetAttr<std::vector<float>>("step_attrs");
+  return true;
+}
+
+}  // namespace operators
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_LITE_OP(fusion_pointwise_chain,
+                 paddle::lite::operators::FusionPointwiseChainOpLite);
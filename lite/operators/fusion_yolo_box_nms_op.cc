@@ -0,0 +1,101 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/operators/fusion_yolo_box_nms_op.h"
+#include "lite/core/op_registry.h"
+
+namespace paddle {
+namespace lite {
+namespace operators {
+
+bool FusionYoloBoxNmsOpLite::CheckShape() const {
+  CHECK_OR_FALSE(param_.ImgSize);
+  CHECK_OR_FALSE(param_.Out);
+  const size_t num_heads = param_.X.size();
+  CHECK_GT_OR_FALSE(num_heads, 0UL);
+  CHECK_EQ_OR_FALSE(param_.anchor_nums.size(), num_heads);
+  CHECK_EQ_OR_FALSE(param_.downsample_ratios.size(), num_heads);
+  CHECK_GT_OR_FALSE(param_.class_num, 0);
+  int anchor_num = 0;
+  for (auto num : param_.anchor_nums) {
+    anchor_num += num;
+  }
+  CHECK_EQ_OR_FALSE(param_.anchors.size(), 2UL * anchor_num);
+
+  auto img_dims = param_.ImgSize->dims();
+  CHECK_EQ_OR_FALSE(img_dims.size(), 2UL);
+  CHECK_EQ_OR_FALSE(img_dims[1], 2);
+  for (size_t i = 0; i < num_heads; i++) {
+    CHECK_OR_FALSE(param_.X[i]);
+    auto x_dims = param_.X[i]->dims();
+    CHECK_EQ_OR_FALSE(x_dims.size(), 4UL);
+    CHECK_EQ_OR_FALSE(x_dims[0], img_dims[0]);
+    CHECK_EQ_OR_FALSE(x_dims[1],
+                      param_.anchor_nums[i] * (5 + param_.class_num));
+  }
+  return true;
+}
+
+bool FusionYoloBoxNmsOpLite::InferShapeImpl() const {
+  // The number of the kept boxes is only known after the nms, the outputs
+  // are resized by the kernel.
+  return true;
+}
+
+bool FusionYoloBoxNmsOpLite::AttachImpl(const cpp::OpDesc& op_desc,
+                                        lite::Scope* scope) {
+  param_.X.clear();
+  for (auto& name : op_desc.Input("X")) {
+    param_.X.push_back(scope->FindVar(name)->GetMutable<Tensor>());
+  }
+  param_.ImgSize =
+      scope->FindVar(op_desc.Input("ImgSize").front())->GetMutable<Tensor>();
+  param_.Out =
+      scope->FindVar(op_desc.Output("Out").front())->GetMutable<Tensor>();
+  param_.Index = nullptr;
+  if (op_desc.HasOutput("Index") && !op_desc.Output("Index").empty()) {
+    param_.Index =
+        scope->FindVar(op_desc.Output("Index").front())->GetMutable<Tensor>();
+  }
+  param_.NmsRoisNum = nullptr;
+  if (op_desc.HasOutput("NmsRoisNum") &&
+      !op_desc.Output("NmsRoisNum").empty()) {
+    param_.NmsRoisNum = scope->FindVar(op_desc.Output("NmsRoisNum").front())
+                            ->GetMutable<Tensor>();
+  }
+
+  param_.anchors = op_desc.GetAttr<std::vector<int>>("anchors");
+  param_.anchor_nums = op_desc.GetAttr<std::vector<int>>("anchor_nums");
+  param_.downsample_ratios =
+      op_desc.GetAttr<std::vector<int>>("downsample_ratios");
+  param_.class_num = op_desc.GetAttr<int>("class_num");
+  param_.conf_thresh = op_desc.GetAttr<float>("conf_thresh");
+  param_.clip_bbox = op_desc.GetAttr<bool>("clip_bbox");
+  param_.scale_x_y = op_desc.GetAttr<float>("scale_x_y");
+  param_.background_label = op_desc.GetAttr<int>("background_label");
+  param_.score_threshold = op_desc.GetAttr<float>("score_threshold");
+  param_.nms_top_k = op_desc.GetAttr<int>("nms_top_k");
+  param_.nms_threshold = op_desc.GetAttr<float>("nms_threshold");
+  param_.nms_eta = op_desc.GetAttr<float>("nms_eta");
+  param_.keep_top_k = op_desc.GetAttr<int>("keep_top_k");
+  param_.normalized = op_desc.GetAttr<bool>("normalized");
+  return true;
+}
+
+}  // namespace operators
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_LITE_OP(fusion_yolo_box_nms,
+                 paddle::lite::operators::FusionYoloBoxNmsOpLite);
@@ -0,0 +1,54 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <string>
+#include "lite/core/kernel.h"
+#include "lite/core/op_lite.h"
+#include "lite/core/scope.h"
+#include "lite/core/tensor.h"
+#include "lite/operators/op_params.h"
+#include "lite/utils/all.h"
+
+namespace paddle {
+namespace lite {
+namespace operators {
+
+// The detection post-processing of the yolo models, which is generated by
+// lite_yolo_box_nms_fuse_pass. It decodes the boxes of the heads X as
+// yolo_box does, then selects them by the nms as multiclass_nms does, so
+// the outputs are the same as the ones of multiclass_nms.
+class FusionYoloBoxNmsOpLite : public OpLite {
+ public:
+  FusionYoloBoxNmsOpLite() {}
+
+  explicit FusionYoloBoxNmsOpLite(const std::string& type) : OpLite(type) {}
+
+  bool CheckShape() const override;
+
+  bool InferShapeImpl() const override;
+
+  bool AttachImpl(const cpp::OpDesc& op_desc, lite::Scope* scope) override;
+
+  void AttachKernel(KernelBase* kernel) override { kernel->SetParam(param_); }
+
+  std::string DebugString() const override { return "fusion_yolo_box_nms"; }
+
+ private:
+  mutable YoloBoxNmsParam param_;
+};
+
+}  // namespace operators
+}  // namespace lite
+}  // namespace paddle
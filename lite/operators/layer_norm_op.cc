@@ -29,6 +29,24 @@ bool LayerNormOp::CheckShape() const {
 
 bool LayerNormOp::InferShapeImpl() const {
   auto out_dims = param_.X->dims();
+  if (param_.Residual && param_.Residual->dims() != out_dims) {
+    // The residual comes from an elementwise_add with axis -1, one of the two
+    // inputs is broadcast along the leading dims of the other.
+    auto residual_dims = param_.Residual->dims();
+    bool x_is_larger = out_dims.production() >= residual_dims.production();
+    const auto &large_dims = x_is_larger ? out_dims : residual_dims;
+    const auto &small_dims = x_is_larger ? residual_dims : out_dims;
+    CHECK_GE(large_dims.size(), small_dims.size());
+    size_t offset = large_dims.size() - small_dims.size();
+    for (size_t i = 0; i < small_dims.size(); i++) {
+      CHECK(small_dims[i] == large_dims[i + offset] ||
+            (small_dims[i] == 1 && small_dims.count(0, i) == 1))
+          << "The residual of layer_norm should be broadcast along the "
+             "leading dims, but got "
+          << residual_dims << " and " << out_dims;
+    }
+    out_dims = large_dims;
+  }
   param_.Y->Resize(out_dims);
   auto inner_size = out_dims.Flatten2D(param_.begin_norm_axis)[0];
   param_.Mean->Resize(std::vector<int64_t>({inner_size}));
@@ -52,6 +70,10 @@ bool LayerNormOp::AttachImpl(const cpp::OpDesc &opdesc, lite::Scope *scope) {
   CHECK(param_.Y);
   CHECK(param_.Mean);
   CHECK(param_.Variance);
+  if (opdesc.HasInput("Residual") && !opdesc.Input("Residual").empty()) {
+    param_.Residual = scope->FindVar(opdesc.Input("Residual").front())
+                          ->GetMutable<lite::Tensor>();
+  }
   if (opdesc.HasInput("Scale")) {
     param_.Scale = scope->FindVar(opdesc.Input("Scale").front())
                        ->GetMutable<lite::Tensor>();
@@ -84,6 +84,10 @@ struct SubgraphParam : ParamBase {
   std::vector<std::string> output_data_names{};
   std::vector<float> input_data_scales{};
   std::vector<float> output_data_scales{};
+  // The shapes of the weights as 'name:d0,d1,...'
+  std::vector<std::string> weight_data_shapes{};
+  // The hash of the data of the weights recorded by the subgraph pass
+  std::string weight_data_digest{};
   int block_idx{-1};
   std::shared_ptr<const cpp::ProgramDesc> program_desc{nullptr};
   Scope* exec_scope{nullptr};
@@ -279,6 +283,12 @@ struct ConcatParam : ParamBase {
   lite::Tensor* output{};
   int axis{0};
   lite::Tensor* axis_tensor{};
+  // The inputs are made the views of output if all of the dims before axis
+  // are 1, so that their producers write into the output directly
+  bool inplace{false};
+  // for int8
+  WITH_INT8_CONFIG
+  std::vector<float> input_scales{};
 };
 
 /// ----------------------- activation operators ----------------------
@@ -311,6 +321,8 @@ struct ActivationParam : ParamBase {
   // softplus
   float softplus_beta{1.0f};
   float softplus_threshold{20.f};
+  // for int8
+  WITH_INT8_CONFIG
 };
 
 struct ActivationGradParam : ParamBase {
@@ -321,6 +333,16 @@ struct ActivationGradParam : ParamBase {
   const lite::Tensor* Out_grad{};
 };
 
+// The storage format of the sparse weights, chosen by sparse_conv_detect_pass.
+// kUnstructured: the non-zeros of each output channel with the scaled input
+//   channel differences, see SparseConvDetectPass::ComputeSparseWeight.
+// kBlock: BSR, the block_h x block_w blocks are stored column major, the
+//   oc_nonzeros is the block row pointer and the diffs is the start input
+//   channel of each block.
+// kNM: at most nm_n non-zeros in every nm_m successive input channels, the
+//   diffs is the input channel of each kept value.
+enum class SparseFormat : int { kUnstructured = 0, kBlock = 1, kNM = 2 };
+
 // For Sparse Convolution op
 struct SparseConvParam : ParamBase {
   const lite::Tensor* x{};
@@ -348,6 +370,32 @@ struct SparseConvParam : ParamBase {
   std::vector<float> weight_scale{};
   float output_scale{1.0f};
   int bit_length{8};
+  SparseFormat sparse_format{SparseFormat::kUnstructured};
+  int block_h{1};
+  int block_w{1};
+  int nm_n{2};
+  int nm_m{4};
+};
+
+// For Sparse FC op, the weights are transposed to [out_features, in_features]
+// before being sparsified.
+struct SparseFcParam : ParamBase {
+  const lite::Tensor* input{};
+  const lite::Tensor* nonzero_weights{};
+  const lite::Tensor* diffs{};
+  const lite::Tensor* oc_nonzeros{};
+  const lite::Tensor* bias{nullptr};
+  lite::Tensor* output{};
+  // -1 means the rank of input minus 1, which is used for matmul
+  int in_num_col_dims{1};
+  int in_features{0};
+  int out_features{0};
+  SparseFormat sparse_format{SparseFormat::kBlock};
+  int block_h{1};
+  int block_w{1};
+  int nm_n{2};
+  int nm_m{4};
+  ActivationParam activation_param;
 };
 
 // For Convolution op
@@ -413,6 +461,17 @@ struct ConvParam : ParamBase {
   std::string scale_activation_type{""};
 };
 
+// For fusion_dw_pw_conv2d op, a depthwise conv followed by a 1x1 conv
+struct DwPwConvParam : ParamBase {
+  lite::Tensor* x{};
+  lite::Tensor* output{};
+  // filter, bias, strides, paddings, dilations and activation of the
+  // depthwise conv, its output is never materialized.
+  ConvParam dw_param;
+  // filter, bias and activation of the pointwise conv.
+  ConvParam pw_param;
+};
+
 // For BatchNorm op
 struct BatchNormParam : ParamBase {
   lite::Tensor* x{};
@@ -489,6 +548,8 @@ struct SplitParam : ParamBase {
   int axis{-1};
   int num{0};
   std::vector<int> sections;
+  // The outputs are the views of x if all of the dims before axis are 1
+  bool inplace{false};
 };
 
 struct UnbindParam : ParamBase {
@@ -507,6 +568,8 @@ struct TransposeParam : ParamBase {
   std::vector<int> axis;
   bool use_mkldnn{false};
   std::string data_format{"AnyLayout"};
+  // for int8
+  WITH_INT8_CONFIG
 };
 
 struct TrilTriuParam : ParamBase {
@@ -553,6 +616,23 @@ struct FusionElementwiseActivationGradParam : public ElementwiseGradParam {
   std::string act_type;
 };
 
+// For fusion_pointwise_chain op, a chain of the pointwise ops applied to X,
+// which is generated by lite_pointwise_chain_fuse_pass.
+struct PointwiseChainParam : ParamBase {
+  const lite::Tensor* X{};
+  std::vector<const lite::Tensor*> operands{};
+  lite::Tensor* Out{};
+  // The i-th step is step_types[i], a binary step takes
+  // operands[step_operands[i]] as its Y with the broadcast axis step_axes[i],
+  // and it's computed as Y op X if step_reversed[i] is set. The attributes of
+  // the i-th step are step_attrs[3 * i, 3 * i + 3).
+  std::vector<std::string> step_types{};
+  std::vector<int> step_operands{};
+  std::vector<int> step_axes{};
+  std::vector<int> step_reversed{};
+  std::vector<float> step_attrs{};
+};
+
 /// ----------------------- mean operators ----------------------
 struct MeanParam : ParamBase {
   const lite::Tensor* X{};
@@ -813,6 +893,33 @@ struct MulticlassNmsParam : ParamBase {
   lite::Tensor* nms_rois_num{};
 };
 
+// For fusion_yolo_box_nms op, the yolo_box ops of the detection heads and
+// the multiclass_nms on the concat of their outputs, which is generated by
+// lite_yolo_box_nms_fuse_pass.
+struct YoloBoxNmsParam : ParamBase {
+  std::vector<const lite::Tensor*> X{};
+  const lite::Tensor* ImgSize{};
+  lite::Tensor* Out{};
+  lite::Tensor* Index{};
+  lite::Tensor* NmsRoisNum{};
+  // The anchors of the i-th head are anchor_nums[i] pairs of anchors, after
+  // the ones of the previous heads.
+  std::vector<int> anchors{};
+  std::vector<int> anchor_nums{};
+  std::vector<int> downsample_ratios{};
+  int class_num{0};
+  float conf_thresh{0.f};
+  bool clip_bbox{true};
+  float scale_x_y{1.0f};
+  int background_label{0};
+  float score_threshold{};
+  int nms_top_k{};
+  float nms_threshold{0.3f};
+  float nms_eta{1.0f};
+  int keep_top_k{};
+  bool normalized{true};
+};
+
 /// ----------------------- matrix_nms operators ----------------------
 struct MatrixNmsParam : ParamBase {
   const lite::Tensor* bboxes{};
@@ -935,6 +1042,21 @@ struct LookupTableDequantParam : ParamBase {
   int64_t padding_idx{-1};
 };
 
+// For fusion_embedding_seq_pool op, the lookup_table, lookup_table_v2 or
+// lookup_table_dequant followed by the sequence_pool of its output, which is
+// generated by lite_embedding_seq_pool_fuse_pass.
+struct EmbeddingSeqPoolParam : ParamBase {
+  const lite::Tensor* W{nullptr};
+  const lite::Tensor* Ids{nullptr};
+  lite::Tensor* Out{nullptr};
+  int64_t padding_idx{-1};
+  // the type of the lookup op, which decides the format of W and the shape
+  std::string lookup_type{"lookup_table"};
+  // SUM, AVERAGE or SQRT
+  std::string pool_type{"SUM"};
+  float pad_value{0.0f};
+};
+
 struct Im2SequenceParam : ParamBase {
   const lite::Tensor* X{};
   const lite::Tensor* Y{};
@@ -959,6 +1081,9 @@ struct NormParam : ParamBase {
 };
 struct LayerNormParam : ParamBase {
   const lite::Tensor* X{};
+  // Y = layer_norm(X + Residual) if Residual is given, which is fused from
+  // the elementwise_add before the layer_norm
+  const lite::Tensor* Residual{};
   const lite::Tensor* Scale{};
   const lite::Tensor* Bias{};
   lite::Tensor* Y{};
@@ -1218,6 +1343,8 @@ struct SliceParam : ParamBase {
   std::vector<lite::Tensor*> EndsTensorList{};
   const lite::Tensor* StartsTensor{nullptr};
   const lite::Tensor* EndsTensor{nullptr};
+  // Out is a view of X if the slice is contiguous
+  bool inplace{false};
 };
 
 struct AffineChannelParam : ParamBase {
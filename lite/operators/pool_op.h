@@ -85,6 +85,15 @@ class PoolOpLite : public OpLite {
       }
     }
     param_.paddings = std::make_shared<std::vector<int>>(paddings);
+    // For Int8
+    const OpInfo* op_info = static_cast<const OpInfo*>(&op_desc);
+    if (op_info != nullptr && op_info->HasAttr("enable_int8")) {
+      param_.enable_int8 = op_info->GetAttr<bool>("enable_int8");
+      if (op_info->HasInputScale("X0_scale", true))
+        param_.input_scale = op_info->GetInputScale("X0_scale", true)[0];
+      if (op_info->HasOutputScale("Out0_scale", true))
+        param_.output_scale = op_info->GetOutputScale("Out0_scale", true)[0];
+    }
 
 #ifdef LITE_WITH_XPU
     if (op_desc.HasAttr("pad_zero")) {
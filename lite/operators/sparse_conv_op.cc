@@ -45,7 +45,14 @@ inline int SparseConvOutputSize(int input_size,
 
 bool SparseConvOp::InferShapeImpl() const {
   const auto in_dims = param_.x->dims();
-  const auto oc = param_.oc_nonzeros->dims()[0];
+  // oc_nonzeros is the row pointer of the block rows or the channels for the
+  // structured formats
+  auto oc = param_.oc_nonzeros->dims()[0];
+  if (param_.sparse_format == SparseFormat::kBlock) {
+    oc = (oc - 1) * param_.block_h;
+  } else if (param_.sparse_format == SparseFormat::kNM) {
+    oc = oc - 1;
+  }
   std::vector<int64_t> output_shape({in_dims[0], oc});
   auto paddings = *param_.paddings;
   auto dilations = *param_.dilations;
@@ -120,6 +120,17 @@ class SparseConvOp : public OpLite {
     if (op_desc.HasAttr("first_ic")) {
       param_.first_ic = op_desc.GetAttr<int>("first_ic");
     }
+    if (op_desc.HasAttr("sparse_format")) {
+      param_.sparse_format =
+          static_cast<SparseFormat>(op_desc.GetAttr<int>("sparse_format"));
+    }
+    if (param_.sparse_format == SparseFormat::kBlock) {
+      param_.block_h = op_desc.GetAttr<int>("block_h");
+      param_.block_w = op_desc.GetAttr<int>("block_w");
+    } else if (param_.sparse_format == SparseFormat::kNM) {
+      param_.nm_n = op_desc.GetAttr<int>("nm_n");
+      param_.nm_m = op_desc.GetAttr<int>("nm_m");
+    }
 
     // For Int8
     const OpInfo* op_info = static_cast<const OpInfo*>(&op_desc);
@@ -0,0 +1,105 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/operators/sparse_fc_op.h"
+#include <vector>
+#include "lite/core/op_registry.h"
+
+namespace paddle {
+namespace lite {
+namespace operators {
+
+bool SparseFcOp::CheckShape() const {
+  CHECK_OR_FALSE(param_.input);
+  CHECK_OR_FALSE(param_.output);
+  CHECK_OR_FALSE(param_.nonzero_weights);
+  CHECK_OR_FALSE(param_.oc_nonzeros);
+  CHECK_OR_FALSE(param_.diffs);
+  CHECK_GT_OR_FALSE(param_.in_features, 0);
+  CHECK_GT_OR_FALSE(param_.out_features, 0);
+  return true;
+}
+
+bool SparseFcOp::InferShapeImpl() const {
+  const auto input_dims = param_.input->dims();
+  int in_num_col_dims = param_.in_num_col_dims;
+  if (in_num_col_dims < 0) {
+    in_num_col_dims = static_cast<int>(input_dims.size()) - 1;
+  }
+  CHECK_EQ(input_dims.Slice(in_num_col_dims, input_dims.size()).production(),
+           param_.in_features);
+  std::vector<DDim::value_type> output_dims(in_num_col_dims + 1);
+  for (int i = 0; i < in_num_col_dims; ++i) {
+    output_dims[i] = input_dims[i];
+  }
+  output_dims[in_num_col_dims] = param_.out_features;
+  param_.output->Resize(output_dims);
+  param_.output->set_lod(param_.input->lod());
+  return true;
+}
+
+bool SparseFcOp::AttachImpl(const cpp::OpDesc& op_desc, lite::Scope* scope) {
+  auto input = op_desc.Input("Input").front();
+  auto nonzero_weights = op_desc.Input("NonZeroWeights").front();
+  auto oc_nonzeros = op_desc.Input("OcNonZeros").front();
+  auto diffs = op_desc.Input("Diffs").front();
+  auto out = op_desc.Output("Out").front();
+
+  param_.input = scope->FindVar(input)->GetMutable<lite::Tensor>();
+  param_.nonzero_weights =
+      scope->FindVar(nonzero_weights)->GetMutable<lite::Tensor>();
+  param_.oc_nonzeros = scope->FindVar(oc_nonzeros)->GetMutable<lite::Tensor>();
+  param_.diffs = scope->FindVar(diffs)->GetMutable<lite::Tensor>();
+  param_.output = scope->FindVar(out)->GetMutable<lite::Tensor>();
+  if (op_desc.HasInput("Bias") && !op_desc.Input("Bias").empty()) {
+    auto bias_var = scope->FindVar(op_desc.Input("Bias").front());
+    if (bias_var != nullptr) {
+      param_.bias = &(bias_var->Get<lite::Tensor>());
+    }
+  }
+
+  param_.in_num_col_dims = op_desc.GetAttr<int>("in_num_col_dims");
+  param_.in_features = op_desc.GetAttr<int>("in_features");
+  param_.out_features = op_desc.GetAttr<int>("out_features");
+  param_.sparse_format =
+      static_cast<SparseFormat>(op_desc.GetAttr<int>("sparse_format"));
+  if (param_.sparse_format == SparseFormat::kBlock) {
+    param_.block_h = op_desc.GetAttr<int>("block_h");
+    param_.block_w = op_desc.GetAttr<int>("block_w");
+  } else if (param_.sparse_format == SparseFormat::kNM) {
+    param_.nm_n = op_desc.GetAttr<int>("nm_n");
+    param_.nm_m = op_desc.GetAttr<int>("nm_m");
+  } else {
+    LOG(FATAL) << "sparse_fc only supports the block and N:M formats.";
+  }
+
+  if (op_desc.HasAttr("activation_type")) {
+    auto act_type = op_desc.GetAttr<std::string>("activation_type");
+    if (act_type == "relu") {
+      param_.activation_param.has_active = true;
+      param_.activation_param.active_type = lite_api::ActivationType::kRelu;
+    } else if (!act_type.empty()) {
+      LOG(FATAL) << "sparse_fc only supports fuse with relu, while the given "
+                    "activation type is "
+                 << act_type;
+    }
+  }
+  return true;
+}
+
+}  // namespace operators
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_LITE_OP(sparse_fc, paddle::lite::operators::SparseFcOp);
@@ -39,6 +39,18 @@ bool SubgraphOp::AttachImpl(const cpp::OpDesc& op_desc, lite::Scope* scope) {
       op_desc.GetAttr<std::vector<std::string>>("input_data_names");
   param_.output_data_names =
       op_desc.GetAttr<std::vector<std::string>>("output_data_names");
+  // The models optimized by the older versions have no weight shapes and
+  // digest
+  param_.weight_data_shapes.clear();
+  if (op_desc.HasAttr("weight_data_shapes")) {
+    param_.weight_data_shapes =
+        op_desc.GetAttr<std::vector<std::string>>("weight_data_shapes");
+  }
+  param_.weight_data_digest.clear();
+  if (op_desc.HasAttr("weight_data_digest")) {
+    param_.weight_data_digest =
+        op_desc.GetAttr<std::string>("weight_data_digest");
+  }
   // Get the quantization parameters of input and output data variables
   auto op_info = static_cast<const OpInfo*>(&op_desc);
   param_.input_data_scales.clear();
@@ -463,6 +463,8 @@ TEST(Activation_relu, precision) {
   abs_error = 2e-5;
 #elif defined(NNADAPTER_WITH_KUNLUNXIN_XTCL)
   abs_error = 2e-5;
+#elif defined(NNADAPTER_WITH_FAKE_DEVICE)
+  abs_error = 2e-5;
 #else
   return;
 #endif
@@ -0,0 +1,439 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+#include "lite/api/paddle_use_kernels.h"
+#include "lite/api/paddle_use_ops.h"
+#include "lite/core/test/arena/framework.h"
+#include "lite/tests/utils/fill_data.h"
+
+namespace paddle {
+namespace lite {
+
+// The baseline is the previous kernel, which computes the source coords and
+// the bilinear interpolation of every output pixel for each of the channels.
+template <typename T>
+bool GT_E(T a, T b) {
+  return (a > b) || fabs(a - b) < 1e-4;
+}
+
+template <typename T>
+bool LT_E(T a, T b) {
+  return (a < b) || fabs(a - b) < 1e-4;
+}
+
+template <typename T>
+bool GT(T a, T b) {
+  return (a - b) > 1e-4;
+}
+
+/**
+ * Get the matrix of perspective transform.
+ *
+ * dx1 = x1 - x2
+ * dx2 = x3 - x2
+ * dx3 = x0 - x1 + x2 - x3
+ * dy1 = y1 - y2
+ * dy2 = y3 - y2
+ * dy3 = y0 - y1 + y2 - y3
+ *
+ * a11 = (x1 - x0 + a31 * (w - 1) * x1) / (w - 1)
+ * a12 = (x3 - x0 + a32 * (h - 1) * x3) / (h - 1)
+ * a13 = x0
+ * a21 = (y1 - y0 + a31 * (w - 1) * y1) / (w - 1)
+ * a22 = (y3 - y0 + a32 * (h - 1) * y3) / (h - 1)
+ * a23 = y0
+ * a31 = (dx3 * dy2 - dx2 * dy3) / (dx1 * dy2 - dx2 * dy1) / (w - 1)
+ * a32 = (dx1 * dy3 - dx3 * dy1) / (dx1 * dy2 - dx2 * dy1) / (h - 1)
+ * a33 = 1
+ */
+template <typename T>
+void get_transform_matrix(const int transformed_width,
+                          const int transformed_height,
+                          T roi_x[],
+                          T roi_y[],
+                          T matrix[]) {
+  T x0 = roi_x[0];
+  T x1 = roi_x[1];
+  T x2 = roi_x[2];
+  T x3 = roi_x[3];
+  T y0 = roi_y[0];
+  T y1 = roi_y[1];
+  T y2 = roi_y[2];
+  T y3 = roi_y[3];
+
+  // Estimate the height and width of RoI
+  T len1 = sqrt((x0 - x1) * (x0 - x1) + (y0 - y1) * (y0 - y1));
+  T len2 = sqrt((x1 - x2) * (x1 - x2) + (y1 - y2) * (y1 - y2));
+  T len3 = sqrt((x2 - x3) * (x2 - x3) + (y2 - y3) * (y2 - y3));
+  T len4 = sqrt((x3 - x0) * (x3 - x0) + (y3 - y0) * (y3 - y0));
+  T estimated_height = (len2 + len4) / 2.0;
+  T estimated_width = (len1 + len3) / 2.0;
+
+  // Get the normalized height and normalized width
+  int normalized_height = std::max(2, transformed_height);
+  int normalized_width =
+      std::round(estimated_width * (normalized_height - 1) / estimated_height) +
+      1;
+  normalized_width = std::max(2, std::min(normalized_width, transformed_width));
+
+  T dx1 = x1 - x2;
+  T dx2 = x3 - x2;
+  T dx3 = x0 - x1 + x2 - x3;
+  T dy1 = y1 - y2;
+  T dy2 = y3 - y2;
+  T dy3 = y0 - y1 + y2 - y3;
+
+  matrix[6] = (dx3 * dy2 - dx2 * dy3) / (dx1 * dy2 - dx2 * dy1 + 1e-5) /
+              (normalized_width - 1);
+  matrix[7] = (dx1 * dy3 - dx3 * dy1) / (dx1 * dy2 - dx2 * dy1 + 1e-5) /
+              (normalized_height - 1);
+  matrix[8] = 1;
+
+  matrix[3] = (y1 - y0 + matrix[6] * (normalized_width - 1) * y1) /
+              (normalized_width - 1);
+  matrix[4] = (y3 - y0 + matrix[7] * (normalized_height - 1) * y3) /
+              (normalized_height - 1);
+  matrix[5] = y0;
+
+  matrix[0] = (x1 - x0 + matrix[6] * (normalized_width - 1) * x1) /
+              (normalized_width - 1);
+  matrix[1] = (x3 - x0 + matrix[7] * (normalized_height - 1) * x3) /
+              (normalized_height - 1);
+  matrix[2] = x0;
+}
+
+/**
+ * Get the source coordinates in the input feature map.
+ *
+ * (u, v, w)^matrix = matrix * (out_w, out_h, 1)^matrix
+ *
+ * in_w = u / w
+ * in_h = v / w
+ *
+ */
+template <typename T>
+void get_source_coords(T matrix[], int out_w, int out_h, T* in_w, T* in_h) {
+  T u = matrix[0] * out_w + matrix[1] * out_h + matrix[2];
+  T v = matrix[3] * out_w + matrix[4] * out_h + matrix[5];
+  T w = matrix[6] * out_w + matrix[7] * out_h + matrix[8];
+
+  in_w[0] = u / w;
+  in_h[0] = v / w;
+}
+
+/*
+*check if (x, y) is in the boundary of roi
+*/
+template <typename T>
+bool in_quad(T x, T y, T roi_x[], T roi_y[]) {
+  for (int i = 0; i < 4; i++) {
+    T xs = roi_x[i];
+    T ys = roi_y[i];
+    T xe = roi_x[(i + 1) % 4];
+    T ye = roi_y[(i + 1) % 4];
+    if (fabs(ys - ye) < 1e-4) {
+      if (fabs(y - ys) < 1e-4 && fabs(y - ye) < 1e-4 &&
+          GT_E<T>(x, std::min(xs, xe)) && LT_E<T>(x, std::max(xs, xe))) {
+        return true;
+      }
+    } else {
+      T intersec_x = (y - ys) * (xe - xs) / (ye - ys) + xs;
+      if (fabs(intersec_x - x) < 1e-4 && GT_E<T>(y, std::min(ys, ye)) &&
+          LT_E<T>(y, std::max(ys, ye))) {
+        return true;
+      }
+    }
+  }
+
+  int n_cross = 0;
+  for (int i = 0; i < 4; i++) {
+    T xs = roi_x[i];
+    T ys = roi_y[i];
+    T xe = roi_x[(i + 1) % 4];
+    T ye = roi_y[(i + 1) % 4];
+    if (fabs(ys - ye) < 1e-4) {
+      continue;
+    }
+    if (LT_E<T>(y, std::min(ys, ye)) || GT<T>(y, std::max(ys, ye))) {
+      continue;
+    }
+    T intersec_x = (y - ys) * (xe - xs) / (ye - ys) + xs;
+    if (fabs(intersec_x - x) < 1e-4) {
+      return true;
+    }
+    if (GT<T>(intersec_x, x)) {
+      n_cross++;
+    }
+  }
+  return (n_cross % 2 == 1);
+}
+
+/**
+ * Perform bilinear interpolation in the input feature map.
+ */
+template <typename T>
+void bilinear_interpolate(const T* in_data,
+                          const int channels,
+                          const int width,
+                          const int height,
+                          int in_n,
+                          int in_c,
+                          T in_w,
+                          T in_h,
+                          T* val) {
+  // Deal with cases that source coords are out of feature map boundary
+  if (GT_E<T>(-0.5, in_w) || GT_E<T>(in_w, width - 0.5) ||
+      GT_E<T>(-0.5, in_h) || GT_E<T>(in_h, height - 0.5)) {
+    // empty
+    val[0] = 0.0;
+    return;
+  }
+
+  if (GT_E<T>(0, in_w)) {
+    in_w = 0;
+  }
+  if (GT_E<T>(0, in_h)) {
+    in_h = 0;
+  }
+
+  int in_w_floor = floor(in_w);
+  int in_h_floor = floor(in_h);
+  int in_w_ceil;
+  int in_h_ceil;
+
+  if (GT_E<T>(in_w_floor, width - 1)) {
+    in_w_ceil = in_w_floor = width - 1;
+    in_w = static_cast<T>(in_w_floor);
+  } else {
+    in_w_ceil = in_w_floor + 1;
+  }
+
+  if (GT_E<T>(in_h_floor, height - 1)) {
+    in_h_ceil = in_h_floor = height - 1;
+    in_h = static_cast<T>(in_h_floor);
+  } else {
+    in_h_ceil = in_h_floor + 1;
+  }
+  T w_floor = in_w - in_w_floor;
+  T h_floor = in_h - in_h_floor;
+  T w_ceil = 1 - w_floor;
+  T h_ceil = 1 - h_floor;
+  const T* data = in_data + (in_n * channels + in_c) * height * width;
+  // Do bilinear interpolation
+  T v1 = data[in_h_floor * width + in_w_floor];
+  T v2 = data[in_h_ceil * width + in_w_floor];
+  T v3 = data[in_h_ceil * width + in_w_ceil];
+  T v4 = data[in_h_floor * width + in_w_ceil];
+  T w1 = w_ceil * h_ceil;
+  T w2 = w_ceil * h_floor;
+  T w3 = w_floor * h_floor;
+  T w4 = w_floor * h_ceil;
+  val[0] = w1 * v1 + w2 * v2 + w3 * v3 + w4 * v4;
+}
+
+class RoiPerspectiveTransformComputeTester : public arena::TestCase {
+ protected:
+  std::string x_ = "x";
+  std::string rois_ = "rois";
+  std::string out_ = "out";
+  std::string mask_ = "mask";
+  std::string transform_matrix_ = "transform_matrix";
+  std::string out2in_idx_ = "out2in_idx";
+  std::string out2in_weights_ = "out2in_weights";
+  DDim x_dims_;
+  LoD rois_lod_;
+  float spatial_scale_;
+  int transformed_height_;
+  int transformed_width_;
+
+ public:
+  RoiPerspectiveTransformComputeTester(const Place& place,
+                                       const std::string& alias,
+                                       const DDim& x_dims,
+                                       const LoD& rois_lod,
+                                       float spatial_scale,
+                                       int transformed_height,
+                                       int transformed_width)
+      : TestCase(place, alias),
+        x_dims_(x_dims),
+        rois_lod_(rois_lod),
+        spatial_scale_(spatial_scale),
+        transformed_height_(transformed_height),
+        transformed_width_(transformed_width) {}
+
+  void RunBaseline(Scope* scope) override {
+    auto* x = scope->FindTensor(x_);
+    auto* rois = scope->FindTensor(rois_);
+    int channels = x_dims_[1];
+    int in_height = x_dims_[2];
+    int in_width = x_dims_[3];
+    int rois_num = rois->dims()[0];
+    auto* out = scope->NewTensor(out_);
+    out->Resize(
+        {rois_num, channels, transformed_height_, transformed_width_});
+    out->set_lod(rois_lod_);
+    auto* mask = scope->NewTensor(mask_);
+    mask->Resize({rois_num, 1, transformed_height_, transformed_width_});
+    auto* transform_matrix = scope->NewTensor(transform_matrix_);
+    transform_matrix->Resize({rois_num, 9});
+
+    const float* input_data = x->data<float>();
+    const float* rois_data = rois->data<float>();
+    float* output_data = out->mutable_data<float>();
+    int* mask_data = mask->mutable_data<int>();
+    float* matrix_data = transform_matrix->mutable_data<float>();
+    std::vector<int> roi2image(rois_num);
+    auto& lod = rois_lod_.back();
+    for (size_t i = 0; i + 1 < lod.size(); ++i) {
+      for (size_t j = lod[i]; j < lod[i + 1]; ++j) {
+        roi2image[j] = i;
+      }
+    }
+
+    for (int n = 0; n < rois_num; ++n) {
+      const float* n_rois = rois_data + n * 8;
+      float roi_x[4];
+      float roi_y[4];
+      for (int k = 0; k < 4; ++k) {
+        roi_x[k] = n_rois[2 * k] * spatial_scale_;
+        roi_y[k] = n_rois[2 * k + 1] * spatial_scale_;
+      }
+      float matrix[9];
+      get_transform_matrix<float>(
+          transformed_width_, transformed_height_, roi_x, roi_y, matrix);
+      for (int i = 0; i < 9; i++) {
+        matrix_data[n * 9 + i] = matrix[i];
+      }
+      for (int c = 0; c < channels; ++c) {
+        for (int out_h = 0; out_h < transformed_height_; ++out_h) {
+          for (int out_w = 0; out_w < transformed_width_; ++out_w) {
+            int out_index =
+                ((n * channels + c) * transformed_height_ + out_h) *
+                    transformed_width_ +
+                out_w;
+            int mask_index =
+                (n * transformed_height_ + out_h) * transformed_width_ + out_w;
+            float in_w, in_h;
+            get_source_coords<float>(matrix, out_w, out_h, &in_w, &in_h);
+            if (in_quad<float>(in_w, in_h, roi_x, roi_y) &&
+                !(GT_E<float>(-0.5, in_w) ||
+                  GT_E<float>(in_w, static_cast<float>(in_width - 0.5)) ||
+                  GT_E<float>(-0.5, in_h) ||
+                  GT_E<float>(in_h, static_cast<float>(in_height - 0.5)))) {
+              bilinear_interpolate<float>(input_data,
+                                          channels,
+                                          in_width,
+                                          in_height,
+                                          roi2image[n],
+                                          c,
+                                          in_w,
+                                          in_h,
+                                          output_data + out_index);
+              mask_data[mask_index] = 1;
+            } else {
+              output_data[out_index] = 0.f;
+              mask_data[mask_index] = 0;
+            }
+          }
+        }
+      }
+    }
+  }
+
+  void PrepareOpDesc(cpp::OpDesc* op_desc) {
+    op_desc->SetType("roi_perspective_transform");
+    op_desc->SetInput("X", {x_});
+    op_desc->SetInput("ROIs", {rois_});
+    op_desc->SetOutput("Out", {out_});
+    op_desc->SetOutput("Mask", {mask_});
+    op_desc->SetOutput("TransformMatrix", {transform_matrix_});
+    op_desc->SetOutput("Out2InIdx", {out2in_idx_});
+    op_desc->SetOutput("Out2InWeights", {out2in_weights_});
+    op_desc->SetAttr("spatial_scale", spatial_scale_);
+    op_desc->SetAttr("transformed_height", transformed_height_);
+    op_desc->SetAttr("transformed_width", transformed_width_);
+  }
+
+  // The quads are around the feature maps, some of their corners are out of
+  // the maps, and some are flipped.
+  void PrepareData() override {
+    std::vector<float> x(x_dims_.production());
+    fill_data_rand<float>(x.data(), -1.f, 1.f, x.size());
+    SetCommonTensor(x_, x_dims_, x.data());
+
+    int64_t rois_num = rois_lod_.back().back();
+    float height = x_dims_[2] / spatial_scale_;
+    float width = x_dims_[3] / spatial_scale_;
+    std::vector<float> rois(rois_num * 8);
+    for (int64_t n = 0; n < rois_num; ++n) {
+      float cx = 0.f;
+      float cy = 0.f;
+      fill_data_rand<float>(&cx, -0.1f * width, 1.1f * width, 1);
+      fill_data_rand<float>(&cy, -0.1f * height, 1.1f * height, 1);
+      // The corners are clockwise, from the top left one.
+      const float dx[4] = {-1.f, 1.f, 1.f, -1.f};
+      const float dy[4] = {-1.f, -1.f, 1.f, 1.f};
+      for (int k = 0; k < 4; ++k) {
+        float rx = 0.f;
+        float ry = 0.f;
+        fill_data_rand<float>(&rx, 0.1f * width, 0.4f * width, 1);
+        fill_data_rand<float>(&ry, 0.1f * height, 0.4f * height, 1);
+        rois[n * 8 + 2 * k] = cx + dx[k] * rx * (n % 5 == 4 ? -1.f : 1.f);
+        rois[n * 8 + 2 * k + 1] = cy + dy[k] * ry;
+      }
+    }
+    SetCommonTensor(rois_, DDim({rois_num, 8}), rois.data(), rois_lod_);
+  }
+};
+
+void TestRoiPerspectiveTransform(const Place& place, float abs_error) {
+  // The ROIs of an image are computed by the tasks of 4 ROIs, so some of the
+  // tasks cover the ROIs of two images.
+  for (auto& lod : std::vector<LoD>{{{0, 1}}, {{0, 3, 9}}, {{0, 5, 5, 13}}}) {
+    int64_t batch = lod.back().size() - 1;
+    for (auto& channels : {1, 3, 16}) {
+      for (auto& spatial_scale : {1.f, 0.25f}) {
+        for (auto& transformed_size : std::vector<std::vector<int>>{
+                 {1, 1}, {2, 2}, {8, 16}, {17, 9}}) {
+          std::unique_ptr<arena::TestCase> tester(
+              new RoiPerspectiveTransformComputeTester(
+                  place,
+                  "def",
+                  DDim({batch, channels, 23, 31}),
+                  lod,
+                  spatial_scale,
+                  transformed_size[0],
+                  transformed_size[1]));
+          arena::Arena arena(std::move(tester), place, abs_error);
+          // The indices and the weights of the pixels aren't computed.
+          arena.TestPrecision({"out2in_idx", "out2in_weights"});
+        }
+      }
+    }
+  }
+}
+
+TEST(RoiPerspectiveTransform, precision) {
+#if defined(LITE_WITH_X86) || defined(LITE_WITH_ARM)
+  TestRoiPerspectiveTransform(TARGET(kHost), 1e-5);
+#endif
+}
+
+}  // namespace lite
+}  // namespace paddle
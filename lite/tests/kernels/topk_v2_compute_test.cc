@@ -72,16 +72,16 @@ class TopkV2ComputeTester : public arena::TestCase {
     for (int i = 0; i < outer_size; i++) {
       int glb_in_off = i * sum_size;
       int glb_out_off = i * out_sum_size;
-      std::vector<std::pair<float, int>> vec;
-      for (int j = 0; j < axis_size; j++) {
-        vec.push_back(std::make_pair(x_data[glb_in_off + j * inner_size], j));
-      }
-      std::partial_sort(
-          vec.begin(), vec.begin() + k_, vec.end(), comp_func<T1, T2>);
-      for (int j = 0; j < k_; j++) {
-        for (int k = 0; k < inner_size; k++) {
-          int cur_off = glb_in_off + vec[j].second * inner_size + k;
-          out_val_data[glb_out_off + j * inner_size + k] = x_data[cur_off];
+      for (int k = 0; k < inner_size; k++) {
+        std::vector<std::pair<float, int>> vec;
+        for (int j = 0; j < axis_size; j++) {
+          vec.push_back(
+              std::make_pair(x_data[glb_in_off + j * inner_size + k], j));
+        }
+        std::partial_sort(
+            vec.begin(), vec.begin() + k_, vec.end(), comp_func<T1, T2>);
+        for (int j = 0; j < k_; j++) {
+          out_val_data[glb_out_off + j * inner_size + k] = vec[j].first;
           out_ind_data[glb_out_off + j * inner_size + k] = vec[j].second;
         }
       }
@@ -0,0 +1,642 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+#include "lite/api/paddle_use_kernels.h"
+#include "lite/api/paddle_use_ops.h"
+#include "lite/core/test/arena/framework.h"
+
+namespace paddle {
+namespace lite {
+
+// The int8 kernels of x86 read the int8 inputs with their scales, and write
+// the output quantized by the output scale for the alias int8_out, or the
+// float output for the alias fp32_out. The baselines compute the float
+// results of the dequantized inputs.
+class Int8ComputeTester : public arena::TestCase {
+ protected:
+  bool int8_out_;
+  float out_scale_;
+  std::mt19937 gen_{2021};
+
+ public:
+  Int8ComputeTester(const Place& place,
+                    const std::string& alias,
+                    float out_scale)
+      : TestCase(place, alias),
+        int8_out_(alias == "int8_out"),
+        out_scale_(out_scale) {}
+
+ protected:
+  // Sets the input of the random int8 values in [-limit, limit].
+  void SetInt8Tensor(const std::string& name,
+                     const DDim& dims,
+                     int limit = 127) {
+    std::uniform_int_distribution<int> dis(-limit, limit);
+    std::vector<int8_t> data(dims.production());
+    for (auto& v : data) {
+      v = static_cast<int8_t>(dis(gen_));
+    }
+    SetCommonTensor(name, dims, data.data());
+  }
+
+  std::vector<float> Dequantize(Scope* scope,
+                                const std::string& name,
+                                float scale) {
+    auto* x = scope->FindTensor(name);
+    std::vector<float> data(x->numel());
+    for (int64_t i = 0; i < x->numel(); i++) {
+      data[i] = x->data<int8_t>()[i] * scale;
+    }
+    return data;
+  }
+
+  // Writes the float results into the output of the baseline, which is
+  // quantized for the int8 output.
+  void SetOutput(Scope* scope,
+                 const std::string& name,
+                 const DDim& dims,
+                 const std::vector<float>& results) {
+    auto* out = scope->NewTensor(name);
+    out->Resize(dims);
+    if (!int8_out_) {
+      std::copy(results.begin(), results.end(), out->mutable_data<float>());
+      return;
+    }
+    auto* out_data = out->mutable_data<int8_t>();
+    for (size_t i = 0; i < results.size(); i++) {
+      float q = std::round(results[i] / out_scale_);
+      out_data[i] = static_cast<int8_t>(std::min(std::max(q, -127.f), 127.f));
+    }
+  }
+
+  void SetInt8Attrs(cpp::OpDesc* op_desc) {
+    op_desc->SetAttr<bool>("enable_int8", true);
+    op_desc->SetAttr<std::vector<float>>("Out0_scale", {out_scale_});
+  }
+};
+
+class MatMulInt8ComputeTester : public Int8ComputeTester {
+ protected:
+  DDim x_dims_;
+  DDim y_dims_;
+  bool trans_x_;
+  bool trans_y_;
+  float alpha_;
+  float x_scale_;
+  std::vector<float> y_scales_;
+
+ public:
+  MatMulInt8ComputeTester(const Place& place,
+                          const std::string& alias,
+                          const DDim& x_dims,
+                          const DDim& y_dims,
+                          bool trans_x,
+                          bool trans_y,
+                          float alpha,
+                          const std::vector<float>& y_scales)
+      : Int8ComputeTester(place, alias, 0.05f),
+        x_dims_(x_dims),
+        y_dims_(y_dims),
+        trans_x_(trans_x),
+        trans_y_(trans_y),
+        alpha_(alpha),
+        x_scale_(1.f / 64),
+        y_scales_(y_scales) {}
+
+  void RunBaseline(Scope* scope) override {
+    auto x = Dequantize(scope, "x", 1.f);
+    auto y = Dequantize(scope, "y", 1.f);
+    const int x_rank = x_dims_.size();
+    const int y_rank = y_dims_.size();
+    const int M = trans_x_ ? x_dims_[x_rank - 1] : x_dims_[x_rank - 2];
+    const int K = trans_x_ ? x_dims_[x_rank - 2] : x_dims_[x_rank - 1];
+    const int N = trans_y_ ? y_dims_[y_rank - 2] : y_dims_[y_rank - 1];
+    const int64_t x_batch = x_dims_.count(0, x_rank - 2);
+    const int64_t y_batch = y_dims_.count(0, y_rank - 2);
+    std::vector<int64_t> out_shape = x_dims_.Vectorize();
+    out_shape[x_rank - 2] = M;
+    out_shape[x_rank - 1] = N;
+    std::vector<float> out(x_batch * M * N);
+    for (int64_t b = 0; b < x_batch; b++) {
+      const float* x_ptr = x.data() + b * M * K;
+      const float* y_ptr = y.data() + (y_batch == 1 ? 0 : b * K * N);
+      for (int m = 0; m < M; m++) {
+        for (int n = 0; n < N; n++) {
+          float sum = 0.f;
+          for (int k = 0; k < K; k++) {
+            float xv = trans_x_ ? x_ptr[k * M + m] : x_ptr[m * K + k];
+            float yv = trans_y_ ? y_ptr[n * K + k] : y_ptr[k * N + n];
+            sum += xv * yv;
+          }
+          float y_scale = y_scales_.size() > 1 ? y_scales_[n] : y_scales_[0];
+          out[(b * M + m) * N + n] = sum * x_scale_ * alpha_ * y_scale;
+        }
+      }
+    }
+    SetOutput(scope, "out", DDim(out_shape), out);
+  }
+
+  void PrepareOpDesc(cpp::OpDesc* op_desc) override {
+    op_desc->SetType("matmul");
+    op_desc->SetInput("X", {"x"});
+    op_desc->SetInput("Y", {"y"});
+    op_desc->SetOutput("Out", {"out"});
+    op_desc->SetAttr("transpose_X", trans_x_);
+    op_desc->SetAttr("transpose_Y", trans_y_);
+    op_desc->SetAttr("alpha", alpha_);
+    SetInt8Attrs(op_desc);
+    op_desc->SetAttr<std::vector<float>>("X0_scale", {x_scale_});
+    op_desc->SetAttr<std::vector<float>>("Y0_scale", y_scales_);
+  }
+
+  void PrepareData() override {
+    // The AVX2 s8u8 gemm adds the pairs of the products into int16 with
+    // saturation, X in [-63, 63] keeps them in range.
+    SetInt8Tensor("x", x_dims_, 63);
+    SetInt8Tensor("y", y_dims_);
+  }
+};
+
+class ElementwiseInt8ComputeTester : public Int8ComputeTester {
+ protected:
+  std::string op_type_;
+  DDim x_dims_;
+  DDim y_dims_;
+  int axis_;
+  float x_scale_{0.02f};
+  float y_scale_{0.03f};
+
+ public:
+  ElementwiseInt8ComputeTester(const Place& place,
+                               const std::string& alias,
+                               const std::string& op_type,
+                               const DDim& x_dims,
+                               const DDim& y_dims,
+                               int axis)
+      : Int8ComputeTester(
+            place, alias, op_type == "elementwise_add" ? 0.04f : 0.1f),
+        op_type_(op_type),
+        x_dims_(x_dims),
+        y_dims_(y_dims),
+        axis_(axis) {}
+
+  void RunBaseline(Scope* scope) override {
+    auto x = Dequantize(scope, "x", x_scale_);
+    auto y = Dequantize(scope, "y", y_scale_);
+    // Y is broadcast along the axis of X.
+    int axis = axis_ < 0 ? x_dims_.size() - y_dims_.size() : axis_;
+    int64_t n = y_dims_.production();
+    int64_t post = x_dims_.count(axis + y_dims_.size(), x_dims_.size());
+    std::vector<float> out(x.size());
+    for (size_t i = 0; i < x.size(); i++) {
+      float yv = y[(i / post) % n];
+      out[i] = op_type_ == "elementwise_add" ? x[i] + yv : x[i] * yv;
+    }
+    SetOutput(scope, "out", x_dims_, out);
+  }
+
+  void PrepareOpDesc(cpp::OpDesc* op_desc) override {
+    op_desc->SetType(op_type_);
+    op_desc->SetInput("X", {"x"});
+    op_desc->SetInput("Y", {"y"});
+    op_desc->SetOutput("Out", {"out"});
+    op_desc->SetAttr("axis", axis_);
+    SetInt8Attrs(op_desc);
+    op_desc->SetAttr<std::vector<float>>("X0_scale", {x_scale_});
+    op_desc->SetAttr<std::vector<float>>("Y0_scale", {y_scale_});
+  }
+
+  void PrepareData() override {
+    SetInt8Tensor("x", x_dims_);
+    SetInt8Tensor("y", y_dims_);
+  }
+};
+
+class PoolInt8ComputeTester : public Int8ComputeTester {
+ protected:
+  DDim x_dims_;
+  std::string pooling_type_;
+  std::vector<int> ksize_;
+  std::vector<int> strides_;
+  std::vector<int> paddings_;
+  bool exclusive_;
+  bool global_pooling_;
+  float x_scale_{0.02f};
+
+ public:
+  PoolInt8ComputeTester(const Place& place,
+                        const std::string& alias,
+                        const DDim& x_dims,
+                        const std::string& pooling_type,
+                        const std::vector<int>& ksize,
+                        const std::vector<int>& strides,
+                        const std::vector<int>& paddings,
+                        bool exclusive,
+                        bool global_pooling)
+      : Int8ComputeTester(place, alias, 0.02f),
+        x_dims_(x_dims),
+        pooling_type_(pooling_type),
+        ksize_(ksize),
+        strides_(strides),
+        paddings_(paddings),
+        exclusive_(exclusive),
+        global_pooling_(global_pooling) {}
+
+  void RunBaseline(Scope* scope) override {
+    auto x = Dequantize(scope, "x", x_scale_);
+    const int nc = x_dims_[0] * x_dims_[1];
+    const int ih = x_dims_[2];
+    const int iw = x_dims_[3];
+    auto ksize = global_pooling_ ? std::vector<int>{ih, iw} : ksize_;
+    auto paddings = global_pooling_ ? std::vector<int>{0, 0} : paddings_;
+    auto strides = global_pooling_ ? std::vector<int>{1, 1} : strides_;
+    const int oh = (ih + 2 * paddings[0] - ksize[0]) / strides[0] + 1;
+    const int ow = (iw + 2 * paddings[1] - ksize[1]) / strides[1] + 1;
+    std::vector<float> out(nc * oh * ow);
+    for (int c = 0; c < nc; c++) {
+      for (int h = 0; h < oh; h++) {
+        for (int w = 0; w < ow; w++) {
+          int hstart = h * strides[0] - paddings[0];
+          int wstart = w * strides[1] - paddings[1];
+          int hend = std::min(hstart + ksize[0], ih);
+          int wend = std::min(wstart + ksize[1], iw);
+          hstart = std::max(hstart, 0);
+          wstart = std::max(wstart, 0);
+          float max_value = -1e10f;
+          float sum = 0.f;
+          for (int i = hstart; i < hend; i++) {
+            for (int j = wstart; j < wend; j++) {
+              float v = x[(c * ih + i) * iw + j];
+              max_value = std::max(max_value, v);
+              sum += v;
+            }
+          }
+          int pool_size = exclusive_ ? (hend - hstart) * (wend - wstart)
+                                     : ksize[0] * ksize[1];
+          out[(c * oh + h) * ow + w] =
+              pooling_type_ == "max" ? max_value : sum / pool_size;
+        }
+      }
+    }
+    SetOutput(scope, "out", DDim({x_dims_[0], x_dims_[1], oh, ow}), out);
+  }
+
+  void PrepareOpDesc(cpp::OpDesc* op_desc) override {
+    op_desc->SetType("pool2d");
+    op_desc->SetInput("X", {"x"});
+    op_desc->SetOutput("Out", {"out"});
+    op_desc->SetAttr("pooling_type", pooling_type_);
+    op_desc->SetAttr("ksize", ksize_);
+    op_desc->SetAttr("global_pooling", global_pooling_);
+    op_desc->SetAttr("strides", strides_);
+    op_desc->SetAttr("paddings", paddings_);
+    op_desc->SetAttr("exclusive", exclusive_);
+    SetInt8Attrs(op_desc);
+    op_desc->SetAttr<std::vector<float>>("X0_scale", {x_scale_});
+  }
+
+  void PrepareData() override { SetInt8Tensor("x", x_dims_); }
+};
+
+class ConcatInt8ComputeTester : public Int8ComputeTester {
+ protected:
+  std::vector<DDim> x_dims_;
+  std::vector<float> x_scales_;
+  int axis_;
+
+ public:
+  ConcatInt8ComputeTester(const Place& place,
+                          const std::string& alias,
+                          const std::vector<DDim>& x_dims,
+                          const std::vector<float>& x_scales,
+                          int axis)
+      : Int8ComputeTester(place, alias, 0.03f),
+        x_dims_(x_dims),
+        x_scales_(x_scales),
+        axis_(axis) {}
+
+  void RunBaseline(Scope* scope) override {
+    auto out_shape = x_dims_[0].Vectorize();
+    out_shape[axis_] = 0;
+    for (auto& dims : x_dims_) {
+      out_shape[axis_] += dims[axis_];
+    }
+    DDim out_dims(out_shape);
+    const int64_t outer = out_dims.count(0, axis_);
+    std::vector<float> out;
+    for (int64_t o = 0; o < outer; o++) {
+      for (size_t i = 0; i < x_dims_.size(); i++) {
+        auto x = Dequantize(scope, "x" + std::to_string(i), x_scales_[i]);
+        int64_t size = x.size() / outer;
+        out.insert(out.end(), x.begin() + o * size, x.begin() + (o + 1) * size);
+      }
+    }
+    SetOutput(scope, "out", out_dims, out);
+  }
+
+  void PrepareOpDesc(cpp::OpDesc* op_desc) override {
+    std::vector<std::string> x_names;
+    for (size_t i = 0; i < x_dims_.size(); i++) {
+      x_names.push_back("x" + std::to_string(i));
+      op_desc->SetAttr<std::vector<float>>("X" + std::to_string(i) + "_scale",
+                                           {x_scales_[i]});
+    }
+    op_desc->SetType("concat");
+    op_desc->SetInput("X", x_names);
+    op_desc->SetOutput("Out", {"out"});
+    op_desc->SetAttr("axis", axis_);
+    SetInt8Attrs(op_desc);
+  }
+
+  void PrepareData() override {
+    for (size_t i = 0; i < x_dims_.size(); i++) {
+      SetInt8Tensor("x" + std::to_string(i), x_dims_[i]);
+    }
+  }
+};
+
+class ActivationInt8ComputeTester : public Int8ComputeTester {
+ protected:
+  std::string act_type_;
+  DDim x_dims_{{2, 3, 4, 5}};
+  float x_scale_{0.05f};
+
+ public:
+  ActivationInt8ComputeTester(const Place& place,
+                              const std::string& alias,
+                              const std::string& act_type,
+                              float out_scale)
+      : Int8ComputeTester(place, alias, out_scale), act_type_(act_type) {}
+
+  void RunBaseline(Scope* scope) override {
+    auto x = Dequantize(scope, "x", x_scale_);
+    std::vector<float> out(x.size());
+    for (size_t i = 0; i < x.size(); i++) {
+      float v = x[i];
+      if (act_type_ == "relu") {
+        out[i] = std::max(v, 0.f);
+      } else if (act_type_ == "relu6") {
+        out[i] = std::min(std::max(v, 0.f), 6.f);
+      } else if (act_type_ == "leaky_relu") {
+        out[i] = v > 0.f ? v : v * 0.1f;
+      } else if (act_type_ == "hard_swish") {
+        out[i] = v * std::min(std::max(v + 3.f, 0.f), 6.f) / 6.f;
+      } else if (act_type_ == "sigmoid") {
+        out[i] = 1.f / (1.f + std::exp(-v));
+      } else {
+        out[i] = std::tanh(v);
+      }
+    }
+    SetOutput(scope, "out", x_dims_, out);
+  }
+
+  void PrepareOpDesc(cpp::OpDesc* op_desc) override {
+    op_desc->SetType(act_type_);
+    op_desc->SetInput("X", {"x"});
+    op_desc->SetOutput("Out", {"out"});
+    if (act_type_ == "relu6") {
+      op_desc->SetAttr("threshold", 6.f);
+    } else if (act_type_ == "leaky_relu") {
+      op_desc->SetAttr("alpha", 0.1f);
+    } else if (act_type_ == "hard_swish") {
+      op_desc->SetAttr("threshold", 6.f);
+      op_desc->SetAttr("scale", 6.f);
+      op_desc->SetAttr("offset", 3.f);
+    }
+    SetInt8Attrs(op_desc);
+    op_desc->SetAttr<std::vector<float>>("X0_scale", {x_scale_});
+  }
+
+  void PrepareData() override { SetInt8Tensor("x", x_dims_); }
+};
+
+class TransposeInt8ComputeTester : public Int8ComputeTester {
+ protected:
+  std::string op_type_;
+  DDim x_dims_;
+  std::vector<int> axis_;
+  float x_scale_{0.02f};
+
+ public:
+  TransposeInt8ComputeTester(const Place& place,
+                             const std::string& alias,
+                             const std::string& op_type,
+                             const DDim& x_dims,
+                             const std::vector<int>& axis,
+                             float out_scale)
+      : Int8ComputeTester(place, alias, out_scale),
+        op_type_(op_type),
+        x_dims_(x_dims),
+        axis_(axis) {}
+
+  void RunBaseline(Scope* scope) override {
+    auto x = Dequantize(scope, "x", x_scale_);
+    const int rank = x_dims_.size();
+    std::vector<int64_t> out_shape(rank);
+    for (int i = 0; i < rank; i++) {
+      out_shape[i] = x_dims_[axis_[i]];
+    }
+    DDim out_dims(out_shape);
+    std::vector<float> out(x.size());
+    std::vector<int64_t> index(rank);
+    for (int64_t i = 0; i < out_dims.production(); i++) {
+      int64_t offset = i;
+      for (int d = rank - 1; d >= 0; d--) {
+        index[d] = offset % out_shape[d];
+        offset /= out_shape[d];
+      }
+      int64_t x_offset = 0;
+      for (int d = 0; d < rank; d++) {
+        x_offset += index[d] * x_dims_.count(axis_[d] + 1, rank);
+      }
+      out[i] = x[x_offset];
+    }
+    SetOutput(scope, "out", out_dims, out);
+  }
+
+  void PrepareOpDesc(cpp::OpDesc* op_desc) override {
+    op_desc->SetType(op_type_);
+    op_desc->SetInput("X", {"x"});
+    op_desc->SetOutput("Out", {"out"});
+    if (op_type_ == "transpose2") {
+      op_desc->SetOutput("XShape", {"xshape"});
+    }
+    op_desc->SetAttr("axis", axis_);
+    SetInt8Attrs(op_desc);
+    op_desc->SetAttr<std::vector<float>>("X0_scale", {x_scale_});
+  }
+
+  void PrepareData() override { SetInt8Tensor("x", x_dims_); }
+};
+
+// The int8 outputs may differ by one from the rounding of the float results.
+float Int8AbsError(const std::string& alias, float fp32_error) {
+  return alias == "int8_out" ? 1.f : fp32_error;
+}
+
+TEST(MatMulInt8, precision) {
+#ifdef LITE_WITH_X86
+  Place place(TARGET(kX86), PRECISION(kInt8));
+  for (std::string alias : {"int8_out", "fp32_out"}) {
+    for (bool trans_x : {false, true}) {
+      for (bool trans_y : {false, true}) {
+        // The per-tensor and the per-column scales of Y.
+        for (int y_scale_size : {1, 24}) {
+          std::vector<float> y_scales(y_scale_size);
+          for (int i = 0; i < y_scale_size; i++) {
+            y_scales[i] = (1.f + i % 4) / 127;
+          }
+          DDim x_dims = trans_x ? DDim({2, 3, 33, 7}) : DDim({2, 3, 7, 33});
+          DDim y_dims = trans_y ? DDim({24, 33}) : DDim({33, 24});
+          std::unique_ptr<arena::TestCase> tester(new MatMulInt8ComputeTester(
+              place, alias, x_dims, y_dims, trans_x, trans_y, 0.5f, y_scales));
+          arena::Arena arena(
+              std::move(tester), place, Int8AbsError(alias, 1e-3));
+          EXPECT_TRUE(arena.TestPrecision());
+        }
+      }
+    }
+    // The batches of Y.
+    std::unique_ptr<arena::TestCase> tester(
+        new MatMulInt8ComputeTester(place,
+                                    alias,
+                                    DDim({4, 5, 40}),
+                                    DDim({4, 40, 9}),
+                                    false,
+                                    false,
+                                    1.f,
+                                    {1.f / 127}));
+    arena::Arena arena(std::move(tester), place, Int8AbsError(alias, 1e-3));
+    EXPECT_TRUE(arena.TestPrecision());
+  }
+#endif
+}
+
+TEST(ElementwiseInt8, precision) {
+#ifdef LITE_WITH_X86
+  Place place(TARGET(kX86), PRECISION(kInt8));
+  for (std::string alias : {"int8_out", "fp32_out"}) {
+    for (std::string op_type : {"elementwise_add", "elementwise_mul"}) {
+      // The same shapes and the broadcast Y.
+      const std::vector<std::pair<DDim, int>> ys{
+          {DDim({2, 3, 4, 5}), -1}, {DDim({3}), 1}, {DDim({3, 4}), 1}};
+      for (auto& y : ys) {
+        std::unique_ptr<arena::TestCase> tester(
+            new ElementwiseInt8ComputeTester(
+                place, alias, op_type, DDim({2, 3, 4, 5}), y.first, y.second));
+        arena::Arena arena(std::move(tester), place, Int8AbsError(alias, 1e-5));
+        EXPECT_TRUE(arena.TestPrecision());
+      }
+    }
+  }
+#endif
+}
+
+TEST(PoolInt8, precision) {
+#ifdef LITE_WITH_X86
+  Place place(TARGET(kX86), PRECISION(kInt8));
+  for (std::string alias : {"int8_out", "fp32_out"}) {
+    for (std::string pooling_type : {"max", "avg"}) {
+      for (bool exclusive : {true, false}) {
+        for (bool global_pooling : {false, true}) {
+          std::unique_ptr<arena::TestCase> tester(
+              new PoolInt8ComputeTester(place,
+                                        alias,
+                                        DDim({2, 3, 9, 10}),
+                                        pooling_type,
+                                        {3, 3},
+                                        {2, 2},
+                                        {1, 1},
+                                        exclusive,
+                                        global_pooling));
+          arena::Arena arena(
+              std::move(tester), place, Int8AbsError(alias, 1e-5));
+          EXPECT_TRUE(arena.TestPrecision());
+        }
+      }
+    }
+  }
+#endif
+}
+
+TEST(ConcatInt8, precision) {
+#ifdef LITE_WITH_X86
+  Place place(TARGET(kX86), PRECISION(kInt8));
+  for (std::string alias : {"int8_out", "fp32_out"}) {
+    for (int axis : {0, 1, 3}) {
+      std::vector<DDim> x_dims(3, DDim({2, 3, 4, 5}));
+      for (size_t i = 0; i < x_dims.size(); i++) {
+        x_dims[i][axis] = i + 1;
+      }
+      std::unique_ptr<arena::TestCase> tester(new ConcatInt8ComputeTester(
+          place, alias, x_dims, {0.01f, 0.03f, 0.02f}, axis));
+      arena::Arena arena(std::move(tester), place, Int8AbsError(alias, 1e-5));
+      EXPECT_TRUE(arena.TestPrecision());
+    }
+  }
+#endif
+}
+
+TEST(ActivationInt8, precision) {
+#ifdef LITE_WITH_X86
+  Place place(TARGET(kX86), PRECISION(kInt8));
+  const std::vector<std::pair<std::string, float>> acts{
+      {"relu", 0.05f},
+      {"relu6", 0.05f},
+      {"leaky_relu", 0.05f},
+      {"hard_swish", 0.05f},
+      {"sigmoid", 1.f / 127},
+      {"tanh", 1.f / 127}};
+  for (std::string alias : {"int8_out", "fp32_out"}) {
+    for (auto& act : acts) {
+      std::unique_ptr<arena::TestCase> tester(new ActivationInt8ComputeTester(
+          place, alias, act.first, act.second));
+      arena::Arena arena(std::move(tester), place, Int8AbsError(alias, 1e-5));
+      EXPECT_TRUE(arena.TestPrecision());
+    }
+  }
+#endif
+}
+
+TEST(TransposeInt8, precision) {
+#ifdef LITE_WITH_X86
+  Place place(TARGET(kX86), PRECISION(kInt8));
+  for (std::string alias : {"int8_out", "fp32_out"}) {
+    for (std::string op_type : {"transpose", "transpose2"}) {
+      // The same scales copy the int8 data, the others requantize it.
+      for (float out_scale : {0.02f, 0.05f}) {
+        std::unique_ptr<arena::TestCase> tester(
+            new TransposeInt8ComputeTester(place,
+                                           alias,
+                                           op_type,
+                                           DDim({2, 3, 4, 5}),
+                                           {0, 2, 3, 1},
+                                           out_scale));
+        arena::Arena arena(std::move(tester), place, Int8AbsError(alias, 1e-5));
+        EXPECT_TRUE(arena.TestPrecision({"xshape"}));
+      }
+    }
+  }
+#endif
+}
+
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,251 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gflags/gflags.h>
+#include <gtest/gtest.h>
+#include <string.h>
+#include <cmath>
+#include <vector>
+#include "lite/backends/host/math/embedding.h"
+#include "lite/core/context.h"
+#include "lite/core/profile/timer.h"
+#include "lite/core/tensor.h"
+#include "lite/tests/utils/fill_data.h"
+#include "lite/tests/utils/tensor_utils.h"
+
+typedef paddle::lite::Tensor Tensor;
+using paddle::lite::profile::Timer;
+using paddle::lite::host::math::EmbeddingPoolType;
+
+DEFINE_int32(power_mode,
+             3,
+             "power mode: "
+             "0 for POWER_HIGH;"
+             "1 for POWER_LOW;"
+             "2 for POWER_FULL;"
+             "3 for NO_BIND");
+DEFINE_int32(threads, 1, "threads num");
+DEFINE_int32(warmup, 0, "warmup times");
+DEFINE_int32(repeats, 1, "repeats times");
+DEFINE_bool(basic_test, true, "do all tests");
+DEFINE_bool(check_result, true, "check the result");
+
+DEFINE_int32(rows, 100000, "embedding: the rows of the table");
+DEFINE_int32(emb_width, 64, "embedding: the width of the rows");
+DEFINE_int32(batch, 256, "embedding: the number of the sequences");
+DEFINE_int32(seq_len, 20, "embedding: the length of the sequences");
+DEFINE_int32(pool_type, 0, "embedding: 0 for SUM, 1 for AVERAGE, 2 for SQRT");
+DEFINE_bool(dequant, false, "embedding: the table of lookup_table_dequant");
+
+// The lookup of all of the ids, then the sequence_pool of its output.
+void basic_embedding_seq_pool(const float* w,
+                              int64_t width,
+                              bool dequant,
+                              const int64_t* ids,
+                              const std::vector<uint64_t>& lod,
+                              EmbeddingPoolType pool_type,
+                              float* out) {
+  int64_t stride = dequant ? width / 4 + 2 : width;
+  std::vector<float> rows(lod.back() * width);
+  for (uint64_t i = 0; i < lod.back(); ++i) {
+    const float* row = w + ids[i] * stride;
+    float* dst = rows.data() + i * width;
+    if (!dequant) {
+      memcpy(dst, row, width * sizeof(float));
+      continue;
+    }
+    float scale = (row[1] - row[0]) / 256;
+    const uint8_t* codes = reinterpret_cast<const uint8_t*>(row + 2);
+    for (int64_t k = 0; k < width; ++k) {
+      dst[k] = scale * static_cast<int>(codes[k]) + row[0];
+    }
+  }
+  for (size_t s = 0; s + 1 < lod.size(); ++s) {
+    int64_t height = lod[s + 1] - lod[s];
+    float* dst = out + s * width;
+    memset(dst, 0, width * sizeof(float));
+    for (int64_t h = 0; h < height; ++h) {
+      for (int64_t k = 0; k < width; ++k) {
+        dst[k] += rows[(lod[s] + h) * width + k];
+      }
+    }
+    float div = pool_type == EmbeddingPoolType::kAverage
+                    ? static_cast<float>(height)
+                    : pool_type == EmbeddingPoolType::kSqrt ? sqrtf(height)
+                                                            : 1.f;
+    if (height > 0) {
+      for (int64_t k = 0; k < width; ++k) {
+        dst[k] /= div;
+      }
+    }
+  }
+}
+
+bool test_embedding_seq_pool(int rows,
+                             int width,
+                             int batch,
+                             int seq_len,
+                             int pool_type,
+                             bool dequant,
+                             int cls,
+                             int ths) {
+  // The rows of lookup_table_dequant are the min and the max followed by the
+  // uint8 codes, whose width is a multiple of 4.
+  width = dequant ? (width + 3) / 4 * 4 : width;
+  int stride = dequant ? width / 4 + 2 : width;
+  Tensor tw;
+  Tensor tout;
+  Tensor tout_basic;
+  tw.Resize({rows, stride});
+  tout.Resize({batch, width});
+  tout_basic.Resize({batch, width});
+  tw.set_precision(PRECISION(kFloat));
+  tout.set_precision(PRECISION(kFloat));
+  tout_basic.set_precision(PRECISION(kFloat));
+  fill_tensor_rand(tw, -1.f, 1.f);
+  auto* w = tw.mutable_data<float>();
+  if (dequant) {
+    for (int r = 0; r < rows; ++r) {
+      w[r * stride] = -1.f;
+      w[r * stride + 1] = 1.f;
+    }
+  }
+
+  // The lengths are in [1, 2 * seq_len), the ids are skewed to the hot rows
+  // as the ones of the recommendation models are.
+  std::vector<uint64_t> lod(batch + 1, 0);
+  std::vector<float> rand(2 * batch + 2 * batch * seq_len);
+  fill_data_rand(rand.data(), 0.f, 1.f, rand.size());
+  for (int s = 0; s < batch; ++s) {
+    lod[s + 1] = lod[s] + 1 + static_cast<int>(rand[s] * (2 * seq_len - 1));
+  }
+  std::vector<int64_t> ids(lod.back());
+  for (size_t i = 0; i < ids.size(); ++i) {
+    float r = rand[batch + i];
+    ids[i] = std::min(rows - 1, static_cast<int>(r * r * r * rows));
+  }
+
+  auto type = static_cast<EmbeddingPoolType>(pool_type);
+  auto* dout = tout.mutable_data<float>();
+  if (FLAGS_check_result) {
+    basic_embedding_seq_pool(w,
+                             width,
+                             dequant,
+                             ids.data(),
+                             lod,
+                             type,
+                             tout_basic.mutable_data<float>());
+  }
+#ifdef LITE_WITH_ARM
+  std::unique_ptr<paddle::lite::KernelContext> ctx1(
+      new paddle::lite::KernelContext);
+  auto& ctx = ctx1->As<paddle::lite::ARMContext>();
+  ctx.SetRunMode(static_cast<paddle::lite_api::PowerMode>(cls), ths);
+#endif
+  paddle::lite::host::math::EmbeddingTable table;
+  table.data = w;
+  table.rows = rows;
+  table.width = width;
+  table.format = dequant
+                     ? paddle::lite::host::math::EmbeddingFormat::kUInt8MinMax
+                     : paddle::lite::host::math::EmbeddingFormat::kFloat;
+  paddle::lite::host::math::EmbeddingScratch scratch;
+  auto run = [&]() {
+    paddle::lite::host::math::embedding_seq_pool(table,
+                                                 ids.data(),
+                                                 lod.data(),
+                                                 batch,
+                                                 1,
+                                                 -1,
+                                                 type,
+                                                 0.f,
+                                                 dout,
+                                                 &scratch);
+  };
+  Timer t0;
+  for (int j = 0; j < FLAGS_warmup; ++j) {
+    run();
+  }
+  for (int i = 0; i < FLAGS_repeats; ++i) {
+    t0.Start();
+    run();
+    t0.Stop();
+  }
+  LOG(INFO) << "rows: " << rows << ", width: " << width
+            << ", batch: " << batch << ", seq_len: " << seq_len
+            << ", pool_type: " << pool_type << ", dequant: " << dequant
+            << ", power_mode: " << cls << ", threads: " << ths
+            << ", avg time: " << t0.LapTimes().Avg()
+            << " ms, min time: " << t0.LapTimes().Min() << " ms";
+
+  if (FLAGS_check_result) {
+    double max_ratio = 0;
+    double max_diff = 0;
+    tensor_cmp_host(tout_basic, tout, max_ratio, max_diff);
+    LOG(INFO) << "compare result, max diff: " << max_diff
+              << ", max ratio: " << max_ratio;
+    if (std::abs(max_ratio) > 1e-4f && std::abs(max_diff) > 5e-5f) {
+      return false;
+    }
+  }
+  return true;
+}
+
+TEST(TestEmbeddingSeqPool, test_func_embedding_seq_pool) {
+  if (FLAGS_basic_test) {
+#ifdef LITE_WITH_ARM
+    paddle::lite::DeviceInfo::Init();
+#endif
+    LOG(INFO) << "run basic embedding_seq_pool test";
+    for (auto& width : {1, 9, 64}) {
+      for (auto& batch : {1, 33, 256}) {
+        for (auto& pool_type : {0, 1, 2}) {
+          for (auto& dequant : {false, true}) {
+            for (auto& th : {1, 2, 4}) {
+              auto flag = test_embedding_seq_pool(
+                  1000, width, batch, 8, pool_type, dequant, 3, th);
+              if (!flag) {
+                LOG(FATAL) << "test width = " << width
+                           << ", batch = " << batch
+                           << ", pool_type = " << pool_type
+                           << ", dequant = " << dequant
+                           << ", threads = " << th << " failed\n";
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+TEST(TestEmbeddingSeqPoolCustom, test_func_embedding_seq_pool_custom) {
+#ifdef LITE_WITH_ARM
+  paddle::lite::DeviceInfo::Init();
+#endif
+  auto flag = test_embedding_seq_pool(FLAGS_rows,
+                                      FLAGS_emb_width,
+                                      FLAGS_batch,
+                                      FLAGS_seq_len,
+                                      FLAGS_pool_type,
+                                      FLAGS_dequant,
+                                      FLAGS_power_mode,
+                                      FLAGS_threads);
+  if (!flag) {
+    LOG(FATAL) << "test rows = " << FLAGS_rows
+               << ", width = " << FLAGS_emb_width << " failed!!";
+  }
+  LOG(INFO) << "test rows = " << FLAGS_rows << ", width = " << FLAGS_emb_width
+            << " passed!!";
+}
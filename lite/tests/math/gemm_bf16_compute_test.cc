@@ -0,0 +1,215 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gflags/gflags.h>
+#include <gtest/gtest.h>
+#include <algorithm>
+#include "lite/tests/utils/fill_data.h"
+#include "lite/tests/utils/naive_math_impl.h"
+#ifdef LITE_WITH_ARM
+#include "lite/backends/arm/math/funcs.h"
+#endif  // LITE_WITH_ARM
+#ifdef LITE_WITH_X86
+#include "lite/backends/x86/math/gemm_bf16.h"
+#endif  // LITE_WITH_X86
+#include "lite/core/context.h"
+#include "lite/core/profile/timer.h"
+#include "lite/core/tensor.h"
+#include "lite/tests/utils/tensor_utils.h"
+#include "lite/utils/bfloat16.h"
+
+typedef paddle::lite::Tensor Tensor;
+typedef paddle::lite::bfloat16 bfloat16;
+using paddle::lite::profile::Timer;
+
+DEFINE_int32(power_mode,
+             3,
+             "power mode: "
+             "0 for POWER_HIGH;"
+             "1 for POWER_LOW;"
+             "2 for POWER_FULL;"
+             "3 for NO_BIND");
+DEFINE_int32(threads, 1, "threads num");
+DEFINE_int32(warmup, 0, "warmup times");
+DEFINE_int32(repeats, 1, "repeats times");
+DEFINE_bool(basic_test, true, "do all tests");
+DEFINE_bool(check_result, true, "check the result");
+
+// The fc of BERT-base, [128x768]x[768x3072].
+DEFINE_int32(M, 128, "gemm: M");
+DEFINE_int32(N, 3072, "gemm: N");
+DEFINE_int32(K, 768, "gemm: K");
+
+DEFINE_bool(flag_bias, true, "with bias");
+DEFINE_bool(flag_relu, false, "do relu");
+
+bool test_gemm_bf16(
+    int m, int n, int k, bool has_bias, bool has_relu, int cls, int ths) {
+  Tensor ta;
+  Tensor tb;
+  Tensor tb_round;
+  Tensor tbias;
+  Tensor tc;
+  Tensor tc_basic;
+  Tensor tb_packed;
+  ta.Resize({m, k});
+  tb.Resize({k, n});
+  tb_round.Resize({k, n});
+  tbias.Resize({n});
+  tc.Resize({m, n});
+  tc_basic.Resize({m, n});
+  ta.set_precision(PRECISION(kFloat));
+  tb.set_precision(PRECISION(kFloat));
+  tb_round.set_precision(PRECISION(kFloat));
+  tbias.set_precision(PRECISION(kFloat));
+  tc.set_precision(PRECISION(kFloat));
+  tc_basic.set_precision(PRECISION(kFloat));
+
+  fill_tensor_rand(ta, -1.f, 1.f);
+  fill_tensor_rand(tb, -1.f, 1.f);
+  fill_tensor_rand(tbias, -1.f, 1.f);
+
+  auto da = ta.data<float>();
+  auto db = tb.data<float>();
+  auto db_round = tb_round.mutable_data<float>();
+  auto dbias = has_bias ? tbias.data<float>() : nullptr;
+  auto dc = tc.mutable_data<float>();
+  auto dc_basic = tc_basic.mutable_data<float>();
+  // the reference is computed with the weights rounded to bf16
+  for (int i = 0; i < tb.numel(); ++i) {
+    db_round[i] = static_cast<float>(bfloat16(db[i]));
+  }
+
+  VLOG(4) << "gemm_bf16 M: " << m << ", N: " << n << ", K: " << k
+          << ", bias: " << (has_bias ? "true" : "false")
+          << ", relu: " << (has_relu ? "true" : "false");
+  if (FLAGS_check_result) {
+    basic_gemm(false,
+               false,
+               m,
+               n,
+               k,
+               1.f,
+               da,
+               k,
+               db_round,
+               n,
+               0.f,
+               dc_basic,
+               n,
+               static_cast<float*>(nullptr));
+    for (int i = 0; i < m; ++i) {
+      for (int j = 0; j < n; ++j) {
+        float v = dc_basic[i * n + j] + (has_bias ? dbias[j] : 0.f);
+        dc_basic[i * n + j] = has_relu ? std::max(v, 0.f) : v;
+      }
+    }
+  }
+  Timer t0;
+  double ops = 2.0 * m * n * k;
+#ifdef LITE_WITH_ARM
+  namespace math = paddle::lite::arm::math;
+  std::unique_ptr<paddle::lite::KernelContext> ctx1(
+      new paddle::lite::KernelContext);
+  auto& ctx = ctx1->As<paddle::lite::ARMContext>();
+  ctx.SetRunMode(static_cast<paddle::lite_api::PowerMode>(cls), ths);
+  auto run = [&](const bfloat16* packed) {
+    math::gemm_bf16(m, n, k, da, k, packed, dc, n, dbias, has_relu, &ctx);
+  };
+#else
+  namespace math = paddle::lite::x86::math;
+  auto run = [&](const bfloat16* packed) {
+    math::gemm_bf16(m, n, k, da, k, packed, dc, n, dbias, has_relu);
+  };
+#endif
+  tb_packed.Resize({math::gemm_bf16_packb_size(k, n)});
+  auto* packed = tb_packed.mutable_data<bfloat16>();
+  math::gemm_bf16_packb(k, n, db, n, packed);
+  for (int j = 0; j < FLAGS_warmup; ++j) {
+    run(packed);
+  }
+  for (int i = 0; i < FLAGS_repeats; ++i) {
+    t0.Start();
+    run(packed);
+    t0.Stop();
+  }
+  LOG(INFO) << "M: " << m << ", N: " << n << ", K: " << k
+            << ", power_mode: " << cls << ", threads: " << ths
+            << ", GOPS: " << ops * 1e-9f
+            << " GOPS, avg time: " << t0.LapTimes().Avg()
+            << " ms, min time: " << t0.LapTimes().Min()
+            << " ms, mean GOPs: " << ops * 1e-6f / t0.LapTimes().Avg()
+            << " GOPs, max GOPs: " << ops * 1e-6f / t0.LapTimes().Min()
+            << " GOPs";
+
+  if (FLAGS_check_result) {
+    // A is also rounded to bf16 by the native bf16 instructions
+    double max_ratio = 0;
+    double max_diff = 0;
+    tensor_cmp_host(tc_basic, tc, max_ratio, max_diff);
+    LOG(INFO) << "compare result, max diff: " << max_diff
+              << ", max ratio: " << max_ratio;
+    if (std::abs(max_ratio) > 1e-2f && std::abs(max_diff) > 5e-2f) {
+      return false;
+    }
+  }
+  return true;
+}
+
+TEST(TestGemmBF16, test_func_gemm_bf16) {
+  if (FLAGS_basic_test) {
+#ifdef LITE_WITH_ARM
+    paddle::lite::DeviceInfo::Init();
+#endif
+    LOG(INFO) << "run basic gemm_bf16 test";
+    for (auto& m : {1, 3, 8, 32}) {
+      for (auto& n : {1, 15, 16, 33, 128}) {
+        for (auto& k : {1, 2, 9, 64}) {
+          for (auto& has_bias : {false, true}) {
+            for (auto& has_relu : {false, true}) {
+              for (auto& th : {1, 2, 4}) {
+                auto flag = test_gemm_bf16(
+                    m, n, k, has_bias, has_relu, FLAGS_power_mode, th);
+                if (!flag) {
+                  LOG(FATAL) << "test m = " << m << ", n = " << n
+                             << ", k = " << k << ", bias: " << has_bias
+                             << ", relu: " << has_relu << " failed\n";
+                }
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+TEST(TestGemmBF16Custom, test_func_gemm_bf16_custom) {
+#ifdef LITE_WITH_ARM
+  paddle::lite::DeviceInfo::Init();
+#endif
+  auto flag = test_gemm_bf16(FLAGS_M,
+                             FLAGS_N,
+                             FLAGS_K,
+                             FLAGS_flag_bias,
+                             FLAGS_flag_relu,
+                             FLAGS_power_mode,
+                             FLAGS_threads);
+  if (!flag) {
+    LOG(FATAL) << "test m = " << FLAGS_M << ", n = " << FLAGS_N
+               << ", k = " << FLAGS_K << " failed!!";
+  }
+  LOG(INFO) << "test m = " << FLAGS_M << ", n = " << FLAGS_N
+            << ", k = " << FLAGS_K << " passed!!";
+}
@@ -392,6 +392,55 @@ TEST(TestLiteGemmInt8, gemm_prepacked_int8) {
   }
 }
 
+#if defined(__aarch64__) && defined(WITH_ARM_I8MM)
+// The smmla kernel is dispatched by gemm_prepack_int8 on the cpus with i8mm,
+// the shapes cover the tails of its 8 columns panels and of the k groups.
+// WITH_ARM_I8MM is off by default, and the i8mm cpus are rare, so the test is
+// skipped on the other cpus. It runs on the x86 hosts with a build of
+//   -DWITH_ARM_I8MM=ON -DARM_TARGET_ARCH_ABI=armv8
+// and the user mode qemu, whose max cpu reports i8mm in the hwcaps:
+//   qemu-aarch64 -cpu max -L <sysroot> ./gemm_int8_compute_test
+//       --gtest_filter=*i8mm*
+TEST(TestLiteGemmInt8, gemm_prepacked_int8_i8mm) {
+  paddle::lite::DeviceInfo::Init();
+  if (!paddle::lite::DeviceInfo::Global().has_i8mm()) {
+    LOG(INFO) << "the cpu has no i8mm, gemm_prepacked_int8_i8mm is skipped";
+    return;
+  }
+  for (auto& m : {1, 7, 8, 9, 33}) {
+    for (auto& n : {1, 7, 8, 9, 15, 16, 17, 141}) {
+      for (auto& k : {1, 4, 7, 8, 9, 12, 16, 67}) {
+        for (auto& trb : {false, true}) {
+          for (auto& has_bias : {false, true}) {
+            for (auto& relu_type : {0, 1}) {
+              for (auto& th : {1, 2}) {
+                auto flag = test_gemm_int8(false,
+                                           trb,
+                                           m,
+                                           n,
+                                           k,
+                                           has_bias,
+                                           relu_type,
+                                           FLAGS_power_mode,
+                                           th);
+                if (!flag) {
+                  LOG(FATAL) << "test i8mm m = " << m << ", n=" << n
+                             << ", k=" << k
+                             << ", bias: " << (has_bias ? "true" : "false")
+                             << ", relu: " << relu_type
+                             << ", trans B: " << (trb ? "true" : "false")
+                             << " failed\n";
+                }
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+}
+#endif
+
 TEST(TestGemmInt8Custom, gemm_prepacked_int8_custom) {
 #ifdef LITE_WITH_ARM
   paddle::lite::DeviceInfo::Init();
@@ -0,0 +1,281 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gflags/gflags.h>
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <type_traits>
+#include <vector>
+#include "lite/backends/host/math/reduce.h"
+#include "lite/core/context.h"
+#include "lite/core/profile/timer.h"
+
+using paddle::lite::profile::Timer;
+using paddle::lite::host::math::ReducePass;
+using paddle::lite::host::math::ReduceType;
+
+DEFINE_int32(power_mode,
+             3,
+             "power mode: "
+             "0 for POWER_HIGH;"
+             "1 for POWER_LOW;"
+             "2 for POWER_FULL;"
+             "3 for NO_BIND");
+DEFINE_int32(threads, 1, "threads num");
+DEFINE_int32(warmup, 0, "warmup times");
+DEFINE_int32(repeats, 1, "repeats times");
+DEFINE_bool(basic_test, true, "do all tests");
+DEFINE_bool(check_result, true, "check the result");
+
+// The logits of a classifier with a vocabulary of 32000 words.
+DEFINE_int32(n, 8, "reduce: n of the input");
+DEFINE_int32(c, 1, "reduce: c of the input");
+DEFINE_int32(h, 1, "reduce: h of the input");
+DEFINE_int32(w, 32000, "reduce: w of the input");
+DEFINE_int32(axis, 3, "reduce: the reduced axis, -5 for all of them");
+DEFINE_int32(reduce_type,
+             0,
+             "reduce: 0 for SUM, 1 for MEAN, 2 for MAX, 3 for MIN, 4 for PROD");
+
+// Reduces each of the values into its output index, in double for floats.
+template <typename T>
+void basic_reduce(const T* x,
+                  T* out,
+                  const std::vector<int64_t>& dims,
+                  const std::vector<bool>& reduced,
+                  ReduceType type) {
+  typedef typename std::conditional<std::is_integral<T>::value,
+                                    int64_t,
+                                    double>::type Acc;
+  int rank = dims.size();
+  int64_t size = 1;
+  int64_t out_size = 1;
+  int64_t count = 1;
+  for (int i = 0; i < rank; ++i) {
+    size *= dims[i];
+    out_size *= reduced[i] ? 1 : dims[i];
+    count *= reduced[i] ? dims[i] : 1;
+  }
+  std::vector<Acc> acc(out_size);
+  std::vector<bool> first(out_size, true);
+  for (int64_t i = 0; i < size; ++i) {
+    int64_t rest = i;
+    int64_t o = 0;
+    int64_t o_stride = 1;
+    for (int d = rank - 1; d >= 0; --d) {
+      int64_t idx = rest % dims[d];
+      rest /= dims[d];
+      if (!reduced[d]) {
+        o += idx * o_stride;
+        o_stride *= dims[d];
+      }
+    }
+    Acc v = static_cast<Acc>(x[i]);
+    if (first[o]) {
+      acc[o] = v;
+      first[o] = false;
+      continue;
+    }
+    switch (type) {
+      case ReduceType::kSum:
+      case ReduceType::kMean:
+        acc[o] += v;
+        break;
+      case ReduceType::kMax:
+        acc[o] = std::max(acc[o], v);
+        break;
+      case ReduceType::kMin:
+        acc[o] = std::min(acc[o], v);
+        break;
+      case ReduceType::kProd:
+        acc[o] *= v;
+        break;
+    }
+  }
+  for (int64_t o = 0; o < out_size; ++o) {
+    if (type == ReduceType::kMean) {
+      acc[o] /= count;
+    }
+    out[o] = static_cast<T>(acc[o]);
+  }
+}
+
+template <typename T>
+bool test_reduce(const std::vector<int64_t>& dims,
+                 const std::vector<int>& axes,
+                 ReduceType type,
+                 int cls,
+                 int ths) {
+  int rank = dims.size();
+  std::vector<bool> reduced(rank, axes.empty());
+  for (int axis : axes) {
+    reduced[axis < 0 ? axis + rank : axis] = true;
+  }
+  int64_t size = 1;
+  int64_t out_size = 1;
+  for (int i = 0; i < rank; ++i) {
+    size *= dims[i];
+    out_size *= reduced[i] ? 1 : dims[i];
+  }
+  // The values of prod are near to 1, so the long products are finite, and
+  // the ones of the ints are -1, 0 and 1, so they don't overflow.
+  std::mt19937 gen(size);
+  std::uniform_real_distribution<float> dis(-1.f, 1.f);
+  std::vector<T> x(size);
+  for (auto& v : x) {
+    float r = dis(gen);
+    if (std::is_integral<T>::value) {
+      v = static_cast<T>(type == ReduceType::kProd ? std::round(r) : r * 100);
+    } else {
+      v = static_cast<T>(type == ReduceType::kProd ? 1.f + r * 0.01f : r);
+    }
+  }
+  std::vector<T> out(out_size);
+  std::vector<T> out_basic(out_size);
+  if (FLAGS_check_result) {
+    basic_reduce(x.data(), out_basic.data(), dims, reduced, type);
+  }
+#ifdef LITE_WITH_ARM
+  std::unique_ptr<paddle::lite::KernelContext> ctx1(
+      new paddle::lite::KernelContext);
+  auto& ctx = ctx1->As<paddle::lite::ARMContext>();
+  ctx.SetRunMode(static_cast<paddle::lite_api::PowerMode>(cls), ths);
+#endif
+  auto run = [&]() {
+    paddle::lite::host::math::reduce(
+        x.data(), out.data(), dims, axes, false, type);
+  };
+  Timer t0;
+  for (int j = 0; j < FLAGS_warmup; ++j) {
+    run();
+  }
+  for (int i = 0; i < FLAGS_repeats; ++i) {
+    t0.Start();
+    run();
+    t0.Stop();
+  }
+  LOG(INFO) << "size: " << size << ", out size: " << out_size
+            << ", reduce type: " << static_cast<int>(type)
+            << ", power_mode: " << cls << ", threads: " << ths
+            << ", avg time: " << t0.LapTimes().Avg()
+            << " ms, min time: " << t0.LapTimes().Min() << " ms";
+
+  if (FLAGS_check_result) {
+    double max_diff = 0;
+    for (int64_t i = 0; i < out_size; ++i) {
+      double ref = static_cast<double>(out_basic[i]);
+      double diff = std::abs(static_cast<double>(out[i]) - ref);
+      max_diff = std::max(max_diff, diff / std::max(1.0, std::abs(ref)));
+    }
+    LOG(INFO) << "compare result, max relative diff: " << max_diff;
+    if (max_diff > 1e-4) {
+      return false;
+    }
+  }
+  return true;
+}
+
+TEST(TestReducePlan, test_func_reduce_plan) {
+  auto check = [](const std::vector<int64_t>& dims,
+                  const std::vector<int>& axes,
+                  const std::vector<ReducePass>& expected) {
+    auto passes = paddle::lite::host::math::reduce_plan(dims, axes, false);
+    ASSERT_EQ(passes.size(), expected.size());
+    for (size_t i = 0; i < passes.size(); ++i) {
+      EXPECT_EQ(passes[i].outer, expected[i].outer);
+      EXPECT_EQ(passes[i].reduce, expected[i].reduce);
+      EXPECT_EQ(passes[i].inner, expected[i].inner);
+    }
+  };
+  check({2, 3, 4, 5}, {2, 3}, {{6, 20, 1}});
+  check({2, 3, 4, 5}, {0, 2}, {{6, 4, 5}, {1, 2, 15}});
+  check({2, 3, 4, 5}, {-3, -1}, {{24, 5, 1}, {2, 3, 4}});
+  check({2, 3, 4, 5}, {}, {{1, 120, 1}});
+  // The dims of size 1 are dropped, whether they are reduced or not.
+  check({1, 3, 1, 5}, {0, 1}, {{1, 3, 5}});
+  check({2, 1, 1}, {1}, {});
+}
+
+TEST(TestReduce, test_func_reduce) {
+  if (FLAGS_basic_test) {
+#ifdef LITE_WITH_ARM
+    paddle::lite::DeviceInfo::Init();
+#endif
+    LOG(INFO) << "run basic reduce test";
+    const std::vector<std::vector<int>> axes_4d = {{0},
+                                                   {1},
+                                                   {2},
+                                                   {3},
+                                                   {-1},
+                                                   {0, 1},
+                                                   {1, 2},
+                                                   {2, 3},
+                                                   {0, 2},
+                                                   {1, 3},
+                                                   {0, 3},
+                                                   {0, 1, 3},
+                                                   {}};
+    for (auto type : {ReduceType::kSum,
+                      ReduceType::kMean,
+                      ReduceType::kMax,
+                      ReduceType::kMin,
+                      ReduceType::kProd}) {
+      for (auto& th : {1, 2, 4}) {
+        bool flag = true;
+        for (auto& axes : axes_4d) {
+          flag = flag && test_reduce<float>({2, 3, 17, 35}, axes, type, 3, th);
+          flag = flag && test_reduce<int32_t>({2, 3, 4, 5}, axes, type, 3, th);
+          flag = flag && test_reduce<int64_t>({3, 1, 9, 2}, axes, type, 3, th);
+        }
+        flag = flag &&
+               test_reduce<float>({2, 1, 3, 4, 5}, {0, 2, 4}, type, 3, th);
+        flag = flag && test_reduce<float>({7}, {0}, type, 3, th);
+        // The long rows and columns which are split into chunks.
+        flag = flag && test_reduce<float>({2, 100003}, {1}, type, 3, th);
+        flag = flag && test_reduce<float>({100003, 3}, {0}, type, 3, th);
+        flag = flag && test_reduce<float>({50001, 70}, {-2}, type, 3, th);
+        flag = flag && test_reduce<int32_t>({3, 40001}, {1}, type, 3, th);
+        flag = flag && test_reduce<int64_t>({3, 20001, 5}, {1}, type, 3, th);
+        if (!flag) {
+          LOG(FATAL) << "test reduce type = " << static_cast<int>(type)
+                     << ", threads = " << th << " failed\n";
+        }
+      }
+    }
+  }
+}
+
+TEST(TestReduceCustom, test_func_reduce_custom) {
+#ifdef LITE_WITH_ARM
+  paddle::lite::DeviceInfo::Init();
+#endif
+  std::vector<int> axes;
+  if (FLAGS_axis != -5) {
+    axes.push_back(FLAGS_axis);
+  }
+  auto flag =
+      test_reduce<float>({FLAGS_n, FLAGS_c, FLAGS_h, FLAGS_w},
+                         axes,
+                         static_cast<ReduceType>(FLAGS_reduce_type),
+                         FLAGS_power_mode,
+                         FLAGS_threads);
+  if (!flag) {
+    LOG(FATAL) << "test reduce type = " << FLAGS_reduce_type
+               << ", axis = " << FLAGS_axis << " failed!!";
+  }
+  LOG(INFO) << "test reduce type = " << FLAGS_reduce_type
+            << ", axis = " << FLAGS_axis << " passed!!";
+}
@@ -0,0 +1,270 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gflags/gflags.h>
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include "lite/backends/host/math/roi_align.h"
+#include "lite/core/context.h"
+#include "lite/core/profile/timer.h"
+#include "lite/core/tensor.h"
+#include "lite/tests/utils/fill_data.h"
+#include "lite/tests/utils/tensor_utils.h"
+
+typedef paddle::lite::Tensor Tensor;
+using paddle::lite::profile::Timer;
+
+DEFINE_int32(power_mode,
+             3,
+             "power mode: "
+             "0 for POWER_HIGH;"
+             "1 for POWER_LOW;"
+             "2 for POWER_FULL;"
+             "3 for NO_BIND");
+DEFINE_int32(threads, 1, "threads num");
+DEFINE_int32(warmup, 0, "warmup times");
+DEFINE_int32(repeats, 1, "repeats times");
+DEFINE_bool(basic_test, true, "do all tests");
+DEFINE_bool(check_result, true, "check the result");
+
+// The box head of Faster R-CNN R50-C4 on a 800x1088 image.
+DEFINE_int32(rois, 1000, "roi_align: the number of the proposals");
+DEFINE_int32(channels, 256, "roi_align: channels");
+DEFINE_int32(height, 50, "roi_align: height of the feature map");
+DEFINE_int32(width, 68, "roi_align: width of the feature map");
+DEFINE_int32(pooled, 7, "roi_align: pooled height and width");
+DEFINE_int32(sampling_ratio, 2, "roi_align: sampling ratio");
+
+// The bilinear interpolation of each sample point, without the weights
+// computed in advance.
+float basic_bilinear(
+    const float* data, int height, int width, float y, float x) {
+  if (y < -1.0 || y > height || x < -1.0 || x > width) {
+    return 0.f;
+  }
+  y = y <= 0 ? 0 : y;
+  x = x <= 0 ? 0 : x;
+  int y_low = static_cast<int>(y);
+  int x_low = static_cast<int>(x);
+  int y_high = y_low + 1;
+  int x_high = x_low + 1;
+  if (y_low >= height - 1) {
+    y_high = y_low = height - 1;
+    y = static_cast<float>(y_low);
+  }
+  if (x_low >= width - 1) {
+    x_high = x_low = width - 1;
+    x = static_cast<float>(x_low);
+  }
+  float ly = y - y_low, lx = x - x_low;
+  float hy = 1.f - ly, hx = 1.f - lx;
+  return hy * hx * data[y_low * width + x_low] +
+         hy * lx * data[y_low * width + x_high] +
+         ly * hx * data[y_high * width + x_low] +
+         ly * lx * data[y_high * width + x_high];
+}
+
+void basic_roi_align(const float* x,
+                     int channels,
+                     int height,
+                     int width,
+                     const float* rois,
+                     const int* roi_batch_id,
+                     int rois_num,
+                     float spatial_scale,
+                     int pooled_height,
+                     int pooled_width,
+                     int sampling_ratio,
+                     float* out) {
+  for (int n = 0; n < rois_num; ++n) {
+    const float* roi = rois + n * 4;
+    float roi_xmin = roi[0] * spatial_scale;
+    float roi_ymin = roi[1] * spatial_scale;
+    float roi_width = std::max(roi[2] * spatial_scale - roi_xmin, 1.f);
+    float roi_height = std::max(roi[3] * spatial_scale - roi_ymin, 1.f);
+    float bin_h = roi_height / pooled_height;
+    float bin_w = roi_width / pooled_width;
+    int grid_h = sampling_ratio > 0 ? sampling_ratio
+                                    : ceil(roi_height / pooled_height);
+    int grid_w =
+        sampling_ratio > 0 ? sampling_ratio : ceil(roi_width / pooled_width);
+    for (int c = 0; c < channels; ++c) {
+      const float* data =
+          x + (roi_batch_id[n] * channels + c) * height * width;
+      for (int ph = 0; ph < pooled_height; ++ph) {
+        for (int pw = 0; pw < pooled_width; ++pw) {
+          float sum = 0.f;
+          for (int iy = 0; iy < grid_h; ++iy) {
+            float y = roi_ymin + ph * bin_h + (iy + .5f) * bin_h / grid_h;
+            for (int ix = 0; ix < grid_w; ++ix) {
+              float xx = roi_xmin + pw * bin_w + (ix + .5f) * bin_w / grid_w;
+              sum += basic_bilinear(data, height, width, y, xx);
+            }
+          }
+          *out++ = sum / (grid_h * grid_w);
+        }
+      }
+    }
+  }
+}
+
+bool test_roi_align(int rois_num,
+                    int channels,
+                    int height,
+                    int width,
+                    int pooled,
+                    int sampling_ratio,
+                    int cls,
+                    int ths) {
+  const int batch = 2;
+  // The proposals are on the input image of 16x the feature map.
+  const float spatial_scale = 1.f / 16;
+  Tensor tx;
+  Tensor trois;
+  Tensor tout;
+  Tensor tout_basic;
+  tx.Resize({batch, channels, height, width});
+  trois.Resize({rois_num, 4});
+  tout.Resize({rois_num, channels, pooled, pooled});
+  tout_basic.Resize({rois_num, channels, pooled, pooled});
+  tx.set_precision(PRECISION(kFloat));
+  tout.set_precision(PRECISION(kFloat));
+  tout_basic.set_precision(PRECISION(kFloat));
+  fill_tensor_rand(tx, -1.f, 1.f);
+
+  std::vector<float> corners(rois_num * 4);
+  fill_data_rand(corners.data(), 0.f, 1.f, rois_num * 4);
+  auto* rois = trois.mutable_data<float>();
+  std::vector<int> roi_batch_id(rois_num);
+  for (int i = 0; i < rois_num; ++i) {
+    float img_h = height / spatial_scale;
+    float img_w = width / spatial_scale;
+    rois[4 * i] = corners[4 * i] * img_w * 0.8f;
+    rois[4 * i + 1] = corners[4 * i + 1] * img_h * 0.8f;
+    rois[4 * i + 2] = rois[4 * i] + corners[4 * i + 2] * img_w * 0.4f;
+    rois[4 * i + 3] = rois[4 * i + 1] + corners[4 * i + 3] * img_h * 0.4f;
+    roi_batch_id[i] = i * batch / std::max(rois_num, 1);
+  }
+
+  const float* dx = tx.data<float>();
+  auto* dout = tout.mutable_data<float>();
+  if (FLAGS_check_result) {
+    basic_roi_align(dx,
+                    channels,
+                    height,
+                    width,
+                    rois,
+                    roi_batch_id.data(),
+                    rois_num,
+                    spatial_scale,
+                    pooled,
+                    pooled,
+                    sampling_ratio,
+                    tout_basic.mutable_data<float>());
+  }
+#ifdef LITE_WITH_ARM
+  std::unique_ptr<paddle::lite::KernelContext> ctx1(
+      new paddle::lite::KernelContext);
+  auto& ctx = ctx1->As<paddle::lite::ARMContext>();
+  ctx.SetRunMode(static_cast<paddle::lite_api::PowerMode>(cls), ths);
+#endif
+  auto run = [&]() {
+    paddle::lite::host::math::roi_align(dx,
+                                        channels,
+                                        height,
+                                        width,
+                                        rois,
+                                        roi_batch_id.data(),
+                                        rois_num,
+                                        spatial_scale,
+                                        pooled,
+                                        pooled,
+                                        sampling_ratio,
+                                        dout);
+  };
+  Timer t0;
+  for (int j = 0; j < FLAGS_warmup; ++j) {
+    run();
+  }
+  for (int i = 0; i < FLAGS_repeats; ++i) {
+    t0.Start();
+    run();
+    t0.Stop();
+  }
+  LOG(INFO) << "rois: " << rois_num << ", channels: " << channels
+            << ", feature map: " << height << "x" << width
+            << ", pooled: " << pooled << ", sampling_ratio: " << sampling_ratio
+            << ", power_mode: " << cls << ", threads: " << ths
+            << ", avg time: " << t0.LapTimes().Avg()
+            << " ms, min time: " << t0.LapTimes().Min() << " ms";
+
+  if (FLAGS_check_result) {
+    double max_ratio = 0;
+    double max_diff = 0;
+    tensor_cmp_host(tout_basic, tout, max_ratio, max_diff);
+    LOG(INFO) << "compare result, max diff: " << max_diff
+              << ", max ratio: " << max_ratio;
+    if (std::abs(max_ratio) > 1e-4f && std::abs(max_diff) > 5e-5f) {
+      return false;
+    }
+  }
+  return true;
+}
+
+TEST(TestRoiAlign, test_func_roi_align) {
+  if (FLAGS_basic_test) {
+#ifdef LITE_WITH_ARM
+    paddle::lite::DeviceInfo::Init();
+#endif
+    LOG(INFO) << "run basic roi_align test";
+    for (auto& rois : {1, 100, 300, 1000}) {
+      for (auto& channels : {1, 7, 256}) {
+        for (auto& sampling_ratio : {-1, 2}) {
+          for (auto& th : {1, 2, 4}) {
+            auto flag = test_roi_align(
+                rois, channels, 50, 68, 7, sampling_ratio, 3, th);
+            if (!flag) {
+              LOG(FATAL) << "test rois = " << rois
+                         << ", channels = " << channels
+                         << ", sampling_ratio = " << sampling_ratio
+                         << ", threads = " << th << " failed\n";
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+TEST(TestRoiAlignCustom, test_func_roi_align_custom) {
+#ifdef LITE_WITH_ARM
+  paddle::lite::DeviceInfo::Init();
+#endif
+  auto flag = test_roi_align(FLAGS_rois,
+                             FLAGS_channels,
+                             FLAGS_height,
+                             FLAGS_width,
+                             FLAGS_pooled,
+                             FLAGS_sampling_ratio,
+                             FLAGS_power_mode,
+                             FLAGS_threads);
+  if (!flag) {
+    LOG(FATAL) << "test rois = " << FLAGS_rois
+               << ", channels = " << FLAGS_channels << " failed!!";
+  }
+  LOG(INFO) << "test rois = " << FLAGS_rois
+            << ", channels = " << FLAGS_channels << " passed!!";
+}
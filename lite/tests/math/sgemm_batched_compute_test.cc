@@ -0,0 +1,265 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gflags/gflags.h>
+#include <gtest/gtest.h>
+#include "lite/tests/utils/fill_data.h"
+#include "lite/tests/utils/naive_math_impl.h"
+#ifdef LITE_WITH_ARM
+#include "lite/backends/arm/math/funcs.h"
+#endif  // LITE_WITH_ARM
+#include "lite/core/context.h"
+#include "lite/core/profile/timer.h"
+#include "lite/core/tensor.h"
+#include "lite/tests/utils/tensor_utils.h"
+
+typedef paddle::lite::Tensor Tensor;
+using paddle::lite::profile::Timer;
+
+DEFINE_int32(power_mode,
+             3,
+             "power mode: "
+             "0 for POWER_HIGH;"
+             "1 for POWER_LOW;"
+             "2 for POWER_FULL;"
+             "3 for NO_BIND");
+DEFINE_int32(threads, 1, "threads num");
+DEFINE_int32(warmup, 0, "warmup times");
+DEFINE_int32(repeats, 1, "repeats times");
+
+#ifdef LITE_WITH_ARM
+DEFINE_bool(basic_test, true, "do all tests");
+#else
+DEFINE_bool(basic_test, false, "do all tests");
+#endif
+
+DEFINE_bool(check_result, true, "check the result");
+
+// The attention scores of BERT-base, 12 heads x [128x64]x[64x128].
+DEFINE_int32(batch, 12, "gemm: batch");
+DEFINE_int32(M, 128, "gemm: M");
+DEFINE_int32(N, 128, "gemm: N");
+DEFINE_int32(K, 64, "gemm: K");
+
+DEFINE_bool(traA, false, "gemm: A transpose");
+DEFINE_bool(traB, true, "gemm: B transpose");
+
+DEFINE_bool(broadcast_a, false, "gemm: A is shared by the batches");
+DEFINE_bool(broadcast_b, false, "gemm: B is shared by the batches");
+
+bool test_sgemm_batched(bool tra,
+                        bool trb,
+                        int batch,
+                        int m,
+                        int n,
+                        int k,
+                        bool broadcast_a,
+                        bool broadcast_b,
+                        float alpha,
+                        float beta,
+                        int cls,
+                        int ths) {
+  int lda = tra ? m : k;
+  int ldb = trb ? k : n;
+  int ldc = n;
+  int64_t stride_a = broadcast_a ? 0 : m * k;
+  int64_t stride_b = broadcast_b ? 0 : k * n;
+  int64_t stride_c = m * n;
+
+  Tensor ta;
+  Tensor tb;
+  Tensor tc;
+  Tensor tc_basic;
+  Tensor tc_backup;
+  ta.Resize({broadcast_a ? 1 : batch, m * k});
+  tb.Resize({broadcast_b ? 1 : batch, k * n});
+  tc.Resize({batch, m * n});
+  tc_basic.Resize({batch, m * n});
+  tc_backup.Resize({batch, m * n});
+  ta.set_precision(PRECISION(kFloat));
+  tb.set_precision(PRECISION(kFloat));
+  tc.set_precision(PRECISION(kFloat));
+  tc_basic.set_precision(PRECISION(kFloat));
+  tc_backup.set_precision(PRECISION(kFloat));
+
+  fill_tensor_rand(ta, -1.f, 1.f);
+  fill_tensor_rand(tb, -1.f, 1.f);
+  fill_tensor_rand(tc, -1.f, 1.f);
+
+  auto da = ta.data<float>();
+  auto db = tb.data<float>();
+  auto dc = tc.mutable_data<float>();
+  auto dc_basic = tc_basic.mutable_data<float>();
+  auto dc_backup = tc_backup.mutable_data<float>();
+  memcpy(dc_basic, dc, sizeof(float) * tc.numel());
+  memcpy(dc_backup, dc, sizeof(float) * tc.numel());
+
+  VLOG(4) << "sgemm_batched batch: " << batch << ", M: " << m << ", N: " << n
+          << ", K: " << k << ", alpha: " << alpha << ", beta: " << beta
+          << ", transA: " << (tra ? "true" : "false")
+          << ", transB: " << (trb ? "true" : "false")
+          << ", broadcast A: " << (broadcast_a ? "true" : "false")
+          << ", broadcast B: " << (broadcast_b ? "true" : "false");
+  if (FLAGS_check_result) {
+    for (int i = 0; i < batch; ++i) {
+      basic_gemm(tra,
+                 trb,
+                 m,
+                 n,
+                 k,
+                 alpha,
+                 da + i * stride_a,
+                 lda,
+                 db + i * stride_b,
+                 ldb,
+                 beta,
+                 dc_basic + i * stride_c,
+                 ldc,
+                 static_cast<float*>(nullptr));
+    }
+  }
+  Timer t0;
+#ifdef LITE_WITH_ARM
+  double ops = 2.0 * batch * m * n * k;
+  std::unique_ptr<paddle::lite::KernelContext> ctx1(
+      new paddle::lite::KernelContext);
+  auto& ctx = ctx1->As<paddle::lite::ARMContext>();
+  ctx.SetRunMode(static_cast<paddle::lite_api::PowerMode>(cls), ths);
+  auto run = [&]() {
+    paddle::lite::arm::math::sgemm_batched(tra,
+                                           trb,
+                                           batch,
+                                           m,
+                                           n,
+                                           k,
+                                           alpha,
+                                           da,
+                                           lda,
+                                           stride_a,
+                                           db,
+                                           ldb,
+                                           stride_b,
+                                           beta,
+                                           dc,
+                                           ldc,
+                                           stride_c,
+                                           &ctx);
+  };
+  for (int j = 0; j < FLAGS_warmup; ++j) {
+    run();
+  }
+  for (int i = 0; i < FLAGS_repeats; ++i) {
+    // C is accumulated with beta, only the last run is checked.
+    memcpy(dc, dc_backup, sizeof(float) * tc.numel());
+    t0.Start();
+    run();
+    t0.Stop();
+  }
+  LOG(INFO) << "batch: " << batch << ", M: " << m << ", N: " << n
+            << ", K: " << k << ", power_mode: " << cls << ", threads: " << ths
+            << ", GOPS: " << ops * 1e-9f
+            << " GOPS, avg time: " << t0.LapTimes().Avg()
+            << " ms, min time: " << t0.LapTimes().Min()
+            << " ms, mean GOPs: " << ops * 1e-6f / t0.LapTimes().Avg()
+            << " GOPs, max GOPs: " << ops * 1e-6f / t0.LapTimes().Min()
+            << " GOPs";
+
+  if (FLAGS_check_result) {
+    double max_ratio = 0;
+    double max_diff = 0;
+    tensor_cmp_host(tc_basic, tc, max_ratio, max_diff);
+    LOG(INFO) << "compare result, max diff: " << max_diff
+              << ", max ratio: " << max_ratio;
+    if (std::abs(max_ratio) > 1e-4f && std::abs(max_diff) > 5e-5f) {
+      return false;
+    }
+  }
+#endif
+  return true;
+}
+
+TEST(TestSgemmBatched, test_func_sgemm_batched) {
+  if (FLAGS_basic_test) {
+#ifdef LITE_WITH_ARM
+    paddle::lite::DeviceInfo::Init();
+#endif
+    LOG(INFO) << "run basic sgemm_batched test";
+    for (auto& batch : {1, 3, 12}) {
+      for (auto& m : {1, 7, 32, 128}) {
+        for (auto& n : {1, 13, 128}) {
+          for (auto& k : {1, 9, 64}) {
+            for (auto& tra : {false, true}) {
+              for (auto& trb : {false, true}) {
+                for (auto& broadcast : {0, 1, 2}) {
+                  for (auto& beta : {0.f, 0.5f}) {
+                    for (auto& th : {1, 2, 4}) {
+                      auto flag = test_sgemm_batched(tra,
+                                                     trb,
+                                                     batch,
+                                                     m,
+                                                     n,
+                                                     k,
+                                                     broadcast == 1,
+                                                     broadcast == 2,
+                                                     0.125f,
+                                                     beta,
+                                                     FLAGS_power_mode,
+                                                     th);
+                      if (!flag) {
+                        LOG(FATAL) << "test batch = " << batch << ", m = " << m
+                                   << ", n = " << n << ", k = " << k
+                                   << ", trans A: " << tra
+                                   << ", trans B: " << trb
+                                   << ", broadcast: " << broadcast
+                                   << ", beta: " << beta << " failed\n";
+                      }
+                    }
+                  }
+                }
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+TEST(TestSgemmBatchedCustom, test_func_sgemm_batched_custom) {
+#ifdef LITE_WITH_ARM
+  paddle::lite::DeviceInfo::Init();
+#endif
+  auto flag = test_sgemm_batched(FLAGS_traA,
+                                 FLAGS_traB,
+                                 FLAGS_batch,
+                                 FLAGS_M,
+                                 FLAGS_N,
+                                 FLAGS_K,
+                                 FLAGS_broadcast_a,
+                                 FLAGS_broadcast_b,
+                                 1.f,
+                                 0.f,
+                                 FLAGS_power_mode,
+                                 FLAGS_threads);
+  if (!flag) {
+    LOG(FATAL) << "test batch = " << FLAGS_batch << ", m = " << FLAGS_M
+               << ", n = " << FLAGS_N << ", k = " << FLAGS_K
+               << ", trans A: " << FLAGS_traA << ", trans B: " << FLAGS_traB
+               << " failed!!";
+  }
+  LOG(INFO) << "test batch = " << FLAGS_batch << ", m = " << FLAGS_M
+            << ", n = " << FLAGS_N << ", k = " << FLAGS_K
+            << ", trans A: " << FLAGS_traA << ", trans B: " << FLAGS_traB
+            << " passed!!";
+}
@@ -0,0 +1,367 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gflags/gflags.h>
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+#include "lite/backends/host/math/sparse_structured_gemm.h"
+#include "lite/core/context.h"
+#include "lite/core/profile/timer.h"
+
+using paddle::lite::profile::Timer;
+using paddle::lite::operators::ActivationParam;
+
+DEFINE_int32(power_mode,
+             3,
+             "power mode: "
+             "0 for POWER_HIGH;"
+             "1 for POWER_LOW;"
+             "2 for POWER_FULL;"
+             "3 for NO_BIND");
+DEFINE_int32(threads, 1, "threads num");
+DEFINE_int32(warmup, 0, "warmup times");
+DEFINE_int32(repeats, 1, "repeats times");
+DEFINE_bool(basic_test, true, "do all tests");
+DEFINE_bool(check_result, true, "check the result");
+
+DEFINE_int32(M, 512, "sparse gemm: rows of the sparse weights");
+DEFINE_int32(K, 512, "sparse gemm: columns of the sparse weights");
+DEFINE_int32(N, 196, "sparse gemm: columns of B or rows of X");
+DEFINE_int32(sparse_format, 1, "sparse gemm: 1 for block, 2 for N:M");
+DEFINE_int32(block_h, 1, "sparse gemm: block height, or n of N:M");
+DEFINE_int32(block_w, 4, "sparse gemm: block width, or m of N:M");
+DEFINE_bool(is_fc, false, "sparse gemm: test the fc rather than the gemm");
+DEFINE_bool(flag_relu, false, "sparse gemm: do relu");
+DEFINE_bool(flag_bias, true, "sparse gemm: with bias");
+
+enum class TestFormat { kBlock = 1, kNM = 2 };
+
+// The packed sparse weights, in the formats of sparse_conv_detect_pass.
+struct SparseWeights {
+  std::vector<float> values;
+  std::vector<uint32_t> row_ptr;
+  std::vector<int32_t> col_idx;
+};
+
+// Generates the dense weights [M, K] whose zeros follow the format: 3 of 4
+// blocks are zero, or the N:M groups keep n values, with some of them zero
+// to test the padding.
+std::vector<float> gen_sparse_weights(
+    TestFormat format, int M, int K, int bh, int bw, std::mt19937* gen) {
+  std::uniform_real_distribution<float> dis(-1.f, 1.f);
+  std::vector<float> w(M * K, 0.f);
+  if (format == TestFormat::kBlock) {
+    for (int br = 0; br < M / bh; br++) {
+      for (int bc = 0; bc < K / bw; bc++) {
+        if ((*gen)() % 4 != 0) continue;
+        for (int i = 0; i < bh; i++) {
+          for (int j = 0; j < bw; j++) {
+            w[(br * bh + i) * K + bc * bw + j] = dis(*gen);
+          }
+        }
+      }
+    }
+  } else {
+    for (int i = 0; i < M; i++) {
+      for (int g = 0; g < K / bw; g++) {
+        int offset = (*gen)() % (bw - bh + 1);
+        for (int t = 0; t < bh; t++) {
+          if ((*gen)() % 8 == 0) continue;
+          w[i * K + g * bw + offset + t] = dis(*gen);
+        }
+      }
+    }
+  }
+  return w;
+}
+
+// Packs the weights as SparseConvDetectPass::ComputeBlockSparseWeight and
+// ComputeNMSparseWeight do.
+SparseWeights pack_sparse_weights(const std::vector<float>& w,
+                                  TestFormat format,
+                                  int M,
+                                  int K,
+                                  int bh,
+                                  int bw) {
+  SparseWeights sw;
+  if (format == TestFormat::kBlock) {
+    sw.row_ptr.push_back(0);
+    for (int br = 0; br < M / bh; br++) {
+      for (int bc = 0; bc < K / bw; bc++) {
+        const float* block = w.data() + br * bh * K + bc * bw;
+        bool nonzero = false;
+        for (int i = 0; i < bh; i++) {
+          for (int j = 0; j < bw; j++) {
+            nonzero = nonzero || block[i * K + j] != 0.f;
+          }
+        }
+        if (!nonzero) continue;
+        sw.col_idx.push_back(bc * bw);
+        for (int j = 0; j < bw; j++) {
+          for (int i = 0; i < bh; i++) {
+            sw.values.push_back(block[i * K + j]);
+          }
+        }
+      }
+      sw.row_ptr.push_back(sw.col_idx.size());
+    }
+    sw.values.resize(std::max<size_t>(sw.values.size(), bh * bw), 0.f);
+    sw.col_idx.resize(std::max<size_t>(sw.col_idx.size(), 1), 0);
+  } else {
+    for (int i = 0; i < M; i++) {
+      for (int g = 0; g < K / bw; g++) {
+        int t = 0;
+        for (int j = 0; j < bw; j++) {
+          if (w[i * K + g * bw + j] != 0.f) {
+            sw.values.push_back(w[i * K + g * bw + j]);
+            sw.col_idx.push_back(g * bw + j);
+            t++;
+          }
+        }
+        for (; t < bh; t++) {
+          sw.values.push_back(0.f);
+          sw.col_idx.push_back(g * bw);
+        }
+      }
+    }
+  }
+  return sw;
+}
+
+// C[M, N] = S * B for the gemm, and C[N, M] = X * S^T for the fc.
+void basic_sparse_gemm(const std::vector<float>& w,
+                       const float* b,
+                       const float* bias,
+                       float* c,
+                       int M,
+                       int K,
+                       int N,
+                       bool is_fc,
+                       bool relu) {
+  for (int m = 0; m < M; m++) {
+    for (int n = 0; n < N; n++) {
+      double sum = bias ? bias[m] : 0.0;
+      for (int k = 0; k < K; k++) {
+        float bv = is_fc ? b[n * K + k] : b[k * N + n];
+        sum += static_cast<double>(w[m * K + k]) * bv;
+      }
+      float v = static_cast<float>(sum);
+      v = relu ? std::max(v, 0.f) : v;
+      c[is_fc ? n * M + m : m * N + n] = v;
+    }
+  }
+}
+
+bool test_sparse_structured_gemm(TestFormat format,
+                                 int bh,
+                                 int bw,
+                                 int M,
+                                 int K,
+                                 int N,
+                                 bool is_fc,
+                                 bool has_bias,
+                                 bool has_relu,
+                                 int cls,
+                                 int ths) {
+  std::mt19937 gen(M * 131 + K * 7 + N);
+  std::uniform_real_distribution<float> dis(-1.f, 1.f);
+  auto w = gen_sparse_weights(format, M, K, bh, bw, &gen);
+  auto sw = pack_sparse_weights(w, format, M, K, bh, bw);
+  std::vector<float> b(K * N);
+  std::vector<float> bias(M);
+  for (auto& v : b) v = dis(gen);
+  for (auto& v : bias) v = dis(gen);
+  const float* bias_ptr = has_bias ? bias.data() : nullptr;
+  std::vector<float> c(M * N, 0.f);
+  std::vector<float> c_basic(M * N, 0.f);
+  if (FLAGS_check_result) {
+    basic_sparse_gemm(
+        w, b.data(), bias_ptr, c_basic.data(), M, K, N, is_fc, has_relu);
+  }
+  ActivationParam act_param;
+  act_param.has_active = has_relu;
+  act_param.active_type = paddle::lite_api::ActivationType::kRelu;
+#ifdef LITE_WITH_ARM
+  std::unique_ptr<paddle::lite::KernelContext> ctx1(
+      new paddle::lite::KernelContext);
+  auto& ctx = ctx1->As<paddle::lite::ARMContext>();
+  ctx.SetRunMode(static_cast<paddle::lite_api::PowerMode>(cls), ths);
+#endif
+  auto run = [&]() {
+    namespace math = paddle::lite::host::math;
+    if (format == TestFormat::kBlock && is_fc) {
+      math::sparse_block_fc_fp32(sw.values.data(),
+                                 sw.row_ptr.data(),
+                                 sw.col_idx.data(),
+                                 bh,
+                                 bw,
+                                 b.data(),
+                                 bias_ptr,
+                                 c.data(),
+                                 M,
+                                 K,
+                                 N,
+                                 act_param);
+    } else if (format == TestFormat::kBlock) {
+      math::sparse_block_gemm_fp32(sw.values.data(),
+                                   sw.row_ptr.data(),
+                                   sw.col_idx.data(),
+                                   bh,
+                                   bw,
+                                   b.data(),
+                                   bias_ptr,
+                                   c.data(),
+                                   M,
+                                   K,
+                                   N,
+                                   act_param);
+    } else if (is_fc) {
+      math::sparse_nm_fc_fp32(sw.values.data(),
+                              sw.col_idx.data(),
+                              bh,
+                              bw,
+                              b.data(),
+                              bias_ptr,
+                              c.data(),
+                              M,
+                              K,
+                              N,
+                              act_param);
+    } else {
+      math::sparse_nm_gemm_fp32(sw.values.data(),
+                                sw.col_idx.data(),
+                                bh,
+                                bw,
+                                b.data(),
+                                bias_ptr,
+                                c.data(),
+                                M,
+                                K,
+                                N,
+                                act_param);
+    }
+  };
+  Timer t0;
+  for (int j = 0; j < FLAGS_warmup; ++j) {
+    run();
+  }
+  for (int i = 0; i < FLAGS_repeats; ++i) {
+    t0.Start();
+    run();
+    t0.Stop();
+  }
+  LOG(INFO) << (is_fc ? "sparse fc" : "sparse gemm") << ", format: "
+            << static_cast<int>(format) << ", block: " << bh << "x" << bw
+            << ", M: " << M << ", K: " << K << ", N: " << N
+            << ", bias: " << has_bias << ", relu: " << has_relu
+            << ", threads: " << ths << ", avg time: " << t0.LapTimes().Avg()
+            << " ms, min time: " << t0.LapTimes().Min() << " ms";
+
+  if (FLAGS_check_result) {
+    double max_diff = 0;
+    for (int i = 0; i < M * N; ++i) {
+      double diff = std::abs(static_cast<double>(c[i]) - c_basic[i]);
+      max_diff = std::max(max_diff, diff);
+    }
+    LOG(INFO) << "compare result, max diff: " << max_diff;
+    if (max_diff > 1e-4) {
+      return false;
+    }
+  }
+  return true;
+}
+
+TEST(TestSparseStructuredGemm, test_func_sparse_structured_gemm) {
+  if (FLAGS_basic_test) {
+#ifdef LITE_WITH_ARM
+    paddle::lite::DeviceInfo::Init();
+#endif
+    LOG(INFO) << "run basic sparse structured gemm test";
+    struct Format {
+      TestFormat format;
+      int bh;
+      int bw;
+    };
+    const std::vector<Format> formats = {{TestFormat::kBlock, 1, 4},
+                                         {TestFormat::kBlock, 4, 1},
+                                         {TestFormat::kBlock, 4, 4},
+                                         {TestFormat::kNM, 2, 4},
+                                         {TestFormat::kNM, 1, 4},
+                                         {TestFormat::kNM, 2, 8}};
+    // The N of the gemm and the fc covers the vector tails, and the M of the
+    // N:M fc covers the tiles and the blocks of the outputs with tails.
+    for (auto& f : formats) {
+      for (auto& th : {1, 2, 4}) {
+        for (auto& mkn : std::vector<std::vector<int>>{{16, 16, 1},
+                                                       {32, 64, 19},
+                                                       {132, 64, 53},
+                                                       {8, 32, 256}}) {
+          for (auto& is_fc : {false, true}) {
+            for (auto& has_bias : {false, true}) {
+              for (auto& has_relu : {false, true}) {
+                if (!test_sparse_structured_gemm(f.format,
+                                                 f.bh,
+                                                 f.bw,
+                                                 mkn[0],
+                                                 mkn[1],
+                                                 mkn[2],
+                                                 is_fc,
+                                                 has_bias,
+                                                 has_relu,
+                                                 3,
+                                                 th)) {
+                  LOG(FATAL) << "test sparse structured gemm format = "
+                             << static_cast<int>(f.format)
+                             << ", block = " << f.bh << "x" << f.bw
+                             << ", M = " << mkn[0] << ", K = " << mkn[1]
+                             << ", N = " << mkn[2] << ", fc = " << is_fc
+                             << ", threads = " << th << " failed\n";
+                }
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+TEST(TestSparseStructuredGemmCustom, test_func_sparse_structured_gemm_custom) {
+#ifdef LITE_WITH_ARM
+  paddle::lite::DeviceInfo::Init();
+#endif
+  auto flag =
+      test_sparse_structured_gemm(static_cast<TestFormat>(FLAGS_sparse_format),
+                                  FLAGS_block_h,
+                                  FLAGS_block_w,
+                                  FLAGS_M,
+                                  FLAGS_K,
+                                  FLAGS_N,
+                                  FLAGS_is_fc,
+                                  FLAGS_flag_bias,
+                                  FLAGS_flag_relu,
+                                  FLAGS_power_mode,
+                                  FLAGS_threads);
+  if (!flag) {
+    LOG(FATAL) << "test sparse structured gemm format = "
+               << FLAGS_sparse_format << ", M = " << FLAGS_M
+               << ", K = " << FLAGS_K << ", N = " << FLAGS_N << " failed!!";
+  }
+  LOG(INFO) << "test sparse structured gemm format = " << FLAGS_sparse_format
+            << ", M = " << FLAGS_M << ", K = " << FLAGS_K
+            << ", N = " << FLAGS_N << " passed!!";
+}
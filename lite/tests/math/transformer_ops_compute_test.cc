@@ -0,0 +1,309 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gflags/gflags.h>
+#include <gtest/gtest.h>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+#include "lite/core/context.h"
+#include "lite/core/profile/timer.h"
+#include "lite/tests/utils/fill_data.h"
+#include "lite/tests/utils/print_info.h"
+#include "lite/tests/utils/tensor_utils.h"
+
+#ifdef LITE_WITH_ARM
+#include "lite/backends/arm/math/funcs.h"
+#endif  // LITE_WITH_ARM
+#ifdef LITE_WITH_X86
+#include "lite/backends/x86/math/activation.h"
+#include "lite/backends/x86/math/layer_norm.h"
+#include "lite/backends/x86/math/softmax.h"
+#endif  // LITE_WITH_X86
+
+DEFINE_int32(power_mode,
+             3,
+             "power mode: "
+             "0 for POWER_HIGH;"
+             "1 for POWER_LOW;"
+             "2 for POWER_FULL;"
+             "3 for NO_BIND");
+DEFINE_int32(threads, 1, "threads num");
+DEFINE_int32(warmup, 0, "warmup times");
+DEFINE_int32(repeats, 1, "repeats times");
+DEFINE_bool(basic_test, false, "do all tests");
+DEFINE_bool(check_result, true, "check the result");
+
+DEFINE_int32(seq_len, 128, "sequence length");
+DEFINE_int32(hidden, 768, "hidden size");
+DEFINE_int32(heads, 12, "number of the attention heads");
+
+typedef paddle::lite::DDim DDim;
+typedef paddle::lite::Tensor Tensor;
+using paddle::lite::profile::Timer;
+
+void softmax_ref(const float* din, float* dout, int rows, int cols) {
+  for (int i = 0; i < rows; ++i) {
+    const float* x = din + i * cols;
+    float* y = dout + i * cols;
+    float max_data = std::numeric_limits<float>::lowest();
+    for (int j = 0; j < cols; ++j) {
+      max_data = std::max(max_data, x[j]);
+    }
+    double sum = 0;
+    for (int j = 0; j < cols; ++j) {
+      y[j] = std::exp(x[j] - max_data);
+      sum += y[j];
+    }
+    for (int j = 0; j < cols; ++j) {
+      y[j] /= sum;
+    }
+  }
+}
+
+void layer_norm_ref(const float* din,
+                    const float* residual,
+                    const float* scale,
+                    const float* bias,
+                    float* dout,
+                    int rows,
+                    int cols,
+                    float epsilon) {
+  std::vector<double> x(cols);
+  for (int i = 0; i < rows; ++i) {
+    double mean = 0;
+    for (int j = 0; j < cols; ++j) {
+      x[j] = din[i * cols + j] + residual[i * cols + j];
+      mean += x[j];
+    }
+    mean /= cols;
+    double var = 0;
+    for (int j = 0; j < cols; ++j) {
+      var += (x[j] - mean) * (x[j] - mean);
+    }
+    var /= cols;
+    for (int j = 0; j < cols; ++j) {
+      dout[i * cols + j] =
+          (x[j] - mean) / std::sqrt(var + epsilon) * scale[j] + bias[j];
+    }
+  }
+}
+
+void gelu_ref(const float* din, float* dout, int size, bool approximate) {
+  for (int i = 0; i < size; ++i) {
+    double x = din[i];
+    if (approximate) {
+      dout[i] =
+          0.5 * x * (1 + std::tanh(std::sqrt(2 / M_PI) *
+                                   (x + 0.044715 * x * x * x)));
+    } else {
+      dout[i] = 0.5 * x * (1 + std::erf(x * M_SQRT1_2));
+    }
+  }
+}
+
+void check_result(const Tensor& basic,
+                  const Tensor& lite,
+                  const std::string& name,
+                  double max_allowed_diff) {
+  double max_ratio = 0;
+  double max_diff = 0;
+  tensor_cmp_host(basic, lite, max_ratio, max_diff);
+  print_diff_info(max_diff, max_ratio);
+  if (max_diff > max_allowed_diff) {
+    LOG(FATAL) << "test " << name << " failed, max diff: " << max_diff;
+  }
+}
+
+// The ops of a BERT like encoder layer with the sequence length `seq_len` and
+// the hidden size `hidden`: the softmax of the attention scores, the layer_norm
+// fused with the residual add and the GELU of the FFN whose size is 4 * hidden.
+void test_transformer_ops(int seq_len, int hidden, int heads, int threads) {
+#ifdef LITE_WITH_ARM
+  std::unique_ptr<paddle::lite::KernelContext> ctx1(
+      new paddle::lite::KernelContext);
+  auto& ctx = ctx1->As<paddle::lite::ARMContext>();
+  ctx.SetRunMode(static_cast<paddle::lite_api::PowerMode>(FLAGS_power_mode),
+                 threads);
+#endif
+  const float epsilon = 1e-5f;
+  Timer t0;
+
+  // softmax, [heads * seq_len, seq_len]
+  int rows = heads * seq_len;
+  Tensor scores, probs, probs_ref;
+  scores.Resize({rows, seq_len});
+  probs.Resize({rows, seq_len});
+  probs_ref.Resize({rows, seq_len});
+  scores.set_precision(PRECISION(kFloat));
+  fill_tensor_rand(scores, -8.f, 8.f);
+  auto run_softmax = [&]() {
+#ifdef LITE_WITH_ARM
+    paddle::lite::arm::math::softmax_inner1_large_axis(
+        scores.data<float>(), probs.mutable_data<float>(), rows, seq_len);
+#elif defined(LITE_WITH_X86)
+    paddle::lite::x86::math::softmax_inner1(
+        scores.data<float>(), probs.mutable_data<float>(), rows, seq_len);
+#endif
+  };
+  for (int i = 0; i < FLAGS_warmup; ++i) run_softmax();
+  for (int i = 0; i < FLAGS_repeats; ++i) {
+    t0.Start();
+    run_softmax();
+    t0.Stop();
+  }
+  LOG(INFO) << "softmax: " << scores.dims() << ", threads: " << threads
+            << ", avg time: " << t0.LapTimes().Avg()
+            << " ms, min time: " << t0.LapTimes().Min() << " ms";
+  if (FLAGS_check_result) {
+    softmax_ref(
+        scores.data<float>(), probs_ref.mutable_data<float>(), rows, seq_len);
+    check_result(probs_ref, probs, "softmax", 1e-5);
+  }
+
+  // layer_norm(x + residual), [seq_len, hidden]
+  Tensor x, residual, scale, bias, out, out_ref, mean, var;
+  x.Resize({seq_len, hidden});
+  residual.Resize({seq_len, hidden});
+  scale.Resize({hidden});
+  bias.Resize({hidden});
+  out.Resize({seq_len, hidden});
+  out_ref.Resize({seq_len, hidden});
+  mean.Resize({seq_len});
+  var.Resize({seq_len});
+  x.set_precision(PRECISION(kFloat));
+  fill_tensor_rand(x, -2.f, 2.f);
+  residual.set_precision(PRECISION(kFloat));
+  fill_tensor_rand(residual, -2.f, 2.f);
+  scale.set_precision(PRECISION(kFloat));
+  fill_tensor_rand(scale, 0.5f, 1.5f);
+  bias.set_precision(PRECISION(kFloat));
+  fill_tensor_rand(bias, -1.f, 1.f);
+  auto run_layer_norm = [&]() {
+#ifdef LITE_WITH_ARM
+    paddle::lite::arm::math::matrix_norm_row(x.data<float>(),
+                                             residual.data<float>(),
+                                             scale.data<float>(),
+                                             bias.data<float>(),
+                                             out.mutable_data<float>(),
+                                             mean.mutable_data<float>(),
+                                             var.mutable_data<float>(),
+                                             epsilon,
+                                             seq_len,
+                                             hidden);
+#elif defined(LITE_WITH_X86)
+    paddle::lite::x86::math::layer_norm(x.data<float>(),
+                                        residual.data<float>(),
+                                        scale.data<float>(),
+                                        bias.data<float>(),
+                                        out.mutable_data<float>(),
+                                        mean.mutable_data<float>(),
+                                        var.mutable_data<float>(),
+                                        epsilon,
+                                        seq_len,
+                                        hidden);
+#endif
+  };
+  Timer t1;
+  for (int i = 0; i < FLAGS_warmup; ++i) run_layer_norm();
+  for (int i = 0; i < FLAGS_repeats; ++i) {
+    t1.Start();
+    run_layer_norm();
+    t1.Stop();
+  }
+  LOG(INFO) << "residual add + layer_norm: " << x.dims()
+            << ", threads: " << threads
+            << ", avg time: " << t1.LapTimes().Avg()
+            << " ms, min time: " << t1.LapTimes().Min() << " ms";
+  if (FLAGS_check_result) {
+    layer_norm_ref(x.data<float>(),
+                   residual.data<float>(),
+                   scale.data<float>(),
+                   bias.data<float>(),
+                   out_ref.mutable_data<float>(),
+                   seq_len,
+                   hidden,
+                   epsilon);
+    check_result(out_ref, out, "layer_norm", 1e-4);
+  }
+
+  // gelu, [seq_len, 4 * hidden]
+  Tensor ffn, act, act_ref;
+  ffn.Resize({seq_len, 4 * hidden});
+  act.Resize({seq_len, 4 * hidden});
+  act_ref.Resize({seq_len, 4 * hidden});
+  ffn.set_precision(PRECISION(kFloat));
+  fill_tensor_rand(ffn, -6.f, 6.f);
+  int size = static_cast<int>(ffn.numel());
+  for (bool approximate : {false, true}) {
+    auto run_gelu = [&]() {
+#ifdef LITE_WITH_ARM
+      paddle::lite::arm::math::act_gelu<float>(ffn.data<float>(),
+                                               act.mutable_data<float>(),
+                                               size,
+                                               approximate,
+                                               threads);
+#elif defined(LITE_WITH_X86)
+      paddle::lite::x86::math::gelu<float>(
+          ffn.data<float>(), act.mutable_data<float>(), size, approximate);
+#endif
+    };
+    Timer t2;
+    for (int i = 0; i < FLAGS_warmup; ++i) run_gelu();
+    for (int i = 0; i < FLAGS_repeats; ++i) {
+      t2.Start();
+      run_gelu();
+      t2.Stop();
+    }
+    LOG(INFO) << "gelu(approximate: " << approximate << "): " << ffn.dims()
+              << ", threads: " << threads
+              << ", avg time: " << t2.LapTimes().Avg()
+              << " ms, min time: " << t2.LapTimes().Min() << " ms";
+    if (FLAGS_check_result) {
+      gelu_ref(
+          ffn.data<float>(), act_ref.mutable_data<float>(), size, approximate);
+      check_result(act_ref, act, "gelu", 1e-5);
+    }
+  }
+}
+
+#if 1  /// the hidden sizes of the BERT models
+TEST(TestTransformerOps, test_transformer_ops_bert) {
+#ifdef LITE_WITH_ARM
+  paddle::lite::DeviceInfo::Init();
+#endif
+  if (FLAGS_basic_test) {
+    for (auto seq_len : {32, 128, 512}) {
+      // BERT-tiny, mini, small, base and large
+      for (auto hidden : {128, 256, 512, 768, 1024}) {
+        for (auto threads : {1, 2, 4}) {
+          test_transformer_ops(seq_len, hidden, hidden / 64, threads);
+        }
+      }
+    }
+  }
+}
+#endif  /// the hidden sizes of the BERT models
+
+#if 1  /// custom
+TEST(TestTransformerOpsCustom, test_transformer_ops_custom_size) {
+#ifdef LITE_WITH_ARM
+  paddle::lite::DeviceInfo::Init();
+#endif
+  test_transformer_ops(
+      FLAGS_seq_len, FLAGS_hidden, FLAGS_heads, FLAGS_threads);
+}
+#endif  // custom
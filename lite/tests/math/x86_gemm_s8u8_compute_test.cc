@@ -24,6 +24,9 @@
 #include <gtest/gtest.h>
 #include <string.h>
 #include <algorithm>
+#include <random>
+#include <vector>
+#include "lite/backends/x86/cpu_info.h"
 #include "lite/backends/x86/math/blas.h"
 #include "lite/backends/x86/math/gemm_s8u8_compute.h"
 #include "lite/core/context.h"
@@ -413,4 +416,64 @@ TEST(TestX86LiteGemmInt8f32, gemm_s8u8f32_compute) {
   }
 }
 
+// Unlike the avx2 kernel, whose pairs of the products saturate in int16, the
+// vnni kernel accumulates the products in int32, so the full range of A gets
+// the exact int32 sums.
+TEST(TestX86LiteGemmInt8f32, gemm_s8u8f32_vnni) {
+  if (!paddle::lite::x86::MayIUse(paddle::lite::x86::avx512_core_vnni)) {
+    LOG(INFO) << "Skip the vnni gemm test, as the cpu doesn't support it.";
+    return;
+  }
+  std::mt19937 gen(0);
+  std::uniform_int_distribution<int> dis(-127, 127);
+  for (int m : {1, 2, 3, 8, 13}) {
+    for (int n : {1, 31, 32, 77}) {
+      for (int k : {1, 5, 64, 333}) {
+        for (auto tra : {true, false}) {
+          for (auto trb : {true, false}) {
+            std::vector<int8_t> a(m * k);
+            std::vector<int8_t> b(k * n);
+            for (auto &v : a) v = static_cast<int8_t>(dis(gen));
+            for (auto &v : b) v = static_cast<int8_t>(dis(gen));
+            // The products of the extreme values saturate the avx2 pairs.
+            a[0] = -127;
+            b[0] = -127;
+            std::vector<float> sa(m, 1.f);
+            std::vector<float> c(m * n);
+            paddle::lite::x86::math::generate_gemm_s8u8_x86_kern<float> gemm(
+                tra,
+                trb,
+                m,
+                n,
+                k,
+                a.data(),
+                n,
+                sa.data(),
+                1.f,
+                1.f,
+                nullptr,
+                0,
+                1.f);
+            gemm.compute(a.data(), b.data(), c.data());
+            for (int i = 0; i < m; i++) {
+              for (int j = 0; j < n; j++) {
+                int32_t sum = 0;
+                for (int l = 0; l < k; l++) {
+                  int32_t va = tra ? a[l * m + i] : a[i * k + l];
+                  int32_t vb = trb ? b[j * k + l] : b[l * n + j];
+                  sum += va * vb;
+                }
+                ASSERT_EQ(c[i * n + j], static_cast<float>(sum))
+                    << "m: " << m << ", n: " << n << ", k: " << k
+                    << ", transA: " << tra << ", transB: " << trb << ", at "
+                    << i << ", " << j;
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
 #endif  // LITE_WITH_X86
@@ -56,6 +56,8 @@ NNADAPTER_KUNLUNXIN_XTCL_SDK_ROOT=""
 NNADAPTER_KUNLUNXIN_XTCL_SDK_URL=""
 # bdcentos_x86_64, ubuntu_x86_64 or kylin_aarch64
 NNADAPTER_KUNLUNXIN_XTCL_SDK_ENV=""
+# The CPU stand-in device for testing the NNAdapter runtime
+NNADAPTER_WITH_FAKE_DEVICE=OFF
 
 # options of compiling baidu XPU lib.
 WITH_BAIDU_XPU=OFF
@@ -212,6 +214,7 @@ function init_cmake_mutable_options {
                         -DNNADAPTER_KUNLUNXIN_XTCL_SDK_ROOT=$NNADAPTER_KUNLUNXIN_XTCL_SDK_ROOT \
                         -DNNADAPTER_KUNLUNXIN_XTCL_SDK_URL=$NNADAPTER_KUNLUNXIN_XTCL_SDK_URL \
                         -DNNADAPTER_KUNLUNXIN_XTCL_SDK_ENV=$NNADAPTER_KUNLUNXIN_XTCL_SDK_ENV \
+                        -DNNADAPTER_WITH_FAKE_DEVICE=$NNADAPTER_WITH_FAKE_DEVICE \
                         -DLITE_WITH_INTEL_FPGA=$WITH_INTEL_FPGA \
                         -DINTEL_FPGA_SDK_ROOT=${INTEL_FPGA_SDK_ROOT} \
                         -DLITE_WITH_PROFILE=${WITH_PROFILE} \
@@ -572,6 +575,10 @@ function main {
                 NNADAPTER_KUNLUNXIN_XTCL_SDK_ENV="${i#*=}"
                 shift
                 ;;
+            --nnadapter_with_fake_device=*)
+                NNADAPTER_WITH_FAKE_DEVICE="${i#*=}"
+                shift
+                ;;
             # compiling lib which can operate on baidu xpu.
             --with_baidu_xpu=*)
                 WITH_BAIDU_XPU="${i#*=}"
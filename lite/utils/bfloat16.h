@@ -0,0 +1,66 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+#include "lite/api/paddle_place.h"
+
+namespace paddle {
+namespace lite {
+
+// The bits of a bfloat16 are the upper 16 bits of the float with the same
+// value, i.e. the sign, the 8 exponent bits and 7 bits of the mantissa. It has
+// the range of float, so the weights can be converted without the calibration
+// needed by int8, and it is widened to float by a 16-bit shift.
+inline uint16_t fp32_to_bf16_bits(float val) {
+  uint32_t bits;
+  memcpy(&bits, &val, sizeof(bits));
+  if ((bits & 0x7fffffffu) > 0x7f800000u) {
+    // keep NaN a quiet NaN instead of rounding it to inf
+    return static_cast<uint16_t>((bits >> 16) | 0x40u);
+  }
+  // round to nearest even
+  bits += 0x7fffu + ((bits >> 16) & 1u);
+  return static_cast<uint16_t>(bits >> 16);
+}
+
+inline float bf16_bits_to_fp32(uint16_t x) {
+  uint32_t bits = static_cast<uint32_t>(x) << 16;
+  float val;
+  memcpy(&val, &bits, sizeof(val));
+  return val;
+}
+
+struct alignas(2) bfloat16 {
+  uint16_t x;
+
+  bfloat16() = default;
+  explicit bfloat16(float val) : x(fp32_to_bf16_bits(val)) {}
+
+  explicit operator float() const { return bf16_bits_to_fp32(x); }
+};
+
+}  // namespace lite
+
+namespace lite_api {
+
+template <>
+struct PrecisionTypeTrait<lite::bfloat16> {
+  constexpr static PrecisionType Type() { return PrecisionType::kBF16; }
+};
+
+}  // namespace lite_api
+}  // namespace paddle
@@ -0,0 +1,57 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/utils/bfloat16.h"
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <limits>
+
+namespace paddle {
+namespace lite {
+
+TEST(bfloat16, conversion) {
+  EXPECT_EQ(bfloat16(1.0f).x, 0x3f80);
+  EXPECT_EQ(bfloat16(-2.0f).x, 0xc000);
+  EXPECT_EQ(bfloat16(0.0f).x, 0x0000);
+  EXPECT_EQ(bfloat16(-0.0f).x, 0x8000);
+  EXPECT_EQ(bfloat16(std::numeric_limits<float>::infinity()).x, 0x7f80);
+  // 1/3 is 0x3eaaaaab, rounded up
+  EXPECT_EQ(bfloat16(1.f / 3.f).x, 0x3eab);
+  // the ties are rounded to even
+  EXPECT_EQ(bfloat16(1.00390625f).x, 0x3f80);
+  EXPECT_EQ(bfloat16(1.01171875f).x, 0x3f82);
+  // the largest float is rounded to inf
+  EXPECT_EQ(bfloat16(std::numeric_limits<float>::max()).x, 0x7f80);
+  EXPECT_TRUE(std::isnan(static_cast<float>(
+      bfloat16(std::numeric_limits<float>::quiet_NaN()))));
+
+  EXPECT_EQ(static_cast<float>(bfloat16(1.0f)), 1.0f);
+  EXPECT_EQ(static_cast<float>(bfloat16(-0.5f)), -0.5f);
+  EXPECT_EQ(static_cast<float>(bfloat16(65536.f)), 65536.f);
+  for (float val : {0.1f, -3.7f, 1234.5f, 1e-30f, 3e30f}) {
+    EXPECT_NEAR(static_cast<float>(bfloat16(val)),
+                val,
+                std::fabs(val) * (1.f / 256.f));
+  }
+}
+
+TEST(bfloat16, precision_trait) {
+  EXPECT_EQ(lite_api::PrecisionTypeTrait<bfloat16>::Type(),
+            lite_api::PrecisionType::kBF16);
+  EXPECT_EQ(sizeof(bfloat16), 2u);
+}
+
+}  // namespace lite
+}  // namespace paddle
@@ -29,6 +29,14 @@
 #define SUBGRAPH_CUSTOM_PARTITION_CONFIG_FILE \
   "SUBGRAPH_CUSTOM_PARTITION_CONFIG_FILE"
 
+// Specify the path of the cost table for partitioning the subgraphs by the
+// estimated latency of the ops on the host and the device and of the
+// transfers between them, see SubgraphCostModel, an example is shown as below:
+// conv2d:8.5,1.2
+// default:1.0,1.0
+// transfer:0.05,0.0001
+#define SUBGRAPH_COST_TABLE_FILE "SUBGRAPH_COST_TABLE_FILE"
+
 // The original weight/local/unused variables in the subblock of the subgraph op
 // will be saved only if 'SUBGRAPH_ONLINE_MODE' is set to true(default) during
 // the analysis phase, it ensure the ops in the subblock can be converted to the
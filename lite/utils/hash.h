@@ -13,6 +13,8 @@
 // limitations under the License.
 
 #pragma once
+#include <stdint.h>
+#include <string.h>
 #include <functional>
 
 namespace paddle {
@@ -25,5 +27,24 @@ inline void CombineHash(const T& from, size_t* to) {
   *to ^= h(from) + 0x9e3779b9 + (*to << 6) + (*to >> 2);
 }
 
+// The FNV-1a hash of the bytes, which are read as 64-bit words, it continues
+// from `hash` to hash the bytes of several buffers in turn.
+inline uint64_t HashBytes(const void* data,
+                          size_t size,
+                          uint64_t hash = 14695981039346656037ULL) {
+  const uint64_t prime = 1099511628211ULL;
+  auto bytes = static_cast<const uint8_t*>(data);
+  size_t i = 0;
+  for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+    uint64_t word;
+    memcpy(&word, bytes + i, sizeof(uint64_t));
+    hash = (hash ^ word) * prime;
+  }
+  for (; i < size; i++) {
+    hash = (hash ^ bytes[i]) * prime;
+  }
+  return hash;
+}
+
 }  // namespace lite
 }  // namespace paddle